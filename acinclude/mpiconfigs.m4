@@ -23,6 +23,12 @@ AC_DEFUN([DUMPI_FUNCTIONS], [
 AH_TEMPLATE(DUMPI_HAVE_MPI_WIN, [if MPI_WIN functions are available])
 AC_DEFINE(DUMPI_HAVE_MPI_WIN, [1])
 
+AH_TEMPLATE(DUMPI_HAVE_MPI_MESSAGE, [if MPI_Message handles are available])
+AC_DEFINE(DUMPI_HAVE_MPI_MESSAGE, [1])
+
+AH_TEMPLATE(DUMPI_HAVE_MPI_DIST_GRAPH, [if distributed graph topologies are available])
+AC_DEFINE(DUMPI_HAVE_MPI_DIST_GRAPH, [1])
+
 AH_TEMPLATE([DUMPI_SKIP_MPI_PCONTROL], [if MPI_PCONTROL is missing])
 AH_TEMPLATE([DUMPI_SKIP_MPI_SEND], [if MPI_SEND is missing])
 AH_TEMPLATE([DUMPI_SKIP_MPI_RECV], [if MPI_RECV is missing])
@@ -313,4 +319,30 @@ AH_TEMPLATE([DUMPI_SKIP_MPIO_WAIT], [if MPIO_WAIT is missing])
 AH_TEMPLATE([DUMPI_SKIP_MPIO_WAITANY], [if MPIO_WAITANY is missing])
 AH_TEMPLATE([DUMPI_SKIP_MPIO_WAITSOME], [if MPIO_WAITSOME is missing])
 AH_TEMPLATE([DUMPI_SKIP_MPIO_WAITALL], [if MPIO_WAITALL is missing])
+AH_TEMPLATE([DUMPI_SKIP_MPI_IBARRIER], [if MPI_IBARRIER is missing])
+AH_TEMPLATE([DUMPI_SKIP_MPI_IBCAST], [if MPI_IBCAST is missing])
+AH_TEMPLATE([DUMPI_SKIP_MPI_IGATHER], [if MPI_IGATHER is missing])
+AH_TEMPLATE([DUMPI_SKIP_MPI_IGATHERV], [if MPI_IGATHERV is missing])
+AH_TEMPLATE([DUMPI_SKIP_MPI_ISCATTER], [if MPI_ISCATTER is missing])
+AH_TEMPLATE([DUMPI_SKIP_MPI_ISCATTERV], [if MPI_ISCATTERV is missing])
+AH_TEMPLATE([DUMPI_SKIP_MPI_IALLGATHER], [if MPI_IALLGATHER is missing])
+AH_TEMPLATE([DUMPI_SKIP_MPI_IALLGATHERV], [if MPI_IALLGATHERV is missing])
+AH_TEMPLATE([DUMPI_SKIP_MPI_IALLTOALL], [if MPI_IALLTOALL is missing])
+AH_TEMPLATE([DUMPI_SKIP_MPI_IALLTOALLV], [if MPI_IALLTOALLV is missing])
+AH_TEMPLATE([DUMPI_SKIP_MPI_IALLTOALLW], [if MPI_IALLTOALLW is missing])
+AH_TEMPLATE([DUMPI_SKIP_MPI_IREDUCE], [if MPI_IREDUCE is missing])
+AH_TEMPLATE([DUMPI_SKIP_MPI_IALLREDUCE], [if MPI_IALLREDUCE is missing])
+AH_TEMPLATE([DUMPI_SKIP_MPI_IREDUCE_SCATTER], [if MPI_IREDUCE_SCATTER is missing])
+AH_TEMPLATE([DUMPI_SKIP_MPI_ISCAN], [if MPI_ISCAN is missing])
+AH_TEMPLATE([DUMPI_SKIP_MPI_IEXSCAN], [if MPI_IEXSCAN is missing])
+AH_TEMPLATE([DUMPI_SKIP_MPI_DIST_GRAPH_CREATE_ADJACENT], [if MPI_DIST_GRAPH_CREATE_ADJACENT is missing])
+AH_TEMPLATE([DUMPI_SKIP_MPI_NEIGHBOR_ALLGATHER], [if MPI_NEIGHBOR_ALLGATHER is missing])
+AH_TEMPLATE([DUMPI_SKIP_MPI_NEIGHBOR_ALLGATHERV], [if MPI_NEIGHBOR_ALLGATHERV is missing])
+AH_TEMPLATE([DUMPI_SKIP_MPI_NEIGHBOR_ALLTOALL], [if MPI_NEIGHBOR_ALLTOALL is missing])
+AH_TEMPLATE([DUMPI_SKIP_MPI_NEIGHBOR_ALLTOALLV], [if MPI_NEIGHBOR_ALLTOALLV is missing])
+AH_TEMPLATE([DUMPI_SKIP_MPI_NEIGHBOR_ALLTOALLW], [if MPI_NEIGHBOR_ALLTOALLW is missing])
+AH_TEMPLATE([DUMPI_SKIP_MPI_MPROBE], [if MPI_MPROBE is missing])
+AH_TEMPLATE([DUMPI_SKIP_MPI_IMPROBE], [if MPI_IMPROBE is missing])
+AH_TEMPLATE([DUMPI_SKIP_MPI_MRECV], [if MPI_MRECV is missing])
+AH_TEMPLATE([DUMPI_SKIP_MPI_IMRECV], [if MPI_IMRECV is missing])
 ])
\ No newline at end of file
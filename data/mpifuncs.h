@@ -288,3 +288,29 @@ int MPIO_Testany(IN int count, IN MPIO_Request *requests[count], OUT int *index
 int MPIO_Waitany(IN int count, IN MPIO_Request *requests[count], OUT int *index, OUT MPI_Status *statuses[count] {COND(*index != MPI_UNDEFINED)}); 
 int MPIO_Waitsome(IN int count, IN MPIO_Request *requests[count], OUT int *outcount, OUT int *indices[*outcount], OUT MPI_Status *statuses[*outcount]);
 int MPIO_Testsome(IN int count, IN MPIO_Request *requests[count], OUT int *outcount, OUT int *indices[*outcount], OUT MPI_Status *statuses[*outcount]);
+int MPI_Ibarrier(IN MPI_Comm comm, OUT MPI_Request *request);
+int MPI_Ibcast(SKIP void *sendbuf, IN int count, IN MPI_Datatype datatype, IN int root, IN MPI_Comm comm, OUT MPI_Request *request);
+int MPI_Igather(SKIP void *inbuf, IN int sendcount, IN MPI_Datatype sendtype, SKIP void *recvbuf, IN int recvcount {COND(commrank==root)}, IN MPI_Datatype recvtype {COND(commrank==root)}, IN int root, IN MPI_Comm comm, OUT MPI_Request *request); EXTRA({DECLARE ADD int commrank;}{PREAMBLE PMPI_Comm_rank(comm, &commrank);});
+int MPI_Igatherv(SKIP void *sendbuf, IN int sendcount, IN MPI_Datatype sendtype, SKIP void *recvbuf, IN int *recvcounts[commsize] {COND(commrank==root)}, IN int *displs[commsize] {COND(commrank==root)}, IN MPI_Datatype recvtype {COND(commrank==root)}, IN int root, IN MPI_Comm comm, OUT MPI_Request *request); EXTRA({DECLARE ADD int commsize; ADD int commrank;}{PREAMBLE PMPI_Comm_size(comm, &commsize); PMPI_Comm_rank(comm, &commrank);});
+int MPI_Iscatter(SKIP void *sendbuf, IN int sendcount {COND(commrank==root)}, IN MPI_Datatype sendtype {COND(commrank==root)}, SKIP void *recvbuf, IN int recvcount, IN MPI_Datatype recvtype, IN int root, IN MPI_Comm comm, OUT MPI_Request *request); EXTRA({DECLARE ADD int commrank;}{PREAMBLE PMPI_Comm_rank(comm, &commrank);});
+int MPI_Iscatterv(SKIP void *sendbuf , IN int *sendcounts[commsize] {COND(commrank==root)}, IN int *displs[commsize] {COND(commrank==root)},  IN MPI_Datatype sendtype, SKIP void *recvbuf, IN int recvcount, IN MPI_Datatype recvtype, IN int root, IN MPI_Comm comm, OUT MPI_Request *request); EXTRA({DECLARE ADD int commsize; ADD int commrank;}{PREAMBLE PMPI_Comm_size(comm, &commsize); PMPI_Comm_rank(comm, &commrank);});
+int MPI_Iallgather(SKIP void *sendbuf , IN int sendcount, IN MPI_Datatype sendtype, SKIP void *recvbuf, IN int recvcount, IN MPI_Datatype recvtype, IN MPI_Comm comm, OUT MPI_Request *request);
+int MPI_Iallgatherv(SKIP void *sendbuf , IN int sendcount, IN MPI_Datatype sendtype, SKIP void *recvbuf, IN int *recvcounts[commsize], IN int *displs[commsize], IN MPI_Datatype recvtype, IN MPI_Comm comm, OUT MPI_Request *request); EXTRA({DECLARE ADD int commsize;}{PREAMBLE PMPI_Comm_size(comm, &commsize);});
+int MPI_Ialltoall(SKIP void *sendbuf , IN int sendcount, IN MPI_Datatype sendtype, SKIP void *recvbuf, IN int recvcount, IN MPI_Datatype recvtype, IN MPI_Comm comm, OUT MPI_Request *request);
+int MPI_Ialltoallv(SKIP void *sendbuf, IN int *sendcounts[commsize], IN int *senddispls[commsize], IN MPI_Datatype sendtype, SKIP void *recvbuf, IN int *recvcounts[commsize], IN int *recvdispls[commsize], IN MPI_Datatype recvtype, IN MPI_Comm comm, OUT MPI_Request *request); EXTRA({DECLARE ADD int commsize;}{PREAMBLE PMPI_Comm_size(comm, &commsize);});
+int MPI_Ialltoallw(SKIP void *sendbuf, IN int *sendcounts[commsize], IN int *senddispls[commsize], IN MPI_Datatype *sendtypes[commsize], SKIP void *recvbuf, IN int *recvcounts[commsize], IN int *recvdispls[commsize], IN MPI_Datatype *recvtypes[commsize], IN MPI_Comm comm, OUT MPI_Request *request); EXTRA({DECLARE ADD int commsize;}{PREAMBLE PMPI_Comm_size(comm, &commsize);});
+int MPI_Ireduce(SKIP void *sendbuf, SKIP void *recvbuf, IN int count, IN MPI_Datatype datatype, IN MPI_Op op, IN int root, IN MPI_Comm comm, OUT MPI_Request *request);
+int MPI_Iallreduce(SKIP void *sendbuf, SKIP void *recvbuf, IN int count, IN MPI_Datatype datatype, IN MPI_Op op, IN MPI_Comm comm, OUT MPI_Request *request);
+int MPI_Ireduce_scatter(SKIP void *sendbuf, SKIP void *recvbuf, IN int *recvcounts[commsize], IN MPI_Datatype datatype, IN MPI_Op op, IN MPI_Comm comm, OUT MPI_Request *request); EXTRA({DECLARE ADD int commsize;}{PREAMBLE PMPI_Comm_size(comm, &commsize);});
+int MPI_Iscan(SKIP void *sendbuf, SKIP void *recvbuf, IN int count, IN MPI_Datatype datatype, IN MPI_Op op, IN MPI_Comm comm, OUT MPI_Request *request);
+int MPI_Iexscan(SKIP void *sendbuf, SKIP void *recvbuf, IN int count, IN MPI_Datatype datatype, IN MPI_Op op, IN MPI_Comm comm, OUT MPI_Request *request);
+int MPI_Dist_graph_create_adjacent(IN MPI_Comm oldcomm, IN int indegree, IN int *sources[indegree], SKIP int *sourceweights, IN int outdegree, IN int *destinations[outdegree], SKIP int *destweights, SKIP MPI_Info info, IN int reorder, OUT MPI_Comm *newcomm);
+int MPI_Neighbor_allgather(SKIP void *sendbuf, IN int sendcount, IN MPI_Datatype sendtype, SKIP void *recvbuf, IN int recvcount, IN MPI_Datatype recvtype, IN MPI_Comm comm);
+int MPI_Neighbor_allgatherv(SKIP void *sendbuf, IN int sendcount, IN MPI_Datatype sendtype, SKIP void *recvbuf, IN int *recvcounts[indegree], IN int *displs[indegree], IN MPI_Datatype recvtype, IN MPI_Comm comm); EXTRA({DECLARE ADD int indegree;}{PREAMBLE libdumpi_neighbor_degrees(comm, &indegree, NULL);});
+int MPI_Neighbor_alltoall(SKIP void *sendbuf, IN int sendcount, IN MPI_Datatype sendtype, SKIP void *recvbuf, IN int recvcount, IN MPI_Datatype recvtype, IN MPI_Comm comm);
+int MPI_Neighbor_alltoallv(SKIP void *sendbuf, IN int *sendcounts[outdegree], IN int *senddispls[outdegree], IN MPI_Datatype sendtype, SKIP void *recvbuf, IN int *recvcounts[indegree], IN int *recvdispls[indegree], IN MPI_Datatype recvtype, IN MPI_Comm comm); EXTRA({DECLARE ADD int indegree; DECLARE ADD int outdegree;}{PREAMBLE libdumpi_neighbor_degrees(comm, &indegree, &outdegree);});
+int MPI_Neighbor_alltoallw(SKIP void *sendbuf, IN int *sendcounts[outdegree], IN MPI_Aint *senddispls[outdegree], IN MPI_Datatype *sendtypes[outdegree], SKIP void *recvbuf, IN int *recvcounts[indegree], IN MPI_Aint *recvdispls[indegree], IN MPI_Datatype *recvtypes[indegree], IN MPI_Comm comm); EXTRA({DECLARE ADD int indegree; DECLARE ADD int outdegree;}{PREAMBLE libdumpi_neighbor_degrees(comm, &indegree, &outdegree);});
+int MPI_Mprobe(IN SOURCE source, IN TAG tag, IN MPI_Comm comm, OUT MPI_Message *message, OUT MPI_Status *status);
+int MPI_Improbe(IN SOURCE source, IN TAG tag, IN MPI_Comm comm, OUT int *flag, OUT MPI_Message *message, OUT MPI_Status *status {COND(*flag != 0)});
+int MPI_Mrecv(SKIP void *buf, IN int count, IN MPI_Datatype datatype, INOUT MPI_Message *message, OUT MPI_Status *status);
+int MPI_Imrecv(SKIP void *buf, IN int count, IN MPI_Datatype datatype, INOUT MPI_Message *message, OUT MPI_Request *request);
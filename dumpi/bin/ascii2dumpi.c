@@ -1403,6 +1403,10 @@ static uint16_t dumpi_returning(const char *mpicall, uint16_t enter_thread,
     prm.NAME = read_int("MPI_Request", #NAME, wrapper); \
   } while(0)
 
+#define DUMPI_CONVERT_MESSAGE(NAME) do {                \
+    prm.NAME = read_int("MPI_Message", #NAME, wrapper); \
+  } while(0)
+
 #define DUMPIO_CONVERT_REQUEST(NAME) do {                \
     prm.NAME = read_int("MPIO_Request", #NAME, wrapper); \
   } while(0)
@@ -4354,6 +4358,339 @@ void report_MPIO_Testsome(fwrapper *wrapper, settings *opts) {
   if(prm.indices) free(prm.indices);
   if(prm.statuses) free(prm.statuses);
 }
+void report_MPI_Ibarrier(fwrapper *wrapper, settings *opts) {
+  PREAMBLE(dumpi_ibarrier);
+  DUMPI_ENTERING(MPI_Ibarrier, prm, thread, cpu, wall, perf, opts);
+  DUMPI_CONVERT_COMM(comm);
+  DUMPI_CONVERT_REQUEST(request);
+  DUMPI_RETURNING(MPI_Ibarrier, dumpi_write_ibarrier, prm, thread, cpu, wall, perf, wrapper, opts);
+}
+void report_MPI_Ibcast(fwrapper *wrapper, settings *opts) {
+  PREAMBLE(dumpi_ibcast);
+  DUMPI_ENTERING(MPI_Ibcast, prm, thread, cpu, wall, perf, opts);
+  DUMPI_CONVERT_INT(count);
+  DUMPI_CONVERT_DATATYPE(datatype);
+  DUMPI_CONVERT_INT(root);
+  DUMPI_CONVERT_COMM(comm);
+  DUMPI_CONVERT_REQUEST(request);
+  DUMPI_RETURNING(MPI_Ibcast, dumpi_write_ibcast, prm, thread, cpu, wall, perf, wrapper, opts);
+}
+void report_MPI_Igather(fwrapper *wrapper, settings *opts) {
+  PREAMBLE(dumpi_igather);
+  DUMPI_ENTERING(MPI_Igather, prm, thread, cpu, wall, perf, opts);
+  DUMPI_CONVERT_INT(commrank);
+  DUMPI_CONVERT_INT(sendcount);
+  DUMPI_CONVERT_DATATYPE(sendtype);
+  DUMPI_CONVERT_INT(recvcount);
+  DUMPI_CONVERT_DATATYPE(recvtype);
+  DUMPI_CONVERT_INT(root);
+  DUMPI_CONVERT_COMM(comm);
+  DUMPI_CONVERT_REQUEST(request);
+  DUMPI_RETURNING(MPI_Igather, dumpi_write_igather, prm, thread, cpu, wall, perf, wrapper, opts);
+}
+void report_MPI_Igatherv(fwrapper *wrapper, settings *opts) {
+  PREAMBLE(dumpi_igatherv);
+  DUMPI_ENTERING(MPI_Igatherv, prm, thread, cpu, wall, perf, opts);
+  DUMPI_CONVERT_INT(commrank);
+  DUMPI_CONVERT_INT(commsize);
+  DUMPI_CONVERT_INT(sendcount);
+  DUMPI_CONVERT_DATATYPE(sendtype);
+  DUMPI_CONVERT_INT_ARRAY_1(commsize, recvcounts);
+  DUMPI_CONVERT_INT_ARRAY_1(commsize, displs);
+  DUMPI_CONVERT_DATATYPE(recvtype);
+  DUMPI_CONVERT_INT(root);
+  DUMPI_CONVERT_COMM(comm);
+  DUMPI_CONVERT_REQUEST(request);
+  DUMPI_RETURNING(MPI_Igatherv, dumpi_write_igatherv, prm, thread, cpu, wall, perf, wrapper, opts);
+  if(prm.recvcounts) free(prm.recvcounts);
+  if(prm.displs) free(prm.displs);
+}
+void report_MPI_Iscatter(fwrapper *wrapper, settings *opts) {
+  PREAMBLE(dumpi_iscatter);
+  DUMPI_ENTERING(MPI_Iscatter, prm, thread, cpu, wall, perf, opts);
+  DUMPI_CONVERT_INT(commrank);
+  DUMPI_CONVERT_INT(sendcount);
+  DUMPI_CONVERT_DATATYPE(sendtype);
+  DUMPI_CONVERT_INT(recvcount);
+  DUMPI_CONVERT_DATATYPE(recvtype);
+  DUMPI_CONVERT_INT(root);
+  DUMPI_CONVERT_COMM(comm);
+  DUMPI_CONVERT_REQUEST(request);
+  DUMPI_RETURNING(MPI_Iscatter, dumpi_write_iscatter, prm, thread, cpu, wall, perf, wrapper, opts);
+}
+void report_MPI_Iscatterv(fwrapper *wrapper, settings *opts) {
+  PREAMBLE(dumpi_iscatterv);
+  DUMPI_ENTERING(MPI_Iscatterv, prm, thread, cpu, wall, perf, opts);
+  DUMPI_CONVERT_INT(commrank);
+  DUMPI_CONVERT_INT(commsize);
+  DUMPI_CONVERT_INT_ARRAY_1(commsize, sendcounts);
+  DUMPI_CONVERT_INT_ARRAY_1(commsize, displs);
+  DUMPI_CONVERT_DATATYPE(sendtype);
+  DUMPI_CONVERT_INT(recvcount);
+  DUMPI_CONVERT_DATATYPE(recvtype);
+  DUMPI_CONVERT_INT(root);
+  DUMPI_CONVERT_COMM(comm);
+  DUMPI_CONVERT_REQUEST(request);
+  DUMPI_RETURNING(MPI_Iscatterv, dumpi_write_iscatterv, prm, thread, cpu, wall, perf, wrapper, opts);
+  if(prm.sendcounts) free(prm.sendcounts);
+  if(prm.displs) free(prm.displs);
+}
+void report_MPI_Iallgather(fwrapper *wrapper, settings *opts) {
+  PREAMBLE(dumpi_iallgather);
+  DUMPI_ENTERING(MPI_Iallgather, prm, thread, cpu, wall, perf, opts);
+  DUMPI_CONVERT_INT(sendcount);
+  DUMPI_CONVERT_DATATYPE(sendtype);
+  DUMPI_CONVERT_INT(recvcount);
+  DUMPI_CONVERT_DATATYPE(recvtype);
+  DUMPI_CONVERT_COMM(comm);
+  DUMPI_CONVERT_REQUEST(request);
+  DUMPI_RETURNING(MPI_Iallgather, dumpi_write_iallgather, prm, thread, cpu, wall, perf, wrapper, opts);
+}
+void report_MPI_Iallgatherv(fwrapper *wrapper, settings *opts) {
+  PREAMBLE(dumpi_iallgatherv);
+  DUMPI_ENTERING(MPI_Iallgatherv, prm, thread, cpu, wall, perf, opts);
+  DUMPI_CONVERT_INT(commsize);
+  DUMPI_CONVERT_INT(sendcount);
+  DUMPI_CONVERT_DATATYPE(sendtype);
+  DUMPI_CONVERT_INT_ARRAY_1(commsize, recvcounts);
+  DUMPI_CONVERT_INT_ARRAY_1(commsize, displs);
+  DUMPI_CONVERT_DATATYPE(recvtype);
+  DUMPI_CONVERT_COMM(comm);
+  DUMPI_CONVERT_REQUEST(request);
+  DUMPI_RETURNING(MPI_Iallgatherv, dumpi_write_iallgatherv, prm, thread, cpu, wall, perf, wrapper, opts);
+  if(prm.recvcounts) free(prm.recvcounts);
+  if(prm.displs) free(prm.displs);
+}
+void report_MPI_Ialltoall(fwrapper *wrapper, settings *opts) {
+  PREAMBLE(dumpi_ialltoall);
+  DUMPI_ENTERING(MPI_Ialltoall, prm, thread, cpu, wall, perf, opts);
+  DUMPI_CONVERT_INT(sendcount);
+  DUMPI_CONVERT_DATATYPE(sendtype);
+  DUMPI_CONVERT_INT(recvcount);
+  DUMPI_CONVERT_DATATYPE(recvtype);
+  DUMPI_CONVERT_COMM(comm);
+  DUMPI_CONVERT_REQUEST(request);
+  DUMPI_RETURNING(MPI_Ialltoall, dumpi_write_ialltoall, prm, thread, cpu, wall, perf, wrapper, opts);
+}
+void report_MPI_Ialltoallv(fwrapper *wrapper, settings *opts) {
+  PREAMBLE(dumpi_ialltoallv);
+  DUMPI_ENTERING(MPI_Ialltoallv, prm, thread, cpu, wall, perf, opts);
+  DUMPI_CONVERT_INT(commsize);
+  DUMPI_CONVERT_INT_ARRAY_1(commsize, sendcounts);
+  DUMPI_CONVERT_INT_ARRAY_1(commsize, senddispls);
+  DUMPI_CONVERT_DATATYPE(sendtype);
+  DUMPI_CONVERT_INT_ARRAY_1(commsize, recvcounts);
+  DUMPI_CONVERT_INT_ARRAY_1(commsize, recvdispls);
+  DUMPI_CONVERT_DATATYPE(recvtype);
+  DUMPI_CONVERT_COMM(comm);
+  DUMPI_CONVERT_REQUEST(request);
+  DUMPI_RETURNING(MPI_Ialltoallv, dumpi_write_ialltoallv, prm, thread, cpu, wall, perf, wrapper, opts);
+  if(prm.sendcounts) free(prm.sendcounts);
+  if(prm.senddispls) free(prm.senddispls);
+  if(prm.recvcounts) free(prm.recvcounts);
+  if(prm.recvdispls) free(prm.recvdispls);
+}
+void report_MPI_Ialltoallw(fwrapper *wrapper, settings *opts) {
+  PREAMBLE(dumpi_ialltoallw);
+  DUMPI_ENTERING(MPI_Ialltoallw, prm, thread, cpu, wall, perf, opts);
+  DUMPI_CONVERT_INT(commsize);
+  DUMPI_CONVERT_INT_ARRAY_1(commsize, sendcounts);
+  DUMPI_CONVERT_INT_ARRAY_1(commsize, senddispls);
+  DUMPI_CONVERT_DATATYPE_ARRAY_1(commsize, sendtypes);
+  DUMPI_CONVERT_INT_ARRAY_1(commsize, recvcounts);
+  DUMPI_CONVERT_INT_ARRAY_1(commsize, recvdispls);
+  DUMPI_CONVERT_DATATYPE_ARRAY_1(commsize, recvtypes);
+  DUMPI_CONVERT_COMM(comm);
+  DUMPI_CONVERT_REQUEST(request);
+  DUMPI_RETURNING(MPI_Ialltoallw, dumpi_write_ialltoallw, prm, thread, cpu, wall, perf, wrapper, opts);
+  if(prm.sendcounts) free(prm.sendcounts);
+  if(prm.senddispls) free(prm.senddispls);
+  if(prm.sendtypes) free(prm.sendtypes);
+  if(prm.recvcounts) free(prm.recvcounts);
+  if(prm.recvdispls) free(prm.recvdispls);
+  if(prm.recvtypes) free(prm.recvtypes);
+}
+void report_MPI_Ireduce(fwrapper *wrapper, settings *opts) {
+  PREAMBLE(dumpi_ireduce);
+  DUMPI_ENTERING(MPI_Ireduce, prm, thread, cpu, wall, perf, opts);
+  DUMPI_CONVERT_INT(count);
+  DUMPI_CONVERT_DATATYPE(datatype);
+  DUMPI_CONVERT_OP(op);
+  DUMPI_CONVERT_INT(root);
+  DUMPI_CONVERT_COMM(comm);
+  DUMPI_CONVERT_REQUEST(request);
+  DUMPI_RETURNING(MPI_Ireduce, dumpi_write_ireduce, prm, thread, cpu, wall, perf, wrapper, opts);
+}
+void report_MPI_Iallreduce(fwrapper *wrapper, settings *opts) {
+  PREAMBLE(dumpi_iallreduce);
+  DUMPI_ENTERING(MPI_Iallreduce, prm, thread, cpu, wall, perf, opts);
+  DUMPI_CONVERT_INT(count);
+  DUMPI_CONVERT_DATATYPE(datatype);
+  DUMPI_CONVERT_OP(op);
+  DUMPI_CONVERT_COMM(comm);
+  DUMPI_CONVERT_REQUEST(request);
+  DUMPI_RETURNING(MPI_Iallreduce, dumpi_write_iallreduce, prm, thread, cpu, wall, perf, wrapper, opts);
+}
+void report_MPI_Ireduce_scatter(fwrapper *wrapper, settings *opts) {
+  PREAMBLE(dumpi_ireduce_scatter);
+  DUMPI_ENTERING(MPI_Ireduce_scatter, prm, thread, cpu, wall, perf, opts);
+  DUMPI_CONVERT_INT(commsize);
+  DUMPI_CONVERT_INT_ARRAY_1(commsize, recvcounts);
+  DUMPI_CONVERT_DATATYPE(datatype);
+  DUMPI_CONVERT_OP(op);
+  DUMPI_CONVERT_COMM(comm);
+  DUMPI_CONVERT_REQUEST(request);
+  DUMPI_RETURNING(MPI_Ireduce_scatter, dumpi_write_ireduce_scatter, prm, thread, cpu, wall, perf, wrapper, opts);
+  if(prm.recvcounts) free(prm.recvcounts);
+}
+void report_MPI_Iscan(fwrapper *wrapper, settings *opts) {
+  PREAMBLE(dumpi_iscan);
+  DUMPI_ENTERING(MPI_Iscan, prm, thread, cpu, wall, perf, opts);
+  DUMPI_CONVERT_INT(count);
+  DUMPI_CONVERT_DATATYPE(datatype);
+  DUMPI_CONVERT_OP(op);
+  DUMPI_CONVERT_COMM(comm);
+  DUMPI_CONVERT_REQUEST(request);
+  DUMPI_RETURNING(MPI_Iscan, dumpi_write_iscan, prm, thread, cpu, wall, perf, wrapper, opts);
+}
+void report_MPI_Iexscan(fwrapper *wrapper, settings *opts) {
+  PREAMBLE(dumpi_iexscan);
+  DUMPI_ENTERING(MPI_Iexscan, prm, thread, cpu, wall, perf, opts);
+  DUMPI_CONVERT_INT(count);
+  DUMPI_CONVERT_DATATYPE(datatype);
+  DUMPI_CONVERT_OP(op);
+  DUMPI_CONVERT_COMM(comm);
+  DUMPI_CONVERT_REQUEST(request);
+  DUMPI_RETURNING(MPI_Iexscan, dumpi_write_iexscan, prm, thread, cpu, wall, perf, wrapper, opts);
+}
+void report_MPI_Dist_graph_create_adjacent(fwrapper *wrapper, settings *opts) {
+  PREAMBLE(dumpi_dist_graph_create_adjacent);
+  DUMPI_ENTERING(MPI_Dist_graph_create_adjacent, prm, thread, cpu, wall, perf, opts);
+  DUMPI_CONVERT_COMM(oldcomm);
+  DUMPI_CONVERT_INT(indegree);
+  DUMPI_CONVERT_INT_ARRAY_1(indegree, sources);
+  DUMPI_CONVERT_INT(outdegree);
+  DUMPI_CONVERT_INT_ARRAY_1(outdegree, destinations);
+  DUMPI_CONVERT_INT(reorder);
+  DUMPI_CONVERT_COMM(newcomm);
+  DUMPI_RETURNING(MPI_Dist_graph_create_adjacent, dumpi_write_dist_graph_create_adjacent, prm, thread, cpu, wall, perf, wrapper, opts);
+  if(prm.sources) free(prm.sources);
+  if(prm.destinations) free(prm.destinations);
+}
+void report_MPI_Neighbor_allgather(fwrapper *wrapper, settings *opts) {
+  PREAMBLE(dumpi_neighbor_allgather);
+  DUMPI_ENTERING(MPI_Neighbor_allgather, prm, thread, cpu, wall, perf, opts);
+  DUMPI_CONVERT_INT(sendcount);
+  DUMPI_CONVERT_DATATYPE(sendtype);
+  DUMPI_CONVERT_INT(recvcount);
+  DUMPI_CONVERT_DATATYPE(recvtype);
+  DUMPI_CONVERT_COMM(comm);
+  DUMPI_RETURNING(MPI_Neighbor_allgather, dumpi_write_neighbor_allgather, prm, thread, cpu, wall, perf, wrapper, opts);
+}
+void report_MPI_Neighbor_allgatherv(fwrapper *wrapper, settings *opts) {
+  PREAMBLE(dumpi_neighbor_allgatherv);
+  DUMPI_ENTERING(MPI_Neighbor_allgatherv, prm, thread, cpu, wall, perf, opts);
+  DUMPI_CONVERT_INT(indegree);
+  DUMPI_CONVERT_INT(sendcount);
+  DUMPI_CONVERT_DATATYPE(sendtype);
+  DUMPI_CONVERT_INT_ARRAY_1(indegree, recvcounts);
+  DUMPI_CONVERT_INT_ARRAY_1(indegree, displs);
+  DUMPI_CONVERT_DATATYPE(recvtype);
+  DUMPI_CONVERT_COMM(comm);
+  DUMPI_RETURNING(MPI_Neighbor_allgatherv, dumpi_write_neighbor_allgatherv, prm, thread, cpu, wall, perf, wrapper, opts);
+  if(prm.recvcounts) free(prm.recvcounts);
+  if(prm.displs) free(prm.displs);
+}
+void report_MPI_Neighbor_alltoall(fwrapper *wrapper, settings *opts) {
+  PREAMBLE(dumpi_neighbor_alltoall);
+  DUMPI_ENTERING(MPI_Neighbor_alltoall, prm, thread, cpu, wall, perf, opts);
+  DUMPI_CONVERT_INT(sendcount);
+  DUMPI_CONVERT_DATATYPE(sendtype);
+  DUMPI_CONVERT_INT(recvcount);
+  DUMPI_CONVERT_DATATYPE(recvtype);
+  DUMPI_CONVERT_COMM(comm);
+  DUMPI_RETURNING(MPI_Neighbor_alltoall, dumpi_write_neighbor_alltoall, prm, thread, cpu, wall, perf, wrapper, opts);
+}
+void report_MPI_Neighbor_alltoallv(fwrapper *wrapper, settings *opts) {
+  PREAMBLE(dumpi_neighbor_alltoallv);
+  DUMPI_ENTERING(MPI_Neighbor_alltoallv, prm, thread, cpu, wall, perf, opts);
+  DUMPI_CONVERT_INT(indegree);
+  DUMPI_CONVERT_INT(outdegree);
+  DUMPI_CONVERT_INT_ARRAY_1(outdegree, sendcounts);
+  DUMPI_CONVERT_INT_ARRAY_1(outdegree, senddispls);
+  DUMPI_CONVERT_DATATYPE(sendtype);
+  DUMPI_CONVERT_INT_ARRAY_1(indegree, recvcounts);
+  DUMPI_CONVERT_INT_ARRAY_1(indegree, recvdispls);
+  DUMPI_CONVERT_DATATYPE(recvtype);
+  DUMPI_CONVERT_COMM(comm);
+  DUMPI_RETURNING(MPI_Neighbor_alltoallv, dumpi_write_neighbor_alltoallv, prm, thread, cpu, wall, perf, wrapper, opts);
+  if(prm.sendcounts) free(prm.sendcounts);
+  if(prm.senddispls) free(prm.senddispls);
+  if(prm.recvcounts) free(prm.recvcounts);
+  if(prm.recvdispls) free(prm.recvdispls);
+}
+void report_MPI_Neighbor_alltoallw(fwrapper *wrapper, settings *opts) {
+  PREAMBLE(dumpi_neighbor_alltoallw);
+  DUMPI_ENTERING(MPI_Neighbor_alltoallw, prm, thread, cpu, wall, perf, opts);
+  DUMPI_CONVERT_INT(indegree);
+  DUMPI_CONVERT_INT(outdegree);
+  DUMPI_CONVERT_INT_ARRAY_1(outdegree, sendcounts);
+  DUMPI_CONVERT_INT_ARRAY_1(outdegree, senddispls);
+  DUMPI_CONVERT_DATATYPE_ARRAY_1(outdegree, sendtypes);
+  DUMPI_CONVERT_INT_ARRAY_1(indegree, recvcounts);
+  DUMPI_CONVERT_INT_ARRAY_1(indegree, recvdispls);
+  DUMPI_CONVERT_DATATYPE_ARRAY_1(indegree, recvtypes);
+  DUMPI_CONVERT_COMM(comm);
+  DUMPI_RETURNING(MPI_Neighbor_alltoallw, dumpi_write_neighbor_alltoallw, prm, thread, cpu, wall, perf, wrapper, opts);
+  if(prm.sendcounts) free(prm.sendcounts);
+  if(prm.senddispls) free(prm.senddispls);
+  if(prm.sendtypes) free(prm.sendtypes);
+  if(prm.recvcounts) free(prm.recvcounts);
+  if(prm.recvdispls) free(prm.recvdispls);
+  if(prm.recvtypes) free(prm.recvtypes);
+}
+void report_MPI_Mprobe(fwrapper *wrapper, settings *opts) {
+  PREAMBLE(dumpi_mprobe);
+  DUMPI_ENTERING(MPI_Mprobe, prm, thread, cpu, wall, perf, opts);
+  DUMPI_CONVERT_SOURCE(source);
+  DUMPI_CONVERT_TAG(tag);
+  DUMPI_CONVERT_COMM(comm);
+  DUMPI_CONVERT_MESSAGE(message);
+  DUMPI_CONVERT_STATUS_PTR(status);
+  DUMPI_RETURNING(MPI_Mprobe, dumpi_write_mprobe, prm, thread, cpu, wall, perf, wrapper, opts);
+  if(prm.status) free(prm.status);
+}
+void report_MPI_Improbe(fwrapper *wrapper, settings *opts) {
+  PREAMBLE(dumpi_improbe);
+  DUMPI_ENTERING(MPI_Improbe, prm, thread, cpu, wall, perf, opts);
+  DUMPI_CONVERT_SOURCE(source);
+  DUMPI_CONVERT_TAG(tag);
+  DUMPI_CONVERT_COMM(comm);
+  DUMPI_CONVERT_INT(flag);
+  DUMPI_CONVERT_MESSAGE(message);
+  DUMPI_CONVERT_STATUS_PTR(status);
+  DUMPI_RETURNING(MPI_Improbe, dumpi_write_improbe, prm, thread, cpu, wall, perf, wrapper, opts);
+  if(prm.status) free(prm.status);
+}
+void report_MPI_Mrecv(fwrapper *wrapper, settings *opts) {
+  PREAMBLE(dumpi_mrecv);
+  DUMPI_ENTERING(MPI_Mrecv, prm, thread, cpu, wall, perf, opts);
+  DUMPI_CONVERT_INT(count);
+  DUMPI_CONVERT_DATATYPE(datatype);
+  DUMPI_CONVERT_MESSAGE(message);
+  DUMPI_CONVERT_STATUS_PTR(status);
+  DUMPI_RETURNING(MPI_Mrecv, dumpi_write_mrecv, prm, thread, cpu, wall, perf, wrapper, opts);
+  if(prm.status) free(prm.status);
+}
+void report_MPI_Imrecv(fwrapper *wrapper, settings *opts) {
+  PREAMBLE(dumpi_imrecv);
+  DUMPI_ENTERING(MPI_Imrecv, prm, thread, cpu, wall, perf, opts);
+  DUMPI_CONVERT_INT(count);
+  DUMPI_CONVERT_DATATYPE(datatype);
+  DUMPI_CONVERT_MESSAGE(message);
+  DUMPI_CONVERT_REQUEST(request);
+  DUMPI_RETURNING(MPI_Imrecv, dumpi_write_imrecv, prm, thread, cpu, wall, perf, wrapper, opts);
+}
 
 void report_Function_enter(fwrapper *wrapper, settings *opts) {
   PREAMBLE(dumpi_func_call);
@@ -4369,6 +4706,13 @@ void report_Function_exit(fwrapper *wrapper, settings *opts) {
   DUMPI_RETURNING(Function_exit, dumpi_write_func_exit, prm, thread, cpu, wall, perf, wrapper, opts);
 }
 
+void report_Function_call(fwrapper *wrapper, settings *opts) {
+  PREAMBLE(dumpi_func_call);
+  DUMPI_ENTERING(Function_call, prm, thread, cpu, wall, perf, opts);
+  DUMPI_CONVERT_FUNC(fn);
+  DUMPI_RETURNING(Function_call, dumpi_write_func_call, prm, thread, cpu, wall, perf, wrapper, opts);
+}
+
 /* Map function names to handlers */
 typedef struct funmap {
   const char *label;
@@ -4508,8 +4852,22 @@ static funmap handlers[] = {
   DMAP(MPIO_Waitall),                   DMAP(MPIO_Testany),
   DMAP(MPIO_Waitany),                   DMAP(MPIO_Waitsome),
   DMAP(MPIO_Testsome),
+  DMAP(MPI_Ibarrier),                   DMAP(MPI_Ibcast),
+  DMAP(MPI_Igather),                    DMAP(MPI_Igatherv),
+  DMAP(MPI_Iscatter),                   DMAP(MPI_Iscatterv),
+  DMAP(MPI_Iallgather),                 DMAP(MPI_Iallgatherv),
+  DMAP(MPI_Ialltoall),                  DMAP(MPI_Ialltoallv),
+  DMAP(MPI_Ialltoallw),                 DMAP(MPI_Ireduce),
+  DMAP(MPI_Iallreduce),                 DMAP(MPI_Ireduce_scatter),
+  DMAP(MPI_Iscan),                      DMAP(MPI_Iexscan),
+  DMAP(MPI_Dist_graph_create_adjacent), DMAP(MPI_Neighbor_allgather),
+  DMAP(MPI_Neighbor_allgatherv),        DMAP(MPI_Neighbor_alltoall),
+  DMAP(MPI_Neighbor_alltoallv),         DMAP(MPI_Neighbor_alltoallw),
+  DMAP(MPI_Mprobe),                     DMAP(MPI_Improbe),
+  DMAP(MPI_Mrecv),                      DMAP(MPI_Imrecv),
   {"Function_enter", report_Function_enter},
   {"Function_exit", report_Function_exit},
+  {"Function_call", report_Function_call},
   {NULL, NULL}
 };
 
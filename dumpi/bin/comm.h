@@ -13,6 +13,7 @@
 #define DUMPI_BIN_COMM_H
 
 #include <dumpi/bin/group.h>
+#include <vector>
 
 namespace dumpi {
 
@@ -37,16 +38,21 @@ namespace dumpi {
     commid index_;
     /// The group underlying this comm.
     group group_;
+    /// True if this comm has a process topology (cartesian or graph).
+    bool topology_;
+    /// Local ranks we receive from and send to in neighborhood collectives,
+    /// in the order the MPI standard gives them (-1 for MPI_PROC_NULL).
+    std::vector<int> sources_, destinations_;
 
   public:
     /// Create an empty (NULL) communicator.
   comm() :
-    index_(-1)
+    index_(-1), topology_(false)
       {}
 
     /// Create a communicator around a group.
   comm(commid index, const group &gg) :
-    index_(index), group_(gg)
+    index_(index), group_(gg), topology_(false)
     {
       if(group_.get_local_rank() < 0) {
 	// This node is not a member of the group -- turn this into a
@@ -75,6 +81,30 @@ namespace dumpi {
     bool is_null_comm() const {
       return index_ < 0;
     }
+
+    /// Attach the neighbors of a process topology to this comm.
+    void set_neighbors(const std::vector<int> &sources,
+                       const std::vector<int> &destinations)
+    {
+      topology_ = true;
+      sources_ = sources;
+      destinations_ = destinations;
+    }
+
+    /// Test whether this comm has a process topology.
+    bool has_topology() const {
+      return topology_;
+    }
+
+    /// Local ranks of the neighbors we receive from.
+    const std::vector<int>& get_sources() const {
+      return sources_;
+    }
+
+    /// Local ranks of the neighbors we send to.
+    const std::vector<int>& get_destinations() const {
+      return destinations_;
+    }
   };
 
   /*@}*/
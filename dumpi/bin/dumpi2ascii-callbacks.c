@@ -13,10 +13,12 @@
 #include <dumpi/libundumpi/callbacks.h>
 #include <dumpi/common/argtypes.h>
 #include <dumpi/common/constants.h>
+#include <dumpi/common/funcs.h>
 #include <dumpi/bin/dumpi2ascii-defs.h>
 #include <assert.h>
 
 d2a_addrmap *d2a_addr = NULL;
+const dumpi_profile *d2a_profile = NULL;
 
 int report_MPI_Send(const dumpi_send *prm, uint16_t thread, const dumpi_time *cpu, const dumpi_time *wall, const dumpi_perfinfo *perf, void *uarg) {
   DUMPI_ENTERING(MPI_Send, prm, thread, cpu, wall, perf);
@@ -523,9 +525,10 @@ int report_MPI_Gatherv(const dumpi_gatherv *prm, uint16_t thread, const dumpi_ti
   DUMPI_ENTERING(MPI_Gatherv, prm, thread, cpu, wall, perf);
   DUMPI_REPORT_INT(commrank);
   DUMPI_REPORT_INT(commsize);
+  DUMPI_REPORT_DETAIL();
   DUMPI_REPORT_INT(sendcount);
   DUMPI_REPORT_DATATYPE(sendtype);
-  DUMPI_REPORT_INT_ARRAY_1(prm->commsize, recvcounts);
+  DUMPI_REPORT_INT_COUNTS(prm->commsize, recvcounts);
   DUMPI_REPORT_INT_ARRAY_1(prm->commsize, displs);
   DUMPI_REPORT_DATATYPE(recvtype);
   DUMPI_REPORT_INT(root);
@@ -549,7 +552,8 @@ int report_MPI_Scatterv(const dumpi_scatterv *prm, uint16_t thread, const dumpi_
   DUMPI_ENTERING(MPI_Scatterv, prm, thread, cpu, wall, perf);
   DUMPI_REPORT_INT(commrank);
   DUMPI_REPORT_INT(commsize);
-  DUMPI_REPORT_INT_ARRAY_1(prm->commsize, sendcounts);
+  DUMPI_REPORT_DETAIL();
+  DUMPI_REPORT_INT_COUNTS(prm->commsize, sendcounts);
   DUMPI_REPORT_INT_ARRAY_1(prm->commsize, displs);
   DUMPI_REPORT_DATATYPE(sendtype);
   DUMPI_REPORT_INT(recvcount);
@@ -572,9 +576,10 @@ int report_MPI_Allgather(const dumpi_allgather *prm, uint16_t thread, const dump
 int report_MPI_Allgatherv(const dumpi_allgatherv *prm, uint16_t thread, const dumpi_time *cpu, const dumpi_time *wall, const dumpi_perfinfo *perf, void *uarg) {
   DUMPI_ENTERING(MPI_Allgatherv, prm, thread, cpu, wall, perf);
   DUMPI_REPORT_INT(commsize);
+  DUMPI_REPORT_DETAIL();
   DUMPI_REPORT_INT(sendcount);
   DUMPI_REPORT_DATATYPE(sendtype);
-  DUMPI_REPORT_INT_ARRAY_1(prm->commsize, recvcounts);
+  DUMPI_REPORT_INT_COUNTS(prm->commsize, recvcounts);
   DUMPI_REPORT_INT_ARRAY_1(prm->commsize, displs);
   DUMPI_REPORT_DATATYPE(recvtype);
   DUMPI_REPORT_COMM(comm);
@@ -594,10 +599,11 @@ int report_MPI_Alltoall(const dumpi_alltoall *prm, uint16_t thread, const dumpi_
 int report_MPI_Alltoallv(const dumpi_alltoallv *prm, uint16_t thread, const dumpi_time *cpu, const dumpi_time *wall, const dumpi_perfinfo *perf, void *uarg) {
   DUMPI_ENTERING(MPI_Alltoallv, prm, thread, cpu, wall, perf);
   DUMPI_REPORT_INT(commsize);
-  DUMPI_REPORT_INT_ARRAY_1(prm->commsize, sendcounts);
+  DUMPI_REPORT_DETAIL();
+  DUMPI_REPORT_INT_COUNTS(prm->commsize, sendcounts);
   DUMPI_REPORT_INT_ARRAY_1(prm->commsize, senddispls);
   DUMPI_REPORT_DATATYPE(sendtype);
-  DUMPI_REPORT_INT_ARRAY_1(prm->commsize, recvcounts);
+  DUMPI_REPORT_INT_COUNTS(prm->commsize, recvcounts);
   DUMPI_REPORT_INT_ARRAY_1(prm->commsize, recvdispls);
   DUMPI_REPORT_DATATYPE(recvtype);
   DUMPI_REPORT_COMM(comm);
@@ -639,7 +645,8 @@ int report_MPI_Allreduce(const dumpi_allreduce *prm, uint16_t thread, const dump
 int report_MPI_Reduce_scatter(const dumpi_reduce_scatter *prm, uint16_t thread, const dumpi_time *cpu, const dumpi_time *wall, const dumpi_perfinfo *perf, void *uarg) {
   DUMPI_ENTERING(MPI_Reduce_scatter, prm, thread, cpu, wall, perf);
   DUMPI_REPORT_INT(commsize);
-  DUMPI_REPORT_INT_ARRAY_1(prm->commsize, recvcounts);
+  DUMPI_REPORT_DETAIL();
+  DUMPI_REPORT_INT_COUNTS(prm->commsize, recvcounts);
   DUMPI_REPORT_DATATYPE(datatype);
   DUMPI_REPORT_OP(op);
   DUMPI_REPORT_COMM(comm);
@@ -1360,10 +1367,11 @@ int report_MPI_Win_wait(const dumpi_win_wait *prm, uint16_t thread, const dumpi_
 int report_MPI_Alltoallw(const dumpi_alltoallw *prm, uint16_t thread, const dumpi_time *cpu, const dumpi_time *wall, const dumpi_perfinfo *perf, void *uarg) {
   DUMPI_ENTERING(MPI_Alltoallw, prm, thread, cpu, wall, perf);
   DUMPI_REPORT_INT(commsize);
-  DUMPI_REPORT_INT_ARRAY_1(prm->commsize, sendcounts);
+  DUMPI_REPORT_DETAIL();
+  DUMPI_REPORT_INT_COUNTS(prm->commsize, sendcounts);
   DUMPI_REPORT_INT_ARRAY_1(prm->commsize, senddispls);
   DUMPI_REPORT_DATATYPE_ARRAY_1(prm->commsize, sendtypes);
-  DUMPI_REPORT_INT_ARRAY_1(prm->commsize, recvcounts);
+  DUMPI_REPORT_INT_COUNTS(prm->commsize, recvcounts);
   DUMPI_REPORT_INT_ARRAY_1(prm->commsize, recvdispls);
   DUMPI_REPORT_DATATYPE_ARRAY_1(prm->commsize, recvtypes);
   DUMPI_REPORT_COMM(comm);
@@ -2435,6 +2443,311 @@ int report_MPIO_Testsome(const dumpio_testsome *prm, uint16_t thread, const dump
   DUMPI_RETURNING(MPIO_Testsome, prm, thread, cpu, wall, perf);
 }
 
+int report_MPI_Ibarrier(const dumpi_ibarrier *prm, uint16_t thread, const dumpi_time *cpu, const dumpi_time *wall, const dumpi_perfinfo *perf, void *uarg) {
+  DUMPI_ENTERING(MPI_Ibarrier, prm, thread, cpu, wall, perf);
+  DUMPI_REPORT_COMM(comm);
+  DUMPI_REPORT_REQUEST(request);
+  DUMPI_RETURNING(MPI_Ibarrier, prm, thread, cpu, wall, perf);
+}
+
+int report_MPI_Ibcast(const dumpi_ibcast *prm, uint16_t thread, const dumpi_time *cpu, const dumpi_time *wall, const dumpi_perfinfo *perf, void *uarg) {
+  DUMPI_ENTERING(MPI_Ibcast, prm, thread, cpu, wall, perf);
+  DUMPI_REPORT_INT(count);
+  DUMPI_REPORT_DATATYPE(datatype);
+  DUMPI_REPORT_INT(root);
+  DUMPI_REPORT_COMM(comm);
+  DUMPI_REPORT_REQUEST(request);
+  DUMPI_RETURNING(MPI_Ibcast, prm, thread, cpu, wall, perf);
+}
+
+int report_MPI_Igather(const dumpi_igather *prm, uint16_t thread, const dumpi_time *cpu, const dumpi_time *wall, const dumpi_perfinfo *perf, void *uarg) {
+  DUMPI_ENTERING(MPI_Igather, prm, thread, cpu, wall, perf);
+  DUMPI_REPORT_INT(commrank);
+  DUMPI_REPORT_INT(sendcount);
+  DUMPI_REPORT_DATATYPE(sendtype);
+  DUMPI_REPORT_INT(recvcount);
+  DUMPI_REPORT_DATATYPE(recvtype);
+  DUMPI_REPORT_INT(root);
+  DUMPI_REPORT_COMM(comm);
+  DUMPI_REPORT_REQUEST(request);
+  DUMPI_RETURNING(MPI_Igather, prm, thread, cpu, wall, perf);
+}
+
+int report_MPI_Igatherv(const dumpi_igatherv *prm, uint16_t thread, const dumpi_time *cpu, const dumpi_time *wall, const dumpi_perfinfo *perf, void *uarg) {
+  DUMPI_ENTERING(MPI_Igatherv, prm, thread, cpu, wall, perf);
+  DUMPI_REPORT_INT(commrank);
+  DUMPI_REPORT_INT(commsize);
+  DUMPI_REPORT_DETAIL();
+  DUMPI_REPORT_INT(sendcount);
+  DUMPI_REPORT_DATATYPE(sendtype);
+  DUMPI_REPORT_INT_COUNTS(prm->commsize, recvcounts);
+  DUMPI_REPORT_INT_ARRAY_1(prm->commsize, displs);
+  DUMPI_REPORT_DATATYPE(recvtype);
+  DUMPI_REPORT_INT(root);
+  DUMPI_REPORT_COMM(comm);
+  DUMPI_REPORT_REQUEST(request);
+  DUMPI_RETURNING(MPI_Igatherv, prm, thread, cpu, wall, perf);
+}
+
+int report_MPI_Iscatter(const dumpi_iscatter *prm, uint16_t thread, const dumpi_time *cpu, const dumpi_time *wall, const dumpi_perfinfo *perf, void *uarg) {
+  DUMPI_ENTERING(MPI_Iscatter, prm, thread, cpu, wall, perf);
+  DUMPI_REPORT_INT(commrank);
+  DUMPI_REPORT_INT(sendcount);
+  DUMPI_REPORT_DATATYPE(sendtype);
+  DUMPI_REPORT_INT(recvcount);
+  DUMPI_REPORT_DATATYPE(recvtype);
+  DUMPI_REPORT_INT(root);
+  DUMPI_REPORT_COMM(comm);
+  DUMPI_REPORT_REQUEST(request);
+  DUMPI_RETURNING(MPI_Iscatter, prm, thread, cpu, wall, perf);
+}
+
+int report_MPI_Iscatterv(const dumpi_iscatterv *prm, uint16_t thread, const dumpi_time *cpu, const dumpi_time *wall, const dumpi_perfinfo *perf, void *uarg) {
+  DUMPI_ENTERING(MPI_Iscatterv, prm, thread, cpu, wall, perf);
+  DUMPI_REPORT_INT(commrank);
+  DUMPI_REPORT_INT(commsize);
+  DUMPI_REPORT_DETAIL();
+  DUMPI_REPORT_INT_COUNTS(prm->commsize, sendcounts);
+  DUMPI_REPORT_INT_ARRAY_1(prm->commsize, displs);
+  DUMPI_REPORT_DATATYPE(sendtype);
+  DUMPI_REPORT_INT(recvcount);
+  DUMPI_REPORT_DATATYPE(recvtype);
+  DUMPI_REPORT_INT(root);
+  DUMPI_REPORT_COMM(comm);
+  DUMPI_REPORT_REQUEST(request);
+  DUMPI_RETURNING(MPI_Iscatterv, prm, thread, cpu, wall, perf);
+}
+
+int report_MPI_Iallgather(const dumpi_iallgather *prm, uint16_t thread, const dumpi_time *cpu, const dumpi_time *wall, const dumpi_perfinfo *perf, void *uarg) {
+  DUMPI_ENTERING(MPI_Iallgather, prm, thread, cpu, wall, perf);
+  DUMPI_REPORT_INT(sendcount);
+  DUMPI_REPORT_DATATYPE(sendtype);
+  DUMPI_REPORT_INT(recvcount);
+  DUMPI_REPORT_DATATYPE(recvtype);
+  DUMPI_REPORT_COMM(comm);
+  DUMPI_REPORT_REQUEST(request);
+  DUMPI_RETURNING(MPI_Iallgather, prm, thread, cpu, wall, perf);
+}
+
+int report_MPI_Iallgatherv(const dumpi_iallgatherv *prm, uint16_t thread, const dumpi_time *cpu, const dumpi_time *wall, const dumpi_perfinfo *perf, void *uarg) {
+  DUMPI_ENTERING(MPI_Iallgatherv, prm, thread, cpu, wall, perf);
+  DUMPI_REPORT_INT(commsize);
+  DUMPI_REPORT_DETAIL();
+  DUMPI_REPORT_INT(sendcount);
+  DUMPI_REPORT_DATATYPE(sendtype);
+  DUMPI_REPORT_INT_COUNTS(prm->commsize, recvcounts);
+  DUMPI_REPORT_INT_ARRAY_1(prm->commsize, displs);
+  DUMPI_REPORT_DATATYPE(recvtype);
+  DUMPI_REPORT_COMM(comm);
+  DUMPI_REPORT_REQUEST(request);
+  DUMPI_RETURNING(MPI_Iallgatherv, prm, thread, cpu, wall, perf);
+}
+
+int report_MPI_Ialltoall(const dumpi_ialltoall *prm, uint16_t thread, const dumpi_time *cpu, const dumpi_time *wall, const dumpi_perfinfo *perf, void *uarg) {
+  DUMPI_ENTERING(MPI_Ialltoall, prm, thread, cpu, wall, perf);
+  DUMPI_REPORT_INT(sendcount);
+  DUMPI_REPORT_DATATYPE(sendtype);
+  DUMPI_REPORT_INT(recvcount);
+  DUMPI_REPORT_DATATYPE(recvtype);
+  DUMPI_REPORT_COMM(comm);
+  DUMPI_REPORT_REQUEST(request);
+  DUMPI_RETURNING(MPI_Ialltoall, prm, thread, cpu, wall, perf);
+}
+
+int report_MPI_Ialltoallv(const dumpi_ialltoallv *prm, uint16_t thread, const dumpi_time *cpu, const dumpi_time *wall, const dumpi_perfinfo *perf, void *uarg) {
+  DUMPI_ENTERING(MPI_Ialltoallv, prm, thread, cpu, wall, perf);
+  DUMPI_REPORT_INT(commsize);
+  DUMPI_REPORT_DETAIL();
+  DUMPI_REPORT_INT_COUNTS(prm->commsize, sendcounts);
+  DUMPI_REPORT_INT_ARRAY_1(prm->commsize, senddispls);
+  DUMPI_REPORT_DATATYPE(sendtype);
+  DUMPI_REPORT_INT_COUNTS(prm->commsize, recvcounts);
+  DUMPI_REPORT_INT_ARRAY_1(prm->commsize, recvdispls);
+  DUMPI_REPORT_DATATYPE(recvtype);
+  DUMPI_REPORT_COMM(comm);
+  DUMPI_REPORT_REQUEST(request);
+  DUMPI_RETURNING(MPI_Ialltoallv, prm, thread, cpu, wall, perf);
+}
+
+int report_MPI_Ialltoallw(const dumpi_ialltoallw *prm, uint16_t thread, const dumpi_time *cpu, const dumpi_time *wall, const dumpi_perfinfo *perf, void *uarg) {
+  DUMPI_ENTERING(MPI_Ialltoallw, prm, thread, cpu, wall, perf);
+  DUMPI_REPORT_INT(commsize);
+  DUMPI_REPORT_DETAIL();
+  DUMPI_REPORT_INT_COUNTS(prm->commsize, sendcounts);
+  DUMPI_REPORT_INT_ARRAY_1(prm->commsize, senddispls);
+  DUMPI_REPORT_DATATYPE_ARRAY_1(prm->commsize, sendtypes);
+  DUMPI_REPORT_INT_COUNTS(prm->commsize, recvcounts);
+  DUMPI_REPORT_INT_ARRAY_1(prm->commsize, recvdispls);
+  DUMPI_REPORT_DATATYPE_ARRAY_1(prm->commsize, recvtypes);
+  DUMPI_REPORT_COMM(comm);
+  DUMPI_REPORT_REQUEST(request);
+  DUMPI_RETURNING(MPI_Ialltoallw, prm, thread, cpu, wall, perf);
+}
+
+int report_MPI_Ireduce(const dumpi_ireduce *prm, uint16_t thread, const dumpi_time *cpu, const dumpi_time *wall, const dumpi_perfinfo *perf, void *uarg) {
+  DUMPI_ENTERING(MPI_Ireduce, prm, thread, cpu, wall, perf);
+  DUMPI_REPORT_INT(count);
+  DUMPI_REPORT_DATATYPE(datatype);
+  DUMPI_REPORT_OP(op);
+  DUMPI_REPORT_INT(root);
+  DUMPI_REPORT_COMM(comm);
+  DUMPI_REPORT_REQUEST(request);
+  DUMPI_RETURNING(MPI_Ireduce, prm, thread, cpu, wall, perf);
+}
+
+int report_MPI_Iallreduce(const dumpi_iallreduce *prm, uint16_t thread, const dumpi_time *cpu, const dumpi_time *wall, const dumpi_perfinfo *perf, void *uarg) {
+  DUMPI_ENTERING(MPI_Iallreduce, prm, thread, cpu, wall, perf);
+  DUMPI_REPORT_INT(count);
+  DUMPI_REPORT_DATATYPE(datatype);
+  DUMPI_REPORT_OP(op);
+  DUMPI_REPORT_COMM(comm);
+  DUMPI_REPORT_REQUEST(request);
+  DUMPI_RETURNING(MPI_Iallreduce, prm, thread, cpu, wall, perf);
+}
+
+int report_MPI_Ireduce_scatter(const dumpi_ireduce_scatter *prm, uint16_t thread, const dumpi_time *cpu, const dumpi_time *wall, const dumpi_perfinfo *perf, void *uarg) {
+  DUMPI_ENTERING(MPI_Ireduce_scatter, prm, thread, cpu, wall, perf);
+  DUMPI_REPORT_INT(commsize);
+  DUMPI_REPORT_DETAIL();
+  DUMPI_REPORT_INT_COUNTS(prm->commsize, recvcounts);
+  DUMPI_REPORT_DATATYPE(datatype);
+  DUMPI_REPORT_OP(op);
+  DUMPI_REPORT_COMM(comm);
+  DUMPI_REPORT_REQUEST(request);
+  DUMPI_RETURNING(MPI_Ireduce_scatter, prm, thread, cpu, wall, perf);
+}
+
+int report_MPI_Iscan(const dumpi_iscan *prm, uint16_t thread, const dumpi_time *cpu, const dumpi_time *wall, const dumpi_perfinfo *perf, void *uarg) {
+  DUMPI_ENTERING(MPI_Iscan, prm, thread, cpu, wall, perf);
+  DUMPI_REPORT_INT(count);
+  DUMPI_REPORT_DATATYPE(datatype);
+  DUMPI_REPORT_OP(op);
+  DUMPI_REPORT_COMM(comm);
+  DUMPI_REPORT_REQUEST(request);
+  DUMPI_RETURNING(MPI_Iscan, prm, thread, cpu, wall, perf);
+}
+
+int report_MPI_Iexscan(const dumpi_iexscan *prm, uint16_t thread, const dumpi_time *cpu, const dumpi_time *wall, const dumpi_perfinfo *perf, void *uarg) {
+  DUMPI_ENTERING(MPI_Iexscan, prm, thread, cpu, wall, perf);
+  DUMPI_REPORT_INT(count);
+  DUMPI_REPORT_DATATYPE(datatype);
+  DUMPI_REPORT_OP(op);
+  DUMPI_REPORT_COMM(comm);
+  DUMPI_REPORT_REQUEST(request);
+  DUMPI_RETURNING(MPI_Iexscan, prm, thread, cpu, wall, perf);
+}
+
+int report_MPI_Dist_graph_create_adjacent(const dumpi_dist_graph_create_adjacent *prm, uint16_t thread, const dumpi_time *cpu, const dumpi_time *wall, const dumpi_perfinfo *perf, void *uarg) {
+  DUMPI_ENTERING(MPI_Dist_graph_create_adjacent, prm, thread, cpu, wall, perf);
+  DUMPI_REPORT_COMM(oldcomm);
+  DUMPI_REPORT_INT(indegree);
+  DUMPI_REPORT_INT_ARRAY_1(prm->indegree, sources);
+  DUMPI_REPORT_INT(outdegree);
+  DUMPI_REPORT_INT_ARRAY_1(prm->outdegree, destinations);
+  DUMPI_REPORT_INT(reorder);
+  DUMPI_REPORT_COMM(newcomm);
+  DUMPI_RETURNING(MPI_Dist_graph_create_adjacent, prm, thread, cpu, wall, perf);
+}
+
+int report_MPI_Neighbor_allgather(const dumpi_neighbor_allgather *prm, uint16_t thread, const dumpi_time *cpu, const dumpi_time *wall, const dumpi_perfinfo *perf, void *uarg) {
+  DUMPI_ENTERING(MPI_Neighbor_allgather, prm, thread, cpu, wall, perf);
+  DUMPI_REPORT_INT(sendcount);
+  DUMPI_REPORT_DATATYPE(sendtype);
+  DUMPI_REPORT_INT(recvcount);
+  DUMPI_REPORT_DATATYPE(recvtype);
+  DUMPI_REPORT_COMM(comm);
+  DUMPI_RETURNING(MPI_Neighbor_allgather, prm, thread, cpu, wall, perf);
+}
+
+int report_MPI_Neighbor_allgatherv(const dumpi_neighbor_allgatherv *prm, uint16_t thread, const dumpi_time *cpu, const dumpi_time *wall, const dumpi_perfinfo *perf, void *uarg) {
+  DUMPI_ENTERING(MPI_Neighbor_allgatherv, prm, thread, cpu, wall, perf);
+  DUMPI_REPORT_INT(indegree);
+  DUMPI_REPORT_INT(sendcount);
+  DUMPI_REPORT_DATATYPE(sendtype);
+  DUMPI_REPORT_INT_ARRAY_1(prm->indegree, recvcounts);
+  DUMPI_REPORT_INT_ARRAY_1(prm->indegree, displs);
+  DUMPI_REPORT_DATATYPE(recvtype);
+  DUMPI_REPORT_COMM(comm);
+  DUMPI_RETURNING(MPI_Neighbor_allgatherv, prm, thread, cpu, wall, perf);
+}
+
+int report_MPI_Neighbor_alltoall(const dumpi_neighbor_alltoall *prm, uint16_t thread, const dumpi_time *cpu, const dumpi_time *wall, const dumpi_perfinfo *perf, void *uarg) {
+  DUMPI_ENTERING(MPI_Neighbor_alltoall, prm, thread, cpu, wall, perf);
+  DUMPI_REPORT_INT(sendcount);
+  DUMPI_REPORT_DATATYPE(sendtype);
+  DUMPI_REPORT_INT(recvcount);
+  DUMPI_REPORT_DATATYPE(recvtype);
+  DUMPI_REPORT_COMM(comm);
+  DUMPI_RETURNING(MPI_Neighbor_alltoall, prm, thread, cpu, wall, perf);
+}
+
+int report_MPI_Neighbor_alltoallv(const dumpi_neighbor_alltoallv *prm, uint16_t thread, const dumpi_time *cpu, const dumpi_time *wall, const dumpi_perfinfo *perf, void *uarg) {
+  DUMPI_ENTERING(MPI_Neighbor_alltoallv, prm, thread, cpu, wall, perf);
+  DUMPI_REPORT_INT(indegree);
+  DUMPI_REPORT_INT(outdegree);
+  DUMPI_REPORT_INT_ARRAY_1(prm->outdegree, sendcounts);
+  DUMPI_REPORT_INT_ARRAY_1(prm->outdegree, senddispls);
+  DUMPI_REPORT_DATATYPE(sendtype);
+  DUMPI_REPORT_INT_ARRAY_1(prm->indegree, recvcounts);
+  DUMPI_REPORT_INT_ARRAY_1(prm->indegree, recvdispls);
+  DUMPI_REPORT_DATATYPE(recvtype);
+  DUMPI_REPORT_COMM(comm);
+  DUMPI_RETURNING(MPI_Neighbor_alltoallv, prm, thread, cpu, wall, perf);
+}
+
+int report_MPI_Neighbor_alltoallw(const dumpi_neighbor_alltoallw *prm, uint16_t thread, const dumpi_time *cpu, const dumpi_time *wall, const dumpi_perfinfo *perf, void *uarg) {
+  DUMPI_ENTERING(MPI_Neighbor_alltoallw, prm, thread, cpu, wall, perf);
+  DUMPI_REPORT_INT(indegree);
+  DUMPI_REPORT_INT(outdegree);
+  DUMPI_REPORT_INT_ARRAY_1(prm->outdegree, sendcounts);
+  DUMPI_REPORT_INT_ARRAY_1(prm->outdegree, senddispls);
+  DUMPI_REPORT_DATATYPE_ARRAY_1(prm->outdegree, sendtypes);
+  DUMPI_REPORT_INT_ARRAY_1(prm->indegree, recvcounts);
+  DUMPI_REPORT_INT_ARRAY_1(prm->indegree, recvdispls);
+  DUMPI_REPORT_DATATYPE_ARRAY_1(prm->indegree, recvtypes);
+  DUMPI_REPORT_COMM(comm);
+  DUMPI_RETURNING(MPI_Neighbor_alltoallw, prm, thread, cpu, wall, perf);
+}
+
+int report_MPI_Mprobe(const dumpi_mprobe *prm, uint16_t thread, const dumpi_time *cpu, const dumpi_time *wall, const dumpi_perfinfo *perf, void *uarg) {
+  DUMPI_ENTERING(MPI_Mprobe, prm, thread, cpu, wall, perf);
+  DUMPI_REPORT_SOURCE(source);
+  DUMPI_REPORT_TAG(tag);
+  DUMPI_REPORT_COMM(comm);
+  DUMPI_REPORT_MESSAGE(message);
+  DUMPI_REPORT_STATUS_PTR(status);
+  DUMPI_RETURNING(MPI_Mprobe, prm, thread, cpu, wall, perf);
+}
+
+int report_MPI_Improbe(const dumpi_improbe *prm, uint16_t thread, const dumpi_time *cpu, const dumpi_time *wall, const dumpi_perfinfo *perf, void *uarg) {
+  DUMPI_ENTERING(MPI_Improbe, prm, thread, cpu, wall, perf);
+  DUMPI_REPORT_SOURCE(source);
+  DUMPI_REPORT_TAG(tag);
+  DUMPI_REPORT_COMM(comm);
+  DUMPI_REPORT_INT(flag);
+  DUMPI_REPORT_MESSAGE(message);
+  DUMPI_REPORT_STATUS_PTR(status);
+  DUMPI_RETURNING(MPI_Improbe, prm, thread, cpu, wall, perf);
+}
+
+int report_MPI_Mrecv(const dumpi_mrecv *prm, uint16_t thread, const dumpi_time *cpu, const dumpi_time *wall, const dumpi_perfinfo *perf, void *uarg) {
+  DUMPI_ENTERING(MPI_Mrecv, prm, thread, cpu, wall, perf);
+  DUMPI_REPORT_INT(count);
+  DUMPI_REPORT_DATATYPE(datatype);
+  DUMPI_REPORT_MESSAGE(message);
+  DUMPI_REPORT_STATUS_PTR(status);
+  DUMPI_RETURNING(MPI_Mrecv, prm, thread, cpu, wall, perf);
+}
+
+int report_MPI_Imrecv(const dumpi_imrecv *prm, uint16_t thread, const dumpi_time *cpu, const dumpi_time *wall, const dumpi_perfinfo *perf, void *uarg) {
+  DUMPI_ENTERING(MPI_Imrecv, prm, thread, cpu, wall, perf);
+  DUMPI_REPORT_INT(count);
+  DUMPI_REPORT_DATATYPE(datatype);
+  DUMPI_REPORT_MESSAGE(message);
+  DUMPI_REPORT_REQUEST(request);
+  DUMPI_RETURNING(MPI_Imrecv, prm, thread, cpu, wall, perf);
+}
+
 int report_Function_enter(const dumpi_func_call *prm, uint16_t thread, const dumpi_time *cpu, const dumpi_time *wall, const dumpi_perfinfo *perf, void *uarg) {
   DUMPI_ENTERING(Function_enter, prm, thread, cpu, wall, perf);
   DUMPI_REPORT_FUNC(fn);
@@ -2447,6 +2760,23 @@ int report_Function_exit(const dumpi_func_call *prm, uint16_t thread, const dump
   DUMPI_RETURNING(Function_exit, prm, thread, cpu, wall, perf);
 }
 
+int report_Function_call(const dumpi_func_call *prm, uint16_t thread, const dumpi_time *cpu, const dumpi_time *wall, const dumpi_perfinfo *perf, void *uarg) {
+  DUMPI_ENTERING(Function_call, prm, thread, cpu, wall, perf);
+  DUMPI_REPORT_FUNC(fn);
+  DUMPI_RETURNING(Function_call, prm, thread, cpu, wall, perf);
+}
+
+int report_Poll_summary(const dumpi_poll_summary *prm, uint16_t thread, const dumpi_time *cpu, const dumpi_time *wall, const dumpi_perfinfo *perf, void *uarg) {
+  DUMPI_ENTERING(Poll_summary, prm, thread, cpu, wall, perf);
+  DUMPI_REPORT_INLINE_PAIR(function, dumpi_get_function_name);
+  DUMPI_REPORT_INLINE(count, "%u", (unsigned)prm->count);
+  DUMPI_REPORT_INLINE(incall, "{\"walltime\": %d.%09d, \"cputime\": %d.%09d}",
+                      prm->incall_wall.sec, prm->incall_wall.nsec,
+                      prm->incall_cpu.sec, prm->incall_cpu.nsec);
+  DUMPI_REPORT_INT_ARRAY_1(prm->argcount, args);
+  DUMPI_RETURNING(Poll_summary, prm, thread, cpu, wall, perf);
+}
+
 void set_callbacks(libundumpi_callbacks *cbacks) {
   assert(cbacks != NULL);
   cbacks->on_send                      = report_MPI_Send                     ;
@@ -2738,7 +3068,35 @@ void set_callbacks(libundumpi_callbacks *cbacks) {
   cbacks->on_iowaitany                 = report_MPIO_Waitany                 ;
   cbacks->on_iowaitsome                = report_MPIO_Waitsome                ;
   cbacks->on_iotestsome                = report_MPIO_Testsome                ;
+  cbacks->on_ibarrier                  = report_MPI_Ibarrier                   ;
+  cbacks->on_ibcast                    = report_MPI_Ibcast                     ;
+  cbacks->on_igather                   = report_MPI_Igather                    ;
+  cbacks->on_igatherv                  = report_MPI_Igatherv                   ;
+  cbacks->on_iscatter                  = report_MPI_Iscatter                   ;
+  cbacks->on_iscatterv                 = report_MPI_Iscatterv                  ;
+  cbacks->on_iallgather                = report_MPI_Iallgather                 ;
+  cbacks->on_iallgatherv               = report_MPI_Iallgatherv                ;
+  cbacks->on_ialltoall                 = report_MPI_Ialltoall                  ;
+  cbacks->on_ialltoallv                = report_MPI_Ialltoallv                 ;
+  cbacks->on_ialltoallw                = report_MPI_Ialltoallw                 ;
+  cbacks->on_ireduce                   = report_MPI_Ireduce                    ;
+  cbacks->on_iallreduce                = report_MPI_Iallreduce                 ;
+  cbacks->on_ireduce_scatter           = report_MPI_Ireduce_scatter            ;
+  cbacks->on_iscan                     = report_MPI_Iscan                      ;
+  cbacks->on_iexscan                   = report_MPI_Iexscan                    ;
+  cbacks->on_dist_graph_create_adjacent= report_MPI_Dist_graph_create_adjacent ;
+  cbacks->on_neighbor_allgather        = report_MPI_Neighbor_allgather         ;
+  cbacks->on_neighbor_allgatherv       = report_MPI_Neighbor_allgatherv        ;
+  cbacks->on_neighbor_alltoall         = report_MPI_Neighbor_alltoall          ;
+  cbacks->on_neighbor_alltoallv        = report_MPI_Neighbor_alltoallv         ;
+  cbacks->on_neighbor_alltoallw        = report_MPI_Neighbor_alltoallw         ;
+  cbacks->on_mprobe                    = report_MPI_Mprobe                     ;
+  cbacks->on_improbe                   = report_MPI_Improbe                    ;
+  cbacks->on_mrecv                     = report_MPI_Mrecv                      ;
+  cbacks->on_imrecv                    = report_MPI_Imrecv                     ;
   cbacks->on_function_enter            = report_Function_enter               ;
   cbacks->on_function_exit             = report_Function_exit                ;
+  cbacks->on_poll_summary              = report_Poll_summary                 ;
+  cbacks->on_function_call             = report_Function_call                ;
 }
 
@@ -45,6 +45,9 @@ typedef struct d2a_addrmap {
 /** The shared container for address mapping */
 extern d2a_addrmap *d2a_addr;
 
+/** The trace being read (for the call site of each record) */
+extern const dumpi_profile *d2a_profile;
+
 /** Define all our callbacks. */
 void set_callbacks(libundumpi_callbacks *cbacks);
 
@@ -127,6 +127,8 @@ static inline void print_requests(const dumpi_request *req, int count) {
     (void)uarg;						    \
     fprintf(dumpfh,"{" DUMPI_EOL DUMPI_INDENT "\"event\":\"" #METHOD "\"," DUMPI_EOL); \
     DUMPI_THREAD_STATS(METHOD, THREAD, CPU, WALL, PERF, entering); \
+    if(d2a_profile != NULL && d2a_profile->callsite != 0)	    \
+      DUMPI_REPORT_INLINE(callsite, "%u", d2a_profile->callsite);   \
     DUMPI_PUT_PERF_IN(PERF);				    \
 } while(0)
 #ifndef ENTERING
@@ -206,6 +208,41 @@ static inline void print_requests(const dumpi_request *req, int count) {
 } while(0)
 #ifndef REPORT_INT_ARRAY_1
 #define REPORT_INT_ARRAY_1 DUMPI_REPORT_INT_ARRAY_1
+#endif
+
+  /**
+   * Print how the arrays of a vector collective were stored
+   * (nothing for full records).
+   */
+#define DUMPI_REPORT_DETAIL() do {                                \
+  if(prm->detail == DUMPI_DETAIL_SUMMARIZED)                      \
+    DUMPI_REPORT_INLINE(detail, "\"summarized\"");               \
+  else if(prm->detail == DUMPI_DETAIL_SPARSE)                     \
+    DUMPI_REPORT_INLINE(detail, "\"sparse\"");                   \
+} while(0)
+#ifndef REPORT_DETAIL
+#define REPORT_DETAIL DUMPI_REPORT_DETAIL
+#endif
+
+  /**
+   * Print a count array of a vector collective, or its summary
+   * (TTAG_summary) if the record was stored summarized.
+   */
+#define DUMPI_REPORT_INT_COUNTS(LEN, TTAG) do {                   \
+  if(prm->detail == DUMPI_DETAIL_SUMMARIZED) {                    \
+    DUMPI_REPORT_INLINE(TTAG, "{\"total\": %lld, \"min\": %d, "    \
+                        "\"max\": %d, \"nonzero\": %d}",          \
+                        (long long)prm->TTAG##_summary.total,     \
+                        prm->TTAG##_summary.min,                  \
+                        prm->TTAG##_summary.max,                  \
+                        prm->TTAG##_summary.nonzero);             \
+  }                                                               \
+  else {                                                          \
+    DUMPI_REPORT_INT_ARRAY_1(LEN, TTAG);                          \
+  }                                                               \
+} while(0)
+#ifndef REPORT_INT_COUNTS
+#define REPORT_INT_COUNTS DUMPI_REPORT_INT_COUNTS
 #endif
 
   /** Print the name of an int64_t variable and its value. */
@@ -584,6 +621,13 @@ static inline void print_requests(const dumpi_request *req, int count) {
   DUMPI_REPORT_INLINE_PAIR(TTAG, dumpi_get_comparison_name)
 #ifndef REPORT_DUMPI_COMPARISON
 #define REPORT_DUMPI_COMPARISON DUMPI_REPORT_COMPARISON
+#endif
+
+  /** Report the name, value, and description of a message handle */
+#define DUMPI_REPORT_MESSAGE(TTAG)                      \
+  DUMPI_REPORT_INLINE_PAIR(TTAG, dumpi_get_message_name)
+#ifndef REPORT_DUMPI_MESSAGE
+#define REPORT_DUMPI_MESSAGE DUMPI_REPORT_MESSAGE
 #endif
 
   /** print the name and values of a data type array variable */
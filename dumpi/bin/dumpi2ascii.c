@@ -33,6 +33,7 @@ typedef struct d2aopt {
   int verbose, help;
   int read_header, read_stream, read_keyval, read_footer, read_perf;
   int read_addresses, read_sizes;
+  int sync_clocks;
   const char *file;
 } d2aopt;
 
@@ -59,6 +60,9 @@ int main(int argc, char **argv) {
   if((profile = undumpi_open(opt.file)) == NULL) {
     return 2;
   }
+  if(opt.sync_clocks && ! undumpi_sync_clocks(profile))
+    fprintf(stderr, "%s has no clock-sync information;  wall times are "
+	    "printed as recorded\n", opt.file);
   if(opt.read_header) {
     dumpi_header *head = undumpi_read_header(profile);
     print_header(head);
@@ -70,7 +74,9 @@ int main(int argc, char **argv) {
     assert(d2a_addr != NULL);
     dumpi_read_function_addresses(profile, &(d2a_addr->count),
 				  &(d2a_addr->address), &(d2a_addr->name));
+    d2a_profile = profile;
     undumpi_read_stream(profile, &cback, DUMPI_UARG);
+    d2a_profile = NULL;
     for(i = 0; i < d2a_addr->count; ++i)
       free(d2a_addr->name[i]);
     free(d2a_addr->address);
@@ -125,7 +131,7 @@ int parse_options(int argc, char **argv, d2aopt *settings) {
   int opt;
   assert(settings != NULL);
   memset(settings, 0, sizeof(d2aopt));
-  while((opt = getopt(argc, argv, "vhaHSKFPAXf:")) != -1) {
+  while((opt = getopt(argc, argv, "vhaHSKFPAXCf:")) != -1) {
     switch(opt) {
     case 'v':
       if(settings->verbose) dumpi_debug = DUMPI_DEBUG_ALL;
@@ -154,6 +160,8 @@ int parse_options(int argc, char **argv, d2aopt *settings) {
       settings->read_addresses = 1; break;
     case 'X':
       settings->read_sizes = 1; break;
+    case 'C':
+      settings->sync_clocks = 1; break;
     case 'f':
       settings->file = strdup(optarg);
       break;
@@ -176,6 +184,7 @@ int parse_options(int argc, char **argv, d2aopt *settings) {
 	      "        -P               Print PAPI counter information\n"
 	      "        -A               Print function address labels\n"
 	      "        -X               Print type sizes\n"
+	      "        -C               Put wall times on the clock of rank 0\n"
 	      "        -f  filename     Read the given binary tracefile\n",
 	      argv[0]);
       break;
@@ -242,6 +251,24 @@ void print_footer(const dumpi_footer *foot) {
 	    dumpi_function_names[i], foot->call_count[i],
 	    foot->ignored_count[i]);
   }
+  /* Overhead and writer statistics were added in version 1.1.1 */
+  for(i = 0; i <= DUMPI_ALL_FUNCTIONS; ++i) {
+    const dumpi_clock *wall = &foot->overhead_wall[i];
+    const dumpi_clock *cpu = &foot->overhead_cpu[i];
+    if(wall->sec || wall->nsec || cpu->sec || cpu->nsec)
+      fprintf(dumpfh, "%s overhead wall=%d.%09d cpu=%d.%09d\n",
+	      dumpi_function_names[i], wall->sec, wall->nsec,
+	      cpu->sec, cpu->nsec);
+  }
+  if(foot->writer.bytes_written || foot->writer.flush_count) {
+    fprintf(dumpfh, "Writer bytes=%llu flushes=%u flushtime=%d.%09d\n",
+	    (unsigned long long)foot->writer.bytes_written,
+	    foot->writer.flush_count, foot->writer.flush_time.sec,
+	    foot->writer.flush_time.nsec);
+    fprintf(dumpfh, "Writer lockwaits=%u locktime=%d.%09d\n",
+	    foot->writer.lock_contended, foot->writer.lock_wait.sec,
+	    foot->writer.lock_wait.nsec);
+  }
 }
 
 void print_perflbl(const dumpi_perfinfo *pinfo) {
@@ -55,6 +55,7 @@ int handle_recv (const dumpi_recv *prm, uint16_t thread, const dumpi_time *cpu,
 	dumpi_alloc_output_profile(cpu->start.sec, wall->start.sec, 0);	\
       opts->oprofile->file = dumpi_open_output_file(opts->outname);	\
     }									\
+    opts->oprofile->callsite = opts->iprofile->callsite;		\
     if(opts->output.function[GUARD]) {					\
       dumpi_write_ ## FUNC (prm, thread, cpu, wall, perf,		\
 			    &opts->output, opts->oprofile);		\
@@ -79,6 +80,7 @@ int handle_recv (const dumpi_recv *prm, uint16_t thread, const dumpi_time *cpu,
 	dumpi_alloc_output_profile(cpu->start.sec, wall->start.sec, 0);	\
       opts->oprofile->file = dumpi_open_output_file(opts->outname);	\
     }									\
+    opts->oprofile->callsite = opts->iprofile->callsite;		\
     if(opts->output.function[GUARD]) {					\
       dumpio_write_ ## FUNC (prm, thread, cpu, wall, perf,		\
 			     &opts->output, opts->oprofile);		\
@@ -89,6 +91,7 @@ int handle_recv (const dumpi_recv *prm, uint16_t thread, const dumpi_time *cpu,
     return 1;								\
   }
 
+/* Profiled function records have no footer entry. */
 #define DUMPI_HANDLERF(LFUNC, FUNC, GUARD)					\
   static								\
   int handle_ ## LFUNC (const dumpi_func_call *prm, uint16_t thread,	\
@@ -96,20 +99,17 @@ int handle_recv (const dumpi_recv *prm, uint16_t thread, const dumpi_time *cpu,
 		       const dumpi_perfinfo *perf, void *userarg)	\
   {									\
     d2dopts *opts = (d2dopts*)userarg;					\
-    assert(GUARD >= 0 && GUARD > DUMPI_END_OF_STREAM);			\
-    opts->footer.call_count[GUARD]++;					\
+    assert(GUARD > DUMPI_ALL_FUNCTIONS && GUARD < DUMPI_END_OF_STREAM);	\
     if(opts->oprofile == NULL) {					\
       opts->oprofile =							\
 	dumpi_alloc_output_profile(cpu->start.sec, wall->start.sec, 0);	\
       opts->oprofile->file = dumpi_open_output_file(opts->outname);	\
     }									\
+    opts->oprofile->callsite = opts->iprofile->callsite;		\
     if(opts->output.function[GUARD]) {					\
       dumpi_write_ ## FUNC (prm, thread, cpu, wall, perf,		\
 			    &opts->output, opts->oprofile);		\
     }									\
-    else {								\
-      opts->footer.ignored_count[GUARD]++;				\
-    }									\
     return 1;								\
   }
 
@@ -402,8 +402,54 @@ DUMPI_HANDLERIO(testany, DUMPIO_Testany)
 DUMPI_HANDLERIO(waitany, DUMPIO_Waitany)
 DUMPI_HANDLERIO(waitsome, DUMPIO_Waitsome)
 DUMPI_HANDLERIO(testsome, DUMPIO_Testsome)
+DUMPI_HANDLER(ibarrier, DUMPI_Ibarrier)
+DUMPI_HANDLER(ibcast, DUMPI_Ibcast)
+DUMPI_HANDLER(igather, DUMPI_Igather)
+DUMPI_HANDLER(igatherv, DUMPI_Igatherv)
+DUMPI_HANDLER(iscatter, DUMPI_Iscatter)
+DUMPI_HANDLER(iscatterv, DUMPI_Iscatterv)
+DUMPI_HANDLER(iallgather, DUMPI_Iallgather)
+DUMPI_HANDLER(iallgatherv, DUMPI_Iallgatherv)
+DUMPI_HANDLER(ialltoall, DUMPI_Ialltoall)
+DUMPI_HANDLER(ialltoallv, DUMPI_Ialltoallv)
+DUMPI_HANDLER(ialltoallw, DUMPI_Ialltoallw)
+DUMPI_HANDLER(ireduce, DUMPI_Ireduce)
+DUMPI_HANDLER(iallreduce, DUMPI_Iallreduce)
+DUMPI_HANDLER(ireduce_scatter, DUMPI_Ireduce_scatter)
+DUMPI_HANDLER(iscan, DUMPI_Iscan)
+DUMPI_HANDLER(iexscan, DUMPI_Iexscan)
+DUMPI_HANDLER(dist_graph_create_adjacent, DUMPI_Dist_graph_create_adjacent)
+DUMPI_HANDLER(neighbor_allgather, DUMPI_Neighbor_allgather)
+DUMPI_HANDLER(neighbor_allgatherv, DUMPI_Neighbor_allgatherv)
+DUMPI_HANDLER(neighbor_alltoall, DUMPI_Neighbor_alltoall)
+DUMPI_HANDLER(neighbor_alltoallv, DUMPI_Neighbor_alltoallv)
+DUMPI_HANDLER(neighbor_alltoallw, DUMPI_Neighbor_alltoallw)
+DUMPI_HANDLER(mprobe, DUMPI_Mprobe)
+DUMPI_HANDLER(improbe, DUMPI_Improbe)
+DUMPI_HANDLER(mrecv, DUMPI_Mrecv)
+DUMPI_HANDLER(imrecv, DUMPI_Imrecv)
 DUMPI_HANDLERF(function_enter, func_enter, DUMPI_Function_enter)
 DUMPI_HANDLERF(function_exit, func_exit, DUMPI_Function_exit)
+DUMPI_HANDLERF(function_call, func_call, DUMPI_Function_call)
+
+/* Poll summaries have no footer entry; they follow the polling function. */
+static int handle_poll_summary(const dumpi_poll_summary *prm, uint16_t thread,
+			       const dumpi_time *cpu, const dumpi_time *wall,
+			       const dumpi_perfinfo *perf, void *userarg)
+{
+  d2dopts *opts = (d2dopts*)userarg;
+  assert(prm->function >= 0 && prm->function < DUMPI_ALL_FUNCTIONS);
+  if(opts->oprofile == NULL) {
+    opts->oprofile =
+      dumpi_alloc_output_profile(cpu->start.sec, wall->start.sec, 0);
+    opts->oprofile->file = dumpi_open_output_file(opts->outname);
+  }
+  opts->oprofile->callsite = opts->iprofile->callsite;
+  if(opts->output.function[prm->function])
+    dumpi_write_poll_summary(prm, thread, cpu, wall, perf,
+			     &opts->output, opts->oprofile);
+  return 1;
+}
 
 /* Set callbacks for MPI functions. */
 int d2d_set_callbacks(d2dopts *opt) {
@@ -698,8 +744,36 @@ int d2d_set_callbacks(d2dopts *opt) {
   opt->cback.on_iowaitany = handle_iowaitany;
   opt->cback.on_iowaitsome = handle_iowaitsome;
   opt->cback.on_iotestsome = handle_iotestsome;
+  CBACK(ibarrier);
+  CBACK(ibcast);
+  CBACK(igather);
+  CBACK(igatherv);
+  CBACK(iscatter);
+  CBACK(iscatterv);
+  CBACK(iallgather);
+  CBACK(iallgatherv);
+  CBACK(ialltoall);
+  CBACK(ialltoallv);
+  CBACK(ialltoallw);
+  CBACK(ireduce);
+  CBACK(iallreduce);
+  CBACK(ireduce_scatter);
+  CBACK(iscan);
+  CBACK(iexscan);
+  CBACK(dist_graph_create_adjacent);
+  CBACK(neighbor_allgather);
+  CBACK(neighbor_allgatherv);
+  CBACK(neighbor_alltoall);
+  CBACK(neighbor_alltoallv);
+  CBACK(neighbor_alltoallw);
+  CBACK(mprobe);
+  CBACK(improbe);
+  CBACK(mrecv);
+  CBACK(imrecv);
   CBACK(function_enter);
   CBACK(function_exit);
+  CBACK(poll_summary);
+  CBACK(function_call);
 
   return 0;
 }
@@ -708,6 +782,7 @@ int d2d_set_callbacks(d2dopts *opt) {
 int d2d_parse_stream(const char *in, const char *out, d2dopts *opt) {
   int error = 0, id = 0;
   dumpi_profile *profile = undumpi_open(in);
+  opt->iprofile = profile;
   opt->oprofile = NULL;
   /* We don't open the output stream until the first MPI call,
    * otherwise we can't decide the time bias properly */
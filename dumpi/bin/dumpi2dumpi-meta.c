@@ -90,6 +90,8 @@ int d2d_parse_metadata(const d2dopts *opt, d2dmeta *meta) {
       else if(strcmp(key, "hostname") == 0) meta->hostname = strdup(value);
       else if(strcmp(key, "username") == 0) meta->username = strdup(value);
       else if(strcmp(key, "startime")== 0) meta->starttime= strdup(value);
+      else if(strcmp(key, "traced") == 0) meta->traced = strdup(value);
+      else if(strcmp(key, "untraced") == 0) meta->untraced = strdup(value);
       if(error) goto escape_hatch;
     }
   }
@@ -175,6 +177,10 @@ int d2d_write_metadata(const d2dopts *opt, const d2dmeta *meta) {
   fprintf(mfile, "version=%d\n", (int)dumpi_version);
   fprintf(mfile, "subversion=%d\n", (int)dumpi_subversion);
   fprintf(mfile, "subsubversion=%d\n", (int)dumpi_subsubversion);  
+  if(meta->traced)
+    fprintf(mfile, "traced=%s\n", meta->traced);
+  if(meta->untraced)
+    fprintf(mfile, "untraced=%s\n", meta->untraced);
   fclose(mfile);
  purgatory:
   return error;
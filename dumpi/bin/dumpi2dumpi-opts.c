@@ -89,11 +89,13 @@ int d2d_collect_opts(int argc, char **argv, d2dopts *opt) {
 	opt->write_userfuncs = 1;
 	opt->output.function[DUMPI_Function_enter] = 1;
 	opt->output.function[DUMPI_Function_exit] = 1;
+	opt->output.function[DUMPI_Function_call] = 1;
 	break;
       case 'U':
 	opt->write_userfuncs = 0;
 	opt->output.function[DUMPI_Function_enter] = 0;
 	opt->output.function[DUMPI_Function_exit] = 0;
+	opt->output.function[DUMPI_Function_call] = 0;
 	break;
       case 'm':
 	fid = get_dumpi_id(optarg, &error);
@@ -37,6 +37,8 @@ extern "C" {
     dumpi_outputs output;
     libundumpi_callbacks cback;
     const char *outname; /* Used internally for parsing */
+    /* Call-site ids are carried from the input to the output records */
+    dumpi_profile *iprofile;
     dumpi_profile *oprofile;
     dumpi_footer footer;
   } d2dopts;
@@ -57,6 +59,10 @@ extern "C" {
     char *hostname;
     char *username;
     char *starttime;
+    /** Ranks with full traces and what the others wrote (trace-ranks);
+     *  NULL if every rank was traced */
+    char *traced;
+    char *untraced;
     /** Version, subversion, and subsubversion are reported for current dumpi */
   } d2dmeta;
 
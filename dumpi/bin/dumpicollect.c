@@ -0,0 +1,782 @@
+/*
+ *  This file is part of DUMPI:
+ *               The MPI profiling library from the SST suite.
+ *  Copyright (c) 2009-2011 Sandia Corporation.
+ *  This software is distributed under the BSD License.
+ *  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+ *  the U.S. Government retains certain rights in this software.
+ *  For more information, see the LICENSE file in the top
+ *  SST/macroscale directory.
+ */
+
+/*
+ * Collect the trace streams that libdumpi sends while a run goes
+ * (stream-to in dumpi.conf) and write them out as regular trace files.
+ * With -l, the records are also read back as they arrive.
+ */
+
+/* fopencookie */
+#define _GNU_SOURCE 1
+#include <dumpi/common/livestream.h>
+#include <dumpi/common/funclabels.h>
+#include <dumpi/common/iodefs.h>
+#include <dumpi/libundumpi/libundumpi.h>
+#include <dumpi/libundumpi/bindings.h>
+#include <dumpi/dumpiconfig.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <signal.h>
+#include <getopt.h>
+#include <poll.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/time.h>
+#include <arpa/inet.h>
+#include <assert.h>
+
+#if defined(DUMPI_USE_PTHREADS) && defined(DUMPI_HAVE_FOPENCOOKIE)
+#define LIVE_SUPPORTED 1
+#include <pthread.h>
+#include <stdio_ext.h>
+#endif
+
+/*
+ * User options.
+ */
+typedef struct collectopt {
+  const char *socket, *fifo, *outdir;
+  double live;
+  int keep, verbose, replay;
+} collectopt;
+
+/* The stream of one rank */
+typedef struct collect_rank {
+  int      fd;
+  int      open;
+  /* Set by a CLOSE frame, or when the connection ends without one */
+  int      done, lost;
+  uint64_t next_seq;
+  /* Bytes of the stream written in order from its start */
+  uint64_t contiguous;
+#ifdef LIVE_SUPPORTED
+  int        reading;
+  pthread_t  reader;
+  FILE      *stream;
+  dumpi_profile *profile;
+  uint64_t   calls[DUMPI_END_OF_STREAM];
+#endif
+} collect_rank;
+
+/* The ranks of one run (by file root) */
+typedef struct collect_job {
+  char *root;
+  int size, done;
+  char version[3];
+  collect_rank *rank;
+  struct collect_job *next;
+} collect_job;
+
+/* A socket connection or the named pipe */
+typedef struct collect_conn {
+  int fd;
+  unsigned char *buf;
+  size_t have, cap;
+  collect_job *job;
+  int rank;
+  struct collect_conn *next;
+} collect_conn;
+
+static collectopt opt;
+static collect_job *jobs = NULL;
+static collect_conn *conns = NULL;
+static int finished_jobs = 0;
+static volatile sig_atomic_t stop = 0;
+
+#ifdef LIVE_SUPPORTED
+static pthread_mutex_t live_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t live_cond = PTHREAD_COND_INITIALIZER;
+#define LIVE_LOCK()   pthread_mutex_lock(&live_lock)
+#define LIVE_UNLOCK() pthread_mutex_unlock(&live_lock)
+#else
+#define LIVE_LOCK()
+#define LIVE_UNLOCK()
+#endif
+
+static int parse_options(int argc, char **argv, collectopt *opt);
+static void handle_frame(collect_conn *conn, const dumpi_frame *frame,
+			 const unsigned char *payload);
+static void finish_job(collect_job *job);
+static void print_live(const collect_job *job, double elapsed);
+
+static void on_signal(int sig) {
+  (void)sig;
+  stop = 1;
+}
+
+static double now(void) {
+  struct timeval tv;
+  gettimeofday(&tv, NULL);
+  return tv.tv_sec + 1e-6 * tv.tv_usec;
+}
+
+#ifdef LIVE_SUPPORTED
+
+/*
+ * Live reading.  Each rank gets a thread that reads its trace file through
+ * a stream which waits for the collector to write more.  The records go
+ * through the libundumpi parsers (add callouts to live_callbacks to do
+ * more than count them).
+ */
+static libundumpi_callbacks live_callbacks;
+static libundumpi_cbpair live_callarr[DUMPI_END_OF_STREAM];
+
+typedef struct live_cookie {
+  collect_rank *rank;
+  int fd;
+  off64_t pos;
+} live_cookie;
+
+static ssize_t live_read(void *cookie, char *buf, size_t size) {
+  live_cookie *lc = (live_cookie*)cookie;
+  uint64_t avail;
+  ssize_t count;
+  LIVE_LOCK();
+  while(lc->rank->contiguous <= (uint64_t)lc->pos && ! lc->rank->done)
+    pthread_cond_wait(&live_cond, &live_lock);
+  avail = lc->rank->contiguous - lc->pos;
+  LIVE_UNLOCK();
+  if(avail == 0) {
+    /* The stream broke off (or had no end-of-stream marker) */
+    pthread_exit(NULL);
+  }
+  if(size > avail)
+    size = avail;
+  if((count = pread(lc->fd, buf, size, lc->pos)) > 0)
+    lc->pos += count;
+  return count;
+}
+
+static int live_seek(void *cookie, off64_t *offset, int whence) {
+  live_cookie *lc = (live_cookie*)cookie;
+  if(whence == SEEK_SET)
+    lc->pos = *offset;
+  else if(whence == SEEK_CUR)
+    lc->pos += *offset;
+  else {
+    errno = ESPIPE;
+    return -1;
+  }
+  *offset = lc->pos;
+  return 0;
+}
+
+static int live_close(void *cookie) {
+  live_cookie *lc = (live_cookie*)cookie;
+  close(lc->fd);
+  free(lc);
+  return 0;
+}
+
+static void* live_reader(void *arg) {
+  collect_rank *rank = (collect_rank*)arg;
+  dumpi_function func;
+  void *uarg = NULL;
+  assert(dumpi_start_stream_read(rank->profile) != 0);
+  while((func = dumpi_read_next_function(rank->profile))
+	< DUMPI_END_OF_STREAM)
+  {
+    LIVE_LOCK();
+    ++rank->calls[func];
+    LIVE_UNLOCK();
+    if(! live_callarr[func].handler(rank->profile, live_callarr[func].callout,
+				    uarg))
+      break;
+  }
+  return NULL;
+}
+
+static void live_start(collect_job *job, int r, const char *fname) {
+  static const cookie_io_functions_t funcs = {
+    live_read, NULL, live_seek, live_close
+  };
+  collect_rank *rank = &job->rank[r];
+  live_cookie *lc;
+  if(live_callarr[0].handler == NULL) {
+    libundumpi_clear_callbacks(&live_callbacks);
+    libundumpi_populate_handlers(&live_callbacks, live_callarr);
+    libundumpi_populate_callouts(&live_callbacks, live_callarr);
+  }
+  lc = (live_cookie*)calloc(1, sizeof(live_cookie));
+  assert(lc != NULL);
+  lc->rank = rank;
+  if((lc->fd = open(fname, O_RDONLY)) < 0) {
+    fprintf(stderr, "dumpicollect:  Cannot read %s back: %s\n", fname,
+	    strerror(errno));
+    free(lc);
+    return;
+  }
+  rank->stream = fopencookie(lc, "r", funcs);
+  assert(rank->stream != NULL);
+  /* Only the reader thread uses the stream (and may exit inside it) */
+  __fsetlocking(rank->stream, FSETLOCKING_BYCALLER);
+  rank->profile = (dumpi_profile*)calloc(1, sizeof(dumpi_profile));
+  assert(rank->profile != NULL);
+  rank->profile->file = rank->stream;
+  memcpy(rank->profile->version, job->version, 3);
+  /* The body follows the 8 bytes of magic; the footer is not known yet */
+  rank->profile->body = sizeof(uint64_t);
+  if(pthread_create(&rank->reader, NULL, live_reader, rank) != 0) {
+    fprintf(stderr, "dumpicollect:  Cannot start a reader for %s\n", fname);
+    fclose(rank->stream);
+    free(rank->profile);
+    return;
+  }
+  rank->reading = 1;
+}
+
+static void live_stop(collect_rank *rank) {
+  if(! rank->reading)
+    return;
+  pthread_join(rank->reader, NULL);
+  fclose(rank->stream);
+  free(rank->profile);
+  rank->reading = 0;
+}
+
+#endif /* LIVE_SUPPORTED */
+
+static int listen_socket(const char *path) {
+  struct sockaddr_un addr;
+  struct stat st;
+  int fd;
+  if(strlen(path) >= sizeof(addr.sun_path)) {
+    fprintf(stderr, "dumpicollect:  Socket path too long: %s\n", path);
+    return -1;
+  }
+  /* A socket left over from an earlier collector */
+  if(stat(path, &st) == 0 && S_ISSOCK(st.st_mode))
+    unlink(path);
+  memset(&addr, 0, sizeof(addr));
+  addr.sun_family = AF_UNIX;
+  strcpy(addr.sun_path, path);
+  if((fd = socket(AF_UNIX, SOCK_STREAM, 0)) < 0 ||
+     bind(fd, (struct sockaddr*)&addr, sizeof(addr)) != 0 ||
+     listen(fd, 128) != 0)
+  {
+    fprintf(stderr, "dumpicollect:  Cannot listen on %s: %s\n", path,
+	    strerror(errno));
+    return -1;
+  }
+  return fd;
+}
+
+/* Open the named pipe (creating it if needed), and keep a write end open
+ * so that it does not report end-of-file between runs. */
+static int open_fifo(const char *path, int *keepalive) {
+  struct stat st;
+  int fd;
+  if(stat(path, &st) != 0 && mkfifo(path, 0600) != 0) {
+    fprintf(stderr, "dumpicollect:  Cannot create %s: %s\n", path,
+	    strerror(errno));
+    return -1;
+  }
+  if((fd = open(path, O_RDONLY | O_NONBLOCK)) < 0 ||
+     (*keepalive = open(path, O_WRONLY | O_NONBLOCK)) < 0)
+  {
+    fprintf(stderr, "dumpicollect:  Cannot open %s: %s\n", path,
+	    strerror(errno));
+    return -1;
+  }
+  return fd;
+}
+
+static collect_conn* add_conn(int fd) {
+  collect_conn *conn = (collect_conn*)calloc(1, sizeof(collect_conn));
+  assert(conn != NULL);
+  conn->fd = fd;
+  conn->rank = -1;
+  conn->cap = 65536;
+  conn->buf = (unsigned char*)malloc(conn->cap);
+  assert(conn->buf != NULL);
+  conn->next = conns;
+  conns = conn;
+  return conn;
+}
+
+/* Take the whole frames out of the connection buffer.
+ * \return 0 if the connection sends something other than frames. */
+static int parse_frames(collect_conn *conn) {
+  dumpi_frame frame;
+  size_t pos = 0, length;
+  while(conn->have - pos >= DUMPI_FRAME_HEADER) {
+    if(! dumpi_frame_unpack(conn->buf + pos, &frame)) {
+      fprintf(stderr, "dumpicollect:  Not a trace stream (bad frame magic); "
+	      "dropping the connection.\n");
+      return 0;
+    }
+    length = DUMPI_FRAME_HEADER + frame.length;
+    if(conn->have - pos < length) {
+      if(length > conn->cap) {
+	conn->cap = length;
+	conn->buf = (unsigned char*)realloc(conn->buf, conn->cap);
+	assert(conn->buf != NULL);
+      }
+      break;
+    }
+    handle_frame(conn, &frame, conn->buf + pos + DUMPI_FRAME_HEADER);
+    pos += length;
+  }
+  memmove(conn->buf, conn->buf + pos, conn->have - pos);
+  conn->have -= pos;
+  return 1;
+}
+
+/* A connection ended; a rank that did not send CLOSE lost its collector
+ * (the rest of its stream is in fileroot-NNNN.frames). */
+static void drop_conn(collect_conn *conn) {
+  collect_conn **link;
+  collect_job *job = conn->job;
+  if(job != NULL && conn->rank >= 0 && ! job->rank[conn->rank].done) {
+    fprintf(stderr, "dumpicollect:  Rank %d of %s ended without closing its "
+	    "stream; replay %s-%04d.frames with -r.\n", conn->rank, job->root,
+	    job->root, conn->rank);
+    LIVE_LOCK();
+    job->rank[conn->rank].done = job->rank[conn->rank].lost = 1;
+#ifdef LIVE_SUPPORTED
+    pthread_cond_broadcast(&live_cond);
+#endif
+    LIVE_UNLOCK();
+    if(++job->done == job->size)
+      finish_job(job);
+  }
+  for(link = &conns; *link != conn; link = &(*link)->next)
+    ;
+  *link = conn->next;
+  if(conn->fd >= 0)
+    close(conn->fd);
+  free(conn->buf);
+  free(conn);
+}
+
+static collect_job* find_job(const char *root, size_t rootlen) {
+  collect_job *job;
+  for(job = jobs; job != NULL; job = job->next)
+    if(strlen(job->root) == rootlen && strncmp(job->root, root, rootlen) == 0)
+      return job;
+  return NULL;
+}
+
+static void handle_open(collect_conn *conn, const dumpi_frame *frame,
+			const unsigned char *payload)
+{
+  const char *root;
+  size_t rootlen;
+  uint32_t size;
+  collect_job *job;
+  collect_rank *rank;
+  char *fname;
+  if(frame->length <= DUMPI_FRAME_OPEN_FIXED) {
+    fprintf(stderr, "dumpicollect:  Malformed OPEN frame from rank %d\n",
+	    (int)frame->rank);
+    return;
+  }
+  /* Trace files go to the output directory, without the run's path */
+  root = (const char*)payload + DUMPI_FRAME_OPEN_FIXED;
+  rootlen = frame->length - DUMPI_FRAME_OPEN_FIXED;
+  while(memchr(root, '/', rootlen) != NULL) {
+    const char *slash = (const char*)memchr(root, '/', rootlen);
+    rootlen -= (slash + 1) - root;
+    root = slash + 1;
+  }
+  memcpy(&size, payload + 4, sizeof(uint32_t));
+  size = ntohl(size);
+  if((job = find_job(root, rootlen)) == NULL) {
+    job = (collect_job*)calloc(1, sizeof(collect_job));
+    assert(job != NULL);
+    job->root = strndup(root, rootlen);
+    job->size = size;
+    memcpy(job->version, payload, 3);
+    job->rank = (collect_rank*)calloc(size, sizeof(collect_rank));
+    assert(job->root != NULL && job->rank != NULL);
+    job->next = jobs;
+    jobs = job;
+    if(opt.verbose)
+      fprintf(stderr, "dumpicollect:  Collecting %s (%d ranks)\n", job->root,
+	      job->size);
+  }
+  if(frame->rank < 0 || frame->rank >= job->size) {
+    fprintf(stderr, "dumpicollect:  Rank %d out of range for %s\n",
+	    (int)frame->rank, job->root);
+    return;
+  }
+  conn->job = job;
+  conn->rank = frame->rank;
+  rank = &job->rank[frame->rank];
+  if(rank->open) {
+    fprintf(stderr, "dumpicollect:  Rank %d of %s opened its stream again\n",
+	    (int)frame->rank, job->root);
+    return;
+  }
+  fname = (char*)malloc(strlen(opt.outdir) + rootlen + 32);
+  assert(fname != NULL);
+  sprintf(fname, "%s/%s-%04d.bin", opt.outdir, job->root, (int)frame->rank);
+  /* A resumed stream continues the trace file of an earlier collector */
+  rank->fd = open(fname, O_WRONLY | O_CREAT |
+		  ((frame->flags & DUMPI_FRAME_RESUME) ? 0 : O_TRUNC), 0644);
+  if(rank->fd < 0) {
+    fprintf(stderr, "dumpicollect:  Cannot open %s: %s\n", fname,
+	    strerror(errno));
+    exit(2);
+  }
+  rank->open = 1;
+  if(frame->flags & DUMPI_FRAME_RESUME) {
+    struct stat st;
+    /* Whatever was in transit when the earlier collector died is gone */
+    if(fstat(rank->fd, &st) == 0 && (uint64_t)st.st_size < frame->offset)
+      fprintf(stderr, "dumpicollect:  Rank %d of %s:  bytes %llu to %llu of "
+	      "the stream were lost with the collector\n", (int)frame->rank,
+	      job->root, (unsigned long long)st.st_size,
+	      (unsigned long long)frame->offset);
+    rank->next_seq = frame->seq;
+    rank->contiguous = frame->offset;
+    /* Ranks written off by an earlier connection come back */
+    if(rank->done) {
+      rank->done = rank->lost = 0;
+      --job->done;
+    }
+  }
+  else {
+    rank->next_seq = frame->seq + 1;
+#ifdef LIVE_SUPPORTED
+    if(opt.live > 0)
+      live_start(job, frame->rank, fname);
+#endif
+  }
+  free(fname);
+}
+
+static void handle_frame(collect_conn *conn, const dumpi_frame *frame,
+			 const unsigned char *payload)
+{
+  collect_rank *rank;
+  ssize_t count;
+  if(frame->type == DUMPI_FRAME_OPEN) {
+    handle_open(conn, frame, payload);
+    return;
+  }
+  if(conn->job == NULL || frame->rank < 0 || frame->rank >= conn->job->size ||
+     ! conn->job->rank[frame->rank].open || conn->job->rank[frame->rank].done)
+  {
+    fprintf(stderr, "dumpicollect:  Frame from rank %d outside an open "
+	    "stream; ignored.\n", (int)frame->rank);
+    return;
+  }
+  rank = &conn->job->rank[frame->rank];
+  if(frame->seq != rank->next_seq)
+    fprintf(stderr, "dumpicollect:  Rank %d of %s:  expected frame %llu, got "
+	    "%llu\n", (int)frame->rank, conn->job->root,
+	    (unsigned long long)rank->next_seq,
+	    (unsigned long long)frame->seq);
+  rank->next_seq = frame->seq + 1;
+  if(frame->type == DUMPI_FRAME_DATA) {
+    count = pwrite(rank->fd, payload, frame->length, frame->offset);
+    if(count != (ssize_t)frame->length) {
+      fprintf(stderr, "dumpicollect:  Failed to write the trace of rank %d of "
+	      "%s: %s\n", (int)frame->rank, conn->job->root, strerror(errno));
+      exit(2);
+    }
+    LIVE_LOCK();
+    if(frame->offset <= rank->contiguous &&
+       frame->offset + frame->length > rank->contiguous)
+      rank->contiguous = frame->offset + frame->length;
+#ifdef LIVE_SUPPORTED
+    pthread_cond_broadcast(&live_cond);
+#endif
+    LIVE_UNLOCK();
+  }
+  else if(frame->type == DUMPI_FRAME_CLOSE) {
+    LIVE_LOCK();
+    rank->done = 1;
+#ifdef LIVE_SUPPORTED
+    pthread_cond_broadcast(&live_cond);
+#endif
+    LIVE_UNLOCK();
+    if(++conn->job->done == conn->job->size)
+      finish_job(conn->job);
+  }
+  else {
+    fprintf(stderr, "dumpicollect:  Unknown frame type %d from rank %d\n",
+	    (int)frame->type, (int)frame->rank);
+  }
+}
+
+/* Write a metafile unless the run left one in the output directory */
+static void write_meta(const collect_job *job) {
+  char *fname = (char*)malloc(strlen(opt.outdir) + strlen(job->root) + 8);
+  FILE *meta;
+  assert(fname != NULL);
+  sprintf(fname, "%s/%s.meta", opt.outdir, job->root);
+  if(access(fname, F_OK) != 0 && (meta = fopen(fname, "w")) != NULL) {
+    fprintf(meta, "numprocs=%d\n", job->size);
+    fprintf(meta, "fileprefix=%s\n", job->root);
+    fprintf(meta, "version=%d\nsubversion=%d\nsubsubversion=%d\n",
+	    job->version[0], job->version[1], job->version[2]);
+    fclose(meta);
+  }
+  free(fname);
+}
+
+/* All ranks of a job are done */
+static void finish_job(collect_job *job) {
+  collect_job **link;
+  collect_conn *conn;
+  int r, lost = 0;
+  for(r = 0; r < job->size; ++r) {
+#ifdef LIVE_SUPPORTED
+    live_stop(&job->rank[r]);
+#endif
+    if(job->rank[r].open)
+      close(job->rank[r].fd);
+    lost += job->rank[r].lost;
+  }
+  if(opt.live > 0)
+    print_live(job, -1);
+  write_meta(job);
+  if(opt.verbose || lost)
+    fprintf(stderr, "dumpicollect:  %s:  %d of %d ranks complete\n",
+	    job->root, job->size - lost, job->size);
+  for(link = &jobs; *link != job; link = &(*link)->next)
+    ;
+  *link = job->next;
+  for(conn = conns; conn != NULL; conn = conn->next)
+    if(conn->job == job)
+      conn->job = NULL;
+  free(job->rank);
+  free(job->root);
+  free(job);
+  ++finished_jobs;
+}
+
+/* Print the calls read back so far (elapsed < 0:  all of them) */
+static void print_live(const collect_job *job, double elapsed) {
+#ifdef LIVE_SUPPORTED
+  uint64_t total[DUMPI_END_OF_STREAM] = {0}, sum = 0;
+  int r, f;
+  LIVE_LOCK();
+  for(r = 0; r < job->size; ++r)
+    for(f = 0; f < DUMPI_END_OF_STREAM; ++f)
+      total[f] += job->rank[r].calls[f];
+  LIVE_UNLOCK();
+  for(f = 0; f < DUMPI_END_OF_STREAM; ++f)
+    sum += total[f];
+  if(elapsed < 0)
+    printf("%s (done):  %llu calls\n", job->root, (unsigned long long)sum);
+  else
+    printf("%s (%.1fs):  %llu calls\n", job->root, elapsed,
+	   (unsigned long long)sum);
+  for(f = 0; f < DUMPI_END_OF_STREAM; ++f)
+    if(total[f] > 0)
+      printf("  %-28s %llu\n", dumpi_function_label((dumpi_function)f),
+	     (unsigned long long)total[f]);
+  fflush(stdout);
+#else
+  (void)job;
+  (void)elapsed;
+#endif
+}
+
+/* Feed a frames file (written by a rank that lost its collector) */
+static int replay(const char *fname) {
+  collect_conn *conn;
+  FILE *in = fopen(fname, "r");
+  size_t count;
+  int status = 1;
+  if(in == NULL) {
+    fprintf(stderr, "dumpicollect:  Cannot open %s: %s\n", fname,
+	    strerror(errno));
+    return 0;
+  }
+  conn = add_conn(-1);
+  while((count = fread(conn->buf + conn->have, 1, conn->cap - conn->have, in))
+	> 0)
+  {
+    conn->have += count;
+    if(! parse_frames(conn)) {
+      status = 0;
+      break;
+    }
+  }
+  if(conn->have > 0)
+    fprintf(stderr, "dumpicollect:  %s ends in the middle of a frame\n",
+	    fname);
+  fclose(in);
+  drop_conn(conn);
+  return status;
+}
+
+int main(int argc, char **argv) {
+  collect_conn *conn, *next;
+  struct pollfd *pfd = NULL;
+  int listener = -1, fifo = -1, keepalive = -1, nfds, i;
+  double start = now(), last = start;
+  ssize_t count;
+
+  if(parse_options(argc, argv, &opt) == 0)
+    return 1;
+  signal(SIGINT, on_signal);
+  signal(SIGTERM, on_signal);
+  signal(SIGPIPE, SIG_IGN);
+  if(opt.replay) {
+    for(i = optind; i < argc; ++i)
+      if(! replay(argv[i]))
+	return 3;
+    /* The other ranks were written by the collector of the run */
+    while(jobs != NULL) {
+      if(opt.verbose)
+	fprintf(stderr, "dumpicollect:  %s:  replayed %d ranks\n",
+		jobs->root, jobs->done);
+      finish_job(jobs);
+    }
+    return 0;
+  }
+  if(opt.socket && (listener = listen_socket(opt.socket)) < 0)
+    return 2;
+  if(opt.fifo && (fifo = open_fifo(opt.fifo, &keepalive)) < 0)
+    return 2;
+  if(fifo >= 0)
+    add_conn(fifo);
+  while(! stop && (opt.keep || finished_jobs == 0 || jobs != NULL)) {
+    nfds = 0;
+    for(conn = conns; conn != NULL; conn = conn->next)
+      ++nfds;
+    pfd = (struct pollfd*)realloc(pfd, (nfds + 1) * sizeof(struct pollfd));
+    assert(pfd != NULL);
+    nfds = 0;
+    if(listener >= 0) {
+      pfd[nfds].fd = listener;
+      pfd[nfds++].events = POLLIN;
+    }
+    for(conn = conns; conn != NULL; conn = conn->next) {
+      pfd[nfds].fd = conn->fd;
+      pfd[nfds++].events = POLLIN;
+    }
+    if(poll(pfd, nfds, (opt.live > 0 ? (int)(opt.live * 1000) : -1)) < 0) {
+      if(errno == EINTR)
+	continue;
+      perror("dumpicollect:  poll");
+      return 2;
+    }
+    i = 0;
+    if(listener >= 0) {
+      if(pfd[i++].revents & POLLIN) {
+	int fd = accept(listener, NULL, NULL);
+	if(fd >= 0)
+	  add_conn(fd);
+      }
+    }
+    for(conn = conns; conn != NULL; conn = next) {
+      short revents = 0;
+      int k;
+      next = conn->next;
+      /* Connections accepted above are not in this round */
+      for(k = i; k < nfds; ++k)
+	if(pfd[k].fd == conn->fd)
+	  revents = pfd[k].revents;
+      if(! (revents & (POLLIN | POLLHUP | POLLERR)))
+	continue;
+      count = read(conn->fd, conn->buf + conn->have, conn->cap - conn->have);
+      if(count < 0 && (errno == EAGAIN || errno == EINTR))
+	continue;
+      if(count > 0) {
+	conn->have += count;
+	if(parse_frames(conn))
+	  continue;
+      }
+      if(conn->fd != fifo)
+	drop_conn(conn);
+    }
+    if(opt.live > 0 && now() - last >= opt.live) {
+      collect_job *job;
+      last = now();
+      for(job = jobs; job != NULL; job = job->next)
+	print_live(job, last - start);
+    }
+  }
+  if(jobs != NULL)
+    fprintf(stderr, "dumpicollect:  Stopped with incomplete traces\n");
+  while(jobs != NULL) {
+    LIVE_LOCK();
+    for(i = 0; i < jobs->size; ++i)
+      jobs->rank[i].done = 1;
+#ifdef LIVE_SUPPORTED
+    pthread_cond_broadcast(&live_cond);
+#endif
+    LIVE_UNLOCK();
+    finish_job(jobs);
+  }
+  while(conns != NULL)
+    drop_conn(conns);
+  if(opt.socket)
+    unlink(opt.socket);
+  if(keepalive >= 0)
+    close(keepalive);
+  free(pfd);
+  return 0;
+}
+
+static void print_usage(const char *name) {
+  fprintf(stderr,
+	  "Usage:  %s [-s socket | -p fifo] [-o dir] [-l secs] [-k] [-v]\n"
+	  "        %s -r [-o dir] file.frames...\n"
+	  "   Options:\n"
+	  "     -s socket  Listen on a Unix-domain socket (stream-to)\n"
+	  "     -p fifo    Read a named pipe (created if needed)\n"
+	  "     -o dir     Write the trace files to dir (default: .)\n"
+	  "     -l secs    Read the records back as they arrive, and print\n"
+	  "                the calls so far every secs seconds\n"
+	  "     -k         Keep collecting after a run completes\n"
+	  "     -r         Replay the frames files of ranks that lost the\n"
+	  "                collector\n"
+	  "     -v         Verbose status output\n"
+	  "     -h         Print this help message\n",
+	  name, name);
+}
+
+int parse_options(int argc, char **argv, collectopt *opt) {
+  int ch;
+  memset(opt, 0, sizeof(collectopt));
+  opt->outdir = ".";
+  while((ch = getopt(argc, argv, "s:p:o:l:krvh")) != -1) {
+    switch(ch) {
+    case 's': opt->socket = optarg;        break;
+    case 'p': opt->fifo = optarg;          break;
+    case 'o': opt->outdir = optarg;        break;
+    case 'l': opt->live = atof(optarg);    break;
+    case 'k': opt->keep = 1;               break;
+    case 'r': opt->replay = 1;             break;
+    case 'v': opt->verbose = 1;            break;
+    case 'h': print_usage(argv[0]);        return 0;
+    default:
+      fprintf(stderr, "Invalid argument %c\n", ch);
+      print_usage(argv[0]);
+      return 0;
+    }
+  }
+  if(opt->replay ? (optind >= argc) : (!opt->socket == !opt->fifo)) {
+    print_usage(argv[0]);
+    return 0;
+  }
+#ifndef LIVE_SUPPORTED
+  if(opt->live > 0) {
+    fprintf(stderr, "dumpicollect:  -l is not supported by this build\n");
+    opt->live = 0;
+  }
+#endif
+  return 1;
+}
@@ -57,6 +57,13 @@ namespace dumpi {
                         int64_t bytes_recvd, int from_global_rank,
                         const void *dumpi_arg) = 0;
 
+    /// Bytes sent to one peer by the call last passed to handle().
+    /// Ignored by default.
+    virtual void handle_peer(dumpi_function /*func*/,
+                             const dumpi_time* /*wall*/,
+                             int64_t /*bytes_sent*/, int /*to_global_rank*/)
+    {}
+
     /// Reset counters and internal state in preparation for a new trace.
     /// Forces a flush of all active handlers unless callcount_ is zero.
     virtual void start_trace(int rank) = 0;
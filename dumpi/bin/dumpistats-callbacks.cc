@@ -16,6 +16,31 @@
 
 namespace dumpi {
 
+  //
+  // Sum of a per-peer count array (summarized records only keep the sum).
+  //
+  static inline int64_t count_total(const int *counts,
+                                    const dumpi_int_summary &summary,
+                                    int commsize)
+  {
+    if(counts == NULL)
+      return summary.total;
+    int64_t total = 0;
+    for(int i = 0; i < commsize; ++i)
+      total += counts[i];
+    return total;
+  }
+
+  //
+  // Sum of a per-neighbor count array (always stored in full).
+  //
+  static inline int64_t count_total(const int *counts, int peers) {
+    int64_t total = 0;
+    for(int i = 0; i < peers; ++i)
+      total += counts[i];
+    return total;
+  }
+
   template <typename thetype, dumpi_function thelabel>
   int report_generic(const thetype *prm, uint16_t thread,
                      const dumpi_time *cpu, const dumpi_time *wall,
@@ -267,8 +292,8 @@ namespace dumpi {
     return 1;
   }
 
-  static
-  int report_MPI_Bcast(const dumpi_bcast *prm, uint16_t thread,
+  template <typename thetype, dumpi_function thelabel>
+  int report_MPI_Bcast(const thetype *prm, uint16_t thread,
                        const dumpi_time *cpu, const dumpi_time *wall,
                        const dumpi_perfinfo *perf, void *uarg)
   {
@@ -277,15 +302,15 @@ namespace dumpi {
     int64_t size = prm->count * cb->typesize(prm->datatype, wall->start);
     // int commsize = cb->commsize(prm->comm, wall->start);
     if(cb->commrank(prm->comm, wall->start) == prm->root)
-      cb->handle(DUMPI_Bcast, thread, cpu, wall, perf,
+      cb->handle(thelabel, thread, cpu, wall, perf,
                  size /* *commsize */, -1, 0, 0, prm);
     else
-      cb->handle(DUMPI_Bcast, thread, cpu, wall, perf, 0, -1, size, -1, prm);
+      cb->handle(thelabel, thread, cpu, wall, perf, 0, -1, size, -1, prm);
     return 1;
   }
 
-  static
-  int report_MPI_Gather(const dumpi_gather *prm, uint16_t thread,
+  template <typename thetype, dumpi_function thelabel>
+  int report_MPI_Gather(const thetype *prm, uint16_t thread,
                         const dumpi_time *cpu, const dumpi_time *wall,
                         const dumpi_perfinfo *perf, void *uarg)
   {
@@ -300,13 +325,13 @@ namespace dumpi {
     }
     int64_t sendsize = (prm->sendcount *
                         cb->typesize(prm->sendtype, wall->start));
-    cb->handle(DUMPI_Gather, thread, cpu, wall, perf, sendsize, dest,
+    cb->handle(thelabel, thread, cpu, wall, perf, sendsize, dest,
                recvsize, source, prm);
     return 1;
   }
 
-  static
-  int report_MPI_Gatherv(const dumpi_gatherv *prm, uint16_t thread,
+  template <typename thetype, dumpi_function thelabel>
+  int report_MPI_Gatherv(const thetype *prm, uint16_t thread,
                          const dumpi_time *cpu, const dumpi_time *wall,
                          const dumpi_perfinfo *perf, void *uarg)
   {
@@ -317,20 +342,18 @@ namespace dumpi {
     if(cb->commrank(prm->comm, wall->start) == prm->root) {
       int commsize = cb->commsize(prm->comm, wall->start);
       int64_t typesize = cb->typesize(prm->recvtype, wall->start);
-      for(int i = 0; i < commsize; ++i) {
-        int64_t unitsend = prm->recvcounts[i];
-        recvsize += unitsend * typesize;
-      }
+      recvsize = typesize * count_total(prm->recvcounts,
+                                        prm->recvcounts_summary, commsize);
     }
     int64_t sendsize = (prm->sendcount *
                         cb->typesize(prm->sendtype, wall->start));
-    cb->handle(DUMPI_Gatherv, thread, cpu, wall, perf, sendsize, dest,
+    cb->handle(thelabel, thread, cpu, wall, perf, sendsize, dest,
                recvsize, source, prm);
     return 1;
   }
 
-  static
-  int report_MPI_Scatter(const dumpi_scatter *prm, uint16_t thread,
+  template <typename thetype, dumpi_function thelabel>
+  int report_MPI_Scatter(const thetype *prm, uint16_t thread,
                          const dumpi_time *cpu, const dumpi_time *wall,
                          const dumpi_perfinfo *perf, void *uarg)
   {
@@ -345,13 +368,13 @@ namespace dumpi {
     }
     int64_t recvsize = (prm->recvcount *
                         cb->typesize(prm->recvtype, wall->start));
-    cb->handle(DUMPI_Scatter, thread, cpu, wall, perf, sendsize, dest,
+    cb->handle(thelabel, thread, cpu, wall, perf, sendsize, dest,
                recvsize, source, prm);
     return 1;
   }
 
-  static
-  int report_MPI_Scatterv(const dumpi_scatterv *prm, uint16_t thread,
+  template <typename thetype, dumpi_function thelabel>
+  int report_MPI_Scatterv(const thetype *prm, uint16_t thread,
                           const dumpi_time *cpu, const dumpi_time *wall,
                           const dumpi_perfinfo *perf, void *uarg)
   {
@@ -362,33 +385,31 @@ namespace dumpi {
     if(cb->commrank(prm->comm, wall->start) == prm->root) {
       int commsize = cb->commsize(prm->comm, wall->start);
       int64_t typesize = cb->typesize(prm->sendtype, wall->start);
-      for(int i = 0; i < commsize; ++i) {
-        int64_t unitsend = prm->sendcounts[i];
-        sendsize += unitsend * typesize;
-      }
+      sendsize = typesize * count_total(prm->sendcounts,
+                                        prm->sendcounts_summary, commsize);
     }
     int64_t recvsize = (prm->recvcount *
                         cb->typesize(prm->recvtype, wall->start));
-    cb->handle(DUMPI_Scatterv, thread, cpu, wall, perf, sendsize, dest,
+    cb->handle(thelabel, thread, cpu, wall, perf, sendsize, dest,
                recvsize, source, prm);
     return 1;
   }
 
-  static
-  int report_MPI_Allgather(const dumpi_allgather *prm, uint16_t thread,
+  template <typename thetype, dumpi_function thelabel>
+  int report_MPI_Allgather(const thetype *prm, uint16_t thread,
                            const dumpi_time *cpu, const dumpi_time *wall,
                            const dumpi_perfinfo *perf, void *uarg)
   {
     callbacks *cb = (callbacks*)uarg;
     int64_t sendsize = cb->typesize(prm->sendtype, wall->start)*prm->sendcount;
     int64_t recvsize = cb->typesize(prm->recvtype, wall->start)*prm->recvcount;
-    cb->handle(DUMPI_Allgather, thread, cpu, wall, perf,
+    cb->handle(thelabel, thread, cpu, wall, perf,
                sendsize, -1, recvsize, -1, prm);
     return 1;
   }
 
-  static
-  int report_MPI_Allgatherv(const dumpi_allgatherv *prm, uint16_t thread,
+  template <typename thetype, dumpi_function thelabel>
+  int report_MPI_Allgatherv(const thetype *prm, uint16_t thread,
                             const dumpi_time *cpu, const dumpi_time *wall,
                             const dumpi_perfinfo *perf, void *uarg)
   {
@@ -397,15 +418,15 @@ namespace dumpi {
     int recvsize = 0;
     int recvtypesize = cb->typesize(prm->recvtype, wall->start);
     int commsize = cb->commsize(prm->comm, wall->start);
-    for(int i = 0; i < commsize; ++i)
-      recvsize += recvtypesize * prm->recvcounts[i];
-    cb->handle(DUMPI_Allgatherv, thread, cpu, wall, perf,
+    recvsize = recvtypesize * count_total(prm->recvcounts,
+                                          prm->recvcounts_summary, commsize);
+    cb->handle(thelabel, thread, cpu, wall, perf,
                sendsize, -1, recvsize, -1, prm);
     return 1;
   }
 
-  static
-  int report_MPI_Alltoall(const dumpi_alltoall *prm, uint16_t thread,
+  template <typename thetype, dumpi_function thelabel>
+  int report_MPI_Alltoall(const thetype *prm, uint16_t thread,
                           const dumpi_time *cpu, const dumpi_time *wall,
                           const dumpi_perfinfo *perf, void *uarg)
   {
@@ -415,13 +436,13 @@ namespace dumpi {
     int64_t sendsize = sendtypesize * prm->sendcount * commsize;
     int64_t recvtypesize = cb->typesize(prm->recvtype, wall->start);
     int64_t recvsize = recvtypesize * prm->recvcount * commsize;
-    cb->handle(DUMPI_Alltoall, thread, cpu, wall, perf,
+    cb->handle(thelabel, thread, cpu, wall, perf,
                sendsize, -1, recvsize, -1, prm);
     return 1;
   }
 
-  static
-  int report_MPI_Alltoallv(const dumpi_alltoallv *prm, uint16_t thread,
+  template <typename thetype, dumpi_function thelabel>
+  int report_MPI_Alltoallv(const thetype *prm, uint16_t thread,
                            const dumpi_time *cpu, const dumpi_time *wall,
                            const dumpi_perfinfo *perf, void *uarg)
   {
@@ -429,18 +450,19 @@ namespace dumpi {
     int64_t sendtypesize = cb->typesize(prm->sendtype, wall->start);
     int64_t recvtypesize = cb->typesize(prm->recvtype, wall->start);
     int commsize = cb->commsize(prm->comm, wall->start);
-    int64_t sendsize = 0, recvsize = 0;
-    for(int i = 0; i < commsize; ++i) {
-      sendsize += sendtypesize * prm->sendcounts[i];
-      recvsize += recvtypesize * prm->recvcounts[i];
-    }
-    cb->handle(DUMPI_Alltoallv, thread, cpu, wall, perf,
+    int64_t sendsize = sendtypesize * count_total(prm->sendcounts,
+                                                  prm->sendcounts_summary,
+                                                  commsize);
+    int64_t recvsize = recvtypesize * count_total(prm->recvcounts,
+                                                  prm->recvcounts_summary,
+                                                  commsize);
+    cb->handle(thelabel, thread, cpu, wall, perf,
                sendsize, -1, recvsize, -1, prm);
     return 1;
   }
 
-  static
-  int report_MPI_Reduce(const dumpi_reduce *prm, uint16_t thread,
+  template <typename thetype, dumpi_function thelabel>
+  int report_MPI_Reduce(const thetype *prm, uint16_t thread,
                         const dumpi_time *cpu, const dumpi_time *wall,
                         const dumpi_perfinfo *perf, void *uarg)
   {
@@ -453,13 +475,13 @@ namespace dumpi {
     if(cb->commrank(prm->comm, wall->start) == prm->root) {
       recvsize = sendsize * cb->commsize(prm->comm, wall->start);
     }
-    cb->handle(DUMPI_Reduce, thread, cpu, wall, perf,
+    cb->handle(thelabel, thread, cpu, wall, perf,
                sendsize, dest, recvsize, source, prm);
     return 1;
   }
 
-  static
-  int report_MPI_Allreduce(const dumpi_allreduce *prm, uint16_t thread,
+  template <typename thetype, dumpi_function thelabel>
+  int report_MPI_Allreduce(const thetype *prm, uint16_t thread,
                            const dumpi_time *cpu, const dumpi_time *wall,
                            const dumpi_perfinfo *perf, void *uarg)
   {
@@ -467,13 +489,13 @@ namespace dumpi {
     int64_t typesize = cb->typesize(prm->datatype, wall->start);
     int64_t unitsize = prm->count * typesize;
     int64_t totalsize = unitsize; // * cb->commsize(prm->comm, wall->start);
-    cb->handle(DUMPI_Allreduce, thread, cpu, wall, perf,
+    cb->handle(thelabel, thread, cpu, wall, perf,
                totalsize, -1, totalsize, -1, prm);
     return 1;
   }
 
-  static
-  int report_MPI_Reduce_scatter(const dumpi_reduce_scatter *prm,
+  template <typename thetype, dumpi_function thelabel>
+  int report_MPI_Reduce_scatter(const thetype *prm,
                                 uint16_t thread, const dumpi_time *cpu,
                                 const dumpi_time *wall,
                                 const dumpi_perfinfo *perf, void *uarg)
@@ -481,17 +503,16 @@ namespace dumpi {
     callbacks *cb = (callbacks*)uarg;
     int64_t typesize = cb->typesize(prm->datatype, wall->start);
     int64_t commsize = cb->commsize(prm->comm, wall->start);
-    int64_t elements = 0;
-    for(int i = 0; i < commsize; ++i)
-      elements += prm->recvcounts[i];
+    int64_t elements = count_total(prm->recvcounts, prm->recvcounts_summary,
+                                   commsize);
     int64_t basesize = elements * typesize;
-    cb->handle(DUMPI_Reduce, thread, cpu, wall, perf,
+    cb->handle(thelabel, thread, cpu, wall, perf,
                basesize, -1, basesize, -1, prm);  
     return 1;
   }
 
-  static
-  int report_MPI_Scan(const dumpi_scan *prm, uint16_t thread,
+  template <typename thetype, dumpi_function thelabel>
+  int report_MPI_Scan(const thetype *prm, uint16_t thread,
                       const dumpi_time *cpu, const dumpi_time *wall,
                       const dumpi_perfinfo *perf, void *uarg)
   {
@@ -510,32 +531,43 @@ namespace dumpi {
         sendsize = 0;
       }
     }
-    cb->handle(DUMPI_Scan, thread, cpu, wall, perf,
+    cb->handle(thelabel, thread, cpu, wall, perf,
                sendsize, global_dest, recvsize, global_source, prm);
     return 1;
   }
 
-  static
-  int report_MPI_Alltoallw(const dumpi_alltoallw *prm, uint16_t thread,
+  template <typename thetype, dumpi_function thelabel>
+  int report_MPI_Alltoallw(const thetype *prm, uint16_t thread,
                            const dumpi_time *cpu, const dumpi_time *wall,
                            const dumpi_perfinfo *perf, void *uarg)
   {
     callbacks *cb = (callbacks*)uarg;
     int commsize = cb->commsize(prm->comm, wall->start);
     int64_t sendsize = 0, recvsize = 0;
-    for(int i = 0; i < commsize; ++i) {
-      int64_t sendtypesize = cb->typesize(prm->sendtypes[i], wall->start);
-      int64_t recvtypesize = cb->typesize(prm->recvtypes[i], wall->start);
-      sendsize += sendtypesize * prm->sendcounts[i];
-      recvsize += recvtypesize * prm->recvcounts[i];
+    if(prm->detail == DUMPI_DETAIL_SUMMARIZED) {
+      // Each side of a summarized record uses a single datatype.
+      if(commsize > 0) {
+        sendsize = (cb->typesize(prm->sendtypes[0], wall->start) *
+                    prm->sendcounts_summary.total);
+        recvsize = (cb->typesize(prm->recvtypes[0], wall->start) *
+                    prm->recvcounts_summary.total);
+      }
+    }
+    else {
+      for(int i = 0; i < commsize; ++i) {
+        int64_t sendtypesize = cb->typesize(prm->sendtypes[i], wall->start);
+        int64_t recvtypesize = cb->typesize(prm->recvtypes[i], wall->start);
+        sendsize += sendtypesize * prm->sendcounts[i];
+        recvsize += recvtypesize * prm->recvcounts[i];
+      }
     }
-    cb->handle(DUMPI_Alltoallw, thread, cpu, wall, perf,
+    cb->handle(thelabel, thread, cpu, wall, perf,
                sendsize, -1, recvsize, -1, prm);
     return 1;
   }
 
-  static
-  int report_MPI_Exscan(const dumpi_exscan *prm, uint16_t thread,
+  template <typename thetype, dumpi_function thelabel>
+  int report_MPI_Exscan(const thetype *prm, uint16_t thread,
                         const dumpi_time *cpu, const dumpi_time *wall,
                         const dumpi_perfinfo *perf, void *uarg)
   {
@@ -552,15 +584,187 @@ namespace dumpi {
     else if(commrank >= (commsize-1)) {
       sendsize = 0;
     }
-    cb->handle(DUMPI_Scan, thread, cpu, wall, perf,
+    cb->handle(thelabel, thread, cpu, wall, perf,
                sendsize, global_dest, recvsize, global_source, prm);
     return 1;
   }
 
+  // Pass a neighborhood collective on as one call, then the bytes sent
+  // to each destination of the topology (MPI_PROC_NULL neighbors are -1
+  // and get nothing).
+  static void report_neighbors(callbacks *cb, dumpi_function label,
+                               uint16_t thread, const dumpi_time *cpu,
+                               const dumpi_time *wall,
+                               const dumpi_perfinfo *perf, dumpi_comm comm,
+                               const std::vector<int64_t> &sent,
+                               int64_t recvsize, const void *prm)
+  {
+    int64_t sendsize = 0;
+    for(size_t i = 0; i < sent.size(); ++i)
+      sendsize += sent[i];
+    cb->handle(label, thread, cpu, wall, perf,
+               sendsize, -1, recvsize, -1, prm);
+    const std::vector<int> &dest = cb->destinations(comm, wall->start);
+    for(size_t i = 0; i < dest.size() && i < sent.size(); ++i) {
+      int peer = cb->globalrank(dest[i], comm, wall->start);
+      if(peer >= 0)
+        cb->handle_peer(label, wall, sent[i], peer);
+    }
+  }
+
+  static
+  int report_MPI_Neighbor_allgather(const dumpi_neighbor_allgather *prm,
+                                    uint16_t thread, const dumpi_time *cpu,
+                                    const dumpi_time *wall,
+                                    const dumpi_perfinfo *perf, void *uarg)
+  {
+    callbacks *cb = (callbacks*)uarg;
+    int outdegree = cb->destinations(prm->comm, wall->start).size();
+    int indegree = cb->sources(prm->comm, wall->start).size();
+    std::vector<int64_t> sent(outdegree, prm->sendcount *
+                              int64_t(cb->typesize(prm->sendtype,
+                                                   wall->start)));
+    int64_t recvsize = (int64_t(cb->typesize(prm->recvtype, wall->start)) *
+                        prm->recvcount * indegree);
+    report_neighbors(cb, DUMPI_Neighbor_allgather, thread, cpu, wall, perf,
+                     prm->comm, sent, recvsize, prm);
+    return 1;
+  }
+
+  static
+  int report_MPI_Neighbor_allgatherv(const dumpi_neighbor_allgatherv *prm,
+                                     uint16_t thread, const dumpi_time *cpu,
+                                     const dumpi_time *wall,
+                                     const dumpi_perfinfo *perf, void *uarg)
+  {
+    callbacks *cb = (callbacks*)uarg;
+    int outdegree = cb->destinations(prm->comm, wall->start).size();
+    std::vector<int64_t> sent(outdegree, prm->sendcount *
+                              int64_t(cb->typesize(prm->sendtype,
+                                                   wall->start)));
+    int64_t recvsize = (cb->typesize(prm->recvtype, wall->start) *
+                        count_total(prm->recvcounts, prm->indegree));
+    report_neighbors(cb, DUMPI_Neighbor_allgatherv, thread, cpu, wall, perf,
+                     prm->comm, sent, recvsize, prm);
+    return 1;
+  }
+
+  static
+  int report_MPI_Neighbor_alltoall(const dumpi_neighbor_alltoall *prm,
+                                   uint16_t thread, const dumpi_time *cpu,
+                                   const dumpi_time *wall,
+                                   const dumpi_perfinfo *perf, void *uarg)
+  {
+    callbacks *cb = (callbacks*)uarg;
+    int outdegree = cb->destinations(prm->comm, wall->start).size();
+    int indegree = cb->sources(prm->comm, wall->start).size();
+    std::vector<int64_t> sent(outdegree, prm->sendcount *
+                              int64_t(cb->typesize(prm->sendtype,
+                                                   wall->start)));
+    int64_t recvsize = (int64_t(cb->typesize(prm->recvtype, wall->start)) *
+                        prm->recvcount * indegree);
+    report_neighbors(cb, DUMPI_Neighbor_alltoall, thread, cpu, wall, perf,
+                     prm->comm, sent, recvsize, prm);
+    return 1;
+  }
+
+  static
+  int report_MPI_Neighbor_alltoallv(const dumpi_neighbor_alltoallv *prm,
+                                    uint16_t thread, const dumpi_time *cpu,
+                                    const dumpi_time *wall,
+                                    const dumpi_perfinfo *perf, void *uarg)
+  {
+    callbacks *cb = (callbacks*)uarg;
+    int64_t sendtypesize = cb->typesize(prm->sendtype, wall->start);
+    std::vector<int64_t> sent(prm->outdegree);
+    for(int i = 0; i < prm->outdegree; ++i)
+      sent[i] = sendtypesize * prm->sendcounts[i];
+    int64_t recvsize = (cb->typesize(prm->recvtype, wall->start) *
+                        count_total(prm->recvcounts, prm->indegree));
+    report_neighbors(cb, DUMPI_Neighbor_alltoallv, thread, cpu, wall, perf,
+                     prm->comm, sent, recvsize, prm);
+    return 1;
+  }
+
+  static
+  int report_MPI_Neighbor_alltoallw(const dumpi_neighbor_alltoallw *prm,
+                                    uint16_t thread, const dumpi_time *cpu,
+                                    const dumpi_time *wall,
+                                    const dumpi_perfinfo *perf, void *uarg)
+  {
+    callbacks *cb = (callbacks*)uarg;
+    std::vector<int64_t> sent(prm->outdegree);
+    for(int i = 0; i < prm->outdegree; ++i)
+      sent[i] = (int64_t(cb->typesize(prm->sendtypes[i], wall->start)) *
+                 prm->sendcounts[i]);
+    int64_t recvsize = 0;
+    for(int i = 0; i < prm->indegree; ++i)
+      recvsize += (int64_t(cb->typesize(prm->recvtypes[i], wall->start)) *
+                   prm->recvcounts[i]);
+    report_neighbors(cb, DUMPI_Neighbor_alltoallw, thread, cpu, wall, perf,
+                     prm->comm, sent, recvsize, prm);
+    return 1;
+  }
+
+  // The sender of a matched message is known at the probe;  the receive
+  // only names the message.
+  static
+  int report_MPI_Mprobe(const dumpi_mprobe *prm, uint16_t thread,
+                        const dumpi_time *cpu, const dumpi_time *wall,
+                        const dumpi_perfinfo *perf, void *uarg)
+  {
+    callbacks *cb = (callbacks*)uarg;
+    int source = (prm->status ? prm->status->source : prm->source);
+    cb->probed(prm->message, cb->globalrank(source, prm->comm, wall->start));
+    cb->handle(DUMPI_Mprobe, thread, cpu, wall, perf, 0, -1, 0, -1, prm);
+    return 1;
+  }
+
+  static
+  int report_MPI_Improbe(const dumpi_improbe *prm, uint16_t thread,
+                         const dumpi_time *cpu, const dumpi_time *wall,
+                         const dumpi_perfinfo *perf, void *uarg)
+  {
+    callbacks *cb = (callbacks*)uarg;
+    if(prm->flag) {
+      int source = (prm->status ? prm->status->source : prm->source);
+      cb->probed(prm->message, cb->globalrank(source, prm->comm,
+                                              wall->start));
+    }
+    cb->handle(DUMPI_Improbe, thread, cpu, wall, perf, 0, -1, 0, -1, prm);
+    return 1;
+  }
+
+  static
+  int report_MPI_Mrecv(const dumpi_mrecv *prm, uint16_t thread,
+                       const dumpi_time *cpu, const dumpi_time *wall,
+                       const dumpi_perfinfo *perf, void *uarg)
+  {
+    callbacks *cb = (callbacks*)uarg;
+    int64_t datasize = cb->typesize(prm->datatype, wall->start);
+    int source = cb->matched(prm->message);
+    cb->handle(DUMPI_Mrecv, thread, cpu, wall, perf, 0, -1,
+               prm->count * datasize, source, prm);
+    return 1;
+  }
+
+  static
+  int report_MPI_Imrecv(const dumpi_imrecv *prm, uint16_t thread,
+                        const dumpi_time *cpu, const dumpi_time *wall,
+                        const dumpi_perfinfo *perf, void *uarg)
+  {
+    callbacks *cb = (callbacks*)uarg;
+    int64_t datasize = cb->typesize(prm->datatype, wall->start);
+    int source = cb->matched(prm->message);
+    cb->handle(DUMPI_Imrecv, thread, cpu, wall, perf, 0, -1,
+               prm->count * datasize, source, prm);
+    return 1;
+  }
+
   //
   // Set up callbacks.
   //
-  callbacks::callbacks() {
+  callbacks::callbacks() : profile_(NULL), sites_(NULL) {
     memset(&cb, 1, sizeof(libundumpi_callbacks));
     cb.on_send = report_MPI_Send;
     cb.on_recv = report_MPI_Recv;
@@ -620,21 +824,23 @@ namespace dumpi {
     cb.on_unpack = report_generic<dumpi_unpack, DUMPI_Unpack>;
     cb.on_pack_size = report_generic<dumpi_pack_size, DUMPI_Pack_size>;
     cb.on_barrier = report_generic<dumpi_barrier, DUMPI_Barrier>;
-    cb.on_bcast = report_MPI_Bcast;
-    cb.on_gather = report_MPI_Gather;
-    cb.on_gatherv = report_MPI_Gatherv;
-    cb.on_scatter = report_MPI_Scatter;
-    cb.on_scatterv = report_MPI_Scatterv;
-    cb.on_allgather = report_MPI_Allgather;
-    cb.on_allgatherv = report_MPI_Allgatherv;
-    cb.on_alltoall = report_MPI_Alltoall;
-    cb.on_alltoallv = report_MPI_Alltoallv;
-    cb.on_reduce = report_MPI_Reduce;
+    cb.on_bcast = report_MPI_Bcast<dumpi_bcast, DUMPI_Bcast>;
+    cb.on_gather = report_MPI_Gather<dumpi_gather, DUMPI_Gather>;
+    cb.on_gatherv = report_MPI_Gatherv<dumpi_gatherv, DUMPI_Gatherv>;
+    cb.on_scatter = report_MPI_Scatter<dumpi_scatter, DUMPI_Scatter>;
+    cb.on_scatterv = report_MPI_Scatterv<dumpi_scatterv, DUMPI_Scatterv>;
+    cb.on_allgather = report_MPI_Allgather<dumpi_allgather, DUMPI_Allgather>;
+    cb.on_allgatherv =
+      report_MPI_Allgatherv<dumpi_allgatherv, DUMPI_Allgatherv>;
+    cb.on_alltoall = report_MPI_Alltoall<dumpi_alltoall, DUMPI_Alltoall>;
+    cb.on_alltoallv = report_MPI_Alltoallv<dumpi_alltoallv, DUMPI_Alltoallv>;
+    cb.on_reduce = report_MPI_Reduce<dumpi_reduce, DUMPI_Reduce>;
     cb.on_op_create = report_generic<dumpi_op_create, DUMPI_Op_create>;
     cb.on_op_free = report_generic<dumpi_op_free, DUMPI_Op_free>;
-    cb.on_allreduce = report_MPI_Allreduce;
-    cb.on_reduce_scatter = report_MPI_Reduce_scatter;
-    cb.on_scan = report_MPI_Scan;
+    cb.on_allreduce = report_MPI_Allreduce<dumpi_allreduce, DUMPI_Allreduce>;
+    cb.on_reduce_scatter =
+      report_MPI_Reduce_scatter<dumpi_reduce_scatter, DUMPI_Reduce_scatter>;
+    cb.on_scan = report_MPI_Scan<dumpi_scan, DUMPI_Scan>;
     cb.on_group_size = report_generic<dumpi_group_size, DUMPI_Group_size>;
     cb.on_group_rank = report_generic<dumpi_group_rank, DUMPI_Group_rank>;
     cb.on_group_translate_ranks =
@@ -746,8 +952,8 @@ namespace dumpi {
     cb.on_win_test = report_generic<dumpi_win_test, DUMPI_Win_test>;
     cb.on_win_unlock = report_generic<dumpi_win_unlock, DUMPI_Win_unlock>;
     cb.on_win_wait = report_generic<dumpi_win_wait, DUMPI_Win_wait>;
-    cb.on_alltoallw = report_MPI_Alltoallw;
-    cb.on_exscan = report_MPI_Exscan;
+    cb.on_alltoallw = report_MPI_Alltoallw<dumpi_alltoallw, DUMPI_Alltoallw>;
+    cb.on_exscan = report_MPI_Exscan<dumpi_exscan, DUMPI_Exscan>;
     cb.on_add_error_class =
       report_generic<dumpi_add_error_class, DUMPI_Add_error_class>;
     cb.on_add_error_code =
@@ -987,20 +1193,56 @@ namespace dumpi {
     cb.on_iowaitany = report_generic<dumpio_waitany, DUMPIO_Waitany>;
     cb.on_iowaitsome = report_generic<dumpio_waitsome, DUMPIO_Waitsome>;
     cb.on_iotestsome = report_generic<dumpio_testsome, DUMPIO_Testsome>;
+    cb.on_ibarrier = report_generic<dumpi_ibarrier, DUMPI_Ibarrier>;
+    cb.on_ibcast = report_MPI_Bcast<dumpi_ibcast, DUMPI_Ibcast>;
+    cb.on_igather = report_MPI_Gather<dumpi_igather, DUMPI_Igather>;
+    cb.on_igatherv = report_MPI_Gatherv<dumpi_igatherv, DUMPI_Igatherv>;
+    cb.on_iscatter = report_MPI_Scatter<dumpi_iscatter, DUMPI_Iscatter>;
+    cb.on_iscatterv = report_MPI_Scatterv<dumpi_iscatterv, DUMPI_Iscatterv>;
+    cb.on_iallgather = report_MPI_Allgather<dumpi_iallgather, DUMPI_Iallgather>;
+    cb.on_iallgatherv =
+      report_MPI_Allgatherv<dumpi_iallgatherv, DUMPI_Iallgatherv>;
+    cb.on_ialltoall = report_MPI_Alltoall<dumpi_ialltoall, DUMPI_Ialltoall>;
+    cb.on_ialltoallv = report_MPI_Alltoallv<dumpi_ialltoallv, DUMPI_Ialltoallv>;
+    cb.on_ialltoallw = report_MPI_Alltoallw<dumpi_ialltoallw, DUMPI_Ialltoallw>;
+    cb.on_ireduce = report_MPI_Reduce<dumpi_ireduce, DUMPI_Ireduce>;
+    cb.on_iallreduce = report_MPI_Allreduce<dumpi_iallreduce, DUMPI_Iallreduce>;
+    cb.on_ireduce_scatter =
+      report_MPI_Reduce_scatter<dumpi_ireduce_scatter, DUMPI_Ireduce_scatter>;
+    cb.on_iscan = report_MPI_Scan<dumpi_iscan, DUMPI_Iscan>;
+    cb.on_iexscan = report_MPI_Exscan<dumpi_iexscan, DUMPI_Iexscan>;
+    cb.on_dist_graph_create_adjacent =
+      report_generic<dumpi_dist_graph_create_adjacent,
+                     DUMPI_Dist_graph_create_adjacent>;
+    cb.on_neighbor_allgather = report_MPI_Neighbor_allgather;
+    cb.on_neighbor_allgatherv = report_MPI_Neighbor_allgatherv;
+    cb.on_neighbor_alltoall = report_MPI_Neighbor_alltoall;
+    cb.on_neighbor_alltoallv = report_MPI_Neighbor_alltoallv;
+    cb.on_neighbor_alltoallw = report_MPI_Neighbor_alltoallw;
+    cb.on_mprobe = report_MPI_Mprobe;
+    cb.on_improbe = report_MPI_Improbe;
+    cb.on_mrecv = report_MPI_Mrecv;
+    cb.on_imrecv = report_MPI_Imrecv;
     cb.on_function_enter = report_function_enter;
     cb. on_function_exit =
       report_generic<dumpi_func_call, DUMPI_Function_exit>;  
+    cb.on_function_call =
+      report_generic<dumpi_func_call, DUMPI_Function_call>;
   }
 
   //
   // Run through all the traces in the given metafile
   //
   void callbacks::go(const metadata &meta, std::vector<trace> &trace,
-                     std::vector<binbase*> &bin)
+                     std::vector<binbase*> &bin, callsitetable *sites)
   {
     trace_ = &trace;
     bin_ = &bin;
+    sites_ = sites;
     for(current_trace_ = 0; current_trace_ < meta.traces(); ++current_trace_) {
+      // Ranks left out of trace-ranks get no rows of their own.
+      if(! meta.traced(current_trace_))
+        continue;
       std::string tname = meta.tracename(current_trace_);
       dumpi_profile *prof = undumpi_open(tname.c_str());
       // Get function addresses.
@@ -1015,16 +1257,22 @@ namespace dumpi {
       }
       free(labels);
       free(names);
+      if(sites_)
+        sites_->start_trace(current_trace_, labels_);
       // Rest of the stuff.
       for(size_t hand = 0; hand < bin.size(); ++hand)
         bin[hand]->start_trace(current_trace_);
+      profile_ = prof;
+      messages_.clear();
       undumpi_read_stream(prof, &cb, this);
+      profile_ = NULL;
       undumpi_close(prof);
     }
     for(size_t hand = 0; hand < bin.size(); ++hand)
       bin[hand]->reset_trace();
     bin_ = NULL;
     trace_ = NULL;
+    sites_ = NULL;
   }
 
   //
@@ -1037,6 +1285,8 @@ namespace dumpi {
                          int64_t bytes_recvd, int from_global_rank,
                          const void *dumpi_arg)
   {
+    if(sites_)
+      sites_->handle(func, profile_->callsite, wall);
     for(size_t hand = 0;hand < bin_->size(); ++hand)
       bin_->at(hand)->handle(func, thread, cpu, wall, perf,
                              bytes_sent, to_global_rank,
@@ -1044,6 +1294,16 @@ namespace dumpi {
                              dumpi_arg);
   }
 
+  //
+  // Forward the bytes sent to one peer to all bins.
+  //
+  void callbacks::handle_peer(dumpi_function func, const dumpi_time *wall,
+                              int64_t bytes_sent, int to_global_rank)
+  {
+    for(size_t hand = 0; hand < bin_->size(); ++hand)
+      bin_->at(hand)->handle_peer(func, wall, bytes_sent, to_global_rank);
+  }
+
   //
   // Given an annotation, pass it on to the handlers.
   //
@@ -1099,4 +1359,33 @@ namespace dumpi {
       return localrank;
   }
 
+  /// Get the neighbors we receive from in the given communicator.
+  const std::vector<int>& callbacks::sources(dumpi_comm comm,
+                                             const dumpi_clock &when) const
+  {
+    return trace_->at(current_trace_).get_comm(comm, when).get_sources();
+  }
+
+  /// Get the neighbors we send to in the given communicator.
+  const std::vector<int>& callbacks::destinations(dumpi_comm comm,
+                                                  const dumpi_clock &when) const
+  {
+    return trace_->at(current_trace_).get_comm(comm, when).get_destinations();
+  }
+
+  /// Remember the sender of a matched message.
+  void callbacks::probed(dumpi_message message, int global_source) {
+    messages_[message] = global_source;
+  }
+
+  /// Get (and forget) the sender of a matched message.
+  int callbacks::matched(dumpi_message message) {
+    std::map<dumpi_message, int>::iterator it = messages_.find(message);
+    if(it == messages_.end())
+      return -1;
+    int source = it->second;
+    messages_.erase(it);
+    return source;
+  }
+
 } // end of namespace dumpi
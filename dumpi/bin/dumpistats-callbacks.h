@@ -13,6 +13,7 @@
 #define DUMPI_BIN_DUMPISTATS_CALLBACKS_H
 
 #include <dumpi/bin/dumpistats-binbase.h>
+#include <dumpi/bin/dumpistats-callsites.h>
 #include <dumpi/bin/metadata.h>
 #include <dumpi/bin/trace.h>
 #include <dumpi/libundumpi/callbacks.h>
@@ -32,14 +33,21 @@ namespace dumpi {
     int current_trace_;
     /// All valid function entry addresses
     std::map<uint64_t, std::string> labels_;
+    /// Trace being read (for the call site of each record).
+    dumpi_profile *profile_;
+    /// Time by call site (NULL unless requested).
+    callsitetable *sites_;
+    /// Senders of messages taken by MPI_Mprobe or MPI_Improbe.
+    std::map<dumpi_message, int> messages_;
 
   public:
     /// Setup.
     callbacks();
 
     /// Run through all the traces in the given metafile
+    /// Calls are also added to sites if it is not NULL.
     void go(const metadata &meta, std::vector<trace> &trace,
-            std::vector<binbase*> &bin);
+            std::vector<binbase*> &bin, callsitetable *sites = NULL);
 
     /// Forward a call to all bins.
     void handle(dumpi_function func, uint16_t thread,
@@ -49,6 +57,10 @@ namespace dumpi {
                 int64_t bytes_recvd, int from_global_rank,
                 const void *dumpi_arg);
 
+    /// Forward the bytes sent to one peer by the call last passed to handle.
+    void handle_peer(dumpi_function func, const dumpi_time *wall,
+                     int64_t bytes_sent, int to_global_rank);
+
     /// Given an annotation, pass it on to the handlers.
     /// Valid annotations are assumed to start with "ANNOTATE: "
     void annotate(const dumpi_func_call *prm, uint16_t thread,
@@ -66,6 +78,23 @@ namespace dumpi {
 
     /// Get the global rank of the given node in the given communicator.
     int globalrank(int localrank, dumpi_comm comm, const dumpi_clock &when)const;
+
+    /// Get the local ranks we receive from in neighborhood collectives on
+    /// the given communicator (empty unless it has a process topology).
+    const std::vector<int>& sources(dumpi_comm comm,
+                                    const dumpi_clock &when) const;
+
+    /// Get the local ranks we send to in neighborhood collectives on the
+    /// given communicator (empty unless it has a process topology).
+    const std::vector<int>& destinations(dumpi_comm comm,
+                                         const dumpi_clock &when) const;
+
+    /// Remember the global rank of the sender of a matched message.
+    void probed(dumpi_message message, int global_source);
+
+    /// Get (and forget) the global rank of the sender of a matched message.
+    /// Returns -1 if no matched probe took it.
+    int matched(dumpi_message message);
   };
 
 } // end of namespace dumpi
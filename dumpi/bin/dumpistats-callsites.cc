@@ -0,0 +1,121 @@
+/*
+ *  This file is part of DUMPI: 
+ *               The MPI profiling library from the SST suite.
+ *  Copyright (c) 2009 Sandia Corporation.
+ *  This software is distributed under the BSD License.
+ *  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+ *  the U.S. Government retains certain rights in this software.
+ *  For more information, see the LICENSE file in the top 
+ *  SST/macroscale directory.
+ */
+
+#include <dumpi/bin/dumpistats-callsites.h>
+#include <dumpi/common/settings.h>
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <algorithm>
+
+namespace dumpi {
+
+  //
+  // Frames look like "module(symbol+offset) [address]" (or just
+  // "[address]" when nothing better is known).  Drop the address where
+  // the module and offset say the same thing, since it changes from one
+  // process to the next when code is loaded at random addresses.
+  //
+  static std::string strip_addresses(const std::string &path) {
+    static const std::string prefix = "CALLSITE: ";
+    std::string text = path, result;
+    if(text.compare(0, prefix.size(), prefix) == 0)
+      text = text.substr(prefix.size());
+    size_t pos = 0;
+    while(pos < text.size()) {
+      size_t open = text.find(") [", pos);
+      if(open == std::string::npos) {
+        result += text.substr(pos);
+        break;
+      }
+      size_t close = text.find(']', open);
+      if(close == std::string::npos) {
+        result += text.substr(pos);
+        break;
+      }
+      result += text.substr(pos, open + 1 - pos);
+      pos = close + 1;
+    }
+    return result;
+  }
+
+  callsitetable::callsitetable(const std::string &pattern) :
+    match_(pattern), rank_(-1), untagged_(0)
+  {}
+
+  void callsitetable::start_trace(int rank,
+                                  const std::map<uint64_t,std::string> &labels)
+  {
+    rank_ = rank;
+    paths_.clear();
+    std::map<uint64_t,std::string>::const_iterator it;
+    for(it = labels.begin(); it != labels.end(); ++it)
+      if(DUMPI_IS_CALLSITE_KEY(it->first))
+        paths_[DUMPI_CALLSITE_ID(it->first)] = strip_addresses(it->second);
+  }
+
+  void callsitetable::handle(dumpi_function func, uint32_t site,
+                             const dumpi_time *wall)
+  {
+    if(! match_.collects(func))
+      return;
+    std::map<uint32_t, std::string>::const_iterator it = paths_.find(site);
+    if(site == 0 || it == paths_.end()) {
+      ++untagged_;
+      return;
+    }
+    totals &tot = totals_[std::make_pair(it->second, int(func))];
+    ++tot.calls;
+    tot.wall_nsec += ((int64_t(wall->stop.sec) - wall->start.sec)*1000000000LL
+                      + (int64_t(wall->stop.nsec) - wall->start.nsec));
+    tot.ranks.insert(rank_);
+  }
+
+  typedef std::pair<std::pair<std::string,int>, int64_t> site_row;
+
+  static bool more_time(const site_row &a, const site_row &b) {
+    return a.second > b.second;
+  }
+
+  void callsitetable::write(const std::string &fname) const {
+    std::ofstream out(fname.c_str());
+    if(! out) {
+      std::cerr << "Failed to open outfile " << fname << "\n";
+      throw "Failed to open outfile.";
+    }
+    std::vector<site_row> rows;
+    std::map<std::pair<std::string,int>, totals>::const_iterator it;
+    for(it = totals_.begin(); it != totals_.end(); ++it)
+      rows.push_back(site_row(it->first, it->second.wall_nsec));
+    std::stable_sort(rows.begin(), rows.end(), more_time);
+    out << "########################################################\n"
+        << "# Time in MPI calls by call site (callsites)\n"
+        << "#\n"
+        << "# Column 1 is total wall time in seconds\n"
+        << "# Column 2 is the number of calls\n"
+        << "# Column 3 is the number of ranks that made them\n"
+        << "# Column 4 is the MPI function\n"
+        << "# Column 5 is the call path, innermost frame first\n";
+    if(untagged_)
+      out << "# " << untagged_ << " matching calls had no call site\n";
+    out << "#\n";
+    for(size_t i = 0; i < rows.size(); ++i) {
+      const totals &tot = totals_.find(rows[i].first)->second;
+      out << std::setw(20) << std::fixed << std::setprecision(9)
+          << (tot.wall_nsec * 1e-9) << " "
+          << std::setw(12) << tot.calls << " "
+          << std::setw(8) << tot.ranks.size() << " "
+          << dumpi_function_label(dumpi_function(rows[i].first.second)) << " "
+          << rows[i].first.first << "\n";
+    }
+  }
+
+} // end of namespace dumpi
@@ -0,0 +1,64 @@
+/*
+ *  This file is part of DUMPI: 
+ *               The MPI profiling library from the SST suite.
+ *  Copyright (c) 2009 Sandia Corporation.
+ *  This software is distributed under the BSD License.
+ *  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+ *  the U.S. Government retains certain rights in this software.
+ *  For more information, see the LICENSE file in the top 
+ *  SST/macroscale directory.
+ */
+
+#ifndef DUMPI_BIN_DUMPISTATS_CALLSITES_H
+#define DUMPI_BIN_DUMPISTATS_CALLSITES_H
+
+#include <dumpi/bin/dumpistats-handlers.h>
+#include <dumpi/common/funclabels.h>
+#include <dumpi/common/types.h>
+#include <string>
+#include <vector>
+#include <map>
+#include <set>
+#include <stdint.h>
+
+namespace dumpi {
+
+  /**
+   * Time and calls grouped by call site and function, over all traced
+   * ranks and the whole run (records carry call-site ids when libdumpi
+   * was run with callsites N).
+   * Call-site ids are only meaningful within one trace file, so sites
+   * are matched across ranks by their text, without absolute addresses.
+   */
+  class callsitetable {
+    struct totals {
+      int64_t calls, wall_nsec;
+      std::set<int> ranks;
+      totals() : calls(0), wall_nsec(0) {}
+    };
+    counter match_;
+    int rank_;
+    /// Call paths of the current trace, by id
+    std::map<uint32_t, std::string> paths_;
+    /// Results, by call path and function
+    std::map<std::pair<std::string, int>, totals> totals_;
+    int64_t untagged_;
+
+  public:
+    /// Collect calls to functions that match the pattern
+    /// (same syntax as the other options).
+    callsitetable(const std::string &pattern);
+
+    /// Start reading the trace of a rank, given its function-address table.
+    void start_trace(int rank, const std::map<uint64_t, std::string> &labels);
+
+    /// Add a call from the given call site (0: none).
+    void handle(dumpi_function func, uint32_t site, const dumpi_time *wall);
+
+    /// Write the table to fname, sites with the most time first.
+    void write(const std::string &fname) const;
+  };
+
+} // end of namespace dumpi
+
+#endif // ! DUMPI_BIN_DUMPISTATS_CALLSITES_H
@@ -366,6 +366,18 @@ namespace dumpi {
     }
   }
 
+  //
+  // Bytes sent to one peer by the call last passed to handle().
+  //
+  void gatherbin::handle_peer(dumpi_function func, const dumpi_time *,
+                              int64_t bytes_sent, int to_global_rank)
+  {
+    if(active_) {
+      for(size_t i = 0; i < handlers_.size(); ++i)
+        handlers_[i]->handle_peer(func, bytes_sent, to_global_rank);
+    }
+  }
+
   //
   // Reset counters and internal state in preparation for a new trace.
   //
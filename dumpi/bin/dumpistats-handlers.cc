@@ -48,13 +48,20 @@ namespace dumpi {
     DUMPI_File_write_all_end, DUMPI_File_read_ordered_begin,
     DUMPI_File_read_ordered_end, DUMPI_File_write_ordered_begin,
     DUMPI_File_write_ordered_end, DUMPI_File_set_atomicity,
-    DUMPI_File_sync, -1
+    DUMPI_File_sync, DUMPI_Ibarrier, DUMPI_Ibcast, DUMPI_Igather,
+    DUMPI_Igatherv, DUMPI_Iscatter, DUMPI_Iscatterv, DUMPI_Iallgather,
+    DUMPI_Iallgatherv, DUMPI_Ialltoall, DUMPI_Ialltoallv, DUMPI_Ialltoallw,
+    DUMPI_Ireduce, DUMPI_Iallreduce, DUMPI_Ireduce_scatter, DUMPI_Iscan,
+    DUMPI_Iexscan, DUMPI_Dist_graph_create_adjacent,
+    DUMPI_Neighbor_allgather, DUMPI_Neighbor_allgatherv,
+    DUMPI_Neighbor_alltoall, DUMPI_Neighbor_alltoallv,
+    DUMPI_Neighbor_alltoallw, -1
   };
 
   static const int waits[] = {
     DUMPI_Wait, DUMPI_Waitany, DUMPI_Waitsome, DUMPI_Waitall, DUMPI_Probe,
     DUMPI_Start, DUMPI_Startall, DUMPI_Win_wait, DUMPIO_Wait, DUMPIO_Waitany,
-    DUMPIO_Waitsome, DUMPIO_Waitall, -1
+    DUMPIO_Waitsome, DUMPIO_Waitall, DUMPI_Mprobe, -1
   };
 
   static int sends[] = {
@@ -66,7 +73,7 @@ namespace dumpi {
 
   static const int recvs[] = {
     DUMPI_Recv, DUMPI_Irecv, DUMPI_Recv_init,
-    DUMPI_Sendrecv, DUMPI_Sendrecv_replace, -1
+    DUMPI_Sendrecv, DUMPI_Sendrecv_replace, DUMPI_Mrecv, DUMPI_Imrecv, -1
   };
 
   static const int ios[] = {
@@ -167,6 +174,13 @@ namespace dumpi {
   handlerbase::~handlerbase() {
   }
 
+  bool handlerbase::handle_aggregate(const dumpi_aggregate &) {
+    return false;
+  }
+
+  void handlerbase::handle_peer(dumpi_function, int64_t, int) {
+  }
+
   // Counter.
   counter::counter(const std::string &pattern) :
     handlerbase(pattern), count_(0)
@@ -206,6 +220,11 @@ namespace dumpi {
   {
     if(collect_[func]) ++count_;
   }
+  bool counter::handle_aggregate(const dumpi_aggregate &agg) {
+    for(int i = 0; i < DUMPI_ALL_FUNCTIONS; ++i)
+      if(collect_[i]) count_ += agg.func[i].calls;
+    return true;
+  }
 
   timer::timer(const std::string &pattern) :
     handlerbase(pattern), cpu_inside_mpi_(0), cpu_outside_mpi_(0),
@@ -276,6 +295,23 @@ namespace dumpi {
       last_cpu_ = *cpu;
       last_wall_ = *wall;    
   }
+  bool timer::handle_aggregate(const dumpi_aggregate &agg) {
+    int64_t cpu_inside = 0, wall_inside = 0;
+    for(int i = 0; i < DUMPI_ALL_FUNCTIONS; ++i) {
+      if(collect_[i]) {
+        cpu_inside += flatten(agg.func[i].cpu);
+        wall_inside += flatten(agg.func[i].wall);
+      }
+    }
+    cpu_inside_mpi_ += cpu_inside;
+    wall_inside_mpi_ += wall_inside;
+    // Calls made by several threads can add up to more than the elapsed time.
+    if(flatten(agg.elapsed_cpu) > cpu_inside)
+      cpu_outside_mpi_ += flatten(agg.elapsed_cpu) - cpu_inside;
+    if(flatten(agg.elapsed_wall) > wall_inside)
+      wall_outside_mpi_ += flatten(agg.elapsed_wall) - wall_inside;
+    return true;
+  }
   void timer::handle(dumpi_function func, uint16_t,
                      const dumpi_time *cpu, const dumpi_time *wall,
                      const dumpi_perfinfo*,
@@ -341,6 +377,11 @@ namespace dumpi {
     if(collect_[func])
       bytes_ += bytes_sent;
   }
+  bool sender::handle_aggregate(const dumpi_aggregate &agg) {
+    for(int i = 0; i < DUMPI_ALL_FUNCTIONS; ++i)
+      if(collect_[i]) bytes_ += agg.func[i].bytes_sent;
+    return true;
+  }
 
   // Recver.
   recver::recver(const std::string &pattern) :
@@ -380,6 +421,11 @@ namespace dumpi {
     if(collect_[func])
       bytes_ += bytes_recvd;
   }
+  bool recver::handle_aggregate(const dumpi_aggregate &agg) {
+    for(int i = 0; i < DUMPI_ALL_FUNCTIONS; ++i)
+      if(collect_[i]) bytes_ += agg.func[i].bytes_recvd;
+    return true;
+  }
 
   // Monitor full set of exchanges.
   exchanger::exchanger(const std::string &pattern) :
@@ -447,6 +493,13 @@ namespace dumpi {
         collrecvd_ += bytes_recvd;
     }
   }
+  void exchanger::handle_peer(dumpi_function func, int64_t bytes_sent,
+                              int to_global_rank)
+  {
+    if(int(sent_.size()) < world_size_) sent_.resize(world_size_);
+    if(collect_[func] && to_global_rank >= 0 && to_global_rank < world_size_)
+      sent_.at(to_global_rank) += bytes_sent;
+  }
 
   perfcounter::perfcounter(const std::string &pattern) :
     handlerbase(pattern)
@@ -616,4 +669,83 @@ namespace dumpi {
     }
   }
 
+  // Histograms.
+  histogram::histogram(const std::string &pattern) :
+    handlerbase(pattern), time_(DUMPI_AGGREGATE_BINS),
+    size_(DUMPI_AGGREGATE_BINS), pat_(pattern)
+  {
+    const char *what[2] = { "taking", "moving" };
+    const char *unit[2] = { "ns", "bytes" };
+    int64_t one(1);
+    std::stringstream ss;
+    for(int kind = 0; kind < 2; ++kind) {
+      for(int i = 0; i < DUMPI_AGGREGATE_BINS; ++i) {
+        ss << "calls " << what[kind] << " ";
+        if(i == 0)
+          ss << "0";
+        else if(i == DUMPI_AGGREGATE_BINS-1)
+          ss << (one << (i-1)) << " or more";
+        else
+          ss << (one << (i-1)) << " up to " << (one << i);
+        ss << " " << unit[kind] << " for " << pat_;
+        desc_.push_back(ss.str());
+        ss.str("");
+      }
+    }
+  }
+  histogram::~histogram() {
+  }
+  void histogram::reset() {
+    time_.assign(DUMPI_AGGREGATE_BINS, 0);
+    size_.assign(DUMPI_AGGREGATE_BINS, 0);
+  }
+  const std::vector<std::string>& histogram::description() const {
+    return desc_;
+  }
+  const std::vector<std::string>& histogram::values() const {
+    values_.clear();
+    std::stringstream ss;
+    for(int i = 0; i < DUMPI_AGGREGATE_BINS; ++i) {
+      ss << time_.at(i); values_.push_back(ss.str()); ss.str("");
+    }
+    for(int i = 0; i < DUMPI_AGGREGATE_BINS; ++i) {
+      ss << size_.at(i); values_.push_back(ss.str()); ss.str("");
+    }
+    return values_;
+  }
+  handlerbase* histogram::clone() const {
+    return new histogram(*this);
+  }
+  void histogram::mark_active(const dumpi_time*, const dumpi_time*,
+                              const dumpi_perfinfo*)
+  {}
+  void histogram::mark_inactive(const dumpi_time*, const dumpi_time*,
+                                const dumpi_perfinfo*)
+  {}
+  void histogram::handle(dumpi_function func, uint16_t,
+                         const dumpi_time*, const dumpi_time *wall,
+                         const dumpi_perfinfo*,
+                         int64_t bytes_sent, int,
+                         int64_t bytes_recvd, int, const void*)
+  {
+    if(collect_[func]) {
+      int64_t nsec = flatten(wall->stop) - flatten(wall->start);
+      time_.at(dumpi_aggregate_bin(nsec > 0 ? nsec : 0))++;
+      // A trace cannot tell an empty message from a call without data.
+      if(bytes_sent + bytes_recvd > 0)
+        size_.at(dumpi_aggregate_bin(bytes_sent + bytes_recvd))++;
+    }
+  }
+  bool histogram::handle_aggregate(const dumpi_aggregate &agg) {
+    for(int i = 0; i < DUMPI_ALL_FUNCTIONS; ++i) {
+      if(collect_[i]) {
+        for(int bin = 0; bin < DUMPI_AGGREGATE_BINS; ++bin) {
+          time_.at(bin) += agg.func[i].time_hist[bin];
+          size_.at(bin) += agg.func[i].size_hist[bin];
+        }
+      }
+    }
+    return true;
+  }
+
 } // end of namespace dumpi
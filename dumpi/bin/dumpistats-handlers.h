@@ -14,6 +14,7 @@
 
 #include <dumpi/common/funclabels.h>
 #include <dumpi/common/types.h>
+#include <dumpi/common/aggregate.h>
 #include <iostream>
 #include <vector>
 #include <map>
@@ -36,6 +37,8 @@ namespace dumpi {
 
     /// Define world size.
     void set_world_size(int wsize) { world_size_ = wsize; }
+    /// Test whether calls to the given function match the pattern.
+    bool collects(dumpi_function func) const { return collect_[func]; }
 
     /// Reset all counters.
     virtual void reset() = 0;
@@ -64,6 +67,15 @@ namespace dumpi {
                         int64_t bytes_sent, int to_global_rank,
                         int64_t bytes_recvd, int from_global_rank,
                         const void *dumpi_arg) = 0;
+
+    /// Statistics of a whole run (mode=profile) instead of individual calls.
+    /// Returns false if this handler needs individual calls.
+    virtual bool handle_aggregate(const dumpi_aggregate &agg);
+
+    /// Bytes sent to one peer by a call already passed to handle()
+    /// (neighborhood collectives).  Ignored by default.
+    virtual void handle_peer(dumpi_function func, int64_t bytes_sent,
+                             int to_global_rank);
   };
 
   class counter : public handlerbase {
@@ -85,6 +97,7 @@ namespace dumpi {
                         int64_t bytes_sent, int to_global_rank,
                         int64_t bytes_recvd, int from_global_rank,
                         const void *dumpi_arg);
+    virtual bool handle_aggregate(const dumpi_aggregate &agg);
   };
 
   class timer : public handlerbase {
@@ -108,6 +121,7 @@ namespace dumpi {
                         int64_t bytes_sent, int to_global_rank,
                         int64_t bytes_recvd, int from_global_rank,
                         const void *dumpi_arg);
+    virtual bool handle_aggregate(const dumpi_aggregate &agg);
   };
 
   class sender : public handlerbase {
@@ -129,6 +143,7 @@ namespace dumpi {
                         int64_t bytes_sent, int to_global_rank,
                         int64_t bytes_recvd, int from_global_rank,
                         const void *dumpi_arg);
+    virtual bool handle_aggregate(const dumpi_aggregate &agg);
   };
 
   class recver : public handlerbase {
@@ -150,6 +165,7 @@ namespace dumpi {
                         int64_t bytes_sent, int to_global_rank,
                         int64_t bytes_recvd, int from_global_rank,
                         const void *dumpi_arg);
+    virtual bool handle_aggregate(const dumpi_aggregate &agg);
   };
 
   class exchanger : public handlerbase {
@@ -173,6 +189,8 @@ namespace dumpi {
                         int64_t bytes_sent, int to_global_rank,
                         int64_t bytes_recvd, int from_global_rank,
                         const void *dumpi_arg);
+    virtual void handle_peer(dumpi_function func, int64_t bytes_sent,
+                             int to_global_rank);
   };
 
   class perfcounter : public handlerbase {
@@ -221,6 +239,30 @@ namespace dumpi {
                         const void *dumpi_arg);
   };
 
+  /// Log2 histograms of call durations and bytes moved per call.
+  class histogram : public handlerbase {
+    std::vector<int64_t> time_, size_;
+    std::string pat_;
+  public:
+    histogram(const std::string &pattern);
+    virtual ~histogram();
+    virtual void reset();
+    virtual const std::vector<std::string>& description() const;
+    virtual const std::vector<std::string>& values() const;
+    virtual handlerbase* clone() const;
+    virtual void mark_active(const dumpi_time *cpu, const dumpi_time *wall,
+                             const dumpi_perfinfo *perf);
+    virtual void mark_inactive(const dumpi_time *cpu, const dumpi_time *wall,
+                               const dumpi_perfinfo *perf);
+    virtual void handle(dumpi_function func, uint16_t thread,
+                        const dumpi_time *cpu, const dumpi_time *wall,
+                        const dumpi_perfinfo *perf,
+                        int64_t bytes_sent, int to_global_rank,
+                        int64_t bytes_recvd, int from_global_rank,
+                        const void *dumpi_arg);
+    virtual bool handle_aggregate(const dumpi_aggregate &agg);
+  };
+
 } // end of namespace dumpi
 
 #endif // ! DUMPI_BIN_DUMPISTATS_HANDLERS_H
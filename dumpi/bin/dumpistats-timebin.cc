@@ -341,6 +341,19 @@ namespace dumpi {
     }
   }
 
+  //
+  // Bytes sent to one peer by the call last passed to handle().
+  //
+  void timebin::handle_peer(dumpi_function func, const dumpi_time *wall,
+                            int64_t bytes_sent, int to_global_rank)
+  {
+    int64_t flattime = wall->start.sec * int64_t(1e9) + wall->start.nsec;
+    if((flattime >= begin_) && (flattime < end_)) {
+      for(size_t i = 0; i < handlers_.size(); ++i)
+        handlers_[i]->handle_peer(func, bytes_sent, to_global_rank);
+    }
+  }
+
   //
   // Figure out timestamp.
   //
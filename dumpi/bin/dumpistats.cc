@@ -14,8 +14,14 @@
 #include <dumpi/bin/dumpistats-timebin.h>
 #include <dumpi/bin/dumpistats-gatherbin.h>
 #include <dumpi/bin/dumpistats-handlers.h>
+#include <dumpi/bin/dumpistats-callsites.h>
 #include <dumpi/bin/dumpistats-callbacks.h>
+#include <dumpi/bin/timeutils.h>
+#include <dumpi/common/aggregate.h>
+#include <dumpi/libundumpi/libundumpi.h>
 #include <sstream>
+#include <fstream>
+#include <iomanip>
 #include <getopt.h>
 #include <stdio.h>
 #include <string.h>
@@ -35,7 +41,10 @@ static const struct option longopts[] = {
   {"recvd", required_argument, NULL, 'r'},
   {"exchange", required_argument, NULL, 'x'},
   {"lump", required_argument, NULL, 'l'},
+  {"hist", required_argument, NULL, 'H'},
   {"perfctr", required_argument, NULL, 'p'},
+  {"callsites", required_argument, NULL, 'S'},
+  {"sync-clocks", no_argument, NULL, 'C'},
   {"in", required_argument, NULL, 'i'},
   {"out", required_argument, NULL, 'o'},
   {NULL, 0, NULL, 0}
@@ -55,7 +64,10 @@ void print_help(const std::string &name) {
             << "   (-r|--recvd)    funcname   Count bytes recvd by function\n"
             << "   (-x|--exchange) funcname   Full send/recv exchange info\n"
             << "   (-l|--lump)     funcname   Lump (bin) messages by size\n"
+            << "   (-H|--hist)     funcname   Log2 histograms of time and size\n"
             << "   (-p|--perfctr)  funcname   PAPI perfcounter info\n"
+            << "   (-S|--callsites) funcname  Time by call site (all bins)\n"
+            << "   (-C|--sync-clocks)         Put wall times on rank 0's clock\n"
             << "   (-i|--in)       metafile   DUMPI metafile (required)\n"
             << "   (-o|--out)      fileroot   Output file root (required)\n"
             << "\n"
@@ -103,7 +115,78 @@ void print_help(const std::string &name) {
             << "         -i dumpi.meta -o stats \\\n"
             << "      Writes a new file containing bytes sent and received\n"
             << "      starting 10 seconds after first and ending 10 seconds\n"
-            << "      before last simulation timestamp\n";
+            << "      before last simulation timestamp\n"
+            << "\n"
+            << "Statistics written by libdumpi with mode=profile are read\n"
+            << "directly (the metafile says which kind of run it was).  They\n"
+            << "cover the whole run, so bins are ignored, and only --count,\n"
+            << "--time, --sent, --recvd, and --hist are available.  The\n"
+            << "result goes to a file called fileroot-profile.tbl.\n"
+            << "\n"
+            << "Traces written with 'callsites N' in dumpi.conf tag each\n"
+            << "call with its call path.  --callsites writes the time in\n"
+            << "matching calls by call path and function, summed over the\n"
+            << "run and all ranks, to a file called fileroot-callsites.tbl.\n"
+            << "\n"
+            << "Traces written with 'clock-sync enable' in dumpi.conf carry\n"
+            << "the offset and drift of each rank's clock from rank 0's.\n"
+            << "--sync-clocks corrects wall times with them as the traces\n"
+            << "are read, so time bins line up across nodes.\n";
+}
+
+/// Write one row per rank from the statistics of a mode=profile run.
+static void aggregate_stats(const metadata &meta,
+                            const std::vector<handlerbase*> &handlers,
+                            const std::string &outroot)
+{
+  std::string fname = outroot + "-profile.tbl";
+  std::ofstream out(fname.c_str());
+  if(! out) {
+    std::cerr << "Failed to open outfile " << fname << "\n";
+    throw "Failed to open outfile.";
+  }
+  out << "########################################################\n"
+      << "# Statistics written by libdumpi (mode=profile)\n"
+      << "#\n"
+      << "# Column 1 is rank\n"
+      << "# Column 2 is the number of threads that called MPI\n"
+      << "# Column 3 is wall time between libdumpi start and finalize\n"
+      << "# Column 4 is cpu time between libdumpi start and finalize\n";
+  int column = 5;
+  for(size_t i = 0; i < handlers.size(); ++i) {
+    const std::vector<std::string> &desc = handlers[i]->description();
+    for(size_t j = 0; j < desc.size(); ++j, ++column)
+      out << "# Column " << column << " is " << desc.at(j) << "\n";
+  }
+  out << "#\n# ";
+  for(int lbl = 1; lbl < column; ++lbl)
+    out << std::setw(20) << std::setfill(' ') << lbl << " ";
+  out << "\n";
+  std::vector<bool> supported(handlers.size(), true);
+  dumpi_aggregate *agg = new dumpi_aggregate;
+  for(int rank = 0; rank < meta.traces(); ++rank) {
+    if(! dumpi_read_aggregate(meta.tracename(rank).c_str(), agg)) {
+      delete agg;
+      throw "Failed to read statistics file.";
+    }
+    out << std::setw(22) << rank << " "
+        << std::setw(22) << agg->threads << " "
+        << std::setw(20) << agg->elapsed_wall << " "
+        << std::setw(20) << agg->elapsed_cpu << " ";
+    for(size_t i = 0; i < handlers.size(); ++i) {
+      handlers[i]->reset();
+      if(! handlers[i]->handle_aggregate(*agg) && supported[i]) {
+        std::cerr << "Warning:  \"" << handlers[i]->description().at(0)
+                  << "\" needs a trace and is left empty\n";
+        supported[i] = false;
+      }
+      const std::vector<std::string> &values = handlers[i]->values();
+      for(size_t j = 0; j < values.size(); ++j)
+        out << std::setw(20) << std::setfill(' ') << values.at(j) << " ";
+    }
+    out << std::endl;
+  }
+  delete agg;
 }
 
 struct options {
@@ -111,7 +194,8 @@ struct options {
   std::string infile, outroot;
   std::vector<binbase*> bin;
   std::vector<handlerbase*> handlers;
-  options() : verbose(false) {}
+  callsitetable *sites;
+  options() : verbose(false), sites(NULL) {}
 };
 
 int main(int argc, char **argv) {
@@ -171,9 +255,19 @@ int main(int argc, char **argv) {
     case 'l':
       opt.handlers.push_back(new lumper(optarg));
       break;
+    case 'H':
+      opt.handlers.push_back(new histogram(optarg));
+      break;
     case 'p':
       opt.handlers.push_back(new perfcounter(optarg));
       break;
+    case 'S':
+      delete opt.sites;
+      opt.sites = new callsitetable(optarg);
+      break;
+    case 'C':
+      undumpi_set_clock_sync(1);
+      break;
     case 'i':
       opt.infile = optarg;
       break;
@@ -198,8 +292,6 @@ int main(int argc, char **argv) {
 
   try {
     // Provide some sensible defaults (time in MPI and non-MPI functions).
-    if(opt.bin.empty())
-      opt.bin.push_back(new timebin("all"));
     if(opt.handlers.empty()) {
       opt.handlers.push_back(new timer("mpi"));
     }
@@ -208,6 +300,25 @@ int main(int argc, char **argv) {
     if(opt.verbose) std::cerr << "Parsing metafile\n";
     metadata meta(opt.infile);
 
+    // Statistics need no replay.
+    if(meta.profile()) {
+      if(! opt.bin.empty())
+        std::cerr << "Warning:  Bins are ignored for mode=profile statistics\n";
+      if(opt.sites)
+        std::cerr << "Warning:  mode=profile statistics have no call sites\n";
+      for(size_t i = 0; i < opt.handlers.size(); ++i)
+        opt.handlers.at(i)->set_world_size(meta.traces());
+      if(opt.verbose) std::cerr << "Reading statistics files\n";
+      aggregate_stats(meta, opt.handlers, opt.outroot);
+      return 0;
+    }
+    if(opt.bin.empty())
+      opt.bin.push_back(new timebin("all"));
+    if(meta.traced_count() < meta.traces())
+      std::cerr << "Note:  Only " << meta.traced_count() << " of "
+                << meta.traces() << " ranks have full traces (trace-ranks); "
+                << "the others are left out of the tables\n";
+
     // Open traces.
     if(opt.verbose) std::cout << "Pre-parsing traces.\n";
     sharedstate shared(meta.traces());
@@ -228,7 +339,11 @@ int main(int argc, char **argv) {
     callbacks cb;
 
     if(opt.verbose) std::cerr << "Re-parsing files and building tables\n";
-    cb.go(meta, traces, opt.bin);
+    cb.go(meta, traces, opt.bin, opt.sites);
+    if(opt.sites) {
+      opt.sites->write(opt.outroot + "-callsites.tbl");
+      delete opt.sites;
+    }
     // Clean up.
     for(size_t i = 0; i < opt.bin.size(); ++i)
       delete opt.bin.at(i);
@@ -14,12 +14,16 @@
 #include <iomanip>
 #include <fstream>
 #include <sstream>
+#include <utility>
+#include <stdlib.h>
 
 namespace dumpi {
 
   //
   // Construct a new
-  metadata::metadata(const std::string &metafile) {
+  metadata::metadata(const std::string &metafile) :
+    profile_(false), has_traced_(false)
+  {
     std::ifstream in(metafile.c_str());
     if(! in) {
       FILE *fin = fopen(metafile.c_str(), "r");
@@ -38,6 +42,8 @@ namespace dumpi {
     if(slash != std::string::npos) {
       pathprefix = metafile.substr(0, slash+1);
     }
+    int nodefiles = 0;
+    std::vector<std::pair<int, std::string> > nodes;
     // N
     while(in.good()) {
       std::string line;
@@ -51,6 +57,19 @@ namespace dumpi {
         }
 	if(std::string("fileprefix") == key)
 	  fileprefix_ = pathprefix + val;
+	if(std::string("mode") == key)
+	  profile_ = (val == "profile");
+	if(std::string("traced") == key) {
+	  has_traced_ = true;
+	  traced_ = val;
+	}
+	if(std::string("nodefiles") == key) {
+          std::istringstream ss(val);
+          ss >> nodefiles;
+	}
+	else if(key.compare(0, 4, "node") == 0 && key.size() > 4 &&
+		key.find_first_not_of("0123456789", 4) == std::string::npos)
+	  nodes.push_back(std::make_pair(atoi(key.c_str()+4), val));
       }
     }
     //std::cerr << "numprocs: " << numprocs_ << "\n"
@@ -58,9 +77,35 @@ namespace dumpi {
     if(numprocs_ <= 0 || fileprefix_ == "") {
       throw "metadata:  Invalid metafile.";
     }
+    if(has_traced_)
+      parse_traced();
+    if(nodefiles > 0) {
+      // One file per node; the nodeK= lines say which ranks are where.
+      node_.assign(numprocs_, -1);
+      for(size_t i = 0; i < nodes.size(); ++i) {
+	if(nodes[i].first < 0 || nodes[i].first >= nodefiles)
+	  throw "metadata:  Invalid node number.";
+	parse_node(nodes[i].first, nodes[i].second);
+      }
+      for(int rank = 0; rank < numprocs_; ++rank)
+	if(node_.at(rank) < 0)
+	  throw "metadata:  A rank is missing from the node files.";
+      tracefmt_ = fileprefix_ + "-node%04d.bin@%d";
+      for(int node = 0; node < nodefiles; ++node) {
+	char buf[1024];
+	snprintf(buf, sizeof(buf), (fileprefix_ + "-node%04d.bin").c_str(),
+		 node);
+	FILE *exists = fopen(buf, "r");
+	if(! exists)
+	  throw "metadata:  Failed to find node files.";
+	fclose(exists);
+      }
+      return;
+    }
     // Now expand the fileprefix to have the "right" number of zeros.
     // Start with a %04f format, and move on from there.
     static const int maxwidth=10;
+    const char *suffix = (profile_ ? ".prof" : ".bin");
     std::stringstream ss;
     int files_found = 0;
     for(int i = 0; i < maxwidth; ++i) {
@@ -70,7 +115,7 @@ namespace dumpi {
 	ss.clear(); // Clear any error flags
 	ss.str(""); // Initalize stream.
 	ss << fileprefix_ << "-" << std::setfill('0') << std::setw(width_)
-	   << file << ".bin";
+	   << file << suffix;
 	FILE *exists = fopen(ss.str().c_str(), "r");
 	if(exists) {
 	  ++files_found;
@@ -81,7 +126,7 @@ namespace dumpi {
 	// Create a printf-style format.
 	ss.clear();
 	ss.str("");
-	ss << fileprefix_ << "-%0" << width_ << "d.bin";
+	ss << fileprefix_ << "-%0" << width_ << "d" << suffix;
 	tracefmt_ = ss.str();
 	break;
       }
@@ -94,4 +139,60 @@ namespace dumpi {
     }
   }
 
+  //
+  // Expand the list of ranks with full traces (traced=0-3,256,512).
+  void metadata::parse_traced() {
+    untraced_.assign(numprocs_, true);
+    std::istringstream ss(traced_);
+    std::string item;
+    while(std::getline(ss, item, ',')) {
+      int first = -1, last = -1;
+      char dash;
+      std::istringstream range(item);
+      if(! (range >> first))
+	throw "metadata:  Invalid traced= list.";
+      last = first;
+      if(range >> dash) {
+	if(dash != '-' || ! (range >> last))
+	  throw "metadata:  Invalid traced= list.";
+      }
+      if(first < 0 || last >= numprocs_ || first > last)
+	throw "metadata:  Invalid traced= list.";
+      for(int rank = first; rank <= last; ++rank)
+	untraced_.at(rank) = false;
+    }
+  }
+
+  //
+  // Assign ranks to a node file (node3=96-127).
+  void metadata::parse_node(int node, const std::string &ranks) {
+    std::istringstream ss(ranks);
+    std::string item;
+    while(std::getline(ss, item, ',')) {
+      int first = -1, last = -1;
+      char dash;
+      std::istringstream range(item);
+      if(! (range >> first))
+	throw "metadata:  Invalid node list.";
+      last = first;
+      if(range >> dash) {
+	if(dash != '-' || ! (range >> last))
+	  throw "metadata:  Invalid node list.";
+      }
+      if(first < 0 || last >= numprocs_ || first > last)
+	throw "metadata:  Invalid node list.";
+      for(int rank = first; rank <= last; ++rank)
+	node_.at(rank) = node;
+    }
+  }
+
+  //
+  // The number of ranks with full traces.
+  int metadata::traced_count() const {
+    int count = 0;
+    for(int rank = 0; rank < numprocs_; ++rank)
+      if(traced(rank)) ++count;
+    return count;
+  }
+
 } // end of namespace dumpi
@@ -13,6 +13,7 @@
 #define DUMPI_BIN_METADATA_H
 
 #include <string>
+#include <vector>
 #include <iostream>
 #include <string.h>
 #include <stdio.h>
@@ -36,6 +37,16 @@ namespace dumpi {
     std::string tracefmt_;
     /// The number of digit in the filename.
     int width_;
+    /// True if the run wrote statistics instead of traces (mode=profile).
+    bool profile_;
+    bool has_traced_;
+    std::string traced_;
+    std::vector<bool> untraced_;
+    /// The node file of each rank (node-files runs), from the nodeK= lines.
+    std::vector<int> node_;
+
+    void parse_traced();
+    void parse_node(int node, const std::string &ranks);
 
   public:
     /// Create new metadata based on the given metafile.
@@ -46,12 +57,34 @@ namespace dumpi {
       return numprocs_;
     }
 
+    /// True if tracename refers to statistics files (mode=profile)
+    /// rather than trace files.
+    bool profile() const {
+      return profile_;
+    }
+
+    /// False for ranks left out of a trace-ranks selection:  their traces
+    /// only hold the calls that set up communicators and datatypes.
+    bool traced(int index) const {
+      return (untraced_.empty() || ! untraced_.at(index));
+    }
+
+    /// The number of ranks with full traces.
+    int traced_count() const;
+
     /// Get the full filename corresponding to the given trace index.
+    /// In node-files runs this names the stream of the rank in its
+    /// node file (fileroot-nodeNNNN.bin@rank).
     std::string tracename(int index) const {
       static char buf[1024];
       if(index >= numprocs_)
 	throw "metadata::tracename:  Invalid rank";
-      if(snprintf(buf, 1024, tracefmt_.c_str(), index) > 1023)
+      if(! node_.empty()) {
+	if(snprintf(buf, 1024, tracefmt_.c_str(), node_.at(index), index)
+	   > 1023)
+	  throw "metadata::tracename:  Buffer overflow.";
+      }
+      else if(snprintf(buf, 1024, tracefmt_.c_str(), index) > 1023)
 	throw "metadata::tracename:  Buffer overflow.";
       return std::string(buf);
     }
@@ -26,6 +26,24 @@ namespace dumpi {
   static const uint32_t clockctrs = 6000;
   static const uint32_t cputimer  = 6001;
 
+  //
+  // Sum of a per-peer count array, leaving out the given rank.
+  // Summarized records only keep the total, which includes that rank.
+  //
+  static uint32_t peer_total(const int *counts,
+                             const dumpi_int_summary &summary,
+                             int commsize, int skip)
+  {
+    if(counts == NULL)
+      return (uint32_t)summary.total;
+    uint32_t total = 0;
+    for(int i = 0; i < commsize; ++i) {
+      if(i != skip)
+        total += counts[i];
+    }
+    return total;
+  }
+
   //
   // Hello.
   //
@@ -568,11 +586,8 @@ namespace dumpi {
     uint32_t procgroup = 0;
     uint32_t sent = 0, recvd = 0;
     if(prm->commrank == prm->root) {
-      recvd = 0;
-      for(int i = 0; i < prm->commsize; ++i) {
-	if(i != prm->root)
-	  recvd += prm->recvcounts[i];
-      }
+      recvd = peer_total(prm->recvcounts, prm->recvcounts_summary,
+			 prm->commsize, prm->root);
       recvd *= rtype.get_size();
     }
     else {
@@ -656,11 +671,8 @@ namespace dumpi {
     uint32_t procgroup = 0;
     uint32_t sent = 0, recvd = 0;
     if(prm->commrank == prm->root) {
-      sent = 0;
-      for(int i = 0; i < prm->commsize; ++i) {
-	if(i != prm->root)
-	  sent += prm->sendcounts[i];
-      }
+      sent = peer_total(prm->sendcounts, prm->sendcounts_summary,
+			prm->commsize, prm->root);
       sent *= stype.get_size();
     }
     else {
@@ -730,11 +742,8 @@ namespace dumpi {
     uint64_t duration = stop - start;
     uint32_t procgroup = 0;
     uint32_t sent = stype.get_size() * prm->sendcount * (prm->commsize - 1);
-    uint32_t recvd = 0;
-    for(int i = 0; i < prm->commsize; ++i) {
-      if(i != self->current_rank_)
-	recvd += prm->recvcounts[i];
-    }
+    uint32_t recvd = peer_total(prm->recvcounts, prm->recvcounts_summary,
+				prm->commsize, self->current_rank_);
     recvd *= rtype.get_size();
     uint32_t root = 0;
     uint32_t source = 0;
@@ -801,13 +810,10 @@ namespace dumpi {
     uint64_t stop = to_nsec(wall->stop);
     uint64_t duration = stop - start;
     uint32_t procgroup = 0;
-    uint32_t sent = 0, recvd = 0;
-    for(int i = 0; i < prm->commsize; ++i) {
-      if(i != self->current_rank_) {
-	sent  += prm->sendcounts[i];
-	recvd += prm->recvcounts[i];
-      }
-    }
+    uint32_t sent = peer_total(prm->sendcounts, prm->sendcounts_summary,
+			       prm->commsize, self->current_rank_);
+    uint32_t recvd = peer_total(prm->recvcounts, prm->recvcounts_summary,
+				prm->commsize, self->current_rank_);
     sent  *= stype.get_size();
     recvd *= rtype.get_size();
     uint32_t root = 0;
@@ -839,7 +845,16 @@ namespace dumpi {
     uint64_t duration = stop - start;
     uint32_t procgroup = 0;
     uint32_t sent = 0, recvd = 0;
-    for(int i = 0; i < prm->commsize; ++i) {
+    if(prm->detail == DUMPI_DETAIL_SUMMARIZED && prm->commsize > 0) {
+      // Each side of a summarized record uses a single datatype.
+      const type &stype
+	= self->info_->at(r).get_type(prm->sendtypes[0], wall->start);
+      const type &rtype
+	= self->info_->at(r).get_type(prm->recvtypes[0], wall->start);
+      sent  = prm->sendcounts_summary.total * stype.get_size();
+      recvd = prm->recvcounts_summary.total * rtype.get_size();
+    }
+    else for(int i = 0; i < prm->commsize; ++i) {
       if(i != self->current_rank_) {
 	const type &stype
 	  = self->info_->at(r).get_type(prm->sendtypes[i], wall->start);
@@ -915,9 +930,9 @@ namespace dumpi {
     uint64_t stop = to_nsec(wall->stop);
     uint64_t duration = stop - start;
     uint32_t procgroup = 0;
-    uint32_t message_estimate = 0;
-    for(int i = 0; i < prm->commsize; ++i)
-      message_estimate += prm->recvcounts[i];
+    uint32_t message_estimate = peer_total(prm->recvcounts,
+					   prm->recvcounts_summary,
+					   prm->commsize, -1);
     message_estimate *=  (the_type.get_size() *
 			  log2(the_comm.get_group().get_size()));
     uint32_t sent = message_estimate, recvd = message_estimate;
@@ -1188,6 +1203,52 @@ namespace dumpi {
     callbacks_.on_iotestsome =
       handle_generic<dumpio_testsome, DUMPIO_Testsome>;
     //
+    // Nonblocking collectives complete in a later wait or test, so they
+    // are recorded as plain function calls rather than collective operations.
+    callbacks_.on_ibarrier = handle_generic<dumpi_ibarrier, DUMPI_Ibarrier>;
+    callbacks_.on_ibcast = handle_generic<dumpi_ibcast, DUMPI_Ibcast>;
+    callbacks_.on_igather = handle_generic<dumpi_igather, DUMPI_Igather>;
+    callbacks_.on_igatherv = handle_generic<dumpi_igatherv, DUMPI_Igatherv>;
+    callbacks_.on_iscatter = handle_generic<dumpi_iscatter, DUMPI_Iscatter>;
+    callbacks_.on_iscatterv = handle_generic<dumpi_iscatterv, DUMPI_Iscatterv>;
+    callbacks_.on_iallgather =
+      handle_generic<dumpi_iallgather, DUMPI_Iallgather>;
+    callbacks_.on_iallgatherv =
+      handle_generic<dumpi_iallgatherv, DUMPI_Iallgatherv>;
+    callbacks_.on_ialltoall = handle_generic<dumpi_ialltoall, DUMPI_Ialltoall>;
+    callbacks_.on_ialltoallv =
+      handle_generic<dumpi_ialltoallv, DUMPI_Ialltoallv>;
+    callbacks_.on_ialltoallw =
+      handle_generic<dumpi_ialltoallw, DUMPI_Ialltoallw>;
+    callbacks_.on_ireduce = handle_generic<dumpi_ireduce, DUMPI_Ireduce>;
+    callbacks_.on_iallreduce =
+      handle_generic<dumpi_iallreduce, DUMPI_Iallreduce>;
+    callbacks_.on_ireduce_scatter =
+      handle_generic<dumpi_ireduce_scatter, DUMPI_Ireduce_scatter>;
+    callbacks_.on_iscan = handle_generic<dumpi_iscan, DUMPI_Iscan>;
+    callbacks_.on_iexscan = handle_generic<dumpi_iexscan, DUMPI_Iexscan>;
+    //
+    // Neighborhood collectives and matched probes are likewise recorded as
+    // plain function calls (the peers of a matched receive are only known
+    // from its status).
+    callbacks_.on_dist_graph_create_adjacent =
+      handle_generic<dumpi_dist_graph_create_adjacent,
+                     DUMPI_Dist_graph_create_adjacent>;
+    callbacks_.on_neighbor_allgather =
+      handle_generic<dumpi_neighbor_allgather, DUMPI_Neighbor_allgather>;
+    callbacks_.on_neighbor_allgatherv =
+      handle_generic<dumpi_neighbor_allgatherv, DUMPI_Neighbor_allgatherv>;
+    callbacks_.on_neighbor_alltoall =
+      handle_generic<dumpi_neighbor_alltoall, DUMPI_Neighbor_alltoall>;
+    callbacks_.on_neighbor_alltoallv =
+      handle_generic<dumpi_neighbor_alltoallv, DUMPI_Neighbor_alltoallv>;
+    callbacks_.on_neighbor_alltoallw =
+      handle_generic<dumpi_neighbor_alltoallw, DUMPI_Neighbor_alltoallw>;
+    callbacks_.on_mprobe = handle_generic<dumpi_mprobe, DUMPI_Mprobe>;
+    callbacks_.on_improbe = handle_generic<dumpi_improbe, DUMPI_Improbe>;
+    callbacks_.on_mrecv = handle_generic<dumpi_mrecv, DUMPI_Mrecv>;
+    callbacks_.on_imrecv = handle_generic<dumpi_imrecv, DUMPI_Imrecv>;
+    //
     // All other functions can probably do just fine with generic handlers:
     callbacks_.on_get_count = handle_generic<dumpi_get_count, DUMPI_Get_count>;
     callbacks_.on_buffer_attach =
@@ -1644,6 +1705,19 @@ namespace dumpi {
     DUMPI_DFUNC(MPIO_Testall);                  DUMPI_DFUNC(MPIO_Waitall);                  
     DUMPI_DFUNC(MPIO_Testany);                  DUMPI_DFUNC(MPIO_Waitany);                  
     DUMPI_DFUNC(MPIO_Waitsome);                 DUMPI_DFUNC(MPIO_Testsome);
+    DUMPI_DFUNC(MPI_Ibarrier);                  DUMPI_DFUNC(MPI_Ibcast);
+    DUMPI_DFUNC(MPI_Igather);                   DUMPI_DFUNC(MPI_Igatherv);
+    DUMPI_DFUNC(MPI_Iscatter);                  DUMPI_DFUNC(MPI_Iscatterv);
+    DUMPI_DFUNC(MPI_Iallgather);                DUMPI_DFUNC(MPI_Iallgatherv);
+    DUMPI_DFUNC(MPI_Ialltoall);                 DUMPI_DFUNC(MPI_Ialltoallv);
+    DUMPI_DFUNC(MPI_Ialltoallw);                DUMPI_DFUNC(MPI_Ireduce);
+    DUMPI_DFUNC(MPI_Iallreduce);                DUMPI_DFUNC(MPI_Ireduce_scatter);
+    DUMPI_DFUNC(MPI_Iscan);                     DUMPI_DFUNC(MPI_Iexscan);
+    DUMPI_DFUNC(MPI_Dist_graph_create_adjacent); DUMPI_DFUNC(MPI_Neighbor_allgather);
+    DUMPI_DFUNC(MPI_Neighbor_allgatherv);       DUMPI_DFUNC(MPI_Neighbor_alltoall);
+    DUMPI_DFUNC(MPI_Neighbor_alltoallv);        DUMPI_DFUNC(MPI_Neighbor_alltoallw);
+    DUMPI_DFUNC(MPI_Mprobe);                    DUMPI_DFUNC(MPI_Improbe);
+    DUMPI_DFUNC(MPI_Mrecv);                     DUMPI_DFUNC(MPI_Imrecv);
 #undef DUMPI_DFUNC
 #undef DUMPI_DCOLL
   }
@@ -57,6 +57,7 @@ namespace dumpi {
     shared_(NULL), mpi_finalized_(0)
   {
     pending_communicator_.id = -1;
+    pending_communicator_.topology = false;
     memset(callarr_, 0, DUMPI_END_OF_STREAM * sizeof(libundumpi_cbpair));
     start_time_.sec = start_time_.nsec = std::numeric_limits<int32_t>::max();
     stop_time_.sec = stop_time_.nsec = std::numeric_limits<int32_t>::min();
@@ -174,6 +175,9 @@ namespace dumpi {
 	  //std::cerr << "Comm: " << newcomm.get_unique_index() << ".  Node: "
 	  //	  << index_ << ".  My rank: " 
 	  //	  << newcomm.get_group().get_global_rank() << "\n";
+	  if(pending_communicator_.topology && ! newcomm.is_null_comm())
+	    newcomm.set_neighbors(pending_communicator_.sources,
+				  pending_communicator_.destinations);
 	  commentry entry(newcomm, pending_communicator_.created);
 	  comms_.insert(std::make_pair(pending_communicator_.id, entry));
 	  pending_communicator_.id = -1;
@@ -189,7 +193,7 @@ namespace dumpi {
       return state_;
     }
     // We get here because we have PREPARSE_READY.
-    assert((profile_->file = fopen(filename_.c_str(), "r")) != NULL);
+    assert((profile_->file = dumpi_open_input_stream(filename_.c_str())) != NULL);
     assert(profile_->file != NULL);
     assert(fseeko(profile_->file, this->off_, SEEK_SET) == 0);
     // Resume parsing until we hit end of stream or another comm. operation.
@@ -452,6 +456,8 @@ namespace dumpi {
 
   //
   // Private method to setup callbacks.
+  // Untraced ranks only record the calls handled here, so keep this list
+  // in step with libdumpi_rankselect_skeleton (libdumpi/rankselect.c).
   //
   void trace::setup_callbacks() {
     libundumpi_callbacks cb;
@@ -465,6 +471,9 @@ namespace dumpi {
     cb.on_comm_dup = handle_comm_dup;
     cb.on_comm_create = handle_comm_create;
     cb.on_comm_split = handle_comm_split;
+    cb.on_cart_create = handle_cart_create;
+    cb.on_graph_create = handle_graph_create;
+    cb.on_dist_graph_create_adjacent = handle_dist_graph_create_adjacent;
     cb.on_comm_group = handle_comm_group;
     cb.on_comm_free = handle_comm_free;
     cb.on_group_union = handle_group_union;
@@ -549,6 +558,9 @@ namespace dumpi {
       // thread A creates a communicator which is then used by thread B.
       throw "trace::handle_comm_dup:  already have a pending communicator.";
     }
+    this->pending_communicator_.topology = false;
+    this->pending_communicator_.sources.clear();
+    this->pending_communicator_.destinations.clear();
     return this->get_comm(commhandle);
   }
 
@@ -605,6 +617,102 @@ namespace dumpi {
     return 1;
   }
 
+  //
+  // MPI_Cart_create and MPI_Graph_create.  The first prod(dims) (or nodes)
+  // ranks of the old communicator join the new one, so we treat these as
+  // a split.  Reordering (reorder != 0) is ignored:  the ranks are assumed
+  // to stay the same, which is what most MPI implementations do.
+  //
+  int trace::handle_cart_create(const dumpi_cart_create *prm, uint16_t thread,
+				const dumpi_time *cpu, const dumpi_time *wall,
+				const dumpi_perfinfo *perf, void *userarg)
+  {
+    (void)thread; (void)cpu; (void)perf;
+    trace *self = (trace*)userarg;
+    const comm &oldcomm = self->comm_creation_precheck(prm->oldcomm);
+    int rank = oldcomm.get_group().get_local_rank();
+    int size = 1;
+    for(int dim = 0; dim < prm->ndim; ++dim)
+      size *= prm->dims[dim];
+    if(rank < size) {
+      // Neighbors are the source and destination of MPI_Cart_shift
+      // by one along each dimension in turn (row-major coordinates).
+      std::vector<int> &nbr = self->pending_communicator_.sources;
+      int stride = size;
+      for(int dim = 0; dim < prm->ndim; ++dim) {
+	int extent = prm->dims[dim];
+	stride /= extent;
+	int coord = (rank / stride) % extent;
+	for(int shift = -1; shift <= 1; shift += 2) {
+	  int there = coord + shift;
+	  if(prm->periods[dim])
+	    there = (there + extent) % extent;
+	  if(there < 0 || there >= extent)
+	    nbr.push_back(-1);
+	  else
+	    nbr.push_back(rank + (there - coord) * stride);
+	}
+      }
+      self->pending_communicator_.destinations = nbr;
+      self->pending_communicator_.topology = true;
+    }
+    self->pending_communicator_.id = prm->newcomm;
+    self->pending_communicator_.created = wall->stop;
+    self->pending_communicator_.handle =
+      self->shared_->comm_split(oldcomm, (rank < size ? 0 : -1), rank);
+    self->state_ = PREPARSE_BLOCKED;
+    return 1;
+  }
+
+  int trace::handle_graph_create(const dumpi_graph_create *prm,
+				 uint16_t thread,
+				 const dumpi_time *cpu, const dumpi_time *wall,
+				 const dumpi_perfinfo *perf, void *userarg)
+  {
+    (void)thread; (void)cpu; (void)perf;
+    trace *self = (trace*)userarg;
+    const comm &oldcomm = self->comm_creation_precheck(prm->oldcomm);
+    int rank = oldcomm.get_group().get_local_rank();
+    if(rank < prm->nodes) {
+      // Our edges are edges[index[rank-1]] up to edges[index[rank]].
+      int first = (rank > 0 ? prm->index[rank-1] : 0);
+      std::vector<int> &nbr = self->pending_communicator_.sources;
+      nbr.assign(prm->edges + first, prm->edges + prm->index[rank]);
+      self->pending_communicator_.destinations = nbr;
+      self->pending_communicator_.topology = true;
+    }
+    self->pending_communicator_.id = prm->newcomm;
+    self->pending_communicator_.created = wall->stop;
+    self->pending_communicator_.handle =
+      self->shared_->comm_split(oldcomm, (rank < prm->nodes ? 0 : -1), rank);
+    self->state_ = PREPARSE_BLOCKED;
+    return 1;
+  }
+
+  //
+  // MPI_Dist_graph_create_adjacent.  Every rank joins (as in MPI_Comm_dup)
+  // and lists its own sources and destinations.  Reordering is ignored.
+  //
+  int trace::handle_dist_graph_create_adjacent
+  (const dumpi_dist_graph_create_adjacent *prm, uint16_t thread,
+   const dumpi_time *cpu, const dumpi_time *wall,
+   const dumpi_perfinfo *perf, void *userarg)
+  {
+    (void)thread; (void)cpu; (void)perf;
+    trace *self = (trace*)userarg;
+    const comm &oldcomm = self->comm_creation_precheck(prm->oldcomm);
+    self->pending_communicator_.sources.assign(prm->sources,
+					       prm->sources + prm->indegree);
+    self->pending_communicator_.destinations.assign
+      (prm->destinations, prm->destinations + prm->outdegree);
+    self->pending_communicator_.topology = true;
+    self->pending_communicator_.id = prm->newcomm;
+    self->pending_communicator_.created = wall->stop;
+    self->pending_communicator_.handle = self->shared_->comm_dup(oldcomm);
+    self->state_ = PREPARSE_BLOCKED;
+    return 1;
+  }
+
   int trace::handle_comm_group(const dumpi_comm_group *prm, uint16_t thread,
 			       const dumpi_time *cpu, const dumpi_time *wall,
 			       const dumpi_perfinfo *perf, void *userarg)
@@ -126,6 +126,9 @@ namespace dumpi {
       int id;
       commhandle handle;
       dumpi_clock created;
+      /// Neighbors of a topology communicator (set if topology is true).
+      bool topology;
+      std::vector<int> sources, destinations;
     } pending_communicator_;
 
     /// Key time stamps.
@@ -163,6 +166,18 @@ namespace dumpi {
       (const dumpi_comm_split *prm, uint16_t thread,
        const dumpi_time *cpu, const dumpi_time *wall,
        const dumpi_perfinfo *perf, void *userarg);
+    static int handle_cart_create
+      (const dumpi_cart_create *prm, uint16_t thread,
+       const dumpi_time *cpu, const dumpi_time *wall,
+       const dumpi_perfinfo *perf, void *userarg);
+    static int handle_graph_create
+      (const dumpi_graph_create *prm, uint16_t thread,
+       const dumpi_time *cpu, const dumpi_time *wall,
+       const dumpi_perfinfo *perf, void *userarg);
+    static int handle_dist_graph_create_adjacent
+      (const dumpi_dist_graph_create_adjacent *prm, uint16_t thread,
+       const dumpi_time *cpu, const dumpi_time *wall,
+       const dumpi_perfinfo *perf, void *userarg);
     static int handle_comm_group
       (const dumpi_comm_group *prm, uint16_t thread,
        const dumpi_time *cpu, const dumpi_time *wall,
@@ -0,0 +1,241 @@
+/*
+ *  This file is part of DUMPI:
+ *               The MPI profiling library from the SST suite.
+ *  Copyright (c) 2009-2011 Sandia Corporation.
+ *  This software is distributed under the BSD License.
+ *  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+ *  the U.S. Government retains certain rights in this software.
+ *  For more information, see the LICENSE file in the top
+ *  SST/macroscale directory.
+ */
+
+#include <dumpi/common/aggregate.h>
+#include <dumpi/common/funcs.h>
+#include <dumpi/common/debugflags.h>
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <arpa/inet.h>
+
+/* Statistics files start with this (the trace magic with the low word
+ * spelling "PROF"). */
+#define DUMPI_AGGREGATE_MAGIC ((((uint64_t)(0xffaadd44))<<32) | 0x50524f46)
+
+/*
+ * File layout (all values big-endian):
+ *   magic (64), version (3 x 8), rank, size, threads (32 each),
+ *   elapsed wall and cpu time (sec, nsec each), number of functions (32),
+ *   then per function:
+ *     function (16), calls (64), wall (sec, nsec), cpu (sec, nsec),
+ *     bytes sent (64), bytes recvd (64),
+ *     for each histogram:  bucket count (8), then (bucket (8), value (64))
+ */
+
+static void write32(FILE *fp, uint32_t value) {
+  value = htonl(value);
+  fwrite(&value, sizeof(uint32_t), 1, fp);
+}
+
+static void write64(FILE *fp, uint64_t value) {
+  write32(fp, (uint32_t)(value >> 32));
+  write32(fp, (uint32_t)value);
+}
+
+static void write_clock(FILE *fp, const dumpi_clock *clock) {
+  write32(fp, clock->sec);
+  write32(fp, clock->nsec);
+}
+
+static void write_hist(FILE *fp, const uint64_t *hist) {
+  int bin;
+  uint8_t used = 0, val;
+  for(bin = 0; bin < DUMPI_AGGREGATE_BINS; ++bin)
+    if(hist[bin]) ++used;
+  fwrite(&used, 1, 1, fp);
+  for(bin = 0; bin < DUMPI_AGGREGATE_BINS; ++bin) {
+    if(hist[bin]) {
+      val = (uint8_t)bin;
+      fwrite(&val, 1, 1, fp);
+      write64(fp, hist[bin]);
+    }
+  }
+}
+
+static int read32(FILE *fp, uint32_t *value) {
+  if(fread(value, sizeof(uint32_t), 1, fp) != 1)
+    return 0;
+  *value = ntohl(*value);
+  return 1;
+}
+
+static int read64(FILE *fp, uint64_t *value) {
+  uint32_t high32, low32;
+  if(! (read32(fp, &high32) && read32(fp, &low32)))
+    return 0;
+  *value = ((uint64_t)high32 << 32) | low32;
+  return 1;
+}
+
+static int read_clock(FILE *fp, dumpi_clock *clock) {
+  uint32_t sec, nsec;
+  if(! (read32(fp, &sec) && read32(fp, &nsec)))
+    return 0;
+  clock->sec = (int32_t)sec;
+  clock->nsec = (int32_t)nsec;
+  return 1;
+}
+
+static int read_hist(FILE *fp, uint64_t *hist) {
+  uint8_t used, bin;
+  int i;
+  if(fread(&used, 1, 1, fp) != 1)
+    return 0;
+  for(i = 0; i < used; ++i) {
+    if(fread(&bin, 1, 1, fp) != 1 || bin >= DUMPI_AGGREGATE_BINS)
+      return 0;
+    if(! read64(fp, &hist[bin]))
+      return 0;
+  }
+  return 1;
+}
+
+/* Add one call to the statistics of a function. */
+void dumpi_aggregate_add(dumpi_aggregate_func *func,
+			 const dumpi_clock *wall_start,
+			 const dumpi_clock *wall_stop,
+			 const dumpi_clock *cpu_start,
+			 const dumpi_clock *cpu_stop,
+			 int64_t sent, int64_t recvd)
+{
+  int64_t nsec;
+  ++func->calls;
+  dumpi_clock_accumulate(&func->wall, wall_start, wall_stop);
+  dumpi_clock_accumulate(&func->cpu, cpu_start, cpu_stop);
+  nsec = ((int64_t)(wall_stop->sec - wall_start->sec) * 1000000000 +
+	  (wall_stop->nsec - wall_start->nsec));
+  ++func->time_hist[dumpi_aggregate_bin(nsec > 0 ? nsec : 0)];
+  if(sent >= 0) {
+    func->bytes_sent += sent;
+    func->bytes_recvd += recvd;
+    ++func->size_hist[dumpi_aggregate_bin(sent + recvd)];
+  }
+}
+
+/* Add the statistics of one function to a running total. */
+void dumpi_aggregate_merge(dumpi_aggregate_func *total,
+			   const dumpi_aggregate_func *value)
+{
+  static const dumpi_clock zero = {0, 0};
+  int bin;
+  total->calls += value->calls;
+  dumpi_clock_accumulate(&total->wall, &zero, &value->wall);
+  dumpi_clock_accumulate(&total->cpu, &zero, &value->cpu);
+  total->bytes_sent += value->bytes_sent;
+  total->bytes_recvd += value->bytes_recvd;
+  for(bin = 0; bin < DUMPI_AGGREGATE_BINS; ++bin) {
+    total->time_hist[bin] += value->time_hist[bin];
+    total->size_hist[bin] += value->size_hist[bin];
+  }
+}
+
+/* Write statistics to the named file. */
+int dumpi_write_aggregate(const char *fname, const dumpi_aggregate *agg) {
+  int func;
+  uint32_t used = 0;
+  FILE *fp = fopen(fname, "w");
+  if(fp == NULL) {
+    fprintf(stderr, "dumpi_write_aggregate:  Failed to open \"%s\" for "
+	    "writing:  errno=%d (%s)\n", fname, errno, strerror(errno));
+    return 0;
+  }
+  if(dumpi_debug & DUMPI_DEBUG_TRACEIO)
+    fprintf(stderr, "[DUMPI-IO] dumpi_write_aggregate(\"%s\")\n", fname);
+  write64(fp, DUMPI_AGGREGATE_MAGIC);
+  fwrite(agg->version, 1, 3, fp);
+  write32(fp, agg->rank);
+  write32(fp, agg->size);
+  write32(fp, agg->threads);
+  write_clock(fp, &agg->elapsed_wall);
+  write_clock(fp, &agg->elapsed_cpu);
+  for(func = 0; func < DUMPI_ALL_FUNCTIONS; ++func)
+    if(agg->func[func].calls) ++used;
+  write32(fp, used);
+  for(func = 0; func < DUMPI_ALL_FUNCTIONS; ++func) {
+    const dumpi_aggregate_func *curr = &agg->func[func];
+    uint16_t label;
+    if(curr->calls == 0)
+      continue;
+    label = htons((uint16_t)func);
+    fwrite(&label, sizeof(uint16_t), 1, fp);
+    write64(fp, curr->calls);
+    write_clock(fp, &curr->wall);
+    write_clock(fp, &curr->cpu);
+    write64(fp, curr->bytes_sent);
+    write64(fp, curr->bytes_recvd);
+    write_hist(fp, curr->time_hist);
+    write_hist(fp, curr->size_hist);
+  }
+  if(ferror(fp)) {
+    fprintf(stderr, "dumpi_write_aggregate:  Failed to write \"%s\"\n", fname);
+    fclose(fp);
+    return 0;
+  }
+  return (fclose(fp) == 0);
+}
+
+/* Read statistics from the named file. */
+int dumpi_read_aggregate(const char *fname, dumpi_aggregate *agg) {
+  uint64_t magic;
+  uint32_t i, used, val;
+  uint16_t label;
+  FILE *fp = fopen(fname, "r");
+  if(fp == NULL) {
+    fprintf(stderr, "dumpi_read_aggregate:  Failed to open \"%s\" for "
+	    "reading:  errno=%d (%s)\n", fname, errno, strerror(errno));
+    return 0;
+  }
+  memset(agg, 0, sizeof(dumpi_aggregate));
+  if(! read64(fp, &magic) || magic != DUMPI_AGGREGATE_MAGIC) {
+    fprintf(stderr, "dumpi_read_aggregate:  \"%s\" is not a DUMPI "
+	    "statistics file.\n", fname);
+    fclose(fp);
+    return 0;
+  }
+  if(fread(agg->version, 1, 3, fp) != 3)
+    goto truncated;
+  if(! read32(fp, &val)) goto truncated;
+  agg->rank = (int32_t)val;
+  if(! read32(fp, &val)) goto truncated;
+  agg->size = (int32_t)val;
+  if(! read32(fp, &val)) goto truncated;
+  agg->threads = (int32_t)val;
+  if(! (read_clock(fp, &agg->elapsed_wall) &&
+	read_clock(fp, &agg->elapsed_cpu) && read32(fp, &used)))
+    goto truncated;
+  for(i = 0; i < used; ++i) {
+    dumpi_aggregate_func *curr;
+    if(fread(&label, sizeof(uint16_t), 1, fp) != 1)
+      goto truncated;
+    label = ntohs(label);
+    if(label >= DUMPI_ALL_FUNCTIONS) {
+      fprintf(stderr, "dumpi_read_aggregate:  Invalid function %d in "
+	      "\"%s\"\n", (int)label, fname);
+      fclose(fp);
+      return 0;
+    }
+    curr = &agg->func[label];
+    if(! (read64(fp, &curr->calls) &&
+	  read_clock(fp, &curr->wall) && read_clock(fp, &curr->cpu) &&
+	  read64(fp, &curr->bytes_sent) && read64(fp, &curr->bytes_recvd) &&
+	  read_hist(fp, curr->time_hist) && read_hist(fp, curr->size_hist)))
+      goto truncated;
+  }
+  fclose(fp);
+  return 1;
+
+ truncated:
+  fprintf(stderr, "dumpi_read_aggregate:  \"%s\" is truncated or corrupt.\n",
+	  fname);
+  fclose(fp);
+  return 0;
+}
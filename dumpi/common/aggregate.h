@@ -0,0 +1,121 @@
+/*
+ *  This file is part of DUMPI:
+ *               The MPI profiling library from the SST suite.
+ *  Copyright (c) 2009-2011 Sandia Corporation.
+ *  This software is distributed under the BSD License.
+ *  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+ *  the U.S. Government retains certain rights in this software.
+ *  For more information, see the LICENSE file in the top
+ *  SST/macroscale directory.
+ */
+
+#ifndef DUMPI_COMMON_AGGREGATE_H
+#define DUMPI_COMMON_AGGREGATE_H
+
+#include <dumpi/common/types.h>
+#include <dumpi/common/funclabels.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* ! __cplusplus */
+
+  /**
+   * \ingroup common
+   * \defgroup common_aggregate  common/aggregate:  Aggregate statistics \
+   *     written instead of a trace (mode=profile).
+   */
+  /*@{*/
+
+  /**
+   * The number of buckets in each histogram.  Bucket 0 counts zero values,
+   * bucket b > 0 counts values in [2^(b-1), 2^b); the last bucket also
+   * holds everything larger.
+   */
+#define DUMPI_AGGREGATE_BINS 48
+
+  /**
+   * Statistics for all calls to one MPI function.
+   */
+  typedef struct dumpi_aggregate_func {
+    /** The number of calls */
+    uint64_t    calls;
+    /** Total time spent in the calls */
+    dumpi_clock wall, cpu;
+    /** Bytes handed to and accepted from MPI (from count and datatype
+     *  arguments; the size of a posted receive, not of the message) */
+    uint64_t    bytes_sent, bytes_recvd;
+    /** Call durations (wall clock), by log2 of nanoseconds */
+    uint64_t    time_hist[DUMPI_AGGREGATE_BINS];
+    /** Bytes sent plus received per call, by log2 of bytes.
+     *  Only calls that carry a data buffer are counted. */
+    uint64_t    size_hist[DUMPI_AGGREGATE_BINS];
+  } dumpi_aggregate_func;
+
+  /**
+   * The statistics of one MPI rank.
+   */
+  typedef struct dumpi_aggregate {
+    /** The version of DUMPI that wrote the statistics */
+    char                 version[3];
+    /** The rank in MPI_COMM_WORLD and the size of MPI_COMM_WORLD */
+    int32_t              rank, size;
+    /** The number of threads that made MPI calls */
+    int32_t              threads;
+    /** Time between the start of profiling and finalize */
+    dumpi_clock          elapsed_wall, elapsed_cpu;
+    /** Indexed by dumpi_function */
+    dumpi_aggregate_func func[DUMPI_ALL_FUNCTIONS];
+  } dumpi_aggregate;
+
+  /**
+   * The histogram bucket for the given value.
+   */
+  static inline int dumpi_aggregate_bin(uint64_t value) {
+    int bin = 0;
+    while(value != 0 && bin < DUMPI_AGGREGATE_BINS-1) {
+      value >>= 1;
+      ++bin;
+    }
+    return bin;
+  }
+
+  /**
+   * Add one call to the statistics of a function.
+   * \param sent, recvd  bytes moved by the call;  sent is negative if
+   *                     the call carries no data buffer.
+   */
+  void dumpi_aggregate_add(dumpi_aggregate_func *func,
+			   const dumpi_clock *wall_start,
+			   const dumpi_clock *wall_stop,
+			   const dumpi_clock *cpu_start,
+			   const dumpi_clock *cpu_stop,
+			   int64_t sent, int64_t recvd);
+
+  /**
+   * Add the statistics of one function to a running total.
+   */
+  void dumpi_aggregate_merge(dumpi_aggregate_func *total,
+			     const dumpi_aggregate_func *value);
+
+  /**
+   * Write statistics to the named file.
+   * Only functions that were called are stored, and only the
+   * non-empty histogram buckets.
+   * \return non-zero on success.
+   */
+  int dumpi_write_aggregate(const char *fname, const dumpi_aggregate *agg);
+
+  /**
+   * Read statistics from the named file.
+   * \return non-zero on success.
+   */
+  int dumpi_read_aggregate(const char *fname, dumpi_aggregate *agg);
+
+  /*@}*/
+
+#ifdef __cplusplus
+} /* end of extern "C" */
+#endif /* ! __cplusplus */
+
+#endif /* ! DUMPI_COMMON_AGGREGATE_H */
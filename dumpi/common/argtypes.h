@@ -27,6 +27,40 @@ extern "C" {
    */
   /*@{*/
 
+  /**
+   * How much of the per-peer arrays of a vector collective
+   * (MPI_Gatherv, MPI_Alltoallv, ...) was stored in a record.
+   */
+  typedef enum dumpi_arg_detail {
+    /** Every array is stored as passed to MPI */
+    DUMPI_DETAIL_FULL = 0,
+    /**
+     * Count arrays are reduced to a dumpi_int_summary and the arrays are
+     * NULL; displacement arrays are not stored (NULL).  Datatype arrays
+     * (MPI_Alltoallw) hold the datatype shared by all peers with a non-zero
+     * count; if the peers use different datatypes, the record is stored
+     * with DUMPI_DETAIL_SPARSE instead.
+     */
+    DUMPI_DETAIL_SUMMARIZED,
+    /**
+     * Only the entries of peers with a non-zero count are stored; the other
+     * entries of every array (counts, displacements, datatypes) read as 0.
+     */
+    DUMPI_DETAIL_SPARSE
+  } dumpi_arg_detail;
+
+  /**
+   * Summary of a count array stored with DUMPI_DETAIL_SUMMARIZED.
+   */
+  typedef struct dumpi_int_summary {
+    /** Sum of all entries */
+    int64_t total;
+    /** Smallest and largest entry (0 for an empty array) */
+    int32_t min, max;
+    /** Number of non-zero entries */
+    int32_t nonzero;
+  } dumpi_int_summary;
+
   /**
    * Hold the argument values for a function call
    */
@@ -35,6 +69,31 @@ extern "C" {
     uint64_t fn;
   } dumpi_func_call;
 
+  /**
+   * Hold a run of consecutive unsuccessful polling calls
+   * (MPI_Iprobe, MPI_Test, or MPI_Testany) with identical arguments.
+   * The record timestamps span from the start of the first call in the
+   * run to the end of the last.
+   */
+  typedef struct dumpi_poll_summary {
+    /** The polling function (a dumpi_function label) */
+    int16_t     function;
+    /** Number of calls folded into this record */
+    uint32_t    count;
+    /** Accumulated wall time spent inside the calls */
+    dumpi_clock incall_wall;
+    /** Accumulated cpu time spent inside the calls */
+    dumpi_clock incall_cpu;
+    /** Length of the args array */
+    int         argcount;
+    /**
+     * The arguments shared by every call in the run:
+     * {source, tag, comm} for MPI_Iprobe, {request} for MPI_Test,
+     * and the request array for MPI_Testany.
+     */
+    int         *args;
+  } dumpi_poll_summary;
+
   /**
    * Hold the argument values for a send operation.
    */
@@ -844,6 +903,13 @@ extern "C" {
     int  root;
     /** Argument value before PMPI call */
     dumpi_comm  comm;
+    /** Not an MPI argument.  How the arrays above were stored */
+    dumpi_arg_detail detail;
+    /**
+     * Not an MPI argument.  Summary of recvcounts (if detail is
+     * DUMPI_DETAIL_SUMMARIZED).
+     */
+    dumpi_int_summary recvcounts_summary;
   } dumpi_gatherv;
 
   /**
@@ -894,6 +960,13 @@ extern "C" {
     int  root;
     /** Argument value before PMPI call */
     dumpi_comm  comm;
+    /** Not an MPI argument.  How the arrays above were stored */
+    dumpi_arg_detail detail;
+    /**
+     * Not an MPI argument.  Summary of sendcounts (if detail is
+     * DUMPI_DETAIL_SUMMARIZED).
+     */
+    dumpi_int_summary sendcounts_summary;
   } dumpi_scatterv;
 
   /**
@@ -930,6 +1003,13 @@ extern "C" {
     dumpi_datatype  recvtype;
     /** Argument value before PMPI call */
     dumpi_comm  comm;
+    /** Not an MPI argument.  How the arrays above were stored */
+    dumpi_arg_detail detail;
+    /**
+     * Not an MPI argument.  Summary of recvcounts (if detail is
+     * DUMPI_DETAIL_SUMMARIZED).
+     */
+    dumpi_int_summary recvcounts_summary;
   } dumpi_allgatherv;
 
   /**
@@ -968,6 +1048,18 @@ extern "C" {
     dumpi_datatype  recvtype;
     /** Argument value before PMPI call */
     dumpi_comm  comm;
+    /** Not an MPI argument.  How the arrays above were stored */
+    dumpi_arg_detail detail;
+    /**
+     * Not an MPI argument.  Summary of sendcounts (if detail is
+     * DUMPI_DETAIL_SUMMARIZED).
+     */
+    dumpi_int_summary sendcounts_summary;
+    /**
+     * Not an MPI argument.  Summary of recvcounts (if detail is
+     * DUMPI_DETAIL_SUMMARIZED).
+     */
+    dumpi_int_summary recvcounts_summary;
   } dumpi_alltoallv;
 
   /**
@@ -1032,6 +1124,13 @@ extern "C" {
     dumpi_op  op;
     /** Argument value before PMPI call */
     dumpi_comm  comm;
+    /** Not an MPI argument.  How the arrays above were stored */
+    dumpi_arg_detail detail;
+    /**
+     * Not an MPI argument.  Summary of recvcounts (if detail is
+     * DUMPI_DETAIL_SUMMARIZED).
+     */
+    dumpi_int_summary recvcounts_summary;
   } dumpi_reduce_scatter;
 
   /**
@@ -2157,6 +2256,18 @@ extern "C" {
     dumpi_datatype * recvtypes;
     /** Argument value before PMPI call */
     dumpi_comm  comm;
+    /** Not an MPI argument.  How the arrays above were stored */
+    dumpi_arg_detail detail;
+    /**
+     * Not an MPI argument.  Summary of sendcounts (if detail is
+     * DUMPI_DETAIL_SUMMARIZED).
+     */
+    dumpi_int_summary sendcounts_summary;
+    /**
+     * Not an MPI argument.  Summary of recvcounts (if detail is
+     * DUMPI_DETAIL_SUMMARIZED).
+     */
+    dumpi_int_summary recvcounts_summary;
   } dumpi_alltoallw;
 
   /**
@@ -3760,6 +3871,565 @@ extern "C" {
     dumpi_status * statuses;
   } dumpio_testsome;
 
+  /**
+   * Hold the argument values for a nonblocking barrier operation.
+   */
+  typedef struct dumpi_ibarrier {
+    /** Argument value before PMPI call */
+    dumpi_comm  comm;
+    /** Argument value after PMPI call */
+    dumpi_request  request;
+  } dumpi_ibarrier;
+
+  /**
+   * Hold the argument values for a nonblocking bcast operation.
+   */
+  typedef struct dumpi_ibcast {
+    /** Argument value before PMPI call */
+    int  count;
+    /** Argument value before PMPI call */
+    dumpi_datatype  datatype;
+    /** Argument value before PMPI call */
+    int  root;
+    /** Argument value before PMPI call */
+    dumpi_comm  comm;
+    /** Argument value after PMPI call */
+    dumpi_request  request;
+  } dumpi_ibcast;
+
+  /**
+   * Hold the argument values for a nonblocking gather operation.
+   */
+  typedef struct dumpi_igather {
+    /** Not an MPI argument.  Added to index relevant data in the struct. */
+    int  commrank;
+    /** Argument value before PMPI call */
+    int  sendcount;
+    /** Argument value before PMPI call */
+    dumpi_datatype  sendtype;
+    /** Argument value before PMPI call.  Only stored if(commrank==root) */
+    int  recvcount;
+    /** Argument value before PMPI call.  Only stored if(commrank==root) */
+    dumpi_datatype  recvtype;
+    /** Argument value before PMPI call */
+    int  root;
+    /** Argument value before PMPI call */
+    dumpi_comm  comm;
+    /** Argument value after PMPI call */
+    dumpi_request  request;
+  } dumpi_igather;
+
+  /**
+   * Hold the argument values for a nonblocking gatherv operation.
+   */
+  typedef struct dumpi_igatherv {
+    /** Not an MPI argument.  Added to index relevant data in the struct. */
+    int  commrank;
+    /** Not an MPI argument.  Added to index relevant data in the struct. */
+    int  commsize;
+    /** Argument value before PMPI call */
+    int  sendcount;
+    /** Argument value before PMPI call */
+    dumpi_datatype  sendtype;
+    /**
+     * Argument value before PMPI call.  Array of length [commsize].
+     * Only stored if(commrank==root)
+     */
+    int * recvcounts;
+    /**
+     * Argument value before PMPI call.  Array of length [commsize].
+     * Only stored if(commrank==root)
+     */
+    int * displs;
+    /** Argument value before PMPI call.  Only stored if(commrank==root) */
+    dumpi_datatype  recvtype;
+    /** Argument value before PMPI call */
+    int  root;
+    /** Argument value before PMPI call */
+    dumpi_comm  comm;
+    /** Argument value after PMPI call */
+    dumpi_request  request;
+    /** Not an MPI argument.  How the arrays above were stored */
+    dumpi_arg_detail detail;
+    /**
+     * Not an MPI argument.  Summary of recvcounts (if detail is
+     * DUMPI_DETAIL_SUMMARIZED).
+     */
+    dumpi_int_summary recvcounts_summary;
+  } dumpi_igatherv;
+
+  /**
+   * Hold the argument values for a nonblocking scatter operation.
+   */
+  typedef struct dumpi_iscatter {
+    /** Not an MPI argument.  Added to index relevant data in the struct. */
+    int  commrank;
+    /** Argument value before PMPI call.  Only stored if(commrank==root) */
+    int  sendcount;
+    /** Argument value before PMPI call.  Only stored if(commrank==root) */
+    dumpi_datatype  sendtype;
+    /** Argument value before PMPI call */
+    int  recvcount;
+    /** Argument value before PMPI call */
+    dumpi_datatype  recvtype;
+    /** Argument value before PMPI call */
+    int  root;
+    /** Argument value before PMPI call */
+    dumpi_comm  comm;
+    /** Argument value after PMPI call */
+    dumpi_request  request;
+  } dumpi_iscatter;
+
+  /**
+   * Hold the argument values for a nonblocking scatterv operation.
+   */
+  typedef struct dumpi_iscatterv {
+    /** Not an MPI argument.  Added to index relevant data in the struct. */
+    int  commrank;
+    /** Not an MPI argument.  Added to index relevant data in the struct. */
+    int  commsize;
+    /**
+     * Argument value before PMPI call.  Array of length [commsize].
+     * Only stored if(commrank==root)
+     */
+    int * sendcounts;
+    /**
+     * Argument value before PMPI call.  Array of length [commsize].
+     * Only stored if(commrank==root)
+     */
+    int * displs;
+    /** Argument value before PMPI call */
+    dumpi_datatype  sendtype;
+    /** Argument value before PMPI call */
+    int  recvcount;
+    /** Argument value before PMPI call */
+    dumpi_datatype  recvtype;
+    /** Argument value before PMPI call */
+    int  root;
+    /** Argument value before PMPI call */
+    dumpi_comm  comm;
+    /** Argument value after PMPI call */
+    dumpi_request  request;
+    /** Not an MPI argument.  How the arrays above were stored */
+    dumpi_arg_detail detail;
+    /**
+     * Not an MPI argument.  Summary of sendcounts (if detail is
+     * DUMPI_DETAIL_SUMMARIZED).
+     */
+    dumpi_int_summary sendcounts_summary;
+  } dumpi_iscatterv;
+
+  /**
+   * Hold the argument values for a nonblocking allgather operation.
+   */
+  typedef struct dumpi_iallgather {
+    /** Argument value before PMPI call */
+    int  sendcount;
+    /** Argument value before PMPI call */
+    dumpi_datatype  sendtype;
+    /** Argument value before PMPI call */
+    int  recvcount;
+    /** Argument value before PMPI call */
+    dumpi_datatype  recvtype;
+    /** Argument value before PMPI call */
+    dumpi_comm  comm;
+    /** Argument value after PMPI call */
+    dumpi_request  request;
+  } dumpi_iallgather;
+
+  /**
+   * Hold the argument values for a nonblocking allgatherv operation.
+   */
+  typedef struct dumpi_iallgatherv {
+    /** Not an MPI argument.  Added to index relevant data in the struct. */
+    int  commsize;
+    /** Argument value before PMPI call */
+    int  sendcount;
+    /** Argument value before PMPI call */
+    dumpi_datatype  sendtype;
+    /** Argument value before PMPI call.  Array of length [commsize] */
+    int * recvcounts;
+    /** Argument value before PMPI call.  Array of length [commsize] */
+    int * displs;
+    /** Argument value before PMPI call */
+    dumpi_datatype  recvtype;
+    /** Argument value before PMPI call */
+    dumpi_comm  comm;
+    /** Argument value after PMPI call */
+    dumpi_request  request;
+    /** Not an MPI argument.  How the arrays above were stored */
+    dumpi_arg_detail detail;
+    /**
+     * Not an MPI argument.  Summary of recvcounts (if detail is
+     * DUMPI_DETAIL_SUMMARIZED).
+     */
+    dumpi_int_summary recvcounts_summary;
+  } dumpi_iallgatherv;
+
+  /**
+   * Hold the argument values for a nonblocking alltoall operation.
+   */
+  typedef struct dumpi_ialltoall {
+    /** Argument value before PMPI call */
+    int  sendcount;
+    /** Argument value before PMPI call */
+    dumpi_datatype  sendtype;
+    /** Argument value before PMPI call */
+    int  recvcount;
+    /** Argument value before PMPI call */
+    dumpi_datatype  recvtype;
+    /** Argument value before PMPI call */
+    dumpi_comm  comm;
+    /** Argument value after PMPI call */
+    dumpi_request  request;
+  } dumpi_ialltoall;
+
+  /**
+   * Hold the argument values for a nonblocking alltoallv operation.
+   */
+  typedef struct dumpi_ialltoallv {
+    /** Not an MPI argument.  Added to index relevant data in the struct. */
+    int  commsize;
+    /** Argument value before PMPI call.  Array of length [commsize] */
+    int * sendcounts;
+    /** Argument value before PMPI call.  Array of length [commsize] */
+    int * senddispls;
+    /** Argument value before PMPI call */
+    dumpi_datatype  sendtype;
+    /** Argument value before PMPI call.  Array of length [commsize] */
+    int * recvcounts;
+    /** Argument value before PMPI call.  Array of length [commsize] */
+    int * recvdispls;
+    /** Argument value before PMPI call */
+    dumpi_datatype  recvtype;
+    /** Argument value before PMPI call */
+    dumpi_comm  comm;
+    /** Argument value after PMPI call */
+    dumpi_request  request;
+    /** Not an MPI argument.  How the arrays above were stored */
+    dumpi_arg_detail detail;
+    /**
+     * Not an MPI argument.  Summary of sendcounts (if detail is
+     * DUMPI_DETAIL_SUMMARIZED).
+     */
+    dumpi_int_summary sendcounts_summary;
+    /**
+     * Not an MPI argument.  Summary of recvcounts (if detail is
+     * DUMPI_DETAIL_SUMMARIZED).
+     */
+    dumpi_int_summary recvcounts_summary;
+  } dumpi_ialltoallv;
+
+  /**
+   * Hold the argument values for a nonblocking alltoallw operation.
+   */
+  typedef struct dumpi_ialltoallw {
+    /** Not an MPI argument.  Added to index relevant data in the struct. */
+    int  commsize;
+    /** Argument value before PMPI call.  Array of length [commsize] */
+    int * sendcounts;
+    /** Argument value before PMPI call.  Array of length [commsize] */
+    int * senddispls;
+    /** Argument value before PMPI call.  Array of length [commsize] */
+    dumpi_datatype * sendtypes;
+    /** Argument value before PMPI call.  Array of length [commsize] */
+    int * recvcounts;
+    /** Argument value before PMPI call.  Array of length [commsize] */
+    int * recvdispls;
+    /** Argument value before PMPI call.  Array of length [commsize] */
+    dumpi_datatype * recvtypes;
+    /** Argument value before PMPI call */
+    dumpi_comm  comm;
+    /** Argument value after PMPI call */
+    dumpi_request  request;
+    /** Not an MPI argument.  How the arrays above were stored */
+    dumpi_arg_detail detail;
+    /**
+     * Not an MPI argument.  Summary of sendcounts (if detail is
+     * DUMPI_DETAIL_SUMMARIZED).
+     */
+    dumpi_int_summary sendcounts_summary;
+    /**
+     * Not an MPI argument.  Summary of recvcounts (if detail is
+     * DUMPI_DETAIL_SUMMARIZED).
+     */
+    dumpi_int_summary recvcounts_summary;
+  } dumpi_ialltoallw;
+
+  /**
+   * Hold the argument values for a nonblocking reduce operation.
+   */
+  typedef struct dumpi_ireduce {
+    /** Argument value before PMPI call */
+    int  count;
+    /** Argument value before PMPI call */
+    dumpi_datatype  datatype;
+    /** Argument value before PMPI call */
+    dumpi_op  op;
+    /** Argument value before PMPI call */
+    int  root;
+    /** Argument value before PMPI call */
+    dumpi_comm  comm;
+    /** Argument value after PMPI call */
+    dumpi_request  request;
+  } dumpi_ireduce;
+
+  /**
+   * Hold the argument values for a nonblocking allreduce operation.
+   */
+  typedef struct dumpi_iallreduce {
+    /** Argument value before PMPI call */
+    int  count;
+    /** Argument value before PMPI call */
+    dumpi_datatype  datatype;
+    /** Argument value before PMPI call */
+    dumpi_op  op;
+    /** Argument value before PMPI call */
+    dumpi_comm  comm;
+    /** Argument value after PMPI call */
+    dumpi_request  request;
+  } dumpi_iallreduce;
+
+  /**
+   * Hold the argument values for a nonblocking reduce scatter operation.
+   */
+  typedef struct dumpi_ireduce_scatter {
+    /** Not an MPI argument.  Added to index relevant data in the struct. */
+    int  commsize;
+    /** Argument value before PMPI call.  Array of length [commsize] */
+    int * recvcounts;
+    /** Argument value before PMPI call */
+    dumpi_datatype  datatype;
+    /** Argument value before PMPI call */
+    dumpi_op  op;
+    /** Argument value before PMPI call */
+    dumpi_comm  comm;
+    /** Argument value after PMPI call */
+    dumpi_request  request;
+    /** Not an MPI argument.  How the arrays above were stored */
+    dumpi_arg_detail detail;
+    /**
+     * Not an MPI argument.  Summary of recvcounts (if detail is
+     * DUMPI_DETAIL_SUMMARIZED).
+     */
+    dumpi_int_summary recvcounts_summary;
+  } dumpi_ireduce_scatter;
+
+  /**
+   * Hold the argument values for a nonblocking scan operation.
+   */
+  typedef struct dumpi_iscan {
+    /** Argument value before PMPI call */
+    int  count;
+    /** Argument value before PMPI call */
+    dumpi_datatype  datatype;
+    /** Argument value before PMPI call */
+    dumpi_op  op;
+    /** Argument value before PMPI call */
+    dumpi_comm  comm;
+    /** Argument value after PMPI call */
+    dumpi_request  request;
+  } dumpi_iscan;
+
+  /**
+   * Hold the argument values for a nonblocking exscan operation.
+   */
+  typedef struct dumpi_iexscan {
+    /** Argument value before PMPI call */
+    int  count;
+    /** Argument value before PMPI call */
+    dumpi_datatype  datatype;
+    /** Argument value before PMPI call */
+    dumpi_op  op;
+    /** Argument value before PMPI call */
+    dumpi_comm  comm;
+    /** Argument value after PMPI call */
+    dumpi_request  request;
+  } dumpi_iexscan;
+
+  /**
+   * Hold the argument values for a dist_graph_create_adjacent operation.
+   * Edge weights and the info argument are not stored.
+   */
+  typedef struct dumpi_dist_graph_create_adjacent {
+    /** Argument value before PMPI call */
+    dumpi_comm  oldcomm;
+    /** Argument value before PMPI call */
+    int  indegree;
+    /** Argument value before PMPI call.  Array of length [indegree] */
+    int * sources;
+    /** Argument value before PMPI call */
+    int  outdegree;
+    /** Argument value before PMPI call.  Array of length [outdegree] */
+    int * destinations;
+    /** Argument value before PMPI call */
+    int  reorder;
+    /** Argument value after PMPI call */
+    dumpi_comm  newcomm;
+  } dumpi_dist_graph_create_adjacent;
+
+  /**
+   * Hold the argument values for a neighbor_allgather operation.
+   */
+  typedef struct dumpi_neighbor_allgather {
+    /** Argument value before PMPI call */
+    int  sendcount;
+    /** Argument value before PMPI call */
+    dumpi_datatype  sendtype;
+    /** Argument value before PMPI call */
+    int  recvcount;
+    /** Argument value before PMPI call */
+    dumpi_datatype  recvtype;
+    /** Argument value before PMPI call */
+    dumpi_comm  comm;
+  } dumpi_neighbor_allgather;
+
+  /**
+   * Hold the argument values for a neighbor_allgatherv operation.
+   */
+  typedef struct dumpi_neighbor_allgatherv {
+    /** Not an MPI argument.  Added to index relevant data in the struct. */
+    int  indegree;
+    /** Argument value before PMPI call */
+    int  sendcount;
+    /** Argument value before PMPI call */
+    dumpi_datatype  sendtype;
+    /** Argument value before PMPI call.  Array of length [indegree] */
+    int * recvcounts;
+    /** Argument value before PMPI call.  Array of length [indegree] */
+    int * displs;
+    /** Argument value before PMPI call */
+    dumpi_datatype  recvtype;
+    /** Argument value before PMPI call */
+    dumpi_comm  comm;
+  } dumpi_neighbor_allgatherv;
+
+  /**
+   * Hold the argument values for a neighbor_alltoall operation.
+   */
+  typedef struct dumpi_neighbor_alltoall {
+    /** Argument value before PMPI call */
+    int  sendcount;
+    /** Argument value before PMPI call */
+    dumpi_datatype  sendtype;
+    /** Argument value before PMPI call */
+    int  recvcount;
+    /** Argument value before PMPI call */
+    dumpi_datatype  recvtype;
+    /** Argument value before PMPI call */
+    dumpi_comm  comm;
+  } dumpi_neighbor_alltoall;
+
+  /**
+   * Hold the argument values for a neighbor_alltoallv operation.
+   */
+  typedef struct dumpi_neighbor_alltoallv {
+    /** Not an MPI argument.  Added to index relevant data in the struct. */
+    int  indegree;
+    /** Not an MPI argument.  Added to index relevant data in the struct. */
+    int  outdegree;
+    /** Argument value before PMPI call.  Array of length [outdegree] */
+    int * sendcounts;
+    /** Argument value before PMPI call.  Array of length [outdegree] */
+    int * senddispls;
+    /** Argument value before PMPI call */
+    dumpi_datatype  sendtype;
+    /** Argument value before PMPI call.  Array of length [indegree] */
+    int * recvcounts;
+    /** Argument value before PMPI call.  Array of length [indegree] */
+    int * recvdispls;
+    /** Argument value before PMPI call */
+    dumpi_datatype  recvtype;
+    /** Argument value before PMPI call */
+    dumpi_comm  comm;
+  } dumpi_neighbor_alltoallv;
+
+  /**
+   * Hold the argument values for a neighbor_alltoallw operation.
+   */
+  typedef struct dumpi_neighbor_alltoallw {
+    /** Not an MPI argument.  Added to index relevant data in the struct. */
+    int  indegree;
+    /** Not an MPI argument.  Added to index relevant data in the struct. */
+    int  outdegree;
+    /** Argument value before PMPI call.  Array of length [outdegree] */
+    int * sendcounts;
+    /** Argument value before PMPI call.  Array of length [outdegree] */
+    int * senddispls;
+    /** Argument value before PMPI call.  Array of length [outdegree] */
+    dumpi_datatype * sendtypes;
+    /** Argument value before PMPI call.  Array of length [indegree] */
+    int * recvcounts;
+    /** Argument value before PMPI call.  Array of length [indegree] */
+    int * recvdispls;
+    /** Argument value before PMPI call.  Array of length [indegree] */
+    dumpi_datatype * recvtypes;
+    /** Argument value before PMPI call */
+    dumpi_comm  comm;
+  } dumpi_neighbor_alltoallw;
+
+  /**
+   * Hold the argument values for a mprobe operation.
+   */
+  typedef struct dumpi_mprobe {
+    /** Argument value before PMPI call */
+    dumpi_source  source;
+    /** Argument value before PMPI call */
+    dumpi_tag  tag;
+    /** Argument value before PMPI call */
+    dumpi_comm  comm;
+    /** Argument value after PMPI call */
+    dumpi_message  message;
+    /** Argument value after PMPI call */
+    dumpi_status * status;
+  } dumpi_mprobe;
+
+  /**
+   * Hold the argument values for a improbe operation.
+   */
+  typedef struct dumpi_improbe {
+    /** Argument value before PMPI call */
+    dumpi_source  source;
+    /** Argument value before PMPI call */
+    dumpi_tag  tag;
+    /** Argument value before PMPI call */
+    dumpi_comm  comm;
+    /** Argument value after PMPI call */
+    int  flag;
+    /** Argument value after PMPI call.  MPI_MESSAGE_NULL unless flag != 0 */
+    dumpi_message  message;
+    /** Argument value after PMPI call.  Only stored if(flag != 0) */
+    dumpi_status * status;
+  } dumpi_improbe;
+
+  /**
+   * Hold the argument values for a mrecv operation.
+   */
+  typedef struct dumpi_mrecv {
+    /** Argument value before PMPI call */
+    int  count;
+    /** Argument value before PMPI call */
+    dumpi_datatype  datatype;
+    /** Argument value before PMPI call */
+    dumpi_message  message;
+    /** Argument value after PMPI call */
+    dumpi_status * status;
+  } dumpi_mrecv;
+
+  /**
+   * Hold the argument values for a imrecv operation.
+   */
+  typedef struct dumpi_imrecv {
+    /** Argument value before PMPI call */
+    int  count;
+    /** Argument value before PMPI call */
+    dumpi_datatype  datatype;
+    /** Argument value before PMPI call */
+    dumpi_message  message;
+    /** Argument value after PMPI call */
+    dumpi_request  request;
+  } dumpi_imrecv;
+
   /*@}*/
 
 #ifdef __cplusplus
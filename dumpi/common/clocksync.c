@@ -0,0 +1,58 @@
+/*
+ *  This file is part of DUMPI:
+ *               The MPI profiling library from the SST suite.
+ *  Copyright (c) 2009-2011 Sandia Corporation.
+ *  This software is distributed under the BSD License.
+ *  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+ *  the U.S. Government retains certain rights in this software.
+ *  For more information, see the LICENSE file in the top
+ *  SST/macroscale directory.
+ */
+
+#include <dumpi/common/clocksync.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#define NSEC_PER_SEC 1000000000LL
+
+int dumpi_clock_sync_from_keyvals(const dumpi_keyval_record *keyval,
+				  dumpi_clock_sync *sync)
+{
+  const dumpi_keyval_entry *entry;
+  int sec, nsec, found = 0;
+  assert(keyval != NULL && sync != NULL);
+  memset(sync, 0, sizeof(dumpi_clock_sync));
+  for(entry = keyval->head; entry != NULL; entry = entry->next) {
+    if(strcmp(entry->key, DUMPI_CLOCK_SYNC_TIME_KEY) == 0) {
+      /* Nine digits of nanoseconds, so %d reads them right */
+      if(sscanf(entry->val, "%d.%d", &sec, &nsec) != 2)
+	return 0;
+      sync->origin.sec = sec;
+      sync->origin.nsec = nsec;
+      found = 1;
+    }
+    else if(strcmp(entry->key, DUMPI_CLOCK_OFFSET_KEY) == 0)
+      sync->offset = strtod(entry->val, NULL);
+    else if(strcmp(entry->key, DUMPI_CLOCK_DRIFT_KEY) == 0)
+      sync->drift = strtod(entry->val, NULL);
+  }
+  return found;
+}
+
+void dumpi_clock_sync_apply(const dumpi_clock_sync *sync, dumpi_clock *wall) {
+  double since, shift;
+  int64_t ns;
+  since = (double)(wall->sec - sync->origin.sec) +
+    1e-9 * (double)(wall->nsec - sync->origin.nsec);
+  shift = sync->offset + sync->drift * since;
+  ns = (int64_t)wall->sec * NSEC_PER_SEC + wall->nsec +
+    (int64_t)(shift * 1e9 + (shift < 0 ? -0.5 : 0.5));
+  wall->sec = (int32_t)(ns / NSEC_PER_SEC);
+  wall->nsec = (int32_t)(ns % NSEC_PER_SEC);
+  if(wall->nsec < 0) {
+    wall->nsec += NSEC_PER_SEC;
+    --wall->sec;
+  }
+}
@@ -0,0 +1,76 @@
+/*
+ *  This file is part of DUMPI:
+ *               The MPI profiling library from the SST suite.
+ *  Copyright (c) 2009-2011 Sandia Corporation.
+ *  This software is distributed under the BSD License.
+ *  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+ *  the U.S. Government retains certain rights in this software.
+ *  For more information, see the LICENSE file in the top
+ *  SST/macroscale directory.
+ */
+
+#ifndef DUMPI_COMMON_CLOCKSYNC_H
+#define DUMPI_COMMON_CLOCKSYNC_H
+
+#include <dumpi/common/types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* ! __cplusplus */
+
+  /**
+   * \ingroup common
+   * \defgroup common_clocksync common/clocksync:  Mapping the wall clock \
+   *    of a rank onto the wall clock of rank 0.
+   *
+   * With clock-sync enabled, each rank trades a few messages with rank 0
+   * at MPI_Init and again at MPI_Finalize, and keeps the exchange with the
+   * shortest round trip.  Half the round trip bounds the error.  From the
+   * two exchanges, libdumpi stores in the keyval record of the trace:
+   *
+   *   - clock-sync-time:   local wall time of the first exchange
+   *                        (seconds.nanoseconds, as read from the clock)
+   *   - clock-offset:      rank 0 time minus local time at that point
+   *                        (seconds)
+   *   - clock-drift:       change of the offset per second of local time
+   *                        (0 if the run was too short to tell)
+   *   - clock-sync-error:  the larger half round trip of the two exchanges
+   *                        (seconds)
+   *
+   * A local wall time t then reads as
+   *   t + offset + drift * (t - sync_time)
+   * on the clock of rank 0.
+   */
+  /*@{*/
+
+#define DUMPI_CLOCK_SYNC_TIME_KEY  "clock-sync-time"
+#define DUMPI_CLOCK_OFFSET_KEY     "clock-offset"
+#define DUMPI_CLOCK_DRIFT_KEY      "clock-drift"
+#define DUMPI_CLOCK_ERROR_KEY      "clock-sync-error"
+
+  /** The linear map from local wall time to the wall time of rank 0. */
+  typedef struct dumpi_clock_sync {
+    /** Local wall time at which offset holds */
+    dumpi_clock origin;
+    /** Seconds to add at origin, and seconds added per second after it */
+    double      offset, drift;
+  } dumpi_clock_sync;
+
+  /**
+   * Read the clock-sync entries of a keyval record.
+   * \return non-zero if the record has them (sync is then set).
+   */
+  int dumpi_clock_sync_from_keyvals(const dumpi_keyval_record *keyval,
+				    dumpi_clock_sync *sync);
+
+  /** Map a local wall time onto the clock of rank 0. */
+  void dumpi_clock_sync_apply(const dumpi_clock_sync *sync,
+			      dumpi_clock *wall);
+
+  /*@}*/
+
+#ifdef __cplusplus
+} /* end of extern "C" */
+#endif /* ! __cplusplus */
+
+#endif /* ! DUMPI_COMMON_CLOCKSYNC_H */
@@ -186,6 +186,17 @@ const char* dumpi_get_request_name(dumpi_request req) {
   }
 }
 
+/* Get the string name of an MPI message
+ * Returns "user-defined-message" if >= DUMPI_FIRST_USER_MESSAGE. */
+const char* dumpi_get_message_name(dumpi_message msg) {
+  switch(msg) {
+    DUMPI_CASE_RETURN(MPI_MESSAGE_ERROR);
+    DUMPI_CASE_RETURN(MPI_MESSAGE_NULL);
+    DUMPI_CASE_RETURN(MPI_MESSAGE_NO_PROC);
+    default: return "user-defined-message";
+  }
+}
+
 /* Get string name for errhandlers. */
 const char* dumpi_get_errhandler_name(dumpi_errhandler eh) {
   if(eh >= DUMPI_FIRST_USER_ERRHANDLER)
@@ -244,6 +244,22 @@ extern "C" {
    */
   const char* dumpi_get_request_name(dumpi_request req);
 
+  /**
+   * Built-in message values (from MPI_Mprobe and MPI_Improbe).
+   */
+  typedef enum dumpi_native_messages {
+    DUMPI_MESSAGE_ERROR=0,
+    DUMPI_MESSAGE_NULL,
+    DUMPI_MESSAGE_NO_PROC,
+    DUMPI_FIRST_USER_MESSAGE
+  } dumpi_native_messages;
+
+  /**
+   * Get the string name of an MPI message.
+   * Returns "user-defined-message" if >= DUMPI_FIRST_USER_MESSAGE.
+   */
+  const char* dumpi_get_message_name(dumpi_message msg);
+
   /** These are required to differ from a NULL pointer in the MPI standard */
 #define DUMPI_STATUS_IGNORE NULL
 #define DUMPI_STATUSES_IGNORE DUMPI_STATUS_IGNORE
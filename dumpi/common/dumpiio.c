@@ -44,6 +44,46 @@ int dumpi_read_func_exit(dumpi_func_call *val, DUMPI_READARGS) {
   return 1;
 }
 
+int dumpi_write_func_call(const dumpi_func_call *val, DUMPI_WRITEARGS) {
+  STARTWRITE(profile, DUMPI_Function_call);
+  PUT_INT64_T(profile, val->fn);
+  ENDWRITE(profile);
+  return 1;
+}
+
+int dumpi_read_func_call(dumpi_func_call *val, DUMPI_READARGS) {
+  STARTREAD(profile, DUMPI_Function_call);
+  val->fn = GET_INT64_T(profile);
+  ENDREAD(profile);
+  return 1;
+}
+
+int dumpi_write_poll_summary(const dumpi_poll_summary *val, DUMPI_WRITEARGS) {
+  STARTWRITE(profile, DUMPI_Poll_summary);
+  PUT_INT16(profile, val->function);
+  PUT_INT(profile, val->count);
+  PUT_INT(profile, val->incall_wall.sec);
+  PUT_INT(profile, val->incall_wall.nsec);
+  PUT_INT(profile, val->incall_cpu.sec);
+  PUT_INT(profile, val->incall_cpu.nsec);
+  put32arr(profile, val->argcount, val->args);
+  ENDWRITE(profile);
+  return 1;
+}
+
+int dumpi_read_poll_summary(dumpi_poll_summary *val, DUMPI_READARGS) {
+  STARTREAD(profile, DUMPI_Poll_summary);
+  val->function = (int16_t)GET_INT16(profile);
+  val->count = GET_INT(profile);
+  val->incall_wall.sec = GET_INT(profile);
+  val->incall_wall.nsec = GET_INT(profile);
+  val->incall_cpu.sec = GET_INT(profile);
+  val->incall_cpu.nsec = GET_INT(profile);
+  get32arr(profile, &val->argcount, &val->args);
+  ENDREAD(profile);
+  return 1;
+}
+
 int dumpi_write_send(const dumpi_send *val, DUMPI_WRITEARGS) {
   STARTWRITE(profile, DUMPI_Send);
   PUT_INT(profile, val->count);
@@ -1170,8 +1210,8 @@ int dumpi_write_gatherv(const dumpi_gatherv *val, DUMPI_WRITEARGS) {
   PUT_DUMPI_DATATYPE(profile, val->sendtype);
   PUT_INT(profile, val->root);
   PUT_DUMPI_COMM(profile, val->comm);
-  if(val->commrank == val->root)   PUT_INT_ARRAY_1(profile, (i0 < val->commsize), val->recvcounts);
-  if(val->commrank == val->root)   PUT_INT_ARRAY_1(profile, (i0 < val->commsize), val->displs);
+  if(val->commrank == val->root)   PUT_INT_COUNTS(profile, val->detail, val->commsize, val->recvcounts, val->recvcounts_summary);
+  if(val->commrank == val->root)   PUT_INT_DISPLS(profile, val->detail, val->commsize, val->displs, val->recvcounts);
   /** JJW All nodes will need to know recvtype
   if(val->commrank == val->root)   PUT_DUMPI_DATATYPE(profile, val->recvtype);
   */
@@ -1188,7 +1228,8 @@ int dumpi_read_gatherv(dumpi_gatherv *val, DUMPI_READARGS) {
   val->sendtype = GET_DUMPI_DATATYPE(profile);
   val->root = GET_INT(profile);
   val->comm = GET_DUMPI_COMM(profile);
-  if(val->commrank == val->root)   GET_INT_ARRAY_1(profile, val->commsize, val->recvcounts);
+  val->detail = DUMPI_DETAIL_FULL;
+  if(val->commrank == val->root)   GET_INT_COUNTS(profile, val->detail, val->commsize, val->recvcounts, val->recvcounts_summary);
   if(val->commrank == val->root)   GET_INT_ARRAY_1(profile, val->commsize, val->displs);
   /** JJW All nodes will need to know recvtype
   if(val->commrank == val->root)   val->recvtype = GET_DUMPI_DATATYPE(profile);
@@ -1233,8 +1274,8 @@ int dumpi_write_scatterv(const dumpi_scatterv *val, DUMPI_WRITEARGS) {
   PUT_DUMPI_DATATYPE(profile, val->recvtype);
   PUT_INT(profile, val->root);
   PUT_DUMPI_COMM(profile, val->comm);
-  if(val->commrank == val->root)   PUT_INT_ARRAY_1(profile, (i0 < val->commsize), val->sendcounts);
-  if(val->commrank == val->root)   PUT_INT_ARRAY_1(profile, (i0 < val->commsize), val->displs);
+  if(val->commrank == val->root)   PUT_INT_COUNTS(profile, val->detail, val->commsize, val->sendcounts, val->sendcounts_summary);
+  if(val->commrank == val->root)   PUT_INT_DISPLS(profile, val->detail, val->commsize, val->displs, val->sendcounts);
   ENDWRITE(profile);
   return 1;
 }
@@ -1248,7 +1289,8 @@ int dumpi_read_scatterv(dumpi_scatterv *val, DUMPI_READARGS) {
   val->recvtype = GET_DUMPI_DATATYPE(profile);
   val->root = GET_INT(profile);
   val->comm = GET_DUMPI_COMM(profile);
-  if(val->commrank == val->root)   GET_INT_ARRAY_1(profile, val->commsize, val->sendcounts);
+  val->detail = DUMPI_DETAIL_FULL;
+  if(val->commrank == val->root)   GET_INT_COUNTS(profile, val->detail, val->commsize, val->sendcounts, val->sendcounts_summary);
   if(val->commrank == val->root)   GET_INT_ARRAY_1(profile, val->commsize, val->displs);
   ENDREAD(profile);
   return 1;
@@ -1281,8 +1323,8 @@ int dumpi_write_allgatherv(const dumpi_allgatherv *val, DUMPI_WRITEARGS) {
   PUT_INT(profile, val->commsize);
   PUT_INT(profile, val->sendcount);
   PUT_DUMPI_DATATYPE(profile, val->sendtype);
-  PUT_INT_ARRAY_1(profile, (i0 < val->commsize), val->recvcounts);
-  PUT_INT_ARRAY_1(profile, (i0 < val->commsize), val->displs);
+  PUT_INT_COUNTS(profile, val->detail, val->commsize, val->recvcounts, val->recvcounts_summary);
+  PUT_INT_DISPLS(profile, val->detail, val->commsize, val->displs, val->recvcounts);
   PUT_DUMPI_DATATYPE(profile, val->recvtype);
   PUT_DUMPI_COMM(profile, val->comm);
   ENDWRITE(profile);
@@ -1294,7 +1336,7 @@ int dumpi_read_allgatherv(dumpi_allgatherv *val, DUMPI_READARGS) {
   val->commsize = GET_INT(profile);
   val->sendcount = GET_INT(profile);
   val->sendtype = GET_DUMPI_DATATYPE(profile);
-  GET_INT_ARRAY_1(profile, val->commsize, val->recvcounts);
+  GET_INT_COUNTS(profile, val->detail, val->commsize, val->recvcounts, val->recvcounts_summary);
   GET_INT_ARRAY_1(profile, val->commsize, val->displs);
   val->recvtype = GET_DUMPI_DATATYPE(profile);
   val->comm = GET_DUMPI_COMM(profile);
@@ -1327,11 +1369,11 @@ int dumpi_read_alltoall(dumpi_alltoall *val, DUMPI_READARGS) {
 int dumpi_write_alltoallv(const dumpi_alltoallv *val, DUMPI_WRITEARGS) {
   STARTWRITE(profile, DUMPI_Alltoallv);
   PUT_INT(profile, val->commsize);
-  PUT_INT_ARRAY_1(profile, (i0 < val->commsize), val->sendcounts);
-  PUT_INT_ARRAY_1(profile, (i0 < val->commsize), val->senddispls);
+  PUT_INT_COUNTS(profile, val->detail, val->commsize, val->sendcounts, val->sendcounts_summary);
+  PUT_INT_DISPLS(profile, val->detail, val->commsize, val->senddispls, val->sendcounts);
   PUT_DUMPI_DATATYPE(profile, val->sendtype);
-  PUT_INT_ARRAY_1(profile, (i0 < val->commsize), val->recvcounts);
-  PUT_INT_ARRAY_1(profile, (i0 < val->commsize), val->recvdispls);
+  PUT_INT_COUNTS(profile, val->detail, val->commsize, val->recvcounts, val->recvcounts_summary);
+  PUT_INT_DISPLS(profile, val->detail, val->commsize, val->recvdispls, val->recvcounts);
   PUT_DUMPI_DATATYPE(profile, val->recvtype);
   PUT_DUMPI_COMM(profile, val->comm);
   ENDWRITE(profile);
@@ -1341,10 +1383,10 @@ int dumpi_write_alltoallv(const dumpi_alltoallv *val, DUMPI_WRITEARGS) {
 int dumpi_read_alltoallv(dumpi_alltoallv *val, DUMPI_READARGS) {
   STARTREAD(profile, DUMPI_Alltoallv);
   val->commsize = GET_INT(profile);
-  GET_INT_ARRAY_1(profile, val->commsize, val->sendcounts);
+  GET_INT_COUNTS(profile, val->detail, val->commsize, val->sendcounts, val->sendcounts_summary);
   GET_INT_ARRAY_1(profile, val->commsize, val->senddispls);
   val->sendtype = GET_DUMPI_DATATYPE(profile);
-  GET_INT_ARRAY_1(profile, val->commsize, val->recvcounts);
+  GET_INT_COUNTS(profile, val->detail, val->commsize, val->recvcounts, val->recvcounts_summary);
   GET_INT_ARRAY_1(profile, val->commsize, val->recvdispls);
   val->recvtype = GET_DUMPI_DATATYPE(profile);
   val->comm = GET_DUMPI_COMM(profile);
@@ -1427,7 +1469,7 @@ int dumpi_read_allreduce(dumpi_allreduce *val, DUMPI_READARGS) {
 int dumpi_write_reduce_scatter(const dumpi_reduce_scatter *val, DUMPI_WRITEARGS) {
   STARTWRITE(profile, DUMPI_Reduce_scatter);
   PUT_INT(profile, val->commsize);
-  PUT_INT_ARRAY_1(profile, (i0 < val->commsize), val->recvcounts);
+  PUT_INT_COUNTS(profile, val->detail, val->commsize, val->recvcounts, val->recvcounts_summary);
   PUT_DUMPI_DATATYPE(profile, val->datatype);
   PUT_DUMPI_OP(profile, val->op);
   PUT_DUMPI_COMM(profile, val->comm);
@@ -1438,7 +1480,7 @@ int dumpi_write_reduce_scatter(const dumpi_reduce_scatter *val, DUMPI_WRITEARGS)
 int dumpi_read_reduce_scatter(dumpi_reduce_scatter *val, DUMPI_READARGS) {
   STARTREAD(profile, DUMPI_Reduce_scatter);
   val->commsize = GET_INT(profile);
-  GET_INT_ARRAY_1(profile, val->commsize, val->recvcounts);
+  GET_INT_COUNTS(profile, val->detail, val->commsize, val->recvcounts, val->recvcounts_summary);
   val->datatype = GET_DUMPI_DATATYPE(profile);
   val->op = GET_DUMPI_OP(profile);
   val->comm = GET_DUMPI_COMM(profile);
@@ -3079,14 +3121,35 @@ int dumpi_read_win_wait(dumpi_win_wait *val, DUMPI_READARGS) {
 }
 
 int dumpi_write_alltoallw(const dumpi_alltoallw *val, DUMPI_WRITEARGS) {
+  dumpi_arg_detail detail = val->detail;
+  dumpi_datatype sendtype = 0, recvtype = 0;
+  /* A summary only gives byte totals if each side uses a single datatype */
+  if(detail == DUMPI_DETAIL_SUMMARIZED &&
+     !(dumpi_uniform_datatype(val->commsize, val->sendtypes, val->sendcounts,
+                              &sendtype) &&
+       dumpi_uniform_datatype(val->commsize, val->recvtypes, val->recvcounts,
+                              &recvtype)))
+  {
+    detail = DUMPI_DETAIL_SPARSE;
+  }
   STARTWRITE(profile, DUMPI_Alltoallw);
   PUT_INT(profile, val->commsize);
-  PUT_INT_ARRAY_1(profile, (i0 < val->commsize), val->sendcounts);
-  PUT_INT_ARRAY_1(profile, (i0 < val->commsize), val->senddispls);
-  PUT_DUMPI_DATATYPE_ARRAY_1(profile, (i0 < val->commsize), val->sendtypes);
-  PUT_INT_ARRAY_1(profile, (i0 < val->commsize), val->recvcounts);
-  PUT_INT_ARRAY_1(profile, (i0 < val->commsize), val->recvdispls);
-  PUT_DUMPI_DATATYPE_ARRAY_1(profile, (i0 < val->commsize), val->recvtypes);
+  PUT_INT_COUNTS(profile, detail, val->commsize, val->sendcounts, val->sendcounts_summary);
+  PUT_INT_DISPLS(profile, detail, val->commsize, val->senddispls, val->sendcounts);
+  if(detail == DUMPI_DETAIL_SUMMARIZED)
+    put_datatype_arr_constant(profile, val->commsize, sendtype);
+  else if(detail == DUMPI_DETAIL_SPARSE)
+    put_datatype_arr_sparse(profile, val->commsize, val->sendtypes, val->sendcounts);
+  else
+    PUT_DUMPI_DATATYPE_ARRAY_1(profile, (i0 < val->commsize), val->sendtypes);
+  PUT_INT_COUNTS(profile, detail, val->commsize, val->recvcounts, val->recvcounts_summary);
+  PUT_INT_DISPLS(profile, detail, val->commsize, val->recvdispls, val->recvcounts);
+  if(detail == DUMPI_DETAIL_SUMMARIZED)
+    put_datatype_arr_constant(profile, val->commsize, recvtype);
+  else if(detail == DUMPI_DETAIL_SPARSE)
+    put_datatype_arr_sparse(profile, val->commsize, val->recvtypes, val->recvcounts);
+  else
+    PUT_DUMPI_DATATYPE_ARRAY_1(profile, (i0 < val->commsize), val->recvtypes);
   PUT_DUMPI_COMM(profile, val->comm);
   ENDWRITE(profile);
   return 1;
@@ -3095,10 +3158,10 @@ int dumpi_write_alltoallw(const dumpi_alltoallw *val, DUMPI_WRITEARGS) {
 int dumpi_read_alltoallw(dumpi_alltoallw *val, DUMPI_READARGS) {
   STARTREAD(profile, DUMPI_Alltoallw);
   val->commsize = GET_INT(profile);
-  GET_INT_ARRAY_1(profile, val->commsize, val->sendcounts);
+  GET_INT_COUNTS(profile, val->detail, val->commsize, val->sendcounts, val->sendcounts_summary);
   GET_INT_ARRAY_1(profile, val->commsize, val->senddispls);
   GET_DUMPI_DATATYPE_ARRAY_1(profile, val->commsize, val->sendtypes);
-  GET_INT_ARRAY_1(profile, val->commsize, val->recvcounts);
+  GET_INT_COUNTS(profile, val->detail, val->commsize, val->recvcounts, val->recvcounts_summary);
   GET_INT_ARRAY_1(profile, val->commsize, val->recvdispls);
   GET_DUMPI_DATATYPE_ARRAY_1(profile, val->commsize, val->recvtypes);
   val->comm = GET_DUMPI_COMM(profile);
@@ -5523,3 +5586,681 @@ int dumpio_read_testsome(dumpio_testsome *val, DUMPI_READARGS) {
   return 1;
 }
 
+int dumpi_write_ibarrier(const dumpi_ibarrier *val, DUMPI_WRITEARGS) {
+  STARTWRITE(profile, DUMPI_Ibarrier);
+  PUT_DUMPI_COMM(profile, val->comm);
+  PUT_DUMPI_REQUEST(profile, val->request);
+  ENDWRITE(profile);
+  return 1;
+}
+
+int dumpi_read_ibarrier(dumpi_ibarrier *val, DUMPI_READARGS) {
+  STARTREAD(profile, DUMPI_Ibarrier);
+  val->comm = GET_DUMPI_COMM(profile);
+  val->request = GET_DUMPI_REQUEST(profile);
+  ENDREAD(profile);
+  return 1;
+}
+
+int dumpi_write_ibcast(const dumpi_ibcast *val, DUMPI_WRITEARGS) {
+  STARTWRITE(profile, DUMPI_Ibcast);
+  PUT_INT(profile, val->count);
+  PUT_DUMPI_DATATYPE(profile, val->datatype);
+  PUT_INT(profile, val->root);
+  PUT_DUMPI_COMM(profile, val->comm);
+  PUT_DUMPI_REQUEST(profile, val->request);
+  ENDWRITE(profile);
+  return 1;
+}
+
+int dumpi_read_ibcast(dumpi_ibcast *val, DUMPI_READARGS) {
+  STARTREAD(profile, DUMPI_Ibcast);
+  val->count = GET_INT(profile);
+  val->datatype = GET_DUMPI_DATATYPE(profile);
+  val->root = GET_INT(profile);
+  val->comm = GET_DUMPI_COMM(profile);
+  val->request = GET_DUMPI_REQUEST(profile);
+  ENDREAD(profile);
+  return 1;
+}
+
+int dumpi_write_igather(const dumpi_igather *val, DUMPI_WRITEARGS) {
+  STARTWRITE(profile, DUMPI_Igather);
+  PUT_INT(profile, val->commrank);
+  PUT_INT(profile, val->sendcount);
+  PUT_DUMPI_DATATYPE(profile, val->sendtype);
+  PUT_INT(profile, val->root);
+  PUT_DUMPI_COMM(profile, val->comm);
+  if(val->commrank == val->root)   PUT_INT(profile, val->recvcount);
+  if(val->commrank == val->root)   PUT_DUMPI_DATATYPE(profile, val->recvtype);
+  PUT_DUMPI_REQUEST(profile, val->request);
+  ENDWRITE(profile);
+  return 1;
+}
+
+int dumpi_read_igather(dumpi_igather *val, DUMPI_READARGS) {
+  STARTREAD(profile, DUMPI_Igather);
+  val->commrank = GET_INT(profile);
+  val->sendcount = GET_INT(profile);
+  val->sendtype = GET_DUMPI_DATATYPE(profile);
+  val->root = GET_INT(profile);
+  val->comm = GET_DUMPI_COMM(profile);
+  if(val->commrank == val->root)   val->recvcount = GET_INT(profile);
+  if(val->commrank == val->root)   val->recvtype = GET_DUMPI_DATATYPE(profile);
+  val->request = GET_DUMPI_REQUEST(profile);
+  ENDREAD(profile);
+  return 1;
+}
+
+int dumpi_write_igatherv(const dumpi_igatherv *val, DUMPI_WRITEARGS) {
+  STARTWRITE(profile, DUMPI_Igatherv);
+  PUT_INT(profile, val->commrank);
+  PUT_INT(profile, val->commsize);
+  PUT_INT(profile, val->sendcount);
+  PUT_DUMPI_DATATYPE(profile, val->sendtype);
+  PUT_INT(profile, val->root);
+  PUT_DUMPI_COMM(profile, val->comm);
+  if(val->commrank == val->root)   PUT_INT_COUNTS(profile, val->detail, val->commsize, val->recvcounts, val->recvcounts_summary);
+  if(val->commrank == val->root)   PUT_INT_DISPLS(profile, val->detail, val->commsize, val->displs, val->recvcounts);
+  /** JJW All nodes will need to know recvtype
+  if(val->commrank == val->root)   PUT_DUMPI_DATATYPE(profile, val->recvtype);
+  */
+  PUT_DUMPI_DATATYPE(profile, val->recvtype);
+  PUT_DUMPI_REQUEST(profile, val->request);
+  ENDWRITE(profile);
+  return 1;
+}
+
+int dumpi_read_igatherv(dumpi_igatherv *val, DUMPI_READARGS) {
+  STARTREAD(profile, DUMPI_Igatherv);
+  val->commrank = GET_INT(profile);
+  val->commsize = GET_INT(profile);
+  val->sendcount = GET_INT(profile);
+  val->sendtype = GET_DUMPI_DATATYPE(profile);
+  val->root = GET_INT(profile);
+  val->comm = GET_DUMPI_COMM(profile);
+  val->detail = DUMPI_DETAIL_FULL;
+  if(val->commrank == val->root)   GET_INT_COUNTS(profile, val->detail, val->commsize, val->recvcounts, val->recvcounts_summary);
+  if(val->commrank == val->root)   GET_INT_ARRAY_1(profile, val->commsize, val->displs);
+  /** JJW All nodes will need to know recvtype
+  if(val->commrank == val->root)   val->recvtype = GET_DUMPI_DATATYPE(profile);
+  */
+  val->recvtype = GET_DUMPI_DATATYPE(profile);
+  val->request = GET_DUMPI_REQUEST(profile);
+  ENDREAD(profile);
+  return 1;
+}
+
+int dumpi_write_iscatter(const dumpi_iscatter *val, DUMPI_WRITEARGS) {
+  STARTWRITE(profile, DUMPI_Iscatter);
+  PUT_INT(profile, val->commrank);
+  PUT_INT(profile, val->recvcount);
+  PUT_DUMPI_DATATYPE(profile, val->recvtype);
+  PUT_INT(profile, val->root);
+  PUT_DUMPI_COMM(profile, val->comm);
+  if(val->commrank == val->root)   PUT_INT(profile, val->sendcount);
+  if(val->commrank == val->root)   PUT_DUMPI_DATATYPE(profile, val->sendtype);
+  PUT_DUMPI_REQUEST(profile, val->request);
+  ENDWRITE(profile);
+  return 1;
+}
+
+int dumpi_read_iscatter(dumpi_iscatter *val, DUMPI_READARGS) {
+  STARTREAD(profile, DUMPI_Iscatter);
+  val->commrank = GET_INT(profile);
+  val->recvcount = GET_INT(profile);
+  val->recvtype = GET_DUMPI_DATATYPE(profile);
+  val->root = GET_INT(profile);
+  val->comm = GET_DUMPI_COMM(profile);
+  if(val->commrank == val->root)   val->sendcount = GET_INT(profile);
+  if(val->commrank == val->root)   val->sendtype = GET_DUMPI_DATATYPE(profile);
+  val->request = GET_DUMPI_REQUEST(profile);
+  ENDREAD(profile);
+  return 1;
+}
+
+int dumpi_write_iscatterv(const dumpi_iscatterv *val, DUMPI_WRITEARGS) {
+  STARTWRITE(profile, DUMPI_Iscatterv);
+  PUT_INT(profile, val->commrank);
+  PUT_INT(profile, val->commsize);
+  PUT_DUMPI_DATATYPE(profile, val->sendtype);
+  PUT_INT(profile, val->recvcount);
+  PUT_DUMPI_DATATYPE(profile, val->recvtype);
+  PUT_INT(profile, val->root);
+  PUT_DUMPI_COMM(profile, val->comm);
+  if(val->commrank == val->root)   PUT_INT_COUNTS(profile, val->detail, val->commsize, val->sendcounts, val->sendcounts_summary);
+  if(val->commrank == val->root)   PUT_INT_DISPLS(profile, val->detail, val->commsize, val->displs, val->sendcounts);
+  PUT_DUMPI_REQUEST(profile, val->request);
+  ENDWRITE(profile);
+  return 1;
+}
+
+int dumpi_read_iscatterv(dumpi_iscatterv *val, DUMPI_READARGS) {
+  STARTREAD(profile, DUMPI_Iscatterv);
+  val->commrank = GET_INT(profile);
+  val->commsize = GET_INT(profile);
+  val->sendtype = GET_DUMPI_DATATYPE(profile);
+  val->recvcount = GET_INT(profile);
+  val->recvtype = GET_DUMPI_DATATYPE(profile);
+  val->root = GET_INT(profile);
+  val->comm = GET_DUMPI_COMM(profile);
+  val->detail = DUMPI_DETAIL_FULL;
+  if(val->commrank == val->root)   GET_INT_COUNTS(profile, val->detail, val->commsize, val->sendcounts, val->sendcounts_summary);
+  if(val->commrank == val->root)   GET_INT_ARRAY_1(profile, val->commsize, val->displs);
+  val->request = GET_DUMPI_REQUEST(profile);
+  ENDREAD(profile);
+  return 1;
+}
+
+int dumpi_write_iallgather(const dumpi_iallgather *val, DUMPI_WRITEARGS) {
+  STARTWRITE(profile, DUMPI_Iallgather);
+  PUT_INT(profile, val->sendcount);
+  PUT_DUMPI_DATATYPE(profile, val->sendtype);
+  PUT_INT(profile, val->recvcount);
+  PUT_DUMPI_DATATYPE(profile, val->recvtype);
+  PUT_DUMPI_COMM(profile, val->comm);
+  PUT_DUMPI_REQUEST(profile, val->request);
+  ENDWRITE(profile);
+  return 1;
+}
+
+int dumpi_read_iallgather(dumpi_iallgather *val, DUMPI_READARGS) {
+  STARTREAD(profile, DUMPI_Iallgather);
+  val->sendcount = GET_INT(profile);
+  val->sendtype = GET_DUMPI_DATATYPE(profile);
+  val->recvcount = GET_INT(profile);
+  val->recvtype = GET_DUMPI_DATATYPE(profile);
+  val->comm = GET_DUMPI_COMM(profile);
+  val->request = GET_DUMPI_REQUEST(profile);
+  ENDREAD(profile);
+  return 1;
+}
+
+int dumpi_write_iallgatherv(const dumpi_iallgatherv *val, DUMPI_WRITEARGS) {
+  STARTWRITE(profile, DUMPI_Iallgatherv);
+  PUT_INT(profile, val->commsize);
+  PUT_INT(profile, val->sendcount);
+  PUT_DUMPI_DATATYPE(profile, val->sendtype);
+  PUT_INT_COUNTS(profile, val->detail, val->commsize, val->recvcounts, val->recvcounts_summary);
+  PUT_INT_DISPLS(profile, val->detail, val->commsize, val->displs, val->recvcounts);
+  PUT_DUMPI_DATATYPE(profile, val->recvtype);
+  PUT_DUMPI_COMM(profile, val->comm);
+  PUT_DUMPI_REQUEST(profile, val->request);
+  ENDWRITE(profile);
+  return 1;
+}
+
+int dumpi_read_iallgatherv(dumpi_iallgatherv *val, DUMPI_READARGS) {
+  STARTREAD(profile, DUMPI_Iallgatherv);
+  val->commsize = GET_INT(profile);
+  val->sendcount = GET_INT(profile);
+  val->sendtype = GET_DUMPI_DATATYPE(profile);
+  GET_INT_COUNTS(profile, val->detail, val->commsize, val->recvcounts, val->recvcounts_summary);
+  GET_INT_ARRAY_1(profile, val->commsize, val->displs);
+  val->recvtype = GET_DUMPI_DATATYPE(profile);
+  val->comm = GET_DUMPI_COMM(profile);
+  val->request = GET_DUMPI_REQUEST(profile);
+  ENDREAD(profile);
+  return 1;
+}
+
+int dumpi_write_ialltoall(const dumpi_ialltoall *val, DUMPI_WRITEARGS) {
+  STARTWRITE(profile, DUMPI_Ialltoall);
+  PUT_INT(profile, val->sendcount);
+  PUT_DUMPI_DATATYPE(profile, val->sendtype);
+  PUT_INT(profile, val->recvcount);
+  PUT_DUMPI_DATATYPE(profile, val->recvtype);
+  PUT_DUMPI_COMM(profile, val->comm);
+  PUT_DUMPI_REQUEST(profile, val->request);
+  ENDWRITE(profile);
+  return 1;
+}
+
+int dumpi_read_ialltoall(dumpi_ialltoall *val, DUMPI_READARGS) {
+  STARTREAD(profile, DUMPI_Ialltoall);
+  val->sendcount = GET_INT(profile);
+  val->sendtype = GET_DUMPI_DATATYPE(profile);
+  val->recvcount = GET_INT(profile);
+  val->recvtype = GET_DUMPI_DATATYPE(profile);
+  val->comm = GET_DUMPI_COMM(profile);
+  val->request = GET_DUMPI_REQUEST(profile);
+  ENDREAD(profile);
+  return 1;
+}
+
+int dumpi_write_ialltoallv(const dumpi_ialltoallv *val, DUMPI_WRITEARGS) {
+  STARTWRITE(profile, DUMPI_Ialltoallv);
+  PUT_INT(profile, val->commsize);
+  PUT_INT_COUNTS(profile, val->detail, val->commsize, val->sendcounts, val->sendcounts_summary);
+  PUT_INT_DISPLS(profile, val->detail, val->commsize, val->senddispls, val->sendcounts);
+  PUT_DUMPI_DATATYPE(profile, val->sendtype);
+  PUT_INT_COUNTS(profile, val->detail, val->commsize, val->recvcounts, val->recvcounts_summary);
+  PUT_INT_DISPLS(profile, val->detail, val->commsize, val->recvdispls, val->recvcounts);
+  PUT_DUMPI_DATATYPE(profile, val->recvtype);
+  PUT_DUMPI_COMM(profile, val->comm);
+  PUT_DUMPI_REQUEST(profile, val->request);
+  ENDWRITE(profile);
+  return 1;
+}
+
+int dumpi_read_ialltoallv(dumpi_ialltoallv *val, DUMPI_READARGS) {
+  STARTREAD(profile, DUMPI_Ialltoallv);
+  val->commsize = GET_INT(profile);
+  GET_INT_COUNTS(profile, val->detail, val->commsize, val->sendcounts, val->sendcounts_summary);
+  GET_INT_ARRAY_1(profile, val->commsize, val->senddispls);
+  val->sendtype = GET_DUMPI_DATATYPE(profile);
+  GET_INT_COUNTS(profile, val->detail, val->commsize, val->recvcounts, val->recvcounts_summary);
+  GET_INT_ARRAY_1(profile, val->commsize, val->recvdispls);
+  val->recvtype = GET_DUMPI_DATATYPE(profile);
+  val->comm = GET_DUMPI_COMM(profile);
+  val->request = GET_DUMPI_REQUEST(profile);
+  ENDREAD(profile);
+  return 1;
+}
+
+int dumpi_write_ialltoallw(const dumpi_ialltoallw *val, DUMPI_WRITEARGS) {
+  dumpi_arg_detail detail = val->detail;
+  dumpi_datatype sendtype = 0, recvtype = 0;
+  /* A summary only gives byte totals if each side uses a single datatype */
+  if(detail == DUMPI_DETAIL_SUMMARIZED &&
+     !(dumpi_uniform_datatype(val->commsize, val->sendtypes, val->sendcounts,
+                              &sendtype) &&
+       dumpi_uniform_datatype(val->commsize, val->recvtypes, val->recvcounts,
+                              &recvtype)))
+  {
+    detail = DUMPI_DETAIL_SPARSE;
+  }
+  STARTWRITE(profile, DUMPI_Ialltoallw);
+  PUT_INT(profile, val->commsize);
+  PUT_INT_COUNTS(profile, detail, val->commsize, val->sendcounts, val->sendcounts_summary);
+  PUT_INT_DISPLS(profile, detail, val->commsize, val->senddispls, val->sendcounts);
+  if(detail == DUMPI_DETAIL_SUMMARIZED)
+    put_datatype_arr_constant(profile, val->commsize, sendtype);
+  else if(detail == DUMPI_DETAIL_SPARSE)
+    put_datatype_arr_sparse(profile, val->commsize, val->sendtypes, val->sendcounts);
+  else
+    PUT_DUMPI_DATATYPE_ARRAY_1(profile, (i0 < val->commsize), val->sendtypes);
+  PUT_INT_COUNTS(profile, detail, val->commsize, val->recvcounts, val->recvcounts_summary);
+  PUT_INT_DISPLS(profile, detail, val->commsize, val->recvdispls, val->recvcounts);
+  if(detail == DUMPI_DETAIL_SUMMARIZED)
+    put_datatype_arr_constant(profile, val->commsize, recvtype);
+  else if(detail == DUMPI_DETAIL_SPARSE)
+    put_datatype_arr_sparse(profile, val->commsize, val->recvtypes, val->recvcounts);
+  else
+    PUT_DUMPI_DATATYPE_ARRAY_1(profile, (i0 < val->commsize), val->recvtypes);
+  PUT_DUMPI_COMM(profile, val->comm);
+  PUT_DUMPI_REQUEST(profile, val->request);
+  ENDWRITE(profile);
+  return 1;
+}
+
+int dumpi_read_ialltoallw(dumpi_ialltoallw *val, DUMPI_READARGS) {
+  STARTREAD(profile, DUMPI_Ialltoallw);
+  val->commsize = GET_INT(profile);
+  GET_INT_COUNTS(profile, val->detail, val->commsize, val->sendcounts, val->sendcounts_summary);
+  GET_INT_ARRAY_1(profile, val->commsize, val->senddispls);
+  GET_DUMPI_DATATYPE_ARRAY_1(profile, val->commsize, val->sendtypes);
+  GET_INT_COUNTS(profile, val->detail, val->commsize, val->recvcounts, val->recvcounts_summary);
+  GET_INT_ARRAY_1(profile, val->commsize, val->recvdispls);
+  GET_DUMPI_DATATYPE_ARRAY_1(profile, val->commsize, val->recvtypes);
+  val->comm = GET_DUMPI_COMM(profile);
+  val->request = GET_DUMPI_REQUEST(profile);
+  ENDREAD(profile);
+  return 1;
+}
+
+int dumpi_write_ireduce(const dumpi_ireduce *val, DUMPI_WRITEARGS) {
+  STARTWRITE(profile, DUMPI_Ireduce);
+  PUT_INT(profile, val->count);
+  PUT_DUMPI_DATATYPE(profile, val->datatype);
+  PUT_DUMPI_OP(profile, val->op);
+  PUT_INT(profile, val->root);
+  PUT_DUMPI_COMM(profile, val->comm);
+  PUT_DUMPI_REQUEST(profile, val->request);
+  ENDWRITE(profile);
+  return 1;
+}
+
+int dumpi_read_ireduce(dumpi_ireduce *val, DUMPI_READARGS) {
+  STARTREAD(profile, DUMPI_Ireduce);
+  val->count = GET_INT(profile);
+  val->datatype = GET_DUMPI_DATATYPE(profile);
+  val->op = GET_DUMPI_OP(profile);
+  val->root = GET_INT(profile);
+  val->comm = GET_DUMPI_COMM(profile);
+  val->request = GET_DUMPI_REQUEST(profile);
+  ENDREAD(profile);
+  return 1;
+}
+
+int dumpi_write_iallreduce(const dumpi_iallreduce *val, DUMPI_WRITEARGS) {
+  STARTWRITE(profile, DUMPI_Iallreduce);
+  PUT_INT(profile, val->count);
+  PUT_DUMPI_DATATYPE(profile, val->datatype);
+  PUT_DUMPI_OP(profile, val->op);
+  PUT_DUMPI_COMM(profile, val->comm);
+  PUT_DUMPI_REQUEST(profile, val->request);
+  ENDWRITE(profile);
+  return 1;
+}
+
+int dumpi_read_iallreduce(dumpi_iallreduce *val, DUMPI_READARGS) {
+  STARTREAD(profile, DUMPI_Iallreduce);
+  val->count = GET_INT(profile);
+  val->datatype = GET_DUMPI_DATATYPE(profile);
+  val->op = GET_DUMPI_OP(profile);
+  val->comm = GET_DUMPI_COMM(profile);
+  val->request = GET_DUMPI_REQUEST(profile);
+  ENDREAD(profile);
+  return 1;
+}
+
+int dumpi_write_ireduce_scatter(const dumpi_ireduce_scatter *val, DUMPI_WRITEARGS) {
+  STARTWRITE(profile, DUMPI_Ireduce_scatter);
+  PUT_INT(profile, val->commsize);
+  PUT_INT_COUNTS(profile, val->detail, val->commsize, val->recvcounts, val->recvcounts_summary);
+  PUT_DUMPI_DATATYPE(profile, val->datatype);
+  PUT_DUMPI_OP(profile, val->op);
+  PUT_DUMPI_COMM(profile, val->comm);
+  PUT_DUMPI_REQUEST(profile, val->request);
+  ENDWRITE(profile);
+  return 1;
+}
+
+int dumpi_read_ireduce_scatter(dumpi_ireduce_scatter *val, DUMPI_READARGS) {
+  STARTREAD(profile, DUMPI_Ireduce_scatter);
+  val->commsize = GET_INT(profile);
+  GET_INT_COUNTS(profile, val->detail, val->commsize, val->recvcounts, val->recvcounts_summary);
+  val->datatype = GET_DUMPI_DATATYPE(profile);
+  val->op = GET_DUMPI_OP(profile);
+  val->comm = GET_DUMPI_COMM(profile);
+  val->request = GET_DUMPI_REQUEST(profile);
+  ENDREAD(profile);
+  return 1;
+}
+
+int dumpi_write_iscan(const dumpi_iscan *val, DUMPI_WRITEARGS) {
+  STARTWRITE(profile, DUMPI_Iscan);
+  PUT_INT(profile, val->count);
+  PUT_DUMPI_DATATYPE(profile, val->datatype);
+  PUT_DUMPI_OP(profile, val->op);
+  PUT_DUMPI_COMM(profile, val->comm);
+  PUT_DUMPI_REQUEST(profile, val->request);
+  ENDWRITE(profile);
+  return 1;
+}
+
+int dumpi_read_iscan(dumpi_iscan *val, DUMPI_READARGS) {
+  STARTREAD(profile, DUMPI_Iscan);
+  val->count = GET_INT(profile);
+  val->datatype = GET_DUMPI_DATATYPE(profile);
+  val->op = GET_DUMPI_OP(profile);
+  val->comm = GET_DUMPI_COMM(profile);
+  val->request = GET_DUMPI_REQUEST(profile);
+  ENDREAD(profile);
+  return 1;
+}
+
+int dumpi_write_iexscan(const dumpi_iexscan *val, DUMPI_WRITEARGS) {
+  STARTWRITE(profile, DUMPI_Iexscan);
+  PUT_INT(profile, val->count);
+  PUT_DUMPI_DATATYPE(profile, val->datatype);
+  PUT_DUMPI_OP(profile, val->op);
+  PUT_DUMPI_COMM(profile, val->comm);
+  PUT_DUMPI_REQUEST(profile, val->request);
+  ENDWRITE(profile);
+  return 1;
+}
+
+int dumpi_read_iexscan(dumpi_iexscan *val, DUMPI_READARGS) {
+  STARTREAD(profile, DUMPI_Iexscan);
+  val->count = GET_INT(profile);
+  val->datatype = GET_DUMPI_DATATYPE(profile);
+  val->op = GET_DUMPI_OP(profile);
+  val->comm = GET_DUMPI_COMM(profile);
+  val->request = GET_DUMPI_REQUEST(profile);
+  ENDREAD(profile);
+  return 1;
+}
+
+int dumpi_write_dist_graph_create_adjacent(const dumpi_dist_graph_create_adjacent *val, DUMPI_WRITEARGS) {
+  STARTWRITE(profile, DUMPI_Dist_graph_create_adjacent);
+  PUT_DUMPI_COMM(profile, val->oldcomm);
+  PUT_INT(profile, val->indegree);
+  PUT_INT_ARRAY_1(profile, (i0 < val->indegree), val->sources);
+  PUT_INT(profile, val->outdegree);
+  PUT_INT_ARRAY_1(profile, (i0 < val->outdegree), val->destinations);
+  PUT_INT(profile, val->reorder);
+  PUT_DUMPI_COMM(profile, val->newcomm);
+  ENDWRITE(profile);
+  return 1;
+}
+
+int dumpi_read_dist_graph_create_adjacent(dumpi_dist_graph_create_adjacent *val, DUMPI_READARGS) {
+  STARTREAD(profile, DUMPI_Dist_graph_create_adjacent);
+  val->oldcomm = GET_DUMPI_COMM(profile);
+  val->indegree = GET_INT(profile);
+  GET_INT_ARRAY_1(profile, val->indegree, val->sources);
+  val->outdegree = GET_INT(profile);
+  GET_INT_ARRAY_1(profile, val->outdegree, val->destinations);
+  val->reorder = GET_INT(profile);
+  val->newcomm = GET_DUMPI_COMM(profile);
+  ENDREAD(profile);
+  return 1;
+}
+
+int dumpi_write_neighbor_allgather(const dumpi_neighbor_allgather *val, DUMPI_WRITEARGS) {
+  STARTWRITE(profile, DUMPI_Neighbor_allgather);
+  PUT_INT(profile, val->sendcount);
+  PUT_DUMPI_DATATYPE(profile, val->sendtype);
+  PUT_INT(profile, val->recvcount);
+  PUT_DUMPI_DATATYPE(profile, val->recvtype);
+  PUT_DUMPI_COMM(profile, val->comm);
+  ENDWRITE(profile);
+  return 1;
+}
+
+int dumpi_read_neighbor_allgather(dumpi_neighbor_allgather *val, DUMPI_READARGS) {
+  STARTREAD(profile, DUMPI_Neighbor_allgather);
+  val->sendcount = GET_INT(profile);
+  val->sendtype = GET_DUMPI_DATATYPE(profile);
+  val->recvcount = GET_INT(profile);
+  val->recvtype = GET_DUMPI_DATATYPE(profile);
+  val->comm = GET_DUMPI_COMM(profile);
+  ENDREAD(profile);
+  return 1;
+}
+
+int dumpi_write_neighbor_allgatherv(const dumpi_neighbor_allgatherv *val, DUMPI_WRITEARGS) {
+  STARTWRITE(profile, DUMPI_Neighbor_allgatherv);
+  PUT_INT(profile, val->indegree);
+  PUT_INT(profile, val->sendcount);
+  PUT_DUMPI_DATATYPE(profile, val->sendtype);
+  PUT_INT_ARRAY_1(profile, (i0 < val->indegree), val->recvcounts);
+  PUT_INT_ARRAY_1(profile, (i0 < val->indegree), val->displs);
+  PUT_DUMPI_DATATYPE(profile, val->recvtype);
+  PUT_DUMPI_COMM(profile, val->comm);
+  ENDWRITE(profile);
+  return 1;
+}
+
+int dumpi_read_neighbor_allgatherv(dumpi_neighbor_allgatherv *val, DUMPI_READARGS) {
+  STARTREAD(profile, DUMPI_Neighbor_allgatherv);
+  val->indegree = GET_INT(profile);
+  val->sendcount = GET_INT(profile);
+  val->sendtype = GET_DUMPI_DATATYPE(profile);
+  GET_INT_ARRAY_1(profile, val->indegree, val->recvcounts);
+  GET_INT_ARRAY_1(profile, val->indegree, val->displs);
+  val->recvtype = GET_DUMPI_DATATYPE(profile);
+  val->comm = GET_DUMPI_COMM(profile);
+  ENDREAD(profile);
+  return 1;
+}
+
+int dumpi_write_neighbor_alltoall(const dumpi_neighbor_alltoall *val, DUMPI_WRITEARGS) {
+  STARTWRITE(profile, DUMPI_Neighbor_alltoall);
+  PUT_INT(profile, val->sendcount);
+  PUT_DUMPI_DATATYPE(profile, val->sendtype);
+  PUT_INT(profile, val->recvcount);
+  PUT_DUMPI_DATATYPE(profile, val->recvtype);
+  PUT_DUMPI_COMM(profile, val->comm);
+  ENDWRITE(profile);
+  return 1;
+}
+
+int dumpi_read_neighbor_alltoall(dumpi_neighbor_alltoall *val, DUMPI_READARGS) {
+  STARTREAD(profile, DUMPI_Neighbor_alltoall);
+  val->sendcount = GET_INT(profile);
+  val->sendtype = GET_DUMPI_DATATYPE(profile);
+  val->recvcount = GET_INT(profile);
+  val->recvtype = GET_DUMPI_DATATYPE(profile);
+  val->comm = GET_DUMPI_COMM(profile);
+  ENDREAD(profile);
+  return 1;
+}
+
+int dumpi_write_neighbor_alltoallv(const dumpi_neighbor_alltoallv *val, DUMPI_WRITEARGS) {
+  STARTWRITE(profile, DUMPI_Neighbor_alltoallv);
+  PUT_INT(profile, val->indegree);
+  PUT_INT(profile, val->outdegree);
+  PUT_INT_ARRAY_1(profile, (i0 < val->outdegree), val->sendcounts);
+  PUT_INT_ARRAY_1(profile, (i0 < val->outdegree), val->senddispls);
+  PUT_DUMPI_DATATYPE(profile, val->sendtype);
+  PUT_INT_ARRAY_1(profile, (i0 < val->indegree), val->recvcounts);
+  PUT_INT_ARRAY_1(profile, (i0 < val->indegree), val->recvdispls);
+  PUT_DUMPI_DATATYPE(profile, val->recvtype);
+  PUT_DUMPI_COMM(profile, val->comm);
+  ENDWRITE(profile);
+  return 1;
+}
+
+int dumpi_read_neighbor_alltoallv(dumpi_neighbor_alltoallv *val, DUMPI_READARGS) {
+  STARTREAD(profile, DUMPI_Neighbor_alltoallv);
+  val->indegree = GET_INT(profile);
+  val->outdegree = GET_INT(profile);
+  GET_INT_ARRAY_1(profile, val->outdegree, val->sendcounts);
+  GET_INT_ARRAY_1(profile, val->outdegree, val->senddispls);
+  val->sendtype = GET_DUMPI_DATATYPE(profile);
+  GET_INT_ARRAY_1(profile, val->indegree, val->recvcounts);
+  GET_INT_ARRAY_1(profile, val->indegree, val->recvdispls);
+  val->recvtype = GET_DUMPI_DATATYPE(profile);
+  val->comm = GET_DUMPI_COMM(profile);
+  ENDREAD(profile);
+  return 1;
+}
+
+int dumpi_write_neighbor_alltoallw(const dumpi_neighbor_alltoallw *val, DUMPI_WRITEARGS) {
+  STARTWRITE(profile, DUMPI_Neighbor_alltoallw);
+  PUT_INT(profile, val->indegree);
+  PUT_INT(profile, val->outdegree);
+  PUT_INT_ARRAY_1(profile, (i0 < val->outdegree), val->sendcounts);
+  PUT_INT_ARRAY_1(profile, (i0 < val->outdegree), val->senddispls);
+  PUT_DUMPI_DATATYPE_ARRAY_1(profile, (i0 < val->outdegree), val->sendtypes);
+  PUT_INT_ARRAY_1(profile, (i0 < val->indegree), val->recvcounts);
+  PUT_INT_ARRAY_1(profile, (i0 < val->indegree), val->recvdispls);
+  PUT_DUMPI_DATATYPE_ARRAY_1(profile, (i0 < val->indegree), val->recvtypes);
+  PUT_DUMPI_COMM(profile, val->comm);
+  ENDWRITE(profile);
+  return 1;
+}
+
+int dumpi_read_neighbor_alltoallw(dumpi_neighbor_alltoallw *val, DUMPI_READARGS) {
+  STARTREAD(profile, DUMPI_Neighbor_alltoallw);
+  val->indegree = GET_INT(profile);
+  val->outdegree = GET_INT(profile);
+  GET_INT_ARRAY_1(profile, val->outdegree, val->sendcounts);
+  GET_INT_ARRAY_1(profile, val->outdegree, val->senddispls);
+  GET_DUMPI_DATATYPE_ARRAY_1(profile, val->outdegree, val->sendtypes);
+  GET_INT_ARRAY_1(profile, val->indegree, val->recvcounts);
+  GET_INT_ARRAY_1(profile, val->indegree, val->recvdispls);
+  GET_DUMPI_DATATYPE_ARRAY_1(profile, val->indegree, val->recvtypes);
+  val->comm = GET_DUMPI_COMM(profile);
+  ENDREAD(profile);
+  return 1;
+}
+
+int dumpi_write_mprobe(const dumpi_mprobe *val, DUMPI_WRITEARGS) {
+  STARTWRITE(profile, DUMPI_Mprobe);
+  PUT_DUMPI_SOURCE(profile, val->source);
+  PUT_DUMPI_TAG(profile, val->tag);
+  PUT_DUMPI_COMM(profile, val->comm);
+  PUT_DUMPI_MESSAGE(profile, val->message);
+  PUT_DUMPI_STATUS(profile, val->status);
+  ENDWRITE(profile);
+  return 1;
+}
+
+int dumpi_read_mprobe(dumpi_mprobe *val, DUMPI_READARGS) {
+  STARTREAD(profile, DUMPI_Mprobe);
+  val->source = GET_DUMPI_SOURCE(profile);
+  val->tag = GET_DUMPI_TAG(profile);
+  val->comm = GET_DUMPI_COMM(profile);
+  val->message = GET_DUMPI_MESSAGE(profile);
+  val->status = GET_DUMPI_STATUS(profile);
+  ENDREAD(profile);
+  return 1;
+}
+
+int dumpi_write_improbe(const dumpi_improbe *val, DUMPI_WRITEARGS) {
+  STARTWRITE(profile, DUMPI_Improbe);
+  PUT_DUMPI_SOURCE(profile, val->source);
+  PUT_DUMPI_TAG(profile, val->tag);
+  PUT_DUMPI_COMM(profile, val->comm);
+  PUT_INT(profile, val->flag);
+  PUT_DUMPI_MESSAGE(profile, val->message);
+  PUT_DUMPI_STATUS(profile, val->status);
+  ENDWRITE(profile);
+  return 1;
+}
+
+int dumpi_read_improbe(dumpi_improbe *val, DUMPI_READARGS) {
+  STARTREAD(profile, DUMPI_Improbe);
+  val->source = GET_DUMPI_SOURCE(profile);
+  val->tag = GET_DUMPI_TAG(profile);
+  val->comm = GET_DUMPI_COMM(profile);
+  val->flag = GET_INT(profile);
+  val->message = GET_DUMPI_MESSAGE(profile);
+  val->status = GET_DUMPI_STATUS(profile);
+  ENDREAD(profile);
+  return 1;
+}
+
+int dumpi_write_mrecv(const dumpi_mrecv *val, DUMPI_WRITEARGS) {
+  STARTWRITE(profile, DUMPI_Mrecv);
+  PUT_INT(profile, val->count);
+  PUT_DUMPI_DATATYPE(profile, val->datatype);
+  PUT_DUMPI_MESSAGE(profile, val->message);
+  PUT_DUMPI_STATUS(profile, val->status);
+  ENDWRITE(profile);
+  return 1;
+}
+
+int dumpi_read_mrecv(dumpi_mrecv *val, DUMPI_READARGS) {
+  STARTREAD(profile, DUMPI_Mrecv);
+  val->count = GET_INT(profile);
+  val->datatype = GET_DUMPI_DATATYPE(profile);
+  val->message = GET_DUMPI_MESSAGE(profile);
+  val->status = GET_DUMPI_STATUS(profile);
+  ENDREAD(profile);
+  return 1;
+}
+
+int dumpi_write_imrecv(const dumpi_imrecv *val, DUMPI_WRITEARGS) {
+  STARTWRITE(profile, DUMPI_Imrecv);
+  PUT_INT(profile, val->count);
+  PUT_DUMPI_DATATYPE(profile, val->datatype);
+  PUT_DUMPI_MESSAGE(profile, val->message);
+  PUT_DUMPI_REQUEST(profile, val->request);
+  ENDWRITE(profile);
+  return 1;
+}
+
+int dumpi_read_imrecv(dumpi_imrecv *val, DUMPI_READARGS) {
+  STARTREAD(profile, DUMPI_Imrecv);
+  val->count = GET_INT(profile);
+  val->datatype = GET_DUMPI_DATATYPE(profile);
+  val->message = GET_DUMPI_MESSAGE(profile);
+  val->request = GET_DUMPI_REQUEST(profile);
+  ENDREAD(profile);
+  return 1;
+}
@@ -41,6 +41,18 @@ extern "C" {
   /** Read a func_exit record (excluding function id) at current position */
   int dumpi_read_func_exit(dumpi_func_call *val, DUMPI_READARGS);
 
+  /** Write a func_call record (a whole call) at the current position */
+  int DUMPI_SKIP_INSTRUMENTING
+  dumpi_write_func_call(const dumpi_func_call *val, DUMPI_WRITEARGS);
+  /** Read a func_call record (excluding function id) at current position */
+  int dumpi_read_func_call(dumpi_func_call *val, DUMPI_READARGS);
+
+  /** Write a poll_summary record at the current stream position */
+  int DUMPI_SKIP_INSTRUMENTING
+  dumpi_write_poll_summary(const dumpi_poll_summary *val, DUMPI_WRITEARGS);
+  /** Read a poll_summary record (excluding function id) at current position */
+  int dumpi_read_poll_summary(dumpi_poll_summary *val, DUMPI_READARGS);
+
   /** Write a send record (including function id) at current position */
   int dumpi_write_send(const dumpi_send *val, DUMPI_WRITEARGS);
   /** Read a send record (excluding function id) at current position */
@@ -1485,6 +1497,136 @@ extern "C" {
   int dumpio_write_testsome(const dumpio_testsome *val, DUMPI_WRITEARGS);
   /** Read an IO testsome record (excluding function id) at current position */
   int dumpio_read_testsome(dumpio_testsome *val, DUMPI_READARGS);
+
+  /** Write a nonblocking barrier record (including function id) at current position */
+  int dumpi_write_ibarrier(const dumpi_ibarrier *val, DUMPI_WRITEARGS);
+  /** Read a nonblocking barrier record (excluding function id) at current position */
+  int dumpi_read_ibarrier(dumpi_ibarrier *val, DUMPI_READARGS);
+
+  /** Write a nonblocking bcast record (including function id) at current position */
+  int dumpi_write_ibcast(const dumpi_ibcast *val, DUMPI_WRITEARGS);
+  /** Read a nonblocking bcast record (excluding function id) at current position */
+  int dumpi_read_ibcast(dumpi_ibcast *val, DUMPI_READARGS);
+
+  /** Write a nonblocking gather record (including function id) at current position */
+  int dumpi_write_igather(const dumpi_igather *val, DUMPI_WRITEARGS);
+  /** Read a nonblocking gather record (excluding function id) at current position */
+  int dumpi_read_igather(dumpi_igather *val, DUMPI_READARGS);
+
+  /** Write a nonblocking gatherv record (including function id) at current position */
+  int dumpi_write_igatherv(const dumpi_igatherv *val, DUMPI_WRITEARGS);
+  /** Read a nonblocking gatherv record (excluding function id) at current position */
+  int dumpi_read_igatherv(dumpi_igatherv *val, DUMPI_READARGS);
+
+  /** Write a nonblocking scatter record (including function id) at current position */
+  int dumpi_write_iscatter(const dumpi_iscatter *val, DUMPI_WRITEARGS);
+  /** Read a nonblocking scatter record (excluding function id) at current position */
+  int dumpi_read_iscatter(dumpi_iscatter *val, DUMPI_READARGS);
+
+  /** Write a nonblocking scatterv record (including function id) at current position */
+  int dumpi_write_iscatterv(const dumpi_iscatterv *val, DUMPI_WRITEARGS);
+  /** Read a nonblocking scatterv record (excluding function id) at current position */
+  int dumpi_read_iscatterv(dumpi_iscatterv *val, DUMPI_READARGS);
+
+  /** Write a nonblocking allgather record (including function id) at current position */
+  int dumpi_write_iallgather(const dumpi_iallgather *val, DUMPI_WRITEARGS);
+  /** Read a nonblocking allgather record (excluding function id) at current position */
+  int dumpi_read_iallgather(dumpi_iallgather *val, DUMPI_READARGS);
+
+  /** Write a nonblocking allgatherv record (including function id) at current position */
+  int dumpi_write_iallgatherv(const dumpi_iallgatherv *val, DUMPI_WRITEARGS);
+  /** Read a nonblocking allgatherv record (excluding function id) at current position */
+  int dumpi_read_iallgatherv(dumpi_iallgatherv *val, DUMPI_READARGS);
+
+  /** Write a nonblocking alltoall record (including function id) at current position */
+  int dumpi_write_ialltoall(const dumpi_ialltoall *val, DUMPI_WRITEARGS);
+  /** Read a nonblocking alltoall record (excluding function id) at current position */
+  int dumpi_read_ialltoall(dumpi_ialltoall *val, DUMPI_READARGS);
+
+  /** Write a nonblocking alltoallv record (including function id) at current position */
+  int dumpi_write_ialltoallv(const dumpi_ialltoallv *val, DUMPI_WRITEARGS);
+  /** Read a nonblocking alltoallv record (excluding function id) at current position */
+  int dumpi_read_ialltoallv(dumpi_ialltoallv *val, DUMPI_READARGS);
+
+  /** Write a nonblocking alltoallw record (including function id) at current position */
+  int dumpi_write_ialltoallw(const dumpi_ialltoallw *val, DUMPI_WRITEARGS);
+  /** Read a nonblocking alltoallw record (excluding function id) at current position */
+  int dumpi_read_ialltoallw(dumpi_ialltoallw *val, DUMPI_READARGS);
+
+  /** Write a nonblocking reduce record (including function id) at current position */
+  int dumpi_write_ireduce(const dumpi_ireduce *val, DUMPI_WRITEARGS);
+  /** Read a nonblocking reduce record (excluding function id) at current position */
+  int dumpi_read_ireduce(dumpi_ireduce *val, DUMPI_READARGS);
+
+  /** Write a nonblocking allreduce record (including function id) at current position */
+  int dumpi_write_iallreduce(const dumpi_iallreduce *val, DUMPI_WRITEARGS);
+  /** Read a nonblocking allreduce record (excluding function id) at current position */
+  int dumpi_read_iallreduce(dumpi_iallreduce *val, DUMPI_READARGS);
+
+  /** Write a nonblocking reduce scatter record (including function id) at current position */
+  int dumpi_write_ireduce_scatter(const dumpi_ireduce_scatter *val, DUMPI_WRITEARGS);
+  /** Read a nonblocking reduce scatter record (excluding function id) at current position */
+  int dumpi_read_ireduce_scatter(dumpi_ireduce_scatter *val, DUMPI_READARGS);
+
+  /** Write a nonblocking scan record (including function id) at current position */
+  int dumpi_write_iscan(const dumpi_iscan *val, DUMPI_WRITEARGS);
+  /** Read a nonblocking scan record (excluding function id) at current position */
+  int dumpi_read_iscan(dumpi_iscan *val, DUMPI_READARGS);
+
+  /** Write a nonblocking exscan record (including function id) at current position */
+  int dumpi_write_iexscan(const dumpi_iexscan *val, DUMPI_WRITEARGS);
+  /** Read a nonblocking exscan record (excluding function id) at current position */
+  int dumpi_read_iexscan(dumpi_iexscan *val, DUMPI_READARGS);
+
+  /** Write a dist_graph_create_adjacent record (including function id) at current position */
+  int dumpi_write_dist_graph_create_adjacent(const dumpi_dist_graph_create_adjacent *val, DUMPI_WRITEARGS);
+  /** Read a dist_graph_create_adjacent record (excluding function id) at current position */
+  int dumpi_read_dist_graph_create_adjacent(dumpi_dist_graph_create_adjacent *val, DUMPI_READARGS);
+
+  /** Write a neighbor_allgather record (including function id) at current position */
+  int dumpi_write_neighbor_allgather(const dumpi_neighbor_allgather *val, DUMPI_WRITEARGS);
+  /** Read a neighbor_allgather record (excluding function id) at current position */
+  int dumpi_read_neighbor_allgather(dumpi_neighbor_allgather *val, DUMPI_READARGS);
+
+  /** Write a neighbor_allgatherv record (including function id) at current position */
+  int dumpi_write_neighbor_allgatherv(const dumpi_neighbor_allgatherv *val, DUMPI_WRITEARGS);
+  /** Read a neighbor_allgatherv record (excluding function id) at current position */
+  int dumpi_read_neighbor_allgatherv(dumpi_neighbor_allgatherv *val, DUMPI_READARGS);
+
+  /** Write a neighbor_alltoall record (including function id) at current position */
+  int dumpi_write_neighbor_alltoall(const dumpi_neighbor_alltoall *val, DUMPI_WRITEARGS);
+  /** Read a neighbor_alltoall record (excluding function id) at current position */
+  int dumpi_read_neighbor_alltoall(dumpi_neighbor_alltoall *val, DUMPI_READARGS);
+
+  /** Write a neighbor_alltoallv record (including function id) at current position */
+  int dumpi_write_neighbor_alltoallv(const dumpi_neighbor_alltoallv *val, DUMPI_WRITEARGS);
+  /** Read a neighbor_alltoallv record (excluding function id) at current position */
+  int dumpi_read_neighbor_alltoallv(dumpi_neighbor_alltoallv *val, DUMPI_READARGS);
+
+  /** Write a neighbor_alltoallw record (including function id) at current position */
+  int dumpi_write_neighbor_alltoallw(const dumpi_neighbor_alltoallw *val, DUMPI_WRITEARGS);
+  /** Read a neighbor_alltoallw record (excluding function id) at current position */
+  int dumpi_read_neighbor_alltoallw(dumpi_neighbor_alltoallw *val, DUMPI_READARGS);
+
+  /** Write a mprobe record (including function id) at current position */
+  int dumpi_write_mprobe(const dumpi_mprobe *val, DUMPI_WRITEARGS);
+  /** Read a mprobe record (excluding function id) at current position */
+  int dumpi_read_mprobe(dumpi_mprobe *val, DUMPI_READARGS);
+
+  /** Write a improbe record (including function id) at current position */
+  int dumpi_write_improbe(const dumpi_improbe *val, DUMPI_WRITEARGS);
+  /** Read a improbe record (excluding function id) at current position */
+  int dumpi_read_improbe(dumpi_improbe *val, DUMPI_READARGS);
+
+  /** Write a mrecv record (including function id) at current position */
+  int dumpi_write_mrecv(const dumpi_mrecv *val, DUMPI_WRITEARGS);
+  /** Read a mrecv record (excluding function id) at current position */
+  int dumpi_read_mrecv(dumpi_mrecv *val, DUMPI_READARGS);
+
+  /** Write a imrecv record (including function id) at current position */
+  int dumpi_write_imrecv(const dumpi_imrecv *val, DUMPI_WRITEARGS);
+  /** Read a imrecv record (excluding function id) at current position */
+  int dumpi_read_imrecv(dumpi_imrecv *val, DUMPI_READARGS);
   
   /*@}*/
 
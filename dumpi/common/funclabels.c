@@ -162,9 +162,23 @@ const char *dumpi_function_label(dumpi_function func) {
     DUMPI_CR(MPIO_Testall);                  DUMPI_CR(MPIO_Waitall);                  
     DUMPI_CR(MPIO_Testany);                  DUMPI_CR(MPIO_Waitany);                  
     DUMPI_CR(MPIO_Waitsome);                 DUMPI_CR(MPIO_Testsome);                 
+    DUMPI_CR(MPI_Ibarrier);                  DUMPI_CR(MPI_Ibcast);                    
+    DUMPI_CR(MPI_Igather);                   DUMPI_CR(MPI_Igatherv);                  
+    DUMPI_CR(MPI_Iscatter);                  DUMPI_CR(MPI_Iscatterv);                 
+    DUMPI_CR(MPI_Iallgather);                DUMPI_CR(MPI_Iallgatherv);               
+    DUMPI_CR(MPI_Ialltoall);                 DUMPI_CR(MPI_Ialltoallv);                
+    DUMPI_CR(MPI_Ialltoallw);                DUMPI_CR(MPI_Ireduce);                   
+    DUMPI_CR(MPI_Iallreduce);                DUMPI_CR(MPI_Ireduce_scatter);           
+    DUMPI_CR(MPI_Iscan);                     DUMPI_CR(MPI_Iexscan);                   
+    DUMPI_CR(MPI_Dist_graph_create_adjacent); DUMPI_CR(MPI_Neighbor_allgather);        
+    DUMPI_CR(MPI_Neighbor_allgatherv);       DUMPI_CR(MPI_Neighbor_alltoall);         
+    DUMPI_CR(MPI_Neighbor_alltoallv);        DUMPI_CR(MPI_Neighbor_alltoallw);        
+    DUMPI_CR(MPI_Mprobe);                    DUMPI_CR(MPI_Improbe);                   
+    DUMPI_CR(MPI_Mrecv);                     DUMPI_CR(MPI_Imrecv);                    
     DUMPI_CR(MPI_ALL_FUNCTIONS);  /* Sentinel to mark last MPI function */
     /* Special lables to indicate profiled functions. */
     DUMPI_CR(MPI_Function_enter);            DUMPI_CR(MPI_Function_exit);
+    DUMPI_CR(MPI_Poll_summary);              DUMPI_CR(MPI_Function_call);
     DUMPI_CR(MPI_END_OF_STREAM);  /* Sentinel to mark end of trace stream */
   default:
     fprintf(stderr, "dumpi_function_label:  error:  unknown function label\n");
@@ -174,9 +174,28 @@ extern "C" {
     DUMPIO_Testall,                  DUMPIO_Waitall,                  
     DUMPIO_Testany,                  DUMPIO_Waitany,                  
     DUMPIO_Waitsome,                 DUMPIO_Testsome,                 
+    /* Nonblocking collectives (added in 1.1.7). */
+    DUMPI_Ibarrier,                  DUMPI_Ibcast,                    
+    DUMPI_Igather,                   DUMPI_Igatherv,                  
+    DUMPI_Iscatter,                  DUMPI_Iscatterv,                 
+    DUMPI_Iallgather,                DUMPI_Iallgatherv,               
+    DUMPI_Ialltoall,                 DUMPI_Ialltoallv,                
+    DUMPI_Ialltoallw,                DUMPI_Ireduce,                   
+    DUMPI_Iallreduce,                DUMPI_Ireduce_scatter,           
+    DUMPI_Iscan,                     DUMPI_Iexscan,                   
+    /* Topology neighborhoods and matched probes (added in 1.1.8). */
+    DUMPI_Dist_graph_create_adjacent, DUMPI_Neighbor_allgather,        
+    DUMPI_Neighbor_allgatherv,       DUMPI_Neighbor_alltoall,         
+    DUMPI_Neighbor_alltoallv,        DUMPI_Neighbor_alltoallw,        
+    DUMPI_Mprobe,                    DUMPI_Improbe,                   
+    DUMPI_Mrecv,                     DUMPI_Imrecv,                    
     DUMPI_ALL_FUNCTIONS,  /* Sentinel to mark last MPI function */
     /* Special lables to indicate profiled functions. */
     DUMPI_Function_enter,            DUMPI_Function_exit,
+    /* Coalesced run of unsuccessful polling calls (added in 1.1.2). */
+    DUMPI_Poll_summary,
+    /* A short profiled function, entry and exit in one record (1.1.6). */
+    DUMPI_Function_call,
     DUMPI_END_OF_STREAM  /* Sentinel to mark end of trace stream */
   } dumpi_function;
 
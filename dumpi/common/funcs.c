@@ -162,8 +162,22 @@ const char *dumpi_function_names[DUMPI_END_OF_STREAM+1] = {
   "MPIO_Testall"                 , "MPIO_Waitall"                 , 
   "MPIO_Testany"                 , "MPIO_Waitany"                 , 
   "MPIO_Waitsome"                , "MPIO_Testsome"                , 
+  "MPI_Ibarrier"                 , "MPI_Ibcast"                   , 
+  "MPI_Igather"                  , "MPI_Igatherv"                 , 
+  "MPI_Iscatter"                 , "MPI_Iscatterv"                , 
+  "MPI_Iallgather"               , "MPI_Iallgatherv"              , 
+  "MPI_Ialltoall"                , "MPI_Ialltoallv"               , 
+  "MPI_Ialltoallw"               , "MPI_Ireduce"                  , 
+  "MPI_Iallreduce"               , "MPI_Ireduce_scatter"          , 
+  "MPI_Iscan"                    , "MPI_Iexscan"                  , 
+  "MPI_Dist_graph_create_adjacent", "MPI_Neighbor_allgather"       , 
+  "MPI_Neighbor_allgatherv"      , "MPI_Neighbor_alltoall"        , 
+  "MPI_Neighbor_alltoallv"       , "MPI_Neighbor_alltoallw"       , 
+  "MPI_Mprobe"                   , "MPI_Improbe"                  , 
+  "MPI_Mrecv"                    , "MPI_Imrecv"                   , 
   "MPI_ALL_FUNCTIONS"            , 
   "Function_enter"               , "Function_exit"                ,
+  "Poll_summary"                 , "Function_call"                ,
   NULL  /* sentinel */
 };
 
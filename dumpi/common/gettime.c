@@ -153,3 +153,21 @@ void dumpi_get_time(dumpi_clock *cpu, dumpi_clock *wall)
 #endif /* DUMPI_ON_REDSTORM / DUMPI_ON_BGP / POSIX_TIMERS conditional */
 }
 
+/*
+ * Get the wall time alone.
+ */
+void dumpi_get_wall_time(dumpi_clock *wall)
+{
+#if (! defined(DUMPI_ON_REDSTORM)) && (! defined(DUMPI_ON_BGP)) && \
+  (! defined(DUMPI_DISABLE_POSIX_TIMERS)) && (_POSIX_TIMERS > 0) && \
+  defined(_POSIX_MONOTONIC_CLOCK)
+  struct timespec tspec;
+  assert(wall != NULL);
+  clock_gettime(CLOCK_MONOTONIC, &tspec);
+  wall->sec = tspec.tv_sec;
+  wall->nsec = tspec.tv_nsec;
+#else
+  dumpi_clock cpu;
+  dumpi_get_time(&cpu, wall);
+#endif /* DUMPI_ON_REDSTORM / DUMPI_ON_BGP / POSIX_TIMERS conditional */
+}
@@ -30,6 +30,12 @@ extern "C" {
    */ 
   void dumpi_get_time(dumpi_clock *cpu, dumpi_clock *wall);
 
+  /**
+   * Retrieve only the current wall time (the clock used by dumpi_get_time).
+   * Cheaper where cpu time needs a separate system call.
+   */
+  void dumpi_get_wall_time(dumpi_clock *wall);
+
   /*@}*/ 
 
 # ifdef __cplusplus
@@ -11,6 +11,8 @@
 
 #include <dumpi/common/io.h>
 #include <dumpi/common/iodefs.h>
+#include <dumpi/common/nodefile.h>
+#include <dumpi/common/writerpool.h>
 #include <dumpi/common/funcs.h>
 #include <dumpi/common/gettime.h>
 #include <dumpi/common/debugflags.h>
@@ -113,20 +115,29 @@ int dumpi_write_footer(dumpi_profile *profile, const dumpi_footer *footer) {
   /* Output ignored counts. */
   for(it = 0; it <= DUMPI_ALL_FUNCTIONS; ++it)
     put32(profile, footer->ignored_count[it]);
-  /* Output overhead costs. */
-  /*
+  /* Output overhead costs (added in v. 1.1.1). */
   for(it = 0; it <= DUMPI_ALL_FUNCTIONS; ++it) {
-    PUT_INT16(profile, overhead_accum[it].wall.sec);
-    PUT_INT32(profile, overhead_accum[it].wall.nsec);
-    PUT_INT16(profile, overhead_accum[it].cpu.sec);
-    PUT_INT32(profile, overhead_accum[it].cpu.nsec);
-  }
-  */
+    put32(profile, footer->overhead_wall[it].sec);
+    put32(profile, footer->overhead_wall[it].nsec);
+    put32(profile, footer->overhead_cpu[it].sec);
+    put32(profile, footer->overhead_cpu[it].nsec);
+  }
+  /* Output writer statistics (added in v. 1.1.1). */
+  put64(profile, footer->writer.bytes_written);
+  put32(profile, footer->writer.flush_count);
+  put32(profile, footer->writer.flush_time.sec);
+  put32(profile, footer->writer.flush_time.nsec);
+  put32(profile, footer->writer.lock_contended);
+  put32(profile, footer->writer.lock_wait.sec);
+  put32(profile, footer->writer.lock_wait.nsec);
   return 1;
 }
 
+/* Where entry IT of a footer with FUNCS functions goes */
+#define FOOTER_INDEX(IT, FUNCS) ((IT) < (FUNCS) ? (IT) : DUMPI_ALL_FUNCTIONS)
+
 int dumpi_read_footer(dumpi_profile *profile, dumpi_footer *footer) {
-  int it;
+  int it, functions;
   /* int8_t label; */
   int64_t foot;
   long callpos;
@@ -146,13 +157,36 @@ int dumpi_read_footer(dumpi_profile *profile, dumpi_footer *footer) {
       fprintf(stderr, "dumpi_read_footer:  Bad magic\n");
       abort();
     }
-    for(it = 0; it <= DUMPI_ALL_FUNCTIONS; ++it)
-      footer->call_count[it] = get32(profile);
-    for(it = 0; it <= DUMPI_ALL_FUNCTIONS; ++it)
-      footer->ignored_count[it] = get32(profile);
+    /* Older footers have fewer functions;  their last entry is the total
+     * (DUMPI_ALL_FUNCTIONS) and the newer functions stay at zero. */
+    memset(footer, 0, sizeof(dumpi_footer));
+    functions = dumpi_stream_functions(profile->version);
+    for(it = 0; it <= functions; ++it)
+      footer->call_count[FOOTER_INDEX(it, functions)] = get32(profile);
+    for(it = 0; it <= functions; ++it)
+      footer->ignored_count[FOOTER_INDEX(it, functions)] = get32(profile);
     /* Read overhead costs if they are in this footer. */
-    /* THIS IS WHERE I AM AT */
-    /* if((DUMPI_READ_TELL(profile) + 12*DUMPI_ALL_FUNCTIONS) <= */
+    if(dumpi_have_version(profile->version, 1, 1, 1)) {
+      for(it = 0; it <= functions; ++it) {
+	int at = FOOTER_INDEX(it, functions);
+	footer->overhead_wall[at].sec  = get32(profile);
+	footer->overhead_wall[at].nsec = get32(profile);
+	footer->overhead_cpu[at].sec   = get32(profile);
+	footer->overhead_cpu[at].nsec  = get32(profile);
+      }
+      footer->writer.bytes_written   = get64(profile);
+      footer->writer.flush_count     = get32(profile);
+      footer->writer.flush_time.sec  = get32(profile);
+      footer->writer.flush_time.nsec = get32(profile);
+      footer->writer.lock_contended  = get32(profile);
+      footer->writer.lock_wait.sec   = get32(profile);
+      footer->writer.lock_wait.nsec  = get32(profile);
+    }
+    else {
+      memset(footer->overhead_wall, 0, sizeof(footer->overhead_wall));
+      memset(footer->overhead_cpu, 0, sizeof(footer->overhead_cpu));
+      memset(&footer->writer, 0, sizeof(dumpi_writer_stats));
+    }
     DUMPI_SEEK(profile, callpos, SEEK_SET);
   }
   else {
@@ -170,12 +204,14 @@ int dumpi_write_keyval_record(dumpi_profile *profile,
     fprintf(stderr, "[DUMPI-IO] dumpi_write_keyval_record at offset 0x%llx\n",
 	    ((long long)DUMPI_WRITE_TELL(profile)));
   assert(profile);
+  profile->keyval = DUMPI_WRITE_TELL(profile);
   if(keyval) {
     dumpi_keyval_entry *curr = keyval->head;
     put32(profile, keyval->count);
     while(curr) {
       put_string(profile, curr->key);
       put_string(profile, curr->val);
+      curr = curr->next;
     }
   }
   else {
@@ -204,8 +240,8 @@ int dumpi_read_keyval_record(dumpi_profile *profile,
       dumpi_push_keyval_entry(keyval, key, val);
       free(key);
       free(val);
-      DUMPI_SEEK(profile, callpos, SEEK_SET);
     }
+    DUMPI_SEEK(profile, callpos, SEEK_SET);
   }
   else {
     /*
@@ -371,7 +407,7 @@ int dumpi_write_index(dumpi_profile *profile) {
   if(dumpi_debug & DUMPI_DEBUG_TRACEIO)
     fprintf(stderr, "[DUMPI-IO] dumpi_write_index at offset 0x%llx\n",
 	    ((long long)DUMPI_WRITE_TELL(profile)));
-  if(profile && profile->file) {
+  if(profile && (profile->file || profile->pooled)) {
     put64(profile, DUMPI_HEAD_MAGIC);
     put64(profile, profile->sizelbl); /* added in v. 0.6.6 */
     put64(profile, profile->addrlbl);
@@ -381,7 +417,9 @@ int dumpi_write_index(dumpi_profile *profile) {
     put64(profile, profile->footer);
     put64(profile, profile->keyval);    
     DUMPI_FLUSH(profile);
-    if(profile->file != stdout && profile->file != stderr)
+    if(profile->pooled)
+      dumpi_pool_close(profile);
+    else if(profile->file != stdout && profile->file != stderr)
       DUMPI_FCLOSE(profile->file);
     dumpi_free_membuf(profile->membuf);
     profile->file = NULL;
@@ -390,11 +428,22 @@ int dumpi_write_index(dumpi_profile *profile) {
   return 1;
 }
 
+DUMPIFILE dumpi_open_input_stream(const char *fname) {
+  DUMPIFILE fp = DUMPI_FOPEN(fname, "r");
+  if(fp == NULL) {
+    /* The stream of one rank in a node file (nodefile@rank)? */
+    int err = errno;
+    if((fp = dumpi_nodefile_open(fname)) == NULL && errno == ENOENT)
+      errno = err;
+  }
+  return fp;
+}
+
 dumpi_profile *dumpi_open_input_file(const char *fname) {
   /* The file must start with magic. */
   dumpi_profile *retval;
   uint64_t magic;
-  DUMPIFILE fp = DUMPI_FOPEN(fname, "r");
+  DUMPIFILE fp = dumpi_open_input_stream(fname);
   retval = (dumpi_profile*)calloc(1, sizeof(dumpi_profile));
   assert(retval != NULL);
   retval->addrlbl = retval->perflbl = 0;
@@ -533,22 +582,37 @@ dumpi_profile *dumpi_alloc_output_profile(int cpu_offset, int wall_offset,
     return NULL;
   }
   retval->target_membuf_size = target_buffer_size;
-  put64(retval, DUMPI_HEAD_MAGIC);
-  retval->version[0] = dumpi_version;
-  retval->version[1] = dumpi_subversion;
-  retval->version[2] = dumpi_subsubversion;
-  retval->cpu_time_offset = cpu_offset;
-  retval->wall_time_offset = wall_offset;
-  dumpi_start_stream_write(retval);
+  dumpi_start_output_profile(retval, cpu_offset, wall_offset);
   return retval;
 }
 
+void dumpi_start_output_profile(dumpi_profile *profile, int cpu_offset,
+				int wall_offset)
+{
+  put64(profile, DUMPI_HEAD_MAGIC);
+  profile->version[0] = dumpi_version;
+  profile->version[1] = dumpi_subversion;
+  profile->version[2] = dumpi_subsubversion;
+  profile->cpu_time_offset = cpu_offset;
+  profile->wall_time_offset = wall_offset;
+  dumpi_start_stream_write(profile);
+}
+
 /*
  * Free dynamic memory for an output profile.
  */
 void dumpi_free_output_profile(dumpi_profile *profile) {
+  if(profile->pooled)
+    dumpi_pool_release(profile);
+  if(profile->ring) {
+    /* The memory buffer is one of the ring segments */
+    dumpi_free_ring(profile->ring);
+    profile->membuf = NULL;
+  }
   if(profile->membuf)
     dumpi_free_membuf(profile->membuf);
+  if(profile->spill)
+    fclose(profile->spill);
   free(profile);
 }
 
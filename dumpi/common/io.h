@@ -212,9 +212,17 @@ extern "C" {
    */
   int dumpi_write_index(dumpi_profile *profile);
 
+  /**
+   * Open a trace file, or the stream of one rank in a node file
+   * (nodefile@rank, see nodefile.h), for reading.
+   * \return NULL if neither can be opened (errno is set).
+   */
+  DUMPIFILE dumpi_open_input_stream(const char *fname);
+
   /* Open a profile file and read its header magic, footer magic,
    * and index table.
-   * \param fname  The name of the file to be opened.
+   * \param fname  The name of the file to be opened, or of the stream of
+   *               one rank in a node file (nodefile@rank, see nodefile.h).
    * \return NULL if the file is not recognized as a valid dumpi file. */
   dumpi_profile* dumpi_open_input_file(const char *fname);
 
@@ -227,6 +235,13 @@ extern "C" {
   dumpi_profile* dumpi_alloc_output_profile(int cpu_bias, int wall_bias,
                                             int target_buffer_size);
 
+  /**
+   * Write the lead-in of a new output profile (magic, version, and time
+   * offsets).  Used by dumpi_alloc_output_profile and by writer pools.
+   */
+  void dumpi_start_output_profile(dumpi_profile *profile, int cpu_offset,
+				  int wall_offset);
+
   /**
    * Free dynamic memory for an output profile.
    */
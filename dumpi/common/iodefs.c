@@ -10,8 +10,13 @@
  */
 
 #include <dumpi/common/iodefs.h>
+#include <dumpi/common/gettime.h>
+#include <dumpi/common/writerpool.h>
 #include <stdlib.h>
 #include <assert.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
 
   /* Grab a buffer to write into -- 128MB-8B should be enough for anybody :) */
 #ifndef DUMPI_MEMBUF_SIZE
@@ -30,6 +35,35 @@ typedef struct dumpi_memory_buffer {
 
 /* static dumpi_memory_buffer *membuf = NULL; */
 
+/* Number of segments in a ring buffer. */
+#ifndef DUMPI_RING_SEGMENTS
+#define DUMPI_RING_SEGMENTS 8
+#endif /* ! DUMPI_RING_SEGMENTS */
+
+typedef struct dumpi_ring_buffer {
+  /* The stream lead-in (never dropped) */
+  dumpi_memory_buffer *lead;
+  /* Records; the oldest segment follows the current one */
+  dumpi_memory_buffer *segment[DUMPI_RING_SEGMENTS];
+  int                  current;
+  size_t               segment_size;
+  uint64_t             dropped;
+} dumpi_ring_buffer;
+
+dumpi_memory_buffer* dumpi_alloc_membuf(size_t length) {
+  dumpi_memory_buffer *buf;
+  buf = (dumpi_memory_buffer*)malloc(sizeof(dumpi_memory_buffer));
+  assert(buf != NULL);
+  buf->length = length;
+  buf->buffer = (unsigned char*)malloc(buf->length);
+  if(!buf->buffer) {
+    fprintf(stderr, "DUMPI:  Memory allocation failed for memory buffer\n");
+    assert(buf->buffer != NULL);
+  }
+  buf->pos = 0;
+  return buf;
+}
+
 /*
  * Free a memory buffer.
  */
@@ -40,29 +74,145 @@ void dumpi_free_membuf(dumpi_memory_buffer *buf) {
   }
 }
 
-static size_t dumpi_membuf_pos(const dumpi_profile *profile) {
+/*
+ * Free a ring buffer (including the memory buffers it holds).
+ */
+void dumpi_free_ring(dumpi_ring_buffer *ring) {
+  int i;
+  if(ring) {
+    dumpi_free_membuf(ring->lead);
+    for(i = 0; i < DUMPI_RING_SEGMENTS; ++i)
+      dumpi_free_membuf(ring->segment[i]);
+    free(ring);
+  }
+}
+
+size_t dumpi_membuf_capacity(const dumpi_profile *profile) {
+  if(profile->membuf)
+    return profile->membuf->length;
+  else
+    return 0;
+}
+
+size_t dumpi_membuf_pos(const dumpi_profile *profile) {
   if(profile->membuf)
     return profile->membuf->pos;
   else
     return 0;
 }
 
-void dumpi_membuf_flush(dumpi_profile *profile) {
+/* Chunk size for copying the spill file into the trace file */
+#ifndef DUMPI_SPILL_CHUNK
+#define DUMPI_SPILL_CHUNK 65536
+#endif /* ! DUMPI_SPILL_CHUNK */
+
+/* Open an anonymous file to spill to (it disappears when closed). */
+static DUMPIFILE open_spill_file(void) {
+  const char *dir = getenv("TMPDIR");
+  char *name;
+  int fd = -1;
+  DUMPIFILE fp;
+  if(dir == NULL || *dir == '\0')
+    dir = "/tmp";
+#ifdef O_TMPFILE
+  fd = open(dir, O_TMPFILE | O_RDWR | O_EXCL, 0600);
+#endif /* O_TMPFILE */
+  if(fd < 0) {
+    name = (char*)malloc(strlen(dir) + 32);
+    assert(name != NULL);
+    sprintf(name, "%s/dumpi-spill-XXXXXX", dir);
+    if((fd = mkstemp(name)) >= 0)
+      unlink(name);
+    free(name);
+  }
+  if(fd < 0 || (fp = fdopen(fd, "w+")) == NULL) {
+    fprintf(stderr, "DUMPI:  Failed to open a spill file in %s: %s\n",
+	    dir, strerror(errno));
+    abort();
+  }
+  return fp;
+}
+
+/* Move the buffered records (and those too large for the buffer) to the
+ * spill file.  Used while there is no trace file. */
+static void membuf_spill(dumpi_profile *profile, const void *ptr,
+			 size_t bytes)
+{
   size_t written;
-  assert(profile && profile->file);
-  if(profile->membuf != NULL && profile->membuf->pos > 0) {
-    written = fwrite(profile->membuf->buffer, 1,
-		     profile->membuf->pos, profile->file);
+  if(profile->spill == NULL)
+    profile->spill = open_spill_file();
+  if(profile->resolve_statuses != NULL)
+    profile->resolve_statuses(profile);
+  if(profile->membuf->pos > 0) {
+    written = fwrite(profile->membuf->buffer, 1, profile->membuf->pos,
+		     profile->spill);
     assert(written == profile->membuf->pos);
+    profile->spill_bytes += written;
     profile->membuf->pos = 0;
   }
-  fflush(profile->file);
+  if(bytes > 0) {
+    written = fwrite(ptr, 1, bytes, profile->spill);
+    assert(written == bytes);
+    profile->spill_bytes += written;
+  }
+}
+
+/* Copy the spilled records to the front of the trace file. */
+static void membuf_unspill(dumpi_profile *profile) {
+  unsigned char chunk[DUMPI_SPILL_CHUNK];
+  size_t count, written;
+  int status = fseeko(profile->spill, 0, SEEK_SET);
+  assert(status == 0);
+  while((count = fread(chunk, 1, sizeof(chunk), profile->spill)) > 0) {
+    written = fwrite(chunk, 1, count, profile->file);
+    assert(written == count);
+  }
+  assert(! ferror(profile->spill));
+  fclose(profile->spill);
+  profile->spill = NULL;
+  profile->spill_bytes = 0;
+}
+
+void dumpi_membuf_flush(dumpi_profile *profile) {
+  size_t written;
+  dumpi_time cpu, wall;
+  assert(profile && (profile->file || profile->pooled));
+  dumpi_get_time(&cpu.start, &wall.start);
+  if(profile->resolve_statuses != NULL)
+    profile->resolve_statuses(profile);
+  if(profile->pooled != NULL) {
+    /* The block goes back to the pool until the next write */
+    if(profile->membuf != NULL && profile->membuf->pos > 0)
+      dumpi_pool_write(profile, profile->membuf->buffer,
+		       profile->membuf->pos);
+    if(profile->membuf != NULL) {
+      profile->membuf->pos = 0;
+      dumpi_pool_return_block(profile);
+    }
+  }
+  else {
+    if(profile->spill != NULL)
+      membuf_unspill(profile);
+    if(profile->membuf != NULL && profile->membuf->pos > 0) {
+      written = fwrite(profile->membuf->buffer, 1,
+		       profile->membuf->pos, profile->file);
+      assert(written == profile->membuf->pos);
+      profile->membuf->pos = 0;
+    }
+    fflush(profile->file);
+  }
+  dumpi_get_time(&cpu.stop, &wall.stop);
+  ++profile->stats.flush_count;
+  dumpi_clock_accumulate(&profile->stats.flush_time, &wall.start, &wall.stop);
+  if(profile->flushed != NULL)
+    profile->flushed(profile, &cpu, &wall);
 }
 
 void dumpi_membuf_write(dumpi_profile *profile,
 			const void *ptr, size_t size, size_t nmemb)
 {
-  size_t bytes = size*nmemb;
+  size_t bytes = size*nmemb, limit;
+  int sink;
   assert(profile != NULL);
   /*
   printf("dumpi_membuf_write(%p, %ld, %ld, %p) at buffer offset %ld\n",
@@ -73,44 +223,143 @@ void dumpi_membuf_write(dumpi_profile *profile,
 	    " at a NULL pointer.\n", (long long)bytes);
     abort();
   }
+  if(profile->membuf == NULL && profile->pooled != NULL)
+    profile->membuf = dumpi_pool_take_block(profile);
   if(profile->membuf == NULL) {
     char *envsetting = NULL;
-    profile->membuf = (dumpi_memory_buffer*)malloc(sizeof(dumpi_memory_buffer));
-    assert(profile->membuf != NULL);
+    size_t length;
     if(profile->target_membuf_size >= DUMPI_MIN_MEMBUF_SIZE)
-      profile->membuf->length = profile->target_membuf_size;
+      length = profile->target_membuf_size;
     else {
-      profile->membuf->length = DUMPI_MEMBUF_SIZE;
+      length = DUMPI_MEMBUF_SIZE;
       envsetting = getenv("DUMPI_MEMBUF_SIZE");
       if(envsetting != NULL) {
-	profile->membuf->length = atoi(envsetting);
+	length = atoi(envsetting);
       }
-      if(profile->membuf->length < DUMPI_MIN_MEMBUF_SIZE)
-	profile->membuf->length = DUMPI_MIN_MEMBUF_SIZE;
-    }
-    profile->membuf->buffer = (unsigned char*)malloc(profile->membuf->length);
-    if(!profile->membuf->buffer) {
-      fprintf(stderr, "DUMPI:  Memory allocation failed for memory buffer\n");
-      assert(profile->membuf->buffer != NULL);
+      if(length < DUMPI_MIN_MEMBUF_SIZE)
+	length = DUMPI_MIN_MEMBUF_SIZE;
     }
-    profile->membuf->pos = 0;
+    profile->membuf = dumpi_alloc_membuf(length);
   }
-  if((profile->membuf->pos+bytes) >= profile->membuf->length) {
-    if(profile->file != NULL) {
-      DUMPI_FLUSH(profile);
-    }
-    else {
-      /* We don't have a file -- next best thing is to grow the buffer */
-      profile->membuf->length = 2*profile->membuf->length + bytes;
+  limit = profile->membuf->length;
+  sink = (profile->file != NULL || profile->pooled != NULL);
+  if(! sink && profile->spill_threshold > 0 &&
+     profile->spill_threshold < limit)
+    limit = profile->spill_threshold;
+  if((profile->membuf->pos+bytes) >= limit) {
+    if(profile->ring != NULL) {
+      /* A ring segment only overshoots by part of one record */
+      profile->membuf->length =
+	profile->membuf->pos + bytes + DUMPI_MIN_MEMBUF_SIZE;
       profile->membuf->buffer =
 	(unsigned char*)realloc(profile->membuf->buffer,
 				profile->membuf->length);
       assert(profile->membuf->buffer != NULL);
     }
+    else {
+      if(sink)
+	DUMPI_FLUSH(profile);
+      if(bytes >= limit) {
+	/* Too large for the buffer -- write it straight through */
+	if(profile->pooled != NULL)
+	  dumpi_pool_write(profile, ptr, bytes);
+	else if(profile->file != NULL) {
+	  size_t written = fwrite(ptr, 1, bytes, profile->file);
+	  assert(written == bytes);
+	}
+	else
+	  membuf_spill(profile, ptr, bytes);
+	profile->stats.bytes_written += bytes;
+	return;
+      }
+      if(profile->membuf == NULL)
+	profile->membuf = dumpi_pool_take_block(profile);
+      if(! sink) {
+	/* We don't have a file yet -- park the records in a spill file
+	 * (see dumpi_profile::spill) rather than growing the buffer */
+	membuf_spill(profile, NULL, 0);
+      }
+    }
   }
   if(bytes > 0)
     memcpy(profile->membuf->buffer+profile->membuf->pos, (ptr), bytes);
   profile->membuf->pos += bytes;
+  profile->stats.bytes_written += bytes;
+}
+
+void dumpi_membuf_ring_enable(dumpi_profile *profile, size_t window) {
+  int i;
+  dumpi_ring_buffer *ring;
+  assert(profile != NULL && profile->ring == NULL);
+  ring = (dumpi_ring_buffer*)calloc(1, sizeof(dumpi_ring_buffer));
+  assert(ring != NULL);
+  ring->segment_size = window / DUMPI_RING_SEGMENTS;
+  if(ring->segment_size < DUMPI_MIN_MEMBUF_SIZE)
+    ring->segment_size = DUMPI_MIN_MEMBUF_SIZE;
+  if(profile->membuf == NULL)
+    profile->membuf = dumpi_alloc_membuf(DUMPI_MIN_MEMBUF_SIZE);
+  ring->lead = profile->membuf;
+  for(i = 0; i < DUMPI_RING_SEGMENTS; ++i)
+    ring->segment[i] = dumpi_alloc_membuf(ring->segment_size + DUMPI_MIN_MEMBUF_SIZE);
+  ring->current = 0;
+  profile->membuf = ring->segment[0];
+  profile->ring = ring;
+}
+
+void dumpi_membuf_ring_mark(dumpi_profile *profile) {
+  dumpi_ring_buffer *ring = profile->ring;
+  dumpi_memory_buffer *next;
+  if(profile->membuf->pos < ring->segment_size)
+    return;
+  ring->current = (ring->current + 1) % DUMPI_RING_SEGMENTS;
+  next = ring->segment[ring->current];
+  ring->dropped += next->pos;
+  next->pos = 0;
+  profile->membuf = next;
+}
+
+/* Append the retained stream without counting it as newly written data. */
+static void ring_append(const dumpi_ring_buffer *ring, dumpi_profile *dest) {
+  int i;
+  uint64_t written = dest->stats.bytes_written;
+  const dumpi_memory_buffer *seg;
+  if(ring->lead->pos > 0)
+    dumpi_membuf_write(dest, ring->lead->buffer, 1, ring->lead->pos);
+  for(i = 1; i <= DUMPI_RING_SEGMENTS; ++i) {
+    seg = ring->segment[(ring->current + i) % DUMPI_RING_SEGMENTS];
+    if(seg->pos > 0)
+      dumpi_membuf_write(dest, seg->buffer, 1, seg->pos);
+  }
+  dest->stats.bytes_written = written;
+}
+
+void dumpi_membuf_ring_copy(const dumpi_profile *profile,
+			    dumpi_profile *dest)
+{
+  assert(profile != NULL && profile->ring != NULL && dest->ring == NULL);
+  ring_append(profile->ring, dest);
+}
+
+void dumpi_membuf_ring_disable(dumpi_profile *profile) {
+  dumpi_ring_buffer *ring;
+  assert(profile != NULL && profile->ring != NULL);
+  ring = profile->ring;
+  profile->ring = NULL;
+  profile->membuf = NULL;
+  ring_append(ring, profile);
+  dumpi_free_ring(ring);
+}
+
+uint64_t dumpi_membuf_ring_dropped(const dumpi_profile *profile) {
+  return (profile->ring ? profile->ring->dropped : 0);
+}
+
+void dumpi_membuf_patch(dumpi_profile *profile, size_t offset,
+			const void *ptr, size_t bytes)
+{
+  assert(profile != NULL && profile->membuf != NULL);
+  assert(offset + bytes <= profile->membuf->pos);
+  memcpy(profile->membuf->buffer + offset, ptr, bytes);
 }
 
 void dumpi_membuf_read(dumpi_profile *profile, void *ptr,
@@ -131,10 +380,15 @@ void dumpi_membuf_read(dumpi_profile *profile, void *ptr,
 }
 
 off_t dumpi_membuf_tell(dumpi_profile *profile) {
-  if(profile->file != NULL) {
-    return (ftello(profile->file) + dumpi_membuf_pos(profile));
+  /* Spilled records are still to be copied to the front of the file */
+  if(profile->pooled != NULL) {
+    return dumpi_pool_tell(profile) + dumpi_membuf_pos(profile);
+  }
+  else if(profile->file != NULL) {
+    return (ftello(profile->file) + profile->spill_bytes +
+	    dumpi_membuf_pos(profile));
   }
   else {
-    return dumpi_membuf_pos(profile);
+    return profile->spill_bytes + dumpi_membuf_pos(profile);
   }
 }
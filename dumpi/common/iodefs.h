@@ -14,10 +14,12 @@
 
 #include <dumpi/common/io.h>
 #include <dumpi/common/types.h>
+#include <dumpi/common/argtypes.h>
 #include <dumpi/common/constants.h>
 #include <dumpi/common/settings.h>
 #include <dumpi/common/debugflags.h>
 #include <dumpi/common/funcs.h>
+#include <dumpi/common/clocksync.h>
 #include <dumpi/dumpiconfig.h>
 #include <stdio.h>
 #include <string.h>
@@ -38,11 +40,21 @@ extern "C" {
    */
   /*@{*/ /* plop the documentation into the current module */
 
+  /**
+   * Allocate a memory buffer of the given length.
+   */
+  struct dumpi_memory_buffer* dumpi_alloc_membuf(size_t length);
+
   /**
    * Free a memory buffer.
    */
   void dumpi_free_membuf(struct dumpi_memory_buffer *buf);
 
+  /**
+   * Free a ring buffer (see dumpi_membuf_ring_enable).
+   */
+  void dumpi_free_ring(struct dumpi_ring_buffer *ring);
+
   /**
    * Flush the memory buffer.
    * Writes and sets the buffer position to zero iff file is not NULL.
@@ -59,6 +71,56 @@ extern "C" {
   void dumpi_membuf_write(dumpi_profile *profile, const void *ptr, size_t size,
 			  size_t nmemb);
 
+  /**
+   * Turn the memory buffer into a ring that holds (roughly) the most recent
+   * 'window' bytes of records.  Data written so far (the stream lead-in)
+   * is always kept.  The ring is split into segments; when a new record
+   * starts and the current segment is full, the oldest segment is
+   * dropped, so the ring always holds complete records.  Nothing gets
+   * written to file until dumpi_membuf_ring_disable is called.
+   */
+  void dumpi_membuf_ring_enable(dumpi_profile *profile, size_t window);
+
+  /**
+   * Called at the start of each record while a ring is active.
+   */
+  void dumpi_membuf_ring_mark(dumpi_profile *profile);
+
+  /**
+   * Append the retained stream (lead-in and records, oldest first) to
+   * another output profile.  The ring itself is not modified.
+   */
+  void dumpi_membuf_ring_copy(const dumpi_profile *profile,
+			      dumpi_profile *dest);
+
+  /**
+   * Put the retained stream back into a regular memory buffer and free
+   * the ring.  Subsequent writes are handled as usual.
+   */
+  void dumpi_membuf_ring_disable(dumpi_profile *profile);
+
+  /**
+   * Number of record bytes dropped from the ring so far.
+   */
+  uint64_t dumpi_membuf_ring_dropped(const dumpi_profile *profile);
+
+  /**
+   * Current write position in the memory buffer.
+   */
+  size_t dumpi_membuf_pos(const dumpi_profile *profile);
+
+  /**
+   * Size of the memory buffer (0 before anything was written).
+   */
+  size_t dumpi_membuf_capacity(const dumpi_profile *profile);
+
+  /**
+   * Overwrite data previously written to the memory buffer (and not yet
+   * flushed) starting at the given buffer offset.
+   */
+  void dumpi_membuf_patch(dumpi_profile *profile, size_t offset,
+			  const void *ptr, size_t bytes);
+
   /**
    * Despite the name, this reads straight from the file (we no longer do
    * our own input file buffering).
@@ -140,6 +202,11 @@ extern "C" {
     DUMPI_FWRITE(fp, &value, sizeof(uint8_t), 1);
   }
 
+  /** Utility routine to overwrite an 8 bit integer in the memory buffer. */
+  static inline void patch8(dumpi_profile *fp, size_t offset, uint8_t value) {
+    dumpi_membuf_patch(fp, offset, &value, sizeof(uint8_t));
+  }
+
   /** Utility routine to get a 16 bit integer from a binary stream. */
   static inline uint16_t get16(dumpi_profile *fp) {
     uint16_t scratch, retval;
@@ -186,32 +253,417 @@ extern "C" {
     DUMPI_FWRITE(fp, &bevalue, sizeof(uint32_t), 1);
   }
 
+  /** Utility routine to overwrite a 32 bit integer in the memory buffer. */
+  static inline void patch32(dumpi_profile *fp, size_t offset,
+			     uint32_t value)
+  {
+    uint32_t bevalue = htonl(value);
+    dumpi_membuf_patch(fp, offset, &bevalue, sizeof(uint32_t));
+  }
+
+  /** Utility routine to get a 64 bit integer from a binary stream. */
+  static inline uint64_t get64(dumpi_profile *fp) {
+    uint64_t value;
+    uint32_t high32, low32;
+    DUMPI_FREAD(fp, &high32, sizeof(uint32_t), 1);
+    DUMPI_FREAD(fp, &low32, sizeof(uint32_t), 1);
+    /* Pack the high and low values into a 64-bit value). */
+    value = ntohl(high32);
+    value <<= 32;
+    value |= ntohl(low32);
+    return value;
+  }
+
+  /** Utility routine to write a 64 bit integer to a binary stream. */
+  static inline void put64(dumpi_profile *fp, uint64_t value) {
+    uint32_t high32, low32;
+    high32 = htonl((uint32_t)(value >> 32));
+    low32  = htonl((uint32_t)(value));
+    DUMPI_FWRITE(fp, &high32, sizeof(uint32_t), 1);
+    DUMPI_FWRITE(fp, &low32,  sizeof(uint32_t), 1);
+  }
+
+  /**
+   * Tags written in place of the length of an array that is stored in a
+   * reduced form (see dumpi_arg_detail).  Plain arrays never have a
+   * negative length.  Each tag is followed by the length of the array.
+   */
+  /*@{*/
+  /** Followed by a dumpi_int_summary (total as 64 bits, min, max, nonzero) */
+#define DUMPI_ARRAY_SUMMARY  (-1)
+  /** Followed by the number of entries and that many index/value pairs */
+#define DUMPI_ARRAY_SPARSE   (-2)
+  /** Nothing follows; the array reads as NULL */
+#define DUMPI_ARRAY_OMITTED  (-3)
+  /** Followed by a single value shared by all entries */
+#define DUMPI_ARRAY_CONSTANT (-4)
+  /*
+   * Compact encodings of complete arrays, picked by put32arr when smaller
+   * than the plain form (readers always get the full array back).
+   */
+  /** Like DUMPI_ARRAY_SPARSE, for an array that is complete */
+#define DUMPI_ARRAY_INDEXED  (-5)
+  /** Followed by the first value and the step */
+#define DUMPI_ARRAY_PROGRESSION (-6)
+  /**
+   * Followed by a byte count and that many bytes of differences between
+   * successive entries, each zigzag-encoded as a base-128 varint
+   */
+#define DUMPI_ARRAY_VARINT   (-7)
+  /*@}*/
+
+  /** Arrays shorter than this are always written in the plain form */
+#define DUMPI_ARRAY_PACK_MIN 4
+
+  /** Map a signed value onto an unsigned one with small magnitudes first. */
+  static inline uint32_t dumpi_zigzag(int32_t value) {
+    return ((uint32_t)value << 1) ^ (uint32_t)(value >> 31);
+  }
+
+  /** Inverse of dumpi_zigzag. */
+  static inline int32_t dumpi_unzigzag(uint32_t value) {
+    return (int32_t)((value >> 1) ^ (0u - (value & 1u)));
+  }
+
+  /** Number of bytes in the varint encoding of a value. */
+  static inline int dumpi_varint_size(uint32_t value) {
+    return (value < (1u<<7) ? 1 : value < (1u<<14) ? 2 :
+	    value < (1u<<21) ? 3 : value < (1u<<28) ? 4 : 5);
+  }
+
+  /** Read count plain 32-bit values with a single read. */
+  static inline void get32block(dumpi_profile *fp, int32_t count,
+				int32_t *arr)
+  {
+    int i;
+    if(count <= 0)
+      return;
+    DUMPI_FREAD(fp, arr, sizeof(int32_t), count);
+    for(i = 0; i < count; ++i)
+      arr[i] = (int32_t)ntohl((uint32_t)arr[i]);
+  }
+
+  /** Expand a DUMPI_ARRAY_VARINT payload of the given length. */
+  static inline void get32varint(dumpi_profile *fp, int32_t count,
+				 int32_t *arr)
+  {
+    int i;
+    uint32_t shift, value, prev = 0;
+    int32_t bytes = get32(fp);
+    const uint8_t *pos, *end;
+    uint8_t *packed = (uint8_t*)malloc(bytes > 0 ? bytes : 1);
+    assert(packed != NULL);
+    if(bytes > 0)
+      DUMPI_FREAD(fp, packed, 1, bytes);
+    pos = packed;
+    end = packed + bytes;
+    for(i = 0; i < count; ++i) {
+      value = 0;
+      shift = 0;
+      do {
+	assert(pos < end);
+	value |= (uint32_t)(*pos & 0x7f) << shift;
+	shift += 7;
+      } while(*pos++ & 0x80);
+      prev += (uint32_t)dumpi_unzigzag(value);
+      arr[i] = (int32_t)prev;
+    }
+    free(packed);
+  }
+
+  /**
+   * Test whether entry i is kept in a sparse array: the entry of the
+   * matching count array is non-zero, or (without counts) the entry itself.
+   */
+  static inline int dumpi_sparse_keep(const int32_t *counts,
+				      const int32_t *arr, int i)
+  {
+    if(counts != NULL)
+      return (counts[i] != 0);
+    return (arr != NULL && arr[i] != 0);
+  }
+
+  /** Compute the summary of an array of counts. */
+  static inline void dumpi_summarize_counts(int32_t count, const int32_t *arr,
+					    dumpi_int_summary *summary)
+  {
+    int i;
+    memset(summary, 0, sizeof(dumpi_int_summary));
+    if(arr == NULL || count <= 0)
+      return;
+    summary->min = summary->max = arr[0];
+    for(i = 0; i < count; ++i) {
+      summary->total += arr[i];
+      if(arr[i] < summary->min) summary->min = arr[i];
+      if(arr[i] > summary->max) summary->max = arr[i];
+      if(arr[i] != 0) ++summary->nonzero;
+    }
+  }
+
+  /**
+   * Utility routine to read an array of 32-bit values in any of its
+   * stored forms.  Compact encodings and sparse arrays are expanded;
+   * summarized and omitted arrays
+   * read as NULL (the summary, if any, goes to summary when it is not NULL).
+   * \return the detail level the array was stored with.
+   */
+  static inline dumpi_arg_detail get32arr_detail(dumpi_profile *fp,
+						 int32_t *count,
+						 int32_t **arr,
+						 dumpi_int_summary *summary)
+  {
+    int i, entries, index;
+    int32_t tag = get32(fp);
+    *arr = NULL;
+    if(tag >= 0) {
+      *count = tag;
+      if(*count > 0)
+	*arr = (int32_t*)malloc(*count * sizeof(int32_t));
+      get32block(fp, *count, *arr);
+      return DUMPI_DETAIL_FULL;
+    }
+    /* The compact encodings of complete arrays came with 1.1.4 */
+    if(tag < DUMPI_ARRAY_CONSTANT &&
+       ! dumpi_have_version(fp->version, 1, 1, 4)) {
+      fprintf(stderr, "get32arr:  Array tag %d at offset 0x%llx is not "
+	      "valid in a version %d.%d.%d stream\n", (int)tag,
+	      (long long)DUMPI_READ_TELL(fp), (int)fp->version[0],
+	      (int)fp->version[1], (int)fp->version[2]);
+      abort();
+    }
+    *count = get32(fp);
+    if(tag <= DUMPI_ARRAY_CONSTANT && *count > 0)
+      *arr = (int32_t*)calloc(*count, sizeof(int32_t));
+    switch(tag) {
+    case DUMPI_ARRAY_CONSTANT:
+      {
+	int32_t value = get32(fp);
+	for(i = 0; i < *count; ++i)
+	  (*arr)[i] = value;
+      }
+      return DUMPI_DETAIL_FULL;
+    case DUMPI_ARRAY_PROGRESSION:
+      {
+	uint32_t value = get32(fp), step = get32(fp);
+	for(i = 0; i < *count; ++i, value += step)
+	  (*arr)[i] = (int32_t)value;
+      }
+      return DUMPI_DETAIL_FULL;
+    case DUMPI_ARRAY_INDEXED:
+      entries = get32(fp);
+      for(i = 0; i < entries; ++i) {
+	index = get32(fp);
+	assert(index >= 0 && index < *count);
+	(*arr)[index] = get32(fp);
+      }
+      return DUMPI_DETAIL_FULL;
+    case DUMPI_ARRAY_VARINT:
+      get32varint(fp, *count, *arr);
+      return DUMPI_DETAIL_FULL;
+    case DUMPI_ARRAY_SUMMARY:
+      {
+	dumpi_int_summary scratch;
+	if(summary == NULL)
+	  summary = &scratch;
+	summary->total = (int64_t)get64(fp);
+	summary->min = get32(fp);
+	summary->max = get32(fp);
+	summary->nonzero = get32(fp);
+      }
+      return DUMPI_DETAIL_SUMMARIZED;
+    case DUMPI_ARRAY_SPARSE:
+      if(*count > 0)
+	*arr = (int32_t*)calloc(*count, sizeof(int32_t));
+      entries = get32(fp);
+      for(i = 0; i < entries; ++i) {
+	index = get32(fp);
+	assert(index >= 0 && index < *count);
+	(*arr)[index] = get32(fp);
+      }
+      return DUMPI_DETAIL_SPARSE;
+    case DUMPI_ARRAY_OMITTED:
+      return DUMPI_DETAIL_SUMMARIZED;
+    default:
+      fprintf(stderr, "get32arr:  Invalid array tag %d at offset 0x%llx\n",
+	      (int)tag, (long long)DUMPI_READ_TELL(fp));
+      abort();
+    }
+  }
+
   /** Utility routine to get an array of 32-bit values. */
   static inline void get32arr(dumpi_profile *fp,
 			      int32_t *count, int32_t **arr)
   {
-    int i;
-    *count = get32(fp);
-    if(*count > 0)
-      *arr = (int32_t*)malloc(*count * sizeof(int32_t));
-    else
-      *arr = NULL;
-    for(i = 0; i < *count; ++i) {
-      (*arr)[i] = get32(fp);
+    get32arr_detail(fp, count, arr, NULL);
+  }
+
+  /** Write count plain 32-bit values, converting a chunk at a time. */
+  static inline void put32block(dumpi_profile *fp, int32_t count,
+				const int32_t *arr)
+  {
+    uint32_t chunk[256];
+    int i, j, n;
+    for(i = 0; i < count; i += n) {
+      n = (count - i < 256 ? count - i : 256);
+      for(j = 0; j < n; ++j)
+	chunk[j] = htonl((uint32_t)arr[i+j]);
+      DUMPI_FWRITE(fp, chunk, sizeof(uint32_t), n);
     }
   }
 
-  /** Utility routine to write an array of 32-bit values. */
+  /** Write the payload of a DUMPI_ARRAY_VARINT array. */
+  static inline void put32varint(dumpi_profile *fp, int32_t count,
+				 const int32_t *arr, int32_t bytes)
+  {
+    uint8_t chunk[1024];
+    uint32_t value, prev = 0;
+    int i, n = 0;
+    put32(fp, bytes);
+    for(i = 0; i < count; ++i) {
+      value = dumpi_zigzag((int32_t)((uint32_t)arr[i] - prev));
+      prev = (uint32_t)arr[i];
+      if(n > (int)sizeof(chunk) - 5) {
+	DUMPI_FWRITE(fp, chunk, 1, n);
+	n = 0;
+      }
+      while(value >= 0x80) {
+	chunk[n++] = (uint8_t)(value | 0x80);
+	value >>= 7;
+      }
+      chunk[n++] = (uint8_t)value;
+    }
+    if(n > 0)
+      DUMPI_FWRITE(fp, chunk, 1, n);
+  }
+
+  /**
+   * Utility routine to write an array of 32-bit values.
+   * Uniform, evenly spaced, mostly zero, or slowly varying arrays are
+   * written in whichever compact encoding is smallest.
+   */
   static inline void put32arr(dumpi_profile *fp,
 			      int32_t count, const int32_t *arr)
   {
-    int i;
+    int i, constant = 1, progression = 1;
+    int32_t step, nonzero = 0, varint = 0;
+    size_t best;
+    int tag = 0;
+    if(count < DUMPI_ARRAY_PACK_MIN || arr == NULL) {
+      put32(fp, count);
+      put32block(fp, count, arr);
+      return;
+    }
+    step = (int32_t)((uint32_t)arr[1] - (uint32_t)arr[0]);
+    for(i = 0; i < count; ++i) {
+      if(arr[i] != 0) ++nonzero;
+      if(i > 0) {
+	int32_t delta = (int32_t)((uint32_t)arr[i] - (uint32_t)arr[i-1]);
+	if(delta != 0) constant = 0;
+	if(delta != step) progression = 0;
+	varint += dumpi_varint_size(dumpi_zigzag(delta));
+      }
+      else {
+	varint += dumpi_varint_size(dumpi_zigzag(arr[0]));
+      }
+    }
+    /* Bytes following the length (or the tag) of each form */
+    best = 4*(size_t)count;
+    if(constant) {
+      best = 8;
+      tag = DUMPI_ARRAY_CONSTANT;
+    }
+    else if(progression) {
+      best = 12;
+      tag = DUMPI_ARRAY_PROGRESSION;
+    }
+    if(8 + 8*(size_t)nonzero < best) {
+      best = 8 + 8*(size_t)nonzero;
+      tag = DUMPI_ARRAY_INDEXED;
+    }
+    if(8 + (size_t)varint < best) {
+      best = 8 + (size_t)varint;
+      tag = DUMPI_ARRAY_VARINT;
+    }
+    if(tag == 0) {
+      put32(fp, count);
+      put32block(fp, count, arr);
+      return;
+    }
+    put32(fp, tag);
+    put32(fp, count);
+    switch(tag) {
+    case DUMPI_ARRAY_CONSTANT:
+      put32(fp, arr[0]);
+      break;
+    case DUMPI_ARRAY_PROGRESSION:
+      put32(fp, arr[0]);
+      put32(fp, step);
+      break;
+    case DUMPI_ARRAY_INDEXED:
+      put32(fp, nonzero);
+      for(i = 0; i < count; ++i) {
+	if(arr[i] != 0) {
+	  put32(fp, i);
+	  put32(fp, arr[i]);
+	}
+      }
+      break;
+    case DUMPI_ARRAY_VARINT:
+      put32varint(fp, count, arr, varint);
+      break;
+    }
+  }
+
+  /**
+   * Utility routine to write the summary of an array of counts.
+   * The summary is computed from arr, or taken from stored if arr is NULL
+   * (a record that was read in summarized form).
+   */
+  static inline void put32arr_summary(dumpi_profile *fp,
+				      int32_t count, const int32_t *arr,
+				      const dumpi_int_summary *stored)
+  {
+    dumpi_int_summary summary;
+    if(arr != NULL)
+      dumpi_summarize_counts(count, arr, &summary);
+    else
+      summary = *stored;
+    put32(fp, DUMPI_ARRAY_SUMMARY);
     put32(fp, count);
+    put64(fp, (uint64_t)summary.total);
+    put32(fp, summary.min);
+    put32(fp, summary.max);
+    put32(fp, summary.nonzero);
+  }
+
+  /**
+   * Utility routine to write the entries of an array that are kept
+   * according to dumpi_sparse_keep as index/value pairs.
+   */
+  static inline void put32arr_sparse(dumpi_profile *fp,
+				     int32_t count, const int32_t *arr,
+				     const int32_t *counts)
+  {
+    int i, entries = 0;
+    for(i = 0; i < count; ++i)
+      if(dumpi_sparse_keep(counts, arr, i)) ++entries;
+    put32(fp, DUMPI_ARRAY_SPARSE);
+    put32(fp, count);
+    put32(fp, entries);
     for(i = 0; i < count; ++i) {
-      put32(fp, arr[i]);
+      if(dumpi_sparse_keep(counts, arr, i)) {
+	put32(fp, i);
+	put32(fp, (arr != NULL ? arr[i] : 0));
+      }
     }
   }
 
+  /** Utility routine to record the length of an array that is not stored. */
+  static inline void put32arr_omitted(dumpi_profile *fp, int32_t count) {
+    put32(fp, DUMPI_ARRAY_OMITTED);
+    put32(fp, count);
+  }
+
   /** Utility routine to read an array of characters. */
   static inline void getchararr(dumpi_profile *fp, int32_t *count, char **arr) {
     off_t startpos, endpos;
@@ -282,28 +734,6 @@ extern "C" {
     }
   */
   
-  /** Utility routine to get a 64 bit integer from a binary stream. */
-  static inline uint64_t get64(dumpi_profile *fp) {
-    uint64_t value;
-    uint32_t high32, low32;
-    DUMPI_FREAD(fp, &high32, sizeof(uint32_t), 1);
-    DUMPI_FREAD(fp, &low32, sizeof(uint32_t), 1);
-    /* Pack the high and low values into a 64-bit value). */
-    value = ntohl(high32);
-    value <<= 32;
-    value |= ntohl(low32);
-    return value;
-  }
-
-  /** Utility routine to write a 64 bit integer to a binary stream. */
-  static inline void put64(dumpi_profile *fp, uint64_t value) {
-    uint32_t high32, low32;
-    high32 = htonl((uint32_t)(value >> 32));
-    low32  = htonl((uint32_t)(value));
-    DUMPI_FWRITE(fp, &high32, sizeof(uint32_t), 1);
-    DUMPI_FWRITE(fp, &low32,  sizeof(uint32_t), 1);
-  }
-
   /** Utility routine to store a single request value */
   static inline void put_single_request(dumpi_profile *fp,
 					dumpi_request request)
@@ -338,13 +768,39 @@ extern "C" {
       (*req)[i] = get_single_request(fp);
   }
 
+  /**
+   * The number of MPI function labels (the value of DUMPI_ALL_FUNCTIONS)
+   * in streams of the given version.  New functions are added right
+   * before the sentinel, which moves the labels that follow it.
+   */
+  static inline int dumpi_stream_functions(const char version[3]) {
+    if(! dumpi_have_version(version, 1, 1, 7))
+      return DUMPI_Ibarrier;
+    if(! dumpi_have_version(version, 1, 1, 8))
+      return DUMPI_Dist_graph_create_adjacent;
+    return DUMPI_ALL_FUNCTIONS;
+  }
+
   /** Read the token for next function. */
   static inline dumpi_function dumpi_read_next_function(dumpi_profile *profile) 
   {
+    int functions = dumpi_stream_functions(profile->version);
     uint16_t next = get16(profile);
     /*fprintf(stderr, "Encountered function label %d at offset 0x%llx\n",
               (int)next, (long long)DUMPI_READ_TELL(profile));*/
-    assert(next <= DUMPI_END_OF_STREAM);  
+    /* Streams older than 1.1.7 (and 1.1.8) had fewer MPI functions before
+     * the sentinel, so everything from the sentinel on moves up. */
+    if(next >= functions)
+      next += DUMPI_ALL_FUNCTIONS - functions;
+    /* Streams older than 1.1.2 ended one label earlier. */
+    if(next == DUMPI_Poll_summary &&
+       !dumpi_have_version(profile->version, 1, 1, 2))
+      next = DUMPI_END_OF_STREAM;
+    /* ...and streams from 1.1.2 up to 1.1.6 ended one label earlier still. */
+    else if(next == DUMPI_Function_call &&
+	    !dumpi_have_version(profile->version, 1, 1, 6))
+      next = DUMPI_END_OF_STREAM;
+    assert(next <= DUMPI_END_OF_STREAM);
     if(next != DUMPI_ALL_FUNCTIONS)
       return ((dumpi_function)next);
     return (dumpi_function)NULL;
@@ -372,6 +828,8 @@ extern "C" {
       mask |= DUMPI_PERFINFO_MASK;
     /* Added to output thread index. */
     mask |= DUMPI_THREADID_MASK;
+    if(profile->callsite)
+      mask |= DUMPI_CALLSITE_MASK;
     put8(profile, mask);
   }
 
@@ -428,6 +886,10 @@ extern "C" {
       wall->start.nsec = get32(profile);
       wall->stop.sec   = get16(profile) + profile->wall_time_offset;
       wall->stop.nsec  = get32(profile);
+      if(profile->wall_sync) {
+	dumpi_clock_sync_apply(profile->wall_sync, &wall->start);
+	dumpi_clock_sync_apply(profile->wall_sync, &wall->stop);
+      }
     }
     else {
       wall->start.sec = wall->start.nsec = 0;
@@ -525,9 +987,22 @@ extern "C" {
         int i;
         put32(profile, count);
         for(i = 0; i < count; ++i) {
-          put32(profile, statuses[i].bytes);
-          put32(profile, statuses[i].source);
-          put8(profile, statuses[i].cancelled);
+          if(statuses[i].cancelled == DUMPI_STATUS_DEFERRED) {
+            /* Placeholders get patched before the buffer is flushed */
+            assert(profile->defer_status != NULL);
+            put32(profile, 0);
+            profile->defer_status(profile, statuses+i, DUMPI_STATUS_BYTES,
+                                  dumpi_membuf_pos(profile) - 4);
+            put32(profile, statuses[i].source);
+            put8(profile, 0);
+            profile->defer_status(profile, statuses+i, DUMPI_STATUS_CANCELLED,
+                                  dumpi_membuf_pos(profile) - 1);
+          }
+          else {
+            put32(profile, statuses[i].bytes);
+            put32(profile, statuses[i].source);
+            put8(profile, statuses[i].cancelled);
+          }
           put8(profile, statuses[i].error);
 	  /* There was a mistake in versions prior to 0.6.3 where
 	   * the tag associated with a status wasn't being saved/restored */
@@ -578,6 +1053,7 @@ extern "C" {
 #define STARTWRITE(PROFILE, LABEL)					\
   assert(val && profile);                                               \
   if(output->function[LABEL]) {                                         \
+    if((PROFILE)->ring) dumpi_membuf_ring_mark(PROFILE);                \
     if(dumpi_debug & DUMPI_DEBUG_TRACEIO) {                             \
       fprintf(stderr, "[DUMPI-IO] Writing record for " #LABEL           \
               " at offset 0x%llx\n",					\
@@ -586,6 +1062,7 @@ extern "C" {
     put_function_label(PROFILE, LABEL);					\
     put_config_mask(PROFILE, perf, output);				\
     put16(PROFILE, thread);						\
+    if((PROFILE)->callsite) put32(PROFILE, (PROFILE)->callsite);	\
     put_times(PROFILE, cpu, wall, output->timestamps);			\
     put_perfinfo(PROFILE, perf, output);
 
@@ -621,6 +1098,8 @@ extern "C" {
   config_mask = get_config_mask(PROFILE);                               \
   if(config_mask & DUMPI_THREADID_MASK)                                 \
     *thread = get16(profile);						\
+  PROFILE->callsite = ((config_mask & DUMPI_CALLSITE_MASK) ?		\
+		       get32(PROFILE) : 0);				\
   get_times(PROFILE, cpu, wall, config_mask);				\
   get_perfinfo(PROFILE, perf, config_mask);
 
@@ -822,11 +1301,142 @@ void do_get_char_array_2(dumpi_profile *profile, int *len0, int *len1,
       PUT_DUMPI_DATATYPE(PROFILE, VALUE[i0]);			\
   } while(0)
 #define GET_DUMPI_DATATYPE_ARRAY_1(PROFILE, LEN, VALUE) do {		\
-    int i0;                                                             \
-    LEN = get32(PROFILE);						\
-    VALUE = (dumpi_datatype*)calloc((LEN)+1, sizeof(dumpi_datatype));   \
-    for(i0 = 0; i0 < LEN; ++i0)                                         \
-      VALUE[i0] = GET_DUMPI_DATATYPE(PROFILE);				\
+    int32_t len0;							\
+    get_datatype_arr(PROFILE, &len0, &(VALUE));				\
+    LEN = len0;								\
+  } while(0)
+
+  /**
+   * Read a datatype array in any of its stored forms (plain, sparse, or
+   * constant); the array is always expanded to its full length.
+   */
+  static inline void get_datatype_arr(dumpi_profile *fp, int32_t *count,
+				      dumpi_datatype **arr)
+  {
+    int i, entries, index;
+    dumpi_datatype value;
+    int32_t tag = get32(fp);
+    if(tag >= 0) {
+      *count = tag;
+      *arr = (dumpi_datatype*)calloc(*count+1, sizeof(dumpi_datatype));
+      for(i = 0; i < *count; ++i)
+	(*arr)[i] = GET_DUMPI_DATATYPE(fp);
+      return;
+    }
+    *count = get32(fp);
+    *arr = (dumpi_datatype*)calloc(*count+1, sizeof(dumpi_datatype));
+    switch(tag) {
+    case DUMPI_ARRAY_SPARSE:
+      entries = get32(fp);
+      for(i = 0; i < entries; ++i) {
+	index = get32(fp);
+	assert(index >= 0 && index < *count);
+	(*arr)[index] = GET_DUMPI_DATATYPE(fp);
+      }
+      break;
+    case DUMPI_ARRAY_CONSTANT:
+      value = GET_DUMPI_DATATYPE(fp);
+      for(i = 0; i < *count; ++i)
+	(*arr)[i] = value;
+      break;
+    default:
+      fprintf(stderr, "get_datatype_arr:  Invalid array tag %d at offset "
+	      "0x%llx\n", (int)tag, (long long)DUMPI_READ_TELL(fp));
+      abort();
+    }
+  }
+
+  /**
+   * Find the datatype shared by all entries kept according to
+   * dumpi_sparse_keep.
+   * \return 0 if the kept entries use more than one datatype.
+   */
+  static inline int dumpi_uniform_datatype(int32_t count,
+					   const dumpi_datatype *arr,
+					   const int32_t *counts,
+					   dumpi_datatype *type)
+  {
+    int i, found = 0;
+    *type = (count > 0 ? arr[0] : 0);
+    for(i = 0; i < count; ++i) {
+      if(counts != NULL && counts[i] == 0)
+	continue;
+      if(found && arr[i] != *type)
+	return 0;
+      *type = arr[i];
+      found = 1;
+    }
+    return 1;
+  }
+
+  /** Write the datatypes of the peers with a non-zero count. */
+  static inline void put_datatype_arr_sparse(dumpi_profile *fp, int32_t count,
+					     const dumpi_datatype *arr,
+					     const int32_t *counts)
+  {
+    int i, entries = 0;
+    for(i = 0; i < count; ++i)
+      if(counts == NULL || counts[i] != 0) ++entries;
+    put32(fp, DUMPI_ARRAY_SPARSE);
+    put32(fp, count);
+    put32(fp, entries);
+    for(i = 0; i < count; ++i) {
+      if(counts == NULL || counts[i] != 0) {
+	put32(fp, i);
+	PUT_DUMPI_DATATYPE(fp, arr[i]);
+      }
+    }
+  }
+
+  /** Write a datatype array whose (kept) entries share one value. */
+  static inline void put_datatype_arr_constant(dumpi_profile *fp,
+					       int32_t count,
+					       dumpi_datatype value)
+  {
+    put32(fp, DUMPI_ARRAY_CONSTANT);
+    put32(fp, count);
+    PUT_DUMPI_DATATYPE(fp, value);
+  }
+
+  /**
+   * Write an array of per-peer counts at the given detail level.
+   */
+#define PUT_INT_COUNTS(PROFILE, DETAIL, LEN, VALUE, SUMMARY) do {	\
+    switch(DETAIL) {							\
+    case DUMPI_DETAIL_SUMMARIZED:					\
+      put32arr_summary(PROFILE, LEN, VALUE, &(SUMMARY));		\
+      break;								\
+    case DUMPI_DETAIL_SPARSE:						\
+      put32arr_sparse(PROFILE, LEN, VALUE, NULL);			\
+      break;								\
+    default:								\
+      put32arr(PROFILE, LEN, VALUE);					\
+    }									\
+  } while(0)
+
+  /**
+   * Write an array of per-peer displacements at the given detail level.
+   * COUNTS is the matching count array (NULL if it was not stored).
+   */
+#define PUT_INT_DISPLS(PROFILE, DETAIL, LEN, VALUE, COUNTS) do {	\
+    switch(DETAIL) {							\
+    case DUMPI_DETAIL_SUMMARIZED:					\
+      put32arr_omitted(PROFILE, LEN);					\
+      break;								\
+    case DUMPI_DETAIL_SPARSE:						\
+      put32arr_sparse(PROFILE, LEN, VALUE, COUNTS);			\
+      break;								\
+    default:								\
+      put32arr(PROFILE, LEN, VALUE);					\
+    }									\
+  } while(0)
+
+  /**
+   * Read an array of per-peer counts in any stored form.
+   * Sets DETAIL to the detail level the array was stored with.
+   */
+#define GET_INT_COUNTS(PROFILE, DETAIL, LEN, VALUE, SUMMARY) do {	\
+    DETAIL = get32arr_detail(PROFILE, &(LEN), &(VALUE), &(SUMMARY));	\
   } while(0)
 
 #define PUT_DUMPI_DEST(PROFILE, VALUE) PUT_INT(PROFILE, VALUE)
@@ -925,6 +1535,9 @@ void do_get_char_array_2(dumpi_profile *profile, int *len0, int *len1,
 #define GET_DUMPI_REQUEST_ARRAY_1(PROFILE, TERM, VALUE) \
   GET_INT_ARRAY_1(PROFILE, TERM, VALUE)
 
+#define PUT_DUMPI_MESSAGE(PROFILE, VALUE) PUT_INT(PROFILE, VALUE)
+#define GET_DUMPI_MESSAGE(PROFILE) GET_INT(PROFILE)
+
 #define PUT_DUMPI_SOURCE(PROFILE, VALUE) PUT_INT(PROFILE, VALUE)
 #define GET_DUMPI_SOURCE(PROFILE) GET_INT(PROFILE)
 
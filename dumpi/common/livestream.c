@@ -0,0 +1,57 @@
+/*
+ *  This file is part of DUMPI:
+ *               The MPI profiling library from the SST suite.
+ *  Copyright (c) 2009-2011 Sandia Corporation.
+ *  This software is distributed under the BSD License.
+ *  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+ *  the U.S. Government retains certain rights in this software.
+ *  For more information, see the LICENSE file in the top
+ *  SST/macroscale directory.
+ */
+
+#include <dumpi/common/livestream.h>
+#include <string.h>
+#include <arpa/inet.h>
+
+static void pack32(unsigned char *buf, uint32_t value) {
+  value = htonl(value);
+  memcpy(buf, &value, sizeof(uint32_t));
+}
+
+static void pack64(unsigned char *buf, uint64_t value) {
+  pack32(buf, (uint32_t)(value >> 32));
+  pack32(buf + 4, (uint32_t)value);
+}
+
+static uint32_t unpack32(const unsigned char *buf) {
+  uint32_t value;
+  memcpy(&value, buf, sizeof(uint32_t));
+  return ntohl(value);
+}
+
+static uint64_t unpack64(const unsigned char *buf) {
+  return ((uint64_t)unpack32(buf) << 32) | unpack32(buf + 4);
+}
+
+void dumpi_frame_pack(unsigned char *buf, const dumpi_frame *frame) {
+  pack32(buf, DUMPI_FRAME_MAGIC);
+  pack32(buf + 4, ((uint32_t)frame->type << 16) | frame->flags);
+  pack32(buf + 8, (uint32_t)frame->rank);
+  pack32(buf + 12, frame->length);
+  pack64(buf + 16, frame->seq);
+  pack64(buf + 24, frame->offset);
+}
+
+int dumpi_frame_unpack(const unsigned char *buf, dumpi_frame *frame) {
+  uint32_t kind;
+  if(unpack32(buf) != DUMPI_FRAME_MAGIC)
+    return 0;
+  kind = unpack32(buf + 4);
+  frame->type = (uint16_t)(kind >> 16);
+  frame->flags = (uint16_t)kind;
+  frame->rank = (int32_t)unpack32(buf + 8);
+  frame->length = unpack32(buf + 12);
+  frame->seq = unpack64(buf + 16);
+  frame->offset = unpack64(buf + 24);
+  return 1;
+}
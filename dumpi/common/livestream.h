@@ -0,0 +1,94 @@
+/*
+ *  This file is part of DUMPI:
+ *               The MPI profiling library from the SST suite.
+ *  Copyright (c) 2009-2011 Sandia Corporation.
+ *  This software is distributed under the BSD License.
+ *  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+ *  the U.S. Government retains certain rights in this software.
+ *  For more information, see the LICENSE file in the top
+ *  SST/macroscale directory.
+ */
+
+#ifndef DUMPI_COMMON_LIVESTREAM_H
+#define DUMPI_COMMON_LIVESTREAM_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* ! __cplusplus */
+
+  /**
+   * \ingroup common
+   * \defgroup common_livestream common/livestream:  Frames used to stream \
+   *    traces to a collector while the run goes (stream-to in dumpi.conf).
+   *
+   * Each rank sends its trace stream (the bytes that would otherwise go
+   * to its trace file) as a sequence of frames.  A frame is a header of
+   * DUMPI_FRAME_HEADER bytes, big-endian:
+   *
+   *   - DUMPI_FRAME_MAGIC (32 bits)
+   *   - type (16 bits) and flags (16 bits)
+   *   - rank (32 bits)
+   *   - payload length (32 bits)
+   *   - sequence number:  frames sent by the rank before this one (64 bits)
+   *   - stream offset of the payload (64 bits)
+   *
+   * followed by the payload.  The first frame of a rank is an OPEN frame
+   * (see dumpi_frame_open), the last a CLOSE frame.
+   */
+  /*@{*/
+
+  /** "DSTR" */
+#define DUMPI_FRAME_MAGIC 0x44535452
+
+  /** Size of a packed frame header */
+#define DUMPI_FRAME_HEADER 32
+
+  /** Kinds of frames */
+  typedef enum dumpi_frame_type {
+    DUMPI_FRAME_OPEN = 1,   /**< Start of a stream (payload: dumpi_frame_open) */
+    DUMPI_FRAME_DATA,       /**< Bytes of the stream */
+    DUMPI_FRAME_CLOSE       /**< End of the stream (no payload) */
+  } dumpi_frame_type;
+
+  /**
+   * Flag on an OPEN frame at the start of a frames file written after
+   * the collector went away:  the stream continues (at the offset of
+   * the frame) rather than starts over.
+   */
+#define DUMPI_FRAME_RESUME 1
+
+  /** A frame header. */
+  typedef struct dumpi_frame {
+    uint16_t type;
+    uint16_t flags;
+    int32_t  rank;
+    uint32_t length;
+    uint64_t seq;
+    uint64_t offset;
+  } dumpi_frame;
+
+  /**
+   * The payload of an OPEN frame:  the dumpi version (3 bytes), one byte
+   * of padding, the number of ranks (32 bits), and the file root of the
+   * run (the remaining bytes, not NUL-terminated).
+   */
+#define DUMPI_FRAME_OPEN_FIXED 8
+
+  /** Pack a frame header into DUMPI_FRAME_HEADER bytes. */
+  void dumpi_frame_pack(unsigned char *buf, const dumpi_frame *frame);
+
+  /**
+   * Unpack a frame header.
+   * \return 0 if the header does not start with the magic.
+   */
+  int dumpi_frame_unpack(const unsigned char *buf, dumpi_frame *frame);
+
+  /*@}*/
+
+#ifdef __cplusplus
+} /* end of extern "C" */
+#endif /* ! __cplusplus */
+
+#endif /* ! DUMPI_COMMON_LIVESTREAM_H */
@@ -0,0 +1,312 @@
+/*
+ *  This file is part of DUMPI:
+ *               The MPI profiling library from the SST suite.
+ *  Copyright (c) 2009-2011 Sandia Corporation.
+ *  This software is distributed under the BSD License.
+ *  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+ *  the U.S. Government retains certain rights in this software.
+ *  For more information, see the LICENSE file in the top
+ *  SST/macroscale directory.
+ */
+
+/* fopencookie */
+#define _GNU_SOURCE 1
+#include <dumpi/common/nodefile.h>
+#include <dumpi/dumpiconfig.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <errno.h>
+#include <assert.h>
+#include <arpa/inet.h>
+
+#define DUMPI_NODE_MAGIC ((((uint64_t)(0xffaadd44))<<32) | 0x4e4f4445)
+
+/* Size of the stdio buffer of a node file being written.  Chunks are
+ * usually much larger; this only gathers up the small ones. */
+#ifndef DUMPI_NODEFILE_BUFFER
+#define DUMPI_NODEFILE_BUFFER (1 << 20)
+#endif /* ! DUMPI_NODEFILE_BUFFER */
+
+/* A run of chunks from one rank. */
+typedef struct nodefile_entry {
+  int32_t  rank;
+  uint64_t length;
+  uint64_t offset;
+} nodefile_entry;
+
+struct dumpi_nodefile {
+  FILE           *file;
+  char           *buffer;
+  uint64_t        offset;
+  nodefile_entry *entry;
+  size_t          count, capacity;
+};
+
+static void write64(FILE *file, uint64_t value) {
+  uint32_t half[2];
+  half[0] = htonl((uint32_t)(value >> 32));
+  half[1] = htonl((uint32_t)value);
+  if(fwrite(half, sizeof(uint32_t), 2, file) != 2) {
+    fprintf(stderr, "dumpi_nodefile:  Write failed: %s\n", strerror(errno));
+    abort();
+  }
+}
+
+static int read64(FILE *file, uint64_t *value) {
+  uint32_t half[2];
+  if(fread(half, sizeof(uint32_t), 2, file) != 2)
+    return 0;
+  *value = ((uint64_t)ntohl(half[0]) << 32) | ntohl(half[1]);
+  return 1;
+}
+
+dumpi_nodefile* dumpi_nodefile_create(const char *fname) {
+  dumpi_nodefile *nf;
+  FILE *file = fopen(fname, "w");
+  if(file == NULL) {
+    fprintf(stderr, "dumpi_nodefile_create:  Failed to open \"%s\": %s\n",
+	    fname, strerror(errno));
+    return NULL;
+  }
+  nf = (dumpi_nodefile*)calloc(1, sizeof(dumpi_nodefile));
+  assert(nf != NULL);
+  nf->file = file;
+  nf->buffer = (char*)malloc(DUMPI_NODEFILE_BUFFER);
+  if(nf->buffer != NULL)
+    setvbuf(file, nf->buffer, _IOFBF, DUMPI_NODEFILE_BUFFER);
+  write64(file, DUMPI_NODE_MAGIC);
+  nf->offset = sizeof(uint64_t);
+  return nf;
+}
+
+void dumpi_nodefile_append(dumpi_nodefile *nf, int rank,
+			   const void *data, size_t bytes)
+{
+  nodefile_entry *last;
+  assert(nf != NULL);
+  if(bytes == 0)
+    return;
+  if(fwrite(data, 1, bytes, nf->file) != bytes) {
+    fprintf(stderr, "dumpi_nodefile:  Write failed: %s\n", strerror(errno));
+    abort();
+  }
+  /* Consecutive chunks from the same rank share an entry */
+  last = (nf->count > 0 ? &nf->entry[nf->count-1] : NULL);
+  if(last != NULL && last->rank == rank)
+    last->length += bytes;
+  else {
+    if(nf->count == nf->capacity) {
+      nf->capacity = (nf->capacity ? 2*nf->capacity : 256);
+      nf->entry = (nodefile_entry*)realloc(nf->entry, nf->capacity *
+					   sizeof(nodefile_entry));
+      assert(nf->entry != NULL);
+    }
+    last = &nf->entry[nf->count++];
+    last->rank = rank;
+    last->length = bytes;
+    last->offset = nf->offset;
+  }
+  nf->offset += bytes;
+}
+
+void dumpi_nodefile_close(dumpi_nodefile *nf) {
+  size_t i;
+  uint32_t rank;
+  assert(nf != NULL);
+  for(i = 0; i < nf->count; ++i) {
+    rank = htonl((uint32_t)nf->entry[i].rank);
+    if(fwrite(&rank, sizeof(uint32_t), 1, nf->file) != 1) {
+      fprintf(stderr, "dumpi_nodefile:  Write failed: %s\n", strerror(errno));
+      abort();
+    }
+    write64(nf->file, nf->entry[i].length);
+    write64(nf->file, nf->entry[i].offset);
+  }
+  write64(nf->file, nf->count);
+  write64(nf->file, nf->offset);
+  write64(nf->file, DUMPI_NODE_MAGIC);
+  if(fclose(nf->file) != 0) {
+    fprintf(stderr, "dumpi_nodefile:  Close failed: %s\n", strerror(errno));
+    abort();
+  }
+  free(nf->buffer);
+  free(nf->entry);
+  free(nf);
+}
+
+#ifdef DUMPI_HAVE_FOPENCOOKIE
+
+/* A chunk of the stream of one rank (start is the stream offset). */
+typedef struct segment_chunk {
+  uint64_t start, length, offset;
+} segment_chunk;
+
+/* Read state for the stream of one rank. */
+typedef struct segment_reader {
+  FILE          *file;
+  segment_chunk *chunk;
+  size_t         count, current;
+  uint64_t       length, pos;
+  /* Where the node file is positioned (to skip needless seeks) */
+  uint64_t       filepos;
+} segment_reader;
+
+/* Find the chunk holding pos (pos < length). */
+static size_t find_chunk(const segment_reader *seg, uint64_t pos) {
+  size_t lo = 0, hi = seg->count;
+  const segment_chunk *cur = &seg->chunk[seg->current];
+  if(pos >= cur->start && pos < cur->start + cur->length)
+    return seg->current;
+  while(hi - lo > 1) {
+    size_t mid = (lo + hi) / 2;
+    if(seg->chunk[mid].start <= pos)
+      lo = mid;
+    else
+      hi = mid;
+  }
+  return lo;
+}
+
+static ssize_t segment_read(void *cookie, char *buf, size_t size) {
+  segment_reader *seg = (segment_reader*)cookie;
+  size_t done = 0, want, got;
+  uint64_t filepos;
+  const segment_chunk *chunk;
+  while(done < size && seg->pos < seg->length) {
+    seg->current = find_chunk(seg, seg->pos);
+    chunk = &seg->chunk[seg->current];
+    filepos = chunk->offset + (seg->pos - chunk->start);
+    if(filepos != seg->filepos) {
+      if(fseeko(seg->file, filepos, SEEK_SET) != 0)
+	return -1;
+      seg->filepos = filepos;
+    }
+    want = size - done;
+    if(want > chunk->start + chunk->length - seg->pos)
+      want = chunk->start + chunk->length - seg->pos;
+    got = fread(buf + done, 1, want, seg->file);
+    seg->filepos += got;
+    seg->pos += got;
+    done += got;
+    if(got < want)
+      return (ferror(seg->file) ? -1 : (ssize_t)done);
+  }
+  return done;
+}
+
+static int segment_seek(void *cookie, off64_t *offset, int whence) {
+  segment_reader *seg = (segment_reader*)cookie;
+  int64_t pos;
+  switch(whence) {
+  case SEEK_SET: pos = *offset; break;
+  case SEEK_CUR: pos = (int64_t)seg->pos + *offset; break;
+  case SEEK_END: pos = (int64_t)seg->length + *offset; break;
+  default: return -1;
+  }
+  if(pos < 0)
+    return -1;
+  seg->pos = pos;
+  *offset = pos;
+  return 0;
+}
+
+static int segment_close(void *cookie) {
+  segment_reader *seg = (segment_reader*)cookie;
+  int status = fclose(seg->file);
+  free(seg->chunk);
+  free(seg);
+  return status;
+}
+
+/* Read the directory entries of one rank. */
+static int read_directory(segment_reader *seg, int rank) {
+  uint64_t magic, count, diroffset, length, offset, i;
+  uint32_t entry_rank;
+  size_t capacity = 0;
+  if(! read64(seg->file, &magic) || magic != DUMPI_NODE_MAGIC)
+    return 0;
+  if(fseeko(seg->file, -3*(off_t)sizeof(uint64_t), SEEK_END) != 0 ||
+     ! read64(seg->file, &count) || ! read64(seg->file, &diroffset) ||
+     ! read64(seg->file, &magic) || magic != DUMPI_NODE_MAGIC ||
+     fseeko(seg->file, diroffset, SEEK_SET) != 0)
+    return 0;
+  for(i = 0; i < count; ++i) {
+    if(fread(&entry_rank, sizeof(uint32_t), 1, seg->file) != 1 ||
+       ! read64(seg->file, &length) || ! read64(seg->file, &offset))
+      return 0;
+    if((int)ntohl(entry_rank) != rank)
+      continue;
+    if(seg->count == capacity) {
+      capacity = (capacity ? 2*capacity : 64);
+      seg->chunk = (segment_chunk*)realloc(seg->chunk,
+					   capacity * sizeof(segment_chunk));
+      assert(seg->chunk != NULL);
+    }
+    seg->chunk[seg->count].start = seg->length;
+    seg->chunk[seg->count].length = length;
+    seg->chunk[seg->count].offset = offset;
+    ++seg->count;
+    seg->length += length;
+  }
+  return 1;
+}
+
+DUMPIFILE dumpi_nodefile_open(const char *name) {
+  static const cookie_io_functions_t funcs = {
+    segment_read, NULL, segment_seek, segment_close
+  };
+  const char *at = strrchr(name, '@');
+  char *fname, *end;
+  long rank;
+  segment_reader *seg;
+  FILE *file, *stream;
+  if(at == NULL || at[1] == '\0') {
+    errno = ENOENT;
+    return NULL;
+  }
+  rank = strtol(at+1, &end, 10);
+  if(*end != '\0' || rank < 0) {
+    errno = ENOENT;
+    return NULL;
+  }
+  fname = strndup(name, at - name);
+  assert(fname != NULL);
+  file = fopen(fname, "r");
+  free(fname);
+  if(file == NULL)
+    return NULL;
+  seg = (segment_reader*)calloc(1, sizeof(segment_reader));
+  assert(seg != NULL);
+  seg->file = file;
+  if(! read_directory(seg, (int)rank)) {
+    fprintf(stderr, "dumpi_nodefile_open:  \"%s\" is not a valid node file "
+	    "(it may be truncated).\n", name);
+    segment_close(seg);
+    errno = EIO;
+    return NULL;
+  }
+  if(seg->count == 0) {
+    segment_close(seg);
+    errno = ENOENT;
+    return NULL;
+  }
+  seg->filepos = (uint64_t)-1;
+  stream = fopencookie(seg, "r", funcs);
+  if(stream == NULL)
+    segment_close(seg);
+  return stream;
+}
+
+#else /* ! DUMPI_HAVE_FOPENCOOKIE */
+
+DUMPIFILE dumpi_nodefile_open(const char *name) {
+  if(strrchr(name, '@') != NULL)
+    fprintf(stderr, "dumpi_nodefile_open:  Cannot open \"%s\":  reading node "
+	    "files needs fopencookie()\n", name);
+  errno = ENOSYS;
+  return NULL;
+}
+
+#endif /* ! DUMPI_HAVE_FOPENCOOKIE */
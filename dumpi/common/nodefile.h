@@ -0,0 +1,79 @@
+/*
+ *  This file is part of DUMPI:
+ *               The MPI profiling library from the SST suite.
+ *  Copyright (c) 2009-2011 Sandia Corporation.
+ *  This software is distributed under the BSD License.
+ *  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+ *  the U.S. Government retains certain rights in this software.
+ *  For more information, see the LICENSE file in the top
+ *  SST/macroscale directory.
+ */
+
+#ifndef DUMPI_COMMON_NODEFILE_H
+#define DUMPI_COMMON_NODEFILE_H
+
+#include <dumpi/common/types.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* ! __cplusplus */
+
+  /**
+   * \ingroup common
+   * \defgroup common_nodefile common/nodefile:  The traces of all ranks \
+   *    on a node in one file (node-files in dumpi.conf).
+   *
+   * A node file holds the trace streams of the ranks on one node, cut
+   * into chunks and stored in the order the chunks arrived:
+   *
+   *   - DUMPI_NODE_MAGIC (64 bits)
+   *   - the chunks
+   *   - the directory:  for each run of chunks from one rank, the rank
+   *     (32 bits), the length (64 bits), and the file offset (64 bits)
+   *   - the number of directory entries (64 bits), the offset of the
+   *     directory (64 bits), and DUMPI_NODE_MAGIC again
+   *
+   * All numbers are big-endian, as in the trace files.  The stream of
+   * a rank is the concatenation of its chunks; it is a regular trace
+   * (offsets in its index are relative to the start of the stream), and
+   * is opened as "nodefile@rank" (see dumpi_nodefile_open).
+   */
+  /*@{*/
+
+  /** Writer state for a node file. */
+  typedef struct dumpi_nodefile dumpi_nodefile;
+
+  /**
+   * Create a node file.
+   * \return NULL (with a message on stderr) if the file cannot be opened.
+   */
+  dumpi_nodefile* dumpi_nodefile_create(const char *fname);
+
+  /**
+   * Append the next chunk of the stream of the given rank.
+   */
+  void dumpi_nodefile_append(dumpi_nodefile *nf, int rank,
+			     const void *data, size_t bytes);
+
+  /**
+   * Write the directory and close the node file.
+   */
+  void dumpi_nodefile_close(dumpi_nodefile *nf);
+
+  /**
+   * Open the stream of one rank for reading.  The name is the node file
+   * name followed by '@' and the rank (e.g. dumpi-2011.03.17-node0002.bin@37).
+   * The returned stream reads and seeks within the stream of that rank.
+   * \return NULL if name is not of this form or the rank has no stream
+   *         in the node file (errno is set).
+   */
+  DUMPIFILE dumpi_nodefile_open(const char *name);
+
+  /*@}*/
+
+#ifdef __cplusplus
+} /* end of extern "C" */
+#endif /* ! __cplusplus */
+
+#endif /* ! DUMPI_COMMON_NODEFILE_H */
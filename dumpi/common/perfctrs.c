@@ -10,8 +10,10 @@
  */
 
 #include <dumpi/common/perfctrs.h>
+#include <dumpi/common/perfevent.h>
 #include <dumpi/dumpiconfig.h>
 #include <assert.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -19,6 +21,18 @@
 #include <pthread.h>
 #endif /* ! DUMPI_USE_PTHREADS */
 
+/* The counters kept by dumpi_init_perfctrs, for every backend */
+static dumpi_perfctr_backend backend_ =
+#ifdef DUMPI_HAVE_PAPI
+  DUMPI_PERFCTR_PAPI;
+#else /* ! DUMPI_HAVE_PAPI */
+  DUMPI_PERFCTR_PERF_EVENT;
+#endif /* ! DUMPI_HAVE_PAPI */
+static int active_counters_ = 0;
+static dumpi_perflabel_t *labels_ = NULL;
+
+#define DUMPI_MIN(A, B) (((A) < (B)) ? (A) : (B))
+
 #ifdef DUMPI_HAVE_PAPI
 
 #include <papi.h>
@@ -28,9 +42,7 @@
  */
 typedef long long dumpi_papi_accum_t;
 
-static int active_counters_ = 0;
 static int *papi_code_ = NULL;
-static dumpi_perflabel_t *papi_label_ = NULL;
 
 #ifdef DUMPI_USE_PTHREADS
 static pthread_key_t *accum_key_ = NULL;
@@ -38,16 +50,6 @@ static pthread_key_t *accum_key_ = NULL;
 static dumpi_papi_accum_t *accum_global_ = NULL;
 #endif /* ! DUMPI_USE_PTHREADS */
 
-#define DUMPI_MIN(A, B) (((A) < (B)) ? (A) : (B))
-
-#ifdef DUMPI_USE_PTHREADS
-#define DUMPI_LOCK_MUTEX   assert(pthread_mutex_lock(mutex) == 0)
-#define DUMPI_UNLOCK_MUTEX assert(pthread_mutex_unlock(mutex) == 0)
-#else /* ! DUMPI_USE_PTHREADS */
-#define DUMPI_LOCK_MUTEX
-#define DUMPI_UNLOCK_MUTEX
-#endif /* ! DUMPI_USE_PTHREADS */
-
 /* Initialize accumulators for the current thread */
 static inline dumpi_papi_accum_t* get_accumulators(void) {
 #ifdef DUMPI_USE_PTHREADS
@@ -84,13 +86,10 @@ static inline dumpi_papi_accum_t* get_accumulators(void) {
 #endif /* ! DUMPI_USE_PTHREADS */
 }
 
-int dumpi_init_perfctrs(dumpi_perfinfo *ctrs) {
+static int papi_init_perfctrs(const dumpi_perfinfo *ctrs) {
   int i, ret, count, maxcount;
   char errstr[PAPI_MAX_STR_LEN+1]; errstr[PAPI_MAX_STR_LEN] = '\0';
-  /* Check input arguments checking and set up */
-  assert(ctrs != NULL);
   count = ctrs->count;
-  active_counters_ = 0;
   dumpi_init_perfctr_tags();
   /* Initialize PAPI.  Return 0 if PAPI fails. */
   ret = PAPI_library_init(PAPI_VER_CURRENT);
@@ -104,8 +103,7 @@ int dumpi_init_perfctrs(dumpi_perfinfo *ctrs) {
   /* Allocate storage */
   maxcount = DUMPI_MIN(PAPI_num_counters(), DUMPI_MAX_PERFCTRS);
   papi_code_ = (int*)calloc(maxcount, sizeof(int));
-  papi_label_ = (dumpi_perflabel_t*)calloc(maxcount, sizeof(dumpi_perflabel_t));
-  assert(papi_code_ != NULL && papi_label_ != NULL);
+  assert(papi_code_ != NULL);
   if(maxcount <= 0) {
     fprintf(stderr, "dumpi_init_perfctrs:  No PAPI counters available\n");
     return 0;
@@ -123,7 +121,7 @@ int dumpi_init_perfctrs(dumpi_perfinfo *ctrs) {
 	continue;
       }
       papi_code_[active_counters_] = event_code;
-      strcpy(papi_label_[active_counters_], ctrs->counter_tag[i]);
+      strcpy(labels_[active_counters_], ctrs->counter_tag[i]);
       ++active_counters_;
     }
     else {
@@ -136,67 +134,89 @@ int dumpi_init_perfctrs(dumpi_perfinfo *ctrs) {
   return (get_accumulators() != NULL);
 }
 
-void dumpi_get_perfctrs(const dumpi_profile *profile, dumpi_perfinfo *perf,
-			dumpi_perfinfo_direction direction)
-{
+static void papi_get_perfctrs(int64_t *values) {
   int i;
-  dumpi_papi_accum_t *accum;  
-  int64_t *active_ctr = (direction == DUMPI_PERFCTR_IN ?
-			 perf->invalue : perf->outvalue);
-  (void)profile;
-  if(active_counters_ > 0) {
-    assert((accum = get_accumulators()) != NULL);
-    perf->count = active_counters_;
-    if(active_counters_) {
-      PAPI_accum_counters(accum, active_counters_);
-      for(i = 0; i < active_counters_; ++i) {
-	/* THIS NEEDS TO BE FIXED */
-	strncpy(perf->counter_tag[i], papi_label_[i], DUMPI_MAX_PERFCTR_NAME-1);
-	perf->counter_tag[i][DUMPI_MAX_PERFCTR_NAME-1] = '\0';
-	active_ctr[i] = accum[i];
-      }
-    }
-  }
-  else {
-    perf->count = 0;
-  }
-}
-
-/**
- * How many perfcounters are currently active?
- */
-size_t dumpi_active_perfctrs(void) {
-  return active_counters_;
+  dumpi_papi_accum_t *accum;
+  assert((accum = get_accumulators()) != NULL);
+  PAPI_accum_counters(accum, active_counters_);
+  for(i = 0; i < active_counters_; ++i)
+    values[i] = accum[i];
 }
 
-/**
- * What are the labels of currently active perfctrs?
- * Array at least of length dumpi_active_perfctrs().
- */
-dumpi_perflabel_t* dumpi_perfctr_labels(void) {
-  return papi_label_;
-}
+#endif /* DUMPI_HAVE_PAPI */
 
+int dumpi_set_perfctr_backend(const char *name) {
+  assert(name != NULL);
+  if(strcmp(name, "papi") == 0) {
+#ifdef DUMPI_HAVE_PAPI
+    backend_ = DUMPI_PERFCTR_PAPI;
+    return 1;
 #else /* ! DUMPI_HAVE_PAPI */
+    return 0;
+#endif /* ! DUMPI_HAVE_PAPI */
+  }
+  if(strcmp(name, "perf") == 0 || strcmp(name, "perf_event") == 0) {
+    backend_ = DUMPI_PERFCTR_PERF_EVENT;
+    return 1;
+  }
+  return 0;
+}
 
 int dumpi_init_perfctrs(dumpi_perfinfo *ctrs) {
+  int i, ret = 1;
+  /* Check input arguments checking and set up */
   assert(ctrs != NULL);
-  return 1;
+  active_counters_ = 0;
+  if(labels_ == NULL) {
+    labels_ = (dumpi_perflabel_t*)calloc(DUMPI_MAX_PERFCTRS,
+					 sizeof(dumpi_perflabel_t));
+    assert(labels_ != NULL);
+  }
+  switch(backend_) {
+  case DUMPI_PERFCTR_PAPI:
+#ifdef DUMPI_HAVE_PAPI
+    ret = papi_init_perfctrs(ctrs);
+#endif /* ! DUMPI_HAVE_PAPI */
+    break;
+  case DUMPI_PERFCTR_PERF_EVENT:
+    if(ctrs->count > 0)
+      active_counters_ = dumpi_perf_event_init(ctrs, labels_,
+					       DUMPI_MAX_PERFCTRS);
+    break;
+  }
+  /* Keep only the active counters, so reads need not touch the labels */
+  for(i = 0; i < active_counters_; ++i)
+    strcpy(ctrs->counter_tag[i], labels_[i]);
+  ctrs->count = active_counters_;
+  return ret;
 }
 
 void dumpi_get_perfctrs(const dumpi_profile *profile, dumpi_perfinfo *perf,
 			dumpi_perfinfo_direction direction)
 {
-  assert(profile && perf);
-  assert(direction == DUMPI_PERFCTR_IN || direction == DUMPI_PERFCTR_OUT);
-  perf->count = 0;
+  int64_t *active_ctr = (direction == DUMPI_PERFCTR_IN ?
+			 perf->invalue : perf->outvalue);
+  (void)profile;
+  perf->count = active_counters_;
+  if(active_counters_ == 0)
+    return;
+  switch(backend_) {
+  case DUMPI_PERFCTR_PAPI:
+#ifdef DUMPI_HAVE_PAPI
+    papi_get_perfctrs(active_ctr);
+#endif /* ! DUMPI_HAVE_PAPI */
+    break;
+  case DUMPI_PERFCTR_PERF_EVENT:
+    dumpi_perf_event_read(active_ctr);
+    break;
+  }
 }
 
 /**
  * How many perfcounters are currently active?
  */
 size_t dumpi_active_perfctrs(void) {
-  return 0;
+  return active_counters_;
 }
 
 /**
@@ -204,8 +224,5 @@ size_t dumpi_active_perfctrs(void) {
  * Array at least of length dumpi_active_perfctrs().
  */
 dumpi_perflabel_t* dumpi_perfctr_labels(void) {
-  return NULL;
+  return (active_counters_ > 0 ? labels_ : NULL);
 }
-
-
-#endif /* DUMPI_HAVE_PAPI */
@@ -22,7 +22,7 @@ extern "C" {
   /**
    * \ingroup common
    * \defgroup common_perfctrs common/perfctrs:  \
-   *      Support for PAPI performance monitors
+   *      Support for PAPI and Linux perf_event performance monitors
    */
   /*@{*/
 
@@ -35,20 +35,36 @@ extern "C" {
 
   typedef char dumpi_perflabel_t[DUMPI_MAX_PERFCTR_NAME];
 
+  /**
+   * Where the counters come from.
+   */
+  typedef enum dumpi_perfctr_backend {
+    DUMPI_PERFCTR_PAPI, DUMPI_PERFCTR_PERF_EVENT
+  } dumpi_perfctr_backend;
+
+  /**
+   * Choose the counter backend by name ("papi" or "perf").  The default
+   * is PAPI where DUMPI was built with it and perf_event otherwise.
+   * Must be called before dumpi_init_perfctrs.
+   * \return non-zero if the backend is available.
+   */
+  int dumpi_set_perfctr_backend(const char *name);
+
   /**
    * Create a perfinfo object that requests as many of the given
-   * performance counters as possible (up to the value provided by PAPI
-   * or DUMPI_MAX_PERFCTRS, whichever is smaller).
+   * performance counters as possible (up to the value provided by the
+   * backend or DUMPI_MAX_PERFCTRS, whichever is smaller).
    *
    * Counters that are not provided by the current system are ignored.
    * All other counters are processed in first-in order, so if the system
    * supports (for example) 2 concurrent counters but 4 are requested
-   * the first 2 supported ones will be turned on.
+   * the first 2 supported ones will be turned on.  ctrs is left
+   * holding only the counters turned on.
    */
   int dumpi_init_perfctrs(dumpi_perfinfo *ctrs);
 
   /**
-   * Read PAPI performance counters.
+   * Read the performance counters.
    */
   void dumpi_get_perfctrs(const dumpi_profile *profile, dumpi_perfinfo *perf,
                           dumpi_perfinfo_direction direction);
@@ -0,0 +1,307 @@
+/*
+ *  This file is part of DUMPI:
+ *               The MPI profiling library from the SST suite.
+ *  Copyright (c) 2009-2011 Sandia Corporation.
+ *  This software is distributed under the BSD License.
+ *  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+ *  the U.S. Government retains certain rights in this software.
+ *  For more information, see the LICENSE file in the top
+ *  SST/macroscale directory.
+ */
+
+#include <dumpi/common/perfevent.h>
+#include <dumpi/dumpiconfig.h>
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef DUMPI_HAVE_PERF_EVENT
+
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <errno.h>
+#ifdef DUMPI_USE_PTHREADS
+#include <pthread.h>
+#endif /* ! DUMPI_USE_PTHREADS */
+
+/* A counter name and the perf event it stands for. */
+typedef struct perf_event_name {
+  const char *name;
+  uint32_t    type;
+  uint64_t    config;
+} perf_event_name;
+
+#define HW(EVENT) PERF_TYPE_HARDWARE, PERF_COUNT_HW_##EVENT
+#define SW(EVENT) PERF_TYPE_SOFTWARE, PERF_COUNT_SW_##EVENT
+#define CACHE(LEVEL, OP, RESULT) PERF_TYPE_HW_CACHE,			\
+    (PERF_COUNT_HW_CACHE_##LEVEL |					\
+     (PERF_COUNT_HW_CACHE_OP_##OP << 8) |				\
+     (PERF_COUNT_HW_CACHE_RESULT_##RESULT << 16))
+
+/* The PAPI presets that map onto a generic perf event, then the perf
+ * names themselves. */
+static const perf_event_name event_names_[] = {
+  { "PAPI_TOT_CYC",  HW(CPU_CYCLES) },
+  { "PAPI_TOT_INS",  HW(INSTRUCTIONS) },
+  { "PAPI_REF_CYC",  HW(REF_CPU_CYCLES) },
+  { "PAPI_BR_INS",   HW(BRANCH_INSTRUCTIONS) },
+  { "PAPI_BR_MSP",   HW(BRANCH_MISSES) },
+  { "PAPI_L3_TCA",   HW(CACHE_REFERENCES) },
+  { "PAPI_L3_TCM",   HW(CACHE_MISSES) },
+  { "PAPI_STL_ICY",  HW(STALLED_CYCLES_FRONTEND) },
+  { "PAPI_RES_STL",  HW(STALLED_CYCLES_BACKEND) },
+  { "PAPI_L1_DCA",   CACHE(L1D, READ, ACCESS) },
+  { "PAPI_L1_DCM",   CACHE(L1D, READ, MISS) },
+  { "PAPI_L1_ICM",   CACHE(L1I, READ, MISS) },
+  { "PAPI_TLB_DM",   CACHE(DTLB, READ, MISS) },
+  { "PAPI_TLB_IM",   CACHE(ITLB, READ, MISS) },
+  { "PERF_COUNT_HW_CPU_CYCLES",          HW(CPU_CYCLES) },
+  { "PERF_COUNT_HW_INSTRUCTIONS",        HW(INSTRUCTIONS) },
+  { "PERF_COUNT_HW_CACHE_REFERENCES",    HW(CACHE_REFERENCES) },
+  { "PERF_COUNT_HW_CACHE_MISSES",        HW(CACHE_MISSES) },
+  { "PERF_COUNT_HW_BRANCH_INSTRUCTIONS", HW(BRANCH_INSTRUCTIONS) },
+  { "PERF_COUNT_HW_BRANCH_MISSES",       HW(BRANCH_MISSES) },
+  { "PERF_COUNT_HW_REF_CPU_CYCLES",      HW(REF_CPU_CYCLES) },
+  { "PERF_COUNT_SW_CPU_CLOCK",           SW(CPU_CLOCK) },
+  { "PERF_COUNT_SW_TASK_CLOCK",          SW(TASK_CLOCK) },
+  { "PERF_COUNT_SW_PAGE_FAULTS",         SW(PAGE_FAULTS) },
+  { "PERF_COUNT_SW_PAGE_FAULTS_MIN",     SW(PAGE_FAULTS_MIN) },
+  { "PERF_COUNT_SW_PAGE_FAULTS_MAJ",     SW(PAGE_FAULTS_MAJ) },
+  { "PERF_COUNT_SW_CONTEXT_SWITCHES",    SW(CONTEXT_SWITCHES) },
+  { "PERF_COUNT_SW_CPU_MIGRATIONS",      SW(CPU_MIGRATIONS) },
+  { NULL, 0, 0 }
+};
+
+#define RAW_PREFIX "PERF_RAW:"
+
+/* The counters of one thread.  The events form one group (led by the
+ * first one that opened) so the fallback costs a single read(). */
+typedef struct perf_event_thread {
+  int leader;
+  int members;
+  int fd[DUMPI_MAX_PERFCTRS];
+  /* Place of each event in a group read (-1 if it did not open) */
+  int position[DUMPI_MAX_PERFCTRS];
+  struct perf_event_mmap_page *page[DUMPI_MAX_PERFCTRS];
+  uint64_t buffer[DUMPI_MAX_PERFCTRS+1];
+} perf_event_thread;
+
+/* The counters kept by dumpi_perf_event_init.  Read-only afterwards. */
+static int event_count_ = 0;
+static struct perf_event_attr attr_[DUMPI_MAX_PERFCTRS];
+static size_t page_size_ = 0;
+
+#ifdef DUMPI_USE_PTHREADS
+static pthread_key_t thread_key_;
+#else /* ! DUMPI_USE_PTHREADS */
+static perf_event_thread *thread_global_ = NULL;
+#endif /* ! DUMPI_USE_PTHREADS */
+
+/* Fill in the attributes for a counter name. */
+static int lookup_event(const char *name, struct perf_event_attr *attr) {
+  const perf_event_name *entry;
+  memset(attr, 0, sizeof(struct perf_event_attr));
+  attr->size = sizeof(struct perf_event_attr);
+  attr->exclude_kernel = 1;
+  attr->exclude_hv = 1;
+  attr->read_format = PERF_FORMAT_GROUP;
+  if(strncmp(name, RAW_PREFIX, strlen(RAW_PREFIX)) == 0) {
+    char *end;
+    const char *start = name + strlen(RAW_PREFIX);
+    attr->type = PERF_TYPE_RAW;
+    attr->config = strtoull(start, &end, 0);
+    return (end != start && *end == '\0');
+  }
+  for(entry = event_names_; entry->name != NULL; ++entry) {
+    if(strcmp(entry->name, name) == 0) {
+      attr->type = entry->type;
+      attr->config = entry->config;
+      return 1;
+    }
+  }
+  return 0;
+}
+
+/* Open a counter for the calling thread in its group. */
+static int open_event(perf_event_thread *thread, int index,
+		      struct perf_event_attr *attr)
+{
+  int fd = (int)syscall(__NR_perf_event_open, attr, 0, -1, thread->leader, 0);
+  thread->fd[index] = fd;
+  thread->position[index] = -1;
+  thread->page[index] = NULL;
+  if(fd < 0)
+    return 0;
+  if(thread->leader < 0)
+    thread->leader = fd;
+  thread->position[index] = thread->members++;
+  thread->page[index] = (struct perf_event_mmap_page*)
+    mmap(NULL, page_size_, PROT_READ, MAP_SHARED, fd, 0);
+  if(thread->page[index] == MAP_FAILED)
+    thread->page[index] = NULL;
+  return 1;
+}
+
+static perf_event_thread* new_thread(void) {
+  perf_event_thread *thread =
+    (perf_event_thread*)calloc(1, sizeof(perf_event_thread));
+  assert(thread != NULL);
+  thread->leader = -1;
+  return thread;
+}
+
+/* Close the counters of a thread (also the pthread key destructor). */
+static void close_thread(void *arg) {
+  perf_event_thread *thread = (perf_event_thread*)arg;
+  int i;
+  for(i = 0; i < event_count_; ++i) {
+    if(thread->page[i] != NULL)
+      munmap(thread->page[i], page_size_);
+    if(thread->fd[i] >= 0)
+      close(thread->fd[i]);
+  }
+  free(thread);
+}
+
+/* The counters of the calling thread, opened on first use. */
+static perf_event_thread* get_thread(void) {
+  perf_event_thread *thread;
+  int i;
+#ifdef DUMPI_USE_PTHREADS
+  thread = (perf_event_thread*)pthread_getspecific(thread_key_);
+#else /* ! DUMPI_USE_PTHREADS */
+  thread = thread_global_;
+#endif /* ! DUMPI_USE_PTHREADS */
+  if(thread == NULL) {
+    thread = new_thread();
+    for(i = 0; i < event_count_; ++i)
+      open_event(thread, i, &attr_[i]);
+#ifdef DUMPI_USE_PTHREADS
+    assert(pthread_setspecific(thread_key_, thread) == 0);
+#else /* ! DUMPI_USE_PTHREADS */
+    thread_global_ = thread;
+#endif /* ! DUMPI_USE_PTHREADS */
+  }
+  return thread;
+}
+
+int dumpi_perf_event_init(const dumpi_perfinfo *ctrs,
+			  dumpi_perflabel_t *labels, int maxcount)
+{
+  perf_event_thread *thread;
+  int i;
+  assert(ctrs != NULL && labels != NULL);
+  page_size_ = (size_t)sysconf(_SC_PAGESIZE);
+  event_count_ = 0;
+  thread = new_thread();
+  for(i = 0; i < ctrs->count && event_count_ < maxcount; ++i) {
+    struct perf_event_attr *attr = &attr_[event_count_];
+    if(! lookup_event(ctrs->counter_tag[i], attr)) {
+      fprintf(stderr, "perf event %s not known -- skipped\n",
+	      ctrs->counter_tag[i]);
+      continue;
+    }
+    if(! open_event(thread, event_count_, attr)) {
+      fprintf(stderr, "perf event %s not supported -- skipped (error: %s)\n",
+	      ctrs->counter_tag[i], strerror(errno));
+      continue;
+    }
+    strcpy(labels[event_count_], ctrs->counter_tag[i]);
+    ++event_count_;
+  }
+#ifdef DUMPI_USE_PTHREADS
+  assert(pthread_key_create(&thread_key_, close_thread) == 0);
+  assert(pthread_setspecific(thread_key_, thread) == 0);
+#else /* ! DUMPI_USE_PTHREADS */
+  thread_global_ = thread;
+#endif /* ! DUMPI_USE_PTHREADS */
+  return event_count_;
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+static inline uint64_t rdpmc(uint32_t counter) {
+  uint32_t low, high;
+  __asm__ volatile("rdpmc" : "=a"(low), "=d"(high) : "c"(counter));
+  return ((uint64_t)high << 32) | low;
+}
+#define DUMPI_HAVE_RDPMC
+#endif
+
+/* Read a counter through its mapped page, without entering the kernel.
+ * Fails if the event is not on a hardware counter right now. */
+static inline int read_user(volatile struct perf_event_mmap_page *page,
+			    int64_t *value)
+{
+#ifdef DUMPI_HAVE_RDPMC
+  uint32_t seq, index;
+  int64_t count, pmc;
+  int width;
+  do {
+    seq = page->lock;
+    __asm__ volatile("" ::: "memory");
+    index = page->index;
+    if(! page->cap_user_rdpmc || index == 0)
+      return 0;
+    count = page->offset;
+    width = page->pmc_width;
+    pmc = (int64_t)rdpmc(index - 1);
+    pmc <<= 64 - width;
+    pmc >>= 64 - width;
+    count += pmc;
+    __asm__ volatile("" ::: "memory");
+  } while(page->lock != seq);
+  *value = count;
+  return 1;
+#else /* ! DUMPI_HAVE_RDPMC */
+  (void)page;
+  (void)value;
+  return 0;
+#endif /* ! DUMPI_HAVE_RDPMC */
+}
+
+void dumpi_perf_event_read(int64_t *values) {
+  perf_event_thread *thread = get_thread();
+  ssize_t length = (thread->members + 1) * sizeof(uint64_t);
+  int i, fallback = 0;
+  for(i = 0; i < event_count_; ++i) {
+    if(thread->page[i] == NULL || ! read_user(thread->page[i], &values[i]))
+      fallback = 1;
+  }
+  if(! fallback)
+    return;
+  /* One read() of the whole group:  nr, then the values in group order */
+  if(thread->leader >= 0 && read(thread->leader, thread->buffer, length)
+     == length)
+  {
+    for(i = 0; i < event_count_; ++i) {
+      if(thread->position[i] >= 0)
+	values[i] = (int64_t)thread->buffer[1 + thread->position[i]];
+    }
+  }
+  for(i = 0; i < event_count_; ++i) {
+    if(thread->position[i] < 0)
+      values[i] = 0;
+  }
+}
+
+#else /* ! DUMPI_HAVE_PERF_EVENT */
+
+int dumpi_perf_event_init(const dumpi_perfinfo *ctrs,
+			  dumpi_perflabel_t *labels, int maxcount)
+{
+  assert(ctrs != NULL && labels != NULL);
+  (void)maxcount;
+  if(ctrs->count > 0)
+    fprintf(stderr, "dumpi_perf_event_init:  perf_event is not supported "
+	    "on this system\n");
+  return 0;
+}
+
+void dumpi_perf_event_read(int64_t *values) {
+  (void)values;
+}
+
+#endif /* ! DUMPI_HAVE_PERF_EVENT */
@@ -0,0 +1,57 @@
+/*
+ *  This file is part of DUMPI:
+ *               The MPI profiling library from the SST suite.
+ *  Copyright (c) 2009-2011 Sandia Corporation.
+ *  This software is distributed under the BSD License.
+ *  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+ *  the U.S. Government retains certain rights in this software.
+ *  For more information, see the LICENSE file in the top
+ *  SST/macroscale directory.
+ */
+
+#ifndef DUMPI_COMMON_PERFEVENT_H
+#define DUMPI_COMMON_PERFEVENT_H
+
+#include <dumpi/common/perfctrs.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* ! __cplusplus */
+
+  /**
+   * \addtogroup common_perfctrs
+   */
+  /*@{*/
+
+  /**
+   * Set up the Linux perf_event backend (Linux only; see
+   * DUMPI_HAVE_PERF_EVENT).
+   *
+   * Counters are named as for PAPI (PAPI_TOT_CYC, PAPI_L1_DCM, ...);
+   * the preset names with an obvious generic perf event are supported.
+   * The perf names (PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_SW_TASK_CLOCK,
+   * ...) and raw events (PERF_RAW:0x1c2) are accepted too.  Kernel
+   * and hypervisor activity is left out, which lets the software events
+   * work without privileges (perf_event_paranoid up to 2).
+   *
+   * The counters that can be opened on the calling thread are kept, in
+   * the order requested, and their labels copied to labels.
+   * \return the number of counters kept.
+   */
+  int dumpi_perf_event_init(const dumpi_perfinfo *ctrs,
+                            dumpi_perflabel_t *labels, int maxcount);
+
+  /**
+   * Read the counters of the calling thread (opening them the first time
+   * the thread asks).  Counters with a user-space readable mapping are
+   * read with rdpmc; the rest with a single read() of the event group.
+   */
+  void dumpi_perf_event_read(int64_t *values);
+
+  /*@}*/
+
+#ifdef __cplusplus
+} /* end of extern "C" block */
+#endif /* ! __cplusplus */
+
+#endif /* DUMPI_COMMON_PERFEVENT_H */
@@ -49,11 +49,25 @@ extern "C" {
 #define DUMPI_CPUTIME_MASK       DUMPI_TIME_CPU
   /** Output wall clock */
 #define DUMPI_WALLTIME_MASK      DUMPI_TIME_WALL
+  /** Output call-site id (see dumpi_profile::callsite) */
+#define DUMPI_CALLSITE_MASK      (1<<4)
   /** Output thread id */
 #define DUMPI_THREADID_MASK      (1<<6)
   /** Output PAPI counter info */
 #define DUMPI_PERFINFO_MASK      (1<<7)
 
+  /**
+   * Call paths (callsites) are listed in the function-address record under
+   * keys that cannot be code addresses:  0xCA11 in the top 16 bits and
+   * the call-site id in the low 32.  The name of each entry is
+   * "CALLSITE: " followed by the frames, innermost first.
+   */
+#define DUMPI_CALLSITE_KEY(ID)   ((((uint64_t)0xCA11) << 48) | (uint32_t)(ID))
+  /** Test whether a function-address key names a call path */
+#define DUMPI_IS_CALLSITE_KEY(KEY) ((((uint64_t)(KEY)) >> 48) == 0xCA11)
+  /** The call-site id of a key accepted by DUMPI_IS_CALLSITE_KEY */
+#define DUMPI_CALLSITE_ID(KEY)   ((uint32_t)((KEY) & 0xffffffff))
+
   /*@}*/
 
 #ifdef __cplusplus
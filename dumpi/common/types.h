@@ -91,6 +91,8 @@ extern "C" {
   typedef int16_t dumpi_win_assert;
   /** A reasonably compact type handle for an MPI request */
   typedef int32_t dumpi_request;
+  /** A reasonably compact type handle for an MPI message (matched probe) */
+  typedef int32_t dumpi_message;
   /** A reasonably compact type handle for an MPIO request */
   typedef int32_t dumpio_request;
 
@@ -106,6 +108,20 @@ extern "C" {
     int8_t  error;
   } dumpi_status;
 
+  /**
+   * Value of dumpi_status::cancelled for a status whose byte count and
+   * cancellation flag have not been decoded yet (libdumpi lazy status
+   * capture).  In such a status, the bytes field holds the index of the
+   * status in the captured array.  Deferred statuses never reach a trace
+   * file; they are handed to dumpi_profile::defer_status instead.
+   */
+#define DUMPI_STATUS_DEFERRED ((int8_t)-128)
+
+  /** The status fields that can be filled in after they are written */
+  typedef enum dumpi_status_field {
+    DUMPI_STATUS_BYTES=0, DUMPI_STATUS_CANCELLED
+  } dumpi_status_field;
+
   /** This typedef dates back to when we worked with compressed streams
    * (which turned out not to be worth the effort) */
 #define DUMPIFILE FILE*
@@ -200,6 +216,76 @@ extern "C" {
    */
   void dumpi_free_keyval_record(dumpi_keyval_record *keyval);
 
+  /**
+   * This is effectively identical to struct timespec from time.h,
+   * but some target platforms don't have high resolution timers.
+   */
+  typedef struct dumpi_clock {
+    int32_t sec;
+    int32_t nsec;
+  } dumpi_clock;
+  
+  /**
+   * Returns a dumpi_clock with the given time using the scale factor.
+   */
+  static inline dumpi_clock dumpi_clock_init_scale(int64_t t, int64_t scale) {
+    dumpi_clock c = { (int32_t) (t/scale), (int32_t) (t%scale) };
+    return c;
+  }
+  
+  /**
+   * Returns a dumpi_clock with the given time using the given field values.
+   */
+  static inline dumpi_clock dumpi_clock_init_time(int64_t tsec, int64_t tnsec) {
+    dumpi_clock c = { (int32_t) tsec, (int32_t) tnsec };
+    return c;
+  }
+
+  /**
+   * Add the time elapsed between start and stop to a running total.
+   * The total is kept normalized (0 <= nsec < 1e9).
+   */
+  static inline void dumpi_clock_accumulate(dumpi_clock *total,
+                                            const dumpi_clock *start,
+                                            const dumpi_clock *stop)
+  {
+    total->sec  += stop->sec - start->sec;
+    total->nsec += stop->nsec - start->nsec;
+    if(total->nsec < 0) {
+      total->nsec += 1000000000;
+      total->sec  -= 1;
+    }
+    else if(total->nsec >= 1000000000) {
+      total->nsec -= 1000000000;
+      total->sec  += 1;
+    }
+  }
+
+  /**
+   * Aggregate the start- and stop-time for a given function.
+   */
+  typedef struct dumpi_time {
+    dumpi_clock start;   /* stored as 6 bytes */
+    dumpi_clock stop;    /* stored as 6 bytes */
+  } dumpi_time;
+
+  /**
+   * Bookkeeping for the cost of writing a trace file.
+   * Added to the footer record in version 1.1.1.
+   */
+  typedef struct dumpi_writer_stats {
+    /** The number of bytes handed to the output stream */
+    uint64_t         bytes_written;
+    /** The number of times the memory buffer was flushed to file */
+    uint32_t         flush_count;
+    /** Wall time spent flushing the memory buffer */
+    dumpi_clock      flush_time;
+    /** The number of times a thread had to wait for the I/O lock */
+    uint32_t         lock_contended;
+    /** Wall time spent waiting for the I/O lock */
+    dumpi_clock      lock_wait;
+  } dumpi_writer_stats;
+
   /**
    * A footer record for dumpi output.
    */
@@ -208,6 +294,12 @@ extern "C" {
     uint32_t         call_count[DUMPI_ALL_FUNCTIONS+1];
     /** The number of times an MPI function was called but not profiles */
     uint32_t         ignored_count[DUMPI_ALL_FUNCTIONS+1];
+    /** Wall time spent inside libdumpi for each function (v. 1.1.1) */
+    dumpi_clock      overhead_wall[DUMPI_ALL_FUNCTIONS+1];
+    /** CPU time spent inside libdumpi for each function (v. 1.1.1) */
+    dumpi_clock      overhead_cpu[DUMPI_ALL_FUNCTIONS+1];
+    /** Cost of writing the trace (v. 1.1.1) */
+    dumpi_writer_stats writer;
   } dumpi_footer;
 
   /**
@@ -217,6 +309,7 @@ extern "C" {
 
   /** Forward declaration of the memory buffer type (defined in iodefs.c). */
   struct dumpi_memory_buffer;
+  struct dumpi_ring_buffer;
 
   /**
    * Specify what output gets written and keep track of call counts.
@@ -255,11 +348,68 @@ extern "C" {
      * it will be set to DUMPI_MEMBUF_SIZE (by default 128 MB).
      */
     size_t target_membuf_size;
+    /**
+     * Until the trace file is opened, records that do not fit in the
+     * memory buffer (or beyond spill_threshold bytes, if that is smaller
+     * and non-zero) are moved to this anonymous temporary file instead of
+     * growing the buffer.  The first flush after the trace file opens
+     * copies them to its front.  spill_bytes is the amount spilled.
+     */
+    DUMPIFILE spill;
+    size_t spill_bytes;
+    size_t spill_threshold;
+    /**
+     * Keep only the most recent records in memory instead of writing them
+     * out (see dumpi_membuf_ring_enable).  NULL for a regular trace.
+     */
+    struct dumpi_ring_buffer *ring;
+    /**
+     * Running totals for data written through the memory buffer.
+     * Only the byte and flush counters get updated here; lock statistics
+     * are the business of whoever owns the lock.
+     */
+    dumpi_writer_stats stats;
+    /**
+     * Support for deferred statuses (see DUMPI_STATUS_DEFERRED).
+     * The writer stores a placeholder for each deferred field and calls
+     * defer_status with the memory buffer offset of the placeholder.
+     * resolve_statuses is called before the memory buffer is written to
+     * file, and is expected to patch every pending placeholder
+     * (see dumpi_membuf_patch).  Both are NULL unless set by libdumpi.
+     */
+    void (*defer_status)(struct dumpi_profile *profile,
+			 const dumpi_status *status,
+			 dumpi_status_field field, size_t offset);
+    void (*resolve_statuses)(struct dumpi_profile *profile);
+    /**
+     * Called at the end of each dumpi_membuf_flush with the time the
+     * flush took.  NULL unless set by libdumpi (see flushpolicy.h).
+     */
+    void (*flushed)(struct dumpi_profile *profile,
+		    const dumpi_time *cpu, const dumpi_time *wall);
+    /**
+     * Call-site id of the record being written or last read (0: none).
+     * Set by libdumpi around each write when callsites are captured;
+     * see DUMPI_CALLSITE_MASK and DUMPI_CALLSITE_KEY.
+     */
+    uint32_t callsite;
+    /**
+     * Set for profiles written through a writer pool (see writerpool.h):
+     * the memory buffer is a block borrowed from the pool, and the pool
+     * opens and closes the file.  NULL for a regular profile.
+     */
+    struct dumpi_pool_entry *pooled;
+    /**
+     * When reading, map wall times onto the clock of rank 0 as records
+     * are decoded (see clocksync.h and undumpi_sync_clocks).
+     * NULL to leave them as recorded.
+     */
+    struct dumpi_clock_sync *wall_sync;
   } dumpi_profile;
 
   /**
    * Control data for what gets written to output files.
-   * Values for timestamps and perfinfo are handled as booleans.
+   * Values for timestamps, perfinfo, and overhead are handled as booleans.
    * Values for statuses and function profiling are handled based on their
    * definition in the dumpi configuration (disable|success|enable).
    */
@@ -267,6 +417,7 @@ extern "C" {
     int8_t           timestamps;
     int8_t           statuses;
     int8_t           perfinfo;
+    int8_t           overhead;
     int8_t           function[DUMPI_END_OF_STREAM];
   } dumpi_outputs;
 
@@ -306,39 +457,6 @@ extern "C" {
     int64_t outvalue[DUMPI_MAX_PERFCTRS];
   } dumpi_perfinfo;
 
-  /**
-   * This is effectively identical to struct timespec from time.h,
-   * but some target platforms don't have high resolution timers.
-   */
-  typedef struct dumpi_clock {
-    int32_t sec;
-    int32_t nsec;
-  } dumpi_clock;
-  
-  /**
-   * Returns a dumpi_clock with the given time using the scale factor.
-   */
-  static inline dumpi_clock dumpi_clock_init_scale(int64_t t, int64_t scale) {
-    dumpi_clock c = { (int32_t) (t/scale), (int32_t) (t%scale) };
-    return c;
-  }
-  
-  /**
-   * Returns a dumpi_clock with the given time using the given field values.
-   */
-  static inline dumpi_clock dumpi_clock_init_time(int64_t tsec, int64_t tnsec) {
-    dumpi_clock c = { (int32_t) tsec, (int32_t) tnsec };
-    return c;
-  }
-
-  /**
-   * Aggregate the start- and stop-time for a given function.
-   */
-  typedef struct dumpi_time {
-    dumpi_clock start;   /* stored as 6 bytes */
-    dumpi_clock stop;    /* stored as 6 bytes */
-  } dumpi_time;
-
   /*@}*/ /* close the doxygen documentation module */
 
 #ifdef __cplusplus
@@ -0,0 +1,358 @@
+/*
+ *  This file is part of DUMPI:
+ *               The MPI profiling library from the SST suite.
+ *  Copyright (c) 2009-2011 Sandia Corporation.
+ *  This software is distributed under the BSD License.
+ *  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+ *  the U.S. Government retains certain rights in this software.
+ *  For more information, see the LICENSE file in the top
+ *  SST/macroscale directory.
+ */
+
+#include <dumpi/common/writerpool.h>
+#include <dumpi/common/iodefs.h>
+#include <dumpi/common/io.h>
+#include <dumpi/dumpiconfig.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <assert.h>
+
+#ifdef DUMPI_USE_PTHREADS
+#include <pthread.h>
+#endif /* ! DUMPI_USE_PTHREADS */
+
+/* Smallest block (as for a regular memory buffer) */
+#define POOL_MIN_BLOCK 4096
+
+/* The two lists a profile can be on */
+enum { HOLDERS = 0, OPEN_FILES = 1 };
+
+/* The pool's view of one profile */
+typedef struct dumpi_pool_entry {
+  struct dumpi_writer_pool *pool;
+  dumpi_profile            *profile;
+  char                     *fname;
+  uint64_t                  written;
+  int                       created;
+#ifdef DUMPI_USE_PTHREADS
+  /* Held by the thread writing the profile */
+  pthread_mutex_t           lock;
+#endif /* ! DUMPI_USE_PTHREADS */
+  /* Profiles holding a block (oldest first) and profiles with an open
+   * file (least recently written first) */
+  struct dumpi_pool_entry  *prev[2], *next[2];
+  int                       listed[2];
+} dumpi_pool_entry;
+
+struct dumpi_writer_pool {
+#ifdef DUMPI_USE_PTHREADS
+  pthread_mutex_t       lock;
+  /* Signalled when a block, a file slot, or a profile is let go */
+  pthread_cond_t        changed;
+#endif /* ! DUMPI_USE_PTHREADS */
+  size_t                block_size;
+  int                   max_blocks, max_files;
+  /* Allocated blocks no profile holds */
+  struct dumpi_memory_buffer **spare;
+  int                   spares;
+  dumpi_pool_entry     *head[2], *tail[2];
+  int                   profiles;
+  dumpi_writer_pool_stats stats;
+};
+
+#ifdef DUMPI_USE_PTHREADS
+#define POOL_LOCK(P)    assert(pthread_mutex_lock(&(P)->lock) == 0)
+#define POOL_UNLOCK(P)  assert(pthread_mutex_unlock(&(P)->lock) == 0)
+#define POOL_WAIT(P)    pthread_cond_wait(&(P)->changed, &(P)->lock)
+#define POOL_SIGNAL(P)  pthread_cond_broadcast(&(P)->changed)
+#define ENTRY_LOCK(E)    assert(pthread_mutex_lock(&(E)->lock) == 0)
+#define ENTRY_UNLOCK(E)  assert(pthread_mutex_unlock(&(E)->lock) == 0)
+#define ENTRY_TRYLOCK(E) (pthread_mutex_trylock(&(E)->lock) == 0)
+#else /* ! DUMPI_USE_PTHREADS */
+#define POOL_LOCK(P)
+#define POOL_UNLOCK(P)
+#define POOL_WAIT(P)     pool_deadlock()
+#define POOL_SIGNAL(P)
+#define ENTRY_LOCK(E)
+#define ENTRY_UNLOCK(E)
+#define ENTRY_TRYLOCK(E) 1
+/* Without threads, only the profile being written can be busy */
+static void pool_deadlock(void) {
+  fprintf(stderr, "DUMPI:  Writer pool has no block or file to give.\n");
+  abort();
+}
+#endif /* ! DUMPI_USE_PTHREADS */
+
+static void unlist(dumpi_writer_pool *pool, dumpi_pool_entry *entry,
+		   int which)
+{
+  if(! entry->listed[which])
+    return;
+  if(entry->prev[which])
+    entry->prev[which]->next[which] = entry->next[which];
+  else
+    pool->head[which] = entry->next[which];
+  if(entry->next[which])
+    entry->next[which]->prev[which] = entry->prev[which];
+  else
+    pool->tail[which] = entry->prev[which];
+  entry->prev[which] = entry->next[which] = NULL;
+  entry->listed[which] = 0;
+}
+
+/* Put an entry at the end of a list (most recent). */
+static void list_last(dumpi_writer_pool *pool, dumpi_pool_entry *entry,
+		      int which)
+{
+  unlist(pool, entry, which);
+  entry->prev[which] = pool->tail[which];
+  if(pool->tail[which])
+    pool->tail[which]->next[which] = entry;
+  else
+    pool->head[which] = entry;
+  pool->tail[which] = entry;
+  entry->listed[which] = 1;
+}
+
+/* First entry on a list that nobody is writing (other than self). */
+static dumpi_pool_entry* idle_entry(dumpi_writer_pool *pool,
+				    dumpi_pool_entry *self, int which)
+{
+  dumpi_pool_entry *entry;
+  for(entry = pool->head[which]; entry != NULL; entry = entry->next[which])
+    if(entry != self && ENTRY_TRYLOCK(entry))
+      return entry;
+  return NULL;
+}
+
+/* Close the file of an entry (pool locked). */
+static void close_file(dumpi_writer_pool *pool, dumpi_pool_entry *entry) {
+  fclose(entry->profile->file);
+  entry->profile->file = NULL;
+  unlist(pool, entry, OPEN_FILES);
+  --pool->stats.open_files;
+  POOL_SIGNAL(pool);
+}
+
+dumpi_writer_pool* dumpi_alloc_writer_pool(size_t memory, size_t block_size,
+					   int max_files)
+{
+  dumpi_writer_pool *pool;
+  pool = (dumpi_writer_pool*)calloc(1, sizeof(dumpi_writer_pool));
+  assert(pool != NULL);
+  if(block_size < POOL_MIN_BLOCK)
+    block_size = POOL_MIN_BLOCK;
+  pool->block_size = block_size;
+  pool->max_blocks = (memory / block_size > 0 ? memory / block_size : 1);
+  pool->max_files = (max_files > 0 ? max_files : 1);
+  pool->spare = (struct dumpi_memory_buffer**)
+    malloc(pool->max_blocks * sizeof(struct dumpi_memory_buffer*));
+  assert(pool->spare != NULL);
+#ifdef DUMPI_USE_PTHREADS
+  assert(pthread_mutex_init(&pool->lock, NULL) == 0);
+  assert(pthread_cond_init(&pool->changed, NULL) == 0);
+#endif /* ! DUMPI_USE_PTHREADS */
+  return pool;
+}
+
+dumpi_profile* dumpi_pool_output_profile(dumpi_writer_pool *pool,
+					 const char *fname,
+					 int cpu_offset, int wall_offset)
+{
+  dumpi_pool_entry *entry;
+  dumpi_profile *profile;
+  assert(pool != NULL && fname != NULL);
+  entry = (dumpi_pool_entry*)calloc(1, sizeof(dumpi_pool_entry));
+  profile = (dumpi_profile*)calloc(1, sizeof(dumpi_profile));
+  assert(entry != NULL && profile != NULL);
+  entry->pool = pool;
+  entry->profile = profile;
+  entry->fname = strdup(fname);
+  assert(entry->fname != NULL);
+#ifdef DUMPI_USE_PTHREADS
+  assert(pthread_mutex_init(&entry->lock, NULL) == 0);
+#endif /* ! DUMPI_USE_PTHREADS */
+  profile->pooled = entry;
+  POOL_LOCK(pool);
+  ++pool->profiles;
+  POOL_UNLOCK(pool);
+  dumpi_pool_lock(profile);
+  dumpi_start_output_profile(profile, cpu_offset, wall_offset);
+  dumpi_pool_unlock(profile);
+  return profile;
+}
+
+void dumpi_pool_lock(dumpi_profile *profile) {
+  assert(profile->pooled != NULL);
+  ENTRY_LOCK(profile->pooled);
+}
+
+void dumpi_pool_unlock(dumpi_profile *profile) {
+  dumpi_writer_pool *pool;
+  assert(profile->pooled != NULL);
+  pool = profile->pooled->pool;
+  ENTRY_UNLOCK(profile->pooled);
+  /* Someone may be waiting for the block or file of this profile */
+  POOL_LOCK(pool);
+  POOL_SIGNAL(pool);
+  POOL_UNLOCK(pool);
+}
+
+struct dumpi_memory_buffer* dumpi_pool_take_block(dumpi_profile *profile) {
+  dumpi_pool_entry *entry = profile->pooled, *victim;
+  dumpi_writer_pool *pool = entry->pool;
+  struct dumpi_memory_buffer *block;
+  POOL_LOCK(pool);
+  for(;;) {
+    if(pool->spares > 0) {
+      block = pool->spare[--pool->spares];
+      break;
+    }
+    if(pool->stats.blocks < pool->max_blocks) {
+      block = dumpi_alloc_membuf(pool->block_size);
+      ++pool->stats.blocks;
+      break;
+    }
+    if(profile->file != NULL) {
+      /* Don't sit on a file while waiting for a block; writing out the
+       * blocks of other profiles may take all the files there are */
+      close_file(pool, entry);
+      ++pool->stats.closes;
+    }
+    if((victim = idle_entry(pool, entry, HOLDERS)) != NULL) {
+      /* Write out the block held longest (it comes back to the spares) */
+      ++pool->stats.evictions;
+      POOL_UNLOCK(pool);
+      DUMPI_FLUSH(victim->profile);
+      ENTRY_UNLOCK(victim);
+      POOL_LOCK(pool);
+      /* Its file may be what another writer is waiting for */
+      POOL_SIGNAL(pool);
+      continue;
+    }
+    ++pool->stats.waits;
+    POOL_WAIT(pool);
+  }
+  list_last(pool, entry, HOLDERS);
+  POOL_UNLOCK(pool);
+  return block;
+}
+
+void dumpi_pool_return_block(dumpi_profile *profile) {
+  dumpi_pool_entry *entry = profile->pooled;
+  dumpi_writer_pool *pool = entry->pool;
+  assert(profile->membuf != NULL);
+  POOL_LOCK(pool);
+  unlist(pool, entry, HOLDERS);
+  pool->spare[pool->spares++] = profile->membuf;
+  profile->membuf = NULL;
+  POOL_SIGNAL(pool);
+  POOL_UNLOCK(pool);
+}
+
+void dumpi_pool_write(dumpi_profile *profile, const void *ptr,
+		      size_t bytes)
+{
+  dumpi_pool_entry *entry = profile->pooled, *victim;
+  dumpi_writer_pool *pool = entry->pool;
+  size_t written;
+  POOL_LOCK(pool);
+  if(profile->file == NULL) {
+    while(pool->stats.open_files >= pool->max_files) {
+      if((victim = idle_entry(pool, entry, OPEN_FILES)) != NULL) {
+	close_file(pool, victim);
+	ENTRY_UNLOCK(victim);
+	++pool->stats.closes;
+      }
+      else {
+	++pool->stats.waits;
+	POOL_WAIT(pool);
+      }
+    }
+    profile->file = fopen(entry->fname, (entry->created ? "a" : "w"));
+    if(profile->file == NULL) {
+      fprintf(stderr, "DUMPI:  Failed to open trace file \"%s\": %s\n",
+	      entry->fname, strerror(errno));
+      abort();
+    }
+    /* Whole blocks are written; the pool bounds the buffer space */
+    setvbuf(profile->file, NULL, _IONBF, 0);
+    if(entry->created)
+      ++pool->stats.reopens;
+    entry->created = 1;
+    if(++pool->stats.open_files > pool->stats.peak_open_files)
+      pool->stats.peak_open_files = pool->stats.open_files;
+  }
+  list_last(pool, entry, OPEN_FILES);
+  POOL_UNLOCK(pool);
+  written = fwrite(ptr, 1, bytes, profile->file);
+  if(written != bytes) {
+    fprintf(stderr, "DUMPI:  Failed to write trace file \"%s\": %s\n",
+	    entry->fname, strerror(errno));
+    abort();
+  }
+  entry->written += bytes;
+}
+
+off_t dumpi_pool_tell(const dumpi_profile *profile) {
+  return (off_t)profile->pooled->written;
+}
+
+void dumpi_pool_close(dumpi_profile *profile) {
+  dumpi_pool_entry *entry = profile->pooled;
+  dumpi_writer_pool *pool = entry->pool;
+  POOL_LOCK(pool);
+  if(profile->membuf != NULL) {
+    unlist(pool, entry, HOLDERS);
+    pool->spare[pool->spares++] = profile->membuf;
+    profile->membuf = NULL;
+  }
+  if(profile->file != NULL)
+    close_file(pool, entry);
+  POOL_SIGNAL(pool);
+  POOL_UNLOCK(pool);
+}
+
+void dumpi_pool_release(dumpi_profile *profile) {
+  dumpi_pool_entry *entry = profile->pooled;
+  dumpi_writer_pool *pool = entry->pool;
+  dumpi_pool_close(profile);
+  POOL_LOCK(pool);
+  --pool->profiles;
+  POOL_UNLOCK(pool);
+#ifdef DUMPI_USE_PTHREADS
+  pthread_mutex_destroy(&entry->lock);
+#endif /* ! DUMPI_USE_PTHREADS */
+  free(entry->fname);
+  free(entry);
+  profile->pooled = NULL;
+}
+
+void dumpi_writer_pool_stats_get(dumpi_writer_pool *pool,
+				 dumpi_writer_pool_stats *stats)
+{
+  POOL_LOCK(pool);
+  *stats = pool->stats;
+  POOL_UNLOCK(pool);
+}
+
+void dumpi_free_writer_pool(dumpi_writer_pool *pool) {
+  int i;
+  if(pool == NULL)
+    return;
+  if(pool->profiles > 0) {
+    /* Their blocks and files stay with them */
+    fprintf(stderr, "DUMPI:  Freeing a writer pool with %d profiles left\n",
+	    pool->profiles);
+  }
+  for(i = 0; i < pool->spares; ++i)
+    dumpi_free_membuf(pool->spare[i]);
+  free(pool->spare);
+#ifdef DUMPI_USE_PTHREADS
+  pthread_mutex_destroy(&pool->lock);
+  pthread_cond_destroy(&pool->changed);
+#endif /* ! DUMPI_USE_PTHREADS */
+  free(pool);
+}
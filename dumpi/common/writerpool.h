@@ -0,0 +1,136 @@
+/*
+ *  This file is part of DUMPI:
+ *               The MPI profiling library from the SST suite.
+ *  Copyright (c) 2009-2011 Sandia Corporation.
+ *  This software is distributed under the BSD License.
+ *  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+ *  the U.S. Government retains certain rights in this software.
+ *  For more information, see the LICENSE file in the top
+ *  SST/macroscale directory.
+ */
+
+#ifndef DUMPI_COMMON_WRITERPOOL_H
+#define DUMPI_COMMON_WRITERPOOL_H
+
+#include <dumpi/common/types.h>
+#include <sys/types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* ! __cplusplus */
+
+  /**
+   * \ingroup common
+   * \defgroup common_writerpool common/writerpool:  Writing many traces \
+   *    at once (e.g. one per rank of a simulated machine).
+   *
+   * A regular output profile has its own memory buffer (DUMPI_MEMBUF_SIZE,
+   * 128MB by default) and keeps its file open.  The profiles of a writer
+   * pool instead borrow fixed-size blocks from a shared, bounded set of
+   * buffers, and the pool keeps only so many trace files open.
+   *
+   *   - A profile takes a block on its first write after a flush, and
+   *     gives it back when the block fills up (or the profile is flushed).
+   *     When all blocks are taken, the pool flushes the profile that took
+   *     its block the longest time ago.
+   *   - A trace file is created on the first flush.  When too many files
+   *     are open, the least recently written one is closed; it is opened
+   *     again (to append) on its next flush.
+   *
+   * Profiles are written with the regular dumpi_write_* calls, finished
+   * with dumpi_write_index, and freed with dumpi_free_output_profile, as
+   * any other output profile.  Threads may write to different profiles
+   * at the same time, provided that each thread brackets its writes with
+   * dumpi_pool_lock and dumpi_pool_unlock (so that the pool does not take
+   * the block or close the file of a profile that is being written) and
+   * holds one profile at a time.
+   */
+  /*@{*/
+
+  /** A set of buffers and open files shared by many output profiles. */
+  typedef struct dumpi_writer_pool dumpi_writer_pool;
+
+  /** Usage counts of a writer pool. */
+  typedef struct dumpi_writer_pool_stats {
+    /** Blocks allocated so far (at most memory / block size) */
+    int      blocks;
+    /** Files open now, and at most */
+    int      open_files, peak_open_files;
+    /** Blocks taken from profiles that had not filled them */
+    uint64_t evictions;
+    /** Files closed to make room, and opened again later */
+    uint64_t closes, reopens;
+    /** Times a writer waited because every block or file was in use */
+    uint64_t waits;
+  } dumpi_writer_pool_stats;
+
+  /**
+   * Create a writer pool.
+   * \param memory      Total bytes of buffer space.  Blocks are allocated
+   *                    as needed, up to memory / block_size of them (at
+   *                    least one per writing thread).
+   * \param block_size  Bytes in the buffer of one profile (at least 4K).
+   * \param max_files   Most trace files open at once (at least 1).
+   */
+  dumpi_writer_pool* dumpi_alloc_writer_pool(size_t memory, size_t block_size,
+					     int max_files);
+
+  /**
+   * Create an output profile that writes the trace file fname through
+   * the pool.  The file is not created until the first flush.
+   * The time offsets are as for dumpi_alloc_output_profile.
+   */
+  dumpi_profile* dumpi_pool_output_profile(dumpi_writer_pool *pool,
+					   const char *fname,
+					   int cpu_offset, int wall_offset);
+
+  /** Start writing to a pooled profile (from any thread). */
+  void dumpi_pool_lock(dumpi_profile *profile);
+
+  /** Done writing to a pooled profile for now. */
+  void dumpi_pool_unlock(dumpi_profile *profile);
+
+  /** Get the usage counts of a pool. */
+  void dumpi_writer_pool_stats_get(dumpi_writer_pool *pool,
+				   dumpi_writer_pool_stats *stats);
+
+  /**
+   * Free a pool.  All its profiles must have been freed first
+   * (dumpi_free_output_profile).
+   */
+  void dumpi_free_writer_pool(dumpi_writer_pool *pool);
+
+  /*
+   * The rest is used by the memory buffer routines (iodefs.c).
+   */
+
+  /** Take a block for a pooled profile (evicting another if needed). */
+  struct dumpi_memory_buffer* dumpi_pool_take_block(dumpi_profile *profile);
+
+  /** Give the (flushed) block of a pooled profile back. */
+  void dumpi_pool_return_block(dumpi_profile *profile);
+
+  /** Append to the trace file of a pooled profile (opening it if needed). */
+  void dumpi_pool_write(dumpi_profile *profile, const void *ptr,
+			size_t bytes);
+
+  /** Bytes written to the trace file of a pooled profile. */
+  off_t dumpi_pool_tell(const dumpi_profile *profile);
+
+  /**
+   * Give back the block and close the file of a pooled profile
+   * (dumpi_write_index).  Writing to it again appends to the file.
+   */
+  void dumpi_pool_close(dumpi_profile *profile);
+
+  /** Close a pooled profile and take it out of the pool
+   * (dumpi_free_output_profile). */
+  void dumpi_pool_release(dumpi_profile *profile);
+
+  /*@}*/
+
+#ifdef __cplusplus
+} /* end of extern "C" */
+#endif /* ! __cplusplus */
+
+#endif /* ! DUMPI_COMMON_WRITERPOOL_H */
@@ -0,0 +1,206 @@
+/*
+ *  This file is part of DUMPI:
+ *               The MPI profiling library from the SST suite.
+ *  Copyright (c) 2009-2011 Sandia Corporation.
+ *  This software is distributed under the BSD License.
+ *  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+ *  the U.S. Government retains certain rights in this software.
+ *  For more information, see the LICENSE file in the top
+ *  SST/macroscale directory.
+ */
+
+#include <dumpi/libdumpi/aggregate.h>
+#include <dumpi/libdumpi/mpibindings-utils.h>
+#include <dumpi/libdumpi/data.h>
+#include <dumpi/common/funcs.h>
+#include <dumpi/common/gettime.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+/* Time at the start of profiling (see libdumpi_aggregate_start). */
+static dumpi_clock start_cpu = {0, 0}, start_wall = {0, 0};
+
+/* Read the wall time, and the cpu time only if profile-cpu-time asks
+ * for it (cpu stays zero otherwise). */
+static void get_time(dumpi_clock *cpu, dumpi_clock *wall) {
+  if(dumpi_global->aggregate_cpu)
+    dumpi_get_time(cpu, wall);
+  else
+    dumpi_get_wall_time(wall);
+}
+
+/* Note the start of an MPI call. */
+void libdumpi_aggregate_enter(dumpi_function func) {
+  libdumpi_aggregate_state *state = libdumpi_get_aggregate();
+  state->function = func;
+  state->sent = -1;
+  state->recvd = 0;
+  get_time(&state->cpu_start, &state->wall_start);
+}
+
+/* Note the data moved by the MPI call in progress. */
+void libdumpi_aggregate_bytes(int64_t sent, int64_t recvd) {
+  libdumpi_aggregate_state *state = libdumpi_get_aggregate();
+  state->sent = sent;
+  state->recvd = recvd;
+}
+
+/* Add the MPI call in progress to this thread's statistics. */
+void libdumpi_aggregate_exit(void) {
+  dumpi_clock cpu = {0, 0}, wall;
+  libdumpi_aggregate_state *state = libdumpi_get_aggregate();
+  get_time(&cpu, &wall);
+  if(state->funcs == NULL) {
+    state->funcs = (dumpi_aggregate_func*)
+      calloc(DUMPI_ALL_FUNCTIONS, sizeof(dumpi_aggregate_func));
+    assert(state->funcs != NULL);
+  }
+  dumpi_aggregate_add(&state->funcs[state->function],
+		      &state->wall_start, &wall, &state->cpu_start, &cpu,
+		      state->sent, state->recvd);
+}
+
+/* Add the statistics of a thread to the given totals. */
+void libdumpi_aggregate_merge(dumpi_aggregate_func *total,
+			      const libdumpi_aggregate_state *state)
+{
+  int func;
+  if(state->funcs == NULL)
+    return;
+  for(func = 0; func < DUMPI_ALL_FUNCTIONS; ++func)
+    if(state->funcs[func].calls)
+      dumpi_aggregate_merge(&total[func], &state->funcs[func]);
+}
+
+/* Free the statistics of a thread. */
+void libdumpi_aggregate_release(libdumpi_aggregate_state *state) {
+  free(state->funcs);
+  state->funcs = NULL;
+}
+
+/* Start the clock for the elapsed time. */
+void libdumpi_aggregate_start(void) {
+  get_time(&start_cpu, &start_wall);
+}
+
+/* Collect the statistics of all threads and write them out. */
+int libdumpi_aggregate_write(const char *fname) {
+  int retval;
+  dumpi_clock cpu = {0, 0}, wall;
+  dumpi_aggregate *agg = (dumpi_aggregate*)calloc(1, sizeof(dumpi_aggregate));
+  assert(agg != NULL);
+  get_time(&cpu, &wall);
+  agg->version[0] = dumpi_version;
+  agg->version[1] = dumpi_subversion;
+  agg->version[2] = dumpi_subsubversion;
+  agg->rank = dumpi_global->comm_rank;
+  agg->size = dumpi_global->comm_size;
+  dumpi_clock_accumulate(&agg->elapsed_wall, &start_wall, &wall);
+  dumpi_clock_accumulate(&agg->elapsed_cpu, &start_cpu, &cpu);
+  agg->threads = libdumpi_collect_aggregate(agg->func);
+  retval = dumpi_write_aggregate(fname, agg);
+  free(agg);
+  return retval;
+}
+
+/* The size of count elements of the given type. */
+int64_t libdumpi_bytes(int count, MPI_Datatype type) {
+  int size = 0;
+  if(count <= 0 || type == MPI_DATATYPE_NULL)
+    return 0;
+  PMPI_Type_size(type, &size);
+  return (int64_t)count * size;
+}
+
+/* The size of the per-peer counts of a vector collective. */
+int64_t libdumpi_bytes_v(const int *counts, MPI_Datatype type, MPI_Comm comm)
+{
+  if(counts == NULL)
+    return 0;
+  return libdumpi_bytes_n(libdumpi_comm_peers(comm), counts, type);
+}
+
+/* The size of the per-peer counts and types of MPI_Alltoallw. */
+int64_t libdumpi_bytes_w(const int *counts, const MPI_Datatype *types,
+			 MPI_Comm comm)
+{
+  if(counts == NULL || types == NULL)
+    return 0;
+  return libdumpi_bytes_nw(libdumpi_comm_peers(comm), counts, types);
+}
+
+/* The size of the given number of per-peer counts. */
+int64_t libdumpi_bytes_n(int peers, const int *counts, MPI_Datatype type) {
+  int i;
+  int64_t total = 0;
+  if(counts == NULL)
+    return 0;
+  for(i = 0; i < peers; ++i)
+    total += (counts[i] > 0 ? counts[i] : 0);
+  return libdumpi_bytes(1, type) * total;
+}
+
+/* The size of the given number of per-peer counts and types. */
+int64_t libdumpi_bytes_nw(int peers, const int *counts,
+			  const MPI_Datatype *types)
+{
+  int i;
+  int64_t total = 0;
+  if(counts == NULL || types == NULL)
+    return 0;
+  for(i = 0; i < peers; ++i)
+    total += libdumpi_bytes(counts[i], types[i]);
+  return total;
+}
+
+/* The number of peers in a collective. */
+int libdumpi_comm_peers(MPI_Comm comm) {
+  int inter = 0, size = 0;
+  PMPI_Comm_test_inter(comm, &inter);
+  if(inter)
+    PMPI_Comm_remote_size(comm, &size);
+  else
+    PMPI_Comm_size(comm, &size);
+  return size;
+}
+
+/* The neighborhood of the calling process in a process topology. */
+void libdumpi_neighbor_degrees(MPI_Comm comm, int *indegree, int *outdegree) {
+  int topo = MPI_UNDEFINED, in = 0, out = 0;
+  PMPI_Topo_test(comm, &topo);
+  if(topo == MPI_CART) {
+    PMPI_Cartdim_get(comm, &in);
+    in = out = 2 * in;
+  }
+  else if(topo == MPI_GRAPH) {
+    PMPI_Graph_neighbors_count(comm, libdumpi_comm_rank(comm), &in);
+    out = in;
+  }
+#ifdef DUMPI_HAVE_MPI_DIST_GRAPH
+  else if(topo == MPI_DIST_GRAPH) {
+    int weighted;
+    PMPI_Dist_graph_neighbors_count(comm, &in, &out, &weighted);
+  }
+#endif
+  if(indegree) *indegree = in;
+  if(outdegree) *outdegree = out;
+}
+
+/* The rank of the calling process. */
+int libdumpi_comm_rank(MPI_Comm comm) {
+  int rank = 0;
+  PMPI_Comm_rank(comm, &rank);
+  return rank;
+}
+
+/* Test whether the calling process is the root of a rooted collective. */
+int libdumpi_comm_is_root(int root, MPI_Comm comm) {
+  int inter = 0;
+  if(root == MPI_ROOT)
+    return 1;
+  if(root == MPI_PROC_NULL)
+    return 0;
+  PMPI_Comm_test_inter(comm, &inter);
+  return (! inter && libdumpi_comm_rank(comm) == root);
+}
@@ -0,0 +1,127 @@
+/*
+ *  This file is part of DUMPI:
+ *               The MPI profiling library from the SST suite.
+ *  Copyright (c) 2009-2011 Sandia Corporation.
+ *  This software is distributed under the BSD License.
+ *  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+ *  the U.S. Government retains certain rights in this software.
+ *  For more information, see the LICENSE file in the top
+ *  SST/macroscale directory.
+ */
+
+#ifndef DUMPI_LIBDUMPI_AGGREGATE_H
+#define DUMPI_LIBDUMPI_AGGREGATE_H
+
+#include <dumpi/common/aggregate.h>
+#include <dumpi/common/types.h>
+#include <dumpi/common/funclabels.h>
+#include <dumpi/dumpiconfig.h>
+#include <mpi.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* ! __cplusplus */
+
+  /**
+   * \addtogroup libdumpi_internal
+   */
+  /*@{*/
+
+  /**
+   * Statistics gathered by one thread (mode=profile).
+   * Each thread keeps one of these (see libdumpi_get_aggregate).
+   */
+  typedef struct libdumpi_aggregate_state {
+    /** The MPI call in progress (set by libdumpi_aggregate_enter) */
+    dumpi_function        function;
+    dumpi_clock           cpu_start, wall_start;
+    /** Bytes moved by the call in progress; sent < 0 if it has no data */
+    int64_t               sent, recvd;
+    /** Statistics indexed by dumpi_function (allocated on first use) */
+    dumpi_aggregate_func *funcs;
+  } libdumpi_aggregate_state;
+
+  /**
+   * Note the start of an MPI call.  Used by DUMPI_INSERT_PREAMBLE.
+   */
+  void libdumpi_aggregate_enter(dumpi_function func);
+
+  /**
+   * Note the data moved by the MPI call in progress.
+   * Used by DUMPI_AGGREGATE_BYTES.
+   */
+  void libdumpi_aggregate_bytes(int64_t sent, int64_t recvd);
+
+  /**
+   * Add the MPI call in progress to the calling thread's statistics.
+   * Used by DUMPI_INSERT_POSTAMBLE.
+   */
+  void libdumpi_aggregate_exit(void);
+
+  /**
+   * Add the statistics of a thread to the given totals
+   * (indexed by dumpi_function).
+   */
+  void libdumpi_aggregate_merge(dumpi_aggregate_func *total,
+				const libdumpi_aggregate_state *state);
+
+  /**
+   * Free the statistics of a thread.
+   */
+  void libdumpi_aggregate_release(libdumpi_aggregate_state *state);
+
+  /**
+   * Start the clock for the elapsed time in the statistics file.
+   */
+  void libdumpi_aggregate_start(void);
+
+  /**
+   * Collect the statistics of all threads and write them to the named file.
+   * \return non-zero on success.
+   */
+  int libdumpi_aggregate_write(const char *fname);
+
+  /** The size of count elements of the given type (0 for MPI_DATATYPE_NULL) */
+  int64_t libdumpi_bytes(int count, MPI_Datatype type);
+
+  /** The size of the per-peer counts of a vector collective */
+  int64_t libdumpi_bytes_v(const int *counts, MPI_Datatype type,
+			   MPI_Comm comm);
+
+  /** The size of the per-peer counts and types of MPI_Alltoallw */
+  int64_t libdumpi_bytes_w(const int *counts, const MPI_Datatype *types,
+			   MPI_Comm comm);
+
+  /** The size of the first peers counts of the given type */
+  int64_t libdumpi_bytes_n(int peers, const int *counts, MPI_Datatype type);
+
+  /** The size of the first peers counts and types */
+  int64_t libdumpi_bytes_nw(int peers, const int *counts,
+			    const MPI_Datatype *types);
+
+  /**
+   * The number of neighbors the calling process receives from (indegree)
+   * and sends to (outdegree) in a neighborhood collective:  twice the
+   * dimensions of a cartesian topology, the neighbors in a graph topology,
+   * the sources and destinations of a distributed graph, 0 otherwise.
+   * Either pointer may be NULL.
+   */
+  void libdumpi_neighbor_degrees(MPI_Comm comm, int *indegree, int *outdegree);
+
+  /** The number of peers in a collective (remote size for intercomms) */
+  int libdumpi_comm_peers(MPI_Comm comm);
+
+  /** The rank of the calling process in the given communicator */
+  int libdumpi_comm_rank(MPI_Comm comm);
+
+  /** Test whether the calling process is the root of a rooted collective */
+  int libdumpi_comm_is_root(int root, MPI_Comm comm);
+
+  /*@}*/
+
+#ifdef __cplusplus
+} /* end of extern "C" */
+#endif /* ! __cplusplus */
+
+#endif /* ! DUMPI_LIBDUMPI_AGGREGATE_H */
@@ -0,0 +1,296 @@
+/*
+ *  This file is part of DUMPI:
+ *               The MPI profiling library from the SST suite.
+ *  Copyright (c) 2009-2011 Sandia Corporation.
+ *  This software is distributed under the BSD License.
+ *  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+ *  the U.S. Government retains certain rights in this software.
+ *  For more information, see the LICENSE file in the top
+ *  SST/macroscale directory.
+ */
+
+#include <dumpi/libdumpi/annotation.h>
+#include <dumpi/libdumpi/mpibindings.h>
+#include <dumpi/libdumpi/mpibindings-utils.h>
+#include <dumpi/libdumpi/trigger.h>
+#include <dumpi/libdumpi/data.h>
+#include <dumpi/common/dumpiio.h>
+#include <dumpi/dumpiconfig.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#ifdef DUMPI_USE_PTHREADS
+#include <pthread.h>
+static pthread_mutex_t table_lock = PTHREAD_MUTEX_INITIALIZER;
+#define LOCK_TABLE()   assert(pthread_mutex_lock(&table_lock) == 0)
+#define UNLOCK_TABLE() assert(pthread_mutex_unlock(&table_lock) == 0)
+#else /* ! DUMPI_USE_PTHREADS */
+#define LOCK_TABLE()
+#define UNLOCK_TABLE()
+#endif /* ! DUMPI_USE_PTHREADS */
+
+#define TABLE_MIN_CAPACITY 256
+#define ANNOTATION_HEADER "ANNOTATION: "
+/* Annotations up to this long are formatted without allocating */
+#define ANNOTATION_LOCAL_SIZE 512
+
+/* One stored text. */
+typedef struct annotation {
+  uint64_t key;
+  uint64_t hash;
+  size_t   length;
+  char    *text;
+  /* Non-zero if the key was handed out by libdumpi_annotation_intern */
+  int      interned;
+} annotation;
+
+/* All texts in the order they were stored, plus open-addressing indices
+ * by key and (for interned texts) by content.  Index slots hold the
+ * position in entries plus one (0 marks an empty slot).  Protected by
+ * table_lock. */
+static annotation *entries = NULL;
+static uint32_t entry_count = 0, entry_capacity = 0;
+static uint32_t *by_key = NULL, *by_text = NULL;
+static size_t index_capacity = 0;
+static uint64_t next_key = DUMPI_MAX_USER_KEY;
+
+/* FNV-1a over the text. */
+static uint64_t hash_text(const char *text, size_t length) {
+  uint64_t hash = 14695981039346656037ull;
+  size_t i;
+  for(i = 0; i < length; ++i) {
+    hash ^= (unsigned char)text[i];
+    hash *= 1099511628211ull;
+  }
+  return hash;
+}
+
+/* Keys are small integers or tagged values, so mix all the bits. */
+static uint64_t hash_key(uint64_t key) {
+  key ^= key >> 33;
+  key *= 0xff51afd7ed558ccdull;
+  key ^= key >> 33;
+  return key;
+}
+
+static void index_entry(uint32_t pos) {
+  const annotation *entry = &entries[pos];
+  size_t slot = hash_key(entry->key) & (index_capacity - 1);
+  while(by_key[slot] != 0)
+    slot = (slot + 1) & (index_capacity - 1);
+  by_key[slot] = pos + 1;
+  if(entry->interned) {
+    slot = entry->hash & (index_capacity - 1);
+    while(by_text[slot] != 0)
+      slot = (slot + 1) & (index_capacity - 1);
+    by_text[slot] = pos + 1;
+  }
+}
+
+/* Double the indices (keeping the load below one half). */
+static void grow_indices(void) {
+  uint32_t pos;
+  free(by_key);
+  free(by_text);
+  index_capacity = (index_capacity ? 2*index_capacity : 2*TABLE_MIN_CAPACITY);
+  by_key = (uint32_t*)calloc(index_capacity, sizeof(uint32_t));
+  by_text = (uint32_t*)calloc(index_capacity, sizeof(uint32_t));
+  assert(by_key != NULL && by_text != NULL);
+  for(pos = 0; pos < entry_count; ++pos)
+    index_entry(pos);
+}
+
+/* Find the entry with the given key (the caller holds the lock). */
+static annotation* find_key(uint64_t key) {
+  size_t slot;
+  if(index_capacity == 0)
+    return NULL;
+  slot = hash_key(key) & (index_capacity - 1);
+  while(by_key[slot] != 0) {
+    if(entries[by_key[slot]-1].key == key)
+      return &entries[by_key[slot]-1];
+    slot = (slot + 1) & (index_capacity - 1);
+  }
+  return NULL;
+}
+
+/* Store a new entry (the caller holds the lock). */
+static void add_entry(uint64_t key, const char *text, size_t length,
+		      uint64_t hash, int interned)
+{
+  annotation *entry;
+  if(entry_count == entry_capacity) {
+    entry_capacity = (entry_capacity ? 2*entry_capacity : TABLE_MIN_CAPACITY);
+    entries = (annotation*)realloc(entries,
+				   entry_capacity * sizeof(annotation));
+    assert(entries != NULL);
+  }
+  entry = &entries[entry_count];
+  entry->key = key;
+  entry->hash = hash;
+  entry->length = length;
+  entry->interned = interned;
+  entry->text = NULL;
+  if(text != NULL) {
+    entry->text = (char*)malloc(length + 1);
+    assert(entry->text != NULL);
+    memcpy(entry->text, text, length);
+    entry->text[length] = '\0';
+  }
+  ++entry_count;
+  if(2*entry_count > index_capacity)
+    grow_indices();
+  else
+    index_entry(entry_count - 1);
+}
+
+/* Store a text under a key. */
+void libdumpi_annotation_insert(uint64_t key, const char *text) {
+  size_t length = (text ? strlen(text) : 0);
+  annotation *entry;
+  LOCK_TABLE();
+  if((entry = find_key(key)) == NULL)
+    add_entry(key, text, length, 0, 0);
+  else if(entry->text == NULL && text != NULL) {
+    entry->text = strdup(text);
+    assert(entry->text != NULL);
+    entry->length = length;
+  }
+  UNLOCK_TABLE();
+}
+
+/* Find or store a text by content. */
+uint64_t libdumpi_annotation_intern(const char *text, size_t length) {
+  uint64_t hash = hash_text(text, length), key = 0;
+  size_t slot;
+  LOCK_TABLE();
+  if(index_capacity > 0) {
+    slot = hash & (index_capacity - 1);
+    while(by_text[slot] != 0) {
+      const annotation *entry = &entries[by_text[slot]-1];
+      if(entry->hash == hash && entry->length == length &&
+	 memcmp(entry->text, text, length) == 0)
+      {
+	key = entry->key;
+	break;
+      }
+      slot = (slot + 1) & (index_capacity - 1);
+    }
+  }
+  if(key == 0) {
+    /* Step over keys the application picked outside its range */
+    while(find_key(next_key) != NULL)
+      ++next_key;
+    key = next_key++;
+    add_entry(key, text, length, hash, 1);
+  }
+  UNLOCK_TABLE();
+  return key;
+}
+
+/* Get the text stored under a key. */
+const char* libdumpi_annotation_find(uint64_t key) {
+  const annotation *entry;
+  const char *text = NULL;
+  LOCK_TABLE();
+  if((entry = find_key(key)) != NULL)
+    text = entry->text;
+  UNLOCK_TABLE();
+  return text;
+}
+
+/* Number of stored keys. */
+size_t libdumpi_annotation_count(void) {
+  size_t count;
+  LOCK_TABLE();
+  count = entry_count;
+  UNLOCK_TABLE();
+  return count;
+}
+
+/* Copy the stored keys. */
+size_t libdumpi_annotation_keys(uint64_t *keys, size_t max) {
+  size_t i;
+  LOCK_TABLE();
+  for(i = 0; i < entry_count && i < max; ++i)
+    keys[i] = entries[i].key;
+  UNLOCK_TABLE();
+  return i;
+}
+
+/* Write the annotation as an entry/exit pair. */
+static void write_annotation(uint64_t key, const dumpi_time *cpu_start,
+			     const dumpi_time *wall_start)
+{
+  dumpi_func_call stat;
+  dumpi_time cpu_stop, wall_stop;
+  uint16_t thread = libdumpi_get_thread_id();
+  stat.fn = key;
+  DUMPI_START_TIME(cpu_stop, wall_stop);
+  DUMPI_STOP_TIME(cpu_stop, wall_stop);
+  libdumpi_lock_io();
+  dumpi_write_func_enter(&stat, thread, cpu_start, wall_start,
+			 dumpi_global->perf, dumpi_global->output,
+			 dumpi_global->profile);
+  dumpi_write_func_exit(&stat, thread, &cpu_stop, &wall_stop,
+			dumpi_global->perf, dumpi_global->output,
+			dumpi_global->profile);
+  libdumpi_unlock_io();
+}
+
+/* Handle MPI_Pcontrol(2/3, ...). */
+void libdumpi_annotate(int level, va_list args) {
+  char local[ANNOTATION_LOCAL_SIZE], *text = local;
+  const size_t offset = strlen(ANNOTATION_HEADER);
+  const char *fmt;
+  dumpi_time cpu_start, wall_start;
+  uint64_t key = 0;
+  va_list argcpy;
+  int length;
+  DUMPI_START_TIME(cpu_start, wall_start);
+  DUMPI_STOP_TIME(cpu_start, wall_start);
+  if(! (dumpi_global->output->function[DUMPI_ALL_FUNCTIONS] ||
+	dumpi_global->triggers))
+    return;
+  if(level == 3) {
+    /* We permit user-keys in the range 1..4095 (reserve '0' for NULL).
+     * This should firmly put us in the first (blocked) page on most
+     * systems. */
+    key = va_arg(args, uint64_t);
+    if(key < DUMPI_MIN_USER_KEY || key >= DUMPI_MAX_USER_KEY) {
+      fprintf(stderr, "WARNING:  DUMPI:  MPI_Pcontrol(3, ...):  "
+	      "User key %llu is outside the recommended range "
+	      "%llu through %llu\n", (unsigned long long)key,
+	      DUMPI_MIN_USER_KEY, DUMPI_MAX_USER_KEY-1);
+    }
+  }
+  fmt = va_arg(args, const char*);
+  memcpy(local, ANNOTATION_HEADER, offset);
+  va_copy(argcpy, args);
+  length = vsnprintf(local+offset, sizeof(local)-offset, fmt, args);
+  if(length < 0)
+    length = 0;
+  else if((size_t)length >= sizeof(local)-offset) {
+    /* Rare long annotation */
+    text = (char*)malloc(offset + length + 1);
+    assert(text != NULL);
+    memcpy(text, ANNOTATION_HEADER, offset);
+    vsnprintf(text+offset, length+1, fmt, argcpy);
+  }
+  va_end(argcpy);
+  if(dumpi_global->triggers)
+    libdumpi_trigger_annotation(text+offset, 0);
+  if(dumpi_global->output->function[DUMPI_ALL_FUNCTIONS]) {
+    if(level == 3)
+      libdumpi_annotation_insert(key, text);
+    else
+      key = libdumpi_annotation_intern(text, offset + length);
+    write_annotation(key, &cpu_start, &wall_start);
+  }
+  if(dumpi_global->triggers)
+    libdumpi_trigger_annotation(text+offset, 1);
+  if(text != local)
+    free(text);
+}
@@ -0,0 +1,82 @@
+/*
+ *  This file is part of DUMPI:
+ *               The MPI profiling library from the SST suite.
+ *  Copyright (c) 2009-2011 Sandia Corporation.
+ *  This software is distributed under the BSD License.
+ *  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+ *  the U.S. Government retains certain rights in this software.
+ *  For more information, see the LICENSE file in the top
+ *  SST/macroscale directory.
+ */
+
+#ifndef DUMPI_LIBDUMPI_ANNOTATION_H
+#define DUMPI_LIBDUMPI_ANNOTATION_H
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* ! __cplusplus */
+
+  /**
+   * \addtogroup libdumpi_internal
+   */
+  /*@{*/
+
+  /** Lowest key an application may pass to MPI_Pcontrol(3, ...) */
+#define DUMPI_MIN_USER_KEY 1ULL
+
+  /**
+   * Keys from here on are handed out to MPI_Pcontrol(2, ...) annotations.
+   * On 64-bit Linux systems, we get quite a few of them before bumping
+   * into the text segment of the program.
+   */
+#define DUMPI_MAX_USER_KEY 4096ULL
+
+  /**
+   * Store a text under the given key (unless the key already has one).
+   * The text is copied.  Safe to call from any thread.
+   */
+  void libdumpi_annotation_insert(uint64_t key, const char *text);
+
+  /**
+   * Get the key of a text, storing the text under a new key (counting up
+   * from DUMPI_MAX_USER_KEY) the first time it is seen.  Repeated texts
+   * are found by content without allocating.  Safe to call from any thread.
+   */
+  uint64_t libdumpi_annotation_intern(const char *text, size_t length);
+
+  /**
+   * Get the text stored under a key, or NULL.  Stored texts are never
+   * moved or freed.
+   */
+  const char* libdumpi_annotation_find(uint64_t key);
+
+  /**
+   * Number of keys with a stored text.
+   */
+  size_t libdumpi_annotation_count(void);
+
+  /**
+   * Copy up to max keys (in the order they were stored) to keys.
+   * \return the number of keys copied.
+   */
+  size_t libdumpi_annotation_keys(uint64_t *keys, size_t max);
+
+  /**
+   * Handle MPI_Pcontrol(2, fmt, ...) and MPI_Pcontrol(3, key, fmt, ...):
+   * format the annotation, check it against the annotation triggers, and
+   * record it as a Function_enter/Function_exit pair whose address is
+   * the annotation's key.  args holds the arguments after the level.
+   */
+  void libdumpi_annotate(int level, va_list args);
+
+  /*@}*/
+
+#ifdef __cplusplus
+} /* end of extern "C" */
+#endif /* ! __cplusplus */
+
+#endif /* ! DUMPI_LIBDUMPI_ANNOTATION_H */
@@ -1,157 +1,106 @@
 /*
- *  This file is part of DUMPI: 
+ *  This file is part of DUMPI:
  *               The MPI profiling library from the SST suite.
  *  Copyright (c) 2009 Sandia Corporation.
  *  This software is distributed under the BSD License.
  *  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
  *  the U.S. Government retains certain rights in this software.
- *  For more information, see the LICENSE file in the top 
+ *  For more information, see the LICENSE file in the top
  *  SST/macroscale directory.
  */
 
 #include <dumpi/libdumpi/callprofile-addrset.h>
+#include <dumpi/dumpiconfig.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <assert.h>
 
-#ifdef __cplusplus
-extern "C" {
-#endif /* !__cplusplus */
+#ifdef DUMPI_USE_PTHREADS
+#include <pthread.h>
+static pthread_mutex_t addr_lock = PTHREAD_MUTEX_INITIALIZER;
+#define LOCK_ADDRESSES()   assert(pthread_mutex_lock(&addr_lock) == 0)
+#define UNLOCK_ADDRESSES() assert(pthread_mutex_unlock(&addr_lock) == 0)
+#else /* ! DUMPI_USE_PTHREADS */
+#define LOCK_ADDRESSES()
+#define UNLOCK_ADDRESSES()
+#endif /* ! DUMPI_USE_PTHREADS */
 
-  /**
-   * \ingroup libdumpi_internal
-   * \defgroup libdumpi_internal_callprofile libdumpi/internal/callprofile: \
-   *    Functionality to track addresses in a call profile generated        \
-   *    using -finstrument-functions
-   */
-  /*@{*/
+#define ADDR_MIN_CAPACITY 1024
 
-  /**
-   * Set up a simple hash of the addresses seen so we can later
-   * write their names to a footer record.
-   */
-  typedef struct dumpi_addrlist {
-    uint64_t *addr;
-    int count, length;
-  } dumpi_addrlist;
+/* One address seen by the instrumentation (address 0 marks an empty slot) */
+typedef struct dumpi_addr_entry {
+  uint64_t address;
+  int32_t  value;
+} dumpi_addr_entry;
 
-  /** Note that the number of buckets goes with the size of HASH_TYPE
-   * HASH_TYPE unsigned short results in 32Ki buckets */
-#define HASH_TYPE unsigned short
+/* Shared open-addressing table of the addresses encountered so far.
+ * Protected by addr_lock. */
+static dumpi_addr_entry *addresses = NULL;
+static size_t addr_count = 0, addr_capacity = 0;
 
-  /** Figure out how many buckets we can fit */
-#define BUCKETS (1<<(8*sizeof(HASH_TYPE)))
+/* Function addresses are aligned and clustered, so mix all the bits. */
+static size_t hash_address(uint64_t address) {
+  address ^= address >> 33;
+  address *= 0xff51afd7ed558ccdull;
+  address ^= address >> 33;
+  return (size_t)address;
+}
 
-  //typedef dumpi_addrlist addr_set[BUCKETS];
-  /** Shared listing of addresses encountered so for.
-   * This might be better managed using a set of init and free functions.
-   */
-  static dumpi_addrlist *addresses = NULL;
-
-  /**
-   * Insert an address on the shared address list.
-   * This might be better handled without the shared back-end list.
-   */
-  static void insert_address(uint64_t address) {
-    const HASH_TYPE *hash_view = NULL;
-    int seen, i, range;
-    HASH_TYPE hash = 0;
-    range = sizeof(uint64_t) / sizeof(HASH_TYPE);
-    /* Compute a hash of the address */
-    hash_view = (const HASH_TYPE*)(address);
-    for(i = 0; i < range; ++i) {
-      hash ^= hash_view[i];
-    }
-    /* This may be a first time we enter this function */
-    if(addresses == NULL) {
-      addresses = (dumpi_addrlist*) calloc(BUCKETS, sizeof(dumpi_addrlist));
-      assert(addresses != NULL);
-    }
-    /* and this may be the first time we see this hash */
-    if(addresses[hash].length == 0) {
-      addresses[hash].length = 4;
-      addresses[hash].addr = (uint64_t*)calloc(addresses[hash].length,sizeof(uint64_t));
-      assert(addresses[hash].addr != NULL);
-      addresses[hash].count = 0; /* redundant, of course */
-    }
-    /* OK, figure out whether we've seen this address before */
-    seen = 0;
-    for(i = 0; i < addresses[hash].count; ++i) {
-      if(addresses[hash].addr[i] == address) {
-	seen = 1;
-	break;
-      }
-    }
-    /* If we have not seen this address before, it is time to insert it */
-    if(seen == 0) {
-      /* Do we need to make more space? */
-      if(addresses[hash].count >= addresses[hash].length) {
-	addresses[hash].length *= 2;
-	addresses[hash].addr =
-	  (uint64_t*)realloc(addresses[hash].addr,
-			  addresses[hash].length * sizeof(uint64_t));
-	assert(addresses[hash].addr != NULL);
-      }
-      /* Insert this address. */
-      addresses[hash].addr[addresses[hash].count] = address;
-      ++addresses[hash].count;
-    }
-  }
-
-  /**
-   * Get an iterator to the first valid pointer on the address list. 
-   */
-  dumpi_addr_iterator libdumpi_addr_begin_iterator() {
-    dumpi_addr_iterator retval = {0, 0};
-    if(addresses != NULL) {
-      for(retval.bucket = 0; retval.bucket < BUCKETS; ++retval.bucket) {
-	if(addresses[retval.bucket].count > 0) {
-	  goto loop_done;
-	}
-      }
-    }
-    else {
-      retval.bucket = BUCKETS;
-    }
-  loop_done:
-    return retval;
-  }
-
-  /** Is this iterator valid? */
-  int libdumpi_addr_valid_iterator(const dumpi_addr_iterator *it) {
-    assert(it != NULL);
-    return it->bucket < BUCKETS;
+/* Double the table (keeping the load below one half). */
+static void grow_addresses(void) {
+  dumpi_addr_entry *old = addresses;
+  size_t old_capacity = addr_capacity, i, slot;
+  addr_capacity = (addr_capacity ? 2*addr_capacity : ADDR_MIN_CAPACITY);
+  addresses = (dumpi_addr_entry*)calloc(addr_capacity,
+					sizeof(dumpi_addr_entry));
+  assert(addresses != NULL);
+  for(i = 0; i < old_capacity; ++i) {
+    if(old[i].address == 0)
+      continue;
+    slot = hash_address(old[i].address) & (addr_capacity - 1);
+    while(addresses[slot].address != 0)
+      slot = (slot + 1) & (addr_capacity - 1);
+    addresses[slot] = old[i];
   }
+  free(old);
+}
 
-  /**
-   * Increment the given iterator.
-   * return non-zero if the iterator is still valid after increment.
-   */
-  int libdumpi_addr_increment_iterator(dumpi_addr_iterator *it) {
-    if(it->bucket < BUCKETS) {
-      ++it->pos;
-      if(it->pos >= addresses[it->bucket].count) {
-	it->pos = 0;
-	for(++it->bucket ; it->bucket < BUCKETS; ++it->bucket) {
-	  if(addresses[it->bucket].count > 0) {
-	    goto loop_done;
-	  }
-	}
-      }
-    }
-  loop_done:
-    return (it->bucket < BUCKETS);
+/* Insert an address on the shared address list. */
+int32_t libdumpi_insert_address(void *address, dumpi_addr_classifier classify)
+{
+  uint64_t key = (uint64_t)(uintptr_t)address;
+  int32_t value;
+  size_t slot;
+  assert(key != 0);
+  LOCK_ADDRESSES();
+  if(2*(addr_count+1) > addr_capacity)
+    grow_addresses();
+  slot = hash_address(key) & (addr_capacity - 1);
+  while(addresses[slot].address != 0 && addresses[slot].address != key)
+    slot = (slot + 1) & (addr_capacity - 1);
+  if(addresses[slot].address == 0) {
+    addresses[slot].address = key;
+    addresses[slot].value = (classify ? classify(key) : 1);
+    ++addr_count;
   }
+  value = addresses[slot].value;
+  UNLOCK_ADDRESSES();
+  return value;
+}
 
-  /* Dereference the iterator. */
-  uint64_t libdumpi_addr_iterator_value(const dumpi_addr_iterator *it) {
-    assert(it->bucket<BUCKETS && it->pos<addresses[it->bucket].count);
-    return addresses[it->bucket].addr[it->pos];
-  }
-
-  /*@}*/
-
-#ifdef __cplusplus
-} /* close extern "C" block */
-#endif /* !__cplusplus */
-
+/* Copy the addresses with a non-zero value. */
+uint64_t* libdumpi_addr_snapshot(int *count) {
+  uint64_t *keys;
+  size_t i;
+  int used = 0;
+  assert(count != NULL);
+  LOCK_ADDRESSES();
+  keys = (uint64_t*)calloc(addr_count + 1, sizeof(uint64_t));
+  assert(keys != NULL);
+  for(i = 0; i < addr_capacity; ++i)
+    if(addresses[i].address != 0 && addresses[i].value != 0)
+      keys[used++] = addresses[i].address;
+  UNLOCK_ADDRESSES();
+  *count = used;
+  return keys;
+}
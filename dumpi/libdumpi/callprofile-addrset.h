@@ -1,11 +1,11 @@
 /*
- *  This file is part of DUMPI: 
+ *  This file is part of DUMPI:
  *               The MPI profiling library from the SST suite.
  *  Copyright (c) 2009 Sandia Corporation.
  *  This software is distributed under the BSD License.
  *  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
  *  the U.S. Government retains certain rights in this software.
- *  For more information, see the LICENSE file in the top 
+ *  For more information, see the LICENSE file in the top
  *  SST/macroscale directory.
  */
 
@@ -29,34 +29,27 @@ extern "C" {
    */
   /*@{*/
 
-  /** Allow semi-sensible iteration through the buckets */
-  typedef struct dumpi_addr_iterator {
-    int bucket;
-    int pos;
-  } dumpi_addr_iterator;
-
   /**
-   * Insert an address on the shared address list.
-   * Uses libdl (if available) to figure out the name at this address.
+   * Decide what to do with calls to a function seen for the first time
+   * (see libdumpi_insert_address).
    */
-  void libdumpi_insert_address(void *address);
+  typedef int32_t (*dumpi_addr_classifier)(uint64_t address);
 
   /**
-   * Get an iterator to the first valid pointer on the address list. 
+   * Insert an address on the shared address list.  The first time an
+   * address is seen, classify is called (once, under the list's lock)
+   * and its result is stored with the address.
+   * \return the value stored with the address.
    */
-  dumpi_addr_iterator libdumpi_addr_begin_iterator();
-
-  /** Test whether an iterator is valid */
-  int libdumpi_addr_valid_iterator(const dumpi_addr_iterator *it);
+  int32_t libdumpi_insert_address(void *address,
+				  dumpi_addr_classifier classify);
 
   /**
-   * Increment the given iterator.
-   * return non-zero if the iterator is still valid after increment.
+   * Get a copy of the addresses on the list whose stored value is
+   * non-zero.  It is the responsibility of the caller to free the array.
+   * \param count  set to the number of addresses in the array.
    */
-  int libdumpi_addr_increment_iterator(dumpi_addr_iterator *it);
-
-  /* Dereference the given iterator. */
-  uint64_t libdumpi_addr_iterator_value(const dumpi_addr_iterator *it);
+  uint64_t* libdumpi_addr_snapshot(int *count);
 
   /*@}*/
 
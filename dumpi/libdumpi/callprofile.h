@@ -37,7 +37,6 @@ extern "C" {
   
   /**
    * Indicate exit from a profiled function.
-   * If this reduces the call depth to zero, force output to a trace file.
    */
   void DUMPI_SKIP_INSTRUMENTING
   __cyg_profile_func_exit(void *fn, void *site);
@@ -49,6 +48,12 @@ extern "C" {
    */
   void libdumpi_insert_data(uint64_t key, const char *data);
 
+  /**
+   * Get the symbol name at the given program position, or NULL if it is
+   * not known (always NULL on systems that do not support dladdr).
+   */
+  const char* DUMPI_SKIP_INSTRUMENTING dumpi_symbol_name(uint64_t fn);
+
   /**
    * Get the function name associated with the given program position.
    * Only works on systems that support dladdr -- otherwise returns the
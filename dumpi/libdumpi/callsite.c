@@ -0,0 +1,201 @@
+/*
+ *  This file is part of DUMPI:
+ *               The MPI profiling library from the SST suite.
+ *  Copyright (c) 2009-2011 Sandia Corporation.
+ *  This software is distributed under the BSD License.
+ *  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+ *  the U.S. Government retains certain rights in this software.
+ *  For more information, see the LICENSE file in the top
+ *  SST/macroscale directory.
+ */
+
+#include <dumpi/libdumpi/callsite.h>
+#include <dumpi/libdumpi/callprofile.h>
+#include <dumpi/libdumpi/mpibindings-utils.h>
+#include <dumpi/libdumpi/data.h>
+#include <dumpi/common/settings.h>
+#include <dumpi/dumpiconfig.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#ifdef DUMPI_HAVE_BACKTRACE
+#include <execinfo.h>
+#endif /* DUMPI_HAVE_BACKTRACE */
+
+#ifdef DUMPI_USE_PTHREADS
+#include <pthread.h>
+static pthread_mutex_t path_lock = PTHREAD_MUTEX_INITIALIZER;
+#define LOCK_PATHS()   assert(pthread_mutex_lock(&path_lock) == 0)
+#define UNLOCK_PATHS() assert(pthread_mutex_unlock(&path_lock) == 0)
+#else /* ! DUMPI_USE_PTHREADS */
+#define LOCK_PATHS()
+#define UNLOCK_PATHS()
+#endif /* ! DUMPI_USE_PTHREADS */
+
+#define PATH_MIN_CAPACITY 256
+
+/* One distinct call path;  the id of paths[i] is i+1. */
+typedef struct callsite_path {
+  uint64_t hash;
+  int      depth;
+  void   **frames;
+} callsite_path;
+
+/* All paths in order of discovery, plus an open-addressing index of
+ * their ids (0 marks an empty slot).  Protected by path_lock. */
+static callsite_path *paths = NULL;
+static uint32_t path_count = 0, path_capacity = 0;
+static uint32_t *slots = NULL;
+static size_t slot_capacity = 0;
+/* Paths already handed to the annotation table */
+static uint32_t published = 0;
+
+/* FNV-1a over the return addresses. */
+static uint64_t hash_frames(void **frames, int depth) {
+  uint64_t hash = 14695981039346656037ull;
+  int i;
+  for(i = 0; i < depth; ++i) {
+    hash ^= (uint64_t)(uintptr_t)frames[i];
+    hash *= 1099511628211ull;
+  }
+  return hash;
+}
+
+static int same_path(const callsite_path *path, uint64_t hash,
+		     void **frames, int depth)
+{
+  return (path->hash == hash && path->depth == depth &&
+	  memcmp(path->frames, frames, depth * sizeof(void*)) == 0);
+}
+
+/* Double the index (keeping the load below one half). */
+static void grow_slots(void) {
+  uint32_t id;
+  size_t slot;
+  free(slots);
+  slot_capacity = (slot_capacity ? 2*slot_capacity : 2*PATH_MIN_CAPACITY);
+  slots = (uint32_t*)calloc(slot_capacity, sizeof(uint32_t));
+  assert(slots != NULL);
+  for(id = 1; id <= path_count; ++id) {
+    slot = paths[id-1].hash & (slot_capacity - 1);
+    while(slots[slot] != 0)
+      slot = (slot + 1) & (slot_capacity - 1);
+    slots[slot] = id;
+  }
+}
+
+/* Find the id of a path, adding it if it is new.
+ * Returns 0 once the table is full. */
+static uint32_t intern_path(void **frames, int depth) {
+  uint64_t hash = hash_frames(frames, depth);
+  uint32_t id = 0;
+  size_t slot;
+  LOCK_PATHS();
+  if(slot_capacity == 0)
+    grow_slots();
+  slot = hash & (slot_capacity - 1);
+  while(slots[slot] != 0) {
+    if(same_path(&paths[slots[slot]-1], hash, frames, depth)) {
+      id = slots[slot];
+      break;
+    }
+    slot = (slot + 1) & (slot_capacity - 1);
+  }
+  if(id == 0 && path_count < DUMPI_CALLSITE_MAX_PATHS) {
+    callsite_path *path;
+    if(path_count == path_capacity) {
+      path_capacity = (path_capacity ? 2*path_capacity : PATH_MIN_CAPACITY);
+      paths = (callsite_path*)realloc(paths,
+				      path_capacity * sizeof(callsite_path));
+      assert(paths != NULL);
+    }
+    path = &paths[path_count];
+    path->hash = hash;
+    path->depth = depth;
+    path->frames = (void**)malloc(depth * sizeof(void*));
+    assert(path->frames != NULL);
+    memcpy(path->frames, frames, depth * sizeof(void*));
+    id = ++path_count;
+    slots[slot] = id;
+    if(2*path_count > slot_capacity)
+      grow_slots();
+  }
+  UNLOCK_PATHS();
+  return id;
+}
+
+/* Set the capture depth. */
+int libdumpi_callsite_set_depth(int depth) {
+  if(depth < 0 || depth > DUMPI_CALLSITE_MAX_DEPTH)
+    return 0;
+#ifndef DUMPI_HAVE_BACKTRACE
+  if(depth > 0) {
+    fprintf(stderr, "dumpi:  This build cannot capture call sites "
+	    "(callsites ignored)\n");
+    depth = 0;
+  }
+#endif /* ! DUMPI_HAVE_BACKTRACE */
+  dumpi_global->callsites = depth;
+  return 1;
+}
+
+/*
+ * frames[0] lies in this function and frames[1] in the MPI binding that
+ * called it;  the path starts at frames[2], the call site in the
+ * application (or in the Fortran wrapper).
+ */
+void libdumpi_callsite_capture(void) {
+#ifdef DUMPI_HAVE_BACKTRACE
+  void *frames[DUMPI_CALLSITE_MAX_DEPTH + 2];
+  int got = backtrace(frames, dumpi_global->callsites + 2);
+  if(got > 2)
+    libdumpi_set_callsite(intern_path(frames+2, got-2));
+#endif /* DUMPI_HAVE_BACKTRACE */
+}
+
+/* Describe one path as "CALLSITE: frame <- frame <- ...". */
+static char* describe_path(const callsite_path *path) {
+  char *text, **symbols = NULL;
+  size_t length = 16;
+  int i;
+#ifdef DUMPI_HAVE_BACKTRACE
+  symbols = backtrace_symbols(path->frames, path->depth);
+#endif /* DUMPI_HAVE_BACKTRACE */
+  for(i = 0; i < path->depth; ++i)
+    length += (symbols ? strlen(symbols[i]) : 0) + 24;
+  text = (char*)malloc(length);
+  assert(text != NULL);
+  strcpy(text, "CALLSITE: ");
+  for(i = 0; i < path->depth; ++i) {
+    size_t used = strlen(text);
+    if(symbols)
+      snprintf(text+used, length-used, "%s%s", (i ? " <- " : ""), symbols[i]);
+    else
+      snprintf(text+used, length-used, "%s[%p]", (i ? " <- " : ""),
+	       path->frames[i]);
+  }
+  free(symbols);
+  return text;
+}
+
+/* Hand new paths to the annotation table. */
+void libdumpi_callsite_publish(void) {
+  LOCK_PATHS();
+  for(; published < path_count; ++published) {
+    char *text = describe_path(&paths[published]);
+    libdumpi_insert_data(DUMPI_CALLSITE_KEY(published+1), text);
+    free(text);
+  }
+  UNLOCK_PATHS();
+}
+
+/* Number of distinct paths. */
+uint32_t libdumpi_callsite_count(void) {
+  uint32_t count;
+  LOCK_PATHS();
+  count = path_count;
+  UNLOCK_PATHS();
+  return count;
+}
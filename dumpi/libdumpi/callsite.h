@@ -0,0 +1,69 @@
+/*
+ *  This file is part of DUMPI:
+ *               The MPI profiling library from the SST suite.
+ *  Copyright (c) 2009-2011 Sandia Corporation.
+ *  This software is distributed under the BSD License.
+ *  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+ *  the U.S. Government retains certain rights in this software.
+ *  For more information, see the LICENSE file in the top
+ *  SST/macroscale directory.
+ */
+
+#ifndef DUMPI_LIBDUMPI_CALLSITE_H
+#define DUMPI_LIBDUMPI_CALLSITE_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* ! __cplusplus */
+
+  /**
+   * \addtogroup libdumpi_internal
+   */
+  /*@{*/
+
+  /** The deepest call path recorded (callsites) */
+#define DUMPI_CALLSITE_MAX_DEPTH 16
+
+  /**
+   * Distinct call paths kept per rank.  Calls from paths seen after the
+   * table is full are recorded without a call-site id.
+   */
+#define DUMPI_CALLSITE_MAX_PATHS 65536
+
+  /**
+   * Set the number of return addresses captured per call (callsites).
+   * 0 turns capture off, as does a build without backtrace().
+   * \return non-zero if the depth was valid.
+   */
+  int libdumpi_callsite_set_depth(int depth);
+
+  /**
+   * Capture the call path of the MPI function that called this function
+   * and make its id the calling thread's current call site (written with
+   * the record of the call, see libdumpi_set_callsite).  Must be called
+   * directly from the MPI binding, so the binding's frame can be dropped
+   * along with this one.  Used by DUMPI_INSERT_PREAMBLE.
+   */
+  void libdumpi_callsite_capture(void);
+
+  /**
+   * Add the call paths seen since the last call to the annotation table,
+   * so they end up in the function-address record under
+   * DUMPI_CALLSITE_KEY(id).  Called before the record is written.
+   */
+  void libdumpi_callsite_publish(void);
+
+  /**
+   * Number of distinct call paths seen so far.
+   */
+  uint32_t libdumpi_callsite_count(void);
+
+  /*@}*/
+
+#ifdef __cplusplus
+} /* end of extern "C" */
+#endif /* ! __cplusplus */
+
+#endif /* ! DUMPI_LIBDUMPI_CALLSITE_H */
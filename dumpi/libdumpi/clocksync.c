@@ -0,0 +1,143 @@
+/*
+ *  This file is part of DUMPI:
+ *               The MPI profiling library from the SST suite.
+ *  Copyright (c) 2009-2011 Sandia Corporation.
+ *  This software is distributed under the BSD License.
+ *  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+ *  the U.S. Government retains certain rights in this software.
+ *  For more information, see the LICENSE file in the top
+ *  SST/macroscale directory.
+ */
+
+#include <dumpi/libdumpi/clocksync.h>
+#include <dumpi/libdumpi/data.h>
+#include <dumpi/common/clocksync.h>
+#include <dumpi/common/gettime.h>
+#include <dumpi/common/debugflags.h>
+#include <mpi.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#define NSEC_PER_SEC 1000000000LL
+#define CLOCKSYNC_TAG 0xC10C
+
+/* Runs shorter than this give no drift (the error would swamp it) */
+#define CLOCKSYNC_MIN_SPAN NSEC_PER_SEC
+
+/* One exchange:  local time halfway through the best round trip,
+ * rank 0 time minus local time there, and the round trip itself */
+typedef struct sync_point {
+  int64_t at, offset, rtt;
+} sync_point;
+
+/* Settings (from the configuration) */
+static int enabled = 0;
+static int rounds = 8;
+
+static MPI_Comm sync_comm = MPI_COMM_NULL;
+static sync_point points[2];
+static int measured = 0;
+
+void libdumpi_clocksync_enable(int enable) {
+  enabled = enable;
+}
+
+int libdumpi_clocksync_rounds(const char *value) {
+  char *end;
+  long count = strtol(value, &end, 10);
+  if(end == value || *end != '\0' || count < 1 || count > 1000)
+    return 0;
+  rounds = (int)count;
+  return 1;
+}
+
+static int64_t wall_now(void) {
+  dumpi_clock cpu, wall;
+  dumpi_get_time(&cpu, &wall);
+  return (int64_t)wall.sec * NSEC_PER_SEC + wall.nsec;
+}
+
+/* Rank 0 answers each round of each rank with its wall time;  the others
+ * keep the round with the shortest trip. */
+static void exchange(sync_point *point) {
+  int rank, size, peer, i;
+  int64_t start, stop, ref;
+  PMPI_Comm_rank(sync_comm, &rank);
+  PMPI_Comm_size(sync_comm, &size);
+  if(rank == 0) {
+    for(peer = 1; peer < size; ++peer) {
+      for(i = 0; i < rounds; ++i) {
+	PMPI_Recv(NULL, 0, MPI_BYTE, peer, CLOCKSYNC_TAG, sync_comm,
+		  MPI_STATUS_IGNORE);
+	ref = wall_now();
+	PMPI_Send(&ref, 1, MPI_LONG_LONG_INT, peer, CLOCKSYNC_TAG, sync_comm);
+      }
+    }
+    point->at = wall_now();
+    point->offset = point->rtt = 0;
+    return;
+  }
+  point->rtt = -1;
+  for(i = 0; i < rounds; ++i) {
+    start = wall_now();
+    PMPI_Send(NULL, 0, MPI_BYTE, 0, CLOCKSYNC_TAG, sync_comm);
+    PMPI_Recv(&ref, 1, MPI_LONG_LONG_INT, 0, CLOCKSYNC_TAG, sync_comm,
+	      MPI_STATUS_IGNORE);
+    stop = wall_now();
+    if(point->rtt < 0 || stop - start < point->rtt) {
+      point->rtt = stop - start;
+      point->at = start + point->rtt / 2;
+      point->offset = ref - point->at;
+    }
+  }
+}
+
+void libdumpi_clocksync_start(void) {
+  if(! enabled || measured > 0)
+    return;
+  PMPI_Comm_dup(MPI_COMM_WORLD, &sync_comm);
+  exchange(&points[measured++]);
+  if(dumpi_debug & DUMPI_DEBUG_LIBDUMPI)
+    fprintf(stderr, "[DUMPI-LIBDUMPI]: clock offset %lld ns "
+	    "(round trip %lld ns)\n", (long long)points[0].offset,
+	    (long long)points[0].rtt);
+}
+
+void libdumpi_clocksync_finish(void) {
+  if(sync_comm == MPI_COMM_NULL)
+    return;
+  exchange(&points[measured++]);
+  PMPI_Comm_free(&sync_comm);
+  if(dumpi_debug & DUMPI_DEBUG_LIBDUMPI)
+    fprintf(stderr, "[DUMPI-LIBDUMPI]: clock offset %lld ns "
+	    "(round trip %lld ns)\n", (long long)points[1].offset,
+	    (long long)points[1].rtt);
+}
+
+void libdumpi_clocksync_record(void) {
+  char val[64];
+  double drift = 0;
+  int64_t rtt, span;
+  if(measured == 0 || dumpi_global->keyval == NULL)
+    return;
+  rtt = points[0].rtt;
+  if(measured > 1) {
+    span = points[1].at - points[0].at;
+    if(span >= CLOCKSYNC_MIN_SPAN)
+      drift = (double)(points[1].offset - points[0].offset) / (double)span;
+    if(points[1].rtt > rtt)
+      rtt = points[1].rtt;
+  }
+  snprintf(val, sizeof(val), "%lld.%09lld",
+	   (long long)(points[0].at / NSEC_PER_SEC),
+	   (long long)(points[0].at % NSEC_PER_SEC));
+  dumpi_push_keyval_entry(dumpi_global->keyval, DUMPI_CLOCK_SYNC_TIME_KEY, val);
+  snprintf(val, sizeof(val), "%.9f", 1e-9 * (double)points[0].offset);
+  dumpi_push_keyval_entry(dumpi_global->keyval, DUMPI_CLOCK_OFFSET_KEY, val);
+  snprintf(val, sizeof(val), "%.6e", drift);
+  dumpi_push_keyval_entry(dumpi_global->keyval, DUMPI_CLOCK_DRIFT_KEY, val);
+  snprintf(val, sizeof(val), "%.9f", 0.5e-9 * (double)rtt);
+  dumpi_push_keyval_entry(dumpi_global->keyval, DUMPI_CLOCK_ERROR_KEY, val);
+}
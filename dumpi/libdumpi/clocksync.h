@@ -0,0 +1,65 @@
+/*
+ *  This file is part of DUMPI:
+ *               The MPI profiling library from the SST suite.
+ *  Copyright (c) 2009-2011 Sandia Corporation.
+ *  This software is distributed under the BSD License.
+ *  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+ *  the U.S. Government retains certain rights in this software.
+ *  For more information, see the LICENSE file in the top
+ *  SST/macroscale directory.
+ */
+
+#ifndef DUMPI_LIBDUMPI_CLOCKSYNC_H
+#define DUMPI_LIBDUMPI_CLOCKSYNC_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* ! __cplusplus */
+
+  /**
+   * \addtogroup libdumpi_internal
+   */
+  /*@{*/
+
+  /**
+   * Turn the clock exchange at MPI_Init and MPI_Finalize on or off
+   * (clock-sync enable|disable, off by default).
+   */
+  void libdumpi_clocksync_enable(int enable);
+
+  /**
+   * Set the number of round trips to rank 0 per exchange
+   * (clock-sync-rounds, 8 by default).
+   * \return non-zero if the value was valid.
+   */
+  int libdumpi_clocksync_rounds(const char *value);
+
+  /**
+   * Measure the offset of the wall clock from that of rank 0 (if
+   * enabled).  Rank 0 trades the configured number of round trips with
+   * each other rank in turn, on a duplicate of MPI_COMM_WORLD, and each
+   * rank keeps the round trip that took the least time.
+   * Collective over MPI_COMM_WORLD;  called right after PMPI_Init.
+   */
+  void libdumpi_clocksync_start(void);
+
+  /**
+   * Measure the offset again, which gives the drift of the clock since
+   * libdumpi_clocksync_start.  Collective over MPI_COMM_WORLD;  called
+   * right before PMPI_Finalize.
+   */
+  void libdumpi_clocksync_finish(void);
+
+  /**
+   * Store the offset and drift in the keyval record
+   * (see common/clocksync.h).
+   */
+  void libdumpi_clocksync_record(void);
+
+  /*@}*/
+
+#ifdef __cplusplus
+} /* end of extern "C" */
+#endif /* ! __cplusplus */
+
+#endif /* ! DUMPI_LIBDUMPI_CLOCKSYNC_H */
@@ -0,0 +1,257 @@
+/*
+ *  This file is part of DUMPI:
+ *               The MPI profiling library from the SST suite.
+ *  Copyright (c) 2009-2011 Sandia Corporation.
+ *  This software is distributed under the BSD License.
+ *  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+ *  the U.S. Government retains certain rights in this software.
+ *  For more information, see the LICENSE file in the top
+ *  SST/macroscale directory.
+ */
+
+#include <dumpi/libdumpi/commmatrix.h>
+#include <dumpi/libdumpi/aggregate.h>
+#include <dumpi/libdumpi/mpibindings-utils.h>
+#include <dumpi/libdumpi/data.h>
+#include <dumpi/common/debugflags.h>
+#include <dumpi/dumpiconfig.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <assert.h>
+
+#define MATRIX_MIN_CAPACITY 16
+
+#ifndef DUMPI_SKIP_MPI_COMM_CREATE_KEYVAL
+/* Attribute holding the world ranks of a communicator's (remote) group,
+ * so ranks only have to be translated once per communicator.
+ * MPI frees the attribute along with the communicator. */
+static int world_keyval = MPI_KEYVAL_INVALID;
+
+static int free_world_ranks(MPI_Comm comm, int keyval, void *value,
+			    void *extra)
+{
+  (void)comm; (void)keyval; (void)extra;
+  free(value);
+  return MPI_SUCCESS;
+}
+#endif /* ! DUMPI_SKIP_MPI_COMM_CREATE_KEYVAL */
+
+/* The group that destination ranks of comm refer to. */
+static void peer_group(MPI_Comm comm, MPI_Group *group) {
+  int inter = 0;
+  PMPI_Comm_test_inter(comm, &inter);
+  if(inter)
+    PMPI_Comm_remote_group(comm, group);
+  else
+    PMPI_Comm_group(comm, group);
+}
+
+/* Translate ranks of the given group to MPI_COMM_WORLD. */
+static void translate(MPI_Group group, int count, int *ranks, int *world) {
+  MPI_Group world_group;
+  PMPI_Comm_group(MPI_COMM_WORLD, &world_group);
+  PMPI_Group_translate_ranks(group, count, ranks, world_group, world);
+  PMPI_Group_free(&world_group);
+}
+
+/* The rank in MPI_COMM_WORLD of rank dest in comm (MPI_UNDEFINED for
+ * processes outside MPI_COMM_WORLD). */
+static int world_rank(int dest, MPI_Comm comm) {
+  MPI_Group group;
+  int result;
+  if(comm == MPI_COMM_WORLD)
+    return dest;
+#ifndef DUMPI_SKIP_MPI_COMM_CREATE_KEYVAL
+  if(world_keyval != MPI_KEYVAL_INVALID) {
+    int *world, found = 0, size, i;
+    PMPI_Comm_get_attr(comm, world_keyval, &world, &found);
+    if(! found) {
+      peer_group(comm, &group);
+      PMPI_Group_size(group, &size);
+      world = (int*)malloc(2 * size * sizeof(int));
+      assert(world != NULL);
+      for(i = 0; i < size; ++i)
+	world[size+i] = i;
+      translate(group, size, world+size, world);
+      PMPI_Group_free(&group);
+      PMPI_Comm_set_attr(comm, world_keyval, world);
+    }
+    return world[dest];
+  }
+#endif /* ! DUMPI_SKIP_MPI_COMM_CREATE_KEYVAL */
+  peer_group(comm, &group);
+  translate(group, 1, &dest, &result);
+  PMPI_Group_free(&group);
+  return result;
+}
+
+/* Set up the attribute that caches world ranks. */
+void libdumpi_matrix_start(void) {
+#ifndef DUMPI_SKIP_MPI_COMM_CREATE_KEYVAL
+  if(world_keyval == MPI_KEYVAL_INVALID)
+    PMPI_Comm_create_keyval(MPI_COMM_NULL_COPY_FN, free_world_ranks,
+			    &world_keyval, NULL);
+#endif /* ! DUMPI_SKIP_MPI_COMM_CREATE_KEYVAL */
+}
+
+/* Count a point-to-point send. */
+void libdumpi_matrix_send(int dest, int count, MPI_Datatype type,
+			  MPI_Comm comm)
+{
+  int peer;
+  if(dest == MPI_PROC_NULL || dest < 0 || comm == MPI_COMM_NULL)
+    return;
+  peer = world_rank(dest, comm);
+  if(peer == MPI_UNDEFINED || peer < 0)
+    return;
+  libdumpi_matrix_add(libdumpi_get_matrix(), peer, 1,
+		      (uint64_t)libdumpi_bytes(count, type));
+}
+
+static size_t slot_of(const libdumpi_matrix *table, int peer) {
+  size_t slot = ((uint32_t)peer * 2654435761u) & (table->capacity - 1);
+  while(table->entries[slot].peer != peer && table->entries[slot].peer >= 0)
+    slot = (slot + 1) & (table->capacity - 1);
+  return slot;
+}
+
+/* Double the number of slots (keeping the load below one half). */
+static void grow(libdumpi_matrix *table) {
+  size_t i, old_capacity = table->capacity;
+  libdumpi_matrix_entry *old = table->entries;
+  table->capacity = (old_capacity ? 2*old_capacity : MATRIX_MIN_CAPACITY);
+  table->entries = (libdumpi_matrix_entry*)
+    malloc(table->capacity * sizeof(libdumpi_matrix_entry));
+  assert(table->entries != NULL);
+  for(i = 0; i < table->capacity; ++i)
+    table->entries[i].peer = -1;
+  for(i = 0; i < old_capacity; ++i)
+    if(old[i].peer >= 0)
+      table->entries[slot_of(table, old[i].peer)] = old[i];
+  free(old);
+}
+
+/* Add traffic to one peer. */
+void libdumpi_matrix_add(libdumpi_matrix *table, int peer,
+			 uint64_t messages, uint64_t bytes)
+{
+  libdumpi_matrix_entry *entry;
+  if(2*(table->used+1) > table->capacity)
+    grow(table);
+  entry = &table->entries[slot_of(table, peer)];
+  if(entry->peer < 0) {
+    entry->peer = peer;
+    entry->messages = 0;
+    entry->bytes = 0;
+    ++table->used;
+  }
+  entry->messages += messages;
+  entry->bytes += bytes;
+}
+
+/* Add a thread's table to the totals. */
+void libdumpi_matrix_merge(libdumpi_matrix *total,
+			   const libdumpi_matrix *table)
+{
+  size_t i;
+  for(i = 0; i < table->capacity; ++i)
+    if(table->entries[i].peer >= 0)
+      libdumpi_matrix_add(total, table->entries[i].peer,
+			  table->entries[i].messages, table->entries[i].bytes);
+}
+
+/* Free a thread's table. */
+void libdumpi_matrix_release(libdumpi_matrix *table) {
+  free(table->entries);
+  memset(table, 0, sizeof(libdumpi_matrix));
+}
+
+/* Order gathered rows by destination. */
+static int compare_rows(const void *a, const void *b) {
+  int64_t pa = ((const int64_t*)a)[0], pb = ((const int64_t*)b)[0];
+  return (pa < pb ? -1 : (pa > pb ? 1 : 0));
+}
+
+/*
+ * Each rank sends its non-zero entries as (destination, messages, bytes)
+ * triples;  rank 0 writes one line per triple:
+ *     source destination messages bytes
+ * sorted by source and then destination.
+ */
+int libdumpi_matrix_write(void) {
+  int rank, size, rows, i, src, retval = 1;
+  int *counts = NULL, *displs = NULL;
+  char fname[512];
+  int64_t *local, *all = NULL;
+  size_t slot, pos = 0;
+  libdumpi_matrix total;
+  memset(&total, 0, sizeof(libdumpi_matrix));
+  libdumpi_collect_matrix(&total);
+  PMPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  PMPI_Comm_size(MPI_COMM_WORLD, &size);
+  rows = (int)total.used;
+  local = (int64_t*)malloc((3*rows + 1) * sizeof(int64_t));
+  assert(local != NULL);
+  for(slot = 0; slot < total.capacity; ++slot) {
+    if(total.entries[slot].peer >= 0) {
+      local[pos++] = total.entries[slot].peer;
+      local[pos++] = (int64_t)total.entries[slot].messages;
+      local[pos++] = (int64_t)total.entries[slot].bytes;
+    }
+  }
+  libdumpi_matrix_release(&total);
+  qsort(local, rows, 3*sizeof(int64_t), compare_rows);
+  rows *= 3;
+  if(rank == 0) {
+    counts = (int*)malloc(size * sizeof(int));
+    displs = (int*)malloc(size * sizeof(int));
+    assert(counts != NULL && displs != NULL);
+  }
+  PMPI_Gather(&rows, 1, MPI_INT, counts, 1, MPI_INT, 0, MPI_COMM_WORLD);
+  if(rank == 0) {
+    int64_t totalrows = 0;
+    for(i = 0; i < size; ++i) {
+      displs[i] = (int)totalrows;
+      totalrows += counts[i];
+    }
+    all = (int64_t*)malloc((totalrows + 1) * sizeof(int64_t));
+    assert(all != NULL);
+  }
+  PMPI_Gatherv(local, rows, MPI_LONG_LONG_INT,
+	       all, counts, displs, MPI_LONG_LONG_INT, 0, MPI_COMM_WORLD);
+  free(local);
+  if(rank == 0) {
+    FILE *fp;
+    snprintf(fname, sizeof(fname), "%s.matrix",
+	     (dumpi_global->file_root ? dumpi_global->file_root : "dumpi"));
+    fp = fopen(fname, "w");
+    if(fp == NULL) {
+      fprintf(stderr, "libdumpi_matrix_write:  Failed to open \"%s\" for "
+	      "writing:  errno=%d (%s)\n", fname, errno, strerror(errno));
+      retval = 0;
+    }
+    else {
+      if(dumpi_debug & DUMPI_DEBUG_TRACEIO)
+	fprintf(stderr, "[DUMPI-IO] libdumpi_matrix_write(\"%s\")\n", fname);
+      fprintf(fp, "# DUMPI point-to-point communication matrix\n"
+	      "# ranks=%d\n# source destination messages bytes\n", size);
+      for(src = 0; src < size; ++src)
+	for(i = displs[src]; i < displs[src] + counts[src]; i += 3)
+	  fprintf(fp, "%d %lld %lld %lld\n", src, (long long)all[i],
+		  (long long)all[i+1], (long long)all[i+2]);
+      if(ferror(fp)) {
+	fprintf(stderr, "libdumpi_matrix_write:  Failed to write \"%s\"\n",
+		fname);
+	retval = 0;
+      }
+      if(fclose(fp) != 0)
+	retval = 0;
+    }
+    free(all);
+    free(counts);
+    free(displs);
+  }
+  return retval;
+}
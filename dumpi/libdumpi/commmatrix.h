@@ -0,0 +1,94 @@
+/*
+ *  This file is part of DUMPI:
+ *               The MPI profiling library from the SST suite.
+ *  Copyright (c) 2009-2011 Sandia Corporation.
+ *  This software is distributed under the BSD License.
+ *  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+ *  the U.S. Government retains certain rights in this software.
+ *  For more information, see the LICENSE file in the top
+ *  SST/macroscale directory.
+ */
+
+#ifndef DUMPI_LIBDUMPI_COMMMATRIX_H
+#define DUMPI_LIBDUMPI_COMMMATRIX_H
+
+#include <mpi.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* ! __cplusplus */
+
+  /**
+   * \addtogroup libdumpi_internal
+   */
+  /*@{*/
+
+  /**
+   * Point-to-point traffic from this rank to one peer (comm-matrix).
+   */
+  typedef struct libdumpi_matrix_entry {
+    /** Destination rank in MPI_COMM_WORLD;  -1 marks an empty slot */
+    int32_t  peer;
+    uint64_t messages, bytes;
+  } libdumpi_matrix_entry;
+
+  /**
+   * A sparse row of the communication matrix:  an open-addressing hash
+   * table keyed by world rank.  Each thread keeps one of these
+   * (see libdumpi_get_matrix).
+   */
+  typedef struct libdumpi_matrix {
+    /** Number of peers in the table */
+    size_t                 used;
+    /** Number of slots (zero or a power of two) */
+    size_t                 capacity;
+    libdumpi_matrix_entry *entries;
+  } libdumpi_matrix;
+
+  /**
+   * Set up the communicator attribute that caches world ranks.
+   * Called once MPI is initialized.
+   */
+  void libdumpi_matrix_start(void);
+
+  /**
+   * Count a message of count elements of the given type sent to rank dest
+   * of comm.  Used by DUMPI_MATRIX_SEND.
+   */
+  void libdumpi_matrix_send(int dest, int count, MPI_Datatype type,
+			    MPI_Comm comm);
+
+  /**
+   * Add messages and bytes sent to a world rank to the table.
+   */
+  void libdumpi_matrix_add(libdumpi_matrix *table, int peer,
+			   uint64_t messages, uint64_t bytes);
+
+  /**
+   * Add all entries of a thread's table to the given totals.
+   */
+  void libdumpi_matrix_merge(libdumpi_matrix *total,
+			     const libdumpi_matrix *table);
+
+  /**
+   * Free the table of a thread.
+   */
+  void libdumpi_matrix_release(libdumpi_matrix *table);
+
+  /**
+   * Gather the tables of all ranks to rank 0, which writes them to
+   * fileroot.matrix.  Collective over MPI_COMM_WORLD;  must be called
+   * before PMPI_Finalize.
+   * \return non-zero on success (always non-zero on ranks other than 0).
+   */
+  int libdumpi_matrix_write(void);
+
+  /*@}*/
+
+#ifdef __cplusplus
+} /* end of extern "C" */
+#endif /* ! __cplusplus */
+
+#endif /* ! DUMPI_LIBDUMPI_COMMMATRIX_H */
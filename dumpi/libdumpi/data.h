@@ -17,6 +17,7 @@
 #include <dumpi/common/io.h>
 #include <dumpi/common/constants.h>
 #include <dumpi/dumpiconfig.h>
+#include <time.h>
 
 #ifdef DUMPI_USE_PTHREADS
 #include <pthread.h>
@@ -68,6 +69,67 @@ extern "C" {
     const char          *output_file; /*fully qualified name*/
     int                  comm_rank;   /* MPI communicator rank. */
     int                  comm_size;   /* MPI communicator size. */
+    /* Per-function sampling (MPI_Foo=sample:N in dumpi.conf).
+     * A period of 0 means the function is not sampled. */
+    int                  sampling;    /* Non-zero if any function sampled */
+    uint32_t             sample_period[DUMPI_ALL_FUNCTIONS+1];
+    uint32_t             sample_count[DUMPI_ALL_FUNCTIONS+1];
+    /* Calls that libdumpi_sample_call left out (period or rate limit) */
+    uint32_t             sample_dropped[DUMPI_ALL_FUNCTIONS+1];
+    /* Upper bound on records per second for sampled functions (0: none) */
+    uint32_t             sample_rate_limit;
+    time_t               sample_window;
+    uint32_t             sample_window_used;
+    /* How much of the per-peer arrays of vector collectives to store
+     * (detail:MPI_Foo=full|summarized|sparse), a dumpi_arg_detail */
+    int8_t               arg_detail[DUMPI_ALL_FUNCTIONS+1];
+    /* Fold runs of unsuccessful polls into summary records (coalesce-polls) */
+    int                  coalesce_polls;
+    /* Decode statuses when the trace buffer is flushed (status-capture) */
+    int                  lazy_statuses;
+    /* Tracing windows (start-after, stop-after, ... see trigger.h).
+     * The next count or time trigger point is kept here for DUMPI_TRIGGER_DUE;
+     * trigger_func is DUMPI_END_OF_STREAM and trigger_time 0 if unset */
+    int                  triggers;
+    dumpi_function       trigger_func;
+    uint32_t             trigger_count;
+    time_t               trigger_time;
+    /* Flight recorder (mode=ringbuffer): keep only the most recent
+     * ring_window bytes of records; dump them on ring_signal (0: none)
+     * and, if ring_fatal, on fatal signals (see ringsignals.h) */
+    int                  ring_mode;
+    size_t               ring_window;
+    int                  ring_signal;
+    int                  ring_fatal;
+    /* Spill records written before the trace file opens to a temporary
+     * file once this many bytes are buffered (0: the buffer size) */
+    size_t               preinit_limit;
+    /* Write the traces of all ranks on a node to one node file
+     * (node-files enable; see nodewriter.h) */
+    int                  node_files;
+    /* Send the trace to a collector instead of writing it to a file
+     * (stream-to; see streamwriter.h) */
+    int                  stream;
+    /* Aggregate statistics instead of a trace (mode=profile);
+     * written to fileroot-NNNN.prof at finalize (see aggregate.h);
+     * cpu time is only read with aggregate_cpu (profile-cpu-time) */
+    int                  aggregate;
+    int                  aggregate_cpu;
+    /* Count point-to-point messages and bytes by destination world rank;
+     * gathered to fileroot.matrix at finalize (see commmatrix.h) */
+    int                  comm_matrix;
+    /* Flush the trace buffer at blocking collectives on MPI_COMM_WORLD
+     * and MPI_Pcontrol(4) (flush-policy collective; see flushpolicy.h) */
+    int                  flush_points;
+    /* Rank selection (trace-ranks, see rankselect.h):  an untraced rank
+     * only records the calls needed to rebuild communicators and types,
+     * plus the footer;  with untraced_profile it also writes statistics
+     * to fileroot-NNNN.prof */
+    int                  untraced;
+    int                  untraced_profile;
+    /* Return addresses captured per traced call (callsites, see
+     * callsite.h);  0 if call sites are not recorded */
+    int                  callsites;
   } dumpi_global_t;
 
   /**
@@ -0,0 +1,158 @@
+/*
+ *  This file is part of DUMPI:
+ *               The MPI profiling library from the SST suite.
+ *  Copyright (c) 2009-2011 Sandia Corporation.
+ *  This software is distributed under the BSD License.
+ *  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+ *  the U.S. Government retains certain rights in this software.
+ *  For more information, see the LICENSE file in the top
+ *  SST/macroscale directory.
+ */
+
+#include <dumpi/libdumpi/flushpolicy.h>
+#include <dumpi/libdumpi/annotation.h>
+#include <dumpi/libdumpi/mpibindings-utils.h>
+#include <dumpi/libdumpi/data.h>
+#include <dumpi/common/dumpiio.h>
+#include <dumpi/common/iodefs.h>
+#include <mpi.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#define FLUSH_ANNOTATION "DUMPI: trace buffer flush"
+
+/* Flushes waiting to be written to the trace */
+#ifndef DUMPI_PENDING_FLUSHES
+#define DUMPI_PENDING_FLUSHES 64
+#endif /* ! DUMPI_PENDING_FLUSHES */
+
+typedef struct flush_interval {
+  uint16_t   thread;
+  dumpi_time cpu, wall;
+} flush_interval;
+
+/* Settings (from the configuration) */
+static int collective = 0;
+static int margin = 25;
+static int together = 0;
+
+/* Flush bookkeeping.  Only touched with the io lock held. */
+static flush_interval pending[DUMPI_PENDING_FLUSHES];
+static int pending_count = 0;
+static uint64_t flushes = 0, scheduled = 0, dropped = 0;
+static uint64_t flush_key = 0;
+
+int libdumpi_flush_policy(const char *value) {
+  if(strcmp(value, "immediate") == 0)
+    collective = 0;
+  else if(strcmp(value, "collective") == 0)
+    collective = 1;
+  else
+    return 0;
+  return 1;
+}
+
+int libdumpi_flush_margin(const char *value) {
+  char *end;
+  long percent = strtol(value, &end, 10);
+  if(end == value || (*end != '\0' && strcmp(end, "%") != 0) ||
+     percent < 0 || percent > 100)
+    return 0;
+  margin = (int)percent;
+  return 1;
+}
+
+void libdumpi_flush_together(int enable) {
+  together = enable;
+}
+
+int libdumpi_flush_points_wanted(void) {
+  return collective;
+}
+
+/* Note a flush of the trace profile (the io lock is held). */
+static void note_flush(dumpi_profile *profile, const dumpi_time *cpu,
+		       const dumpi_time *wall)
+{
+  (void)profile;
+  ++flushes;
+  if(pending_count == DUMPI_PENDING_FLUSHES) {
+    ++dropped;
+    return;
+  }
+  pending[pending_count].thread = libdumpi_get_thread_id();
+  pending[pending_count].cpu = *cpu;
+  pending[pending_count].wall = *wall;
+  ++pending_count;
+}
+
+void libdumpi_flush_policy_start(dumpi_profile *profile) {
+  assert(profile != NULL);
+  flush_key = libdumpi_annotation_intern(FLUSH_ANNOTATION,
+					 strlen(FLUSH_ANNOTATION));
+  profile->flushed = note_flush;
+}
+
+/* Write the flushes noted so far (the io lock is held).  Writing can
+ * flush again, so work from a copy. */
+static void write_flushes(dumpi_profile *profile) {
+  flush_interval done[DUMPI_PENDING_FLUSHES];
+  dumpi_func_call stat;
+  int i, count = pending_count;
+  memcpy(done, pending, count * sizeof(flush_interval));
+  pending_count = 0;
+  stat.fn = flush_key;
+  for(i = 0; i < count; ++i) {
+    dumpi_time cpu_in = {done[i].cpu.start, done[i].cpu.start};
+    dumpi_time wall_in = {done[i].wall.start, done[i].wall.start};
+    dumpi_time cpu_out = {done[i].cpu.stop, done[i].cpu.stop};
+    dumpi_time wall_out = {done[i].wall.stop, done[i].wall.stop};
+    dumpi_write_func_enter(&stat, done[i].thread, &cpu_in, &wall_in, NULL,
+			   dumpi_global->output, profile);
+    dumpi_write_func_exit(&stat, done[i].thread, &cpu_out, &wall_out, NULL,
+			  dumpi_global->output, profile);
+  }
+}
+
+void libdumpi_flush_point(void) {
+  dumpi_profile *profile = dumpi_global->profile;
+  int due, any;
+  libdumpi_lock_io();
+  due = (profile->file != NULL &&
+	 dumpi_membuf_pos(profile) * 100 >=
+	 dumpi_membuf_capacity(profile) * (size_t)(100 - margin));
+  libdumpi_unlock_io();
+  if(together) {
+    PMPI_Allreduce(&due, &any, 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
+    due = any;
+  }
+  libdumpi_lock_io();
+  if(due && profile->file != NULL) {
+    ++scheduled;
+    DUMPI_FLUSH(profile);
+  }
+  if(pending_count > 0)
+    write_flushes(profile);
+  libdumpi_unlock_io();
+}
+
+void libdumpi_flush_policy_record(void) {
+  char val[64];
+  if(! dumpi_global->flush_points || dumpi_global->keyval == NULL)
+    return;
+  dumpi_push_keyval_entry(dumpi_global->keyval, "flush-policy", "collective");
+  snprintf(val, sizeof(val), "%d", margin);
+  dumpi_push_keyval_entry(dumpi_global->keyval, "flush-margin", val);
+  dumpi_push_keyval_entry(dumpi_global->keyval, "flush-together",
+			  (together ? "enable" : "disable"));
+  snprintf(val, sizeof(val), "%llu", (unsigned long long)scheduled);
+  dumpi_push_keyval_entry(dumpi_global->keyval, "flush-scheduled", val);
+  snprintf(val, sizeof(val), "%llu", (unsigned long long)(flushes - scheduled));
+  dumpi_push_keyval_entry(dumpi_global->keyval, "flush-forced", val);
+  if(dropped > 0) {
+    snprintf(val, sizeof(val), "%llu", (unsigned long long)dropped);
+    dumpi_push_keyval_entry(dumpi_global->keyval, "flush-unrecorded", val);
+  }
+}
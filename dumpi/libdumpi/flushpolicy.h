@@ -0,0 +1,78 @@
+/*
+ *  This file is part of DUMPI:
+ *               The MPI profiling library from the SST suite.
+ *  Copyright (c) 2009-2011 Sandia Corporation.
+ *  This software is distributed under the BSD License.
+ *  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+ *  the U.S. Government retains certain rights in this software.
+ *  For more information, see the LICENSE file in the top
+ *  SST/macroscale directory.
+ */
+
+#ifndef DUMPI_LIBDUMPI_FLUSHPOLICY_H
+#define DUMPI_LIBDUMPI_FLUSHPOLICY_H
+
+#include <dumpi/common/types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* ! __cplusplus */
+
+  /**
+   * \addtogroup libdumpi_internal
+   */
+  /*@{*/
+
+  /**
+   * Choose when the trace buffer is written to file (flush-policy):
+   * "immediate" flushes only when the buffer is full; "collective" also
+   * flushes at flush points (blocking collectives on MPI_COMM_WORLD and
+   * MPI_Pcontrol(4)) once the buffer is fuller than the margin allows.
+   * \return non-zero if the value was valid.
+   */
+  int libdumpi_flush_policy(const char *value);
+
+  /**
+   * Set the share of the buffer (in percent) kept free for the records
+   * written between flush points (flush-margin).
+   * \return non-zero if the value was valid.
+   */
+  int libdumpi_flush_margin(const char *value);
+
+  /**
+   * Let all ranks flush at a flush point as soon as one of them needs
+   * to (flush-together).  Costs an MPI_Allreduce per flush point.
+   */
+  void libdumpi_flush_together(int enable);
+
+  /**
+   * Non-zero if the configuration asks for flush points.
+   */
+  int libdumpi_flush_points_wanted(void);
+
+  /**
+   * Start watching the flushes of the trace profile.  Each flush is
+   * later written to the trace as an annotation pair (Function_enter and
+   * Function_exit of the key of the text "DUMPI: trace buffer flush")
+   * spanning the flush, so that analysis can mask it.
+   */
+  void libdumpi_flush_policy_start(dumpi_profile *profile);
+
+  /**
+   * A flush point (see DUMPI_FLUSH_POINT).  With flush-together, every
+   * rank must reach it.
+   */
+  void libdumpi_flush_point(void);
+
+  /**
+   * Note the settings and flush counts in the keyval record.
+   */
+  void libdumpi_flush_policy_record(void);
+
+  /*@}*/
+
+#ifdef __cplusplus
+} /* end of extern "C" */
+#endif /* ! __cplusplus */
+
+#endif /* ! DUMPI_LIBDUMPI_FLUSHPOLICY_H */
@@ -13,6 +13,20 @@
 #include <dumpi/libdumpi/data.h>
 #include <dumpi/libdumpi/callprofile.h>
 #include <dumpi/libdumpi/mpibindings-maps.h>
+#include <dumpi/libdumpi/mpibindings-utils.h>
+#include <dumpi/libdumpi/pollsummary.h>
+#include <dumpi/libdumpi/statuscapture.h>
+#include <dumpi/libdumpi/trigger.h>
+#include <dumpi/libdumpi/aggregate.h>
+#include <dumpi/libdumpi/commmatrix.h>
+#include <dumpi/libdumpi/rankselect.h>
+#include <dumpi/libdumpi/callsite.h>
+#include <dumpi/libdumpi/instrument.h>
+#include <dumpi/libdumpi/flushpolicy.h>
+#include <dumpi/libdumpi/nodewriter.h>
+#include <dumpi/libdumpi/streamwriter.h>
+#include <dumpi/libdumpi/clocksync.h>
+#include <dumpi/libdumpi/ringsignals.h>
 #include <dumpi/common/perfctrtags.h>
 #include <dumpi/common/perfctrs.h>
 #include <dumpi/common/io.h>
@@ -52,6 +66,22 @@ static void read_config(FILE* fp);
 static void open_output_file(void);
 static void process_keyval(const char *key, const char *value);
 static void create_meta_file(void);
+static void set_sampling(dumpi_function func, const char *value);
+static void set_sample_rate_limit(const char *value);
+static void set_arg_detail(const char *funcname, const char *value);
+static void record_sampling(void);
+static void set_trigger(libdumpi_trigger_kind kind, const char *key,
+			const char *value);
+static void record_triggers(void);
+static void set_ring_window(const char *value);
+static void set_ring_signal(const char *value);
+static void set_preinit_limit(const char *value);
+static void bad_size(const char *key, const char *value);
+static void record_ring(void);
+static void record_callsites(void);
+static void write_trailer(dumpi_profile *profile, int final);
+
+volatile sig_atomic_t libdumpi_snapshot_requested = 0;
 
 
 /****************************************************/
@@ -87,7 +117,7 @@ void libdumpi_init(void) {
     }
     /* Set any undefined configuration options to a reasonable value */
     default_config();
-    /* and initialize PAPI stuff (if requested and supported) */
+    /* and initialize performance counters (if requested and supported) */
     assert(dumpi_global != NULL);
     dumpi_init_perfctrs(dumpi_global->perf);
     /* Finally, initialize the profile but leave the file unopened */
@@ -98,6 +128,23 @@ void libdumpi_init(void) {
       int walloffset = wall.sec;
       dumpi_global->profile =
         dumpi_alloc_output_profile(cpuoffset, walloffset, 0);
+      dumpi_global->profile->spill_threshold = dumpi_global->preinit_limit;
+      if(dumpi_global->aggregate) {
+        /* Nothing gets written until the statistics at finalize */
+        libdumpi_aggregate_start();
+      }
+      else if(dumpi_global->ring_mode) {
+        /* Placeholders for lazy statuses can be dropped from the ring,
+         * and snapshots cannot call into MPI */
+        dumpi_membuf_ring_enable(dumpi_global->profile,
+                                 dumpi_global->ring_window);
+        libdumpi_ring_signals_start(dumpi_global->ring_signal,
+                                    dumpi_global->ring_fatal);
+      }
+      else if(dumpi_global->lazy_statuses)
+        libdumpi_enable_lazy_statuses(dumpi_global->profile);
+      if(dumpi_global->flush_points)
+        libdumpi_flush_policy_start(dumpi_global->profile);
     }
   }
   assert(atexit(libdumpi_finalize) == 0);
@@ -126,7 +173,10 @@ void libdumpi_open_files(void) {
     fprintf(stderr, "libdumpi_open_files:  Error:  MPI is not initialized.");
     abort();
   }
+  libdumpi_rankselect_apply();
   open_output_file();
+  if(dumpi_global->comm_matrix)
+    libdumpi_matrix_start();
   /* dumpi_start_stream_write(dumpi_global->profile); */
   create_meta_file();
   if(dumpi_debug & DUMPI_DEBUG_LIBDUMPI)
@@ -183,6 +233,8 @@ void dumpi_setup() {
     assert(pthread_mutex_init(&dumpi_global->mutex, NULL) == 0);
 #endif /* ! DUMPI_USE_PTHREADS */
     dumpi_global->comm_rank = -getpid();
+    dumpi_global->ring_signal = -1;
+    dumpi_global->ring_fatal = -1;
   }
   if(! dumpi_global->output) {
     init_global_output();
@@ -202,6 +254,8 @@ void init_global_output(void) {
     dumpi_global->output->function[i] = -1;
   dumpi_global->output->function[DUMPI_Function_enter] = 1;
   dumpi_global->output->function[DUMPI_Function_exit] = 1;
+  dumpi_global->output->function[DUMPI_Poll_summary] = 1;
+  dumpi_global->output->function[DUMPI_Function_call] = 1;
   /* Other storage field in the dumpi_global */
   /* Note that dumpi_build_header populates all its fields (inc. starttime) */
   dumpi_global->header = dumpi_build_header();
@@ -212,35 +266,98 @@ void init_global_output(void) {
   assert(dumpi_global->perf != NULL);
   dumpi_global->output->timestamps = -1;
   dumpi_global->output->statuses = -1;
+  dumpi_global->output->overhead = -1;
 }
 
 void dumpi_finish_profiling(void) {
+  if(dumpi_debug & DUMPI_DEBUG_LIBDUMPI)
+    fprintf(stderr, "[DUMPI-LIBDUMPI]: dumpi_finish_profiling entering\n");  
+  if(dumpi_global->aggregate) {
+    /* No trace, just the statistics */
+    libdumpi_aggregate_write(dumpi_global->output_file);
+    dumpi_free_output_profile(dumpi_global->profile);
+    dumpi_global->profile = NULL;
+    if(dumpi_debug & DUMPI_DEBUG_LIBDUMPI)
+      fprintf(stderr, "[DUMPI-LIBDUMPI]: libdumpi_finish_profiling returning\n");
+    return;
+  }
+  if(dumpi_global->untraced && dumpi_global->untraced_profile) {
+    /* Statistics next to the skeleton trace of an unselected rank */
+    char fname[1024];
+    snprintf(fname, sizeof(fname), "%s-%04d.prof",
+	     dumpi_global->file_root, dumpi_global->comm_rank);
+    libdumpi_aggregate_write(fname);
+  }
+  /* Pending poll summaries have to precede the end-of-stream marker */
+  if(dumpi_global->coalesce_polls) {
+    libdumpi_poll_close_all();
+    dumpi_global->coalesce_polls = 0;
+  }
+  if(dumpi_global->profile->ring) {
+    /* Replace any snapshot written through another file handle */
+    libdumpi_ring_signals_stop();
+    record_ring();
+    fflush(dumpi_global->profile->file);
+    assert(ftruncate(fileno(dumpi_global->profile->file), 0) == 0);
+    dumpi_membuf_ring_disable(dumpi_global->profile);
+  }
+  write_trailer(dumpi_global->profile, 1);
+  if(dumpi_global->node_files)
+    libdumpi_nodewriter_finish();
+  if(dumpi_debug & DUMPI_DEBUG_LIBDUMPI)
+    fprintf(stderr, "[DUMPI-LIBDUMPI]: libdumpi_finish_profiling returning\n");
+}
+
+/*
+ * Write the end of stream marker and all trailing records (header, footer,
+ * keyval, labels, and index) to the profile, then close its file.
+ * Writer statistics always come from the real trace profile.
+ */
+void write_trailer(dumpi_profile *profile, int final) {
   int i, addr_count;
   uint64_t *addrs = NULL;
   char **names = NULL;
-  if(dumpi_debug & DUMPI_DEBUG_LIBDUMPI)
-    fprintf(stderr, "[DUMPI-LIBDUMPI]: dumpi_finish_profiling entering\n");  
-  dumpi_write_header(dumpi_global->profile, dumpi_global->header);
-  dumpi_write_footer(dumpi_global->profile, dumpi_global->footer);
-  dumpi_write_keyval_record(dumpi_global->profile, dumpi_global->keyval);
-  dumpi_write_perfctr_labels(dumpi_global->profile,
+  dumpi_write_header(profile, dumpi_global->header);
+  /* Overhead and lock statistics are collected from all threads,
+   * buffer statistics are kept by the profile itself */
+  libdumpi_collect_overhead(dumpi_global->footer);
+  dumpi_global->footer->writer.bytes_written =
+    dumpi_global->profile->stats.bytes_written;
+  dumpi_global->footer->writer.flush_count =
+    dumpi_global->profile->stats.flush_count;
+  dumpi_global->footer->writer.flush_time =
+    dumpi_global->profile->stats.flush_time;
+  dumpi_write_footer(profile, dumpi_global->footer);
+  if(final) {
+    record_sampling();
+    record_triggers();
+    libdumpi_rankselect_record();
+    record_callsites();
+    libdumpi_instrument_record();
+    libdumpi_flush_policy_record();
+    libdumpi_nodewriter_record();
+    libdumpi_streamwriter_record();
+    libdumpi_clocksync_record();
+  }
+  dumpi_write_keyval_record(profile, dumpi_global->keyval);
+  dumpi_write_perfctr_labels(profile,
 			     dumpi_active_perfctrs(), dumpi_perfctr_labels());
-  dumpi_write_datatype_sizes(dumpi_global->profile, &dumpi_global->typesize);
+  dumpi_write_datatype_sizes(profile, &dumpi_global->typesize);
   /* Need to add an index entry in the same way as for perfctr labels */
+  if(dumpi_global->callsites)
+    libdumpi_callsite_publish();
   addr_count = dumpi_profile_unique_address_count();
   addrs = dumpi_profile_unique_addresses();
   names = (char**)calloc(addr_count+1, sizeof(const char*));
   assert(names != NULL);
   for(i = 0; i < addr_count; ++i)
     names[i] = strdup(dumpi_function_name(addrs[i]));
-  dumpi_write_function_addresses(dumpi_global->profile, 
+  dumpi_write_function_addresses(profile, 
 				 addr_count, addrs, names);
   free(addrs);
   for(i = 0; i < addr_count; ++i) free(names[i]);
   free(names);
-  dumpi_write_index(dumpi_global->profile);
-  if(dumpi_debug & DUMPI_DEBUG_LIBDUMPI)
-    fprintf(stderr, "[DUMPI-LIBDUMPI]: libdumpi_finish_profiling returning\n");
+  dumpi_write_index(profile);
 }
 
 /*
@@ -254,6 +371,14 @@ void default_config(void) {
     dumpi_global->output->timestamps = DUMPI_TIME_FULL;
   if(dumpi_global->output->statuses < 0)
     dumpi_global->output->statuses = DUMPI_ENABLE;
+  if(dumpi_global->output->overhead < 0)
+    dumpi_global->output->overhead = 0;
+  if(dumpi_global->ring_window == 0)
+    dumpi_global->ring_window = (size_t)64 << 20;
+  if(dumpi_global->ring_signal < 0)
+    dumpi_global->ring_signal = SIGUSR1;
+  if(dumpi_global->ring_fatal < 0)
+    dumpi_global->ring_fatal = 1;
   if(dumpi_global->output->function[DUMPI_ALL_FUNCTIONS] < 0)
     dumpi_global->output->function[DUMPI_ALL_FUNCTIONS] = DUMPI_ENABLE;
   for(fun = 0; fun < DUMPI_ALL_FUNCTIONS; ++fun)
@@ -261,6 +386,34 @@ void default_config(void) {
       dumpi_global->output->function[fun] = dumpi_global->output->function[DUMPI_ALL_FUNCTIONS];
   /* Turn stuff on by default -- instrumented code can override this later */
   dumpi_global->output->function[DUMPI_ALL_FUNCTIONS] = DUMPI_ENABLE;
+  /* ...unless a start trigger holds tracing back */
+  libdumpi_trigger_arm();
+  if(dumpi_global->aggregate) {
+    /* Only MPI calls are aggregated; nothing else goes to a trace */
+    dumpi_global->output->function[DUMPI_Function_enter] = DUMPI_DISABLE;
+    dumpi_global->output->function[DUMPI_Function_exit] = DUMPI_DISABLE;
+    dumpi_global->output->function[DUMPI_Function_call] = DUMPI_DISABLE;
+    dumpi_global->output->function[DUMPI_Poll_summary] = DUMPI_DISABLE;
+    dumpi_global->coalesce_polls = 0;
+    dumpi_global->lazy_statuses = 0;
+    dumpi_global->ring_mode = 0;
+  }
+  /* A ring buffer is truncated and rewritten, which a node file can't do */
+  if(dumpi_global->ring_mode || dumpi_global->aggregate)
+    dumpi_global->node_files = 0;
+  /* ...nor a stream; a stream replaces the node file */
+  dumpi_global->stream = (libdumpi_stream_wanted() &&
+			  ! dumpi_global->ring_mode &&
+			  ! dumpi_global->aggregate);
+  if(dumpi_global->stream)
+    dumpi_global->node_files = 0;
+  /* Every call of a poll run is counted in its summary record */
+  if(dumpi_global->coalesce_polls && dumpi_global->sampling)
+    libdumpi_poll_exempt_sampling();
+  /* Neither a ring buffer nor the statistics are flushed along the way */
+  dumpi_global->flush_points = (libdumpi_flush_points_wanted() &&
+				! dumpi_global->ring_mode &&
+				! dumpi_global->aggregate);
 }
 
 void read_config(FILE* fp) {
@@ -351,13 +504,35 @@ void open_output_file(void) {
 	   (cwd ? cwd : ""), (cwd ? "/" : ""), 
 	   dumpi_global->file_root, dumpi_global->comm_rank);
   */
-  snprintf(fname, count-1, "%s-%04d.bin",
-	   dumpi_global->file_root, dumpi_global->comm_rank);
+  snprintf(fname, count-1, "%s-%04d.%s",
+	   dumpi_global->file_root, dumpi_global->comm_rank,
+	   (dumpi_global->aggregate ? "prof" : "bin"));
   dumpi_global->output_file = fname;
+  dumpi_global->keyval = dumpi_alloc_keyval_record();
+  /* Statistics are written in one go at finalize */
+  if(dumpi_global->aggregate)
+    return;
+  if(dumpi_global->stream && mpi_initialized) {
+    /* Frames to the collector, or the file if it can't be reached */
+    dumpi_global->profile->file = libdumpi_streamwriter_open();
+    if(dumpi_global->profile->file != NULL)
+      return;
+    dumpi_global->stream = 0;
+  }
+  if(dumpi_global->node_files && mpi_initialized) {
+    /* One file per node, written by the lowest rank on the node */
+    char *segment = NULL;
+    dumpi_global->profile->file = libdumpi_nodewriter_open(&segment);
+    if(dumpi_global->profile->file != NULL) {
+      free(fname);
+      dumpi_global->output_file = segment;
+      return;
+    }
+    dumpi_global->node_files = 0;
+  }
   
   dumpi_global->profile->file = dumpi_open_output_file(fname);
   assert(dumpi_global->profile->file != NULL);
-  dumpi_global->keyval = dumpi_alloc_keyval_record();
   assert(dumpi_global->profile != NULL && dumpi_global->profile->file != NULL);
 }
 
@@ -389,7 +564,10 @@ void process_keyval(const char *key, const char *value) {
 	if(dumpi_global->output->function[offset] < 0) {
 	  /* We don't want to override values set directly from the application */
 	  /*fprintf(stderr, "Setting %s (%d) to %s\n", key, offset, value);*/
-	  dumpi_global->output->function[offset] = profiling_to_setting(value);
+	  if(strncmp(value, "sample", 6) == 0)
+	    set_sampling((dumpi_function)offset, value);
+	  else
+	    dumpi_global->output->function[offset] = profiling_to_setting(value);
 	}
 	return;
       }
@@ -423,16 +601,24 @@ void process_keyval(const char *key, const char *value) {
       return;
     }
   }
+  if(strcmp(key, "perfctr-backend") == 0) {
+    if(! dumpi_set_perfctr_backend(value))
+      fprintf(stderr, "dumpi:  Configure option \"%s\" with invalid "
+	      "value %s\n", "perfctr-backend", value);
+    return;
+  }
   /* Are we configuring call tracing? */
   if(strcmp(key, "tracing") == 0) {
     fprintf(stderr, "Call tracing: %s %s\n", key, value);
     if(strcmp(value, "enable") == 0) {
       dumpi_global->output->function[DUMPI_Function_enter] = 1;
       dumpi_global->output->function[DUMPI_Function_exit]  = 1;
+      dumpi_global->output->function[DUMPI_Function_call] = 1;
     }
     else if(strcmp(value, "disable") == 0) {
       dumpi_global->output->function[DUMPI_Function_enter] = 0;
       dumpi_global->output->function[DUMPI_Function_exit]  = 0;
+      dumpi_global->output->function[DUMPI_Function_call] = 0;
     }
     else if(strcmp(value, "enter") == 0) {
       dumpi_global->output->function[DUMPI_Function_enter] = 1;
@@ -447,6 +633,270 @@ void process_keyval(const char *key, const char *value) {
     }
     return;
   }
+  /* Array detail for vector collectives (detail:MPI_Alltoallv=sparse) */
+  if(strncmp(key, "detail:", 7) == 0) {
+    set_arg_detail(key+7, value);
+    return;
+  }
+  /* Cap on the number of records per second from sampled functions */
+  if(strcmp(key, "sample-rate-limit") == 0) {
+    set_sample_rate_limit(value);
+    return;
+  }
+  /* Are we measuring the time spent inside libdumpi? */
+  if(strcmp(key, "overhead") == 0) {
+    if(dumpi_global->output->overhead < 0) {
+      if(strcmp(value, "enable") == 0)
+	dumpi_global->output->overhead = 1;
+      else if(strcmp(value, "disable") == 0)
+	dumpi_global->output->overhead = 0;
+      else
+	fprintf(stderr, "dumpi:  Configure option \"%s\" with invalid "
+		"value %s\n", "overhead", value);
+    }
+    return;
+  }
+  /* Should runs of unsuccessful polls be folded into summary records? */
+  if(strcmp(key, "coalesce-polls") == 0) {
+    if(strcmp(value, "enable") == 0)
+      dumpi_global->coalesce_polls = 1;
+    else if(strcmp(value, "disable") == 0)
+      dumpi_global->coalesce_polls = 0;
+    else
+      fprintf(stderr, "dumpi:  Configure option \"%s\" with invalid "
+	      "value %s\n", "coalesce-polls", value);
+    return;
+  }
+  /* Should mode=profile also read the cpu clock around each call? */
+  if(strcmp(key, "profile-cpu-time") == 0) {
+    if(strcmp(value, "enable") == 0)
+      dumpi_global->aggregate_cpu = 1;
+    else if(strcmp(value, "disable") == 0)
+      dumpi_global->aggregate_cpu = 0;
+    else
+      fprintf(stderr, "dumpi:  Configure option \"%s\" with invalid "
+	      "value %s\n", "profile-cpu-time", value);
+    return;
+  }
+  /* Per-peer point-to-point totals, gathered at finalize */
+  if(strcmp(key, "comm-matrix") == 0) {
+    if(strcmp(value, "enable") == 0)
+      dumpi_global->comm_matrix = 1;
+    else if(strcmp(value, "disable") == 0)
+      dumpi_global->comm_matrix = 0;
+    else
+      fprintf(stderr, "dumpi:  Configure option \"%s\" with invalid "
+	      "value %s\n", "comm-matrix", value);
+    return;
+  }
+  /* Depth of the call path recorded with each traced call */
+  if(strcmp(key, "callsites") == 0) {
+    char *end;
+    long depth = strtol(value, &end, 10);
+    if(end == value || *end != '\0' || ! libdumpi_callsite_set_depth(depth))
+      fprintf(stderr, "dumpi:  Configure option \"%s\" with invalid "
+	      "value %s\n", "callsites", value);
+    return;
+  }
+  /* Which calls to profiled functions (-finstrument-functions) to record */
+  if(strcmp(key, "instrument-include") == 0) {
+    if(! libdumpi_instrument_include(value))
+      fprintf(stderr, "dumpi:  Configure option \"%s\" with invalid "
+	      "value %s\n", "instrument-include", value);
+    return;
+  }
+  if(strcmp(key, "instrument-exclude") == 0) {
+    if(! libdumpi_instrument_exclude(value))
+      fprintf(stderr, "dumpi:  Configure option \"%s\" with invalid "
+	      "value %s\n", "instrument-exclude", value);
+    return;
+  }
+  if(strcmp(key, "instrument-sample") == 0) {
+    if(! libdumpi_instrument_sample(value))
+      fprintf(stderr, "dumpi:  Configure option \"%s\" with invalid "
+	      "value %s\n", "instrument-sample", value);
+    return;
+  }
+  if(strcmp(key, "instrument-min-duration") == 0) {
+    if(! libdumpi_instrument_min_duration(value))
+      fprintf(stderr, "dumpi:  Configure option \"%s\" with invalid "
+	      "value %s\n", "instrument-min-duration", value);
+    return;
+  }
+  if(strcmp(key, "instrument-combine") == 0) {
+    if(strcmp(value, "enable") == 0)
+      libdumpi_instrument_combine(1);
+    else if(strcmp(value, "disable") == 0)
+      libdumpi_instrument_combine(0);
+    else
+      fprintf(stderr, "dumpi:  Configure option \"%s\" with invalid "
+	      "value %s\n", "instrument-combine", value);
+    return;
+  }
+  /* When to write the trace buffer */
+  if(strcmp(key, "flush-policy") == 0) {
+    if(! libdumpi_flush_policy(value))
+      fprintf(stderr, "dumpi:  Configure option \"%s\" with invalid "
+	      "value %s\n", "flush-policy", value);
+    return;
+  }
+  if(strcmp(key, "flush-margin") == 0) {
+    if(! libdumpi_flush_margin(value))
+      fprintf(stderr, "dumpi:  Configure option \"%s\" with invalid "
+	      "value %s\n", "flush-margin", value);
+    return;
+  }
+  if(strcmp(key, "flush-together") == 0) {
+    if(strcmp(value, "enable") == 0)
+      libdumpi_flush_together(1);
+    else if(strcmp(value, "disable") == 0)
+      libdumpi_flush_together(0);
+    else
+      fprintf(stderr, "dumpi:  Configure option \"%s\" with invalid "
+	      "value %s\n", "flush-together", value);
+    return;
+  }
+  /* Ranks that write a full trace */
+  if(strcmp(key, "trace-ranks") == 0) {
+    if(! libdumpi_rankselect_set(value))
+      fprintf(stderr, "dumpi:  Configure option \"%s\" with invalid "
+	      "value %s\n", "trace-ranks", value);
+    return;
+  }
+  if(strcmp(key, "trace-ranks-seed") == 0) {
+    libdumpi_rankselect_seed(strtoull(value, NULL, 0));
+    return;
+  }
+  if(strcmp(key, "untraced-ranks") == 0) {
+    if(strcmp(value, "profile") == 0)
+      dumpi_global->untraced_profile = 1;
+    else if(strcmp(value, "footer") == 0)
+      dumpi_global->untraced_profile = 0;
+    else
+      fprintf(stderr, "dumpi:  Configure option \"%s\" with invalid "
+	      "value %s\n", "untraced-ranks", value);
+    return;
+  }
+  /* Windows of the run to trace */
+  if(strcmp(key, "start-after") == 0 || strcmp(key, "start-after-seconds") == 0)
+  {
+    set_trigger(DUMPI_TRIGGER_START_AFTER, key, value);
+    return;
+  }
+  if(strcmp(key, "stop-after") == 0 || strcmp(key, "stop-after-seconds") == 0) {
+    set_trigger(DUMPI_TRIGGER_STOP_AFTER, key, value);
+    return;
+  }
+  if(strcmp(key, "repeat-every") == 0 ||
+     strcmp(key, "repeat-every-seconds") == 0)
+  {
+    set_trigger(DUMPI_TRIGGER_REPEAT_EVERY, key, value);
+    return;
+  }
+  if(strcmp(key, "start-at-annotation") == 0) {
+    set_trigger(DUMPI_TRIGGER_START_AT_ANNOTATION, key, value);
+    return;
+  }
+  if(strcmp(key, "stop-at-annotation") == 0) {
+    set_trigger(DUMPI_TRIGGER_STOP_AT_ANNOTATION, key, value);
+    return;
+  }
+  /* Regular trace, flight recorder, or statistics only? */
+  if(strcmp(key, "mode") == 0) {
+    if(strcmp(value, "ringbuffer") == 0) {
+      dumpi_global->ring_mode = 1;
+      dumpi_global->aggregate = 0;
+    }
+    else if(strcmp(value, "profile") == 0) {
+      dumpi_global->ring_mode = 0;
+      dumpi_global->aggregate = 1;
+    }
+    else if(strcmp(value, "trace") == 0) {
+      dumpi_global->ring_mode = 0;
+      dumpi_global->aggregate = 0;
+    }
+    else
+      fprintf(stderr, "dumpi:  Configure option \"%s\" with invalid "
+	      "value %s\n", "mode", value);
+    return;
+  }
+  if(strcmp(key, "ringbuffer-size") == 0) {
+    set_ring_window(value);
+    return;
+  }
+  /* Measure the offset and drift of the wall clock against rank 0 */
+  if(strcmp(key, "clock-sync") == 0) {
+    if(strcmp(value, "enable") == 0)
+      libdumpi_clocksync_enable(1);
+    else if(strcmp(value, "disable") == 0)
+      libdumpi_clocksync_enable(0);
+    else
+      fprintf(stderr, "dumpi:  Configure option \"%s\" with invalid "
+	      "value %s\n", "clock-sync", value);
+    return;
+  }
+  if(strcmp(key, "clock-sync-rounds") == 0) {
+    if(! libdumpi_clocksync_rounds(value))
+      fprintf(stderr, "dumpi:  Invalid value %s for clock-sync-rounds "
+	      "(expected a count from 1 to 1000)\n", value);
+    return;
+  }
+  /* One trace file per node instead of one per rank? */
+  if(strcmp(key, "node-files") == 0) {
+    if(strcmp(value, "enable") == 0)
+      dumpi_global->node_files = 1;
+    else if(strcmp(value, "disable") == 0)
+      dumpi_global->node_files = 0;
+    else
+      fprintf(stderr, "dumpi:  Configure option \"%s\" with invalid "
+	      "value %s\n", "node-files", value);
+    return;
+  }
+  if(strcmp(key, "node-queue-size") == 0) {
+    if(! libdumpi_node_queue_size(value))
+      bad_size("node-queue-size", value);
+    return;
+  }
+  /* Send the trace to dumpicollect as it is written */
+  if(strcmp(key, "stream-to") == 0) {
+    libdumpi_stream_to(value);
+    return;
+  }
+  if(strcmp(key, "stream-backlog") == 0) {
+    if(! libdumpi_stream_backlog(value))
+      bad_size("stream-backlog", value);
+    return;
+  }
+  if(strcmp(key, "preinit-buffer-size") == 0) {
+    set_preinit_limit(value);
+    return;
+  }
+  if(strcmp(key, "ringbuffer-signal") == 0) {
+    set_ring_signal(value);
+    return;
+  }
+  /* Should a crashing or killed rank dump its ring buffer? */
+  if(strcmp(key, "ringbuffer-fatal-signals") == 0) {
+    if(strcmp(value, "enable") == 0)
+      dumpi_global->ring_fatal = 1;
+    else if(strcmp(value, "disable") == 0)
+      dumpi_global->ring_fatal = 0;
+    else
+      fprintf(stderr, "dumpi:  Configure option \"%s\" with invalid "
+	      "value %s\n", "ringbuffer-fatal-signals", value);
+    return;
+  }
+  /* Are statuses decoded in the MPI wrapper or when the buffer is flushed? */
+  if(strcmp(key, "status-capture") == 0) {
+    if(strcmp(value, "lazy") == 0)
+      dumpi_global->lazy_statuses = 1;
+    else if(strcmp(value, "eager") == 0)
+      dumpi_global->lazy_statuses = 0;
+    else
+      fprintf(stderr, "dumpi:  Configure option \"%s\" with invalid "
+	      "value %s\n", "status-capture", value);
+    return;
+  }
   /* OK, so let's see whether this is the status flag. */
   if(strcmp(key, "statuses") == 0) {
     if(dumpi_global->output->statuses < 0) {
@@ -497,7 +947,9 @@ void process_keyval(const char *key, const char *value) {
 
 void create_meta_file(void) {
   char buffer[100];
-  
+
+  if(dumpi_global->comm_rank != 0)
+    return;
   sprintf(buffer, "%s.meta", dumpi_global->file_root);
   FILE *df = fopen(buffer, "w");
   assert(df != NULL);
@@ -511,7 +963,273 @@ void create_meta_file(void) {
 	  dumpi_global->header->version[0], 
 	  dumpi_global->header->version[1], 
 	  dumpi_global->header->version[2]);
+  if(dumpi_global->aggregate)
+    fprintf(df, "mode=profile\n");
+  if(dumpi_global->comm_matrix)
+    fprintf(df, "matrix=%s.matrix\n", dumpi_global->file_root);
+  libdumpi_rankselect_write_meta(df);
+  libdumpi_nodewriter_write_meta(df);
   fclose(df);
 }
 
 
+
+/*
+ * Handle MPI_Foo=sample[:N] -- record one out of every N calls
+ * (N defaults to 1, which leaves only the rate limit in effect).
+ */
+void set_sampling(dumpi_function func, const char *value) {
+  long period = 1;
+  if(value[6] == ':') {
+    period = strtol(value+7, NULL, 10);
+  }
+  else if(value[6] != '\0') {
+    fprintf(stderr, "dumpi:  Invalid sampling setting %s for %s\n",
+	    value, dumpi_function_names[func]);
+    return;
+  }
+  if(period < 1) {
+    fprintf(stderr, "dumpi:  Sampling period for %s must be positive "
+	    "(got %s).  Recording every call.\n",
+	    dumpi_function_names[func], value);
+    period = 1;
+  }
+  dumpi_global->output->function[func] = DUMPI_ENABLE;
+  dumpi_global->sample_period[func] = (uint32_t)period;
+  dumpi_global->sampling = 1;
+}
+
+/*
+ * Handle detail:MPI_Foo=full|summarized|sparse
+ * (detail:MPI_Default sets every function).
+ */
+void set_arg_detail(const char *funcname, const char *value) {
+  int func;
+  dumpi_arg_detail detail;
+  if(strcmp(value, "full") == 0)
+    detail = DUMPI_DETAIL_FULL;
+  else if(strcmp(value, "summarized") == 0)
+    detail = DUMPI_DETAIL_SUMMARIZED;
+  else if(strcmp(value, "sparse") == 0)
+    detail = DUMPI_DETAIL_SPARSE;
+  else {
+    fprintf(stderr, "dumpi:  Invalid value %s for detail:%s "
+	    "(expected full, summarized, or sparse)\n", value, funcname);
+    return;
+  }
+  if(strcmp(funcname, "MPI_Default") == 0) {
+    for(func = 0; func < DUMPI_ALL_FUNCTIONS; ++func)
+      dumpi_global->arg_detail[func] = (int8_t)detail;
+    return;
+  }
+  for(func = 0; func < DUMPI_ALL_FUNCTIONS; ++func) {
+    if(strcmp(funcname, dumpi_function_names[func]) == 0) {
+      dumpi_global->arg_detail[func] = (int8_t)detail;
+      return;
+    }
+  }
+  fprintf(stderr, "dumpi:  Unknown MPI function in detail:%s\n", funcname);
+}
+
+/*
+ * Handle sample-rate-limit=N or sample-rate-limit=N/s
+ */
+void set_sample_rate_limit(const char *value) {
+  char *end = NULL;
+  long limit = strtol(value, &end, 10);
+  if(limit < 0 || end == value || (*end != '\0' && strcmp(end, "/s") != 0)) {
+    fprintf(stderr, "dumpi:  Invalid value %s for sample-rate-limit "
+	    "(expected records per second, e.g. 50000/s)\n", value);
+    return;
+  }
+  dumpi_global->sample_rate_limit = (uint32_t)limit;
+}
+
+void set_trigger(libdumpi_trigger_kind kind, const char *key,
+		 const char *value)
+{
+  const char *suffix = strrchr(key, '-');
+  int seconds = (suffix != NULL && strcmp(suffix, "-seconds") == 0);
+  if(! libdumpi_trigger_set(kind, value, seconds))
+    fprintf(stderr, "dumpi:  Invalid value %s for %s (expected %s)\n",
+	    value, key, (kind >= DUMPI_TRIGGER_START_AT_ANNOTATION ?
+			 "a regular expression" :
+			 (seconds ? "seconds" : "MPI_Foo:N or a time like 120s")));
+}
+
+void set_ring_window(const char *value) {
+  char *end = NULL;
+  long megabytes = strtol(value, &end, 10);
+  if(megabytes <= 0 || end == value ||
+     (*end != '\0' && strcmp(end, "M") != 0 && strcmp(end, "MB") != 0))
+  {
+    fprintf(stderr, "dumpi:  Invalid value %s for ringbuffer-size "
+	    "(expected megabytes, e.g. 64M)\n", value);
+    return;
+  }
+  dumpi_global->ring_window = (size_t)megabytes << 20;
+}
+
+int libdumpi_parse_size(const char *value, size_t *size) {
+  char *end = NULL;
+  long amount = strtol(value, &end, 10);
+  int shift = -1;
+  if(end != value && amount > 0) {
+    if(strcmp(end, "K") == 0 || strcmp(end, "KB") == 0)
+      shift = 10;
+    else if(*end == '\0' || strcmp(end, "M") == 0 || strcmp(end, "MB") == 0)
+      shift = 20;
+  }
+  if(shift < 0)
+    return 0;
+  *size = (size_t)amount << shift;
+  return 1;
+}
+
+void bad_size(const char *key, const char *value) {
+  fprintf(stderr, "dumpi:  Invalid value %s for %s "
+	  "(expected megabytes, e.g. 16M, or kilobytes, e.g. 512K)\n",
+	  value, key);
+}
+
+void set_preinit_limit(const char *value) {
+  if(! libdumpi_parse_size(value, &dumpi_global->preinit_limit))
+    bad_size("preinit-buffer-size", value);
+}
+
+void set_ring_signal(const char *value) {
+  char *end = NULL;
+  long signum;
+  if(strncmp(value, "SIG", 3) == 0)
+    value += 3;
+  if(strcmp(value, "none") == 0)
+    dumpi_global->ring_signal = 0;
+  else if(strcmp(value, "USR1") == 0)
+    dumpi_global->ring_signal = SIGUSR1;
+  else if(strcmp(value, "USR2") == 0)
+    dumpi_global->ring_signal = SIGUSR2;
+  else {
+    signum = strtol(value, &end, 10);
+    if(signum <= 0 || end == value || *end != '\0') {
+      fprintf(stderr, "dumpi:  Invalid value %s for ringbuffer-signal "
+	      "(expected SIGUSR1, SIGUSR2, a signal number, or none)\n", value);
+      return;
+    }
+    dumpi_global->ring_signal = (int)signum;
+  }
+}
+
+void libdumpi_ring_snapshot(void) {
+  dumpi_profile *snap;
+  libdumpi_snapshot_requested = 0;
+  if(dumpi_global == NULL || dumpi_global->profile == NULL ||
+     dumpi_global->profile->ring == NULL || dumpi_global->output_file == NULL)
+    return;
+  libdumpi_lock_io();
+  snap = (dumpi_profile*)calloc(1, sizeof(dumpi_profile));
+  assert(snap != NULL);
+  memcpy(snap->version, dumpi_global->profile->version, sizeof(snap->version));
+  snap->cpu_time_offset = dumpi_global->profile->cpu_time_offset;
+  snap->wall_time_offset = dumpi_global->profile->wall_time_offset;
+  snap->body = dumpi_global->profile->body;
+  snap->file = dumpi_open_output_file(dumpi_global->output_file);
+  if(snap->file != NULL) {
+    dumpi_membuf_ring_copy(dumpi_global->profile, snap);
+    write_trailer(snap, 0);
+  }
+  dumpi_free_output_profile(snap);
+  libdumpi_unlock_io();
+}
+
+int libdumpi_sample_call(dumpi_function func) {
+  uint32_t count = dumpi_global->sample_count[func]++;
+  if((count % dumpi_global->sample_period[func]) != 0) {
+    ++dumpi_global->sample_dropped[func];
+    return 0;
+  }
+  if(dumpi_global->sample_rate_limit) {
+    time_t now = time(NULL);
+    if(now != dumpi_global->sample_window) {
+      dumpi_global->sample_window = now;
+      dumpi_global->sample_window_used = 0;
+    }
+    if(dumpi_global->sample_window_used >= dumpi_global->sample_rate_limit) {
+      ++dumpi_global->sample_dropped[func];
+      return 0;
+    }
+    ++dumpi_global->sample_window_used;
+  }
+  return 1;
+}
+
+/*
+ * Note the capture depth and the number of distinct call paths.
+ */
+void record_callsites(void) {
+  char val[64];
+  if(dumpi_global->keyval == NULL || dumpi_global->callsites == 0)
+    return;
+  snprintf(val, sizeof(val), "%d", dumpi_global->callsites);
+  dumpi_push_keyval_entry(dumpi_global->keyval, "callsites", val);
+  snprintf(val, sizeof(val), "%u", libdumpi_callsite_count());
+  dumpi_push_keyval_entry(dumpi_global->keyval, "callsite-paths", val);
+}
+
+/*
+ * Note how many trigger windows were opened during the run.
+ */
+void record_triggers(void) {
+  char val[64];
+  if(dumpi_global->keyval == NULL || ! dumpi_global->triggers)
+    return;
+  snprintf(val, sizeof(val), "%d", libdumpi_trigger_windows());
+  dumpi_push_keyval_entry(dumpi_global->keyval, "trigger-windows", val);
+}
+
+/*
+ * Note the ring buffer size and how many bytes of old records it dropped.
+ */
+void record_ring(void) {
+  char val[64];
+  if(dumpi_global->keyval == NULL)
+    return;
+  dumpi_push_keyval_entry(dumpi_global->keyval, "mode", "ringbuffer");
+  snprintf(val, sizeof(val), "%lluM",
+	   (unsigned long long)(dumpi_global->ring_window >> 20));
+  dumpi_push_keyval_entry(dumpi_global->keyval, "ringbuffer-size", val);
+  snprintf(val, sizeof(val), "%llu", (unsigned long long)
+	   dumpi_membuf_ring_dropped(dumpi_global->profile));
+  dumpi_push_keyval_entry(dumpi_global->keyval, "ringbuffer-dropped", val);
+}
+
+/*
+ * Store the sampling settings in the keyval record so analysis tools
+ * can scale counts back up.  For each sampled function we store the
+ * configured ratio ("sample:MPI_Foo" = "1/N") and the effective ratio
+ * ("sampled:MPI_Foo" = "recorded/called").  Only calls that reached the
+ * sampler are counted, so calls left out by triggers or trace-ranks do
+ * not skew the ratio.
+ */
+void record_sampling(void) {
+  int func;
+  char key[128], val[64];
+  if(dumpi_global->keyval == NULL || dumpi_global->sampling == 0)
+    return;
+  if(dumpi_global->sample_rate_limit) {
+    snprintf(val, sizeof(val), "%u/s", dumpi_global->sample_rate_limit);
+    dumpi_push_keyval_entry(dumpi_global->keyval, "sample-rate-limit", val);
+  }
+  for(func = 0; func < DUMPI_ALL_FUNCTIONS; ++func) {
+    if(dumpi_global->sample_period[func] == 0)
+      continue;
+    snprintf(key, sizeof(key), "sample:%s", dumpi_function_names[func]);
+    snprintf(val, sizeof(val), "1/%u", dumpi_global->sample_period[func]);
+    dumpi_push_keyval_entry(dumpi_global->keyval, key, val);
+    snprintf(key, sizeof(key), "sampled:%s", dumpi_function_names[func]);
+    snprintf(val, sizeof(val), "%u/%u",
+	     dumpi_global->sample_count[func] -
+	     dumpi_global->sample_dropped[func],
+	     dumpi_global->sample_count[func]);
+    dumpi_push_keyval_entry(dumpi_global->keyval, key, val);
+  }
+}
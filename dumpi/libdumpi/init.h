@@ -19,6 +19,7 @@
 #include <stdio.h>
 #include <string.h>
 #include <errno.h>
+#include <signal.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -63,6 +64,39 @@ extern "C" {
    */
   void libdumpi_finalize(void);
 
+  /**
+   * Decide whether a call to a sampled function gets recorded.
+   * Only called for functions with a non-zero sampling period
+   * (see DUMPI_SAMPLED).  Records one out of every sample_period calls,
+   * subject to the global sample-rate-limit.
+   * The counters are not protected by a lock -- like the footer counts,
+   * concurrent calls from several threads may skew the sampling slightly.
+   * \return non-zero if the call should be recorded.
+   */
+  int libdumpi_sample_call(dumpi_function func);
+
+  /**
+   * Parse a buffer size from the configuration:  a positive count of
+   * megabytes (16, 16M, 16MB) or kilobytes (512K, 512KB).
+   * \return non-zero (and set size) if the value was valid.
+   */
+  int libdumpi_parse_size(const char *value, size_t *size);
+
+  /**
+   * Set by the ringbuffer-signal handler when there is no snapshot
+   * thread (see ringsignals.h).  The snapshot itself is then taken by
+   * the next MPI call (see DUMPI_INSERT_PREAMBLE), since writing a
+   * trace is not safe inside a signal handler.
+   */
+  extern volatile sig_atomic_t libdumpi_snapshot_requested;
+
+  /**
+   * Write the records currently held in the ring buffer (mode=ringbuffer)
+   * as a complete trace file, replacing the previous snapshot.
+   * Recording continues afterwards.  A no-op for regular traces.
+   */
+  void libdumpi_ring_snapshot(void);
+
   /*@}*/ /* close comment scope */
 
 #ifdef __cplusplus
@@ -0,0 +1,323 @@
+/*
+ *  This file is part of DUMPI:
+ *               The MPI profiling library from the SST suite.
+ *  Copyright (c) 2009-2011 Sandia Corporation.
+ *  This software is distributed under the BSD License.
+ *  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+ *  the U.S. Government retains certain rights in this software.
+ *  For more information, see the LICENSE file in the top
+ *  SST/macroscale directory.
+ */
+
+#include <dumpi/libdumpi/instrument.h>
+#include <dumpi/libdumpi/callprofile.h>
+#include <dumpi/libdumpi/callprofile-addrset.h>
+#include <dumpi/libdumpi/mpibindings-utils.h>
+#include <dumpi/libdumpi/data.h>
+#include <dumpi/common/dumpiio.h>
+#include <dumpi/common/gettime.h>
+#include <dumpi/common/io.h>
+#include <regex.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#define FRAME_MIN_CAPACITY 64
+#define SLOT_MIN_CAPACITY  256
+
+/* One instrument-include or instrument-exclude item. */
+typedef struct filter_item {
+  /* Non-zero for an address range, zero for a symbol-name pattern */
+  int      is_range;
+  uint64_t low, high;
+  regex_t  pattern;
+  struct filter_item *next;
+} filter_item;
+
+/* The configured filters.  Set while reading the configuration;
+ * read-only (and applied once per address) afterwards. */
+static filter_item *includes = NULL, *excludes = NULL;
+static int32_t sample_period = 1;
+static int64_t min_duration = 0;   /* nanoseconds */
+static int combine = 1;
+static int configured = 0;
+
+/* Parse an item:  an address, an address range, or a pattern. */
+static filter_item* parse_item(const char *value) {
+  filter_item *item = (filter_item*)calloc(1, sizeof(filter_item));
+  char *end;
+  assert(item != NULL);
+  if(strncmp(value, "0x", 2) == 0) {
+    item->is_range = 1;
+    item->low = item->high = strtoull(value, &end, 16);
+    if(*end == '-') {
+      const char *start = end+1;
+      item->high = strtoull(start, &end, 16);
+      if(end == start)
+	end = (char*)value;
+    }
+    if(end != value && *end == '\0' && item->low <= item->high)
+      return item;
+  }
+  else if(regcomp(&item->pattern, value, REG_EXTENDED | REG_NOSUB) == 0)
+    return item;
+  free(item);
+  return NULL;
+}
+
+/* Add an item to the front of a filter list. */
+static int add_item(filter_item **list, const char *value) {
+  filter_item *item = parse_item(value);
+  if(item == NULL)
+    return 0;
+  item->next = *list;
+  *list = item;
+  configured = 1;
+  return 1;
+}
+
+int libdumpi_instrument_include(const char *value) {
+  return add_item(&includes, value);
+}
+
+int libdumpi_instrument_exclude(const char *value) {
+  return add_item(&excludes, value);
+}
+
+int libdumpi_instrument_sample(const char *value) {
+  char *end;
+  long period = strtol(value, &end, 10);
+  if(end == value || *end != '\0' || period < 1 || period > INT32_MAX)
+    return 0;
+  sample_period = (int32_t)period;
+  configured = 1;
+  return 1;
+}
+
+int libdumpi_instrument_min_duration(const char *value) {
+  char *end;
+  double scale = 1e9, duration = strtod(value, &end);
+  if(end == value || duration < 0)
+    return 0;
+  if(strcmp(end, "ms") == 0)      scale = 1e6;
+  else if(strcmp(end, "us") == 0) scale = 1e3;
+  else if(strcmp(end, "ns") == 0) scale = 1;
+  else if(*end != '\0' && strcmp(end, "s") != 0)
+    return 0;
+  min_duration = (int64_t)(duration * scale);
+  configured = 1;
+  return 1;
+}
+
+void libdumpi_instrument_combine(int enable) {
+  combine = enable;
+  configured = 1;
+}
+
+/* Test a function against a filter list. */
+static int matches(const filter_item *list, uint64_t fn, const char *name) {
+  for(; list != NULL; list = list->next) {
+    if(list->is_range) {
+      if(fn >= list->low && fn <= list->high)
+	return 1;
+    }
+    else if(name != NULL && regexec(&list->pattern, name, 0, NULL, 0) == 0)
+      return 1;
+  }
+  return 0;
+}
+
+/* Decide how often a function is recorded (0: never).  Called once per
+ * function for the whole process (see libdumpi_insert_address). */
+static int32_t classify(uint64_t fn) {
+  const char *name = NULL;
+  if(includes != NULL || excludes != NULL)
+    name = dumpi_symbol_name(fn);
+  if(includes != NULL && ! matches(includes, fn, name))
+    return 0;
+  if(matches(excludes, fn, name))
+    return 0;
+  return sample_period;
+}
+
+/* Spread aligned function addresses over the slots. */
+static size_t hash_fn(uint64_t fn) {
+  return (size_t)((fn ^ (fn >> 29)) * 0x9e3779b97f4a7c15ull >> 20);
+}
+
+/* Double the thread's function cache. */
+static void grow_slots(libdumpi_funcstack *stack) {
+  libdumpi_func_slot *old = stack->slots;
+  size_t old_capacity = stack->slot_capacity, i, slot;
+  stack->slot_capacity = (old_capacity ? 2*old_capacity : SLOT_MIN_CAPACITY);
+  stack->slots = (libdumpi_func_slot*)calloc(stack->slot_capacity,
+					     sizeof(libdumpi_func_slot));
+  assert(stack->slots != NULL);
+  for(i = 0; i < old_capacity; ++i) {
+    if(old[i].fn == 0)
+      continue;
+    slot = hash_fn(old[i].fn) & (stack->slot_capacity - 1);
+    while(stack->slots[slot].fn != 0)
+      slot = (slot + 1) & (stack->slot_capacity - 1);
+    stack->slots[slot] = old[i];
+  }
+  free(old);
+}
+
+/* Find what the thread knows about a function, asking the shared
+ * address list the first time the thread sees it. */
+static libdumpi_func_slot* find_slot(libdumpi_funcstack *stack, uint64_t fn) {
+  size_t slot;
+  if(2*(stack->used+1) > stack->slot_capacity)
+    grow_slots(stack);
+  slot = hash_fn(fn) & (stack->slot_capacity - 1);
+  while(stack->slots[slot].fn != fn) {
+    if(stack->slots[slot].fn == 0) {
+      stack->slots[slot].fn = fn;
+      stack->slots[slot].period =
+	libdumpi_insert_address((void*)(uintptr_t)fn, classify);
+      ++stack->used;
+      break;
+    }
+    slot = (slot + 1) & (stack->slot_capacity - 1);
+  }
+  return &stack->slots[slot];
+}
+
+/* Nanoseconds between two times. */
+static int64_t elapsed(const dumpi_clock *start, const dumpi_clock *stop) {
+  return ((int64_t)(stop->sec - start->sec) * 1000000000 +
+	  (stop->nsec - start->nsec));
+}
+
+/* Note entry into a profiled function. */
+void libdumpi_instrument_enter(libdumpi_funcstack *stack, uint64_t fn) {
+  libdumpi_func_slot *slot = find_slot(stack, fn);
+  libdumpi_func_frame *frame;
+  if(slot->period == 0)
+    return;
+  if(stack->depth == stack->capacity) {
+    stack->capacity = (stack->capacity ? 2*stack->capacity :
+		       FRAME_MIN_CAPACITY);
+    stack->frames = (libdumpi_func_frame*)
+      realloc(stack->frames, stack->capacity * sizeof(libdumpi_func_frame));
+    assert(stack->frames != NULL);
+  }
+  frame = &stack->frames[stack->depth++];
+  frame->fn = fn;
+  frame->recorded = 0;
+  if(! (dumpi_global->output->function[DUMPI_Function_enter] ||
+	dumpi_global->output->function[DUMPI_Function_exit] ||
+	dumpi_global->output->function[DUMPI_Function_call]))
+    return;
+  if(slot->calls++ % slot->period != 0) {
+    ++stack->skipped;
+    return;
+  }
+  frame->recorded = 1;
+  dumpi_get_time(&frame->cpu, &frame->wall);
+  if(! combine && min_duration == 0) {
+    /* Nothing to wait for:  taking the lock writes the entry record */
+    libdumpi_lock_io();
+    libdumpi_unlock_io();
+  }
+}
+
+/* Note exit from a profiled function. */
+void libdumpi_instrument_exit(libdumpi_funcstack *stack, uint64_t fn) {
+  libdumpi_func_slot *slot = find_slot(stack, fn);
+  libdumpi_func_frame frame;
+  dumpi_func_call stat;
+  dumpi_time cpu, wall;
+  size_t depth;
+  int flushed;
+  if(slot->period == 0)
+    return;
+  /* Frames above the matching one were left by longjmp */
+  for(depth = stack->depth; depth > 0; --depth)
+    if(stack->frames[depth-1].fn == fn)
+      break;
+  if(depth == 0)
+    return;
+  frame = stack->frames[depth-1];
+  stack->depth = depth-1;
+  flushed = (stack->flushed > stack->depth);
+  if(flushed)
+    stack->flushed = stack->depth;
+  if(! frame.recorded)
+    return;
+  dumpi_get_time(&cpu.stop, &wall.stop);
+  cpu.start = frame.cpu;
+  wall.start = frame.wall;
+  if(! flushed && elapsed(&wall.start, &wall.stop) < min_duration) {
+    ++stack->skipped;
+    return;
+  }
+  stat.fn = fn;
+  /* Any entry records held back for enclosing calls come first */
+  libdumpi_lock_io();
+  if(dumpi_global->profile != NULL) {
+    if(! flushed && combine) {
+      dumpi_write_func_call(&stat, stack->thread, &cpu, &wall, NULL,
+			    dumpi_global->output, dumpi_global->profile);
+    }
+    else {
+      if(! flushed) {
+	dumpi_time cpu_in = {cpu.start, cpu.start};
+	dumpi_time wall_in = {wall.start, wall.start};
+	dumpi_write_func_enter(&stat, stack->thread, &cpu_in, &wall_in, NULL,
+			       dumpi_global->output, dumpi_global->profile);
+      }
+      cpu.start = cpu.stop;
+      wall.start = wall.stop;
+      dumpi_write_func_exit(&stat, stack->thread, &cpu, &wall, NULL,
+			    dumpi_global->output, dumpi_global->profile);
+    }
+  }
+  libdumpi_unlock_io();
+}
+
+/* Write the entry records held back. */
+void libdumpi_funcstack_flush(libdumpi_funcstack *stack) {
+  for(; stack->flushed < stack->depth; ++stack->flushed) {
+    const libdumpi_func_frame *frame = &stack->frames[stack->flushed];
+    dumpi_func_call stat;
+    dumpi_time cpu, wall;
+    if(! frame->recorded || dumpi_global == NULL ||
+       dumpi_global->profile == NULL)
+      continue;
+    stat.fn = frame->fn;
+    cpu.start = cpu.stop = frame->cpu;
+    wall.start = wall.stop = frame->wall;
+    dumpi_write_func_enter(&stat, stack->thread, &cpu, &wall, NULL,
+			   dumpi_global->output, dumpi_global->profile);
+  }
+}
+
+/* Free the state of a thread. */
+void libdumpi_funcstack_release(libdumpi_funcstack *stack) {
+  free(stack->frames);
+  free(stack->slots);
+  stack->frames = NULL;
+  stack->slots = NULL;
+  stack->depth = stack->capacity = stack->flushed = 0;
+  stack->used = stack->slot_capacity = 0;
+}
+
+/* Note the settings and the calls left out. */
+void libdumpi_instrument_record(void) {
+  char val[64];
+  if(! configured || dumpi_global->keyval == NULL)
+    return;
+  snprintf(val, sizeof(val), "%d", (int)sample_period);
+  dumpi_push_keyval_entry(dumpi_global->keyval, "instrument-sample", val);
+  snprintf(val, sizeof(val), "%lldns", (long long)min_duration);
+  dumpi_push_keyval_entry(dumpi_global->keyval, "instrument-min-duration",
+			  val);
+  dumpi_push_keyval_entry(dumpi_global->keyval, "instrument-combine",
+			  (combine ? "enable" : "disable"));
+  snprintf(val, sizeof(val), "%llu",
+	   (unsigned long long)libdumpi_collect_skipped_calls());
+  dumpi_push_keyval_entry(dumpi_global->keyval, "instrument-skipped", val);
+}
@@ -0,0 +1,139 @@
+/*
+ *  This file is part of DUMPI:
+ *               The MPI profiling library from the SST suite.
+ *  Copyright (c) 2009-2011 Sandia Corporation.
+ *  This software is distributed under the BSD License.
+ *  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+ *  the U.S. Government retains certain rights in this software.
+ *  For more information, see the LICENSE file in the top
+ *  SST/macroscale directory.
+ */
+
+#ifndef DUMPI_LIBDUMPI_INSTRUMENT_H
+#define DUMPI_LIBDUMPI_INSTRUMENT_H
+
+#include <dumpi/common/types.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* ! __cplusplus */
+
+  /**
+   * \addtogroup libdumpi_internal_callprofile
+   */
+  /*@{*/
+
+  /**
+   * A profiled function the calling thread is currently inside.
+   */
+  typedef struct libdumpi_func_frame {
+    uint64_t    fn;
+    /** Zero if the call was sampled out */
+    int         recorded;
+    /** Time of entry */
+    dumpi_clock cpu, wall;
+  } libdumpi_func_frame;
+
+  /**
+   * What a thread knows about one function:  how often calls are
+   * recorded (0: never, N: one in N) and how many calls it has seen.
+   * fn 0 marks an empty slot.
+   */
+  typedef struct libdumpi_func_slot {
+    uint64_t fn;
+    int32_t  period;
+    uint32_t calls;
+  } libdumpi_func_slot;
+
+  /**
+   * Per-thread state of the function instrumentation
+   * (see libdumpi_get_funcstack).
+   *
+   * The entry record of a call is held back until the call turns out to
+   * need one:  when a record is written from inside it (any record, MPI
+   * calls included) or, without instrument-combine, when it ends.
+   * frames[0..flushed) have had their entry record written.
+   */
+  typedef struct libdumpi_funcstack {
+    uint16_t             thread;
+    size_t               depth, capacity, flushed;
+    libdumpi_func_frame *frames;
+    /** Open-addressing cache of the functions seen by this thread */
+    size_t               used, slot_capacity;
+    libdumpi_func_slot  *slots;
+    /** Calls not written (sampled out or shorter than the minimum) */
+    uint64_t             skipped;
+  } libdumpi_funcstack;
+
+  /**
+   * Add a function the instrumentation records (instrument-include).
+   * Either a (POSIX extended) regular expression matched against the
+   * symbol name or an address range such as 0x401000-0x4020ff.
+   * Once any function is included, all others are left out.
+   * \return non-zero if the value was valid.
+   */
+  int libdumpi_instrument_include(const char *value);
+
+  /**
+   * Add a function the instrumentation leaves out (instrument-exclude),
+   * given as for libdumpi_instrument_include.  Exclusion wins.
+   * \return non-zero if the value was valid.
+   */
+  int libdumpi_instrument_exclude(const char *value);
+
+  /**
+   * Record one call in N of each function (instrument-sample).
+   * \return non-zero if the value was valid.
+   */
+  int libdumpi_instrument_sample(const char *value);
+
+  /**
+   * Leave out calls that take less than the given time and contain
+   * nothing else that is recorded (instrument-min-duration).  The value
+   * is in seconds unless it ends in s, ms, us, or ns.
+   * \return non-zero if the value was valid.
+   */
+  int libdumpi_instrument_min_duration(const char *value);
+
+  /**
+   * Write calls that contain nothing else that is recorded as a single
+   * Function_call record (instrument-combine, enabled by default).
+   */
+  void libdumpi_instrument_combine(int enable);
+
+  /**
+   * Note entry into a profiled function.  Used by __cyg_profile_func_enter.
+   */
+  void libdumpi_instrument_enter(libdumpi_funcstack *stack, uint64_t fn);
+
+  /**
+   * Note exit from a profiled function.  Used by __cyg_profile_func_exit.
+   */
+  void libdumpi_instrument_exit(libdumpi_funcstack *stack, uint64_t fn);
+
+  /**
+   * Write the entry records held back for the calls the thread is inside.
+   * The caller holds the io lock (libdumpi_lock_io does this).
+   */
+  void libdumpi_funcstack_flush(libdumpi_funcstack *stack);
+
+  /**
+   * Free the state of a thread.
+   */
+  void libdumpi_funcstack_release(libdumpi_funcstack *stack);
+
+  /**
+   * Note the instrumentation settings and the number of calls left out
+   * in the keyval record.
+   */
+  void libdumpi_instrument_record(void);
+
+  /*@}*/
+
+#ifdef __cplusplus
+} /* end of extern "C" */
+#endif /* ! __cplusplus */
+
+#endif /* ! DUMPI_LIBDUMPI_INSTRUMENT_H */
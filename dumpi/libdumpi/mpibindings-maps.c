@@ -404,6 +404,39 @@ dumpi_datatype libdumpi_get_request(MPI_Request mrequest) {
   return dumpi_hm_request_get(request_map, mrequest);
 }
 
+#ifdef DUMPI_HAVE_MPI_MESSAGE
+/**
+ * Create the bindings for a hash map of MPI_Message objects.
+ */
+DUMPI_DECLARE_HASHMAP(message, MPI_Message, dumpi_message)
+
+/**
+ * Create the handle for a shared map of MPI_Message objects.
+ */
+static dumpi_hm_message *message_map = NULL;
+
+/**
+ * Add built-in MPI_Message objects to the hash map.
+ */
+void libdumpi_init_message_map(void) {
+  if(message_map == NULL) {
+    dumpi_hm_message_init(&message_map, DUMPI_FIRST_USER_MESSAGE);
+    dumpi_hm_message_set(message_map, MPI_MESSAGE_NULL, DUMPI_MESSAGE_NULL);
+    dumpi_hm_message_set(message_map, MPI_MESSAGE_NO_PROC,
+			 DUMPI_MESSAGE_NO_PROC);
+  }
+}
+
+/*
+ * Get a dumpi message index corresponding to the given MPI_Message.
+ */
+dumpi_message libdumpi_get_message(MPI_Message mmessage) {
+  libdumpi_init_message_map();
+  return dumpi_hm_message_get(message_map, mmessage);
+}
+
+#endif /* ! DUMPI_HAVE_MPI_MESSAGE */
+
 /** 
  * Create the bindings for a hash map of MPI keyval handles.
  * The MPI standard defines those as int, but they are a
@@ -512,6 +545,9 @@ void libdumpi_init_maps(void) {
   libdumpi_init_op_map();
   libdumpi_init_iorequest_map();
   libdumpi_init_request_map();
+#ifdef DUMPI_HAVE_MPI_MESSAGE
+  libdumpi_init_message_map();
+#endif
   libdumpi_init_keyval_map();
 #ifdef DUMPI_HAVE_MPI_WIN
   libdumpi_init_win_map();
@@ -535,6 +571,9 @@ void dumpi_free_maps(void) {
   dumpi_hm_op_free(&op_map);
   dumpi_hm_iorequest_free(&iorequest_map);
   dumpi_hm_request_free(&request_map);
+#ifdef DUMPI_HAVE_MPI_MESSAGE
+  dumpi_hm_message_free(&message_map);
+#endif
   dumpi_hm_keyval_free(&keyval_map);
 #ifdef DUMPI_HAVE_MPI_WIN
   dumpi_hm_win_free(&win_map);
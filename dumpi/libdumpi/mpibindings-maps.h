@@ -86,6 +86,13 @@ extern "C" {
    * Get a dumpi request index corresponding to the given MPI_Request.
    */
   dumpi_datatype libdumpi_get_request(MPI_Request mrequest);
+
+#if DUMPI_HAVE_MPI_MESSAGE
+  /**
+   * Get a dumpi message index corresponding to the given MPI_Message.
+   */
+  dumpi_message libdumpi_get_message(MPI_Message mmessage);
+#endif /* ! DUMPI_HAVE_MPI_MESSAGE */
   
   /**
    * Get a dumpi keyval index corresponding to the given MPI key (integer).
@@ -10,8 +10,11 @@
  */
 
 #include <dumpi/libdumpi/mpibindings-utils.h>
+#include <dumpi/libdumpi/data.h>
+#include <dumpi/common/gettime.h>
 #include <dumpi/dumpiconfig.h>
 #include <stdlib.h>
+#include <string.h>
 #include <assert.h>
 
 #ifdef DUMPI_USE_PTHREADS
@@ -19,92 +22,392 @@
 static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
 #endif /* ! DUMPI_USE_PTHREADS */
 
+/* Scratch arena used for argument conversion (see libdumpi_scratch_alloc).
+ * Allocation bumps an offset into one block; overflow requests get their
+ * own block and are folded into a larger arena when it is reset. */
+typedef struct scratch_block {
+  struct scratch_block *next;
+} scratch_block;
+
+/* Overflow blocks keep the same alignment as the arena itself. */
+#define SCRATCH_ALIGN 16
+#define SCRATCH_MIN_CAPACITY 4096
+
+typedef struct scratch_arena {
+  char          *base;
+  size_t         capacity;
+  size_t         used;
+  scratch_block *overflow;
+  size_t         overflow_bytes;
+} scratch_arena;
+
+static void* scratch_alloc(scratch_arena *arena, size_t bytes) {
+  void *ptr;
+  scratch_block *block;
+  bytes = (bytes + SCRATCH_ALIGN - 1) & ~(size_t)(SCRATCH_ALIGN - 1);
+  if(arena->used + bytes <= arena->capacity) {
+    ptr = arena->base + arena->used;
+    arena->used += bytes;
+    return ptr;
+  }
+  block = (scratch_block*)malloc(SCRATCH_ALIGN + bytes);
+  assert(block != NULL);
+  block->next = arena->overflow;
+  arena->overflow = block;
+  arena->overflow_bytes += bytes;
+  return ((char*)block) + SCRATCH_ALIGN;
+}
+
+static void scratch_reset(scratch_arena *arena) {
+  if(arena->overflow != NULL) {
+    size_t needed = arena->used + arena->overflow_bytes;
+    while(arena->overflow != NULL) {
+      scratch_block *next = arena->overflow->next;
+      free(arena->overflow);
+      arena->overflow = next;
+    }
+    arena->overflow_bytes = 0;
+    if(needed < 2*arena->capacity)
+      needed = 2*arena->capacity;
+    if(needed < SCRATCH_MIN_CAPACITY)
+      needed = SCRATCH_MIN_CAPACITY;
+    free(arena->base);
+    arena->base = (char*)malloc(needed);
+    assert(arena->base != NULL);
+    arena->capacity = needed;
+  }
+  arena->used = 0;
+}
+
+/* Time spent waiting for the io lock (only updated while holding it). */
+static uint32_t lock_contended = 0;
+static dumpi_clock lock_wait = {0, 0};
+
 #ifdef DUMPI_USE_PTHREADS
 
 typedef struct callarg {
   int thread_id;
   int calldepth;
+  /* Time spent inside libdumpi, indexed by dumpi_function */
+  dumpi_clock overhead_wall[DUMPI_ALL_FUNCTIONS+1];
+  dumpi_clock overhead_cpu[DUMPI_ALL_FUNCTIONS+1];
+  /* Unsuccessful polls not yet written (coalesce-polls) */
+  libdumpi_poll_run poll_run;
+  /* Temporary storage for argument conversion */
+  scratch_arena scratch;
+  /* Statuses waiting to be written (status-capture lazy) */
+  libdumpi_status_capture status_capture;
+  /* Statistics gathered instead of a trace (mode=profile) */
+  libdumpi_aggregate_state aggregate;
+  /* Point-to-point traffic by destination (comm-matrix) */
+  libdumpi_matrix matrix;
+  /* Call path of the current MPI call (callsites, 0: none) */
+  uint32_t callsite;
+  /* Profiled functions the thread is inside (-finstrument-functions) */
+  libdumpi_funcstack funcs;
+  /* All live per-thread records are chained together for collection. */
+  struct callarg *next;
 } callarg;
 
-static pthread_key_t *key = NULL;
+static pthread_key_t key;
+static pthread_once_t key_once = PTHREAD_ONCE_INIT;
 static int next_id = 0;
 
-static void init_stuff() {
-  if(key == NULL) {
-    assert((key = (pthread_key_t*)malloc(sizeof(pthread_key_t))) != NULL);
-    assert(pthread_key_create(key, free) == 0);
+/* Per-thread records and the overhead left behind by threads that exited.
+ * Both are protected by registry_lock. */
+static pthread_mutex_t registry_lock = PTHREAD_MUTEX_INITIALIZER;
+static callarg *registry = NULL;
+static dumpi_clock retired_wall[DUMPI_ALL_FUNCTIONS+1];
+static dumpi_clock retired_cpu[DUMPI_ALL_FUNCTIONS+1];
+static dumpi_aggregate_func *retired_aggregate = NULL;
+static int retired_threads = 0;
+static libdumpi_matrix retired_matrix = {0, 0, NULL};
+static uint64_t retired_skipped = 0;
+
+static void add_clocks(dumpi_clock *total, const dumpi_clock *value) {
+  static const dumpi_clock zero = {0, 0};
+  dumpi_clock_accumulate(total, &zero, value);
+}
+
+/* Free the arena of an exiting thread. */
+static void scratch_release(scratch_arena *arena) {
+  while(arena->overflow != NULL) {
+    scratch_block *next = arena->overflow->next;
+    free(arena->overflow);
+    arena->overflow = next;
+  }
+  free(arena->base);
+  memset(arena, 0, sizeof(scratch_arena));
+}
+
+/* Fold the overhead of an exiting thread into the retired totals. */
+static void release_callarg(void *arg) {
+  int i;
+  callarg *carg = (callarg*)arg;
+  callarg **curr;
+  libdumpi_poll_close(&carg->poll_run);
+  free(carg->poll_run.args);
+  scratch_release(&carg->scratch);
+  assert(pthread_mutex_lock(&registry_lock) == 0);
+  for(i = 0; i <= DUMPI_ALL_FUNCTIONS; ++i) {
+    add_clocks(&retired_wall[i], &carg->overhead_wall[i]);
+    add_clocks(&retired_cpu[i], &carg->overhead_cpu[i]);
+  }
+  if(carg->aggregate.funcs != NULL) {
+    if(retired_aggregate == NULL) {
+      retired_aggregate = (dumpi_aggregate_func*)
+	calloc(DUMPI_ALL_FUNCTIONS, sizeof(dumpi_aggregate_func));
+      assert(retired_aggregate != NULL);
+    }
+    libdumpi_aggregate_merge(retired_aggregate, &carg->aggregate);
+    ++retired_threads;
+  }
+  libdumpi_matrix_merge(&retired_matrix, &carg->matrix);
+  retired_skipped += carg->funcs.skipped;
+  for(curr = &registry; *curr != NULL; curr = &(*curr)->next) {
+    if(*curr == carg) {
+      *curr = carg->next;
+      break;
+    }
   }
-  if(pthread_getspecific(*key) == NULL) {
-    callarg *carg;
+  assert(pthread_mutex_unlock(&registry_lock) == 0);
+  libdumpi_aggregate_release(&carg->aggregate);
+  libdumpi_matrix_release(&carg->matrix);
+  libdumpi_funcstack_release(&carg->funcs);
+  free(carg);
+}
+
+static void create_key(void) {
+  assert(pthread_key_create(&key, release_callarg) == 0);
+}
+
+static callarg* init_stuff() {
+  callarg *carg;
+  pthread_once(&key_once, create_key);
+  if((carg = (callarg*)pthread_getspecific(key)) == NULL) {
     assert((carg = (callarg*)calloc(1, sizeof(callarg))) != NULL);
+    assert(pthread_mutex_lock(&registry_lock) == 0);
     carg->thread_id = next_id++;
-    assert(pthread_setspecific(*key, carg) == 0);
+    carg->funcs.thread = (uint16_t)carg->thread_id;
+    carg->next = registry;
+    registry = carg;
+    assert(pthread_mutex_unlock(&registry_lock) == 0);
+    assert(pthread_setspecific(key, carg) == 0);
   }
+  return carg;
 }
 
 /* A global lock to protect access to dumpiio routines. */
 int libdumpi_lock_io(void) {
-  init_stuff();
-#ifdef DUMPI_USE_PTHREADS
-  assert(pthread_mutex_lock(&lock) == 0);
-#endif
+  callarg *carg = init_stuff();
+  if(pthread_mutex_trylock(&lock) != 0) {
+    dumpi_clock cpu, start, stop;
+    dumpi_get_time(&cpu, &start);
+    assert(pthread_mutex_lock(&lock) == 0);
+    dumpi_get_time(&cpu, &stop);
+    ++lock_contended;
+    dumpi_clock_accumulate(&lock_wait, &start, &stop);
+  }
+  /* Entries of the profiled functions around the coming record go first */
+  if(carg->funcs.flushed < carg->funcs.depth)
+    libdumpi_funcstack_flush(&carg->funcs);
+  /* Records written under the lock carry the thread's call site */
+  if(dumpi_global && dumpi_global->profile)
+    dumpi_global->profile->callsite = carg->callsite;
   return 1;
 }
 
 /* A global lock for io routines. */
 int libdumpi_unlock_io(void) {
   init_stuff();
-#ifdef DUMPI_USE_PTHREADS
+  if(dumpi_global && dumpi_global->profile)
+    dumpi_global->profile->callsite = 0;
   assert(pthread_mutex_unlock(&lock) == 0);
-#endif
   return 1;
 }
 
 /* Get a unique thread index for this thread. */
 int libdumpi_get_thread_id(void) {
-  callarg *carg;
-  init_stuff();
-  assert((carg = (callarg*)pthread_getspecific(*key)) != NULL);
+  callarg *carg = init_stuff();
   return carg->thread_id;
 }
 
 /* Increase call depth counter for this thread. */
 int libdumpi_enter_mpi(void) {
-  callarg *carg;
-  init_stuff();
-  assert((carg = (callarg*)pthread_getspecific(*key)) != NULL);
+  callarg *carg = init_stuff();
   ++carg->calldepth;
   return carg->calldepth;
 }
 
 /* Decrease call depth counter for this thread. */
 int libdumpi_exit_mpi(void) {
-  callarg *carg;
-  init_stuff();
-  assert((carg = (callarg*)pthread_getspecific(*key)) != NULL);
+  callarg *carg = init_stuff();
   assert(carg->calldepth > 0);
   --carg->calldepth;
+  if(carg->calldepth == 0) {
+    scratch_reset(&carg->scratch);
+    carg->callsite = 0;
+  }
   return carg->calldepth;
 }
 
 /* Read current call depth. */
 int libdumpi_get_call_depth(void) {
-  callarg *carg;
-  init_stuff();
-  assert((carg = (callarg*)pthread_getspecific(*key)) != NULL);
+  callarg *carg = init_stuff();
   return carg->calldepth;
 }
 
+/* Get temporary storage from this thread's scratch arena. */
+void* libdumpi_scratch_alloc(size_t bytes) {
+  callarg *carg = init_stuff();
+  return scratch_alloc(&carg->scratch, bytes);
+}
+
+/* Add the time since the given start time to this thread's overhead. */
+void libdumpi_add_overhead(int func, const dumpi_clock *cpu_start,
+			   const dumpi_clock *wall_start)
+{
+  dumpi_clock cpu, wall;
+  callarg *carg = init_stuff();
+  dumpi_get_time(&cpu, &wall);
+  dumpi_clock_accumulate(&carg->overhead_wall[func], wall_start, &wall);
+  dumpi_clock_accumulate(&carg->overhead_cpu[func], cpu_start, &cpu);
+}
+
+/* Sum up overhead from all threads (live or not) into the footer. */
+void libdumpi_collect_overhead(dumpi_footer *footer) {
+  int i;
+  callarg *curr;
+  assert(footer != NULL);
+  assert(pthread_mutex_lock(&registry_lock) == 0);
+  memcpy(footer->overhead_wall, retired_wall, sizeof(retired_wall));
+  memcpy(footer->overhead_cpu, retired_cpu, sizeof(retired_cpu));
+  for(curr = registry; curr != NULL; curr = curr->next) {
+    for(i = 0; i <= DUMPI_ALL_FUNCTIONS; ++i) {
+      add_clocks(&footer->overhead_wall[i], &curr->overhead_wall[i]);
+      add_clocks(&footer->overhead_cpu[i], &curr->overhead_cpu[i]);
+    }
+  }
+  assert(pthread_mutex_unlock(&registry_lock) == 0);
+  footer->writer.lock_contended = lock_contended;
+  footer->writer.lock_wait = lock_wait;
+}
+
+/* Get this thread's run of coalesced polls. */
+libdumpi_poll_run* libdumpi_get_poll_run(void) {
+  callarg *carg = init_stuff();
+  return &carg->poll_run;
+}
+
+/* Visit the poll runs of all live threads. */
+void libdumpi_foreach_poll_run(void (*fn)(libdumpi_poll_run*)) {
+  callarg *curr;
+  assert(pthread_mutex_lock(&registry_lock) == 0);
+  for(curr = registry; curr != NULL; curr = curr->next)
+    fn(&curr->poll_run);
+  assert(pthread_mutex_unlock(&registry_lock) == 0);
+}
+
+/* Get this thread's most recent status capture. */
+libdumpi_status_capture* libdumpi_get_status_capture(void) {
+  callarg *carg = init_stuff();
+  return &carg->status_capture;
+}
+
+/* Get this thread's statistics (mode=profile). */
+libdumpi_aggregate_state* libdumpi_get_aggregate(void) {
+  callarg *carg = init_stuff();
+  return &carg->aggregate;
+}
+
+/* Sum up the statistics of all threads (live or not). */
+int libdumpi_collect_aggregate(dumpi_aggregate_func *total) {
+  int func, threads;
+  callarg *curr;
+  assert(total != NULL);
+  assert(pthread_mutex_lock(&registry_lock) == 0);
+  threads = retired_threads;
+  if(retired_aggregate != NULL)
+    for(func = 0; func < DUMPI_ALL_FUNCTIONS; ++func)
+      dumpi_aggregate_merge(&total[func], &retired_aggregate[func]);
+  for(curr = registry; curr != NULL; curr = curr->next) {
+    if(curr->aggregate.funcs != NULL) {
+      libdumpi_aggregate_merge(total, &curr->aggregate);
+      ++threads;
+    }
+  }
+  assert(pthread_mutex_unlock(&registry_lock) == 0);
+  return threads;
+}
+
+/* Get this thread's point-to-point traffic (comm-matrix). */
+libdumpi_matrix* libdumpi_get_matrix(void) {
+  callarg *carg = init_stuff();
+  return &carg->matrix;
+}
+
+/* Set the call path of this thread's current MPI call. */
+void libdumpi_set_callsite(uint32_t id) {
+  callarg *carg = init_stuff();
+  carg->callsite = id;
+}
+
+/* Get this thread's function instrumentation state. */
+libdumpi_funcstack* libdumpi_get_funcstack(void) {
+  callarg *carg = init_stuff();
+  return &carg->funcs;
+}
+
+/* Sum up the instrumented calls left out by all threads. */
+uint64_t libdumpi_collect_skipped_calls(void) {
+  callarg *curr;
+  uint64_t skipped;
+  assert(pthread_mutex_lock(&registry_lock) == 0);
+  skipped = retired_skipped;
+  for(curr = registry; curr != NULL; curr = curr->next)
+    skipped += curr->funcs.skipped;
+  assert(pthread_mutex_unlock(&registry_lock) == 0);
+  return skipped;
+}
+
+/* Sum up the traffic of all threads (live or not). */
+void libdumpi_collect_matrix(libdumpi_matrix *total) {
+  callarg *curr;
+  assert(total != NULL);
+  assert(pthread_mutex_lock(&registry_lock) == 0);
+  libdumpi_matrix_merge(total, &retired_matrix);
+  for(curr = registry; curr != NULL; curr = curr->next)
+    libdumpi_matrix_merge(total, &curr->matrix);
+  assert(pthread_mutex_unlock(&registry_lock) == 0);
+}
+
 #else /* ! DUMPI_USE_PTHREADS */
 
 static int calldepth = 0;
+static dumpi_clock overhead_wall[DUMPI_ALL_FUNCTIONS+1];
+static dumpi_clock overhead_cpu[DUMPI_ALL_FUNCTIONS+1];
+static libdumpi_poll_run poll_run;
+static scratch_arena scratch;
+static libdumpi_status_capture status_capture;
+static libdumpi_aggregate_state aggregate;
+static libdumpi_matrix matrix;
+static uint32_t callsite = 0;
+static libdumpi_funcstack funcs;
 
 /* A global lock to protect access to dumpiio routines. */
 int libdumpi_lock_io(void) {
+  if(funcs.flushed < funcs.depth)
+    libdumpi_funcstack_flush(&funcs);
+  if(dumpi_global && dumpi_global->profile)
+    dumpi_global->profile->callsite = callsite;
+  return 1;
 }
 
 /* A global lock for io routines. */
 int libdumpi_unlock_io(void) {
+  if(dumpi_global && dumpi_global->profile)
+    dumpi_global->profile->callsite = 0;
+  return 1;
 }
 
 /* Get a unique thread index for this thread. */
@@ -121,6 +424,10 @@ int libdumpi_enter_mpi(void) {
 /* Decrease call depth counter for this thread. */
 int libdumpi_exit_mpi(void) {
   --calldepth;
+  if(calldepth == 0) {
+    scratch_reset(&scratch);
+    callsite = 0;
+  }
   return calldepth;
 }
 
@@ -129,4 +436,81 @@ int libdumpi_get_call_depth(void) {
   return calldepth;
 }
 
+/* Get temporary storage from the scratch arena. */
+void* libdumpi_scratch_alloc(size_t bytes) {
+  return scratch_alloc(&scratch, bytes);
+}
+
+/* Add the time since the given start time to the overhead. */
+void libdumpi_add_overhead(int func, const dumpi_clock *cpu_start,
+			   const dumpi_clock *wall_start)
+{
+  dumpi_clock cpu, wall;
+  dumpi_get_time(&cpu, &wall);
+  dumpi_clock_accumulate(&overhead_wall[func], wall_start, &wall);
+  dumpi_clock_accumulate(&overhead_cpu[func], cpu_start, &cpu);
+}
+
+/* Copy the overhead into the footer. */
+void libdumpi_collect_overhead(dumpi_footer *footer) {
+  assert(footer != NULL);
+  memcpy(footer->overhead_wall, overhead_wall, sizeof(overhead_wall));
+  memcpy(footer->overhead_cpu, overhead_cpu, sizeof(overhead_cpu));
+  footer->writer.lock_contended = lock_contended;
+  footer->writer.lock_wait = lock_wait;
+}
+
+/* Get the run of coalesced polls. */
+libdumpi_poll_run* libdumpi_get_poll_run(void) {
+  return &poll_run;
+}
+
+/* Visit the (only) poll run. */
+void libdumpi_foreach_poll_run(void (*fn)(libdumpi_poll_run*)) {
+  fn(&poll_run);
+}
+
+/* Get the most recent status capture. */
+libdumpi_status_capture* libdumpi_get_status_capture(void) {
+  return &status_capture;
+}
+
+/* Get the statistics (mode=profile). */
+libdumpi_aggregate_state* libdumpi_get_aggregate(void) {
+  return &aggregate;
+}
+
+/* Copy the statistics into the totals. */
+int libdumpi_collect_aggregate(dumpi_aggregate_func *total) {
+  assert(total != NULL);
+  libdumpi_aggregate_merge(total, &aggregate);
+  return (aggregate.funcs != NULL);
+}
+
+/* Get the point-to-point traffic (comm-matrix). */
+libdumpi_matrix* libdumpi_get_matrix(void) {
+  return &matrix;
+}
+
+/* Copy the traffic into the totals. */
+void libdumpi_collect_matrix(libdumpi_matrix *total) {
+  assert(total != NULL);
+  libdumpi_matrix_merge(total, &matrix);
+}
+
+/* Set the call path of the current MPI call. */
+void libdumpi_set_callsite(uint32_t id) {
+  callsite = id;
+}
+
+/* Get the function instrumentation state. */
+libdumpi_funcstack* libdumpi_get_funcstack(void) {
+  return &funcs;
+}
+
+/* Number of instrumented calls left out. */
+uint64_t libdumpi_collect_skipped_calls(void) {
+  return funcs.skipped;
+}
+
 #endif /* DUMPI_USE_PTHREADS */
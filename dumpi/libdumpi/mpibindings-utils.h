@@ -12,6 +12,15 @@
 #ifndef DUMPI_LIBDUMPI_MPIBINDINGS_UTILS_H
 #define DUMPI_LIBDUMPI_MPIBINDINGS_UTILS_H
 
+#include <dumpi/common/types.h>
+#include <dumpi/libdumpi/pollsummary.h>
+#include <dumpi/libdumpi/statuscapture.h>
+#include <dumpi/libdumpi/aggregate.h>
+#include <dumpi/libdumpi/commmatrix.h>
+#include <dumpi/libdumpi/instrument.h>
+#include <stddef.h>
+#include <stdint.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif /* ! __cplusplus */
@@ -42,7 +51,8 @@ extern "C" {
 
   /**
    * Decrease call depth counter for this thread.
-   * A call count of 0 indicates that the thread is completely outside MPI.
+   * A call count of 0 indicates that the thread is completely outside MPI;
+   * at that point the thread's scratch arena is reset.
    */
   int libdumpi_exit_mpi(void);
 
@@ -51,6 +61,89 @@ extern "C" {
    */
   int libdumpi_get_call_depth(void);
 
+  /**
+   * Get temporary storage for argument conversion from the calling
+   * thread's scratch arena.  The memory must not be freed; it stays valid
+   * until the thread leaves the outermost MPI call (the arena is reset in
+   * libdumpi_exit_mpi, called from DUMPI_INSERT_POSTAMBLE).
+   * Requests that do not fit the arena get their own block, and the arena
+   * grows to cover them at the next reset.
+   */
+  void* libdumpi_scratch_alloc(size_t bytes);
+
+  /**
+   * Charge the time elapsed since the given start times to the calling
+   * thread's overhead total for the given dumpi_function.
+   * Used by DUMPI_STOP_OVERHEAD.
+   */
+  void libdumpi_add_overhead(int func, const dumpi_clock *cpu_start,
+                             const dumpi_clock *wall_start);
+
+  /**
+   * Sum up the overhead totals for all threads (including threads that
+   * have exited) and store them in the footer, along with the time
+   * spent waiting for the I/O lock.
+   */
+  void libdumpi_collect_overhead(dumpi_footer *footer);
+
+  /**
+   * Get the calling thread's run of coalesced polling calls.
+   */
+  libdumpi_poll_run* libdumpi_get_poll_run(void);
+
+  /**
+   * Apply the given function to the poll runs of all live threads.
+   */
+  void libdumpi_foreach_poll_run(void (*fn)(libdumpi_poll_run*));
+
+  /**
+   * Get the calling thread's most recent status capture.
+   */
+  libdumpi_status_capture* libdumpi_get_status_capture(void);
+
+  /**
+   * Get the calling thread's statistics (mode=profile).
+   */
+  libdumpi_aggregate_state* libdumpi_get_aggregate(void);
+
+  /**
+   * Add the statistics of all threads (including those that
+   * have exited) to the given totals, indexed by dumpi_function.
+   * \return the number of threads that made MPI calls.
+   */
+  int libdumpi_collect_aggregate(dumpi_aggregate_func *total);
+
+  /**
+   * Get the calling thread's point-to-point traffic (comm-matrix).
+   */
+  libdumpi_matrix* libdumpi_get_matrix(void);
+
+  /**
+   * Add the traffic of all threads (including those that
+   * have exited) to the given table.
+   */
+  void libdumpi_collect_matrix(libdumpi_matrix *total);
+
+  /**
+   * Set the call path of the calling thread's current MPI call (callsites).
+   * libdumpi_lock_io hands it to the trace profile, so the record written
+   * under the lock carries it;  it is cleared when the thread leaves the
+   * outermost MPI call.
+   */
+  void libdumpi_set_callsite(uint32_t id);
+
+  /**
+   * Get this thread's function instrumentation state.  libdumpi_lock_io
+   * writes the entry records it holds back.
+   */
+  libdumpi_funcstack* libdumpi_get_funcstack(void);
+
+  /**
+   * Number of instrumented calls left out by all threads (including
+   * those that have exited).
+   */
+  uint64_t libdumpi_collect_skipped_calls(void);
+
 #ifdef __cplusplus
 } /* end of extern C block */
 #endif /* ! __cplusplus */
@@ -15,6 +15,13 @@
 #include <dumpi/libdumpi/mpibindings-maps.h>
 #include <dumpi/libdumpi/mpibindings-utils.h>
 #include <dumpi/libdumpi/init.h>
+#include <dumpi/libdumpi/trigger.h>
+#include <dumpi/libdumpi/aggregate.h>
+#include <dumpi/libdumpi/commmatrix.h>
+#include <dumpi/libdumpi/rankselect.h>
+#include <dumpi/libdumpi/callsite.h>
+#include <dumpi/libdumpi/flushpolicy.h>
+#include <dumpi/libdumpi/clocksync.h>
 #include <dumpi/libdumpi/data.h>
 #include <dumpi/common/gettime.h>
 #include <dumpi/common/perfctrs.h>
@@ -41,6 +48,31 @@ extern "C" {
 #define DUMPI_PROFILING(FUNC)                                                 \
   (dumpi_global->output->function[FUNC] && dumpi_global->output->function[DUMPI_ALL_FUNCTIONS])
 
+  /** Test whether a call is recorded by this rank:  ranks left out of
+   * trace-ranks only record the calls that describe communicators,
+   * groups, and datatypes. */
+#define DUMPI_RECORDED(FUNC)						\
+  (! dumpi_global->untraced || libdumpi_rankselect_skeleton(FUNC))
+
+  /** Test whether a call to a sampled function should be recorded.
+   * Unsampled functions (the common case) only pay for a single test. */
+#define DUMPI_SAMPLED(FUNC)						\
+  (dumpi_global->sampling == 0 || dumpi_global->sample_period[FUNC] == 0 \
+   || libdumpi_sample_call(FUNC))
+
+  /** The detail level configured for the arrays of a vector collective */
+#define DUMPI_ARG_DETAIL(FUNC)						\
+  ((dumpi_arg_detail)dumpi_global->arg_detail[FUNC])
+
+  /** Test whether the next tracing trigger (see trigger.h) is reached.
+   * Only the count of the current function is compared, and the clock is
+   * only read while a time trigger is pending. */
+#define DUMPI_TRIGGER_DUE(FUNC)						\
+  ((dumpi_global->trigger_func == (FUNC) &&				\
+    dumpi_global->footer->call_count[FUNC] >= dumpi_global->trigger_count) \
+   || (dumpi_global->trigger_time != 0 &&				\
+       time(NULL) >= dumpi_global->trigger_time))
+
   /** Increment the count for how often a given function has been
    * profiled but not output to the stream */
 #define DUMPI_INCREMENT_IGNORED(FUNC) do {                 \
@@ -58,7 +90,8 @@ extern "C" {
   /** Common setup stuff used in all MPI_* functions.
    * This is an ugly side-effect of the auto-generated MPI bindings */
 #define DUMPI_INSERT_PREAMBLE(FUNC)					\
-  int profiling, call_depth;						\
+  int profiling, aggregating, call_depth;				\
+  dumpi_clock_pair overhead_start;					\
   call_depth = libdumpi_enter_mpi();					\
   assert(call_depth > 0);						\
   if(dumpi_debug & DUMPI_DEBUG_MPICALLS)				\
@@ -72,13 +105,73 @@ extern "C" {
       fprintf(stderr, "[DUMPI-MPI] libdumpi initialized\n");		\
   }									\
   assert(dumpi_global != NULL);						\
-  profiling = (call_depth == 1) && DUMPI_PROFILING(FUNC);		\
+  if(call_depth == 1) DUMPI_START_OVERHEAD(FUNC);			\
+  if(dumpi_global->triggers && call_depth == 1 && DUMPI_TRIGGER_DUE(FUNC)) \
+    libdumpi_trigger_fire();						\
+  profiling = ((call_depth == 1) && DUMPI_PROFILING(FUNC));		\
+  /* In mode=profile calls are counted and timed but never written, */	\
+  /* untraced ranks may count them on top of their skeleton trace */	\
+  aggregating = (profiling && (dumpi_global->aggregate ||		\
+				(dumpi_global->untraced &&		\
+				 dumpi_global->untraced_profile)));	\
+  profiling = (profiling && ! dumpi_global->aggregate &&		\
+	       DUMPI_RECORDED(FUNC) && DUMPI_SAMPLED(FUNC));		\
   if(!profiling) DUMPI_INCREMENT_IGNORED(FUNC);				\
-  DUMPI_INCREMENT_CALLED(FUNC)
+  DUMPI_INCREMENT_CALLED(FUNC);						\
+  if(libdumpi_snapshot_requested && call_depth == 1)			\
+    libdumpi_ring_snapshot();						\
+  if(dumpi_global->coalesce_polls && call_depth == 1)			\
+    libdumpi_poll_interrupt(FUNC);					\
+  if(profiling && dumpi_global->callsites)				\
+    libdumpi_callsite_capture();					\
+  if(aggregating) libdumpi_aggregate_enter(FUNC);			\
+  if(call_depth == 1) DUMPI_STOP_OVERHEAD(FUNC)
+
+  /** Note the bytes sent and received by a call in mode=profile.
+   * The arguments are only evaluated when the call is aggregated. */
+#define DUMPI_AGGREGATE_BYTES(SENT, RECVD) do {			\
+    if(aggregating) libdumpi_aggregate_bytes(SENT, RECVD);		\
+} while(0)
+
+  /** Same as DUMPI_AGGREGATE_BYTES for a rooted collective, where the
+   * root moves different data than the other ranks. */
+#define DUMPI_AGGREGATE_ROOTED_BYTES(ROOT, COMM, ROOT_SENT, ROOT_RECVD,	\
+				     SENT, RECVD) do {			\
+    if(aggregating) {							\
+      if(libdumpi_comm_is_root(ROOT, COMM))				\
+	libdumpi_aggregate_bytes(ROOT_SENT, ROOT_RECVD);		\
+      else								\
+	libdumpi_aggregate_bytes(SENT, RECVD);				\
+    }									\
+} while(0)
+
+  /** Count a point-to-point send in the communication matrix
+   * (comm-matrix).  Sends are counted whether or not they are traced. */
+#define DUMPI_MATRIX_SEND(DEST, COUNT, TYPE, COMM) do {		\
+    if(dumpi_global->comm_matrix && call_depth == 1)			\
+      libdumpi_matrix_send(DEST, COUNT, TYPE, COMM);			\
+} while(0)
+
+  /** Offer the flush policy a flush point after a blocking collective
+   * (see flushpolicy.h).  Done whether or not the call is profiled, so
+   * that every rank reaches the same flush points. */
+#define DUMPI_FLUSH_POINT(COMM) do {					\
+    if(dumpi_global->flush_points && call_depth == 1 &&		\
+       (COMM) == MPI_COMM_WORLD)					\
+      libdumpi_flush_point();						\
+} while(0)
+
+  /** Test whether an unsuccessful polling call was folded into a poll
+   * summary record (so no record of its own should be written).
+   * Expects the thread, cpu, and wall variables of the MPI bindings. */
+#define DUMPI_POLL_COALESCED(FUNC, FLAG, COUNT, ARGS)			\
+  (dumpi_global->coalesce_polls &&					\
+   libdumpi_poll_coalesce(FUNC, FLAG, COUNT, ARGS, thread, &cpu, &wall))
 
   /** Common tear-down stuff used in all MPI_* functions.
    * Another ugly side effect of the auto-generated MPI bindings */
 #define DUMPI_INSERT_POSTAMBLE do {					\
+    if(aggregating) libdumpi_aggregate_exit();				\
     call_depth = libdumpi_exit_mpi();					\
     if(dumpi_debug & DUMPI_DEBUG_MPICALLS)				\
       fprintf(stderr, "[DUMPI-MPI] MPI call complete at call depth %d\n", call_depth); \
@@ -108,19 +201,13 @@ extern "C" {
 
   /** 
    * Data type used to hold a wall clock timer and cpu timer together.
-   * Used in the overhead profiling (currently disabled).
+   * Used in the overhead profiling.
    */
   typedef struct dumpi_clock_pair {
     dumpi_clock wall;
     dumpi_clock cpu;
   } dumpi_clock_pair;
 
-  /*
-  static dumpi_clock_pair *overhead_start = NULL;
-  static dumpi_clock_pair *overhead_stop = NULL;
-  static dumpi_clock_pair *overhead_accum = NULL;
-  */
-
   /** Utility definitino to find the difference between two time values */
 #define DUMPI_SUBTRACT_TIME(DEST, LEFT, RIGHT) do {     \
   DEST.nsec = LEFT.nsec - RIGHT.nsec;                   \
@@ -133,46 +220,32 @@ extern "C" {
 } while(0)
 
   /** Utility routine for starting overhead counting.
-   * Currently disabled
+   * Each START/STOP pair brackets time spent in libdumpi (the preamble,
+   * argument conversion, and record output) as opposed to time spent
+   * in PMPI.  Off unless overhead is enabled in dumpi.conf.
    */
-#define DUMPI_START_OVERHEAD(FUNC)
+#define DUMPI_START_OVERHEAD(FUNC) do {					\
+    if(dumpi_global->output->overhead)					\
+      dumpi_get_time(&overhead_start.cpu, &overhead_start.wall);	\
+} while(0)
 
   /**
    * Utility routine for stopping overhead counting.
-   * Currently disabled
+   * The elapsed time is added to a per-thread accumulator (no locking);
+   * the totals get written to the footer at finalize time.
    */
-#define DUMPI_STOP_OVERHEAD(FUNC)
-
-/* #define DUMPI_START_OVERHEAD(FUNC) do {                                 \ */
-/*   if(overhead_start == NULL) {                                          \ */
-/*     overhead_start =                                                    \ */
-/*       (dumpi_clock_pair*)malloc(DUMPI_ALL_FUNCTIONS*sizeof(dumpi_clock)); \ */
-/*     assert(overhead_start != NULL);                                     \ */
-/*   }                                                                     \ */
-/*   dumpi_get_time(&overhead_start[FUNC].cpu, &overhead_start[FUNC].wall);\ */
-/* } while(0) */
-
-/* #define DUMPI_STOP_OVERHEAD(FUNC) do {                                  \ */
-/*   if(overhead_accum == NULL) {                                          \ */
-/*     overhead_accum =                                                    \ */
-/*       (dumpi_clock_pair*)calloc(DUMPI_ALL_FUNCTIONS, sizeof(dumpi_clock));\ */
-/*     assert(overhead_accum != NULL);                                     \ */
-/*   }                                                                     \ */
-/*   if(overhead_stop == NULL) {                                           \ */
-/*     overhead_stop =                                                     \ */
-/*       (dumpi_clock_pair*)malloc(DUMPI_ALL_FUNCTIONS*sizeof(dumpi_clock)); \ */
-/*     assert(overhead_stop != NULL);                                      \ */
-/*   }                                                                     \ */
-/*   assert(overhead_start != NULL);                                       \ */
-/*   dumpi_get_time(&overhead_stop[FUNC].cpu, &overhead_stop[FUNC].wall);  \ */
-/*   DUMPI_SUBTRACT_TIME(overhead_accum[FUNC].wall,                        \ */
-/*                       overhead_stop[FUNC].wall, overhead_start[FUNC].wall); \ */
-/*   DUMPI_SUBTRACT_TIME(overhead_accum[FUNC].cpu,                         \ */
-/*                       overhead_stop[FUNC].cpu, overhead_start[FUNC].cpu); \ */
-/* } while(0) */
+#define DUMPI_STOP_OVERHEAD(FUNC) do {					\
+    if(dumpi_global->output->overhead)					\
+      libdumpi_add_overhead(FUNC, &overhead_start.cpu,			\
+			    &overhead_start.wall);			\
+} while(0)
 
   /* Conversion/assignment routines */
 
+  /* Arrays built by the conversion routines come from the calling thread's
+   * scratch arena (libdumpi_scratch_alloc) and are released all at once
+   * by DUMPI_INSERT_POSTAMBLE, so the "free data" routines are no-ops. */
+
   /** A type conversion routine -- used by the auto-generated MPI bindings */
 #define DUMPI_INT_FROM_INT(A, B) A=(B)
   /** Integer arrays are not copied by value -- just grab the pointer */
@@ -188,8 +261,8 @@ extern "C" {
   /** A type conversion routine -- used by the auto-generated MPI bindings */
 #define DUMPI_INT_FROM_INT_ARRAY_2_FIXBOUND(ROWS, COLS, A, B) do {    \
   int i, j;							\
-  assert(((A) = (int**)malloc((ROWS)*sizeof(int*))) != NULL);	\
-  assert(((A)[0] = (int*)malloc((ROWS)*(COLS)*sizeof(int))) != NULL);	\
+  (A) = (int**)libdumpi_scratch_alloc((ROWS)*sizeof(int*));	\
+  (A)[0] = (int*)libdumpi_scratch_alloc((ROWS)*(COLS)*sizeof(int));	\
   /* Set the pointers for elements 1 through n*/                \
   for(i = 1; i < (ROWS); ++i) {                                 \
     (A)[i] = (A)[0] + i*(COLS);                                 \
@@ -203,10 +276,7 @@ extern "C" {
 } while(0)
 
   /** A "free data" routine -- used by the auto-generated MPI bindings */
-#define DUMPI_FREE_INT_FROM_INT_ARRAY_2_FIXBOUND(ROWS, A) do {        \
-  free((A)[0]);                                                 \
-  free(A);                                                      \
-} while(0)
+#define DUMPI_FREE_INT_FROM_INT_ARRAY_2_FIXBOUND(ROWS, A) do {} while(0)
 
   /** A type conversion routine -- used by the auto-generated MPI bindings */
 #define DUMPI_INT_FROM_MPI_AINT(A, B) A = (B)
@@ -215,8 +285,7 @@ extern "C" {
   /** A type conversion routine -- used by the auto-generated MPI bindings */
 #define DUMPI_INT_FROM_MPI_AINT_ARRAY_1(COUNT, A, B)  do {    \
   if((COUNT) > 0) {                                     \
-    A = (int*)malloc((COUNT)*sizeof(int));              \
-    assert(A != NULL);                                  \
+    A = (int*)libdumpi_scratch_alloc((COUNT)*sizeof(int)); \
     memcpy(A, (B), (COUNT)*sizeof(int));                \
   }                                                     \
   else {                                                \
@@ -226,11 +295,7 @@ extern "C" {
 
   /* Avoid memory leaks when sizeof(MPI_Aint)!=sizeof(int) */
   /** A "free data" routine -- used by the auto-generated MPI bindings */
-#define DUMPI_FREE_INT_FROM_MPI_AINT(A) do {          \
-  if((A) != NULL) {                             \
-    free(A);                                    \
-  }                                             \
-} while(0)
+#define DUMPI_FREE_INT_FROM_MPI_AINT(A) do {} while(0)
 
   /** A type conversion routine -- used by the auto-generated MPI bindings */
 #define DUMPI_INT64T_FROM_MPI_OFFSET(A, B) A=((int64_t)(B))
@@ -251,15 +316,19 @@ extern "C" {
 #else
   /* GRH: have to actually allocate, since everything is const in MPI 3 */
 #define DUMPI_CHAR_FROM_CHAR_ARRAY_1(LEN, A, B) do {  \
-  A = (char*)malloc(sizeof(char) * LEN);  \
-  strcpy(A, B);   \
-  if(LEN >= 0) {                                \
-        (A)[LEN]='\0';                              \
-      }   \
+  if((B) != NULL) {                             \
+    size_t len = ((LEN) >= 0 ? (size_t)(LEN) : strlen(B)); \
+    A = (char*)libdumpi_scratch_alloc(len + 1); \
+    memcpy(A, B, len);                          \
+    (A)[len]='\0';                              \
+  }                                             \
+  else {                                        \
+    A = NULL;                                   \
+  }                                             \
 } while(0)
 
   /** A "free data" routine -- used by the auto-generated MPI bindings */
-#define DUMPI_FREE_CHAR_FROM_CHAR(A) free(A);
+#define DUMPI_FREE_CHAR_FROM_CHAR(A) do {} while(0)
 
 #endif
   /* 
@@ -536,8 +605,7 @@ extern "C" {
 #define DUMPI_DATATYPE_FROM_MPI_DATATYPE_ARRAY_1(COUNT, A, B) do {      \
   if(((COUNT) > 0) && ((B) != NULL)) {                                  \
     int i;                                                              \
-    A = (dumpi_datatype*)malloc((COUNT)*sizeof(dumpi_datatype));        \
-    assert(A != NULL);                                                  \
+    A = (dumpi_datatype*)libdumpi_scratch_alloc((COUNT)*sizeof(dumpi_datatype)); \
     for(i = 0; i < (COUNT); ++i)                                        \
       DUMPI_DATATYPE_FROM_MPI_DATATYPE((A)[i], (B)[i]);                 \
   }                                                                     \
@@ -547,7 +615,7 @@ extern "C" {
 } while(0)
 
   /** Free dynamically allocated array of dumpi datatypes */
-#define DUMPI_FREE_DATATYPE_FROM_MPI_DATATYPE(A) free(A)
+#define DUMPI_FREE_DATATYPE_FROM_MPI_DATATYPE(A) do {} while(0)
 
   /** Convert an MPI distribution value to a dumpi distribution */
   static inline dumpi_distribution dumpi_distribution_from_int(int mpi_distribution) {
@@ -574,8 +642,7 @@ extern "C" {
 #define DUMPI_DISTRIBUTION_FROM_INT_ARRAY_1(COUNT, A, B) do {           \
     if((COUNT) > 0) {                                                   \
       int i;                                                              \
-      A = (dumpi_distribution*)malloc((COUNT)*sizeof(dumpi_distribution)); \
-      assert((A) != NULL);                                              \
+      A = (dumpi_distribution*)libdumpi_scratch_alloc((COUNT)*sizeof(dumpi_distribution)); \
       for(i = 0; i < (COUNT); ++i)                                      \
         DUMPI_DISTRIBUTION_FROM_INT((A)[i], (B)[i]);                    \
     }                                                                   \
@@ -585,7 +652,7 @@ extern "C" {
 } while(0)
 
   /** Free a dynamically allocated array of dumpi datatypes. */
-#define DUMPI_FREE_DISTRIBUTION_FROM_INT(A) free(A)
+#define DUMPI_FREE_DISTRIBUTION_FROM_INT(A) do {} while(0)
 
   /** Convert an MPI errorcode to a dumpi errorcode */
 #define DUMPI_ERRCODE_FROM_INT(A, B)            \
@@ -595,8 +662,7 @@ extern "C" {
 #define DUMPI_ERRCODE_FROM_INT_ARRAY_1(COUNT, A, B) do {                  \
     if((COUNT)>0 && (B)!=NULL) {                                        \
       int i;                                                            \
-      A = (dumpi_errcode*)malloc((COUNT)*sizeof(dumpi_errcode));        \
-      assert(A != NULL);                                                \
+      A = (dumpi_errcode*)libdumpi_scratch_alloc((COUNT)*sizeof(dumpi_errcode)); \
       for(i = 0; i < (COUNT); ++i) {                                    \
         DUMPI_ERRCODE_FROM_INT((A)[i], (B)[i]);                         \
       }                                                                 \
@@ -604,7 +670,7 @@ extern "C" {
 } while(0)
 
   /** Free a dynamically allocated array of dumpi errorcodes */
-#define DUMPI_FREE_ERRCODE_FROM_INT(A) free(A)
+#define DUMPI_FREE_ERRCODE_FROM_INT(A) do {} while(0)
 
   /** Convert an MPI errhandler to a dumpi errhandler */
 #define DUMPI_ERRHANDLER_FROM_MPI_ERRHANDLER(A, B) \
@@ -662,8 +728,7 @@ extern "C" {
 #define DUMPI_INFO_FROM_MPI_INFO_ARRAY_1(COUNT, A, B) do {      \
   if((COUNT) > 0 && (B) != NULL) {                              \
     int i;                                                      \
-    A = (dumpi_info*)malloc((COUNT)*sizeof(dumpi_info));        \
-    assert(A != NULL);                                          \
+    A = (dumpi_info*)libdumpi_scratch_alloc((COUNT)*sizeof(dumpi_info)); \
     for(i = 0; i < (COUNT); ++i) {                              \
       DUMPI_INFO_FROM_MPI_INFO((A)[i], (B)[i]);                 \
     }                                                           \
@@ -674,7 +739,7 @@ extern "C" {
 } while(0)
 
   /** Free a dynamically allocated array of dumpi info handles. */
-#define DUMPI_FREE_INFO_FROM_MPI_INFO(A) free(A)
+#define DUMPI_FREE_INFO_FROM_MPI_INFO(A) do {} while(0)
 
   /** Convert an MPI lock to a dumpi lock handle. */
   static inline dumpi_locktype dumpi_locktype_from_int(int mpi_locktype) {
@@ -714,12 +779,15 @@ extern "C" {
 #define DUMPI_REQUEST_FROM_MPI_REQUEST(A, B)          \
   A = libdumpi_get_request(B)
 
+  /** Get the dumpi message handle corresponding to an MPI_Message. */
+#define DUMPI_MESSAGE_FROM_MPI_MESSAGE(A, B)          \
+  A = libdumpi_get_message(B)
+
   /** Get the dumpi request handles corresponding to an array of MPI_Requests */
 #define DUMPI_REQUEST_FROM_MPI_REQUEST_ARRAY_1(COUNT, A, B) do {      \
   if((COUNT) > 0 && (B) != NULL) {                                      \
     int i;                                                              \
-    A = (dumpi_request*)malloc((COUNT)*sizeof(dumpi_request));        \
-    assert(A != NULL);                                                  \
+    A = (dumpi_request*)libdumpi_scratch_alloc((COUNT)*sizeof(dumpi_request)); \
     for(i = 0; i < (COUNT); ++i) {                                      \
       DUMPI_REQUEST_FROM_MPI_REQUEST((A)[i], (B)[i]);                 \
     }                                                                   \
@@ -730,7 +798,7 @@ extern "C" {
 } while(0)
 
   /** Free a dynamically allocated array of dumpi request handles */
-#define DUMPI_FREE_REQUEST_FROM_MPI_REQUEST(A) free(A)
+#define DUMPI_FREE_REQUEST_FROM_MPI_REQUEST(A) do {} while(0)
 
   /** Autoconf test for whether MPIO_Request is the same as MPI_Request */
 #ifdef MPIO_USES_MPI_REQUEST
@@ -752,8 +820,7 @@ extern "C" {
 #define DUMPIO_REQUEST_FROM_MPIO_REQUEST_ARRAY_1(COUNT, A, B) do {      \
   if((COUNT) > 0 && (B) != NULL) {                                      \
     int i;                                                              \
-    A = (dumpio_request*)malloc((COUNT)*sizeof(dumpio_request));        \
-    assert(A != NULL);                                                  \
+    A = (dumpio_request*)libdumpi_scratch_alloc((COUNT)*sizeof(dumpio_request)); \
     for(i = 0; i < (COUNT); ++i) {                                      \
       DUMPIO_REQUEST_FROM_MPIO_REQUEST((A)[i], (B)[i]);                 \
     }                                                                   \
@@ -763,7 +830,7 @@ extern "C" {
   }                                                                     \
 } while(0)
 
-#define DUMPIO_FREE_REQUEST_FROM_MPIO_REQUEST(A) free(A)
+#define DUMPIO_FREE_REQUEST_FROM_MPIO_REQUEST(A) do {} while(0)
 
 #endif /* MPIO_REQUEST_USES_MPI_REQUEST */
 
@@ -777,10 +844,11 @@ extern "C" {
     if(((COUNT)<=0) || ((B) == NULL) ||                                 \
        ((B) == MPI_STATUS_IGNORE) || ((B) == MPI_STATUSES_IGNORE))      \
       A = DUMPI_STATUS_IGNORE;                                          \
+    else if(dumpi_global->lazy_statuses)                                \
+      A = libdumpi_capture_statuses((COUNT), (B));                      \
     else {                                                              \
       int i, scratch;                                                   \
-      A = (dumpi_status*)malloc((COUNT)*sizeof(dumpi_status));          \
-      assert(A != NULL);                                                \
+      A = (dumpi_status*)libdumpi_scratch_alloc((COUNT)*sizeof(dumpi_status)); \
       for(i = 0; i < (COUNT); ++i) {                                    \
         /* Figure out the status information. */                        \
         PMPI_Get_count((B)+i, MPI_CHAR, &A[i].bytes);                   \
@@ -795,7 +863,7 @@ extern "C" {
 } while(0)
 
   /** Free a dynamically allocated dumpi_status */
-#define DUMPI_FREE_STATUS_FROM_MPI_STATUS(A) free(A)
+#define DUMPI_FREE_STATUS_FROM_MPI_STATUS(A) do {} while(0)
 
   /** Convert MPI thread level request to dumpi thread level value */
   static inline dumpi_threadlevel dumpi_threadlevel_from_int(int mpilevel) {
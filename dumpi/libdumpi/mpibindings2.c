@@ -17,6 +17,7 @@ s *  This file is part of DUMPI:
 #include <dumpi/dumpiconfig.h>
 #include <dumpi/libdumpi/mpibindings.h>
 #include <dumpi/libdumpi/callprofile.h>
+#include <dumpi/libdumpi/annotation.h>
 #include <dumpi/libdumpi/fused-bindings.h>
 #include <dumpi/libdumpi/libdumpi.h>
 #include <stdarg.h>
@@ -40,62 +41,17 @@ s *  This file is part of DUMPI:
 #define MIN(A, B) ((A) < (B) ? (A) : (B))
 #define MAX(A, B) ((A) > (B) ? (A) : (B))
 
-#define MIN_USER_KEY 1ULL
-#define MAX_USER_KEY 4096ULL
-
-static uint64_t next_comment_index_ = MAX_USER_KEY;
-static size_t comment_buffer_size_ = 0;
-static size_t comment_buffer_offset_ = 0;
-static char *comment_buffer_ = NULL;
-#define comment_header_ "ANNOTATION: "
-
-/*
- * Utility function to print to the comment buffer.
- */
-static int print_to_comment_buffer(va_list arglist) {
-  size_t strsize;
-  const char *fmt;
-  va_list argcpy;
-  fmt = va_arg(arglist, const char*);
-  va_copy(argcpy, arglist);
-  strsize = vsnprintf(comment_buffer_+comment_buffer_offset_,
-                      comment_buffer_size_-comment_buffer_offset_,
-                      fmt, arglist);
-  if(strsize >= (comment_buffer_size_-comment_buffer_offset_)) {
-    /* Ran out of buffer space -- create some more */
-    strsize += comment_buffer_offset_;
-    assert((comment_buffer_ = realloc(comment_buffer_, strsize + 1)) != NULL);
-    comment_buffer_size_ = strsize + 1;
-    snprintf(comment_buffer_, comment_buffer_offset_+1, comment_header_);
-    vsnprintf(comment_buffer_+comment_buffer_offset_,
-              comment_buffer_size_+comment_buffer_offset_, fmt, argcpy);
-  }  
-  va_end(argcpy);
-  return 1;
-}
-
 /*
  * subvert the function entry/function exit mechanism to allow custom
- * annotation.
+ * annotation (see annotation.h).
  *  MPI_Pcontrol(2, const char *fmt, ...) creates a string annotation
  *  MPI_Pcontrol(3, uint64_t key, const char *fmt, ...) is a keyed annotation
+ *  MPI_Pcontrol(4) is a flush point (see flushpolicy.h)
  */
 int MPI_Pcontrol(const int level, ...) {
   va_list arglist;
-  dumpi_func_call stat;
-  uint16_t thread;
-  dumpi_time cpu_start, wall_start, cpu_stop, wall_stop;
   if(dumpi_global == NULL)
     libdumpi_init();
-  DUMPI_START_TIME(cpu_start, wall_start);
-  DUMPI_STOP_TIME(cpu_start, wall_start);
-  thread = libdumpi_get_thread_id();
-  if(! comment_buffer_) {
-    comment_buffer_offset_ = strlen(comment_header_);
-    comment_buffer_size_ = comment_buffer_offset_ + 10;;
-    assert((comment_buffer_ = (char*)malloc(comment_buffer_size_)) != NULL);
-    snprintf(comment_buffer_, comment_buffer_offset_+1, comment_header_);
-  }
   switch(level) {
   case 0:
     libdumpi_disable_profiling();
@@ -104,53 +60,15 @@ int MPI_Pcontrol(const int level, ...) {
     libdumpi_enable_profiling();
     break;
   case 2:
-    /* Automated keys count starting at 4096.
-     * On 64-bit Linux systems, we get quite a few entries before 
-     * bumping into the text segment of the program. */
-    if(dumpi_global->output->function[DUMPI_ALL_FUNCTIONS]) {
-      va_start(arglist, level);
-      print_to_comment_buffer(arglist);
-      stat.fn = next_comment_index_++;
-      libdumpi_insert_data(stat.fn, comment_buffer_);
-      DUMPI_START_TIME(cpu_stop, wall_stop);
-      DUMPI_STOP_TIME(cpu_stop, wall_stop);
-      libdumpi_lock_io();
-      dumpi_write_func_enter(&stat, thread, &cpu_start, &wall_start,
-                             dumpi_global->perf, dumpi_global->output,
-                             dumpi_global->profile);
-      dumpi_write_func_exit(&stat, thread, &cpu_stop, &wall_stop,
-                            dumpi_global->perf, dumpi_global->output,
-                            dumpi_global->profile);
-      libdumpi_unlock_io();
-      va_end(arglist);
-    }
-    break;
   case 3:
-    /* We permit user-keys in the range 1..4095.
-     * (reserve '0' for NULL pointer). 
-     * This should irmly put us in the first (blocked) page on most systems */
-    if(dumpi_global->output->function[DUMPI_ALL_FUNCTIONS]) {
-      va_start(arglist, level);
-      stat.fn = va_arg(arglist, uint64_t);
-      if((stat.fn < MIN_USER_KEY) || (stat.fn >= MAX_USER_KEY)) {
-        fprintf(stderr, "WARNING:  DUMPI:  MPI_Pcontrol(3, ...):  "
-                "User key %llu is outside the recommended range "
-                "%llu through %llu\n", stat.fn, MIN_USER_KEY, MAX_USER_KEY-1);
-      }
-      print_to_comment_buffer(arglist);
-      libdumpi_insert_data(stat.fn, comment_buffer_);    
-      DUMPI_START_TIME(cpu_stop, wall_stop);
-      DUMPI_STOP_TIME(cpu_stop, wall_stop);
-      libdumpi_lock_io();
-      dumpi_write_func_enter(&stat, thread, &cpu_start, &wall_start,
-                             dumpi_global->perf, dumpi_global->output,
-                             dumpi_global->profile);
-      dumpi_write_func_exit(&stat, thread, &cpu_stop, &wall_stop,
-                            dumpi_global->perf, dumpi_global->output,
-                            dumpi_global->profile);
-      libdumpi_unlock_io();
-      va_end(arglist);
-    }
+    va_start(arglist, level);
+    libdumpi_annotate(level, arglist);
+    va_end(arglist);
+    break;
+  case 4:
+    if(dumpi_global->flush_points)
+      libdumpi_flush_point();
+    break;
   }
   return MPI_SUCCESS;
 }
@@ -164,6 +82,8 @@ int MPI_Send(DUMPI_CONST void *buf, int count, MPI_Datatype datatype, int dest,
   memset(&stat, 0, sizeof(dumpi_send));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Send);
+  DUMPI_MATRIX_SEND(dest, count, datatype, comm);
+  DUMPI_AGGREGATE_BYTES(libdumpi_bytes(count, datatype), 0);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Send);
     DUMPI_INT_FROM_INT(stat.count, count);
@@ -197,6 +117,7 @@ int MPI_Recv(void *buf, int count, MPI_Datatype datatype, int source, int tag, M
   memset(&stat, 0, sizeof(dumpi_recv));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Recv);
+  DUMPI_AGGREGATE_BYTES(0, libdumpi_bytes(count, datatype));
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Recv);
     DUMPI_INT_FROM_INT(stat.count, count);
@@ -264,6 +185,8 @@ int MPI_Bsend(DUMPI_CONST void *buf, int count, MPI_Datatype datatype, int dest,
   memset(&stat, 0, sizeof(dumpi_bsend));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Bsend);
+  DUMPI_MATRIX_SEND(dest, count, datatype, comm);
+  DUMPI_AGGREGATE_BYTES(libdumpi_bytes(count, datatype), 0);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Bsend);
     DUMPI_INT_FROM_INT(stat.count, count);
@@ -297,6 +220,8 @@ int MPI_Ssend(DUMPI_CONST void *buf, int count, MPI_Datatype datatype, int dest,
   memset(&stat, 0, sizeof(dumpi_ssend));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Ssend);
+  DUMPI_MATRIX_SEND(dest, count, datatype, comm);
+  DUMPI_AGGREGATE_BYTES(libdumpi_bytes(count, datatype), 0);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Ssend);
     DUMPI_INT_FROM_INT(stat.count, count);
@@ -330,6 +255,8 @@ int MPI_Rsend(DUMPI_CONST void *buf, int count, MPI_Datatype datatype, int dest,
   memset(&stat, 0, sizeof(dumpi_rsend));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Rsend);
+  DUMPI_MATRIX_SEND(dest, count, datatype, comm);
+  DUMPI_AGGREGATE_BYTES(libdumpi_bytes(count, datatype), 0);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Rsend);
     DUMPI_INT_FROM_INT(stat.count, count);
@@ -421,6 +348,8 @@ int MPI_Isend(DUMPI_CONST void *buf, int count, MPI_Datatype datatype, int dest,
   memset(&stat, 0, sizeof(dumpi_isend));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Isend);
+  DUMPI_MATRIX_SEND(dest, count, datatype, comm);
+  DUMPI_AGGREGATE_BYTES(libdumpi_bytes(count, datatype), 0);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Isend);
     DUMPI_INT_FROM_INT(stat.count, count);
@@ -455,6 +384,8 @@ int MPI_Ibsend(DUMPI_CONST void *buf, int count, MPI_Datatype datatype, int dest
   memset(&stat, 0, sizeof(dumpi_ibsend));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Ibsend);
+  DUMPI_MATRIX_SEND(dest, count, datatype, comm);
+  DUMPI_AGGREGATE_BYTES(libdumpi_bytes(count, datatype), 0);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Ibsend);
     DUMPI_INT_FROM_INT(stat.count, count);
@@ -489,6 +420,8 @@ int MPI_Issend(DUMPI_CONST void *buf, int count, MPI_Datatype datatype, int dest
   memset(&stat, 0, sizeof(dumpi_issend));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Issend);
+  DUMPI_MATRIX_SEND(dest, count, datatype, comm);
+  DUMPI_AGGREGATE_BYTES(libdumpi_bytes(count, datatype), 0);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Issend);
     DUMPI_INT_FROM_INT(stat.count, count);
@@ -523,6 +456,8 @@ int MPI_Irsend(DUMPI_CONST void *buf, int count, MPI_Datatype datatype, int dest
   memset(&stat, 0, sizeof(dumpi_irsend));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Irsend);
+  DUMPI_MATRIX_SEND(dest, count, datatype, comm);
+  DUMPI_AGGREGATE_BYTES(libdumpi_bytes(count, datatype), 0);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Irsend);
     DUMPI_INT_FROM_INT(stat.count, count);
@@ -557,6 +492,7 @@ int MPI_Irecv(void *buf, int count, MPI_Datatype datatype, int source, int tag,
   memset(&stat, 0, sizeof(dumpi_irecv));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Irecv);
+  DUMPI_AGGREGATE_BYTES(0, libdumpi_bytes(count, datatype));
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Irecv);
     DUMPI_INT_FROM_INT(stat.count, count);
@@ -634,9 +570,11 @@ int MPI_Test(MPI_Request *request, int *flag, MPI_Status *status) {
     DUMPI_STOP_TIME(cpu, wall);
     DUMPI_INT_FROM_INT(stat.flag, *flag);
     if(*flag != 0)    DUMPI_STATUS_FROM_MPI_STATUS_PTR(stat.status, status);
-    libdumpi_lock_io();
-    dumpi_write_test(&stat, thread, &cpu, &wall, dumpi_global->perf, dumpi_global->output, dumpi_global->profile);
-    libdumpi_unlock_io();
+    if(! DUMPI_POLL_COALESCED(DUMPI_Test, stat.flag, 1, &stat.request)) {
+      libdumpi_lock_io();
+      dumpi_write_test(&stat, thread, &cpu, &wall, dumpi_global->perf, dumpi_global->output, dumpi_global->profile);
+      libdumpi_unlock_io();
+    }
     if(status != NULL) DUMPI_FREE_STATUS_FROM_MPI_STATUS(stat.status);
     DUMPI_STOP_OVERHEAD(DUMPI_Test);
   }
@@ -731,9 +669,11 @@ int MPI_Testany(int count, MPI_Request *requests, int *index, int *flag, MPI_Sta
     DUMPI_INT_FROM_INT(stat.index, *index);
     DUMPI_INT_FROM_INT(stat.flag, *flag);
     if(*flag != 0)    DUMPI_STATUS_FROM_MPI_STATUS_PTR(stat.status, status);
-    libdumpi_lock_io();
-    dumpi_write_testany(&stat, thread, &cpu, &wall, dumpi_global->perf, dumpi_global->output, dumpi_global->profile);
-    libdumpi_unlock_io();
+    if(! DUMPI_POLL_COALESCED(DUMPI_Testany, stat.flag, stat.count, stat.requests)) {
+      libdumpi_lock_io();
+      dumpi_write_testany(&stat, thread, &cpu, &wall, dumpi_global->perf, dumpi_global->output, dumpi_global->profile);
+      libdumpi_unlock_io();
+    }
     if(requests != NULL) DUMPI_FREE_REQUEST_FROM_MPI_REQUEST(stat.requests);
     if(status != NULL) DUMPI_FREE_STATUS_FROM_MPI_STATUS(stat.status);
     DUMPI_STOP_OVERHEAD(DUMPI_Testany);
@@ -888,6 +828,7 @@ int MPI_Iprobe(int source, int tag, MPI_Comm comm, int *flag, MPI_Status *status
   dumpi_time cpu, wall;
   int retval;
   dumpi_iprobe stat;
+  int pollargs[3];
   memset(&stat, 0, sizeof(dumpi_iprobe));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Iprobe);
@@ -905,9 +846,12 @@ int MPI_Iprobe(int source, int tag, MPI_Comm comm, int *flag, MPI_Status *status
     DUMPI_STOP_TIME(cpu, wall);
     DUMPI_INT_FROM_INT(stat.flag, *flag);
     if(*flag != 0)    DUMPI_STATUS_FROM_MPI_STATUS_PTR(stat.status, status);
-    libdumpi_lock_io();
-    dumpi_write_iprobe(&stat, thread, &cpu, &wall, dumpi_global->perf, dumpi_global->output, dumpi_global->profile);
-    libdumpi_unlock_io();
+    pollargs[0] = stat.source; pollargs[1] = stat.tag; pollargs[2] = stat.comm;
+    if(! DUMPI_POLL_COALESCED(DUMPI_Iprobe, stat.flag, 3, pollargs)) {
+      libdumpi_lock_io();
+      dumpi_write_iprobe(&stat, thread, &cpu, &wall, dumpi_global->perf, dumpi_global->output, dumpi_global->profile);
+      libdumpi_unlock_io();
+    }
     if(status != NULL) DUMPI_FREE_STATUS_FROM_MPI_STATUS(stat.status);
     DUMPI_STOP_OVERHEAD(DUMPI_Iprobe);
   }
@@ -1018,6 +962,7 @@ int MPI_Send_init(DUMPI_CONST void *buf, int count, MPI_Datatype datatype, int d
   memset(&stat, 0, sizeof(dumpi_send_init));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Send_init);
+  DUMPI_AGGREGATE_BYTES(libdumpi_bytes(count, datatype), 0);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Send_init);
     DUMPI_INT_FROM_INT(stat.count, count);
@@ -1052,6 +997,7 @@ int MPI_Bsend_init(DUMPI_CONST void *buf, int count, MPI_Datatype datatype, int
   memset(&stat, 0, sizeof(dumpi_bsend_init));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Bsend_init);
+  DUMPI_AGGREGATE_BYTES(libdumpi_bytes(count, datatype), 0);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Bsend_init);
     DUMPI_INT_FROM_INT(stat.count, count);
@@ -1086,6 +1032,7 @@ int MPI_Ssend_init(DUMPI_CONST void *buf, int count, MPI_Datatype datatype, int
   memset(&stat, 0, sizeof(dumpi_ssend_init));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Ssend_init);
+  DUMPI_AGGREGATE_BYTES(libdumpi_bytes(count, datatype), 0);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Ssend_init);
     DUMPI_INT_FROM_INT(stat.count, count);
@@ -1120,6 +1067,7 @@ int MPI_Rsend_init(DUMPI_CONST void *buf, int count, MPI_Datatype datatype, int
   memset(&stat, 0, sizeof(dumpi_rsend_init));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Rsend_init);
+  DUMPI_AGGREGATE_BYTES(libdumpi_bytes(count, datatype), 0);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Rsend_init);
     DUMPI_INT_FROM_INT(stat.count, count);
@@ -1154,6 +1102,7 @@ int MPI_Recv_init(void *buf, int count, MPI_Datatype datatype, int source, int t
   memset(&stat, 0, sizeof(dumpi_recv_init));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Recv_init);
+  DUMPI_AGGREGATE_BYTES(0, libdumpi_bytes(count, datatype));
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Recv_init);
     DUMPI_INT_FROM_INT(stat.count, count);
@@ -1248,6 +1197,8 @@ int MPI_Sendrecv(DUMPI_CONST void *sendbuf, int sendcount, MPI_Datatype sendtype
   memset(&stat, 0, sizeof(dumpi_sendrecv));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Sendrecv);
+  DUMPI_MATRIX_SEND(dest, sendcount, sendtype, comm);
+  DUMPI_AGGREGATE_BYTES(libdumpi_bytes(sendcount, sendtype), libdumpi_bytes(recvcount, recvtype));
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Sendrecv);
     DUMPI_INT_FROM_INT(stat.sendcount, sendcount);
@@ -1287,6 +1238,8 @@ int MPI_Sendrecv_replace(void *buf, int count, MPI_Datatype datatype, int dest,
   memset(&stat, 0, sizeof(dumpi_sendrecv_replace));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Sendrecv_replace);
+  DUMPI_MATRIX_SEND(dest, count, datatype, comm);
+  DUMPI_AGGREGATE_BYTES(libdumpi_bytes(count, datatype), libdumpi_bytes(count, datatype));
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Sendrecv_replace);
     DUMPI_INT_FROM_INT(stat.count, count);
@@ -1880,6 +1833,7 @@ int MPI_Barrier(MPI_Comm comm) {
     libdumpi_unlock_io();
     DUMPI_STOP_OVERHEAD(DUMPI_Barrier);
   }
+  DUMPI_FLUSH_POINT(comm);
   DUMPI_INSERT_POSTAMBLE;
   return retval;
 }
@@ -1894,6 +1848,8 @@ int MPI_Bcast(void *sendbuf, int count, MPI_Datatype datatype, int root, MPI_Com
   memset(&stat, 0, sizeof(dumpi_bcast));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Bcast);
+  DUMPI_AGGREGATE_ROOTED_BYTES(root, comm, libdumpi_bytes(count, datatype), 0,
+			       0, libdumpi_bytes(count, datatype));
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Bcast);
     DUMPI_INT_FROM_INT(stat.count, count);
@@ -1912,6 +1868,7 @@ int MPI_Bcast(void *sendbuf, int count, MPI_Datatype datatype, int root, MPI_Com
     libdumpi_unlock_io();
     DUMPI_STOP_OVERHEAD(DUMPI_Bcast);
   }
+  DUMPI_FLUSH_POINT(comm);
   DUMPI_INSERT_POSTAMBLE;
   return retval;
 }
@@ -1928,6 +1885,9 @@ int MPI_Gather(DUMPI_CONST void *inbuf, int sendcount, MPI_Datatype sendtype, vo
   int commrank;
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Gather);
+  DUMPI_AGGREGATE_ROOTED_BYTES(root, comm, libdumpi_bytes(sendcount, sendtype),
+			       libdumpi_bytes(recvcount, recvtype) * libdumpi_comm_peers(comm),
+			       libdumpi_bytes(sendcount, sendtype), 0);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Gather);
     PMPI_Comm_rank(comm, &commrank);
@@ -1950,6 +1910,7 @@ int MPI_Gather(DUMPI_CONST void *inbuf, int sendcount, MPI_Datatype sendtype, vo
     libdumpi_unlock_io();
     DUMPI_STOP_OVERHEAD(DUMPI_Gather);
   }
+  DUMPI_FLUSH_POINT(comm);
   DUMPI_INSERT_POSTAMBLE;
   return retval;
 }
@@ -1967,8 +1928,12 @@ int MPI_Gatherv(DUMPI_CONST void *sendbuf, int sendcount, MPI_Datatype sendtype,
   int commrank;
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Gatherv);
+  DUMPI_AGGREGATE_ROOTED_BYTES(root, comm, libdumpi_bytes(sendcount, sendtype),
+			       libdumpi_bytes_v(recvcounts, recvtype, comm),
+			       libdumpi_bytes(sendcount, sendtype), 0);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Gatherv);
+    stat.detail = DUMPI_ARG_DETAIL(DUMPI_Gatherv);
     PMPI_Comm_size(comm, &commsize); PMPI_Comm_rank(comm, &commrank);
     DUMPI_INT_FROM_INT(stat.commrank, commrank);
     DUMPI_INT_FROM_INT(stat.commsize, commsize);
@@ -1993,6 +1958,7 @@ int MPI_Gatherv(DUMPI_CONST void *sendbuf, int sendcount, MPI_Datatype sendtype,
     if(displs != NULL) DUMPI_FREE_INT_FROM_INT(stat.displs);
     DUMPI_STOP_OVERHEAD(DUMPI_Gatherv);
   }
+  DUMPI_FLUSH_POINT(comm);
   DUMPI_INSERT_POSTAMBLE;
   return retval;
 }
@@ -2009,6 +1975,9 @@ int MPI_Scatter(DUMPI_CONST void *sendbuf, int sendcount, MPI_Datatype sendtype,
   int commrank;
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Scatter);
+  DUMPI_AGGREGATE_ROOTED_BYTES(root, comm, libdumpi_bytes(sendcount, sendtype) * libdumpi_comm_peers(comm),
+			       libdumpi_bytes(recvcount, recvtype),
+			       0, libdumpi_bytes(recvcount, recvtype));
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Scatter);
     PMPI_Comm_rank(comm, &commrank);
@@ -2031,6 +2000,7 @@ int MPI_Scatter(DUMPI_CONST void *sendbuf, int sendcount, MPI_Datatype sendtype,
     libdumpi_unlock_io();
     DUMPI_STOP_OVERHEAD(DUMPI_Scatter);
   }
+  DUMPI_FLUSH_POINT(comm);
   DUMPI_INSERT_POSTAMBLE;
   return retval;
 }
@@ -2048,8 +2018,12 @@ int MPI_Scatterv(DUMPI_CONST void *sendbuf, DUMPI_CONST int *sendcounts, DUMPI_C
   int commrank;
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Scatterv);
+  DUMPI_AGGREGATE_ROOTED_BYTES(root, comm, libdumpi_bytes_v(sendcounts, sendtype, comm),
+			       libdumpi_bytes(recvcount, recvtype),
+			       0, libdumpi_bytes(recvcount, recvtype));
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Scatterv);
+    stat.detail = DUMPI_ARG_DETAIL(DUMPI_Scatterv);
     PMPI_Comm_size(comm, &commsize); PMPI_Comm_rank(comm, &commrank);
     DUMPI_INT_FROM_INT(stat.commrank, commrank);
     DUMPI_INT_FROM_INT(stat.commsize, commsize);
@@ -2074,6 +2048,7 @@ int MPI_Scatterv(DUMPI_CONST void *sendbuf, DUMPI_CONST int *sendcounts, DUMPI_C
     if(displs != NULL) DUMPI_FREE_INT_FROM_INT(stat.displs);
     DUMPI_STOP_OVERHEAD(DUMPI_Scatterv);
   }
+  DUMPI_FLUSH_POINT(comm);
   DUMPI_INSERT_POSTAMBLE;
   return retval;
 }
@@ -2088,6 +2063,8 @@ int MPI_Allgather(DUMPI_CONST void *sendbuf, int sendcount, MPI_Datatype sendtyp
   memset(&stat, 0, sizeof(dumpi_allgather));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Allgather);
+  DUMPI_AGGREGATE_BYTES(libdumpi_bytes(sendcount, sendtype),
+			libdumpi_bytes(recvcount, recvtype) * libdumpi_comm_peers(comm));
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Allgather);
     DUMPI_INT_FROM_INT(stat.sendcount, sendcount);
@@ -2107,6 +2084,7 @@ int MPI_Allgather(DUMPI_CONST void *sendbuf, int sendcount, MPI_Datatype sendtyp
     libdumpi_unlock_io();
     DUMPI_STOP_OVERHEAD(DUMPI_Allgather);
   }
+  DUMPI_FLUSH_POINT(comm);
   DUMPI_INSERT_POSTAMBLE;
   return retval;
 }
@@ -2123,8 +2101,11 @@ int MPI_Allgatherv(DUMPI_CONST void *sendbuf, int sendcount, MPI_Datatype sendty
   int commsize;
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Allgatherv);
+  DUMPI_AGGREGATE_BYTES(libdumpi_bytes(sendcount, sendtype),
+			libdumpi_bytes_v(recvcounts, recvtype, comm));
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Allgatherv);
+    stat.detail = DUMPI_ARG_DETAIL(DUMPI_Allgatherv);
     PMPI_Comm_size(comm, &commsize);
     DUMPI_INT_FROM_INT(stat.commsize, commsize);
     DUMPI_INT_FROM_INT(stat.sendcount, sendcount);
@@ -2147,6 +2128,7 @@ int MPI_Allgatherv(DUMPI_CONST void *sendbuf, int sendcount, MPI_Datatype sendty
     if(displs != NULL) DUMPI_FREE_INT_FROM_INT(stat.displs);
     DUMPI_STOP_OVERHEAD(DUMPI_Allgatherv);
   }
+  DUMPI_FLUSH_POINT(comm);
   DUMPI_INSERT_POSTAMBLE;
   return retval;
 }
@@ -2161,6 +2143,8 @@ int MPI_Alltoall(DUMPI_CONST void *sendbuf, int sendcount, MPI_Datatype sendtype
   memset(&stat, 0, sizeof(dumpi_alltoall));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Alltoall);
+  DUMPI_AGGREGATE_BYTES(libdumpi_bytes(sendcount, sendtype) * libdumpi_comm_peers(comm),
+			libdumpi_bytes(recvcount, recvtype) * libdumpi_comm_peers(comm));
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Alltoall);
     DUMPI_INT_FROM_INT(stat.sendcount, sendcount);
@@ -2180,6 +2164,7 @@ int MPI_Alltoall(DUMPI_CONST void *sendbuf, int sendcount, MPI_Datatype sendtype
     libdumpi_unlock_io();
     DUMPI_STOP_OVERHEAD(DUMPI_Alltoall);
   }
+  DUMPI_FLUSH_POINT(comm);
   DUMPI_INSERT_POSTAMBLE;
   return retval;
 }
@@ -2196,8 +2181,11 @@ int MPI_Alltoallv(DUMPI_CONST void *sendbuf, DUMPI_CONST int *sendcounts, DUMPI_
   int commsize;
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Alltoallv);
+  DUMPI_AGGREGATE_BYTES(libdumpi_bytes_v(sendcounts, sendtype, comm),
+			libdumpi_bytes_v(recvcounts, recvtype, comm));
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Alltoallv);
+    stat.detail = DUMPI_ARG_DETAIL(DUMPI_Alltoallv);
     PMPI_Comm_size(comm, &commsize);
     DUMPI_INT_FROM_INT(stat.commsize, commsize);
     DUMPI_INT_FROM_INT_ARRAY_1(commsize, stat.sendcounts, sendcounts);
@@ -2223,6 +2211,7 @@ int MPI_Alltoallv(DUMPI_CONST void *sendbuf, DUMPI_CONST int *sendcounts, DUMPI_
     if(recvdispls != NULL) DUMPI_FREE_INT_FROM_INT(stat.recvdispls);
     DUMPI_STOP_OVERHEAD(DUMPI_Alltoallv);
   }
+  DUMPI_FLUSH_POINT(comm);
   DUMPI_INSERT_POSTAMBLE;
   return retval;
 }
@@ -2237,6 +2226,8 @@ int MPI_Reduce(DUMPI_CONST void *sendbuf, void *recvbuf, int count, MPI_Datatype
   memset(&stat, 0, sizeof(dumpi_reduce));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Reduce);
+  DUMPI_AGGREGATE_ROOTED_BYTES(root, comm, libdumpi_bytes(count, datatype), libdumpi_bytes(count, datatype),
+			       libdumpi_bytes(count, datatype), 0);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Reduce);
     DUMPI_INT_FROM_INT(stat.count, count);
@@ -2256,6 +2247,7 @@ int MPI_Reduce(DUMPI_CONST void *sendbuf, void *recvbuf, int count, MPI_Datatype
     libdumpi_unlock_io();
     DUMPI_STOP_OVERHEAD(DUMPI_Reduce);
   }
+  DUMPI_FLUSH_POINT(comm);
   DUMPI_INSERT_POSTAMBLE;
   return retval;
 }
@@ -2329,6 +2321,7 @@ int MPI_Allreduce(DUMPI_CONST void *sendbuf, void *recvbuf, int count, MPI_Datat
   memset(&stat, 0, sizeof(dumpi_allreduce));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Allreduce);
+  DUMPI_AGGREGATE_BYTES(libdumpi_bytes(count, datatype), libdumpi_bytes(count, datatype));
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Allreduce);
     DUMPI_INT_FROM_INT(stat.count, count);
@@ -2347,6 +2340,7 @@ int MPI_Allreduce(DUMPI_CONST void *sendbuf, void *recvbuf, int count, MPI_Datat
     libdumpi_unlock_io();
     DUMPI_STOP_OVERHEAD(DUMPI_Allreduce);
   }
+  DUMPI_FLUSH_POINT(comm);
   DUMPI_INSERT_POSTAMBLE;
   return retval;
 }
@@ -2363,8 +2357,11 @@ int MPI_Reduce_scatter(DUMPI_CONST void *sendbuf, void *recvbuf, DUMPI_CONST int
   int commsize;
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Reduce_scatter);
+  DUMPI_AGGREGATE_BYTES(libdumpi_bytes_v(recvcounts, datatype, comm),
+			libdumpi_bytes(recvcounts[libdumpi_comm_rank(comm)], datatype));
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Reduce_scatter);
+    stat.detail = DUMPI_ARG_DETAIL(DUMPI_Reduce_scatter);
     PMPI_Comm_size(comm, &commsize);
     DUMPI_INT_FROM_INT(stat.commsize, commsize);
     DUMPI_INT_FROM_INT_ARRAY_1(commsize, stat.recvcounts, recvcounts);
@@ -2384,6 +2381,7 @@ int MPI_Reduce_scatter(DUMPI_CONST void *sendbuf, void *recvbuf, DUMPI_CONST int
     if(recvcounts != NULL) DUMPI_FREE_INT_FROM_INT(stat.recvcounts);
     DUMPI_STOP_OVERHEAD(DUMPI_Reduce_scatter);
   }
+  DUMPI_FLUSH_POINT(comm);
   DUMPI_INSERT_POSTAMBLE;
   return retval;
 }
@@ -2398,6 +2396,7 @@ int MPI_Scan(DUMPI_CONST void *sendbuf, void *recvbuf, int count, MPI_Datatype d
   memset(&stat, 0, sizeof(dumpi_scan));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Scan);
+  DUMPI_AGGREGATE_BYTES(libdumpi_bytes(count, datatype), libdumpi_bytes(count, datatype));
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Scan);
     DUMPI_INT_FROM_INT(stat.count, count);
@@ -2416,6 +2415,7 @@ int MPI_Scan(DUMPI_CONST void *sendbuf, void *recvbuf, int count, MPI_Datatype d
     libdumpi_unlock_io();
     DUMPI_STOP_OVERHEAD(DUMPI_Scan);
   }
+  DUMPI_FLUSH_POINT(comm);
   DUMPI_INSERT_POSTAMBLE;
   return retval;
 }
@@ -4257,6 +4257,7 @@ int MPI_Init(int *argc, char ***argv) {
   /* PMPI_Init is tagged as an INITIAL call */
   if(retval == MPI_SUCCESS) {
     libdumpi_open_files();
+    libdumpi_clocksync_start();
     libdumpi_init_maps();
     register_builtin_datatypes();
     DUMPI_START_TIME(cpu, wall); /* We cheat on timings for INIT. */
@@ -4291,7 +4292,12 @@ int MPI_Finalize(void ) {
     DUMPI_START_TIME(cpu, wall);
     DUMPI_STOP_OVERHEAD(DUMPI_Finalize);
   }
-  
+  /* Deferred statuses can only be decoded while MPI is still up */
+  libdumpi_resolve_statuses();
+  /* So is the gather of the communication matrix */
+  if(dumpi_global->comm_matrix)
+    libdumpi_matrix_write();
+  libdumpi_clocksync_finish();
   retval = PMPI_Finalize();
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Finalize);
@@ -4790,6 +4796,7 @@ int MPI_Accumulate(DUMPI_CONST void *buf, int origincount, MPI_Datatype originty
   memset(&stat, 0, sizeof(dumpi_accumulate));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Accumulate);
+  DUMPI_AGGREGATE_BYTES(libdumpi_bytes(origincount, origintype), 0);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Accumulate);
     DUMPI_INT_FROM_INT(stat.origincount, origincount);
@@ -4826,6 +4833,7 @@ int MPI_Get(void *buf, int origincount, MPI_Datatype origintype, int targetrank,
   memset(&stat, 0, sizeof(dumpi_get));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Get);
+  DUMPI_AGGREGATE_BYTES(0, libdumpi_bytes(origincount, origintype));
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Get);
     DUMPI_INT_FROM_INT(stat.origincount, origincount);
@@ -4861,6 +4869,7 @@ int MPI_Put(DUMPI_CONST void *buf, int origincount, MPI_Datatype origintype, int
   memset(&stat, 0, sizeof(dumpi_put));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Put);
+  DUMPI_AGGREGATE_BYTES(libdumpi_bytes(origincount, origintype), 0);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Put);
     DUMPI_INT_FROM_INT(stat.origincount, origincount);
@@ -5232,8 +5241,11 @@ int MPI_Alltoallw(DUMPI_CONST void *sendbuf, DUMPI_CONST int *sendcounts, DUMPI_
   int commsize;
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Alltoallw);
+  DUMPI_AGGREGATE_BYTES(libdumpi_bytes_w(sendcounts, sendtypes, comm),
+			libdumpi_bytes_w(recvcounts, recvtypes, comm));
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Alltoallw);
+    stat.detail = DUMPI_ARG_DETAIL(DUMPI_Alltoallw);
     PMPI_Comm_size(comm, &commsize);
     DUMPI_INT_FROM_INT(stat.commsize, commsize);
     DUMPI_INT_FROM_INT_ARRAY_1(commsize, stat.sendcounts, sendcounts);
@@ -5261,6 +5273,7 @@ int MPI_Alltoallw(DUMPI_CONST void *sendbuf, DUMPI_CONST int *sendcounts, DUMPI_
     if(recvtypes != NULL) DUMPI_FREE_DATATYPE_FROM_MPI_DATATYPE(stat.recvtypes);
     DUMPI_STOP_OVERHEAD(DUMPI_Alltoallw);
   }
+  DUMPI_FLUSH_POINT(comm);
   DUMPI_INSERT_POSTAMBLE;
   return retval;
 }
@@ -5275,6 +5288,7 @@ int MPI_Exscan(DUMPI_CONST void *sendbuf, void *recvbuf, int count, MPI_Datatype
   memset(&stat, 0, sizeof(dumpi_exscan));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Exscan);
+  DUMPI_AGGREGATE_BYTES(libdumpi_bytes(count, datatype), libdumpi_bytes(count, datatype));
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Exscan);
     DUMPI_INT_FROM_INT(stat.count, count);
@@ -5293,6 +5307,7 @@ int MPI_Exscan(DUMPI_CONST void *sendbuf, void *recvbuf, int count, MPI_Datatype
     libdumpi_unlock_io();
     DUMPI_STOP_OVERHEAD(DUMPI_Exscan);
   }
+  DUMPI_FLUSH_POINT(comm);
   DUMPI_INSERT_POSTAMBLE;
   return retval;
 }
@@ -5747,6 +5762,7 @@ int MPI_Init_thread(int *argc, char ***argv, int required, int *provided) {
   if(retval == MPI_SUCCESS) {
     /* PMPI_Init_thread is tagged as an INITIAL call */
     libdumpi_open_files();
+    libdumpi_clocksync_start();
     libdumpi_init_maps();
     register_builtin_datatypes();
     DUMPI_START_TIME(cpu, wall); /* We cheat on timings for INIT. */
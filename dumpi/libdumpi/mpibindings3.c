@@ -17,6 +17,7 @@ s *  This file is part of DUMPI:
 #include <dumpi/dumpiconfig.h>
 #include <dumpi/libdumpi/mpibindings.h>
 #include <dumpi/libdumpi/callprofile.h>
+#include <dumpi/libdumpi/annotation.h>
 #include <dumpi/libdumpi/fused-bindings.h>
 #include <dumpi/libdumpi/libdumpi.h>
 #include <stdarg.h>
@@ -40,62 +41,17 @@ s *  This file is part of DUMPI:
 #define MIN(A, B) ((A) < (B) ? (A) : (B))
 #define MAX(A, B) ((A) > (B) ? (A) : (B))
 
-#define MIN_USER_KEY 1ULL
-#define MAX_USER_KEY 4096ULL
-
-static uint64_t next_comment_index_ = MAX_USER_KEY;
-static size_t comment_buffer_size_ = 0;
-static size_t comment_buffer_offset_ = 0;
-static char *comment_buffer_ = NULL;
-#define comment_header_ "ANNOTATION: "
-
-/*
- * Utility function to print to the comment buffer.
- */
-static int print_to_comment_buffer(va_list arglist) {
-  size_t strsize;
-  const char *fmt;
-  va_list argcpy;
-  fmt = va_arg(arglist, const char*);
-  va_copy(argcpy, arglist);
-  strsize = vsnprintf(comment_buffer_+comment_buffer_offset_,
-                      comment_buffer_size_-comment_buffer_offset_,
-                      fmt, arglist);
-  if(strsize >= (comment_buffer_size_-comment_buffer_offset_)) {
-    /* Ran out of buffer space -- create some more */
-    strsize += comment_buffer_offset_;
-    assert((comment_buffer_ = realloc(comment_buffer_, strsize + 1)) != NULL);
-    comment_buffer_size_ = strsize + 1;
-    snprintf(comment_buffer_, comment_buffer_offset_+1, comment_header_);
-    vsnprintf(comment_buffer_+comment_buffer_offset_,
-              comment_buffer_size_+comment_buffer_offset_, fmt, argcpy);
-  }  
-  va_end(argcpy);
-  return 1;
-}
-
 /*
  * subvert the function entry/function exit mechanism to allow custom
- * annotation.
+ * annotation (see annotation.h).
  *  MPI_Pcontrol(2, const char *fmt, ...) creates a string annotation
  *  MPI_Pcontrol(3, uint64_t key, const char *fmt, ...) is a keyed annotation
+ *  MPI_Pcontrol(4) is a flush point (see flushpolicy.h)
  */
 int MPI_Pcontrol(const int level, ...) {
   va_list arglist;
-  dumpi_func_call stat;
-  uint16_t thread;
-  dumpi_time cpu_start, wall_start, cpu_stop, wall_stop;
   if(dumpi_global == NULL)
     libdumpi_init();
-  DUMPI_START_TIME(cpu_start, wall_start);
-  DUMPI_STOP_TIME(cpu_start, wall_start);
-  thread = libdumpi_get_thread_id();
-  if(! comment_buffer_) {
-    comment_buffer_offset_ = strlen(comment_header_);
-    comment_buffer_size_ = comment_buffer_offset_ + 10;;
-    assert((comment_buffer_ = (char*)malloc(comment_buffer_size_)) != NULL);
-    snprintf(comment_buffer_, comment_buffer_offset_+1, comment_header_);
-  }
   switch(level) {
   case 0:
     libdumpi_disable_profiling();
@@ -104,53 +60,15 @@ int MPI_Pcontrol(const int level, ...) {
     libdumpi_enable_profiling();
     break;
   case 2:
-    /* Automated keys count starting at 4096.
-     * On 64-bit Linux systems, we get quite a few entries before 
-     * bumping into the text segment of the program. */
-    if(dumpi_global->output->function[DUMPI_ALL_FUNCTIONS]) {
-      va_start(arglist, level);
-      print_to_comment_buffer(arglist);
-      stat.fn = next_comment_index_++;
-      libdumpi_insert_data(stat.fn, comment_buffer_);
-      DUMPI_START_TIME(cpu_stop, wall_stop);
-      DUMPI_STOP_TIME(cpu_stop, wall_stop);
-      libdumpi_lock_io();
-      dumpi_write_func_enter(&stat, thread, &cpu_start, &wall_start,
-                             dumpi_global->perf, dumpi_global->output,
-                             dumpi_global->profile);
-      dumpi_write_func_exit(&stat, thread, &cpu_stop, &wall_stop,
-                            dumpi_global->perf, dumpi_global->output,
-                            dumpi_global->profile);
-      libdumpi_unlock_io();
-      va_end(arglist);
-    }
-    break;
   case 3:
-    /* We permit user-keys in the range 1..4095.
-     * (reserve '0' for NULL pointer). 
-     * This should irmly put us in the first (blocked) page on most systems */
-    if(dumpi_global->output->function[DUMPI_ALL_FUNCTIONS]) {
-      va_start(arglist, level);
-      stat.fn = va_arg(arglist, uint64_t);
-      if((stat.fn < MIN_USER_KEY) || (stat.fn >= MAX_USER_KEY)) {
-        fprintf(stderr, "WARNING:  DUMPI:  MPI_Pcontrol(3, ...):  "
-                "User key %llu is outside the recommended range "
-                "%llu through %llu\n", stat.fn, MIN_USER_KEY, MAX_USER_KEY-1);
-      }
-      print_to_comment_buffer(arglist);
-      libdumpi_insert_data(stat.fn, comment_buffer_);    
-      DUMPI_START_TIME(cpu_stop, wall_stop);
-      DUMPI_STOP_TIME(cpu_stop, wall_stop);
-      libdumpi_lock_io();
-      dumpi_write_func_enter(&stat, thread, &cpu_start, &wall_start,
-                             dumpi_global->perf, dumpi_global->output,
-                             dumpi_global->profile);
-      dumpi_write_func_exit(&stat, thread, &cpu_stop, &wall_stop,
-                            dumpi_global->perf, dumpi_global->output,
-                            dumpi_global->profile);
-      libdumpi_unlock_io();
-      va_end(arglist);
-    }
+    va_start(arglist, level);
+    libdumpi_annotate(level, arglist);
+    va_end(arglist);
+    break;
+  case 4:
+    if(dumpi_global->flush_points)
+      libdumpi_flush_point();
+    break;
   }
   return MPI_SUCCESS;
 }
@@ -164,6 +82,8 @@ int MPI_Send(const void *buf, int count, MPI_Datatype datatype, int dest, int ta
   memset(&stat, 0, sizeof(dumpi_send));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Send);
+  DUMPI_MATRIX_SEND(dest, count, datatype, comm);
+  DUMPI_AGGREGATE_BYTES(libdumpi_bytes(count, datatype), 0);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Send);
     DUMPI_INT_FROM_INT(stat.count, count);
@@ -197,6 +117,7 @@ int MPI_Recv(void *buf, int count, MPI_Datatype datatype, int source, int tag, M
   memset(&stat, 0, sizeof(dumpi_recv));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Recv);
+  DUMPI_AGGREGATE_BYTES(0, libdumpi_bytes(count, datatype));
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Recv);
     DUMPI_INT_FROM_INT(stat.count, count);
@@ -264,6 +185,8 @@ int MPI_Bsend(const void *buf, int count, MPI_Datatype datatype, int dest, int t
   memset(&stat, 0, sizeof(dumpi_bsend));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Bsend);
+  DUMPI_MATRIX_SEND(dest, count, datatype, comm);
+  DUMPI_AGGREGATE_BYTES(libdumpi_bytes(count, datatype), 0);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Bsend);
     DUMPI_INT_FROM_INT(stat.count, count);
@@ -297,6 +220,8 @@ int MPI_Ssend(const void *buf, int count, MPI_Datatype datatype, int dest, int t
   memset(&stat, 0, sizeof(dumpi_ssend));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Ssend);
+  DUMPI_MATRIX_SEND(dest, count, datatype, comm);
+  DUMPI_AGGREGATE_BYTES(libdumpi_bytes(count, datatype), 0);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Ssend);
     DUMPI_INT_FROM_INT(stat.count, count);
@@ -330,6 +255,8 @@ int MPI_Rsend(const void *buf, int count, MPI_Datatype datatype, int dest, int t
   memset(&stat, 0, sizeof(dumpi_rsend));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Rsend);
+  DUMPI_MATRIX_SEND(dest, count, datatype, comm);
+  DUMPI_AGGREGATE_BYTES(libdumpi_bytes(count, datatype), 0);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Rsend);
     DUMPI_INT_FROM_INT(stat.count, count);
@@ -421,6 +348,8 @@ int MPI_Isend(const void *buf, int count, MPI_Datatype datatype, int dest, int t
   memset(&stat, 0, sizeof(dumpi_isend));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Isend);
+  DUMPI_MATRIX_SEND(dest, count, datatype, comm);
+  DUMPI_AGGREGATE_BYTES(libdumpi_bytes(count, datatype), 0);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Isend);
     DUMPI_INT_FROM_INT(stat.count, count);
@@ -455,6 +384,8 @@ int MPI_Ibsend(const void *buf, int count, MPI_Datatype datatype, int dest, int
   memset(&stat, 0, sizeof(dumpi_ibsend));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Ibsend);
+  DUMPI_MATRIX_SEND(dest, count, datatype, comm);
+  DUMPI_AGGREGATE_BYTES(libdumpi_bytes(count, datatype), 0);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Ibsend);
     DUMPI_INT_FROM_INT(stat.count, count);
@@ -489,6 +420,8 @@ int MPI_Issend(const void *buf, int count, MPI_Datatype datatype, int dest, int
   memset(&stat, 0, sizeof(dumpi_issend));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Issend);
+  DUMPI_MATRIX_SEND(dest, count, datatype, comm);
+  DUMPI_AGGREGATE_BYTES(libdumpi_bytes(count, datatype), 0);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Issend);
     DUMPI_INT_FROM_INT(stat.count, count);
@@ -523,6 +456,8 @@ int MPI_Irsend(const void *buf, int count, MPI_Datatype datatype, int dest, int
   memset(&stat, 0, sizeof(dumpi_irsend));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Irsend);
+  DUMPI_MATRIX_SEND(dest, count, datatype, comm);
+  DUMPI_AGGREGATE_BYTES(libdumpi_bytes(count, datatype), 0);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Irsend);
     DUMPI_INT_FROM_INT(stat.count, count);
@@ -557,6 +492,7 @@ int MPI_Irecv(void *buf, int count, MPI_Datatype datatype, int source, int tag,
   memset(&stat, 0, sizeof(dumpi_irecv));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Irecv);
+  DUMPI_AGGREGATE_BYTES(0, libdumpi_bytes(count, datatype));
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Irecv);
     DUMPI_INT_FROM_INT(stat.count, count);
@@ -634,9 +570,11 @@ int MPI_Test(MPI_Request *request, int *flag, MPI_Status *status) {
     DUMPI_STOP_TIME(cpu, wall);
     DUMPI_INT_FROM_INT(stat.flag, *flag);
     if(*flag != 0)    DUMPI_STATUS_FROM_MPI_STATUS_PTR(stat.status, status);
-    libdumpi_lock_io();
-    dumpi_write_test(&stat, thread, &cpu, &wall, dumpi_global->perf, dumpi_global->output, dumpi_global->profile);
-    libdumpi_unlock_io();
+    if(! DUMPI_POLL_COALESCED(DUMPI_Test, stat.flag, 1, &stat.request)) {
+      libdumpi_lock_io();
+      dumpi_write_test(&stat, thread, &cpu, &wall, dumpi_global->perf, dumpi_global->output, dumpi_global->profile);
+      libdumpi_unlock_io();
+    }
     if(status != NULL) DUMPI_FREE_STATUS_FROM_MPI_STATUS(stat.status);
     DUMPI_STOP_OVERHEAD(DUMPI_Test);
   }
@@ -731,9 +669,11 @@ int MPI_Testany(int count, MPI_Request *requests, int *index, int *flag, MPI_Sta
     DUMPI_INT_FROM_INT(stat.index, *index);
     DUMPI_INT_FROM_INT(stat.flag, *flag);
     if(*flag != 0)    DUMPI_STATUS_FROM_MPI_STATUS_PTR(stat.status, status);
-    libdumpi_lock_io();
-    dumpi_write_testany(&stat, thread, &cpu, &wall, dumpi_global->perf, dumpi_global->output, dumpi_global->profile);
-    libdumpi_unlock_io();
+    if(! DUMPI_POLL_COALESCED(DUMPI_Testany, stat.flag, stat.count, stat.requests)) {
+      libdumpi_lock_io();
+      dumpi_write_testany(&stat, thread, &cpu, &wall, dumpi_global->perf, dumpi_global->output, dumpi_global->profile);
+      libdumpi_unlock_io();
+    }
     if(requests != NULL) DUMPI_FREE_REQUEST_FROM_MPI_REQUEST(stat.requests);
     if(status != NULL) DUMPI_FREE_STATUS_FROM_MPI_STATUS(stat.status);
     DUMPI_STOP_OVERHEAD(DUMPI_Testany);
@@ -888,6 +828,7 @@ int MPI_Iprobe(int source, int tag, MPI_Comm comm, int *flag, MPI_Status *status
   dumpi_time cpu, wall;
   int retval;
   dumpi_iprobe stat;
+  int pollargs[3];
   memset(&stat, 0, sizeof(dumpi_iprobe));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Iprobe);
@@ -905,9 +846,12 @@ int MPI_Iprobe(int source, int tag, MPI_Comm comm, int *flag, MPI_Status *status
     DUMPI_STOP_TIME(cpu, wall);
     DUMPI_INT_FROM_INT(stat.flag, *flag);
     if(*flag != 0)    DUMPI_STATUS_FROM_MPI_STATUS_PTR(stat.status, status);
-    libdumpi_lock_io();
-    dumpi_write_iprobe(&stat, thread, &cpu, &wall, dumpi_global->perf, dumpi_global->output, dumpi_global->profile);
-    libdumpi_unlock_io();
+    pollargs[0] = stat.source; pollargs[1] = stat.tag; pollargs[2] = stat.comm;
+    if(! DUMPI_POLL_COALESCED(DUMPI_Iprobe, stat.flag, 3, pollargs)) {
+      libdumpi_lock_io();
+      dumpi_write_iprobe(&stat, thread, &cpu, &wall, dumpi_global->perf, dumpi_global->output, dumpi_global->profile);
+      libdumpi_unlock_io();
+    }
     if(status != NULL) DUMPI_FREE_STATUS_FROM_MPI_STATUS(stat.status);
     DUMPI_STOP_OVERHEAD(DUMPI_Iprobe);
   }
@@ -1018,6 +962,7 @@ int MPI_Send_init(const void *buf, int count, MPI_Datatype datatype, int dest, i
   memset(&stat, 0, sizeof(dumpi_send_init));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Send_init);
+  DUMPI_AGGREGATE_BYTES(libdumpi_bytes(count, datatype), 0);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Send_init);
     DUMPI_INT_FROM_INT(stat.count, count);
@@ -1052,6 +997,7 @@ int MPI_Bsend_init(const void *buf, int count, MPI_Datatype datatype, int dest,
   memset(&stat, 0, sizeof(dumpi_bsend_init));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Bsend_init);
+  DUMPI_AGGREGATE_BYTES(libdumpi_bytes(count, datatype), 0);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Bsend_init);
     DUMPI_INT_FROM_INT(stat.count, count);
@@ -1086,6 +1032,7 @@ int MPI_Ssend_init(const void *buf, int count, MPI_Datatype datatype, int dest,
   memset(&stat, 0, sizeof(dumpi_ssend_init));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Ssend_init);
+  DUMPI_AGGREGATE_BYTES(libdumpi_bytes(count, datatype), 0);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Ssend_init);
     DUMPI_INT_FROM_INT(stat.count, count);
@@ -1120,6 +1067,7 @@ int MPI_Rsend_init(const void *buf, int count, MPI_Datatype datatype, int dest,
   memset(&stat, 0, sizeof(dumpi_rsend_init));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Rsend_init);
+  DUMPI_AGGREGATE_BYTES(libdumpi_bytes(count, datatype), 0);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Rsend_init);
     DUMPI_INT_FROM_INT(stat.count, count);
@@ -1154,6 +1102,7 @@ int MPI_Recv_init(void *buf, int count, MPI_Datatype datatype, int source, int t
   memset(&stat, 0, sizeof(dumpi_recv_init));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Recv_init);
+  DUMPI_AGGREGATE_BYTES(0, libdumpi_bytes(count, datatype));
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Recv_init);
     DUMPI_INT_FROM_INT(stat.count, count);
@@ -1248,6 +1197,8 @@ int MPI_Sendrecv(const void *sendbuf, int sendcount, MPI_Datatype sendtype, int
   memset(&stat, 0, sizeof(dumpi_sendrecv));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Sendrecv);
+  DUMPI_MATRIX_SEND(dest, sendcount, sendtype, comm);
+  DUMPI_AGGREGATE_BYTES(libdumpi_bytes(sendcount, sendtype), libdumpi_bytes(recvcount, recvtype));
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Sendrecv);
     DUMPI_INT_FROM_INT(stat.sendcount, sendcount);
@@ -1287,6 +1238,8 @@ int MPI_Sendrecv_replace(void *buf, int count, MPI_Datatype datatype, int dest,
   memset(&stat, 0, sizeof(dumpi_sendrecv_replace));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Sendrecv_replace);
+  DUMPI_MATRIX_SEND(dest, count, datatype, comm);
+  DUMPI_AGGREGATE_BYTES(libdumpi_bytes(count, datatype), libdumpi_bytes(count, datatype));
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Sendrecv_replace);
     DUMPI_INT_FROM_INT(stat.count, count);
@@ -1880,6 +1833,7 @@ int MPI_Barrier(MPI_Comm comm) {
     libdumpi_unlock_io();
     DUMPI_STOP_OVERHEAD(DUMPI_Barrier);
   }
+  DUMPI_FLUSH_POINT(comm);
   DUMPI_INSERT_POSTAMBLE;
   return retval;
 }
@@ -1894,6 +1848,8 @@ int MPI_Bcast(void *sendbuf, int count, MPI_Datatype datatype, int root, MPI_Com
   memset(&stat, 0, sizeof(dumpi_bcast));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Bcast);
+  DUMPI_AGGREGATE_ROOTED_BYTES(root, comm, libdumpi_bytes(count, datatype), 0,
+			       0, libdumpi_bytes(count, datatype));
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Bcast);
     DUMPI_INT_FROM_INT(stat.count, count);
@@ -1912,6 +1868,7 @@ int MPI_Bcast(void *sendbuf, int count, MPI_Datatype datatype, int root, MPI_Com
     libdumpi_unlock_io();
     DUMPI_STOP_OVERHEAD(DUMPI_Bcast);
   }
+  DUMPI_FLUSH_POINT(comm);
   DUMPI_INSERT_POSTAMBLE;
   return retval;
 }
@@ -1928,6 +1885,9 @@ int MPI_Gather(const void *inbuf, int sendcount, MPI_Datatype sendtype, void *re
   int commrank;
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Gather);
+  DUMPI_AGGREGATE_ROOTED_BYTES(root, comm, libdumpi_bytes(sendcount, sendtype),
+			       libdumpi_bytes(recvcount, recvtype) * libdumpi_comm_peers(comm),
+			       libdumpi_bytes(sendcount, sendtype), 0);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Gather);
     PMPI_Comm_rank(comm, &commrank);
@@ -1950,6 +1910,7 @@ int MPI_Gather(const void *inbuf, int sendcount, MPI_Datatype sendtype, void *re
     libdumpi_unlock_io();
     DUMPI_STOP_OVERHEAD(DUMPI_Gather);
   }
+  DUMPI_FLUSH_POINT(comm);
   DUMPI_INSERT_POSTAMBLE;
   return retval;
 }
@@ -1967,8 +1928,12 @@ int MPI_Gatherv(const void *sendbuf, int sendcount, MPI_Datatype sendtype, void
   int commrank;
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Gatherv);
+  DUMPI_AGGREGATE_ROOTED_BYTES(root, comm, libdumpi_bytes(sendcount, sendtype),
+			       libdumpi_bytes_v(recvcounts, recvtype, comm),
+			       libdumpi_bytes(sendcount, sendtype), 0);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Gatherv);
+    stat.detail = DUMPI_ARG_DETAIL(DUMPI_Gatherv);
     PMPI_Comm_size(comm, &commsize); PMPI_Comm_rank(comm, &commrank);
     DUMPI_INT_FROM_INT(stat.commrank, commrank);
     DUMPI_INT_FROM_INT(stat.commsize, commsize);
@@ -1993,6 +1958,7 @@ int MPI_Gatherv(const void *sendbuf, int sendcount, MPI_Datatype sendtype, void
     if(displs != NULL) DUMPI_FREE_INT_FROM_INT(stat.displs);
     DUMPI_STOP_OVERHEAD(DUMPI_Gatherv);
   }
+  DUMPI_FLUSH_POINT(comm);
   DUMPI_INSERT_POSTAMBLE;
   return retval;
 }
@@ -2009,6 +1975,9 @@ int MPI_Scatter(const void *sendbuf, int sendcount, MPI_Datatype sendtype, void
   int commrank;
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Scatter);
+  DUMPI_AGGREGATE_ROOTED_BYTES(root, comm, libdumpi_bytes(sendcount, sendtype) * libdumpi_comm_peers(comm),
+			       libdumpi_bytes(recvcount, recvtype),
+			       0, libdumpi_bytes(recvcount, recvtype));
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Scatter);
     PMPI_Comm_rank(comm, &commrank);
@@ -2031,6 +2000,7 @@ int MPI_Scatter(const void *sendbuf, int sendcount, MPI_Datatype sendtype, void
     libdumpi_unlock_io();
     DUMPI_STOP_OVERHEAD(DUMPI_Scatter);
   }
+  DUMPI_FLUSH_POINT(comm);
   DUMPI_INSERT_POSTAMBLE;
   return retval;
 }
@@ -2048,8 +2018,12 @@ int MPI_Scatterv(const void *sendbuf, const int *sendcounts, const int *displs,
   int commrank;
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Scatterv);
+  DUMPI_AGGREGATE_ROOTED_BYTES(root, comm, libdumpi_bytes_v(sendcounts, sendtype, comm),
+			       libdumpi_bytes(recvcount, recvtype),
+			       0, libdumpi_bytes(recvcount, recvtype));
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Scatterv);
+    stat.detail = DUMPI_ARG_DETAIL(DUMPI_Scatterv);
     PMPI_Comm_size(comm, &commsize); PMPI_Comm_rank(comm, &commrank);
     DUMPI_INT_FROM_INT(stat.commrank, commrank);
     DUMPI_INT_FROM_INT(stat.commsize, commsize);
@@ -2074,6 +2048,7 @@ int MPI_Scatterv(const void *sendbuf, const int *sendcounts, const int *displs,
     if(displs != NULL) DUMPI_FREE_INT_FROM_INT(stat.displs);
     DUMPI_STOP_OVERHEAD(DUMPI_Scatterv);
   }
+  DUMPI_FLUSH_POINT(comm);
   DUMPI_INSERT_POSTAMBLE;
   return retval;
 }
@@ -2088,6 +2063,8 @@ int MPI_Allgather(const void *sendbuf, int sendcount, MPI_Datatype sendtype, voi
   memset(&stat, 0, sizeof(dumpi_allgather));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Allgather);
+  DUMPI_AGGREGATE_BYTES(libdumpi_bytes(sendcount, sendtype),
+			libdumpi_bytes(recvcount, recvtype) * libdumpi_comm_peers(comm));
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Allgather);
     DUMPI_INT_FROM_INT(stat.sendcount, sendcount);
@@ -2107,6 +2084,7 @@ int MPI_Allgather(const void *sendbuf, int sendcount, MPI_Datatype sendtype, voi
     libdumpi_unlock_io();
     DUMPI_STOP_OVERHEAD(DUMPI_Allgather);
   }
+  DUMPI_FLUSH_POINT(comm);
   DUMPI_INSERT_POSTAMBLE;
   return retval;
 }
@@ -2123,8 +2101,11 @@ int MPI_Allgatherv(const void *sendbuf, int sendcount, MPI_Datatype sendtype, vo
   int commsize;
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Allgatherv);
+  DUMPI_AGGREGATE_BYTES(libdumpi_bytes(sendcount, sendtype),
+			libdumpi_bytes_v(recvcounts, recvtype, comm));
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Allgatherv);
+    stat.detail = DUMPI_ARG_DETAIL(DUMPI_Allgatherv);
     PMPI_Comm_size(comm, &commsize);
     DUMPI_INT_FROM_INT(stat.commsize, commsize);
     DUMPI_INT_FROM_INT(stat.sendcount, sendcount);
@@ -2147,6 +2128,7 @@ int MPI_Allgatherv(const void *sendbuf, int sendcount, MPI_Datatype sendtype, vo
     if(displs != NULL) DUMPI_FREE_INT_FROM_INT(stat.displs);
     DUMPI_STOP_OVERHEAD(DUMPI_Allgatherv);
   }
+  DUMPI_FLUSH_POINT(comm);
   DUMPI_INSERT_POSTAMBLE;
   return retval;
 }
@@ -2161,6 +2143,8 @@ int MPI_Alltoall(const void *sendbuf, int sendcount, MPI_Datatype sendtype, void
   memset(&stat, 0, sizeof(dumpi_alltoall));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Alltoall);
+  DUMPI_AGGREGATE_BYTES(libdumpi_bytes(sendcount, sendtype) * libdumpi_comm_peers(comm),
+			libdumpi_bytes(recvcount, recvtype) * libdumpi_comm_peers(comm));
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Alltoall);
     DUMPI_INT_FROM_INT(stat.sendcount, sendcount);
@@ -2180,6 +2164,7 @@ int MPI_Alltoall(const void *sendbuf, int sendcount, MPI_Datatype sendtype, void
     libdumpi_unlock_io();
     DUMPI_STOP_OVERHEAD(DUMPI_Alltoall);
   }
+  DUMPI_FLUSH_POINT(comm);
   DUMPI_INSERT_POSTAMBLE;
   return retval;
 }
@@ -2196,8 +2181,11 @@ int MPI_Alltoallv(const void *sendbuf, const int *sendcounts, const int *senddis
   int commsize;
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Alltoallv);
+  DUMPI_AGGREGATE_BYTES(libdumpi_bytes_v(sendcounts, sendtype, comm),
+			libdumpi_bytes_v(recvcounts, recvtype, comm));
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Alltoallv);
+    stat.detail = DUMPI_ARG_DETAIL(DUMPI_Alltoallv);
     PMPI_Comm_size(comm, &commsize);
     DUMPI_INT_FROM_INT(stat.commsize, commsize);
     DUMPI_INT_FROM_INT_ARRAY_1(commsize, stat.sendcounts, sendcounts);
@@ -2223,6 +2211,7 @@ int MPI_Alltoallv(const void *sendbuf, const int *sendcounts, const int *senddis
     if(recvdispls != NULL) DUMPI_FREE_INT_FROM_INT(stat.recvdispls);
     DUMPI_STOP_OVERHEAD(DUMPI_Alltoallv);
   }
+  DUMPI_FLUSH_POINT(comm);
   DUMPI_INSERT_POSTAMBLE;
   return retval;
 }
@@ -2237,6 +2226,8 @@ int MPI_Reduce(const void *sendbuf, void *recvbuf, int count, MPI_Datatype datat
   memset(&stat, 0, sizeof(dumpi_reduce));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Reduce);
+  DUMPI_AGGREGATE_ROOTED_BYTES(root, comm, libdumpi_bytes(count, datatype), libdumpi_bytes(count, datatype),
+			       libdumpi_bytes(count, datatype), 0);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Reduce);
     DUMPI_INT_FROM_INT(stat.count, count);
@@ -2256,6 +2247,7 @@ int MPI_Reduce(const void *sendbuf, void *recvbuf, int count, MPI_Datatype datat
     libdumpi_unlock_io();
     DUMPI_STOP_OVERHEAD(DUMPI_Reduce);
   }
+  DUMPI_FLUSH_POINT(comm);
   DUMPI_INSERT_POSTAMBLE;
   return retval;
 }
@@ -2329,6 +2321,7 @@ int MPI_Allreduce(const void *sendbuf, void *recvbuf, int count, MPI_Datatype da
   memset(&stat, 0, sizeof(dumpi_allreduce));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Allreduce);
+  DUMPI_AGGREGATE_BYTES(libdumpi_bytes(count, datatype), libdumpi_bytes(count, datatype));
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Allreduce);
     DUMPI_INT_FROM_INT(stat.count, count);
@@ -2347,6 +2340,7 @@ int MPI_Allreduce(const void *sendbuf, void *recvbuf, int count, MPI_Datatype da
     libdumpi_unlock_io();
     DUMPI_STOP_OVERHEAD(DUMPI_Allreduce);
   }
+  DUMPI_FLUSH_POINT(comm);
   DUMPI_INSERT_POSTAMBLE;
   return retval;
 }
@@ -2363,8 +2357,11 @@ int MPI_Reduce_scatter(const void *sendbuf, void *recvbuf, const int *recvcounts
   int commsize;
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Reduce_scatter);
+  DUMPI_AGGREGATE_BYTES(libdumpi_bytes_v(recvcounts, datatype, comm),
+			libdumpi_bytes(recvcounts[libdumpi_comm_rank(comm)], datatype));
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Reduce_scatter);
+    stat.detail = DUMPI_ARG_DETAIL(DUMPI_Reduce_scatter);
     PMPI_Comm_size(comm, &commsize);
     DUMPI_INT_FROM_INT(stat.commsize, commsize);
     DUMPI_INT_FROM_INT_ARRAY_1(commsize, stat.recvcounts, recvcounts);
@@ -2384,6 +2381,7 @@ int MPI_Reduce_scatter(const void *sendbuf, void *recvbuf, const int *recvcounts
     if(recvcounts != NULL) DUMPI_FREE_INT_FROM_INT(stat.recvcounts);
     DUMPI_STOP_OVERHEAD(DUMPI_Reduce_scatter);
   }
+  DUMPI_FLUSH_POINT(comm);
   DUMPI_INSERT_POSTAMBLE;
   return retval;
 }
@@ -2398,6 +2396,7 @@ int MPI_Scan(const void *sendbuf, void *recvbuf, int count, MPI_Datatype datatyp
   memset(&stat, 0, sizeof(dumpi_scan));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Scan);
+  DUMPI_AGGREGATE_BYTES(libdumpi_bytes(count, datatype), libdumpi_bytes(count, datatype));
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Scan);
     DUMPI_INT_FROM_INT(stat.count, count);
@@ -2416,6 +2415,7 @@ int MPI_Scan(const void *sendbuf, void *recvbuf, int count, MPI_Datatype datatyp
     libdumpi_unlock_io();
     DUMPI_STOP_OVERHEAD(DUMPI_Scan);
   }
+  DUMPI_FLUSH_POINT(comm);
   DUMPI_INSERT_POSTAMBLE;
   return retval;
 }
@@ -4257,6 +4257,7 @@ int MPI_Init(int *argc, char ***argv) {
   /* PMPI_Init is tagged as an INITIAL call */
   if(retval == MPI_SUCCESS) {
     libdumpi_open_files();
+    libdumpi_clocksync_start();
     libdumpi_init_maps();
     register_builtin_datatypes();
     DUMPI_START_TIME(cpu, wall); /* We cheat on timings for INIT. */
@@ -4291,7 +4292,12 @@ int MPI_Finalize(void ) {
     DUMPI_START_TIME(cpu, wall);
     DUMPI_STOP_OVERHEAD(DUMPI_Finalize);
   }
-  
+  /* Deferred statuses can only be decoded while MPI is still up */
+  libdumpi_resolve_statuses();
+  /* So is the gather of the communication matrix */
+  if(dumpi_global->comm_matrix)
+    libdumpi_matrix_write();
+  libdumpi_clocksync_finish();
   retval = PMPI_Finalize();
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Finalize);
@@ -4790,6 +4796,7 @@ int MPI_Accumulate(const void *buf, int origincount, MPI_Datatype origintype, in
   memset(&stat, 0, sizeof(dumpi_accumulate));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Accumulate);
+  DUMPI_AGGREGATE_BYTES(libdumpi_bytes(origincount, origintype), 0);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Accumulate);
     DUMPI_INT_FROM_INT(stat.origincount, origincount);
@@ -4826,6 +4833,7 @@ int MPI_Get(void *buf, int origincount, MPI_Datatype origintype, int targetrank,
   memset(&stat, 0, sizeof(dumpi_get));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Get);
+  DUMPI_AGGREGATE_BYTES(0, libdumpi_bytes(origincount, origintype));
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Get);
     DUMPI_INT_FROM_INT(stat.origincount, origincount);
@@ -4861,6 +4869,7 @@ int MPI_Put(const void *buf, int origincount, MPI_Datatype origintype, int targe
   memset(&stat, 0, sizeof(dumpi_put));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Put);
+  DUMPI_AGGREGATE_BYTES(libdumpi_bytes(origincount, origintype), 0);
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Put);
     DUMPI_INT_FROM_INT(stat.origincount, origincount);
@@ -5232,8 +5241,11 @@ int MPI_Alltoallw(const void *sendbuf, const int *sendcounts, const int *senddis
   int commsize;
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Alltoallw);
+  DUMPI_AGGREGATE_BYTES(libdumpi_bytes_w(sendcounts, sendtypes, comm),
+			libdumpi_bytes_w(recvcounts, recvtypes, comm));
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Alltoallw);
+    stat.detail = DUMPI_ARG_DETAIL(DUMPI_Alltoallw);
     PMPI_Comm_size(comm, &commsize);
     DUMPI_INT_FROM_INT(stat.commsize, commsize);
     DUMPI_INT_FROM_INT_ARRAY_1(commsize, stat.sendcounts, sendcounts);
@@ -5261,6 +5273,7 @@ int MPI_Alltoallw(const void *sendbuf, const int *sendcounts, const int *senddis
     if(recvtypes != NULL) DUMPI_FREE_DATATYPE_FROM_MPI_DATATYPE(stat.recvtypes);
     DUMPI_STOP_OVERHEAD(DUMPI_Alltoallw);
   }
+  DUMPI_FLUSH_POINT(comm);
   DUMPI_INSERT_POSTAMBLE;
   return retval;
 }
@@ -5275,6 +5288,7 @@ int MPI_Exscan(const void *sendbuf, void *recvbuf, int count, MPI_Datatype datat
   memset(&stat, 0, sizeof(dumpi_exscan));
   thread = libdumpi_get_thread_id();
   DUMPI_INSERT_PREAMBLE(DUMPI_Exscan);
+  DUMPI_AGGREGATE_BYTES(libdumpi_bytes(count, datatype), libdumpi_bytes(count, datatype));
   if(profiling) {
     DUMPI_START_OVERHEAD(DUMPI_Exscan);
     DUMPI_INT_FROM_INT(stat.count, count);
@@ -5293,6 +5307,7 @@ int MPI_Exscan(const void *sendbuf, void *recvbuf, int count, MPI_Datatype datat
     libdumpi_unlock_io();
     DUMPI_STOP_OVERHEAD(DUMPI_Exscan);
   }
+  DUMPI_FLUSH_POINT(comm);
   DUMPI_INSERT_POSTAMBLE;
   return retval;
 }
@@ -5747,6 +5762,7 @@ int MPI_Init_thread(int *argc, char ***argv, int required, int *provided) {
   if(retval == MPI_SUCCESS) {
     /* PMPI_Init_thread is tagged as an INITIAL call */
     libdumpi_open_files();
+    libdumpi_clocksync_start();
     libdumpi_init_maps();
     register_builtin_datatypes();
     DUMPI_START_TIME(cpu, wall); /* We cheat on timings for INIT. */
@@ -9494,3 +9510,1037 @@ int MPIO_Testsome(int count, MPIO_Request *requests, int *outcount, int *indices
 }
 #endif /* DUMPI_SKIP_MPIO_TESTSOME */
 
+#ifndef DUMPI_SKIP_MPI_IBARRIER
+int MPI_Ibarrier(MPI_Comm comm, MPI_Request *request) {
+  int16_t thread;
+  dumpi_time cpu, wall;
+  int retval;
+  dumpi_ibarrier stat;
+  memset(&stat, 0, sizeof(dumpi_ibarrier));
+  thread = libdumpi_get_thread_id();
+  DUMPI_INSERT_PREAMBLE(DUMPI_Ibarrier);
+  if(profiling) {
+    DUMPI_START_OVERHEAD(DUMPI_Ibarrier);
+    DUMPI_COMM_FROM_MPI_COMM(stat.comm, comm);
+    DUMPI_START_TIME(cpu, wall);
+    DUMPI_STOP_OVERHEAD(DUMPI_Ibarrier);
+  }
+  retval = PMPI_Ibarrier(comm, request);
+  if(profiling) {
+    DUMPI_START_OVERHEAD(DUMPI_Ibarrier);
+    DUMPI_STOP_TIME(cpu, wall);
+    DUMPI_REQUEST_FROM_MPI_REQUEST(stat.request, *request);
+    libdumpi_lock_io();
+    dumpi_write_ibarrier(&stat, thread, &cpu, &wall, dumpi_global->perf, dumpi_global->output, dumpi_global->profile);
+    libdumpi_unlock_io();
+    DUMPI_STOP_OVERHEAD(DUMPI_Ibarrier);
+  }
+  DUMPI_INSERT_POSTAMBLE;
+  return retval;
+}
+#endif /* DUMPI_SKIP_MPI_IBARRIER */
+
+#ifndef DUMPI_SKIP_MPI_IBCAST
+int MPI_Ibcast(void *sendbuf, int count, MPI_Datatype datatype, int root, MPI_Comm comm, MPI_Request *request) {
+  int16_t thread;
+  dumpi_time cpu, wall;
+  int retval;
+  dumpi_ibcast stat;
+  memset(&stat, 0, sizeof(dumpi_ibcast));
+  thread = libdumpi_get_thread_id();
+  DUMPI_INSERT_PREAMBLE(DUMPI_Ibcast);
+  DUMPI_AGGREGATE_ROOTED_BYTES(root, comm, libdumpi_bytes(count, datatype), 0,
+			       0, libdumpi_bytes(count, datatype));
+  if(profiling) {
+    DUMPI_START_OVERHEAD(DUMPI_Ibcast);
+    DUMPI_INT_FROM_INT(stat.count, count);
+    DUMPI_DATATYPE_FROM_MPI_DATATYPE(stat.datatype, datatype);
+    DUMPI_INT_FROM_INT(stat.root, root);
+    DUMPI_COMM_FROM_MPI_COMM(stat.comm, comm);
+    DUMPI_START_TIME(cpu, wall);
+    DUMPI_STOP_OVERHEAD(DUMPI_Ibcast);
+  }
+  retval = PMPI_Ibcast(sendbuf, count, datatype, root, comm, request);
+  if(profiling) {
+    DUMPI_START_OVERHEAD(DUMPI_Ibcast);
+    DUMPI_STOP_TIME(cpu, wall);
+    DUMPI_REQUEST_FROM_MPI_REQUEST(stat.request, *request);
+    libdumpi_lock_io();
+    dumpi_write_ibcast(&stat, thread, &cpu, &wall, dumpi_global->perf, dumpi_global->output, dumpi_global->profile);
+    libdumpi_unlock_io();
+    DUMPI_STOP_OVERHEAD(DUMPI_Ibcast);
+  }
+  DUMPI_INSERT_POSTAMBLE;
+  return retval;
+}
+#endif /* DUMPI_SKIP_MPI_IBCAST */
+
+#ifndef DUMPI_SKIP_MPI_IGATHER
+int MPI_Igather(const void *inbuf, int sendcount, MPI_Datatype sendtype, void *recvbuf, int recvcount, MPI_Datatype recvtype, int root, MPI_Comm comm, MPI_Request *request) {
+  int16_t thread;
+  dumpi_time cpu, wall;
+  int retval;
+  dumpi_igather stat;
+  memset(&stat, 0, sizeof(dumpi_igather));
+  /* Extra declarations */
+  int commrank;
+  thread = libdumpi_get_thread_id();
+  DUMPI_INSERT_PREAMBLE(DUMPI_Igather);
+  DUMPI_AGGREGATE_ROOTED_BYTES(root, comm, libdumpi_bytes(sendcount, sendtype),
+			       libdumpi_bytes(recvcount, recvtype) * libdumpi_comm_peers(comm),
+			       libdumpi_bytes(sendcount, sendtype), 0);
+  if(profiling) {
+    DUMPI_START_OVERHEAD(DUMPI_Igather);
+    PMPI_Comm_rank(comm, &commrank);
+    DUMPI_INT_FROM_INT(stat.commrank, commrank);
+    DUMPI_INT_FROM_INT(stat.sendcount, sendcount);
+    DUMPI_DATATYPE_FROM_MPI_DATATYPE(stat.sendtype, sendtype);
+    if(commrank==root)    DUMPI_INT_FROM_INT(stat.recvcount, recvcount);
+    if(commrank==root)    DUMPI_DATATYPE_FROM_MPI_DATATYPE(stat.recvtype, recvtype);
+    DUMPI_INT_FROM_INT(stat.root, root);
+    DUMPI_COMM_FROM_MPI_COMM(stat.comm, comm);
+    DUMPI_START_TIME(cpu, wall);
+    DUMPI_STOP_OVERHEAD(DUMPI_Igather);
+  }
+  retval = PMPI_Igather(inbuf, sendcount, sendtype, recvbuf, recvcount, recvtype, root, comm, request);
+  if(profiling) {
+    DUMPI_START_OVERHEAD(DUMPI_Igather);
+    DUMPI_STOP_TIME(cpu, wall);
+    DUMPI_REQUEST_FROM_MPI_REQUEST(stat.request, *request);
+    libdumpi_lock_io();
+    dumpi_write_igather(&stat, thread, &cpu, &wall, dumpi_global->perf, dumpi_global->output, dumpi_global->profile);
+    libdumpi_unlock_io();
+    DUMPI_STOP_OVERHEAD(DUMPI_Igather);
+  }
+  DUMPI_INSERT_POSTAMBLE;
+  return retval;
+}
+#endif /* DUMPI_SKIP_MPI_IGATHER */
+
+#ifndef DUMPI_SKIP_MPI_IGATHERV
+int MPI_Igatherv(const void *sendbuf, int sendcount, MPI_Datatype sendtype, void *recvbuf, const int *recvcounts, const int *displs, MPI_Datatype recvtype, int root, MPI_Comm comm, MPI_Request *request) {
+  int16_t thread;
+  dumpi_time cpu, wall;
+  int retval;
+  dumpi_igatherv stat;
+  memset(&stat, 0, sizeof(dumpi_igatherv));
+  /* Extra declarations */
+  int commsize;
+  int commrank;
+  thread = libdumpi_get_thread_id();
+  DUMPI_INSERT_PREAMBLE(DUMPI_Igatherv);
+  DUMPI_AGGREGATE_ROOTED_BYTES(root, comm, libdumpi_bytes(sendcount, sendtype),
+			       libdumpi_bytes_v(recvcounts, recvtype, comm),
+			       libdumpi_bytes(sendcount, sendtype), 0);
+  if(profiling) {
+    DUMPI_START_OVERHEAD(DUMPI_Igatherv);
+    stat.detail = DUMPI_ARG_DETAIL(DUMPI_Igatherv);
+    PMPI_Comm_size(comm, &commsize); PMPI_Comm_rank(comm, &commrank);
+    DUMPI_INT_FROM_INT(stat.commrank, commrank);
+    DUMPI_INT_FROM_INT(stat.commsize, commsize);
+    DUMPI_INT_FROM_INT(stat.sendcount, sendcount);
+    DUMPI_DATATYPE_FROM_MPI_DATATYPE(stat.sendtype, sendtype);
+    if(commrank==root)    DUMPI_INT_FROM_INT_ARRAY_1(commsize, stat.recvcounts, recvcounts);
+    if(commrank==root)    DUMPI_INT_FROM_INT_ARRAY_1(commsize, stat.displs, displs);
+    if(commrank==root)    DUMPI_DATATYPE_FROM_MPI_DATATYPE(stat.recvtype, recvtype);
+    DUMPI_INT_FROM_INT(stat.root, root);
+    DUMPI_COMM_FROM_MPI_COMM(stat.comm, comm);
+    DUMPI_START_TIME(cpu, wall);
+    DUMPI_STOP_OVERHEAD(DUMPI_Igatherv);
+  }
+  retval = PMPI_Igatherv(sendbuf, sendcount, sendtype, recvbuf, recvcounts, displs, recvtype, root, comm, request);
+  if(profiling) {
+    DUMPI_START_OVERHEAD(DUMPI_Igatherv);
+    DUMPI_STOP_TIME(cpu, wall);
+    DUMPI_REQUEST_FROM_MPI_REQUEST(stat.request, *request);
+    libdumpi_lock_io();
+    dumpi_write_igatherv(&stat, thread, &cpu, &wall, dumpi_global->perf, dumpi_global->output, dumpi_global->profile);
+    libdumpi_unlock_io();
+    if(recvcounts != NULL) DUMPI_FREE_INT_FROM_INT(stat.recvcounts);
+    if(displs != NULL) DUMPI_FREE_INT_FROM_INT(stat.displs);
+    DUMPI_STOP_OVERHEAD(DUMPI_Igatherv);
+  }
+  DUMPI_INSERT_POSTAMBLE;
+  return retval;
+}
+#endif /* DUMPI_SKIP_MPI_IGATHERV */
+
+#ifndef DUMPI_SKIP_MPI_ISCATTER
+int MPI_Iscatter(const void *sendbuf, int sendcount, MPI_Datatype sendtype, void *recvbuf, int recvcount, MPI_Datatype recvtype, int root, MPI_Comm comm, MPI_Request *request) {
+  int16_t thread;
+  dumpi_time cpu, wall;
+  int retval;
+  dumpi_iscatter stat;
+  memset(&stat, 0, sizeof(dumpi_iscatter));
+  /* Extra declarations */
+  int commrank;
+  thread = libdumpi_get_thread_id();
+  DUMPI_INSERT_PREAMBLE(DUMPI_Iscatter);
+  DUMPI_AGGREGATE_ROOTED_BYTES(root, comm, libdumpi_bytes(sendcount, sendtype) * libdumpi_comm_peers(comm),
+			       libdumpi_bytes(recvcount, recvtype),
+			       0, libdumpi_bytes(recvcount, recvtype));
+  if(profiling) {
+    DUMPI_START_OVERHEAD(DUMPI_Iscatter);
+    PMPI_Comm_rank(comm, &commrank);
+    DUMPI_INT_FROM_INT(stat.commrank, commrank);
+    if(commrank==root)    DUMPI_INT_FROM_INT(stat.sendcount, sendcount);
+    if(commrank==root)    DUMPI_DATATYPE_FROM_MPI_DATATYPE(stat.sendtype, sendtype);
+    DUMPI_INT_FROM_INT(stat.recvcount, recvcount);
+    DUMPI_DATATYPE_FROM_MPI_DATATYPE(stat.recvtype, recvtype);
+    DUMPI_INT_FROM_INT(stat.root, root);
+    DUMPI_COMM_FROM_MPI_COMM(stat.comm, comm);
+    DUMPI_START_TIME(cpu, wall);
+    DUMPI_STOP_OVERHEAD(DUMPI_Iscatter);
+  }
+  retval = PMPI_Iscatter(sendbuf, sendcount, sendtype, recvbuf, recvcount, recvtype, root, comm, request);
+  if(profiling) {
+    DUMPI_START_OVERHEAD(DUMPI_Iscatter);
+    DUMPI_STOP_TIME(cpu, wall);
+    DUMPI_REQUEST_FROM_MPI_REQUEST(stat.request, *request);
+    libdumpi_lock_io();
+    dumpi_write_iscatter(&stat, thread, &cpu, &wall, dumpi_global->perf, dumpi_global->output, dumpi_global->profile);
+    libdumpi_unlock_io();
+    DUMPI_STOP_OVERHEAD(DUMPI_Iscatter);
+  }
+  DUMPI_INSERT_POSTAMBLE;
+  return retval;
+}
+#endif /* DUMPI_SKIP_MPI_ISCATTER */
+
+#ifndef DUMPI_SKIP_MPI_ISCATTERV
+int MPI_Iscatterv(const void *sendbuf, const int *sendcounts, const int *displs, MPI_Datatype sendtype, void *recvbuf, int recvcount, MPI_Datatype recvtype, int root, MPI_Comm comm, MPI_Request *request) {
+  int16_t thread;
+  dumpi_time cpu, wall;
+  int retval;
+  dumpi_iscatterv stat;
+  memset(&stat, 0, sizeof(dumpi_iscatterv));
+  /* Extra declarations */
+  int commsize;
+  int commrank;
+  thread = libdumpi_get_thread_id();
+  DUMPI_INSERT_PREAMBLE(DUMPI_Iscatterv);
+  DUMPI_AGGREGATE_ROOTED_BYTES(root, comm, libdumpi_bytes_v(sendcounts, sendtype, comm),
+			       libdumpi_bytes(recvcount, recvtype),
+			       0, libdumpi_bytes(recvcount, recvtype));
+  if(profiling) {
+    DUMPI_START_OVERHEAD(DUMPI_Iscatterv);
+    stat.detail = DUMPI_ARG_DETAIL(DUMPI_Iscatterv);
+    PMPI_Comm_size(comm, &commsize); PMPI_Comm_rank(comm, &commrank);
+    DUMPI_INT_FROM_INT(stat.commrank, commrank);
+    DUMPI_INT_FROM_INT(stat.commsize, commsize);
+    if(commrank==root)    DUMPI_INT_FROM_INT_ARRAY_1(commsize, stat.sendcounts, sendcounts);
+    if(commrank==root)    DUMPI_INT_FROM_INT_ARRAY_1(commsize, stat.displs, displs);
+    DUMPI_DATATYPE_FROM_MPI_DATATYPE(stat.sendtype, sendtype);
+    DUMPI_INT_FROM_INT(stat.recvcount, recvcount);
+    DUMPI_DATATYPE_FROM_MPI_DATATYPE(stat.recvtype, recvtype);
+    DUMPI_INT_FROM_INT(stat.root, root);
+    DUMPI_COMM_FROM_MPI_COMM(stat.comm, comm);
+    DUMPI_START_TIME(cpu, wall);
+    DUMPI_STOP_OVERHEAD(DUMPI_Iscatterv);
+  }
+  retval = PMPI_Iscatterv(sendbuf, sendcounts, displs, sendtype, recvbuf, recvcount, recvtype, root, comm, request);
+  if(profiling) {
+    DUMPI_START_OVERHEAD(DUMPI_Iscatterv);
+    DUMPI_STOP_TIME(cpu, wall);
+    DUMPI_REQUEST_FROM_MPI_REQUEST(stat.request, *request);
+    libdumpi_lock_io();
+    dumpi_write_iscatterv(&stat, thread, &cpu, &wall, dumpi_global->perf, dumpi_global->output, dumpi_global->profile);
+    libdumpi_unlock_io();
+    if(sendcounts != NULL) DUMPI_FREE_INT_FROM_INT(stat.sendcounts);
+    if(displs != NULL) DUMPI_FREE_INT_FROM_INT(stat.displs);
+    DUMPI_STOP_OVERHEAD(DUMPI_Iscatterv);
+  }
+  DUMPI_INSERT_POSTAMBLE;
+  return retval;
+}
+#endif /* DUMPI_SKIP_MPI_ISCATTERV */
+
+#ifndef DUMPI_SKIP_MPI_IALLGATHER
+int MPI_Iallgather(const void *sendbuf, int sendcount, MPI_Datatype sendtype, void *recvbuf, int recvcount, MPI_Datatype recvtype, MPI_Comm comm, MPI_Request *request) {
+  int16_t thread;
+  dumpi_time cpu, wall;
+  int retval;
+  dumpi_iallgather stat;
+  memset(&stat, 0, sizeof(dumpi_iallgather));
+  thread = libdumpi_get_thread_id();
+  DUMPI_INSERT_PREAMBLE(DUMPI_Iallgather);
+  DUMPI_AGGREGATE_BYTES(libdumpi_bytes(sendcount, sendtype),
+			libdumpi_bytes(recvcount, recvtype) * libdumpi_comm_peers(comm));
+  if(profiling) {
+    DUMPI_START_OVERHEAD(DUMPI_Iallgather);
+    DUMPI_INT_FROM_INT(stat.sendcount, sendcount);
+    DUMPI_DATATYPE_FROM_MPI_DATATYPE(stat.sendtype, sendtype);
+    DUMPI_INT_FROM_INT(stat.recvcount, recvcount);
+    DUMPI_DATATYPE_FROM_MPI_DATATYPE(stat.recvtype, recvtype);
+    DUMPI_COMM_FROM_MPI_COMM(stat.comm, comm);
+    DUMPI_START_TIME(cpu, wall);
+    DUMPI_STOP_OVERHEAD(DUMPI_Iallgather);
+  }
+  retval = PMPI_Iallgather(sendbuf, sendcount, sendtype, recvbuf, recvcount, recvtype, comm, request);
+  if(profiling) {
+    DUMPI_START_OVERHEAD(DUMPI_Iallgather);
+    DUMPI_STOP_TIME(cpu, wall);
+    DUMPI_REQUEST_FROM_MPI_REQUEST(stat.request, *request);
+    libdumpi_lock_io();
+    dumpi_write_iallgather(&stat, thread, &cpu, &wall, dumpi_global->perf, dumpi_global->output, dumpi_global->profile);
+    libdumpi_unlock_io();
+    DUMPI_STOP_OVERHEAD(DUMPI_Iallgather);
+  }
+  DUMPI_INSERT_POSTAMBLE;
+  return retval;
+}
+#endif /* DUMPI_SKIP_MPI_IALLGATHER */
+
+#ifndef DUMPI_SKIP_MPI_IALLGATHERV
+int MPI_Iallgatherv(const void *sendbuf, int sendcount, MPI_Datatype sendtype, void *recvbuf, const int *recvcounts, const int *displs, MPI_Datatype recvtype, MPI_Comm comm, MPI_Request *request) {
+  int16_t thread;
+  dumpi_time cpu, wall;
+  int retval;
+  dumpi_iallgatherv stat;
+  memset(&stat, 0, sizeof(dumpi_iallgatherv));
+  /* Extra declarations */
+  int commsize;
+  thread = libdumpi_get_thread_id();
+  DUMPI_INSERT_PREAMBLE(DUMPI_Iallgatherv);
+  DUMPI_AGGREGATE_BYTES(libdumpi_bytes(sendcount, sendtype),
+			libdumpi_bytes_v(recvcounts, recvtype, comm));
+  if(profiling) {
+    DUMPI_START_OVERHEAD(DUMPI_Iallgatherv);
+    stat.detail = DUMPI_ARG_DETAIL(DUMPI_Iallgatherv);
+    PMPI_Comm_size(comm, &commsize);
+    DUMPI_INT_FROM_INT(stat.commsize, commsize);
+    DUMPI_INT_FROM_INT(stat.sendcount, sendcount);
+    DUMPI_DATATYPE_FROM_MPI_DATATYPE(stat.sendtype, sendtype);
+    DUMPI_INT_FROM_INT_ARRAY_1(commsize, stat.recvcounts, recvcounts);
+    DUMPI_INT_FROM_INT_ARRAY_1(commsize, stat.displs, displs);
+    DUMPI_DATATYPE_FROM_MPI_DATATYPE(stat.recvtype, recvtype);
+    DUMPI_COMM_FROM_MPI_COMM(stat.comm, comm);
+    DUMPI_START_TIME(cpu, wall);
+    DUMPI_STOP_OVERHEAD(DUMPI_Iallgatherv);
+  }
+  retval = PMPI_Iallgatherv(sendbuf, sendcount, sendtype, recvbuf, recvcounts, displs, recvtype, comm, request);
+  if(profiling) {
+    DUMPI_START_OVERHEAD(DUMPI_Iallgatherv);
+    DUMPI_STOP_TIME(cpu, wall);
+    DUMPI_REQUEST_FROM_MPI_REQUEST(stat.request, *request);
+    libdumpi_lock_io();
+    dumpi_write_iallgatherv(&stat, thread, &cpu, &wall, dumpi_global->perf, dumpi_global->output, dumpi_global->profile);
+    libdumpi_unlock_io();
+    if(recvcounts != NULL) DUMPI_FREE_INT_FROM_INT(stat.recvcounts);
+    if(displs != NULL) DUMPI_FREE_INT_FROM_INT(stat.displs);
+    DUMPI_STOP_OVERHEAD(DUMPI_Iallgatherv);
+  }
+  DUMPI_INSERT_POSTAMBLE;
+  return retval;
+}
+#endif /* DUMPI_SKIP_MPI_IALLGATHERV */
+
+#ifndef DUMPI_SKIP_MPI_IALLTOALL
+int MPI_Ialltoall(const void *sendbuf, int sendcount, MPI_Datatype sendtype, void *recvbuf, int recvcount, MPI_Datatype recvtype, MPI_Comm comm, MPI_Request *request) {
+  int16_t thread;
+  dumpi_time cpu, wall;
+  int retval;
+  dumpi_ialltoall stat;
+  memset(&stat, 0, sizeof(dumpi_ialltoall));
+  thread = libdumpi_get_thread_id();
+  DUMPI_INSERT_PREAMBLE(DUMPI_Ialltoall);
+  DUMPI_AGGREGATE_BYTES(libdumpi_bytes(sendcount, sendtype) * libdumpi_comm_peers(comm),
+			libdumpi_bytes(recvcount, recvtype) * libdumpi_comm_peers(comm));
+  if(profiling) {
+    DUMPI_START_OVERHEAD(DUMPI_Ialltoall);
+    DUMPI_INT_FROM_INT(stat.sendcount, sendcount);
+    DUMPI_DATATYPE_FROM_MPI_DATATYPE(stat.sendtype, sendtype);
+    DUMPI_INT_FROM_INT(stat.recvcount, recvcount);
+    DUMPI_DATATYPE_FROM_MPI_DATATYPE(stat.recvtype, recvtype);
+    DUMPI_COMM_FROM_MPI_COMM(stat.comm, comm);
+    DUMPI_START_TIME(cpu, wall);
+    DUMPI_STOP_OVERHEAD(DUMPI_Ialltoall);
+  }
+  retval = PMPI_Ialltoall(sendbuf, sendcount, sendtype, recvbuf, recvcount, recvtype, comm, request);
+  if(profiling) {
+    DUMPI_START_OVERHEAD(DUMPI_Ialltoall);
+    DUMPI_STOP_TIME(cpu, wall);
+    DUMPI_REQUEST_FROM_MPI_REQUEST(stat.request, *request);
+    libdumpi_lock_io();
+    dumpi_write_ialltoall(&stat, thread, &cpu, &wall, dumpi_global->perf, dumpi_global->output, dumpi_global->profile);
+    libdumpi_unlock_io();
+    DUMPI_STOP_OVERHEAD(DUMPI_Ialltoall);
+  }
+  DUMPI_INSERT_POSTAMBLE;
+  return retval;
+}
+#endif /* DUMPI_SKIP_MPI_IALLTOALL */
+
+#ifndef DUMPI_SKIP_MPI_IALLTOALLV
+int MPI_Ialltoallv(const void *sendbuf, const int *sendcounts, const int *senddispls, MPI_Datatype sendtype, void *recvbuf, const int *recvcounts, const int *recvdispls, MPI_Datatype recvtype, MPI_Comm comm, MPI_Request *request) {
+  int16_t thread;
+  dumpi_time cpu, wall;
+  int retval;
+  dumpi_ialltoallv stat;
+  memset(&stat, 0, sizeof(dumpi_ialltoallv));
+  /* Extra declarations */
+  int commsize;
+  thread = libdumpi_get_thread_id();
+  DUMPI_INSERT_PREAMBLE(DUMPI_Ialltoallv);
+  DUMPI_AGGREGATE_BYTES(libdumpi_bytes_v(sendcounts, sendtype, comm),
+			libdumpi_bytes_v(recvcounts, recvtype, comm));
+  if(profiling) {
+    DUMPI_START_OVERHEAD(DUMPI_Ialltoallv);
+    stat.detail = DUMPI_ARG_DETAIL(DUMPI_Ialltoallv);
+    PMPI_Comm_size(comm, &commsize);
+    DUMPI_INT_FROM_INT(stat.commsize, commsize);
+    DUMPI_INT_FROM_INT_ARRAY_1(commsize, stat.sendcounts, sendcounts);
+    DUMPI_INT_FROM_INT_ARRAY_1(commsize, stat.senddispls, senddispls);
+    DUMPI_DATATYPE_FROM_MPI_DATATYPE(stat.sendtype, sendtype);
+    DUMPI_INT_FROM_INT_ARRAY_1(commsize, stat.recvcounts, recvcounts);
+    DUMPI_INT_FROM_INT_ARRAY_1(commsize, stat.recvdispls, recvdispls);
+    DUMPI_DATATYPE_FROM_MPI_DATATYPE(stat.recvtype, recvtype);
+    DUMPI_COMM_FROM_MPI_COMM(stat.comm, comm);
+    DUMPI_START_TIME(cpu, wall);
+    DUMPI_STOP_OVERHEAD(DUMPI_Ialltoallv);
+  }
+  retval = PMPI_Ialltoallv(sendbuf, sendcounts, senddispls, sendtype, recvbuf, recvcounts, recvdispls, recvtype, comm, request);
+  if(profiling) {
+    DUMPI_START_OVERHEAD(DUMPI_Ialltoallv);
+    DUMPI_STOP_TIME(cpu, wall);
+    DUMPI_REQUEST_FROM_MPI_REQUEST(stat.request, *request);
+    libdumpi_lock_io();
+    dumpi_write_ialltoallv(&stat, thread, &cpu, &wall, dumpi_global->perf, dumpi_global->output, dumpi_global->profile);
+    libdumpi_unlock_io();
+    if(sendcounts != NULL) DUMPI_FREE_INT_FROM_INT(stat.sendcounts);
+    if(senddispls != NULL) DUMPI_FREE_INT_FROM_INT(stat.senddispls);
+    if(recvcounts != NULL) DUMPI_FREE_INT_FROM_INT(stat.recvcounts);
+    if(recvdispls != NULL) DUMPI_FREE_INT_FROM_INT(stat.recvdispls);
+    DUMPI_STOP_OVERHEAD(DUMPI_Ialltoallv);
+  }
+  DUMPI_INSERT_POSTAMBLE;
+  return retval;
+}
+#endif /* DUMPI_SKIP_MPI_IALLTOALLV */
+
+#ifndef DUMPI_SKIP_MPI_IALLTOALLW
+int MPI_Ialltoallw(const void *sendbuf, const int *sendcounts, const int *senddispls, const MPI_Datatype *sendtypes, void *recvbuf, const int *recvcounts, const int *recvdispls, const MPI_Datatype *recvtypes, MPI_Comm comm, MPI_Request *request) {
+  int16_t thread;
+  dumpi_time cpu, wall;
+  int retval;
+  dumpi_ialltoallw stat;
+  memset(&stat, 0, sizeof(dumpi_ialltoallw));
+  /* Extra declarations */
+  int commsize;
+  thread = libdumpi_get_thread_id();
+  DUMPI_INSERT_PREAMBLE(DUMPI_Ialltoallw);
+  DUMPI_AGGREGATE_BYTES(libdumpi_bytes_w(sendcounts, sendtypes, comm),
+			libdumpi_bytes_w(recvcounts, recvtypes, comm));
+  if(profiling) {
+    DUMPI_START_OVERHEAD(DUMPI_Ialltoallw);
+    stat.detail = DUMPI_ARG_DETAIL(DUMPI_Ialltoallw);
+    PMPI_Comm_size(comm, &commsize);
+    DUMPI_INT_FROM_INT(stat.commsize, commsize);
+    DUMPI_INT_FROM_INT_ARRAY_1(commsize, stat.sendcounts, sendcounts);
+    DUMPI_INT_FROM_INT_ARRAY_1(commsize, stat.senddispls, senddispls);
+    DUMPI_DATATYPE_FROM_MPI_DATATYPE_ARRAY_1(commsize, stat.sendtypes, sendtypes);
+    DUMPI_INT_FROM_INT_ARRAY_1(commsize, stat.recvcounts, recvcounts);
+    DUMPI_INT_FROM_INT_ARRAY_1(commsize, stat.recvdispls, recvdispls);
+    DUMPI_DATATYPE_FROM_MPI_DATATYPE_ARRAY_1(commsize, stat.recvtypes, recvtypes);
+    DUMPI_COMM_FROM_MPI_COMM(stat.comm, comm);
+    DUMPI_START_TIME(cpu, wall);
+    DUMPI_STOP_OVERHEAD(DUMPI_Ialltoallw);
+  }
+  retval = PMPI_Ialltoallw(sendbuf, sendcounts, senddispls, sendtypes, recvbuf, recvcounts, recvdispls, recvtypes, comm, request);
+  if(profiling) {
+    DUMPI_START_OVERHEAD(DUMPI_Ialltoallw);
+    DUMPI_STOP_TIME(cpu, wall);
+    DUMPI_REQUEST_FROM_MPI_REQUEST(stat.request, *request);
+    libdumpi_lock_io();
+    dumpi_write_ialltoallw(&stat, thread, &cpu, &wall, dumpi_global->perf, dumpi_global->output, dumpi_global->profile);
+    libdumpi_unlock_io();
+    if(sendcounts != NULL) DUMPI_FREE_INT_FROM_INT(stat.sendcounts);
+    if(senddispls != NULL) DUMPI_FREE_INT_FROM_INT(stat.senddispls);
+    if(sendtypes != NULL) DUMPI_FREE_DATATYPE_FROM_MPI_DATATYPE(stat.sendtypes);
+    if(recvcounts != NULL) DUMPI_FREE_INT_FROM_INT(stat.recvcounts);
+    if(recvdispls != NULL) DUMPI_FREE_INT_FROM_INT(stat.recvdispls);
+    if(recvtypes != NULL) DUMPI_FREE_DATATYPE_FROM_MPI_DATATYPE(stat.recvtypes);
+    DUMPI_STOP_OVERHEAD(DUMPI_Ialltoallw);
+  }
+  DUMPI_INSERT_POSTAMBLE;
+  return retval;
+}
+#endif /* DUMPI_SKIP_MPI_IALLTOALLW */
+
+#ifndef DUMPI_SKIP_MPI_IREDUCE
+int MPI_Ireduce(const void *sendbuf, void *recvbuf, int count, MPI_Datatype datatype, MPI_Op op, int root, MPI_Comm comm, MPI_Request *request) {
+  int16_t thread;
+  dumpi_time cpu, wall;
+  int retval;
+  dumpi_ireduce stat;
+  memset(&stat, 0, sizeof(dumpi_ireduce));
+  thread = libdumpi_get_thread_id();
+  DUMPI_INSERT_PREAMBLE(DUMPI_Ireduce);
+  DUMPI_AGGREGATE_ROOTED_BYTES(root, comm, libdumpi_bytes(count, datatype), libdumpi_bytes(count, datatype),
+			       libdumpi_bytes(count, datatype), 0);
+  if(profiling) {
+    DUMPI_START_OVERHEAD(DUMPI_Ireduce);
+    DUMPI_INT_FROM_INT(stat.count, count);
+    DUMPI_DATATYPE_FROM_MPI_DATATYPE(stat.datatype, datatype);
+    DUMPI_OP_FROM_MPI_OP(stat.op, op);
+    DUMPI_INT_FROM_INT(stat.root, root);
+    DUMPI_COMM_FROM_MPI_COMM(stat.comm, comm);
+    DUMPI_START_TIME(cpu, wall);
+    DUMPI_STOP_OVERHEAD(DUMPI_Ireduce);
+  }
+  retval = PMPI_Ireduce(sendbuf, recvbuf, count, datatype, op, root, comm, request);
+  if(profiling) {
+    DUMPI_START_OVERHEAD(DUMPI_Ireduce);
+    DUMPI_STOP_TIME(cpu, wall);
+    DUMPI_REQUEST_FROM_MPI_REQUEST(stat.request, *request);
+    libdumpi_lock_io();
+    dumpi_write_ireduce(&stat, thread, &cpu, &wall, dumpi_global->perf, dumpi_global->output, dumpi_global->profile);
+    libdumpi_unlock_io();
+    DUMPI_STOP_OVERHEAD(DUMPI_Ireduce);
+  }
+  DUMPI_INSERT_POSTAMBLE;
+  return retval;
+}
+#endif /* DUMPI_SKIP_MPI_IREDUCE */
+
+#ifndef DUMPI_SKIP_MPI_IALLREDUCE
+int MPI_Iallreduce(const void *sendbuf, void *recvbuf, int count, MPI_Datatype datatype, MPI_Op op, MPI_Comm comm, MPI_Request *request) {
+  int16_t thread;
+  dumpi_time cpu, wall;
+  int retval;
+  dumpi_iallreduce stat;
+  memset(&stat, 0, sizeof(dumpi_iallreduce));
+  thread = libdumpi_get_thread_id();
+  DUMPI_INSERT_PREAMBLE(DUMPI_Iallreduce);
+  DUMPI_AGGREGATE_BYTES(libdumpi_bytes(count, datatype), libdumpi_bytes(count, datatype));
+  if(profiling) {
+    DUMPI_START_OVERHEAD(DUMPI_Iallreduce);
+    DUMPI_INT_FROM_INT(stat.count, count);
+    DUMPI_DATATYPE_FROM_MPI_DATATYPE(stat.datatype, datatype);
+    DUMPI_OP_FROM_MPI_OP(stat.op, op);
+    DUMPI_COMM_FROM_MPI_COMM(stat.comm, comm);
+    DUMPI_START_TIME(cpu, wall);
+    DUMPI_STOP_OVERHEAD(DUMPI_Iallreduce);
+  }
+  retval = PMPI_Iallreduce(sendbuf, recvbuf, count, datatype, op, comm, request);
+  if(profiling) {
+    DUMPI_START_OVERHEAD(DUMPI_Iallreduce);
+    DUMPI_STOP_TIME(cpu, wall);
+    DUMPI_REQUEST_FROM_MPI_REQUEST(stat.request, *request);
+    libdumpi_lock_io();
+    dumpi_write_iallreduce(&stat, thread, &cpu, &wall, dumpi_global->perf, dumpi_global->output, dumpi_global->profile);
+    libdumpi_unlock_io();
+    DUMPI_STOP_OVERHEAD(DUMPI_Iallreduce);
+  }
+  DUMPI_INSERT_POSTAMBLE;
+  return retval;
+}
+#endif /* DUMPI_SKIP_MPI_IALLREDUCE */
+
+#ifndef DUMPI_SKIP_MPI_IREDUCE_SCATTER
+int MPI_Ireduce_scatter(const void *sendbuf, void *recvbuf, const int *recvcounts, MPI_Datatype datatype, MPI_Op op, MPI_Comm comm, MPI_Request *request) {
+  int16_t thread;
+  dumpi_time cpu, wall;
+  int retval;
+  dumpi_ireduce_scatter stat;
+  memset(&stat, 0, sizeof(dumpi_ireduce_scatter));
+  /* Extra declarations */
+  int commsize;
+  thread = libdumpi_get_thread_id();
+  DUMPI_INSERT_PREAMBLE(DUMPI_Ireduce_scatter);
+  DUMPI_AGGREGATE_BYTES(libdumpi_bytes_v(recvcounts, datatype, comm),
+			libdumpi_bytes(recvcounts[libdumpi_comm_rank(comm)], datatype));
+  if(profiling) {
+    DUMPI_START_OVERHEAD(DUMPI_Ireduce_scatter);
+    stat.detail = DUMPI_ARG_DETAIL(DUMPI_Ireduce_scatter);
+    PMPI_Comm_size(comm, &commsize);
+    DUMPI_INT_FROM_INT(stat.commsize, commsize);
+    DUMPI_INT_FROM_INT_ARRAY_1(commsize, stat.recvcounts, recvcounts);
+    DUMPI_DATATYPE_FROM_MPI_DATATYPE(stat.datatype, datatype);
+    DUMPI_OP_FROM_MPI_OP(stat.op, op);
+    DUMPI_COMM_FROM_MPI_COMM(stat.comm, comm);
+    DUMPI_START_TIME(cpu, wall);
+    DUMPI_STOP_OVERHEAD(DUMPI_Ireduce_scatter);
+  }
+  retval = PMPI_Ireduce_scatter(sendbuf, recvbuf, recvcounts, datatype, op, comm, request);
+  if(profiling) {
+    DUMPI_START_OVERHEAD(DUMPI_Ireduce_scatter);
+    DUMPI_STOP_TIME(cpu, wall);
+    DUMPI_REQUEST_FROM_MPI_REQUEST(stat.request, *request);
+    libdumpi_lock_io();
+    dumpi_write_ireduce_scatter(&stat, thread, &cpu, &wall, dumpi_global->perf, dumpi_global->output, dumpi_global->profile);
+    libdumpi_unlock_io();
+    if(recvcounts != NULL) DUMPI_FREE_INT_FROM_INT(stat.recvcounts);
+    DUMPI_STOP_OVERHEAD(DUMPI_Ireduce_scatter);
+  }
+  DUMPI_INSERT_POSTAMBLE;
+  return retval;
+}
+#endif /* DUMPI_SKIP_MPI_IREDUCE_SCATTER */
+
+#ifndef DUMPI_SKIP_MPI_ISCAN
+int MPI_Iscan(const void *sendbuf, void *recvbuf, int count, MPI_Datatype datatype, MPI_Op op, MPI_Comm comm, MPI_Request *request) {
+  int16_t thread;
+  dumpi_time cpu, wall;
+  int retval;
+  dumpi_iscan stat;
+  memset(&stat, 0, sizeof(dumpi_iscan));
+  thread = libdumpi_get_thread_id();
+  DUMPI_INSERT_PREAMBLE(DUMPI_Iscan);
+  DUMPI_AGGREGATE_BYTES(libdumpi_bytes(count, datatype), libdumpi_bytes(count, datatype));
+  if(profiling) {
+    DUMPI_START_OVERHEAD(DUMPI_Iscan);
+    DUMPI_INT_FROM_INT(stat.count, count);
+    DUMPI_DATATYPE_FROM_MPI_DATATYPE(stat.datatype, datatype);
+    DUMPI_OP_FROM_MPI_OP(stat.op, op);
+    DUMPI_COMM_FROM_MPI_COMM(stat.comm, comm);
+    DUMPI_START_TIME(cpu, wall);
+    DUMPI_STOP_OVERHEAD(DUMPI_Iscan);
+  }
+  retval = PMPI_Iscan(sendbuf, recvbuf, count, datatype, op, comm, request);
+  if(profiling) {
+    DUMPI_START_OVERHEAD(DUMPI_Iscan);
+    DUMPI_STOP_TIME(cpu, wall);
+    DUMPI_REQUEST_FROM_MPI_REQUEST(stat.request, *request);
+    libdumpi_lock_io();
+    dumpi_write_iscan(&stat, thread, &cpu, &wall, dumpi_global->perf, dumpi_global->output, dumpi_global->profile);
+    libdumpi_unlock_io();
+    DUMPI_STOP_OVERHEAD(DUMPI_Iscan);
+  }
+  DUMPI_INSERT_POSTAMBLE;
+  return retval;
+}
+#endif /* DUMPI_SKIP_MPI_ISCAN */
+
+#ifndef DUMPI_SKIP_MPI_IEXSCAN
+int MPI_Iexscan(const void *sendbuf, void *recvbuf, int count, MPI_Datatype datatype, MPI_Op op, MPI_Comm comm, MPI_Request *request) {
+  int16_t thread;
+  dumpi_time cpu, wall;
+  int retval;
+  dumpi_iexscan stat;
+  memset(&stat, 0, sizeof(dumpi_iexscan));
+  thread = libdumpi_get_thread_id();
+  DUMPI_INSERT_PREAMBLE(DUMPI_Iexscan);
+  DUMPI_AGGREGATE_BYTES(libdumpi_bytes(count, datatype), libdumpi_bytes(count, datatype));
+  if(profiling) {
+    DUMPI_START_OVERHEAD(DUMPI_Iexscan);
+    DUMPI_INT_FROM_INT(stat.count, count);
+    DUMPI_DATATYPE_FROM_MPI_DATATYPE(stat.datatype, datatype);
+    DUMPI_OP_FROM_MPI_OP(stat.op, op);
+    DUMPI_COMM_FROM_MPI_COMM(stat.comm, comm);
+    DUMPI_START_TIME(cpu, wall);
+    DUMPI_STOP_OVERHEAD(DUMPI_Iexscan);
+  }
+  retval = PMPI_Iexscan(sendbuf, recvbuf, count, datatype, op, comm, request);
+  if(profiling) {
+    DUMPI_START_OVERHEAD(DUMPI_Iexscan);
+    DUMPI_STOP_TIME(cpu, wall);
+    DUMPI_REQUEST_FROM_MPI_REQUEST(stat.request, *request);
+    libdumpi_lock_io();
+    dumpi_write_iexscan(&stat, thread, &cpu, &wall, dumpi_global->perf, dumpi_global->output, dumpi_global->profile);
+    libdumpi_unlock_io();
+    DUMPI_STOP_OVERHEAD(DUMPI_Iexscan);
+  }
+  DUMPI_INSERT_POSTAMBLE;
+  return retval;
+}
+#endif /* DUMPI_SKIP_MPI_IEXSCAN */
+
+#ifndef DUMPI_SKIP_MPI_DIST_GRAPH_CREATE_ADJACENT
+int MPI_Dist_graph_create_adjacent(MPI_Comm oldcomm, int indegree, const int *sources, const int *sourceweights, int outdegree, const int *destinations, const int *destweights, MPI_Info info, int reorder, MPI_Comm *newcomm) {
+  int16_t thread;
+  dumpi_time cpu, wall;
+  int retval;
+  dumpi_dist_graph_create_adjacent stat;
+  memset(&stat, 0, sizeof(dumpi_dist_graph_create_adjacent));
+  thread = libdumpi_get_thread_id();
+  DUMPI_INSERT_PREAMBLE(DUMPI_Dist_graph_create_adjacent);
+  if(profiling) {
+    DUMPI_START_OVERHEAD(DUMPI_Dist_graph_create_adjacent);
+    DUMPI_COMM_FROM_MPI_COMM(stat.oldcomm, oldcomm);
+    DUMPI_INT_FROM_INT(stat.indegree, indegree);
+    DUMPI_INT_FROM_INT_ARRAY_1(indegree, stat.sources, sources);
+    DUMPI_INT_FROM_INT(stat.outdegree, outdegree);
+    DUMPI_INT_FROM_INT_ARRAY_1(outdegree, stat.destinations, destinations);
+    DUMPI_INT_FROM_INT(stat.reorder, reorder);
+    DUMPI_START_TIME(cpu, wall);
+    DUMPI_STOP_OVERHEAD(DUMPI_Dist_graph_create_adjacent);
+  }
+  retval = PMPI_Dist_graph_create_adjacent(oldcomm, indegree, sources, sourceweights, outdegree, destinations, destweights, info, reorder, newcomm);
+  if(profiling) {
+    DUMPI_START_OVERHEAD(DUMPI_Dist_graph_create_adjacent);
+    DUMPI_STOP_TIME(cpu, wall);
+    DUMPI_COMM_FROM_MPI_COMM(stat.newcomm, *newcomm);
+    libdumpi_lock_io();
+    dumpi_write_dist_graph_create_adjacent(&stat, thread, &cpu, &wall, dumpi_global->perf, dumpi_global->output, dumpi_global->profile);
+    libdumpi_unlock_io();
+    if(sources != NULL) DUMPI_FREE_INT_FROM_INT(stat.sources);
+    if(destinations != NULL) DUMPI_FREE_INT_FROM_INT(stat.destinations);
+    DUMPI_STOP_OVERHEAD(DUMPI_Dist_graph_create_adjacent);
+  }
+  DUMPI_INSERT_POSTAMBLE;
+  return retval;
+}
+#endif /* DUMPI_SKIP_MPI_DIST_GRAPH_CREATE_ADJACENT */
+
+#ifndef DUMPI_SKIP_MPI_NEIGHBOR_ALLGATHER
+int MPI_Neighbor_allgather(const void *sendbuf, int sendcount, MPI_Datatype sendtype, void *recvbuf, int recvcount, MPI_Datatype recvtype, MPI_Comm comm) {
+  int16_t thread;
+  dumpi_time cpu, wall;
+  int retval;
+  dumpi_neighbor_allgather stat;
+  memset(&stat, 0, sizeof(dumpi_neighbor_allgather));
+  /* Extra declarations */
+  int indegree = 0, outdegree = 0;
+  thread = libdumpi_get_thread_id();
+  DUMPI_INSERT_PREAMBLE(DUMPI_Neighbor_allgather);
+  if(aggregating) libdumpi_neighbor_degrees(comm, &indegree, &outdegree);
+  DUMPI_AGGREGATE_BYTES(libdumpi_bytes(sendcount, sendtype) * outdegree,
+			libdumpi_bytes(recvcount, recvtype) * indegree);
+  if(profiling) {
+    DUMPI_START_OVERHEAD(DUMPI_Neighbor_allgather);
+    DUMPI_INT_FROM_INT(stat.sendcount, sendcount);
+    DUMPI_DATATYPE_FROM_MPI_DATATYPE(stat.sendtype, sendtype);
+    DUMPI_INT_FROM_INT(stat.recvcount, recvcount);
+    DUMPI_DATATYPE_FROM_MPI_DATATYPE(stat.recvtype, recvtype);
+    DUMPI_COMM_FROM_MPI_COMM(stat.comm, comm);
+    DUMPI_START_TIME(cpu, wall);
+    DUMPI_STOP_OVERHEAD(DUMPI_Neighbor_allgather);
+  }
+  retval = PMPI_Neighbor_allgather(sendbuf, sendcount, sendtype, recvbuf, recvcount, recvtype, comm);
+  if(profiling) {
+    DUMPI_START_OVERHEAD(DUMPI_Neighbor_allgather);
+    DUMPI_STOP_TIME(cpu, wall);
+    libdumpi_lock_io();
+    dumpi_write_neighbor_allgather(&stat, thread, &cpu, &wall, dumpi_global->perf, dumpi_global->output, dumpi_global->profile);
+    libdumpi_unlock_io();
+    DUMPI_STOP_OVERHEAD(DUMPI_Neighbor_allgather);
+  }
+  DUMPI_FLUSH_POINT(comm);
+  DUMPI_INSERT_POSTAMBLE;
+  return retval;
+}
+#endif /* DUMPI_SKIP_MPI_NEIGHBOR_ALLGATHER */
+
+#ifndef DUMPI_SKIP_MPI_NEIGHBOR_ALLGATHERV
+int MPI_Neighbor_allgatherv(const void *sendbuf, int sendcount, MPI_Datatype sendtype, void *recvbuf, const int *recvcounts, const int *displs, MPI_Datatype recvtype, MPI_Comm comm) {
+  int16_t thread;
+  dumpi_time cpu, wall;
+  int retval;
+  dumpi_neighbor_allgatherv stat;
+  memset(&stat, 0, sizeof(dumpi_neighbor_allgatherv));
+  /* Extra declarations */
+  int indegree = 0, outdegree = 0;
+  thread = libdumpi_get_thread_id();
+  DUMPI_INSERT_PREAMBLE(DUMPI_Neighbor_allgatherv);
+  if(profiling || aggregating)
+    libdumpi_neighbor_degrees(comm, &indegree, &outdegree);
+  DUMPI_AGGREGATE_BYTES(libdumpi_bytes(sendcount, sendtype) * outdegree,
+			libdumpi_bytes_n(indegree, recvcounts, recvtype));
+  if(profiling) {
+    DUMPI_START_OVERHEAD(DUMPI_Neighbor_allgatherv);
+    DUMPI_INT_FROM_INT(stat.indegree, indegree);
+    DUMPI_INT_FROM_INT(stat.sendcount, sendcount);
+    DUMPI_DATATYPE_FROM_MPI_DATATYPE(stat.sendtype, sendtype);
+    DUMPI_INT_FROM_INT_ARRAY_1(indegree, stat.recvcounts, recvcounts);
+    DUMPI_INT_FROM_INT_ARRAY_1(indegree, stat.displs, displs);
+    DUMPI_DATATYPE_FROM_MPI_DATATYPE(stat.recvtype, recvtype);
+    DUMPI_COMM_FROM_MPI_COMM(stat.comm, comm);
+    DUMPI_START_TIME(cpu, wall);
+    DUMPI_STOP_OVERHEAD(DUMPI_Neighbor_allgatherv);
+  }
+  retval = PMPI_Neighbor_allgatherv(sendbuf, sendcount, sendtype, recvbuf, recvcounts, displs, recvtype, comm);
+  if(profiling) {
+    DUMPI_START_OVERHEAD(DUMPI_Neighbor_allgatherv);
+    DUMPI_STOP_TIME(cpu, wall);
+    libdumpi_lock_io();
+    dumpi_write_neighbor_allgatherv(&stat, thread, &cpu, &wall, dumpi_global->perf, dumpi_global->output, dumpi_global->profile);
+    libdumpi_unlock_io();
+    if(recvcounts != NULL) DUMPI_FREE_INT_FROM_INT(stat.recvcounts);
+    if(displs != NULL) DUMPI_FREE_INT_FROM_INT(stat.displs);
+    DUMPI_STOP_OVERHEAD(DUMPI_Neighbor_allgatherv);
+  }
+  DUMPI_FLUSH_POINT(comm);
+  DUMPI_INSERT_POSTAMBLE;
+  return retval;
+}
+#endif /* DUMPI_SKIP_MPI_NEIGHBOR_ALLGATHERV */
+
+#ifndef DUMPI_SKIP_MPI_NEIGHBOR_ALLTOALL
+int MPI_Neighbor_alltoall(const void *sendbuf, int sendcount, MPI_Datatype sendtype, void *recvbuf, int recvcount, MPI_Datatype recvtype, MPI_Comm comm) {
+  int16_t thread;
+  dumpi_time cpu, wall;
+  int retval;
+  dumpi_neighbor_alltoall stat;
+  memset(&stat, 0, sizeof(dumpi_neighbor_alltoall));
+  /* Extra declarations */
+  int indegree = 0, outdegree = 0;
+  thread = libdumpi_get_thread_id();
+  DUMPI_INSERT_PREAMBLE(DUMPI_Neighbor_alltoall);
+  if(aggregating) libdumpi_neighbor_degrees(comm, &indegree, &outdegree);
+  DUMPI_AGGREGATE_BYTES(libdumpi_bytes(sendcount, sendtype) * outdegree,
+			libdumpi_bytes(recvcount, recvtype) * indegree);
+  if(profiling) {
+    DUMPI_START_OVERHEAD(DUMPI_Neighbor_alltoall);
+    DUMPI_INT_FROM_INT(stat.sendcount, sendcount);
+    DUMPI_DATATYPE_FROM_MPI_DATATYPE(stat.sendtype, sendtype);
+    DUMPI_INT_FROM_INT(stat.recvcount, recvcount);
+    DUMPI_DATATYPE_FROM_MPI_DATATYPE(stat.recvtype, recvtype);
+    DUMPI_COMM_FROM_MPI_COMM(stat.comm, comm);
+    DUMPI_START_TIME(cpu, wall);
+    DUMPI_STOP_OVERHEAD(DUMPI_Neighbor_alltoall);
+  }
+  retval = PMPI_Neighbor_alltoall(sendbuf, sendcount, sendtype, recvbuf, recvcount, recvtype, comm);
+  if(profiling) {
+    DUMPI_START_OVERHEAD(DUMPI_Neighbor_alltoall);
+    DUMPI_STOP_TIME(cpu, wall);
+    libdumpi_lock_io();
+    dumpi_write_neighbor_alltoall(&stat, thread, &cpu, &wall, dumpi_global->perf, dumpi_global->output, dumpi_global->profile);
+    libdumpi_unlock_io();
+    DUMPI_STOP_OVERHEAD(DUMPI_Neighbor_alltoall);
+  }
+  DUMPI_FLUSH_POINT(comm);
+  DUMPI_INSERT_POSTAMBLE;
+  return retval;
+}
+#endif /* DUMPI_SKIP_MPI_NEIGHBOR_ALLTOALL */
+
+#ifndef DUMPI_SKIP_MPI_NEIGHBOR_ALLTOALLV
+int MPI_Neighbor_alltoallv(const void *sendbuf, const int *sendcounts, const int *senddispls, MPI_Datatype sendtype, void *recvbuf, const int *recvcounts, const int *recvdispls, MPI_Datatype recvtype, MPI_Comm comm) {
+  int16_t thread;
+  dumpi_time cpu, wall;
+  int retval;
+  dumpi_neighbor_alltoallv stat;
+  memset(&stat, 0, sizeof(dumpi_neighbor_alltoallv));
+  /* Extra declarations */
+  int indegree = 0, outdegree = 0;
+  thread = libdumpi_get_thread_id();
+  DUMPI_INSERT_PREAMBLE(DUMPI_Neighbor_alltoallv);
+  if(profiling || aggregating)
+    libdumpi_neighbor_degrees(comm, &indegree, &outdegree);
+  DUMPI_AGGREGATE_BYTES(libdumpi_bytes_n(outdegree, sendcounts, sendtype),
+			libdumpi_bytes_n(indegree, recvcounts, recvtype));
+  if(profiling) {
+    DUMPI_START_OVERHEAD(DUMPI_Neighbor_alltoallv);
+    DUMPI_INT_FROM_INT(stat.indegree, indegree);
+    DUMPI_INT_FROM_INT(stat.outdegree, outdegree);
+    DUMPI_INT_FROM_INT_ARRAY_1(outdegree, stat.sendcounts, sendcounts);
+    DUMPI_INT_FROM_INT_ARRAY_1(outdegree, stat.senddispls, senddispls);
+    DUMPI_DATATYPE_FROM_MPI_DATATYPE(stat.sendtype, sendtype);
+    DUMPI_INT_FROM_INT_ARRAY_1(indegree, stat.recvcounts, recvcounts);
+    DUMPI_INT_FROM_INT_ARRAY_1(indegree, stat.recvdispls, recvdispls);
+    DUMPI_DATATYPE_FROM_MPI_DATATYPE(stat.recvtype, recvtype);
+    DUMPI_COMM_FROM_MPI_COMM(stat.comm, comm);
+    DUMPI_START_TIME(cpu, wall);
+    DUMPI_STOP_OVERHEAD(DUMPI_Neighbor_alltoallv);
+  }
+  retval = PMPI_Neighbor_alltoallv(sendbuf, sendcounts, senddispls, sendtype, recvbuf, recvcounts, recvdispls, recvtype, comm);
+  if(profiling) {
+    DUMPI_START_OVERHEAD(DUMPI_Neighbor_alltoallv);
+    DUMPI_STOP_TIME(cpu, wall);
+    libdumpi_lock_io();
+    dumpi_write_neighbor_alltoallv(&stat, thread, &cpu, &wall, dumpi_global->perf, dumpi_global->output, dumpi_global->profile);
+    libdumpi_unlock_io();
+    if(sendcounts != NULL) DUMPI_FREE_INT_FROM_INT(stat.sendcounts);
+    if(senddispls != NULL) DUMPI_FREE_INT_FROM_INT(stat.senddispls);
+    if(recvcounts != NULL) DUMPI_FREE_INT_FROM_INT(stat.recvcounts);
+    if(recvdispls != NULL) DUMPI_FREE_INT_FROM_INT(stat.recvdispls);
+    DUMPI_STOP_OVERHEAD(DUMPI_Neighbor_alltoallv);
+  }
+  DUMPI_FLUSH_POINT(comm);
+  DUMPI_INSERT_POSTAMBLE;
+  return retval;
+}
+#endif /* DUMPI_SKIP_MPI_NEIGHBOR_ALLTOALLV */
+
+#ifndef DUMPI_SKIP_MPI_NEIGHBOR_ALLTOALLW
+int MPI_Neighbor_alltoallw(const void *sendbuf, const int *sendcounts, const MPI_Aint *senddispls, const MPI_Datatype *sendtypes, void *recvbuf, const int *recvcounts, const MPI_Aint *recvdispls, const MPI_Datatype *recvtypes, MPI_Comm comm) {
+  int16_t thread;
+  dumpi_time cpu, wall;
+  int retval;
+  dumpi_neighbor_alltoallw stat;
+  memset(&stat, 0, sizeof(dumpi_neighbor_alltoallw));
+  /* Extra declarations */
+  int indegree = 0, outdegree = 0;
+  thread = libdumpi_get_thread_id();
+  DUMPI_INSERT_PREAMBLE(DUMPI_Neighbor_alltoallw);
+  if(profiling || aggregating)
+    libdumpi_neighbor_degrees(comm, &indegree, &outdegree);
+  DUMPI_AGGREGATE_BYTES(libdumpi_bytes_nw(outdegree, sendcounts, sendtypes),
+			libdumpi_bytes_nw(indegree, recvcounts, recvtypes));
+  if(profiling) {
+    DUMPI_START_OVERHEAD(DUMPI_Neighbor_alltoallw);
+    DUMPI_INT_FROM_INT(stat.indegree, indegree);
+    DUMPI_INT_FROM_INT(stat.outdegree, outdegree);
+    DUMPI_INT_FROM_INT_ARRAY_1(outdegree, stat.sendcounts, sendcounts);
+    DUMPI_INT_FROM_MPI_AINT_ARRAY_1(outdegree, stat.senddispls, senddispls);
+    DUMPI_DATATYPE_FROM_MPI_DATATYPE_ARRAY_1(outdegree, stat.sendtypes, sendtypes);
+    DUMPI_INT_FROM_INT_ARRAY_1(indegree, stat.recvcounts, recvcounts);
+    DUMPI_INT_FROM_MPI_AINT_ARRAY_1(indegree, stat.recvdispls, recvdispls);
+    DUMPI_DATATYPE_FROM_MPI_DATATYPE_ARRAY_1(indegree, stat.recvtypes, recvtypes);
+    DUMPI_COMM_FROM_MPI_COMM(stat.comm, comm);
+    DUMPI_START_TIME(cpu, wall);
+    DUMPI_STOP_OVERHEAD(DUMPI_Neighbor_alltoallw);
+  }
+  retval = PMPI_Neighbor_alltoallw(sendbuf, sendcounts, senddispls, sendtypes, recvbuf, recvcounts, recvdispls, recvtypes, comm);
+  if(profiling) {
+    DUMPI_START_OVERHEAD(DUMPI_Neighbor_alltoallw);
+    DUMPI_STOP_TIME(cpu, wall);
+    libdumpi_lock_io();
+    dumpi_write_neighbor_alltoallw(&stat, thread, &cpu, &wall, dumpi_global->perf, dumpi_global->output, dumpi_global->profile);
+    libdumpi_unlock_io();
+    if(sendcounts != NULL) DUMPI_FREE_INT_FROM_INT(stat.sendcounts);
+    if(senddispls != NULL) DUMPI_FREE_INT_FROM_MPI_AINT(stat.senddispls);
+    if(sendtypes != NULL) DUMPI_FREE_DATATYPE_FROM_MPI_DATATYPE(stat.sendtypes);
+    if(recvcounts != NULL) DUMPI_FREE_INT_FROM_INT(stat.recvcounts);
+    if(recvdispls != NULL) DUMPI_FREE_INT_FROM_MPI_AINT(stat.recvdispls);
+    if(recvtypes != NULL) DUMPI_FREE_DATATYPE_FROM_MPI_DATATYPE(stat.recvtypes);
+    DUMPI_STOP_OVERHEAD(DUMPI_Neighbor_alltoallw);
+  }
+  DUMPI_FLUSH_POINT(comm);
+  DUMPI_INSERT_POSTAMBLE;
+  return retval;
+}
+#endif /* DUMPI_SKIP_MPI_NEIGHBOR_ALLTOALLW */
+
+#ifndef DUMPI_SKIP_MPI_MPROBE
+int MPI_Mprobe(int source, int tag, MPI_Comm comm, MPI_Message *message, MPI_Status *status) {
+  int16_t thread;
+  dumpi_time cpu, wall;
+  int retval;
+  dumpi_mprobe stat;
+  memset(&stat, 0, sizeof(dumpi_mprobe));
+  thread = libdumpi_get_thread_id();
+  DUMPI_INSERT_PREAMBLE(DUMPI_Mprobe);
+  if(profiling) {
+    DUMPI_START_OVERHEAD(DUMPI_Mprobe);
+    DUMPI_SOURCE_FROM_INT(stat.source, source);
+    DUMPI_TAG_FROM_INT(stat.tag, tag);
+    DUMPI_COMM_FROM_MPI_COMM(stat.comm, comm);
+    DUMPI_START_TIME(cpu, wall);
+    DUMPI_STOP_OVERHEAD(DUMPI_Mprobe);
+  }
+  retval = PMPI_Mprobe(source, tag, comm, message, status);
+  if(profiling) {
+    DUMPI_START_OVERHEAD(DUMPI_Mprobe);
+    DUMPI_STOP_TIME(cpu, wall);
+    DUMPI_MESSAGE_FROM_MPI_MESSAGE(stat.message, *message);
+    DUMPI_STATUS_FROM_MPI_STATUS_PTR(stat.status, status);
+    libdumpi_lock_io();
+    dumpi_write_mprobe(&stat, thread, &cpu, &wall, dumpi_global->perf, dumpi_global->output, dumpi_global->profile);
+    libdumpi_unlock_io();
+    if(status != NULL) DUMPI_FREE_STATUS_FROM_MPI_STATUS(stat.status);
+    DUMPI_STOP_OVERHEAD(DUMPI_Mprobe);
+  }
+  DUMPI_INSERT_POSTAMBLE;
+  return retval;
+}
+#endif /* DUMPI_SKIP_MPI_MPROBE */
+
+#ifndef DUMPI_SKIP_MPI_IMPROBE
+int MPI_Improbe(int source, int tag, MPI_Comm comm, int *flag, MPI_Message *message, MPI_Status *status) {
+  int16_t thread;
+  dumpi_time cpu, wall;
+  int retval;
+  dumpi_improbe stat;
+  int pollargs[3];
+  memset(&stat, 0, sizeof(dumpi_improbe));
+  thread = libdumpi_get_thread_id();
+  DUMPI_INSERT_PREAMBLE(DUMPI_Improbe);
+  if(profiling) {
+    DUMPI_START_OVERHEAD(DUMPI_Improbe);
+    DUMPI_SOURCE_FROM_INT(stat.source, source);
+    DUMPI_TAG_FROM_INT(stat.tag, tag);
+    DUMPI_COMM_FROM_MPI_COMM(stat.comm, comm);
+    DUMPI_START_TIME(cpu, wall);
+    DUMPI_STOP_OVERHEAD(DUMPI_Improbe);
+  }
+  retval = PMPI_Improbe(source, tag, comm, flag, message, status);
+  if(profiling) {
+    DUMPI_START_OVERHEAD(DUMPI_Improbe);
+    DUMPI_STOP_TIME(cpu, wall);
+    DUMPI_INT_FROM_INT(stat.flag, *flag);
+    stat.message = DUMPI_MESSAGE_NULL;
+    if(*flag != 0)    DUMPI_MESSAGE_FROM_MPI_MESSAGE(stat.message, *message);
+    if(*flag != 0)    DUMPI_STATUS_FROM_MPI_STATUS_PTR(stat.status, status);
+    pollargs[0] = stat.source; pollargs[1] = stat.tag; pollargs[2] = stat.comm;
+    if(! DUMPI_POLL_COALESCED(DUMPI_Improbe, stat.flag, 3, pollargs)) {
+      libdumpi_lock_io();
+      dumpi_write_improbe(&stat, thread, &cpu, &wall, dumpi_global->perf, dumpi_global->output, dumpi_global->profile);
+      libdumpi_unlock_io();
+    }
+    if(status != NULL) DUMPI_FREE_STATUS_FROM_MPI_STATUS(stat.status);
+    DUMPI_STOP_OVERHEAD(DUMPI_Improbe);
+  }
+  DUMPI_INSERT_POSTAMBLE;
+  return retval;
+}
+#endif /* DUMPI_SKIP_MPI_IMPROBE */
+
+#ifndef DUMPI_SKIP_MPI_MRECV
+int MPI_Mrecv(void *buf, int count, MPI_Datatype datatype, MPI_Message *message, MPI_Status *status) {
+  int16_t thread;
+  dumpi_time cpu, wall;
+  int retval;
+  dumpi_mrecv stat;
+  memset(&stat, 0, sizeof(dumpi_mrecv));
+  thread = libdumpi_get_thread_id();
+  DUMPI_INSERT_PREAMBLE(DUMPI_Mrecv);
+  DUMPI_AGGREGATE_BYTES(0, libdumpi_bytes(count, datatype));
+  if(profiling) {
+    DUMPI_START_OVERHEAD(DUMPI_Mrecv);
+    DUMPI_INT_FROM_INT(stat.count, count);
+    DUMPI_DATATYPE_FROM_MPI_DATATYPE(stat.datatype, datatype);
+    DUMPI_MESSAGE_FROM_MPI_MESSAGE(stat.message, *message);
+    DUMPI_START_TIME(cpu, wall);
+    DUMPI_STOP_OVERHEAD(DUMPI_Mrecv);
+  }
+  retval = PMPI_Mrecv(buf, count, datatype, message, status);
+  if(profiling) {
+    DUMPI_START_OVERHEAD(DUMPI_Mrecv);
+    DUMPI_STOP_TIME(cpu, wall);
+    DUMPI_STATUS_FROM_MPI_STATUS_PTR(stat.status, status);
+    libdumpi_lock_io();
+    dumpi_write_mrecv(&stat, thread, &cpu, &wall, dumpi_global->perf, dumpi_global->output, dumpi_global->profile);
+    libdumpi_unlock_io();
+    if(status != NULL) DUMPI_FREE_STATUS_FROM_MPI_STATUS(stat.status);
+    DUMPI_STOP_OVERHEAD(DUMPI_Mrecv);
+  }
+  DUMPI_INSERT_POSTAMBLE;
+  return retval;
+}
+#endif /* DUMPI_SKIP_MPI_MRECV */
+
+#ifndef DUMPI_SKIP_MPI_IMRECV
+int MPI_Imrecv(void *buf, int count, MPI_Datatype datatype, MPI_Message *message, MPI_Request *request) {
+  int16_t thread;
+  dumpi_time cpu, wall;
+  int retval;
+  dumpi_imrecv stat;
+  memset(&stat, 0, sizeof(dumpi_imrecv));
+  thread = libdumpi_get_thread_id();
+  DUMPI_INSERT_PREAMBLE(DUMPI_Imrecv);
+  DUMPI_AGGREGATE_BYTES(0, libdumpi_bytes(count, datatype));
+  if(profiling) {
+    DUMPI_START_OVERHEAD(DUMPI_Imrecv);
+    DUMPI_INT_FROM_INT(stat.count, count);
+    DUMPI_DATATYPE_FROM_MPI_DATATYPE(stat.datatype, datatype);
+    DUMPI_MESSAGE_FROM_MPI_MESSAGE(stat.message, *message);
+    DUMPI_START_TIME(cpu, wall);
+    DUMPI_STOP_OVERHEAD(DUMPI_Imrecv);
+  }
+  retval = PMPI_Imrecv(buf, count, datatype, message, request);
+  if(profiling) {
+    DUMPI_START_OVERHEAD(DUMPI_Imrecv);
+    DUMPI_STOP_TIME(cpu, wall);
+    DUMPI_REQUEST_FROM_MPI_REQUEST(stat.request, *request);
+    libdumpi_lock_io();
+    dumpi_write_imrecv(&stat, thread, &cpu, &wall, dumpi_global->perf, dumpi_global->output, dumpi_global->profile);
+    libdumpi_unlock_io();
+    DUMPI_STOP_OVERHEAD(DUMPI_Imrecv);
+  }
+  DUMPI_INSERT_POSTAMBLE;
+  return retval;
+}
+#endif /* DUMPI_SKIP_MPI_IMRECV */
+
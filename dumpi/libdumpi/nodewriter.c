@@ -0,0 +1,401 @@
+/*
+ *  This file is part of DUMPI:
+ *               The MPI profiling library from the SST suite.
+ *  Copyright (c) 2009-2011 Sandia Corporation.
+ *  This software is distributed under the BSD License.
+ *  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+ *  the U.S. Government retains certain rights in this software.
+ *  For more information, see the LICENSE file in the top
+ *  SST/macroscale directory.
+ */
+
+/* fopencookie */
+#define _GNU_SOURCE 1
+#include <dumpi/libdumpi/nodewriter.h>
+#include <dumpi/libdumpi/data.h>
+#include <dumpi/libdumpi/init.h>
+#include <dumpi/common/nodefile.h>
+#include <dumpi/common/io.h>
+#include <dumpi/dumpiconfig.h>
+#include <mpi.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <errno.h>
+#include <assert.h>
+
+#if defined(DUMPI_HAVE_FOPENCOOKIE) && defined(DUMPI_HAVE_SHM_OPEN) && \
+    defined(DUMPI_USE_PTHREADS) && MPI_VERSION >= 3
+#define NODE_FILES_SUPPORTED 1
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+/* Slots in the queue of a node */
+#ifndef DUMPI_NODE_QUEUE_SLOTS
+#define DUMPI_NODE_QUEUE_SLOTS 16
+#endif /* ! DUMPI_NODE_QUEUE_SLOTS */
+
+/* Smallest slot (a flush is split across slots) */
+#ifndef DUMPI_NODE_MIN_SLOT
+#define DUMPI_NODE_MIN_SLOT 65536
+#endif /* ! DUMPI_NODE_MIN_SLOT */
+
+/* Settings (from the configuration) */
+static size_t queue_size = (size_t)16 << 20;
+
+/* The node of each rank (rank 0 only, for the metafile) */
+static int node_count = 0;
+static int *rank_node = NULL;
+
+/* This rank's node file, and waits for a free slot */
+static char *node_name = NULL;
+static uint64_t stalls = 0;
+
+int libdumpi_node_queue_size(const char *value) {
+  return libdumpi_parse_size(value, &queue_size);
+}
+
+#ifdef NODE_FILES_SUPPORTED
+
+#define QLOCK(Q)   assert(pthread_mutex_lock(&(Q)->lock) == 0)
+#define QUNLOCK(Q) assert(pthread_mutex_unlock(&(Q)->lock) == 0)
+
+/* A chunk handed to the writer (ready once the data is copied in). */
+typedef struct node_slot {
+  int32_t  rank;
+  int32_t  ready;
+  uint64_t length;
+} node_slot;
+
+/* The queue of a node, at the start of the shared memory.  Slot data
+ * follows at data_offset. */
+typedef struct node_queue {
+  pthread_mutex_t lock;
+  /* A slot became ready, or a rank closed its stream */
+  pthread_cond_t  filled;
+  /* A slot was written out */
+  pthread_cond_t  drained;
+  /* Slots written out / handed out so far */
+  uint64_t        head, tail;
+  uint64_t        slot_size, data_offset;
+  /* Ranks on the node that have not closed their streams */
+  int32_t         writing;
+  node_slot       slot[DUMPI_NODE_QUEUE_SLOTS];
+} node_queue;
+
+/* The trace stream of this rank. */
+typedef struct rank_stream {
+  int      rank;
+  uint64_t pos;
+} rank_stream;
+
+static node_queue *queue = NULL;
+static size_t mapped = 0;
+/* Lowest rank on the node only */
+static dumpi_nodefile *nodefile = NULL;
+static pthread_t writer;
+
+static unsigned char* slot_data(uint64_t index) {
+  return ((unsigned char*)queue + queue->data_offset +
+	  (index % DUMPI_NODE_QUEUE_SLOTS) * queue->slot_size);
+}
+
+/* Append chunks to the node file until every rank is done. */
+static void* write_node_file(void *arg) {
+  node_slot *slot;
+  (void)arg;
+  QLOCK(queue);
+  for(;;) {
+    while(! (queue->head < queue->tail &&
+	     queue->slot[queue->head % DUMPI_NODE_QUEUE_SLOTS].ready) &&
+	  ! (queue->head == queue->tail && queue->writing == 0))
+      assert(pthread_cond_wait(&queue->filled, &queue->lock) == 0);
+    if(queue->head == queue->tail)
+      break;
+    slot = &queue->slot[queue->head % DUMPI_NODE_QUEUE_SLOTS];
+    QUNLOCK(queue);
+    dumpi_nodefile_append(nodefile, slot->rank, slot_data(queue->head),
+			  slot->length);
+    QLOCK(queue);
+    slot->ready = 0;
+    ++queue->head;
+    assert(pthread_cond_broadcast(&queue->drained) == 0);
+  }
+  QUNLOCK(queue);
+  return NULL;
+}
+
+static ssize_t stream_write(void *cookie, const char *buf, size_t size) {
+  rank_stream *stream = (rank_stream*)cookie;
+  size_t done = 0, bytes;
+  uint64_t index;
+  while(done < size) {
+    QLOCK(queue);
+    if(queue->tail - queue->head == DUMPI_NODE_QUEUE_SLOTS) {
+      ++stalls;
+      do {
+	assert(pthread_cond_wait(&queue->drained, &queue->lock) == 0);
+      } while(queue->tail - queue->head == DUMPI_NODE_QUEUE_SLOTS);
+    }
+    index = queue->tail++;
+    QUNLOCK(queue);
+    /* The slot is ours until it is marked ready */
+    bytes = size - done;
+    if(bytes > queue->slot_size)
+      bytes = queue->slot_size;
+    memcpy(slot_data(index), buf + done, bytes);
+    QLOCK(queue);
+    queue->slot[index % DUMPI_NODE_QUEUE_SLOTS].rank = stream->rank;
+    queue->slot[index % DUMPI_NODE_QUEUE_SLOTS].length = bytes;
+    queue->slot[index % DUMPI_NODE_QUEUE_SLOTS].ready = 1;
+    assert(pthread_cond_signal(&queue->filled) == 0);
+    QUNLOCK(queue);
+    done += bytes;
+  }
+  stream->pos += size;
+  return size;
+}
+
+/* Only tells the position (DUMPI_WRITE_TELL). */
+static int stream_seek(void *cookie, off64_t *offset, int whence) {
+  rank_stream *stream = (rank_stream*)cookie;
+  if((whence == SEEK_CUR && *offset == 0) ||
+     (whence == SEEK_SET && (uint64_t)*offset == stream->pos))
+  {
+    *offset = stream->pos;
+    return 0;
+  }
+  errno = ESPIPE;
+  return -1;
+}
+
+static int stream_close(void *cookie) {
+  QLOCK(queue);
+  --queue->writing;
+  assert(pthread_cond_signal(&queue->filled) == 0);
+  QUNLOCK(queue);
+  free(cookie);
+  return 0;
+}
+
+/* Create and map the queue (lowest rank on the node). */
+static int create_queue(const char *shmname, int writing, size_t slot_size) {
+  pthread_mutexattr_t mattr;
+  pthread_condattr_t cattr;
+  size_t data_offset = (sizeof(node_queue) + 4095) & ~(size_t)4095;
+  int fd = shm_open(shmname, O_RDWR | O_CREAT | O_EXCL, 0600);
+  mapped = data_offset + DUMPI_NODE_QUEUE_SLOTS * slot_size;
+  if(fd < 0)
+    return 0;
+  if(ftruncate(fd, mapped) != 0) {
+    close(fd);
+    shm_unlink(shmname);
+    return 0;
+  }
+  queue = (node_queue*)mmap(NULL, mapped, PROT_READ | PROT_WRITE,
+			    MAP_SHARED, fd, 0);
+  close(fd);
+  if(queue == MAP_FAILED) {
+    queue = NULL;
+    shm_unlink(shmname);
+    return 0;
+  }
+  memset(queue, 0, sizeof(node_queue));
+  assert(pthread_mutexattr_init(&mattr) == 0);
+  assert(pthread_mutexattr_setpshared(&mattr, PTHREAD_PROCESS_SHARED) == 0);
+  assert(pthread_mutex_init(&queue->lock, &mattr) == 0);
+  pthread_mutexattr_destroy(&mattr);
+  assert(pthread_condattr_init(&cattr) == 0);
+  assert(pthread_condattr_setpshared(&cattr, PTHREAD_PROCESS_SHARED) == 0);
+  assert(pthread_cond_init(&queue->filled, &cattr) == 0);
+  assert(pthread_cond_init(&queue->drained, &cattr) == 0);
+  pthread_condattr_destroy(&cattr);
+  queue->slot_size = slot_size;
+  queue->data_offset = data_offset;
+  queue->writing = writing;
+  return 1;
+}
+
+/* Map the queue created by the lowest rank on the node. */
+static int attach_queue(const char *shmname, size_t slot_size) {
+  size_t data_offset = (sizeof(node_queue) + 4095) & ~(size_t)4095;
+  int fd = shm_open(shmname, O_RDWR, 0600);
+  mapped = data_offset + DUMPI_NODE_QUEUE_SLOTS * slot_size;
+  if(fd < 0)
+    return 0;
+  queue = (node_queue*)mmap(NULL, mapped, PROT_READ | PROT_WRITE,
+			    MAP_SHARED, fd, 0);
+  close(fd);
+  if(queue == MAP_FAILED) {
+    queue = NULL;
+    return 0;
+  }
+  return 1;
+}
+
+DUMPIFILE libdumpi_nodewriter_open(char **name) {
+  static const cookie_io_functions_t funcs = {
+    NULL, stream_write, stream_seek, stream_close
+  };
+  MPI_Comm node, leaders;
+  int node_rank, node_size, ok, all_ok;
+  /* node index, node count, pid of the lowest rank */
+  long info[3] = {0, 0, 0};
+  size_t slot_size = queue_size / DUMPI_NODE_QUEUE_SLOTS;
+  char shmname[64], *fname;
+  rank_stream *stream;
+  DUMPIFILE fp;
+  if(slot_size < DUMPI_NODE_MIN_SLOT)
+    slot_size = DUMPI_NODE_MIN_SLOT;
+  assert(PMPI_Comm_split_type(MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED, 0,
+			      MPI_INFO_NULL, &node) == MPI_SUCCESS);
+  PMPI_Comm_rank(node, &node_rank);
+  PMPI_Comm_size(node, &node_size);
+  assert(PMPI_Comm_split(MPI_COMM_WORLD, (node_rank == 0 ? 0 : MPI_UNDEFINED),
+			 dumpi_global->comm_rank, &leaders) == MPI_SUCCESS);
+  if(node_rank == 0) {
+    int index, count;
+    PMPI_Comm_rank(leaders, &index);
+    PMPI_Comm_size(leaders, &count);
+    PMPI_Comm_free(&leaders);
+    info[0] = index;
+    info[1] = count;
+    info[2] = (long)getpid();
+  }
+  PMPI_Bcast(info, 3, MPI_LONG, 0, node);
+  snprintf(shmname, sizeof(shmname), "/dumpi-%ld-%ld", info[2], info[0]);
+  fname = (char*)malloc(strlen(dumpi_global->file_root) + 64);
+  assert(fname != NULL);
+  sprintf(fname, "%s-node%04ld.bin", dumpi_global->file_root, info[0]);
+  /* The lowest rank sets up the queue and the file, the others attach */
+  if(node_rank == 0) {
+    ok = create_queue(shmname, node_size, slot_size);
+    if(ok && (nodefile = dumpi_nodefile_create(fname)) == NULL)
+      ok = 0;
+  }
+  PMPI_Bcast(&ok, 1, MPI_INT, 0, node);
+  if(ok && node_rank != 0)
+    ok = attach_queue(shmname, slot_size);
+  /* Every rank has attached (or failed to) once this completes */
+  PMPI_Allreduce(&ok, &all_ok, 1, MPI_INT, MPI_MIN, MPI_COMM_WORLD);
+  if(node_rank == 0 && queue != NULL)
+    shm_unlink(shmname);
+  if(! all_ok) {
+    if(dumpi_global->comm_rank == 0)
+      fprintf(stderr, "DUMPI:  node-files:  Failed to set up the queue of "
+	      "a node; writing one trace file per rank.\n");
+    if(queue != NULL)
+      munmap(queue, mapped);
+    queue = NULL;
+    if(nodefile != NULL) {
+      dumpi_nodefile_close(nodefile);
+      unlink(fname);
+      nodefile = NULL;
+    }
+    PMPI_Comm_free(&node);
+    free(fname);
+    return NULL;
+  }
+  if(node_rank == 0)
+    assert(pthread_create(&writer, NULL, write_node_file, NULL) == 0);
+  /* The directory for the metafile */
+  if(dumpi_global->comm_rank == 0) {
+    node_count = (int)info[1];
+    rank_node = (int*)malloc(dumpi_global->comm_size * sizeof(int));
+    assert(rank_node != NULL);
+  }
+  {
+    int index = (int)info[0];
+    PMPI_Gather(&index, 1, MPI_INT, rank_node, 1, MPI_INT, 0, MPI_COMM_WORLD);
+  }
+  PMPI_Comm_free(&node);
+  node_name = fname;
+  *name = (char*)malloc(strlen(fname) + 16);
+  assert(*name != NULL);
+  sprintf(*name, "%s@%d", fname, dumpi_global->comm_rank);
+  stream = (rank_stream*)calloc(1, sizeof(rank_stream));
+  assert(stream != NULL);
+  stream->rank = dumpi_global->comm_rank;
+  fp = fopencookie(stream, "w", funcs);
+  assert(fp != NULL);
+  /* The trace buffer does the buffering */
+  setvbuf(fp, NULL, _IONBF, 0);
+  return fp;
+}
+
+void libdumpi_nodewriter_finish(void) {
+  if(queue == NULL)
+    return;
+  if(nodefile != NULL) {
+    assert(pthread_join(writer, NULL) == 0);
+    dumpi_nodefile_close(nodefile);
+    nodefile = NULL;
+  }
+  munmap(queue, mapped);
+  queue = NULL;
+}
+
+#else /* ! NODE_FILES_SUPPORTED */
+
+DUMPIFILE libdumpi_nodewriter_open(char **name) {
+  (void)name;
+  if(dumpi_global->comm_rank == 0)
+    fprintf(stderr, "DUMPI:  node-files:  Not supported by this build "
+	    "(needs MPI-3, pthreads, shm_open, and fopencookie); writing "
+	    "one trace file per rank.\n");
+  return NULL;
+}
+
+void libdumpi_nodewriter_finish(void) {
+}
+
+#endif /* ! NODE_FILES_SUPPORTED */
+
+/* List the ranks of each node as ranges, e.g. node3=96-127 */
+void libdumpi_nodewriter_write_meta(FILE *meta) {
+  int *first, *order, node, rank, pos, end, sep;
+  if(rank_node == NULL)
+    return;
+  /* Sort the ranks by node (stable, so ascending within a node) */
+  first = (int*)calloc(node_count + 1, sizeof(int));
+  order = (int*)malloc(dumpi_global->comm_size * sizeof(int));
+  assert(first != NULL && order != NULL);
+  for(rank = 0; rank < dumpi_global->comm_size; ++rank)
+    ++first[rank_node[rank] + 1];
+  for(node = 0; node < node_count; ++node)
+    first[node + 1] += first[node];
+  for(rank = 0; rank < dumpi_global->comm_size; ++rank)
+    order[first[rank_node[rank]]++] = rank;
+  fprintf(meta, "nodefiles=%d\n", node_count);
+  for(node = 0, pos = 0; node < node_count; ++node) {
+    fprintf(meta, "node%d=", node);
+    for(sep = 0; pos < first[node]; ++pos, sep = 1) {
+      end = pos;
+      while(end + 1 < first[node] && order[end + 1] == order[end] + 1)
+	++end;
+      fprintf(meta, (sep ? ",%d" : "%d"), order[pos]);
+      if(end > pos)
+	fprintf(meta, "-%d", order[end]);
+      pos = end;
+    }
+    fprintf(meta, "\n");
+  }
+  free(first);
+  free(order);
+  free(rank_node);
+  rank_node = NULL;
+}
+
+void libdumpi_nodewriter_record(void) {
+  char val[64];
+  if(node_name == NULL || dumpi_global->keyval == NULL)
+    return;
+  dumpi_push_keyval_entry(dumpi_global->keyval, "node-file", node_name);
+  snprintf(val, sizeof(val), "%llu", (unsigned long long)stalls);
+  dumpi_push_keyval_entry(dumpi_global->keyval, "node-queue-stalls", val);
+}
@@ -0,0 +1,77 @@
+/*
+ *  This file is part of DUMPI:
+ *               The MPI profiling library from the SST suite.
+ *  Copyright (c) 2009-2011 Sandia Corporation.
+ *  This software is distributed under the BSD License.
+ *  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+ *  the U.S. Government retains certain rights in this software.
+ *  For more information, see the LICENSE file in the top
+ *  SST/macroscale directory.
+ */
+
+#ifndef DUMPI_LIBDUMPI_NODEWRITER_H
+#define DUMPI_LIBDUMPI_NODEWRITER_H
+
+#include <dumpi/common/types.h>
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* ! __cplusplus */
+
+  /**
+   * \addtogroup libdumpi_internal
+   */
+  /*@{*/
+
+  /**
+   * Set the size of the shared-memory queue of each node
+   * (node-queue-size, in megabytes or with a K or M suffix).
+   * \return non-zero if the value was valid.
+   */
+  int libdumpi_node_queue_size(const char *value);
+
+  /**
+   * Open the trace stream of this rank in the node file of its node
+   * (node-files enable).  Collective over MPI_COMM_WORLD.
+   *
+   * The ranks sharing a node (MPI_Comm_split_type with
+   * MPI_COMM_TYPE_SHARED) hand their flushed buffers to a queue in
+   * POSIX shared memory, and a thread of the lowest rank on the node
+   * appends them to fileroot-nodeNNNN.bin (see nodefile.h).  The queue
+   * outlives MPI, so the trailer written after MPI_Finalize goes the
+   * same way.
+   * \param name  set to the name the stream is read back with
+   *              (fileroot-nodeNNNN.bin@rank).
+   * \return the stream, or NULL if node files are not supported or could
+   *         not be set up on every node (all ranks then write their own
+   *         trace file).
+   */
+  DUMPIFILE libdumpi_nodewriter_open(char **name);
+
+  /**
+   * Wait until every rank on the node has closed its stream and close
+   * the node file (on the lowest rank of the node), then release the
+   * queue.  Call after the trace stream was closed.
+   */
+  void libdumpi_nodewriter_finish(void);
+
+  /**
+   * Write the directory of node files to the metafile (rank 0 only):
+   * nodefiles=count, and nodeK=ranks for each node.
+   */
+  void libdumpi_nodewriter_write_meta(FILE *meta);
+
+  /**
+   * Note the node file and the number of waits for a free queue slot in
+   * the keyval record.
+   */
+  void libdumpi_nodewriter_record(void);
+
+  /*@}*/
+
+#ifdef __cplusplus
+} /* end of extern "C" */
+#endif /* ! __cplusplus */
+
+#endif /* ! DUMPI_LIBDUMPI_NODEWRITER_H */
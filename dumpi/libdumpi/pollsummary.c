@@ -0,0 +1,145 @@
+/*
+ *  This file is part of DUMPI:
+ *               The MPI profiling library from the SST suite.
+ *  Copyright (c) 2009-2011 Sandia Corporation.
+ *  This software is distributed under the BSD License.
+ *  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+ *  the U.S. Government retains certain rights in this software.
+ *  For more information, see the LICENSE file in the top
+ *  SST/macroscale directory.
+ */
+
+#include <dumpi/libdumpi/pollsummary.h>
+#include <dumpi/libdumpi/mpibindings-utils.h>
+#include <dumpi/libdumpi/data.h>
+#include <dumpi/common/dumpiio.h>
+#include <dumpi/common/funcs.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+/* The functions that call DUMPI_POLL_COALESCED */
+static const dumpi_function poll_functions[] = {
+  DUMPI_Iprobe, DUMPI_Improbe, DUMPI_Test, DUMPI_Testany
+};
+
+/* Write the run (the caller holds the io lock). */
+static void write_run(libdumpi_poll_run *run) {
+  dumpi_poll_summary summary;
+  if(! run->active)
+    return;
+  run->active = 0;
+  /* Threads can outlive the trace; their runs are simply dropped. */
+  if(dumpi_global == NULL || dumpi_global->profile == NULL)
+    return;
+  summary.function = (int16_t)run->function;
+  summary.count = run->count;
+  summary.incall_wall = run->incall_wall;
+  summary.incall_cpu = run->incall_cpu;
+  summary.argcount = run->argcount;
+  summary.args = run->args;
+  dumpi_write_poll_summary(&summary, run->thread, &run->cpu, &run->wall,
+			   NULL, dumpi_global->output, dumpi_global->profile);
+}
+
+/* Start a new run with a single call. */
+static void open_run(libdumpi_poll_run *run, dumpi_function func,
+		     int argcount, const int *args, uint16_t thread,
+		     const dumpi_time *cpu, const dumpi_time *wall)
+{
+  if(argcount > run->argcapacity) {
+    run->args = (int*)realloc(run->args, argcount*sizeof(int));
+    assert(run->args != NULL);
+    run->argcapacity = argcount;
+  }
+  if(argcount > 0)
+    memcpy(run->args, args, argcount*sizeof(int));
+  run->argcount = argcount;
+  run->function = func;
+  run->thread = thread;
+  run->count = 1;
+  run->cpu = *cpu;
+  run->wall = *wall;
+  run->incall_cpu.sec = run->incall_cpu.nsec = 0;
+  run->incall_wall.sec = run->incall_wall.nsec = 0;
+  dumpi_clock_accumulate(&run->incall_cpu, &cpu->start, &cpu->stop);
+  dumpi_clock_accumulate(&run->incall_wall, &wall->start, &wall->stop);
+  run->active = 1;
+}
+
+/* Test whether a call continues the open run. */
+static int same_run(const libdumpi_poll_run *run, dumpi_function func,
+		    int argcount, const int *args)
+{
+  return (run->active && run->function == func &&
+	  run->argcount == argcount &&
+	  (argcount == 0 ||
+	   memcmp(run->args, args, argcount*sizeof(int)) == 0));
+}
+
+/* Fold an unsuccessful polling call into this thread's run. */
+int libdumpi_poll_coalesce(dumpi_function func, int flag,
+			   int argcount, const int *args, uint16_t thread,
+			   const dumpi_time *cpu, const dumpi_time *wall)
+{
+  libdumpi_poll_run *run = libdumpi_get_poll_run();
+  if(flag == 0 && same_run(run, func, argcount, args)) {
+    /* The common case only touches this thread's state. */
+    ++run->count;
+    run->cpu.stop = cpu->stop;
+    run->wall.stop = wall->stop;
+    dumpi_clock_accumulate(&run->incall_cpu, &cpu->start, &cpu->stop);
+    dumpi_clock_accumulate(&run->incall_wall, &wall->start, &wall->stop);
+    return 1;
+  }
+  if(run->active) {
+    libdumpi_lock_io();
+    write_run(run);
+    libdumpi_unlock_io();
+  }
+  if(flag != 0)
+    return 0;
+  open_run(run, func, argcount, args, thread, cpu, wall);
+  return 1;
+}
+
+/* Close this thread's run on entry to a different MPI function. */
+void libdumpi_poll_interrupt(dumpi_function func) {
+  libdumpi_poll_run *run = libdumpi_get_poll_run();
+  if(run->active && run->function != func)
+    libdumpi_poll_close(run);
+}
+
+/* Write the run (if open) and mark it closed. */
+void libdumpi_poll_close(libdumpi_poll_run *run) {
+  if(run->active) {
+    libdumpi_lock_io();
+    write_run(run);
+    libdumpi_unlock_io();
+  }
+}
+
+/* Close the runs of every thread. */
+void libdumpi_poll_close_all(void) {
+  libdumpi_lock_io();
+  libdumpi_foreach_poll_run(write_run);
+  libdumpi_unlock_io();
+}
+
+/* Polls are counted by their summary records, not sampled. */
+void libdumpi_poll_exempt_sampling(void) {
+  size_t i;
+  int func;
+  for(i = 0; i < sizeof(poll_functions)/sizeof(poll_functions[0]); ++i) {
+    if(dumpi_global->sample_period[poll_functions[i]] != 0) {
+      fprintf(stderr, "dumpi:  Not sampling %s since coalesce-polls is "
+	      "enabled\n", dumpi_function_names[poll_functions[i]]);
+      dumpi_global->sample_period[poll_functions[i]] = 0;
+    }
+  }
+  dumpi_global->sampling = 0;
+  for(func = 0; func < DUMPI_ALL_FUNCTIONS; ++func)
+    if(dumpi_global->sample_period[func] != 0)
+      dumpi_global->sampling = 1;
+}
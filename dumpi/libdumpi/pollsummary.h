@@ -0,0 +1,93 @@
+/*
+ *  This file is part of DUMPI:
+ *               The MPI profiling library from the SST suite.
+ *  Copyright (c) 2009-2011 Sandia Corporation.
+ *  This software is distributed under the BSD License.
+ *  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+ *  the U.S. Government retains certain rights in this software.
+ *  For more information, see the LICENSE file in the top
+ *  SST/macroscale directory.
+ */
+
+#ifndef DUMPI_LIBDUMPI_POLLSUMMARY_H
+#define DUMPI_LIBDUMPI_POLLSUMMARY_H
+
+#include <dumpi/common/types.h>
+#include <dumpi/common/funclabels.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* ! __cplusplus */
+
+  /**
+   * \addtogroup libdumpi_internal
+   */
+  /*@{*/
+
+  /**
+   * A run of unsuccessful polling calls that has not been written yet.
+   * Each thread keeps one of these (see libdumpi_get_poll_run).
+   */
+  typedef struct libdumpi_poll_run {
+    /** Non-zero while a run is open */
+    int            active;
+    /** The polling function (MPI_Iprobe, MPI_Improbe, MPI_Test, or
+        MPI_Testany) */
+    dumpi_function function;
+    /** Thread that made the calls */
+    uint16_t       thread;
+    /** Number of calls in the run */
+    uint32_t       count;
+    /** Start of the first call and end of the last call */
+    dumpi_time     cpu, wall;
+    /** Time accumulated inside the calls */
+    dumpi_clock    incall_cpu, incall_wall;
+    /** Arguments shared by all calls in the run */
+    int            argcount;
+    int            argcapacity;
+    int           *args;
+  } libdumpi_poll_run;
+
+  /**
+   * Fold an unsuccessful polling call into the calling thread's run.
+   * A call whose arguments differ from the open run closes that run
+   * and starts a new one.  A successful call (flag != 0) closes the run
+   * and is left for the caller to write as a regular record.
+   * \return non-zero if the call was absorbed into a run.
+   */
+  int libdumpi_poll_coalesce(dumpi_function func, int flag,
+			     int argcount, const int *args, uint16_t thread,
+			     const dumpi_time *cpu, const dumpi_time *wall);
+
+  /**
+   * Close the calling thread's run (if any) because a different MPI
+   * function is being called.  Used by DUMPI_INSERT_PREAMBLE.
+   */
+  void libdumpi_poll_interrupt(dumpi_function func);
+
+  /**
+   * Write the given run as a poll summary record (if it is open)
+   * and mark it closed.
+   */
+  void libdumpi_poll_close(libdumpi_poll_run *run);
+
+  /**
+   * Close the runs of every thread.  Called before the trace is finalized.
+   */
+  void libdumpi_poll_close_all(void);
+
+  /**
+   * Drop the sampling setting of every polling function.  A poll summary
+   * counts each call of its run, so polls can't be sampled out once they
+   * are coalesced.  Called at startup when coalesce-polls is enabled.
+   */
+  void libdumpi_poll_exempt_sampling(void);
+
+  /*@}*/
+
+#ifdef __cplusplus
+} /* end of extern "C" */
+#endif /* ! __cplusplus */
+
+#endif /* ! DUMPI_LIBDUMPI_POLLSUMMARY_H */
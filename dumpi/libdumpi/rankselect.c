@@ -0,0 +1,281 @@
+/*
+ *  This file is part of DUMPI:
+ *               The MPI profiling library from the SST suite.
+ *  Copyright (c) 2009-2011 Sandia Corporation.
+ *  This software is distributed under the BSD License.
+ *  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+ *  the U.S. Government retains certain rights in this software.
+ *  For more information, see the LICENSE file in the top
+ *  SST/macroscale directory.
+ */
+
+#include <dumpi/libdumpi/rankselect.h>
+#include <dumpi/libdumpi/aggregate.h>
+#include <dumpi/libdumpi/data.h>
+#include <dumpi/common/io.h>
+#include <mpi.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+/* The configured selection (NULL if every rank is traced). */
+static char *selection = NULL;
+static uint64_t seed = 0;
+
+/* Where the calling rank lives (filled in by libdumpi_rankselect_apply). */
+typedef struct rank_info {
+  int  rank, size;
+  /* Non-zero for the lowest rank on the node */
+  int  node_leader;
+  char host[MPI_MAX_PROCESSOR_NAME+1];
+} rank_info;
+
+/* Per-rank flags gathered to rank 0 for the metafile. */
+static char *traced_ranks = NULL;
+static int traced_count = 0;
+
+/* A well-mixed 64-bit hash (splitmix64 finalizer). */
+static uint64_t mix64(uint64_t x) {
+  x += 0x9e3779b97f4a7c15ull;
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+  return x ^ (x >> 31);
+}
+
+/* Test one item of the selection against a rank.
+ * Returns -1 if the item is invalid. */
+static int match_item(const char *item, const rank_info *info) {
+  char *end;
+  long first, last, stride = 1;
+  if(strcmp(item, "all") == 0)
+    return 1;
+  if(strcmp(item, "per-node") == 0)
+    return info->node_leader;
+  if(strncmp(item, "node:", 5) == 0)
+    return (item[5] != '\0' && strcmp(item+5, info->host) == 0);
+  if(strncmp(item, "random:", 7) == 0) {
+    double fraction = strtod(item+7, &end);
+    uint64_t draw;
+    if(end == item+7 || *end != '\0' || fraction < 0 || fraction > 1)
+      return -1;
+    draw = mix64(seed ^ mix64((uint64_t)info->rank));
+    return ((double)(draw >> 11) * (1.0 / 9007199254740992.0) < fraction);
+  }
+  first = strtol(item, &end, 10);
+  if(end == item || first < 0)
+    return -1;
+  last = first;
+  if(*end == '-') {
+    const char *start = end+1;
+    last = strtol(start, &end, 10);
+    if(end == start)
+      last = (info->size > 0 ? info->size - 1 : first);
+    if(*end == ':') {
+      start = end+1;
+      stride = strtol(start, &end, 10);
+      if(end == start || stride <= 0)
+	return -1;
+    }
+  }
+  if(*end != '\0')
+    return -1;
+  return (info->rank >= first && info->rank <= last &&
+	  (info->rank - first) % stride == 0);
+}
+
+/* Test the whole selection against a rank.
+ * Returns -1 (after complaining) if any item is invalid. */
+static int match_selection(const char *value, const rank_info *info) {
+  char *copy, *item, *save;
+  int selected = 0, match;
+  copy = strdup(value);
+  assert(copy != NULL);
+  for(item = strtok_r(copy, ",", &save); item != NULL;
+      item = strtok_r(NULL, ",", &save))
+  {
+    if((match = match_item(item, info)) < 0) {
+      fprintf(stderr, "dumpi:  Invalid item \"%s\" in trace-ranks %s\n",
+	      item, value);
+      selected = -1;
+      break;
+    }
+    selected |= match;
+  }
+  free(copy);
+  return selected;
+}
+
+/* Set the selection. */
+int libdumpi_rankselect_set(const char *value) {
+  rank_info info;
+  memset(&info, 0, sizeof(rank_info));
+  if(match_selection(value, &info) < 0)
+    return 0;
+  free(selection);
+  selection = strdup(value);
+  assert(selection != NULL);
+  return 1;
+}
+
+/* Set the seed for random selections. */
+void libdumpi_rankselect_seed(uint64_t value) {
+  seed = value;
+}
+
+#if MPI_VERSION < 3
+/* Group the ranks by processor name (for MPI-2, which has no
+ * MPI_Comm_split_type).  A hash of the name splits most nodes apart;
+ * hosts that share a hash are then told apart by the full name, one
+ * host at a time. */
+static MPI_Comm split_by_host(const rank_info *info) {
+  uint32_t hash = 2166136261u;
+  const char *c;
+  char first[MPI_MAX_PROCESSOR_NAME+1];
+  int same;
+  MPI_Comm group, host;
+  for(c = info->host; *c; ++c)
+    hash = (hash ^ (unsigned char)*c) * 16777619u;
+  PMPI_Comm_split(MPI_COMM_WORLD, (int)(hash & 0x7fffffff), info->rank,
+		  &group);
+  for(;;) {
+    memcpy(first, info->host, sizeof(first));
+    PMPI_Bcast(first, sizeof(first), MPI_CHAR, 0, group);
+    same = (strcmp(first, info->host) == 0);
+    PMPI_Comm_split(group, (same ? 0 : 1), info->rank, &host);
+    PMPI_Comm_free(&group);
+    if(same)
+      return host;
+    group = host;
+  }
+}
+#endif /* MPI_VERSION < 3 */
+
+/* Find the lowest rank on the calling rank's node. */
+static int find_node_leader(const rank_info *info) {
+  int node_rank = 0;
+  MPI_Comm node;
+#if MPI_VERSION >= 3
+  PMPI_Comm_split_type(MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED, info->rank,
+		       MPI_INFO_NULL, &node);
+#else
+  node = split_by_host(info);
+#endif /* MPI_VERSION >= 3 */
+  PMPI_Comm_rank(node, &node_rank);
+  PMPI_Comm_free(&node);
+  return (node_rank == 0);
+}
+
+/* Decide whether the calling rank is traced. */
+void libdumpi_rankselect_apply(void) {
+  rank_info info;
+  int len = 0, selected;
+  char flag;
+  if(selection == NULL)
+    return;
+  memset(&info, 0, sizeof(rank_info));
+  PMPI_Comm_rank(MPI_COMM_WORLD, &info.rank);
+  PMPI_Comm_size(MPI_COMM_WORLD, &info.size);
+  PMPI_Get_processor_name(info.host, &len);
+  info.host[len] = '\0';
+  /* Every rank sees the same selection, so all of them get here */
+  if(strstr(selection, "per-node") != NULL)
+    info.node_leader = find_node_leader(&info);
+  selected = (match_selection(selection, &info) > 0);
+  flag = (char)selected;
+  if(info.rank == 0) {
+    traced_ranks = (char*)malloc(info.size);
+    assert(traced_ranks != NULL);
+    traced_count = info.size;
+  }
+  PMPI_Gather(&flag, 1, MPI_CHAR, traced_ranks, 1, MPI_CHAR,
+	      0, MPI_COMM_WORLD);
+  if(selected)
+    return;
+  dumpi_global->untraced = 1;
+  /* Only MPI calls that describe communicators, groups, and types */
+  dumpi_global->output->function[DUMPI_Function_enter] = DUMPI_DISABLE;
+  dumpi_global->output->function[DUMPI_Function_exit] = DUMPI_DISABLE;
+  dumpi_global->output->function[DUMPI_Function_call] = DUMPI_DISABLE;
+  dumpi_global->coalesce_polls = 0;
+  if(dumpi_global->untraced_profile)
+    libdumpi_aggregate_start();
+}
+
+/* Calls recorded by untraced ranks (the ones dumpistats and friends
+ * replay to rebuild communicators and datatypes).  Keep this list in step
+ * with the preparse callbacks in trace::setup_callbacks (bin/trace.cc). */
+int libdumpi_rankselect_skeleton(dumpi_function func) {
+  switch(func) {
+  case DUMPI_Init:
+  case DUMPI_Init_thread:
+  case DUMPI_Finalize:
+  case DUMPI_Abort:
+  case DUMPI_Comm_dup:
+  case DUMPI_Comm_create:
+  case DUMPI_Comm_split:
+  case DUMPI_Cart_create:
+  case DUMPI_Graph_create:
+  case DUMPI_Dist_graph_create_adjacent:
+  case DUMPI_Comm_group:
+  case DUMPI_Comm_free:
+  case DUMPI_Group_union:
+  case DUMPI_Group_intersection:
+  case DUMPI_Group_difference:
+  case DUMPI_Group_incl:
+  case DUMPI_Group_excl:
+  case DUMPI_Group_range_incl:
+  case DUMPI_Group_range_excl:
+  case DUMPI_Group_free:
+  case DUMPI_Type_contiguous:
+  case DUMPI_Type_vector:
+  case DUMPI_Type_hvector:
+  case DUMPI_Type_indexed:
+  case DUMPI_Type_hindexed:
+  case DUMPI_Type_struct:
+  case DUMPI_Type_dup:
+  case DUMPI_Type_create_darray:
+  case DUMPI_Type_create_hindexed:
+  case DUMPI_Type_create_hvector:
+  case DUMPI_Type_create_indexed_block:
+  case DUMPI_Type_create_resized:
+  case DUMPI_Type_create_struct:
+  case DUMPI_Type_create_subarray:
+  case DUMPI_Type_commit:
+  case DUMPI_Type_free:
+    return 1;
+  default:
+    return 0;
+  }
+}
+
+/* Write the traced ranks as a list of ranges, e.g. traced=0-3,256,512 */
+void libdumpi_rankselect_write_meta(FILE *meta) {
+  int rank, first, sep = 0;
+  if(traced_ranks == NULL)
+    return;
+  fprintf(meta, "traced=");
+  for(rank = 0; rank < traced_count; ++rank) {
+    if(! traced_ranks[rank])
+      continue;
+    first = rank;
+    while(rank+1 < traced_count && traced_ranks[rank+1])
+      ++rank;
+    fprintf(meta, (sep ? ",%d" : "%d"), first);
+    if(rank > first)
+      fprintf(meta, "-%d", rank);
+    sep = 1;
+  }
+  fprintf(meta, "\nuntraced=%s\n",
+	  (dumpi_global->untraced_profile ? "profile" : "footer"));
+  free(traced_ranks);
+  traced_ranks = NULL;
+}
+
+/* Record the selection in the keyval record. */
+void libdumpi_rankselect_record(void) {
+  if(selection == NULL || dumpi_global->keyval == NULL)
+    return;
+  dumpi_push_keyval_entry(dumpi_global->keyval, "trace-ranks", selection);
+  dumpi_push_keyval_entry(dumpi_global->keyval, "traced",
+			  (dumpi_global->untraced ? "no" : "yes"));
+}
@@ -0,0 +1,78 @@
+/*
+ *  This file is part of DUMPI:
+ *               The MPI profiling library from the SST suite.
+ *  Copyright (c) 2009-2011 Sandia Corporation.
+ *  This software is distributed under the BSD License.
+ *  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+ *  the U.S. Government retains certain rights in this software.
+ *  For more information, see the LICENSE file in the top
+ *  SST/macroscale directory.
+ */
+
+#ifndef DUMPI_LIBDUMPI_RANKSELECT_H
+#define DUMPI_LIBDUMPI_RANKSELECT_H
+
+#include <dumpi/common/funclabels.h>
+#include <stdio.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* ! __cplusplus */
+
+  /**
+   * \addtogroup libdumpi_internal
+   */
+  /*@{*/
+
+  /**
+   * Set the ranks that write a full trace (trace-ranks).  The value is a
+   * comma-separated list of items, each of which selects:
+   *   - N          rank N;
+   *   - A-B[:S]    every S-th rank from A to B (B may be omitted for
+   *                the last rank);
+   *   - random:F   a fraction F of the ranks (see libdumpi_rankselect_seed);
+   *   - per-node   the lowest rank on each node;
+   *   - node:HOST  all ranks on the node whose processor name is HOST;
+   *   - all        every rank.
+   * \return non-zero if the value was valid.
+   */
+  int libdumpi_rankselect_set(const char *value);
+
+  /**
+   * Seed for random:F selections (trace-ranks-seed).  The same seed
+   * always selects the same ranks.
+   */
+  void libdumpi_rankselect_seed(uint64_t seed);
+
+  /**
+   * Decide whether the calling rank is traced.  Collective over
+   * MPI_COMM_WORLD (if a selection is configured);  called once MPI is
+   * initialized.  Ranks outside the selection set dumpi_global->untraced.
+   */
+  void libdumpi_rankselect_apply(void);
+
+  /**
+   * Test whether an untraced rank still records calls to the given
+   * function:  the calls the trace tools need to rebuild communicators,
+   * groups, and datatypes (see DUMPI_RECORDED).
+   */
+  int libdumpi_rankselect_skeleton(dumpi_function func);
+
+  /**
+   * Write the traced ranks to the metafile (rank 0 only).
+   */
+  void libdumpi_rankselect_write_meta(FILE *meta);
+
+  /**
+   * Note the selection and whether this rank was traced in the keyval record.
+   */
+  void libdumpi_rankselect_record(void);
+
+  /*@}*/
+
+#ifdef __cplusplus
+} /* end of extern "C" */
+#endif /* ! __cplusplus */
+
+#endif /* ! DUMPI_LIBDUMPI_RANKSELECT_H */
@@ -0,0 +1,183 @@
+/*
+ *  This file is part of DUMPI:
+ *               The MPI profiling library from the SST suite.
+ *  Copyright (c) 2009-2011 Sandia Corporation.
+ *  This software is distributed under the BSD License.
+ *  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+ *  the U.S. Government retains certain rights in this software.
+ *  For more information, see the LICENSE file in the top
+ *  SST/macroscale directory.
+ */
+
+#include <dumpi/libdumpi/ringsignals.h>
+#include <dumpi/libdumpi/init.h>
+#include <dumpi/dumpiconfig.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <errno.h>
+#include <assert.h>
+#ifdef DUMPI_USE_PTHREADS
+#include <pthread.h>
+#include <poll.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif /* ! DUMPI_USE_PTHREADS */
+
+/* Seconds a dying rank waits for its snapshot to be written */
+#ifndef DUMPI_FATAL_SNAPSHOT_WAIT
+#define DUMPI_FATAL_SNAPSHOT_WAIT 10
+#endif /* ! DUMPI_FATAL_SNAPSHOT_WAIT */
+
+static const int fatal_signals[] = {
+  SIGABRT, SIGSEGV, SIGBUS, SIGFPE, SIGILL, SIGTERM
+};
+#define FATAL_SIGNALS ((int)(sizeof(fatal_signals) / sizeof(int)))
+
+static struct sigaction fatal_saved[FATAL_SIGNALS];
+static int fatal_hooked = 0;
+static volatile sig_atomic_t dying = 0;
+static int snapshot_signal = 0;
+
+#ifdef DUMPI_USE_PTHREADS
+/* Each byte on the wake pipe asks the helper for a snapshot (or to
+ * quit); snapshots for fatal signals are acknowledged on the done pipe */
+#define SNAP_TAKE  't'
+#define SNAP_FATAL 'f'
+#define SNAP_QUIT  'q'
+static int wake[2] = { -1, -1 };
+static int done[2] = { -1, -1 };
+static pthread_t helper;
+static int helper_running = 0;
+
+/* Only async-signal-safe calls from here on */
+static void wake_helper(char what) {
+  if(wake[1] >= 0)
+    while(write(wake[1], &what, 1) < 0 && errno == EINTR)
+      ;
+}
+
+/* The helper thread runs with all signals blocked, so the handlers
+ * below never run on it. */
+static void* snapshot_helper(void *arg) {
+  char what;
+  ssize_t got;
+  (void)arg;
+  for(;;) {
+    got = read(wake[0], &what, 1);
+    if(got < 0 && errno == EINTR)
+      continue;
+    if(got <= 0 || what == SNAP_QUIT)
+      break;
+    libdumpi_ring_snapshot();
+    if(what == SNAP_FATAL)
+      while(write(done[1], &what, 1) < 0 && errno == EINTR)
+	;
+  }
+  return NULL;
+}
+#endif /* ! DUMPI_USE_PTHREADS */
+
+static void request_snapshot(int sig) {
+  int saved_errno = errno;
+  (void)sig;
+#ifdef DUMPI_USE_PTHREADS
+  if(helper_running)
+    wake_helper(SNAP_TAKE);
+  else
+#endif /* ! DUMPI_USE_PTHREADS */
+    libdumpi_snapshot_requested = 1;
+  errno = saved_errno;
+}
+
+/* Dump the ring, then hand the signal on to whoever had it before. */
+static void fatal_snapshot(int sig) {
+  int i, saved_errno = errno;
+  if(! dying) {
+    dying = 1;
+#ifdef DUMPI_USE_PTHREADS
+    if(helper_running) {
+      struct pollfd pfd;
+      pfd.fd = done[0];
+      pfd.events = POLLIN;
+      pfd.revents = 0;
+      wake_helper(SNAP_FATAL);
+      /* The helper may be stuck behind this thread (the I/O lock,
+       * or a heap lock if the heap is broken) */
+      while(poll(&pfd, 1, DUMPI_FATAL_SNAPSHOT_WAIT * 1000) < 0 &&
+	    errno == EINTR)
+	;
+    }
+#else
+    /* Best effort:  this does not return if the heap is broken */
+    libdumpi_ring_snapshot();
+#endif /* ! DUMPI_USE_PTHREADS */
+  }
+  for(i = 0; i < FATAL_SIGNALS; ++i)
+    if(fatal_signals[i] == sig)
+      sigaction(sig, fatal_saved + i, NULL);
+  errno = saved_errno;
+  /* Delivered with the previous action once the handler returns */
+  raise(sig);
+}
+
+void libdumpi_ring_signals_start(int snapsig, int fatal) {
+  struct sigaction act;
+  int i;
+#ifdef DUMPI_USE_PTHREADS
+  sigset_t all, old;
+  if(pipe(wake) == 0 && pipe(done) == 0) {
+    /* A burst of signals must not block the handler */
+    fcntl(wake[1], F_SETFL, fcntl(wake[1], F_GETFL) | O_NONBLOCK);
+    sigfillset(&all);
+    pthread_sigmask(SIG_SETMASK, &all, &old);
+    helper_running = (pthread_create(&helper, NULL, snapshot_helper, NULL)
+		      == 0);
+    pthread_sigmask(SIG_SETMASK, &old, NULL);
+  }
+  if(! helper_running)
+    fprintf(stderr, "DUMPI:  Failed to start the ring buffer snapshot "
+	    "thread; snapshots wait for the next MPI call.\n");
+#endif /* ! DUMPI_USE_PTHREADS */
+  snapshot_signal = snapsig;
+  if(snapsig)
+    signal(snapsig, request_snapshot);
+  if(fatal) {
+    memset(&act, 0, sizeof(act));
+    act.sa_handler = fatal_snapshot;
+    sigemptyset(&act.sa_mask);
+    for(i = 0; i < FATAL_SIGNALS; ++i)
+      sigaction(fatal_signals[i], &act, fatal_saved + i);
+    fatal_hooked = 1;
+  }
+}
+
+void libdumpi_ring_signals_stop(void) {
+  int i;
+  if(fatal_hooked) {
+    for(i = 0; i < FATAL_SIGNALS; ++i)
+      sigaction(fatal_signals[i], fatal_saved + i, NULL);
+    fatal_hooked = 0;
+  }
+  /* Later snapshot requests find no ring and do nothing */
+  if(snapshot_signal)
+    signal(snapshot_signal, SIG_IGN);
+  snapshot_signal = 0;
+#ifdef DUMPI_USE_PTHREADS
+  if(helper_running) {
+    char what = SNAP_QUIT;
+    helper_running = 0;
+    /* The write end may be full of snapshot requests */
+    fcntl(wake[1], F_SETFL, fcntl(wake[1], F_GETFL) & ~O_NONBLOCK);
+    while(write(wake[1], &what, 1) < 0 && errno == EINTR)
+      ;
+    assert(pthread_join(helper, NULL) == 0);
+  }
+  for(i = 0; i < 2; ++i) {
+    if(wake[i] >= 0) close(wake[i]);
+    if(done[i] >= 0) close(done[i]);
+    wake[i] = done[i] = -1;
+  }
+#endif /* ! DUMPI_USE_PTHREADS */
+}
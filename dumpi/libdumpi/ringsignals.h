@@ -0,0 +1,47 @@
+/*
+ *  This file is part of DUMPI:
+ *               The MPI profiling library from the SST suite.
+ *  Copyright (c) 2009-2011 Sandia Corporation.
+ *  This software is distributed under the BSD License.
+ *  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+ *  the U.S. Government retains certain rights in this software.
+ *  For more information, see the LICENSE file in the top
+ *  SST/macroscale directory.
+ */
+
+#ifndef DUMPI_LIBDUMPI_RINGSIGNALS_H
+#define DUMPI_LIBDUMPI_RINGSIGNALS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* ! __cplusplus */
+
+  /**
+   * \addtogroup libdumpi_internal
+   */
+  /*@{*/
+
+  /**
+   * Take ring buffer snapshots (mode=ringbuffer) on signals.
+   * With pthreads, a helper thread writes the snapshot as soon as
+   * snapsig arrives, so a rank stuck in a blocking MPI call can still
+   * be dumped; otherwise the next MPI call writes it.  If fatal is
+   * non-zero, SIGABRT, SIGSEGV, SIGBUS, SIGFPE, SIGILL, and SIGTERM also
+   * write a snapshot before their previous action is taken.
+   * \param snapsig the snapshot signal (0: none).
+   */
+  void libdumpi_ring_signals_start(int snapsig, int fatal);
+
+  /**
+   * Stop the helper thread and restore the fatal signal actions.
+   * Called before the final ring buffer is written.
+   */
+  void libdumpi_ring_signals_stop(void);
+
+  /*@}*/
+
+#ifdef __cplusplus
+} /* end of extern "C" */
+#endif /* ! __cplusplus */
+
+#endif /* ! DUMPI_LIBDUMPI_RINGSIGNALS_H */
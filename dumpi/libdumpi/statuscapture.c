@@ -0,0 +1,120 @@
+/*
+ *  This file is part of DUMPI:
+ *               The MPI profiling library from the SST suite.
+ *  Copyright (c) 2009-2011 Sandia Corporation.
+ *  This software is distributed under the BSD License.
+ *  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+ *  the U.S. Government retains certain rights in this software.
+ *  For more information, see the LICENSE file in the top
+ *  SST/macroscale directory.
+ */
+
+#include <dumpi/libdumpi/statuscapture.h>
+#include <dumpi/libdumpi/mpibindings-utils.h>
+#include <dumpi/libdumpi/data.h>
+#include <dumpi/common/iodefs.h>
+#include <dumpi/common/constants.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+/* A placeholder in the memory buffer waiting for its value. */
+typedef struct pending_status {
+  size_t             offset;
+  dumpi_status_field field;
+  MPI_Status         status;
+} pending_status;
+
+/* Placeholders written but not yet patched (protected by the io lock). */
+static pending_status *pending = NULL;
+static size_t pending_count = 0, pending_capacity = 0;
+
+/* Capture statuses without calling into MPI. */
+dumpi_status* libdumpi_capture_statuses(int count,
+					const MPI_Status *statuses)
+{
+  int i;
+  libdumpi_status_capture *capture = libdumpi_get_status_capture();
+  MPI_Status *raw =
+    (MPI_Status*)libdumpi_scratch_alloc(count*sizeof(MPI_Status));
+  dumpi_status *decoded =
+    (dumpi_status*)libdumpi_scratch_alloc(count*sizeof(dumpi_status));
+  memcpy(raw, statuses, count*sizeof(MPI_Status));
+  for(i = 0; i < count; ++i) {
+    decoded[i].bytes = i;
+    if(raw[i].MPI_SOURCE == MPI_ANY_SOURCE)
+      decoded[i].source = DUMPI_ANY_SOURCE;
+    else if(raw[i].MPI_SOURCE == MPI_ROOT)
+      decoded[i].source = DUMPI_ROOT;
+    else
+      decoded[i].source = raw[i].MPI_SOURCE;
+    if(raw[i].MPI_TAG == MPI_ANY_TAG)
+      decoded[i].tag = DUMPI_ANY_TAG;
+    else
+      decoded[i].tag = raw[i].MPI_TAG;
+    decoded[i].cancelled = DUMPI_STATUS_DEFERRED;
+    decoded[i].error = raw[i].MPI_ERROR;
+  }
+  capture->decoded = decoded;
+  capture->raw = raw;
+  capture->count = count;
+  return decoded;
+}
+
+/* Remember where the writer put a placeholder (called by put_statuses). */
+static void defer_status(dumpi_profile *profile, const dumpi_status *status,
+			 dumpi_status_field field, size_t offset)
+{
+  int index = status->bytes;
+  libdumpi_status_capture *capture = libdumpi_get_status_capture();
+  (void)profile;
+  /* Records are written by the thread that captured their statuses */
+  assert(index >= 0 && index < capture->count);
+  assert(status == capture->decoded + index);
+  if(pending_count == pending_capacity) {
+    pending_capacity = (pending_capacity ? 2*pending_capacity : 64);
+    pending = (pending_status*)realloc(pending,
+				       pending_capacity*sizeof(pending_status));
+    assert(pending != NULL);
+  }
+  pending[pending_count].offset = offset;
+  pending[pending_count].field = field;
+  memcpy(&pending[pending_count].status, capture->raw + index,
+	 sizeof(MPI_Status));
+  ++pending_count;
+}
+
+/* Decode all pending statuses (called before the buffer is flushed). */
+static void resolve_statuses(dumpi_profile *profile) {
+  size_t i;
+  int value;
+  for(i = 0; i < pending_count; ++i) {
+    if(pending[i].field == DUMPI_STATUS_BYTES) {
+      PMPI_Get_count(&pending[i].status, MPI_CHAR, &value);
+      patch32(profile, pending[i].offset, value);
+    }
+    else {
+      PMPI_Test_cancelled(&pending[i].status, &value);
+      patch8(profile, pending[i].offset, value);
+    }
+  }
+  pending_count = 0;
+}
+
+/* Install the writer hooks. */
+void libdumpi_enable_lazy_statuses(dumpi_profile *profile) {
+  assert(profile != NULL);
+  profile->defer_status = defer_status;
+  profile->resolve_statuses = resolve_statuses;
+}
+
+/* Decode all pending statuses now. */
+void libdumpi_resolve_statuses(void) {
+  libdumpi_lock_io();
+  if(dumpi_global != NULL && dumpi_global->profile != NULL &&
+     dumpi_global->profile->resolve_statuses != NULL)
+  {
+    dumpi_global->profile->resolve_statuses(dumpi_global->profile);
+  }
+  libdumpi_unlock_io();
+}
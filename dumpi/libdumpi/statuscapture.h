@@ -0,0 +1,67 @@
+/*
+ *  This file is part of DUMPI:
+ *               The MPI profiling library from the SST suite.
+ *  Copyright (c) 2009-2011 Sandia Corporation.
+ *  This software is distributed under the BSD License.
+ *  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+ *  the U.S. Government retains certain rights in this software.
+ *  For more information, see the LICENSE file in the top
+ *  SST/macroscale directory.
+ */
+
+#ifndef DUMPI_LIBDUMPI_STATUSCAPTURE_H
+#define DUMPI_LIBDUMPI_STATUSCAPTURE_H
+
+#include <dumpi/common/types.h>
+#include <mpi.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* ! __cplusplus */
+
+  /**
+   * \addtogroup libdumpi_internal
+   */
+  /*@{*/
+
+  /**
+   * The most recent array of statuses captured by a thread
+   * (see libdumpi_get_status_capture).
+   */
+  typedef struct libdumpi_status_capture {
+    /** The dumpi_status array handed to the trace writer */
+    const dumpi_status *decoded;
+    /** Copies of the MPI_Status objects, in the same order */
+    const MPI_Status   *raw;
+    int                 count;
+  } libdumpi_status_capture;
+
+  /**
+   * Capture statuses without calling into MPI (status-capture lazy).
+   * The MPI_Status objects are copied into the scratch arena and the
+   * source, tag, and error fields are converted right away.  The byte
+   * count and cancellation flag are marked with DUMPI_STATUS_DEFERRED
+   * and get decoded (by PMPI_Get_count and PMPI_Test_cancelled) in a
+   * batch just before the trace buffer is written to file.
+   */
+  dumpi_status* libdumpi_capture_statuses(int count,
+					  const MPI_Status *statuses);
+
+  /**
+   * Install the hooks that let the trace writer accept deferred statuses.
+   */
+  void libdumpi_enable_lazy_statuses(dumpi_profile *profile);
+
+  /**
+   * Decode all pending statuses now.
+   * Must be called before PMPI_Finalize, since decoding uses MPI.
+   */
+  void libdumpi_resolve_statuses(void);
+
+  /*@}*/
+
+#ifdef __cplusplus
+} /* end of extern "C" */
+#endif /* ! __cplusplus */
+
+#endif /* ! DUMPI_LIBDUMPI_STATUSCAPTURE_H */
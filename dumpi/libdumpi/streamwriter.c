@@ -0,0 +1,438 @@
+/*
+ *  This file is part of DUMPI:
+ *               The MPI profiling library from the SST suite.
+ *  Copyright (c) 2009-2011 Sandia Corporation.
+ *  This software is distributed under the BSD License.
+ *  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+ *  the U.S. Government retains certain rights in this software.
+ *  For more information, see the LICENSE file in the top
+ *  SST/macroscale directory.
+ */
+
+/* fopencookie */
+#define _GNU_SOURCE 1
+#include <dumpi/libdumpi/streamwriter.h>
+#include <dumpi/libdumpi/data.h>
+#include <dumpi/libdumpi/init.h>
+#include <dumpi/common/livestream.h>
+#include <dumpi/dumpiconfig.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <assert.h>
+#include <limits.h>
+#include <signal.h>
+#include <poll.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <arpa/inet.h>
+
+/* Largest payload of a frame sent over a socket (through a named pipe,
+ * frames are kept to PIPE_BUF so that the ranks' writes don't mix) */
+#ifndef DUMPI_STREAM_MAX_FRAME
+#define DUMPI_STREAM_MAX_FRAME 262144
+#endif /* ! DUMPI_STREAM_MAX_FRAME */
+
+/* The memory backlog holds at least a few whole frames */
+#define DUMPI_STREAM_MIN_BACKLOG (4 * (DUMPI_STREAM_MAX_FRAME + DUMPI_FRAME_HEADER))
+
+/* How long closing the stream waits for the collector (milliseconds) */
+#ifndef DUMPI_STREAM_CLOSE_TIMEOUT
+#define DUMPI_STREAM_CLOSE_TIMEOUT 30000
+#endif /* ! DUMPI_STREAM_CLOSE_TIMEOUT */
+
+/* Settings (from the configuration) */
+static char *target = NULL;
+static size_t backlog_size = (size_t)4 << 20;
+
+/* Statistics */
+static uint64_t frames = 0, spilled = 0, peak_backlog = 0;
+static char *fallback_name = NULL;
+
+void libdumpi_stream_to(const char *path) {
+  free(target);
+  target = strdup(path);
+  assert(target != NULL);
+}
+
+int libdumpi_stream_backlog(const char *value) {
+  return libdumpi_parse_size(value, &backlog_size);
+}
+
+int libdumpi_stream_wanted(void) {
+  return (target != NULL);
+}
+
+#ifdef DUMPI_HAVE_FOPENCOOKIE
+
+/* The connection of this rank and the frames the collector has not
+ * taken yet:  buf[head, tail) in memory, followed by
+ * [spill_read, spill_write) in the spill file. */
+typedef struct stream_channel {
+  int            fd;
+  int            fifo;
+  int            rank;
+  /* Frames and stream bytes queued so far */
+  uint64_t       seq, pos;
+  unsigned char *buf;
+  /* head is the start of the frame being sent, of which sent bytes
+   * are out */
+  size_t         head, sent, tail, cap;
+  FILE          *spill;
+  off_t          spill_read, spill_write;
+  /* Set once the collector is gone */
+  FILE          *fallback;
+} stream_channel;
+
+static size_t max_payload(const stream_channel *ch) {
+  return (ch->fifo ? PIPE_BUF - DUMPI_FRAME_HEADER : DUMPI_STREAM_MAX_FRAME);
+}
+
+static void write_all(FILE *file, const void *data, size_t bytes) {
+  if(bytes > 0 && fwrite(data, 1, bytes, file) != bytes) {
+    fprintf(stderr, "DUMPI:  Failed to write the trace stream: %s\n",
+	    strerror(errno));
+    abort();
+  }
+}
+
+static void compact(stream_channel *ch) {
+  if(ch->head > 0) {
+    memmove(ch->buf, ch->buf + ch->head, ch->tail - ch->head);
+    ch->tail -= ch->head;
+    ch->head = 0;
+  }
+}
+
+/* Append to the backlog (or to the fallback file). */
+static void queue_bytes(stream_channel *ch, const void *data, size_t bytes) {
+  uint64_t backlog;
+  if(ch->fallback != NULL) {
+    write_all(ch->fallback, data, bytes);
+    return;
+  }
+  if(ch->spill_write == ch->spill_read && ch->tail + bytes > ch->cap)
+    compact(ch);
+  if(ch->spill_write == ch->spill_read && ch->tail + bytes <= ch->cap) {
+    memcpy(ch->buf + ch->tail, data, bytes);
+    ch->tail += bytes;
+  }
+  else {
+    /* The collector is behind; keep the rest on disk */
+    if(ch->spill == NULL && (ch->spill = tmpfile()) == NULL) {
+      fprintf(stderr, "DUMPI:  Failed to open a file for the trace stream "
+	      "backlog: %s\n", strerror(errno));
+      abort();
+    }
+    assert(fseeko(ch->spill, ch->spill_write, SEEK_SET) == 0);
+    write_all(ch->spill, data, bytes);
+    ch->spill_write += bytes;
+    spilled += bytes;
+  }
+  backlog = (ch->tail - ch->head) + (ch->spill_write - ch->spill_read);
+  if(backlog > peak_backlog)
+    peak_backlog = backlog;
+}
+
+static void queue_frame(stream_channel *ch, dumpi_frame_type type,
+			const void *payload, size_t length)
+{
+  unsigned char header[DUMPI_FRAME_HEADER];
+  dumpi_frame frame;
+  frame.type = type;
+  frame.flags = 0;
+  frame.rank = ch->rank;
+  frame.length = length;
+  frame.seq = ch->seq++;
+  ++frames;
+  frame.offset = ch->pos;
+  dumpi_frame_pack(header, &frame);
+  queue_bytes(ch, header, DUMPI_FRAME_HEADER);
+  queue_bytes(ch, payload, length);
+  if(type == DUMPI_FRAME_DATA)
+    ch->pos += length;
+}
+
+static void open_payload(unsigned char *payload, size_t *length) {
+  uint32_t size = htonl((uint32_t)dumpi_global->comm_size);
+  size_t rootlen = strlen(dumpi_global->file_root);
+  payload[0] = dumpi_global->header->version[0];
+  payload[1] = dumpi_global->header->version[1];
+  payload[2] = dumpi_global->header->version[2];
+  payload[3] = 0;
+  memcpy(payload + 4, &size, sizeof(uint32_t));
+  memcpy(payload + DUMPI_FRAME_OPEN_FIXED, dumpi_global->file_root, rootlen);
+  *length = DUMPI_FRAME_OPEN_FIXED + rootlen;
+}
+
+/* Move spilled bytes back to memory (once the spill is used up, it
+ * starts over). */
+static void refill(stream_channel *ch) {
+  size_t want;
+  compact(ch);
+  want = ch->cap - ch->tail;
+  if(want > (size_t)(ch->spill_write - ch->spill_read))
+    want = ch->spill_write - ch->spill_read;
+  if(want == 0)
+    return;
+  assert(fseeko(ch->spill, ch->spill_read, SEEK_SET) == 0);
+  assert(fread(ch->buf + ch->tail, 1, want, ch->spill) == want);
+  ch->tail += want;
+  ch->spill_read += want;
+  if(ch->spill_read == ch->spill_write) {
+    ch->spill_read = ch->spill_write = 0;
+    assert(ftruncate(fileno(ch->spill), 0) == 0);
+  }
+}
+
+/* Length of the frame at head (whole in memory), 0 if nothing is left. */
+static size_t head_frame(stream_channel *ch, dumpi_frame *frame) {
+  size_t length;
+  if(ch->tail - ch->head < DUMPI_FRAME_HEADER)
+    refill(ch);
+  if(ch->tail - ch->head < DUMPI_FRAME_HEADER)
+    return 0;
+  assert(dumpi_frame_unpack(ch->buf + ch->head, frame));
+  length = DUMPI_FRAME_HEADER + frame->length;
+  if(ch->tail - ch->head < length)
+    refill(ch);
+  assert(ch->tail - ch->head >= length);
+  return length;
+}
+
+/* The collector is gone:  write the frames it did not get, and all
+ * later ones, to fileroot-NNNN.frames (led by an OPEN frame, so that
+ * dumpicollect -r can pick up where the stream broke off). */
+static void divert(stream_channel *ch) {
+  unsigned char header[DUMPI_FRAME_HEADER], payload[1024];
+  dumpi_frame frame;
+  size_t length, bytes;
+  int err = errno;
+  fallback_name = (char*)malloc(strlen(dumpi_global->file_root) + 32);
+  assert(fallback_name != NULL);
+  sprintf(fallback_name, "%s-%04d.frames", dumpi_global->file_root, ch->rank);
+  fprintf(stderr, "DUMPI:  Lost the trace collector (%s); rank %d writes "
+	  "the rest of its trace to %s\n", (err ? strerror(err) : "timeout"),
+	  ch->rank, fallback_name);
+  if((ch->fallback = fopen(fallback_name, "w")) == NULL) {
+    fprintf(stderr, "DUMPI:  Failed to open \"%s\": %s\n", fallback_name,
+	    strerror(errno));
+    abort();
+  }
+  if(head_frame(ch, &frame) == 0) {
+    frame.seq = ch->seq;
+    frame.offset = ch->pos;
+  }
+  frame.type = DUMPI_FRAME_OPEN;
+  frame.flags = DUMPI_FRAME_RESUME;
+  frame.rank = ch->rank;
+  open_payload(payload, &length);
+  frame.length = length;
+  dumpi_frame_pack(header, &frame);
+  write_all(ch->fallback, header, DUMPI_FRAME_HEADER);
+  write_all(ch->fallback, payload, length);
+  /* Partly sent frames go again in full */
+  write_all(ch->fallback, ch->buf + ch->head, ch->tail - ch->head);
+  if(ch->spill != NULL) {
+    assert(fseeko(ch->spill, ch->spill_read, SEEK_SET) == 0);
+    while((length = ch->spill_write - ch->spill_read) > 0) {
+      bytes = (length < sizeof(payload) ? length : sizeof(payload));
+      assert(fread(payload, 1, bytes, ch->spill) == bytes);
+      write_all(ch->fallback, payload, bytes);
+      ch->spill_read += bytes;
+    }
+    fclose(ch->spill);
+    ch->spill = NULL;
+  }
+  ch->head = ch->sent = ch->tail = 0;
+  close(ch->fd);
+  ch->fd = -1;
+}
+
+/* Send what the collector takes right away (with wait, everything). */
+static void drain(stream_channel *ch, int wait) {
+  dumpi_frame frame;
+  struct pollfd pfd;
+  size_t length;
+  ssize_t count;
+  while(ch->fallback == NULL && (length = head_frame(ch, &frame)) > 0) {
+    if(ch->fifo) {
+      /* Up to PIPE_BUF bytes go into a pipe in one piece or not at all */
+      count = write(ch->fd, ch->buf + ch->head, length);
+    }
+    else {
+      count = send(ch->fd, ch->buf + ch->head + ch->sent,
+		   length - ch->sent, MSG_NOSIGNAL | MSG_DONTWAIT);
+    }
+    if(count > 0) {
+      ch->sent += count;
+      if(ch->sent == length) {
+	ch->head += length;
+	ch->sent = 0;
+      }
+      continue;
+    }
+    if(count < 0 && errno == EINTR)
+      continue;
+    if(count < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+      if(! wait)
+	return;
+      pfd.fd = ch->fd;
+      pfd.events = POLLOUT;
+      errno = 0;
+      if(poll(&pfd, 1, DUMPI_STREAM_CLOSE_TIMEOUT) > 0)
+	continue;
+    }
+    divert(ch);
+  }
+}
+
+static ssize_t stream_write(void *cookie, const char *buf, size_t size) {
+  stream_channel *ch = (stream_channel*)cookie;
+  size_t done = 0, bytes;
+  while(done < size) {
+    bytes = size - done;
+    if(bytes > max_payload(ch))
+      bytes = max_payload(ch);
+    queue_frame(ch, DUMPI_FRAME_DATA, buf + done, bytes);
+    done += bytes;
+  }
+  drain(ch, 0);
+  return size;
+}
+
+/* Only tells the position (DUMPI_WRITE_TELL). */
+static int stream_seek(void *cookie, off64_t *offset, int whence) {
+  stream_channel *ch = (stream_channel*)cookie;
+  if((whence == SEEK_CUR && *offset == 0) ||
+     (whence == SEEK_SET && (uint64_t)*offset == ch->pos))
+  {
+    *offset = ch->pos;
+    return 0;
+  }
+  errno = ESPIPE;
+  return -1;
+}
+
+static int stream_close(void *cookie) {
+  stream_channel *ch = (stream_channel*)cookie;
+  queue_frame(ch, DUMPI_FRAME_CLOSE, NULL, 0);
+  drain(ch, 1);
+  if(ch->fd >= 0)
+    close(ch->fd);
+  if(ch->fallback != NULL)
+    fclose(ch->fallback);
+  if(ch->spill != NULL)
+    fclose(ch->spill);
+  free(ch->buf);
+  free(ch);
+  return 0;
+}
+
+/* Connect to a listening socket or open a named pipe. */
+static int connect_collector(const char *path, int *fifo) {
+  struct sockaddr_un addr;
+  struct sigaction action;
+  struct stat st;
+  int fd;
+  if(stat(path, &st) != 0)
+    return -1;
+  if(S_ISFIFO(st.st_mode)) {
+    *fifo = 1;
+    /* A collector that goes away must not take the run with it */
+    if(sigaction(SIGPIPE, NULL, &action) == 0 &&
+       action.sa_handler == SIG_DFL)
+      signal(SIGPIPE, SIG_IGN);
+    return open(path, O_WRONLY | O_NONBLOCK);
+  }
+  *fifo = 0;
+  if(strlen(path) >= sizeof(addr.sun_path)) {
+    errno = ENAMETOOLONG;
+    return -1;
+  }
+  memset(&addr, 0, sizeof(addr));
+  addr.sun_family = AF_UNIX;
+  strcpy(addr.sun_path, path);
+  if((fd = socket(AF_UNIX, SOCK_STREAM, 0)) < 0)
+    return -1;
+  if(connect(fd, (struct sockaddr*)&addr, sizeof(addr)) != 0) {
+    int err = errno;
+    close(fd);
+    errno = err;
+    return -1;
+  }
+  return fd;
+}
+
+DUMPIFILE libdumpi_streamwriter_open(void) {
+  static const cookie_io_functions_t funcs = {
+    NULL, stream_write, stream_seek, stream_close
+  };
+  unsigned char payload[1024];
+  size_t length;
+  stream_channel *ch;
+  DUMPIFILE fp;
+  assert(target != NULL);
+  if(strlen(dumpi_global->file_root) + DUMPI_FRAME_OPEN_FIXED >
+     sizeof(payload))
+  {
+    fprintf(stderr, "DUMPI:  stream-to:  File root too long; writing the "
+	    "trace file.\n");
+    return NULL;
+  }
+  ch = (stream_channel*)calloc(1, sizeof(stream_channel));
+  assert(ch != NULL);
+  ch->rank = dumpi_global->comm_rank;
+  if((ch->fd = connect_collector(target, &ch->fifo)) < 0) {
+    fprintf(stderr, "DUMPI:  Cannot reach the trace collector at %s (%s); "
+	    "rank %d writes its trace file.\n", target, strerror(errno),
+	    ch->rank);
+    free(ch);
+    return NULL;
+  }
+  ch->cap = backlog_size;
+  if(ch->cap < DUMPI_STREAM_MIN_BACKLOG)
+    ch->cap = DUMPI_STREAM_MIN_BACKLOG;
+  ch->buf = (unsigned char*)malloc(ch->cap);
+  assert(ch->buf != NULL);
+  open_payload(payload, &length);
+  queue_frame(ch, DUMPI_FRAME_OPEN, payload, length);
+  drain(ch, 0);
+  fp = fopencookie(ch, "w", funcs);
+  assert(fp != NULL);
+  /* The trace buffer does the buffering */
+  setvbuf(fp, NULL, _IONBF, 0);
+  return fp;
+}
+
+#else /* ! DUMPI_HAVE_FOPENCOOKIE */
+
+DUMPIFILE libdumpi_streamwriter_open(void) {
+  if(dumpi_global->comm_rank == 0)
+    fprintf(stderr, "DUMPI:  stream-to:  Not supported by this build (needs "
+	    "fopencookie); writing one trace file per rank.\n");
+  return NULL;
+}
+
+#endif /* ! DUMPI_HAVE_FOPENCOOKIE */
+
+void libdumpi_streamwriter_record(void) {
+  char val[64];
+  if(! dumpi_global->stream || dumpi_global->keyval == NULL)
+    return;
+  dumpi_push_keyval_entry(dumpi_global->keyval, "stream-to", target);
+  snprintf(val, sizeof(val), "%llu", (unsigned long long)frames);
+  dumpi_push_keyval_entry(dumpi_global->keyval, "stream-frames", val);
+  snprintf(val, sizeof(val), "%llu", (unsigned long long)peak_backlog);
+  dumpi_push_keyval_entry(dumpi_global->keyval, "stream-backlog-peak", val);
+  snprintf(val, sizeof(val), "%llu", (unsigned long long)spilled);
+  dumpi_push_keyval_entry(dumpi_global->keyval, "stream-spilled", val);
+  if(fallback_name != NULL)
+    dumpi_push_keyval_entry(dumpi_global->keyval, "stream-fallback",
+			    fallback_name);
+}
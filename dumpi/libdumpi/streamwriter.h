@@ -0,0 +1,70 @@
+/*
+ *  This file is part of DUMPI:
+ *               The MPI profiling library from the SST suite.
+ *  Copyright (c) 2009-2011 Sandia Corporation.
+ *  This software is distributed under the BSD License.
+ *  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+ *  the U.S. Government retains certain rights in this software.
+ *  For more information, see the LICENSE file in the top
+ *  SST/macroscale directory.
+ */
+
+#ifndef DUMPI_LIBDUMPI_STREAMWRITER_H
+#define DUMPI_LIBDUMPI_STREAMWRITER_H
+
+#include <dumpi/common/types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* ! __cplusplus */
+
+  /**
+   * \addtogroup libdumpi_internal
+   */
+  /*@{*/
+
+  /**
+   * Stream the trace to a collector (dumpicollect) listening on the
+   * given Unix-domain socket or reading the given named pipe (stream-to).
+   */
+  void libdumpi_stream_to(const char *path);
+
+  /**
+   * Set how much of the stream is held in memory while the collector
+   * is behind (stream-backlog, in megabytes or with a K or M suffix).
+   * Beyond that, the backlog goes to a temporary file.
+   * \return non-zero if the value was valid.
+   */
+  int libdumpi_stream_backlog(const char *value);
+
+  /**
+   * Non-zero if the configuration asks for streaming.
+   */
+  int libdumpi_stream_wanted(void);
+
+  /**
+   * Connect to the collector and open the trace stream of this rank.
+   *
+   * The stream sends each flush of the trace buffer as frames (see
+   * livestream.h) without blocking.  Whatever the collector does not
+   * take right away is kept in memory, then in a temporary file, and
+   * sent with later flushes; only closing the stream waits for the
+   * collector.  If the collector goes away, the rest of the stream is
+   * written to fileroot-NNNN.frames, which dumpicollect -r can replay.
+   * \return the stream, or NULL if the collector cannot be reached (the
+   *         rank then writes its trace file as usual).
+   */
+  DUMPIFILE libdumpi_streamwriter_open(void);
+
+  /**
+   * Note the collector and the streaming statistics in the keyval record.
+   */
+  void libdumpi_streamwriter_record(void);
+
+  /*@}*/
+
+#ifdef __cplusplus
+} /* end of extern "C" */
+#endif /* ! __cplusplus */
+
+#endif /* ! DUMPI_LIBDUMPI_STREAMWRITER_H */
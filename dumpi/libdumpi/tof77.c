@@ -24,7 +24,130 @@
 static int f77_constants_initialized = 0;
 static MPI_Fint f77_status_size, f77_compare_ident, f77_compare_similar, f77_compare_unequal;
 static MPI_Fint *f77_status_ignore = NULL, *f77_statuses_ignore = NULL;
-static MPI_Status *static_status = NULL;
+
+/* MPICH-derived implementations use integer handles, and their f2c/c2f
+ * conversions are casts.  There, Fortran request arrays are handed to
+ * the C bindings as they are. */
+#if defined(MPICH_VERSION)
+#define F77_IDENTITY_REQUESTS (sizeof(MPI_Request) == sizeof(MPI_Fint))
+#else
+#define F77_IDENTITY_REQUESTS 0
+#endif
+
+/* Fortran integer arrays can be passed straight through when
+ * INTEGER and int have the same size. */
+#define F77_IDENTITY_INTS (sizeof(MPI_Fint) == sizeof(int))
+
+/*
+ * Each thread keeps a set of conversion buffers that grow as needed and
+ * are reused on every call (a wrapper never uses the same slot twice).
+ * These are separate from the libdumpi scratch arena, which is reset when
+ * the profiled C binding returns.
+ */
+enum f77_slot {
+  F77_REQUESTS, F77_STATUSES, F77_INDICES,
+  F77_INTS0, F77_INTS1, F77_INTS2, F77_INTS3,
+  F77_TYPES0, F77_TYPES1,
+  F77_SLOTS
+};
+
+typedef struct f77_buffers {
+  void       *buf[F77_SLOTS];
+  size_t      size[F77_SLOTS];
+  MPI_Status  status;
+} f77_buffers;
+
+#ifdef DUMPI_USE_PTHREADS
+#include <pthread.h>
+
+static pthread_key_t f77_key;
+static pthread_once_t f77_key_once = PTHREAD_ONCE_INIT;
+
+static void release_buffers(void *arg) {
+  int i;
+  f77_buffers *buffers = (f77_buffers*)arg;
+  for(i = 0; i < F77_SLOTS; ++i)
+    free(buffers->buf[i]);
+  free(buffers);
+}
+
+static void create_f77_key(void) {
+  assert(pthread_key_create(&f77_key, release_buffers) == 0);
+}
+
+static inline f77_buffers* get_buffers(void) {
+  f77_buffers *buffers;
+  pthread_once(&f77_key_once, create_f77_key);
+  if((buffers = (f77_buffers*)pthread_getspecific(f77_key)) == NULL) {
+    assert((buffers = (f77_buffers*)calloc(1, sizeof(f77_buffers))) != NULL);
+    assert(pthread_setspecific(f77_key, buffers) == 0);
+  }
+  return buffers;
+}
+
+#else /* ! DUMPI_USE_PTHREADS */
+
+static f77_buffers static_buffers;
+
+static inline f77_buffers* get_buffers(void) {
+  return &static_buffers;
+}
+
+#endif /* ! DUMPI_USE_PTHREADS */
+
+/* Get at least the given number of bytes from a per-thread buffer. */
+static inline void* reserve(enum f77_slot slot, size_t bytes) {
+  f77_buffers *buffers = get_buffers();
+  if(bytes > buffers->size[slot]) {
+    free(buffers->buf[slot]);
+    assert((buffers->buf[slot] = malloc(bytes)) != NULL);
+    buffers->size[slot] = bytes;
+  }
+  return buffers->buf[slot];
+}
+
+/* Get a C int array holding the values of a Fortran integer array. */
+static inline int* fint_array(enum f77_slot slot, int count, MPI_Fint *farr) {
+  int i, *carr;
+  if(F77_IDENTITY_INTS || count <= 0)
+    return (int*)farr;
+  carr = (int*)reserve(slot, count * sizeof(int));
+  for(i = 0; i < count; ++i)
+    carr[i] = farr[i];
+  return carr;
+}
+
+/* Get a C int array for output to a Fortran integer array. */
+static inline int* fint_outarray(enum f77_slot slot, int count, MPI_Fint *farr) {
+  if(F77_IDENTITY_INTS || count <= 0)
+    return (int*)farr;
+  return (int*)reserve(slot, count * sizeof(int));
+}
+
+/* Copy C output values back to a Fortran integer array. */
+static inline void finish_fint_array(int count, int *carr, MPI_Fint *farr) {
+  int i;
+  if((void*)carr != (void*)farr)
+    for(i = 0; i < count; ++i)
+      farr[i] = carr[i];
+}
+
+/* Get a zero-filled C int array. */
+static inline int* zero_array(enum f77_slot slot, int count) {
+  int *carr = (int*)reserve(slot, count * sizeof(int));
+  memset(carr, 0, count * sizeof(int));
+  return carr;
+}
+
+/* Get a C datatype array for a Fortran array of datatype handles. */
+static inline MPI_Datatype* ftype_array(enum f77_slot slot, int count, MPI_Fint *ftypes) {
+  int i;
+  MPI_Datatype *ctypes;
+  ctypes = (MPI_Datatype*)reserve(slot, count * sizeof(MPI_Datatype));
+  for(i = 0; i < count; ++i)
+    ctypes[i] = MPI_Type_f2c(ftypes[i]);
+  return ctypes;
+}
 
 #define GET_FCONSTANTS F77_FUNC_(libdumpi_get_f77_constants, LIBDUMPI_GET_F77_CONSTANTS)
 #define GET_FSTATUSES F77_FUNC_(libdumpi_get_f77_statuses, LIBDUMPI_GET_F77_STATUSES)
@@ -48,7 +171,9 @@ static inline void init_constants() {
 static inline MPI_Request* clone_requests(MPI_Fint *count, MPI_Fint *frequests) {
   int i;
   MPI_Request *crequests;
-  assert((crequests = (MPI_Request*)calloc(*count, sizeof(MPI_Request))) != NULL);
+  if(F77_IDENTITY_REQUESTS || *count <= 0)
+    return (MPI_Request*)frequests;
+  crequests = (MPI_Request*)reserve(F77_REQUESTS, *count * sizeof(MPI_Request));
   for(i = 0; i < *count; ++i)
     crequests[i] = MPI_Request_f2c(frequests[i]);
   return crequests;
@@ -56,28 +181,26 @@ static inline MPI_Request* clone_requests(MPI_Fint *count, MPI_Fint *frequests)
 
 static inline void update_requests(MPI_Fint *count, MPI_Request *crequests, MPI_Fint *frequests) {
   int i;
+  if((void*)crequests == (void*)frequests)
+    return;
   for(i = 0; i < *count; ++i)
     frequests[i] = MPI_Request_c2f(crequests[i]);
-  free(crequests);
 }
 
 static inline MPI_Status* start_inbound_status(MPI_Fint *status) {
+  MPI_Status *cstatus = &get_buffers()->status;
   init_constants();
-  if(! static_status)
-    static_status = (MPI_Status*)calloc(1, sizeof(MPI_Status));
   assert((status != f77_status_ignore) && (status != f77_statuses_ignore));
-  MPI_Status_f2c(status, static_status);
-  return static_status;
+  MPI_Status_f2c(status, cstatus);
+  return cstatus;
 }
 
 static inline MPI_Status* start_outbound_status(MPI_Fint *status) {
   init_constants();
-  if(! static_status)
-    static_status = (MPI_Status*)calloc(1, sizeof(MPI_Status));
   if((status == f77_status_ignore) || (status == f77_statuses_ignore))
     return MPI_STATUS_IGNORE;
   else
-    return static_status;
+    return &get_buffers()->status;
 }
 
 static inline void finish_status(MPI_Status *cstatus, MPI_Fint *fstatus) {
@@ -90,11 +213,8 @@ static inline MPI_Status* start_outbound_statuses(MPI_Fint *count, MPI_Fint *sta
   init_constants();
   if((*count <= 0) || (statuses == f77_status_ignore) || (statuses == f77_statuses_ignore))
     return MPI_STATUSES_IGNORE;
-  else {
-    MPI_Status *retval = NULL;
-    assert((retval = (MPI_Status*)calloc(*count, sizeof(MPI_Status))) != NULL);
-    return retval;
-  }
+  else
+    return (MPI_Status*)reserve(F77_STATUSES, *count * sizeof(MPI_Status));
 }
 
 static inline MPI_Status* start_inbound_statuses(MPI_Fint *count, MPI_Fint *statuses) {
@@ -103,7 +223,7 @@ static inline MPI_Status* start_inbound_statuses(MPI_Fint *count, MPI_Fint *stat
   if(cstatus != MPI_STATUS_IGNORE) {
     int i;
     for(i = 0; i < *count; ++i)
-      MPI_Status_f2c(statuses+i, cstatus+i);
+      MPI_Status_f2c(statuses + i*f77_status_size, cstatus+i);
   }
   return cstatus;
 }
@@ -113,8 +233,7 @@ static inline void finish_statuses(MPI_Fint *count, MPI_Status *cstatuses, MPI_F
   if(cstatuses != MPI_STATUSES_IGNORE) {
     int i;
     for(i = 0; i < *count; ++i)
-      MPI_Status_c2f(cstatuses+i, fstatuses+i);
-    free(cstatuses);
+      MPI_Status_c2f(cstatuses+i, fstatuses + i*f77_status_size);
   }
 }
 
@@ -320,15 +439,13 @@ void F77_FUNC_(mpi_waitsome, MPI_WAITSOME)(MPI_Fint *count, MPI_Fint *requests,
   int *cindices;
   int coutcount;
   crequests = clone_requests(count, requests);
-  assert((cindices = (int*)calloc(*count, sizeof(int))) != NULL);
+  cindices = fint_outarray(F77_INDICES, *count, indices);
   cstatuses = start_outbound_statuses(count, statuses);
   *ierr = MPI_Waitsome(*count, crequests, &coutcount, cindices, cstatuses);
   update_requests(count, crequests, requests);
   *outcount = coutcount;
-  if(coutcount != MPI_UNDEFINED) {
-    int i;
-    for(i = 0; i < coutcount; ++i) indices[i] = cindices[i];
-  }
+  if(coutcount != MPI_UNDEFINED)
+    finish_fint_array(coutcount, cindices, indices);
   finish_statuses(count, cstatuses, statuses);
 }
 
@@ -339,15 +456,13 @@ void F77_FUNC_(mpi_testsome, MPI_TESTSOME)(MPI_Fint *count, MPI_Fint *requests,
   int *cindices;
   int coutcount;
   crequests = clone_requests(count, requests);
-  assert((cindices = (int*)calloc(*count, sizeof(int))) != NULL);
+  cindices = fint_outarray(F77_INDICES, *count, indices);
   cstatuses = start_outbound_statuses(count, statuses);
   *ierr = MPI_Testsome(*count, crequests, &coutcount, cindices, cstatuses);
   update_requests(count, crequests, requests);
   *outcount = coutcount;
-  if(coutcount != MPI_UNDEFINED) {
-    int i;
-    for(i = 0; i < coutcount; ++i) indices[i] = cindices[i];
-  }
+  if(coutcount != MPI_UNDEFINED)
+    finish_fint_array(coutcount, cindices, indices);
   finish_statuses(count, cstatuses, statuses);
 }
 
@@ -469,51 +584,32 @@ void F77_FUNC_(mpi_type_hvector, MPI_TYPE_HVECTOR)(MPI_Fint *count, MPI_Fint *bl
 
 void F77_FUNC_(mpi_type_indexed, MPI_TYPE_INDEXED)(MPI_Fint *count, MPI_Fint *lengths, MPI_Fint *indices, MPI_Fint *oldtype, MPI_Fint *newtype, MPI_Fint *ierr)
 {
-  int i;
   int *clengths, *cindices;
   MPI_Datatype cnewtype;
-  assert((clengths = (int*)calloc(*count, sizeof(int))) != NULL);
-  assert((cindices = (int*)calloc(*count, sizeof(int))) != NULL);
-  for(i = 0; i < *count; ++i) {
-    clengths[i] = lengths[i];
-    cindices[i] = indices[i];
-  }
+  clengths = fint_array(F77_INTS0, *count, lengths);
+  cindices = fint_array(F77_INTS1, *count, indices);
   *ierr = MPI_Type_indexed(*count, clengths, cindices, MPI_Type_f2c(*oldtype), &cnewtype);
   *newtype = MPI_Type_c2f(cnewtype);
-  free(clengths);
-  free(cindices);
 }
 
 void F77_FUNC_(mpi_type_hindexed, MPI_TYPE_HINDEXED)(MPI_Fint *count, MPI_Fint *lengths, MPI_Aint *indices, MPI_Fint *oldtype, MPI_Fint *newtype, MPI_Fint *ierr)
 {
-  int i;
   int *clengths;
   MPI_Datatype cnewtype;
-  assert((clengths = (int*)calloc(*count, sizeof(int))) != NULL);
-  for(i = 0; i < *count; ++i) {
-    clengths[i] = lengths[i];
-  }
+  clengths = fint_array(F77_INTS0, *count, lengths);
   *ierr = MPI_Type_hindexed(*count, clengths, indices, MPI_Type_f2c(*oldtype), &cnewtype);
   *newtype = MPI_Type_c2f(cnewtype);
-  free(clengths);
 }
 
 void F77_FUNC_(mpi_type_struct, MPI_TYPE_STRUCT)(MPI_Fint *count, MPI_Fint *lengths, MPI_Aint *indices, MPI_Fint *oldtypes, MPI_Fint *newtype, MPI_Fint *ierr)
 {
-  int i;
   int *clengths;
   MPI_Datatype *coldtypes;
   MPI_Datatype cnewtype;
-  assert((clengths = (int*)calloc(*count, sizeof(int))) != NULL);
-  assert((coldtypes = (MPI_Datatype*)calloc(*count, sizeof(MPI_Datatype))) != NULL);
-  for(i = 0; i < *count; ++i) {
-    clengths[i] = lengths[i];
-    coldtypes[i] = MPI_Type_f2c(oldtypes[i]);
-  }
-  *ierr = MPI_Type_struct(*count, lengths, indices, coldtypes, &cnewtype);
+  clengths = fint_array(F77_INTS0, *count, lengths);
+  coldtypes = ftype_array(F77_TYPES0, *count, oldtypes);
+  *ierr = MPI_Type_struct(*count, clengths, indices, coldtypes, &cnewtype);
   *newtype = MPI_Type_c2f(cnewtype);
-  free(coldtypes);
-  free(clengths);
 }
 
 void F77_FUNC_(mpi_address, MPI_ADDRESS)(void *buf, MPI_Aint *address, MPI_Fint *ierr)
@@ -603,21 +699,19 @@ void F77_FUNC_(mpi_gather, MPI_GATHER)(void *inbuf, MPI_Fint *sendcount, MPI_Fin
 
 void F77_FUNC_(mpi_gatherv, MPI_GATHERV)(void *sendbuf, MPI_Fint *sendcount, MPI_Fint *sendtype, void *recvbuf, MPI_Fint *recvcounts, MPI_Fint *displs, MPI_Fint *recvtype, MPI_Fint *root, MPI_Fint *comm, MPI_Fint *ierr)
 {
-  int i, commsize, commrank;
+  int commsize, commrank;
   int *crecvcounts, *cdispls;
   PMPI_Comm_size(MPI_Comm_f2c(*comm), &commsize);
   PMPI_Comm_rank(MPI_Comm_f2c(*comm), &commrank);
-  assert((crecvcounts = (int*)calloc(commsize, sizeof(int))) != NULL);
-  assert((cdispls = (int*)calloc(commsize, sizeof(int))) != NULL);
   if(commrank == *root) {
-    for(i = 0; i < commsize; ++i) {
-      crecvcounts[i] = recvcounts[i];
-      cdispls[i] = displs[i];
-    }
+    crecvcounts = fint_array(F77_INTS0, commsize, recvcounts);
+    cdispls = fint_array(F77_INTS1, commsize, displs);
+  }
+  else {
+    /* Only significant at root (the Fortran arrays may be dummies) */
+    crecvcounts = cdispls = zero_array(F77_INTS0, commsize);
   }
   *ierr = MPI_Gatherv(sendbuf, *sendcount, MPI_Type_f2c(*sendtype), recvbuf, crecvcounts, cdispls, MPI_Type_f2c(*recvtype), *root, MPI_Comm_f2c(*comm));
-  free(crecvcounts);
-  free(cdispls);
 }
 
 void F77_FUNC_(mpi_scatter, MPI_SCATTER)(void *sendbuf, MPI_Fint *sendcount, MPI_Fint *sendtype, void *recvbuf, MPI_Fint *recvcount, MPI_Fint *recvtype, MPI_Fint *root, MPI_Fint *comm, MPI_Fint *ierr)
@@ -627,21 +721,19 @@ void F77_FUNC_(mpi_scatter, MPI_SCATTER)(void *sendbuf, MPI_Fint *sendcount, MPI
 
 void F77_FUNC_(mpi_scatterv, MPI_SCATTERV)(void *sendbuf, MPI_Fint *sendcounts, MPI_Fint *displs, MPI_Fint *sendtype, void *recvbuf, MPI_Fint *recvcount, MPI_Fint *recvtype, MPI_Fint *root, MPI_Fint *comm, MPI_Fint *ierr)
 {
-  int i, commsize, commrank;
+  int commsize, commrank;
   int *csendcounts, *cdispls;
   PMPI_Comm_size(MPI_Comm_f2c(*comm), &commsize);
   PMPI_Comm_rank(MPI_Comm_f2c(*comm), &commrank);
-  assert((csendcounts = (int*)calloc(commsize, sizeof(int))) != NULL);
-  assert((cdispls = (int*)calloc(commsize, sizeof(int))) != NULL);
   if(commrank == *root) {
-    for(i = 0; i < commsize; ++i) {
-      csendcounts[i] = sendcounts[i];
-      cdispls[i] = displs[i];
-    }
+    csendcounts = fint_array(F77_INTS0, commsize, sendcounts);
+    cdispls = fint_array(F77_INTS1, commsize, displs);
+  }
+  else {
+    /* Only significant at root (the Fortran arrays may be dummies) */
+    csendcounts = cdispls = zero_array(F77_INTS0, commsize);
   }
   *ierr = MPI_Scatterv(sendbuf, csendcounts, cdispls, MPI_Type_f2c(*sendtype), recvbuf, *recvcount, MPI_Type_f2c(*recvtype), *root, MPI_Comm_f2c(*comm));
-  free(csendcounts);
-  free(cdispls);
 }
 
 void F77_FUNC_(mpi_allgather, MPI_ALLGATHER)(void *sendbuf, MPI_Fint *sendcount, MPI_Fint *sendtype, void *recvbuf, MPI_Fint *recvcount, MPI_Fint *recvtype, MPI_Fint *comm, MPI_Fint *ierr)
@@ -651,18 +743,12 @@ void F77_FUNC_(mpi_allgather, MPI_ALLGATHER)(void *sendbuf, MPI_Fint *sendcount,
 
 void F77_FUNC_(mpi_allgatherv, MPI_ALLGATHERV)(void *sendbuf, MPI_Fint *sendcount, MPI_Fint *sendtype, void *recvbuf, MPI_Fint *recvcounts, MPI_Fint *displs, MPI_Fint *recvtype, MPI_Fint *comm, MPI_Fint *ierr)
 {
-  int i, commsize;
+  int commsize;
   int *crecvcounts, *cdispls;
   PMPI_Comm_size(MPI_Comm_f2c(*comm), &commsize);
-  assert((crecvcounts = (int*)calloc(commsize, sizeof(int))) != NULL);
-  assert((cdispls = (int*)calloc(commsize, sizeof(int))) != NULL);
-  for(i = 0; i < commsize; ++i) {
-    crecvcounts[i] = recvcounts[i];
-    cdispls[i] = displs[i];
-  }
+  crecvcounts = fint_array(F77_INTS0, commsize, recvcounts);
+  cdispls = fint_array(F77_INTS1, commsize, displs);
   *ierr = MPI_Allgatherv(sendbuf, *sendcount, MPI_Type_f2c(*sendtype), recvbuf, crecvcounts, cdispls, MPI_Type_f2c(*recvtype), MPI_Comm_f2c(*comm));
-  free(crecvcounts);
-  free(cdispls);
 }
 
 void F77_FUNC_(mpi_alltoall, MPI_ALLTOALL)(void *sendbuf, MPI_Fint *sendcount, MPI_Fint *sendtype, void *recvbuf, MPI_Fint *recvcount, MPI_Fint *recvtype, MPI_Fint *comm, MPI_Fint *ierr)
@@ -672,24 +758,14 @@ void F77_FUNC_(mpi_alltoall, MPI_ALLTOALL)(void *sendbuf, MPI_Fint *sendcount, M
 
 void F77_FUNC_(mpi_alltoallv, MPI_ALLTOALLV)(void *sendbuf, MPI_Fint *sendcounts, MPI_Fint *senddispls, MPI_Fint *sendtype, void *recvbuf, MPI_Fint *recvcounts, MPI_Fint *recvdispls, MPI_Fint *recvtype, MPI_Fint *comm, MPI_Fint *ierr)
 {
-  int i, commsize;
+  int commsize;
   int *csendcounts, *csenddispls, *crecvcounts, *crecvdispls;
   PMPI_Comm_size(MPI_Comm_f2c(*comm), &commsize);
-  assert((csendcounts = (int*)calloc(commsize, sizeof(int))) != NULL);
-  assert((csenddispls = (int*)calloc(commsize, sizeof(int))) != NULL);
-  assert((crecvcounts = (int*)calloc(commsize, sizeof(int))) != NULL);
-  assert((crecvdispls = (int*)calloc(commsize, sizeof(int))) != NULL);
-  for(i = 0; i < commsize; ++i) {
-    csendcounts[i] = sendcounts[i];
-    csenddispls[i] = senddispls[i];
-    crecvcounts[i] = recvcounts[i];
-    crecvdispls[i] = recvdispls[i];
-  }
+  csendcounts = fint_array(F77_INTS0, commsize, sendcounts);
+  csenddispls = fint_array(F77_INTS1, commsize, senddispls);
+  crecvcounts = fint_array(F77_INTS2, commsize, recvcounts);
+  crecvdispls = fint_array(F77_INTS3, commsize, recvdispls);
   *ierr = MPI_Alltoallv(sendbuf, csendcounts, csenddispls, MPI_Type_f2c(*sendtype), recvbuf, crecvcounts, crecvdispls, MPI_Type_f2c(*recvtype), MPI_Comm_f2c(*comm));
-  free(csendcounts);
-  free(csenddispls);
-  free(crecvcounts);
-  free(crecvdispls);
 }
 
 void F77_FUNC_(mpi_reduce, MPI_REDUCE)(void *sendbuf, void *recvbuf, MPI_Fint *count, MPI_Fint *datatype, MPI_Fint *op, MPI_Fint *root, MPI_Fint *comm, MPI_Fint *ierr)
@@ -721,12 +797,10 @@ void F77_FUNC_(mpi_allreduce, MPI_ALLREDUCE)(void *sendbuf, void *recvbuf, MPI_F
 
 void F77_FUNC_(mpi_reduce_scatter, MPI_REDUCE_SCATTER)(void *sendbuf, void *recvbuf, MPI_Fint *recvcounts, MPI_Fint *datatype, MPI_Fint *op, MPI_Fint *comm, MPI_Fint *ierr)
 {
-  int i, commsize;
+  int commsize;
   int *crecvcounts;
-  assert((crecvcounts = (int*)calloc(commsize, sizeof(int))) != NULL);
-  for(i = 0; i < commsize; ++i)
-    crecvcounts[i] = recvcounts[i];
   PMPI_Comm_size(MPI_Comm_f2c(*comm), &commsize);
+  crecvcounts = fint_array(F77_INTS0, commsize, recvcounts);
   *ierr = MPI_Reduce_scatter(sendbuf, recvbuf, crecvcounts, MPI_Type_f2c(*datatype), MPI_Op_f2c(*op), MPI_Comm_f2c(*comm));
 }
 
@@ -1401,31 +1475,17 @@ void F77_FUNC_(mpi_win_wait, MPI_WIN_WAIT)(MPI_Fint *win, MPI_Fint *ierr)
 
 void F77_FUNC_(mpi_alltoallw, MPI_ALLTOALLW)(void *sendbuf, MPI_Fint *sendcounts, MPI_Fint *senddispls, MPI_Fint *sendtypes, void *recvbuf, MPI_Fint *recvcounts, MPI_Fint *recvdispls, MPI_Fint *recvtypes, MPI_Fint *comm, MPI_Fint *ierr)
 {
-  int i, commsize;
+  int commsize;
   int *csendcounts, *csenddispls, *crecvcounts, *crecvdispls;
   MPI_Datatype *csendtypes, *crecvtypes;
   PMPI_Comm_size(MPI_Comm_f2c(*comm), &commsize);
-  assert((csendcounts = (int*)calloc(commsize, sizeof(int))) != NULL);
-  assert((csenddispls = (int*)calloc(commsize, sizeof(int))) != NULL);
-  assert((crecvcounts = (int*)calloc(commsize, sizeof(int))) != NULL);
-  assert((crecvdispls = (int*)calloc(commsize, sizeof(int))) != NULL);
-  assert((csendtypes = (MPI_Datatype*)calloc(commsize, sizeof(MPI_Datatype))) != NULL);
-  assert((crecvtypes = (MPI_Datatype*)calloc(commsize, sizeof(MPI_Datatype))) != NULL);
-  for(i = 0; i < commsize; ++i) {
-    csendcounts[i] = sendcounts[i];
-    csenddispls[i] = senddispls[i];
-    crecvcounts[i] = recvcounts[i];
-    crecvdispls[i] = recvdispls[i];
-    csendtypes[i] = MPI_Type_f2c(sendtypes[i]);
-    crecvtypes[i] = MPI_Type_f2c(recvtypes[i]);
-  }
+  csendcounts = fint_array(F77_INTS0, commsize, sendcounts);
+  csenddispls = fint_array(F77_INTS1, commsize, senddispls);
+  crecvcounts = fint_array(F77_INTS2, commsize, recvcounts);
+  crecvdispls = fint_array(F77_INTS3, commsize, recvdispls);
+  csendtypes = ftype_array(F77_TYPES0, commsize, sendtypes);
+  crecvtypes = ftype_array(F77_TYPES1, commsize, recvtypes);
   *ierr = MPI_Alltoallw(sendbuf, csendcounts, csenddispls, csendtypes, recvbuf, crecvcounts, crecvdispls, crecvtypes, MPI_Comm_f2c(*comm));
-  free(csendcounts);
-  free(csenddispls);
-  free(crecvcounts);
-  free(crecvdispls);
-  free(csendtypes);
-  free(crecvtypes);
 }
 
 void F77_FUNC_(mpi_exscan, MPI_EXSCAN)(void *sendbuf, void *recvbuf, MPI_Fint *count, MPI_Fint *datatype, MPI_Fint *op, MPI_Fint *comm, MPI_Fint *ierr)
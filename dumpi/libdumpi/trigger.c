@@ -0,0 +1,178 @@
+/*
+ *  This file is part of DUMPI:
+ *               The MPI profiling library from the SST suite.
+ *  Copyright (c) 2009-2011 Sandia Corporation.
+ *  This software is distributed under the BSD License.
+ *  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+ *  the U.S. Government retains certain rights in this software.
+ *  For more information, see the LICENSE file in the top
+ *  SST/macroscale directory.
+ */
+
+#include <dumpi/libdumpi/trigger.h>
+#include <dumpi/libdumpi/data.h>
+#include <dumpi/common/funcs.h>
+#include <dumpi/common/settings.h>
+#include <regex.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <time.h>
+
+/* A call count or time interval. */
+typedef struct trigger_point {
+  int            set;
+  /* DUMPI_END_OF_STREAM for a time interval */
+  dumpi_function func;
+  uint32_t       count;
+  time_t         seconds;
+} trigger_point;
+
+/* Trigger state.  Like the sampling counters, this is not protected by
+ * a lock; the worst a race can do is shift a window by a call. */
+static trigger_point start_after, stop_after, repeat_every;
+static regex_t start_regex, stop_regex;
+static int have_start_regex = 0, have_stop_regex = 0;
+static int window_open = 0, windows = 0;
+/* Call counts and time at the start of the run and of the last window */
+static uint32_t *opened_count = NULL;
+static time_t    opened_time = 0;
+static time_t    origin = 0;
+
+/* Parse MPI_Foo:N or Ns. */
+static int parse_point(trigger_point *point, const char *value, int seconds) {
+  char *end = NULL;
+  const char *colon = strchr(value, ':');
+  long number;
+  int func;
+  if(colon != NULL) {
+    for(func = 0; func < DUMPI_ALL_FUNCTIONS; ++func)
+      if(strlen(dumpi_function_names[func]) == (size_t)(colon - value) &&
+	 strncmp(dumpi_function_names[func], value, colon - value) == 0)
+	break;
+    number = strtol(colon+1, &end, 10);
+    if(func == DUMPI_ALL_FUNCTIONS || number <= 0 || *end != '\0')
+      return 0;
+    point->func = (dumpi_function)func;
+    point->count = (uint32_t)number;
+    point->seconds = 0;
+  }
+  else {
+    number = strtol(value, &end, 10);
+    if(number <= 0 || end == value ||
+       !((*end == '\0' && seconds) || strcmp(end, "s") == 0))
+      return 0;
+    point->func = DUMPI_END_OF_STREAM;
+    point->count = 0;
+    point->seconds = (time_t)number;
+  }
+  point->set = 1;
+  return 1;
+}
+
+int libdumpi_trigger_set(libdumpi_trigger_kind kind, const char *value,
+			 int seconds)
+{
+  switch(kind) {
+  case DUMPI_TRIGGER_START_AFTER:
+    return parse_point(&start_after, value, seconds);
+  case DUMPI_TRIGGER_STOP_AFTER:
+    return parse_point(&stop_after, value, seconds);
+  case DUMPI_TRIGGER_REPEAT_EVERY:
+    return parse_point(&repeat_every, value, seconds);
+  case DUMPI_TRIGGER_START_AT_ANNOTATION:
+    if(have_start_regex)
+      regfree(&start_regex);
+    have_start_regex =
+      (regcomp(&start_regex, value, REG_EXTENDED|REG_NOSUB) == 0);
+    return have_start_regex;
+  case DUMPI_TRIGGER_STOP_AT_ANNOTATION:
+    if(have_stop_regex)
+      regfree(&stop_regex);
+    have_stop_regex =
+      (regcomp(&stop_regex, value, REG_EXTENDED|REG_NOSUB) == 0);
+    return have_stop_regex;
+  }
+  return 0;
+}
+
+/* Make the given interval (counted from 'count'/'when') the next trigger. */
+static void set_next(const trigger_point *point, const uint32_t *count,
+		     time_t when)
+{
+  dumpi_global->trigger_func = DUMPI_END_OF_STREAM;
+  dumpi_global->trigger_count = 0;
+  dumpi_global->trigger_time = 0;
+  if(point == NULL || ! point->set)
+    return;
+  if(point->func == DUMPI_END_OF_STREAM) {
+    dumpi_global->trigger_time = when + point->seconds;
+  }
+  else {
+    dumpi_global->trigger_func = point->func;
+    dumpi_global->trigger_count = count[point->func] + point->count;
+  }
+}
+
+static void open_window(void) {
+  const uint32_t *count = dumpi_global->footer->call_count;
+  window_open = 1;
+  ++windows;
+  memcpy(opened_count, count, (DUMPI_ALL_FUNCTIONS+1)*sizeof(uint32_t));
+  opened_time = time(NULL);
+  dumpi_global->output->function[DUMPI_ALL_FUNCTIONS] = DUMPI_ENABLE;
+  set_next(&stop_after, opened_count, opened_time);
+}
+
+static void close_window(void) {
+  window_open = 0;
+  dumpi_global->output->function[DUMPI_ALL_FUNCTIONS] = DUMPI_DISABLE;
+  set_next(&repeat_every, opened_count, opened_time);
+}
+
+void libdumpi_trigger_arm(void) {
+  const uint32_t *count = dumpi_global->footer->call_count;
+  dumpi_global->triggers = (start_after.set || stop_after.set ||
+			    repeat_every.set || have_start_regex ||
+			    have_stop_regex);
+  if(! dumpi_global->triggers)
+    return;
+  if(opened_count == NULL) {
+    opened_count = (uint32_t*)calloc(DUMPI_ALL_FUNCTIONS+1, sizeof(uint32_t));
+    assert(opened_count != NULL);
+  }
+  origin = time(NULL);
+  if(start_after.set || have_start_regex) {
+    window_open = 0;
+    dumpi_global->output->function[DUMPI_ALL_FUNCTIONS] = DUMPI_DISABLE;
+    set_next(&start_after, count, origin);
+  }
+  else {
+    open_window();
+  }
+}
+
+void libdumpi_trigger_fire(void) {
+  if(window_open)
+    close_window();
+  else
+    open_window();
+}
+
+void libdumpi_trigger_annotation(const char *text, int after) {
+  if(! after && ! window_open && have_start_regex &&
+     regexec(&start_regex, text, 0, NULL, 0) == 0)
+  {
+    open_window();
+  }
+  else if(after && window_open && have_stop_regex &&
+	  regexec(&stop_regex, text, 0, NULL, 0) == 0)
+  {
+    close_window();
+  }
+}
+
+int libdumpi_trigger_windows(void) {
+  return windows;
+}
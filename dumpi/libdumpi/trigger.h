@@ -0,0 +1,83 @@
+/*
+ *  This file is part of DUMPI:
+ *               The MPI profiling library from the SST suite.
+ *  Copyright (c) 2009-2011 Sandia Corporation.
+ *  This software is distributed under the BSD License.
+ *  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+ *  the U.S. Government retains certain rights in this software.
+ *  For more information, see the LICENSE file in the top
+ *  SST/macroscale directory.
+ */
+
+#ifndef DUMPI_LIBDUMPI_TRIGGER_H
+#define DUMPI_LIBDUMPI_TRIGGER_H
+
+#include <dumpi/common/funclabels.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* ! __cplusplus */
+
+  /**
+   * \addtogroup libdumpi_internal
+   */
+  /*@{*/
+
+  /**
+   * The triggers that can be set in dumpi.conf.
+   * Tracing is switched on and off for windows of the run by toggling
+   * the DUMPI_ALL_FUNCTIONS setting (just like MPI_Pcontrol(0/1)).
+   */
+  typedef enum libdumpi_trigger_kind {
+    /** Open the first window after MPI_Foo:N calls or N seconds */
+    DUMPI_TRIGGER_START_AFTER=0,
+    /** Close a window after MPI_Foo:N calls or N seconds inside it */
+    DUMPI_TRIGGER_STOP_AFTER,
+    /** Reopen MPI_Foo:N calls or N seconds after the last window opened */
+    DUMPI_TRIGGER_REPEAT_EVERY,
+    /** Open a window when an MPI_Pcontrol annotation matches a regex */
+    DUMPI_TRIGGER_START_AT_ANNOTATION,
+    /** Close a window when an MPI_Pcontrol annotation matches a regex */
+    DUMPI_TRIGGER_STOP_AT_ANNOTATION
+  } libdumpi_trigger_kind;
+
+  /**
+   * Configure a trigger.  Count triggers are given as MPI_Foo:N,
+   * time triggers as a number of seconds with an 's' suffix (the suffix
+   * is optional if seconds is non-zero).
+   * \return non-zero if the value was valid.
+   */
+  int libdumpi_trigger_set(libdumpi_trigger_kind kind, const char *value,
+			   int seconds);
+
+  /**
+   * Set up the initial tracing state once the configuration is complete.
+   * Tracing starts off if any start trigger is configured.
+   * Updates dumpi_global->triggers and the next trigger point.
+   */
+  void libdumpi_trigger_arm(void);
+
+  /**
+   * Open or close the current window (called when the trigger point set
+   * in dumpi_global is reached; see DUMPI_TRIGGER_DUE).
+   */
+  void libdumpi_trigger_fire(void);
+
+  /**
+   * Check an annotation against start-at-annotation (before the annotation
+   * is recorded) or against stop-at-annotation (after it is recorded).
+   */
+  void libdumpi_trigger_annotation(const char *text, int after);
+
+  /**
+   * Number of windows opened so far.
+   */
+  int libdumpi_trigger_windows(void);
+
+  /*@}*/
+
+#ifdef __cplusplus
+} /* end of extern "C" */
+#endif /* ! __cplusplus */
+
+#endif /* ! DUMPI_LIBDUMPI_TRIGGER_H */
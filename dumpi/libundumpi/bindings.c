@@ -5106,6 +5106,482 @@ int libdumpi_grab_io_testsome(dumpi_profile *profile, libundumpi_unsafe_fun call
   return 1;
 }
 
+int libundumpi_grab_ibarrier(dumpi_profile *profile, libundumpi_unsafe_fun callout, void *uarg) {
+  dumpi_ibarrier val;
+  uint16_t thread;
+  dumpi_time cpu, wall;
+  dumpi_perfinfo perf;
+  memset(&val, 0, sizeof(dumpi_ibarrier));
+  thread = 0;
+  memset(&cpu, 0, sizeof(dumpi_time));
+  memset(&wall, 0, sizeof(dumpi_time));
+  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  dumpi_read_ibarrier(&val, &thread, &cpu, &wall, &perf, profile);
+  if(callout != NULL)
+    ((dumpi_ibarrier_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+  DUMPI_RELEASE_PERFTAGS(perf);
+  return 1;
+}
+
+int libundumpi_grab_ibcast(dumpi_profile *profile, libundumpi_unsafe_fun callout, void *uarg) {
+  dumpi_ibcast val;
+  uint16_t thread;
+  dumpi_time cpu, wall;
+  dumpi_perfinfo perf;
+  memset(&val, 0, sizeof(dumpi_ibcast));
+  thread = 0;
+  memset(&cpu, 0, sizeof(dumpi_time));
+  memset(&wall, 0, sizeof(dumpi_time));
+  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  dumpi_read_ibcast(&val, &thread, &cpu, &wall, &perf, profile);
+  if(callout != NULL)
+    ((dumpi_ibcast_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+  DUMPI_RELEASE_PERFTAGS(perf);
+  return 1;
+}
+
+int libundumpi_grab_igather(dumpi_profile *profile, libundumpi_unsafe_fun callout, void *uarg) {
+  dumpi_igather val;
+  uint16_t thread;
+  dumpi_time cpu, wall;
+  dumpi_perfinfo perf;
+  memset(&val, 0, sizeof(dumpi_igather));
+  thread = 0;
+  memset(&cpu, 0, sizeof(dumpi_time));
+  memset(&wall, 0, sizeof(dumpi_time));
+  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  dumpi_read_igather(&val, &thread, &cpu, &wall, &perf, profile);
+  if(callout != NULL)
+    ((dumpi_igather_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+  DUMPI_RELEASE_PERFTAGS(perf);
+  return 1;
+}
+
+int libundumpi_grab_igatherv(dumpi_profile *profile, libundumpi_unsafe_fun callout, void *uarg) {
+  dumpi_igatherv val;
+  uint16_t thread;
+  dumpi_time cpu, wall;
+  dumpi_perfinfo perf;
+  memset(&val, 0, sizeof(dumpi_igatherv));
+  thread = 0;
+  memset(&cpu, 0, sizeof(dumpi_time));
+  memset(&wall, 0, sizeof(dumpi_time));
+  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  dumpi_read_igatherv(&val, &thread, &cpu, &wall, &perf, profile);
+  if(callout != NULL)
+    ((dumpi_igatherv_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+  if(val.recvcounts != NULL) DUMPI_FREE_INT(val.recvcounts);
+  if(val.displs != NULL) DUMPI_FREE_INT(val.displs);
+  DUMPI_RELEASE_PERFTAGS(perf);
+  return 1;
+}
+
+int libundumpi_grab_iscatter(dumpi_profile *profile, libundumpi_unsafe_fun callout, void *uarg) {
+  dumpi_iscatter val;
+  uint16_t thread;
+  dumpi_time cpu, wall;
+  dumpi_perfinfo perf;
+  memset(&val, 0, sizeof(dumpi_iscatter));
+  thread = 0;
+  memset(&cpu, 0, sizeof(dumpi_time));
+  memset(&wall, 0, sizeof(dumpi_time));
+  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  dumpi_read_iscatter(&val, &thread, &cpu, &wall, &perf, profile);
+  if(callout != NULL)
+    ((dumpi_iscatter_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+  DUMPI_RELEASE_PERFTAGS(perf);
+  return 1;
+}
+
+int libundumpi_grab_iscatterv(dumpi_profile *profile, libundumpi_unsafe_fun callout, void *uarg) {
+  dumpi_iscatterv val;
+  uint16_t thread;
+  dumpi_time cpu, wall;
+  dumpi_perfinfo perf;
+  memset(&val, 0, sizeof(dumpi_iscatterv));
+  thread = 0;
+  memset(&cpu, 0, sizeof(dumpi_time));
+  memset(&wall, 0, sizeof(dumpi_time));
+  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  dumpi_read_iscatterv(&val, &thread, &cpu, &wall, &perf, profile);
+  if(callout != NULL)
+    ((dumpi_iscatterv_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+  if(val.sendcounts != NULL) DUMPI_FREE_INT(val.sendcounts);
+  if(val.displs != NULL) DUMPI_FREE_INT(val.displs);
+  DUMPI_RELEASE_PERFTAGS(perf);
+  return 1;
+}
+
+int libundumpi_grab_iallgather(dumpi_profile *profile, libundumpi_unsafe_fun callout, void *uarg) {
+  dumpi_iallgather val;
+  uint16_t thread;
+  dumpi_time cpu, wall;
+  dumpi_perfinfo perf;
+  memset(&val, 0, sizeof(dumpi_iallgather));
+  thread = 0;
+  memset(&cpu, 0, sizeof(dumpi_time));
+  memset(&wall, 0, sizeof(dumpi_time));
+  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  dumpi_read_iallgather(&val, &thread, &cpu, &wall, &perf, profile);
+  if(callout != NULL)
+    ((dumpi_iallgather_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+  DUMPI_RELEASE_PERFTAGS(perf);
+  return 1;
+}
+
+int libundumpi_grab_iallgatherv(dumpi_profile *profile, libundumpi_unsafe_fun callout, void *uarg) {
+  dumpi_iallgatherv val;
+  uint16_t thread;
+  dumpi_time cpu, wall;
+  dumpi_perfinfo perf;
+  memset(&val, 0, sizeof(dumpi_iallgatherv));
+  thread = 0;
+  memset(&cpu, 0, sizeof(dumpi_time));
+  memset(&wall, 0, sizeof(dumpi_time));
+  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  dumpi_read_iallgatherv(&val, &thread, &cpu, &wall, &perf, profile);
+  if(callout != NULL)
+    ((dumpi_iallgatherv_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+  if(val.recvcounts != NULL) DUMPI_FREE_INT(val.recvcounts);
+  if(val.displs != NULL) DUMPI_FREE_INT(val.displs);
+  DUMPI_RELEASE_PERFTAGS(perf);
+  return 1;
+}
+
+int libundumpi_grab_ialltoall(dumpi_profile *profile, libundumpi_unsafe_fun callout, void *uarg) {
+  dumpi_ialltoall val;
+  uint16_t thread;
+  dumpi_time cpu, wall;
+  dumpi_perfinfo perf;
+  memset(&val, 0, sizeof(dumpi_ialltoall));
+  thread = 0;
+  memset(&cpu, 0, sizeof(dumpi_time));
+  memset(&wall, 0, sizeof(dumpi_time));
+  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  dumpi_read_ialltoall(&val, &thread, &cpu, &wall, &perf, profile);
+  if(callout != NULL)
+    ((dumpi_ialltoall_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+  DUMPI_RELEASE_PERFTAGS(perf);
+  return 1;
+}
+
+int libundumpi_grab_ialltoallv(dumpi_profile *profile, libundumpi_unsafe_fun callout, void *uarg) {
+  dumpi_ialltoallv val;
+  uint16_t thread;
+  dumpi_time cpu, wall;
+  dumpi_perfinfo perf;
+  memset(&val, 0, sizeof(dumpi_ialltoallv));
+  thread = 0;
+  memset(&cpu, 0, sizeof(dumpi_time));
+  memset(&wall, 0, sizeof(dumpi_time));
+  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  dumpi_read_ialltoallv(&val, &thread, &cpu, &wall, &perf, profile);
+  if(callout != NULL)
+    ((dumpi_ialltoallv_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+  if(val.sendcounts != NULL) DUMPI_FREE_INT(val.sendcounts);
+  if(val.senddispls != NULL) DUMPI_FREE_INT(val.senddispls);
+  if(val.recvcounts != NULL) DUMPI_FREE_INT(val.recvcounts);
+  if(val.recvdispls != NULL) DUMPI_FREE_INT(val.recvdispls);
+  DUMPI_RELEASE_PERFTAGS(perf);
+  return 1;
+}
+
+int libundumpi_grab_ialltoallw(dumpi_profile *profile, libundumpi_unsafe_fun callout, void *uarg) {
+  dumpi_ialltoallw val;
+  uint16_t thread;
+  dumpi_time cpu, wall;
+  dumpi_perfinfo perf;
+  memset(&val, 0, sizeof(dumpi_ialltoallw));
+  thread = 0;
+  memset(&cpu, 0, sizeof(dumpi_time));
+  memset(&wall, 0, sizeof(dumpi_time));
+  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  dumpi_read_ialltoallw(&val, &thread, &cpu, &wall, &perf, profile);
+  if(callout != NULL)
+    ((dumpi_ialltoallw_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+  if(val.sendcounts != NULL) DUMPI_FREE_INT(val.sendcounts);
+  if(val.senddispls != NULL) DUMPI_FREE_INT(val.senddispls);
+  if(val.sendtypes != NULL) DUMPI_FREE_DATATYPE(val.sendtypes);
+  if(val.recvcounts != NULL) DUMPI_FREE_INT(val.recvcounts);
+  if(val.recvdispls != NULL) DUMPI_FREE_INT(val.recvdispls);
+  if(val.recvtypes != NULL) DUMPI_FREE_DATATYPE(val.recvtypes);
+  DUMPI_RELEASE_PERFTAGS(perf);
+  return 1;
+}
+
+int libundumpi_grab_ireduce(dumpi_profile *profile, libundumpi_unsafe_fun callout, void *uarg) {
+  dumpi_ireduce val;
+  uint16_t thread;
+  dumpi_time cpu, wall;
+  dumpi_perfinfo perf;
+  memset(&val, 0, sizeof(dumpi_ireduce));
+  thread = 0;
+  memset(&cpu, 0, sizeof(dumpi_time));
+  memset(&wall, 0, sizeof(dumpi_time));
+  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  dumpi_read_ireduce(&val, &thread, &cpu, &wall, &perf, profile);
+  if(callout != NULL)
+    ((dumpi_ireduce_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+  DUMPI_RELEASE_PERFTAGS(perf);
+  return 1;
+}
+
+int libundumpi_grab_iallreduce(dumpi_profile *profile, libundumpi_unsafe_fun callout, void *uarg) {
+  dumpi_iallreduce val;
+  uint16_t thread;
+  dumpi_time cpu, wall;
+  dumpi_perfinfo perf;
+  memset(&val, 0, sizeof(dumpi_iallreduce));
+  thread = 0;
+  memset(&cpu, 0, sizeof(dumpi_time));
+  memset(&wall, 0, sizeof(dumpi_time));
+  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  dumpi_read_iallreduce(&val, &thread, &cpu, &wall, &perf, profile);
+  if(callout != NULL)
+    ((dumpi_iallreduce_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+  DUMPI_RELEASE_PERFTAGS(perf);
+  return 1;
+}
+
+int libundumpi_grab_ireduce_scatter(dumpi_profile *profile, libundumpi_unsafe_fun callout, void *uarg) {
+  dumpi_ireduce_scatter val;
+  uint16_t thread;
+  dumpi_time cpu, wall;
+  dumpi_perfinfo perf;
+  memset(&val, 0, sizeof(dumpi_ireduce_scatter));
+  thread = 0;
+  memset(&cpu, 0, sizeof(dumpi_time));
+  memset(&wall, 0, sizeof(dumpi_time));
+  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  dumpi_read_ireduce_scatter(&val, &thread, &cpu, &wall, &perf, profile);
+  if(callout != NULL)
+    ((dumpi_ireduce_scatter_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+  if(val.recvcounts != NULL) DUMPI_FREE_INT(val.recvcounts);
+  DUMPI_RELEASE_PERFTAGS(perf);
+  return 1;
+}
+
+int libundumpi_grab_iscan(dumpi_profile *profile, libundumpi_unsafe_fun callout, void *uarg) {
+  dumpi_iscan val;
+  uint16_t thread;
+  dumpi_time cpu, wall;
+  dumpi_perfinfo perf;
+  memset(&val, 0, sizeof(dumpi_iscan));
+  thread = 0;
+  memset(&cpu, 0, sizeof(dumpi_time));
+  memset(&wall, 0, sizeof(dumpi_time));
+  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  dumpi_read_iscan(&val, &thread, &cpu, &wall, &perf, profile);
+  if(callout != NULL)
+    ((dumpi_iscan_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+  DUMPI_RELEASE_PERFTAGS(perf);
+  return 1;
+}
+
+int libundumpi_grab_iexscan(dumpi_profile *profile, libundumpi_unsafe_fun callout, void *uarg) {
+  dumpi_iexscan val;
+  uint16_t thread;
+  dumpi_time cpu, wall;
+  dumpi_perfinfo perf;
+  memset(&val, 0, sizeof(dumpi_iexscan));
+  thread = 0;
+  memset(&cpu, 0, sizeof(dumpi_time));
+  memset(&wall, 0, sizeof(dumpi_time));
+  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  dumpi_read_iexscan(&val, &thread, &cpu, &wall, &perf, profile);
+  if(callout != NULL)
+    ((dumpi_iexscan_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+  DUMPI_RELEASE_PERFTAGS(perf);
+  return 1;
+}
+
+int libundumpi_grab_dist_graph_create_adjacent(dumpi_profile *profile, libundumpi_unsafe_fun callout, void *uarg) {
+  dumpi_dist_graph_create_adjacent val;
+  uint16_t thread;
+  dumpi_time cpu, wall;
+  dumpi_perfinfo perf;
+  memset(&val, 0, sizeof(dumpi_dist_graph_create_adjacent));
+  thread = 0;
+  memset(&cpu, 0, sizeof(dumpi_time));
+  memset(&wall, 0, sizeof(dumpi_time));
+  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  dumpi_read_dist_graph_create_adjacent(&val, &thread, &cpu, &wall, &perf, profile);
+  if(callout != NULL)
+    ((dumpi_dist_graph_create_adjacent_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+  if(val.sources != NULL) DUMPI_FREE_INT(val.sources);
+  if(val.destinations != NULL) DUMPI_FREE_INT(val.destinations);
+  DUMPI_RELEASE_PERFTAGS(perf);
+  return 1;
+}
+
+int libundumpi_grab_neighbor_allgather(dumpi_profile *profile, libundumpi_unsafe_fun callout, void *uarg) {
+  dumpi_neighbor_allgather val;
+  uint16_t thread;
+  dumpi_time cpu, wall;
+  dumpi_perfinfo perf;
+  memset(&val, 0, sizeof(dumpi_neighbor_allgather));
+  thread = 0;
+  memset(&cpu, 0, sizeof(dumpi_time));
+  memset(&wall, 0, sizeof(dumpi_time));
+  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  dumpi_read_neighbor_allgather(&val, &thread, &cpu, &wall, &perf, profile);
+  if(callout != NULL)
+    ((dumpi_neighbor_allgather_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+  DUMPI_RELEASE_PERFTAGS(perf);
+  return 1;
+}
+
+int libundumpi_grab_neighbor_allgatherv(dumpi_profile *profile, libundumpi_unsafe_fun callout, void *uarg) {
+  dumpi_neighbor_allgatherv val;
+  uint16_t thread;
+  dumpi_time cpu, wall;
+  dumpi_perfinfo perf;
+  memset(&val, 0, sizeof(dumpi_neighbor_allgatherv));
+  thread = 0;
+  memset(&cpu, 0, sizeof(dumpi_time));
+  memset(&wall, 0, sizeof(dumpi_time));
+  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  dumpi_read_neighbor_allgatherv(&val, &thread, &cpu, &wall, &perf, profile);
+  if(callout != NULL)
+    ((dumpi_neighbor_allgatherv_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+  if(val.recvcounts != NULL) DUMPI_FREE_INT(val.recvcounts);
+  if(val.displs != NULL) DUMPI_FREE_INT(val.displs);
+  DUMPI_RELEASE_PERFTAGS(perf);
+  return 1;
+}
+
+int libundumpi_grab_neighbor_alltoall(dumpi_profile *profile, libundumpi_unsafe_fun callout, void *uarg) {
+  dumpi_neighbor_alltoall val;
+  uint16_t thread;
+  dumpi_time cpu, wall;
+  dumpi_perfinfo perf;
+  memset(&val, 0, sizeof(dumpi_neighbor_alltoall));
+  thread = 0;
+  memset(&cpu, 0, sizeof(dumpi_time));
+  memset(&wall, 0, sizeof(dumpi_time));
+  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  dumpi_read_neighbor_alltoall(&val, &thread, &cpu, &wall, &perf, profile);
+  if(callout != NULL)
+    ((dumpi_neighbor_alltoall_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+  DUMPI_RELEASE_PERFTAGS(perf);
+  return 1;
+}
+
+int libundumpi_grab_neighbor_alltoallv(dumpi_profile *profile, libundumpi_unsafe_fun callout, void *uarg) {
+  dumpi_neighbor_alltoallv val;
+  uint16_t thread;
+  dumpi_time cpu, wall;
+  dumpi_perfinfo perf;
+  memset(&val, 0, sizeof(dumpi_neighbor_alltoallv));
+  thread = 0;
+  memset(&cpu, 0, sizeof(dumpi_time));
+  memset(&wall, 0, sizeof(dumpi_time));
+  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  dumpi_read_neighbor_alltoallv(&val, &thread, &cpu, &wall, &perf, profile);
+  if(callout != NULL)
+    ((dumpi_neighbor_alltoallv_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+  if(val.sendcounts != NULL) DUMPI_FREE_INT(val.sendcounts);
+  if(val.senddispls != NULL) DUMPI_FREE_INT(val.senddispls);
+  if(val.recvcounts != NULL) DUMPI_FREE_INT(val.recvcounts);
+  if(val.recvdispls != NULL) DUMPI_FREE_INT(val.recvdispls);
+  DUMPI_RELEASE_PERFTAGS(perf);
+  return 1;
+}
+
+int libundumpi_grab_neighbor_alltoallw(dumpi_profile *profile, libundumpi_unsafe_fun callout, void *uarg) {
+  dumpi_neighbor_alltoallw val;
+  uint16_t thread;
+  dumpi_time cpu, wall;
+  dumpi_perfinfo perf;
+  memset(&val, 0, sizeof(dumpi_neighbor_alltoallw));
+  thread = 0;
+  memset(&cpu, 0, sizeof(dumpi_time));
+  memset(&wall, 0, sizeof(dumpi_time));
+  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  dumpi_read_neighbor_alltoallw(&val, &thread, &cpu, &wall, &perf, profile);
+  if(callout != NULL)
+    ((dumpi_neighbor_alltoallw_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+  if(val.sendcounts != NULL) DUMPI_FREE_INT(val.sendcounts);
+  if(val.senddispls != NULL) DUMPI_FREE_INT(val.senddispls);
+  if(val.sendtypes != NULL) DUMPI_FREE_DATATYPE(val.sendtypes);
+  if(val.recvcounts != NULL) DUMPI_FREE_INT(val.recvcounts);
+  if(val.recvdispls != NULL) DUMPI_FREE_INT(val.recvdispls);
+  if(val.recvtypes != NULL) DUMPI_FREE_DATATYPE(val.recvtypes);
+  DUMPI_RELEASE_PERFTAGS(perf);
+  return 1;
+}
+
+int libundumpi_grab_mprobe(dumpi_profile *profile, libundumpi_unsafe_fun callout, void *uarg) {
+  dumpi_mprobe val;
+  uint16_t thread;
+  dumpi_time cpu, wall;
+  dumpi_perfinfo perf;
+  memset(&val, 0, sizeof(dumpi_mprobe));
+  thread = 0;
+  memset(&cpu, 0, sizeof(dumpi_time));
+  memset(&wall, 0, sizeof(dumpi_time));
+  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  dumpi_read_mprobe(&val, &thread, &cpu, &wall, &perf, profile);
+  if(callout != NULL)
+    ((dumpi_mprobe_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+  if(val.status != NULL) DUMPI_FREE_STATUS(val.status);
+  DUMPI_RELEASE_PERFTAGS(perf);
+  return 1;
+}
+
+int libundumpi_grab_improbe(dumpi_profile *profile, libundumpi_unsafe_fun callout, void *uarg) {
+  dumpi_improbe val;
+  uint16_t thread;
+  dumpi_time cpu, wall;
+  dumpi_perfinfo perf;
+  memset(&val, 0, sizeof(dumpi_improbe));
+  thread = 0;
+  memset(&cpu, 0, sizeof(dumpi_time));
+  memset(&wall, 0, sizeof(dumpi_time));
+  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  dumpi_read_improbe(&val, &thread, &cpu, &wall, &perf, profile);
+  if(callout != NULL)
+    ((dumpi_improbe_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+  if(val.status != NULL) DUMPI_FREE_STATUS(val.status);
+  DUMPI_RELEASE_PERFTAGS(perf);
+  return 1;
+}
+
+int libundumpi_grab_mrecv(dumpi_profile *profile, libundumpi_unsafe_fun callout, void *uarg) {
+  dumpi_mrecv val;
+  uint16_t thread;
+  dumpi_time cpu, wall;
+  dumpi_perfinfo perf;
+  memset(&val, 0, sizeof(dumpi_mrecv));
+  thread = 0;
+  memset(&cpu, 0, sizeof(dumpi_time));
+  memset(&wall, 0, sizeof(dumpi_time));
+  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  dumpi_read_mrecv(&val, &thread, &cpu, &wall, &perf, profile);
+  if(callout != NULL)
+    ((dumpi_mrecv_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+  if(val.status != NULL) DUMPI_FREE_STATUS(val.status);
+  DUMPI_RELEASE_PERFTAGS(perf);
+  return 1;
+}
+
+int libundumpi_grab_imrecv(dumpi_profile *profile, libundumpi_unsafe_fun callout, void *uarg) {
+  dumpi_imrecv val;
+  uint16_t thread;
+  dumpi_time cpu, wall;
+  dumpi_perfinfo perf;
+  memset(&val, 0, sizeof(dumpi_imrecv));
+  thread = 0;
+  memset(&cpu, 0, sizeof(dumpi_time));
+  memset(&wall, 0, sizeof(dumpi_time));
+  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  dumpi_read_imrecv(&val, &thread, &cpu, &wall, &perf, profile);
+  if(callout != NULL)
+    ((dumpi_imrecv_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+  DUMPI_RELEASE_PERFTAGS(perf);
+  return 1;
+}
+
 int libundumpi_grab_all_functions(dumpi_profile *profile, libundumpi_unsafe_fun callout, void *uarg) {
   /* This one is a no-op */
   (void)profile;
@@ -5148,6 +5624,41 @@ int libundumpi_grab_function_exit(dumpi_profile *profile, libundumpi_unsafe_fun
   return 1;
 }
 
+int libundumpi_grab_function_call(dumpi_profile *profile, libundumpi_unsafe_fun callout, void *uarg) {
+  dumpi_func_call val;
+  uint16_t thread;
+  dumpi_time cpu, wall;
+  dumpi_perfinfo perf;
+  memset(&val, 0, sizeof(dumpi_func_call));
+  thread = 0;
+  memset(&cpu, 0, sizeof(dumpi_time));
+  memset(&wall, 0, sizeof(dumpi_time));
+  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  dumpi_read_func_call(&val, &thread, &cpu, &wall, &perf, profile);
+  if(callout != NULL)
+    ((dumpi_function_call_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+  DUMPI_RELEASE_PERFTAGS(perf);
+  return 1;
+}
+
+int libundumpi_grab_poll_summary(dumpi_profile *profile, libundumpi_unsafe_fun callout, void *uarg) {
+  dumpi_poll_summary val;
+  uint16_t thread;
+  dumpi_time cpu, wall;
+  dumpi_perfinfo perf;
+  memset(&val, 0, sizeof(dumpi_poll_summary));
+  thread = 0;
+  memset(&cpu, 0, sizeof(dumpi_time));
+  memset(&wall, 0, sizeof(dumpi_time));
+  memset(&perf, 0, sizeof(dumpi_perfinfo));
+  dumpi_read_poll_summary(&val, &thread, &cpu, &wall, &perf, profile);
+  if(callout != NULL)
+    ((dumpi_poll_summary_call)callout)(&val, thread, &cpu, &wall, &perf, uarg);
+  free(val.args);
+  DUMPI_RELEASE_PERFTAGS(perf);
+  return 1;
+}
+
 void libundumpi_populate_callbacks(const libundumpi_callbacks *callback,
            libundumpi_cbpair *callarr)
 {
@@ -5447,9 +5958,37 @@ void libundumpi_populate_callouts(const libundumpi_callbacks *callback,
   callarr[DUMPIO_Waitany].callout = (libundumpi_unsafe_fun)callback->on_iowaitany;
   callarr[DUMPIO_Waitsome].callout = (libundumpi_unsafe_fun)callback->on_iowaitsome;
   callarr[DUMPIO_Testsome].callout = (libundumpi_unsafe_fun)callback->on_iotestsome;
+  callarr[DUMPI_Ibarrier].callout = (libundumpi_unsafe_fun)callback->on_ibarrier;
+  callarr[DUMPI_Ibcast].callout = (libundumpi_unsafe_fun)callback->on_ibcast;
+  callarr[DUMPI_Igather].callout = (libundumpi_unsafe_fun)callback->on_igather;
+  callarr[DUMPI_Igatherv].callout = (libundumpi_unsafe_fun)callback->on_igatherv;
+  callarr[DUMPI_Iscatter].callout = (libundumpi_unsafe_fun)callback->on_iscatter;
+  callarr[DUMPI_Iscatterv].callout = (libundumpi_unsafe_fun)callback->on_iscatterv;
+  callarr[DUMPI_Iallgather].callout = (libundumpi_unsafe_fun)callback->on_iallgather;
+  callarr[DUMPI_Iallgatherv].callout = (libundumpi_unsafe_fun)callback->on_iallgatherv;
+  callarr[DUMPI_Ialltoall].callout = (libundumpi_unsafe_fun)callback->on_ialltoall;
+  callarr[DUMPI_Ialltoallv].callout = (libundumpi_unsafe_fun)callback->on_ialltoallv;
+  callarr[DUMPI_Ialltoallw].callout = (libundumpi_unsafe_fun)callback->on_ialltoallw;
+  callarr[DUMPI_Ireduce].callout = (libundumpi_unsafe_fun)callback->on_ireduce;
+  callarr[DUMPI_Iallreduce].callout = (libundumpi_unsafe_fun)callback->on_iallreduce;
+  callarr[DUMPI_Ireduce_scatter].callout = (libundumpi_unsafe_fun)callback->on_ireduce_scatter;
+  callarr[DUMPI_Iscan].callout = (libundumpi_unsafe_fun)callback->on_iscan;
+  callarr[DUMPI_Iexscan].callout = (libundumpi_unsafe_fun)callback->on_iexscan;
+  callarr[DUMPI_Dist_graph_create_adjacent].callout = (libundumpi_unsafe_fun)callback->on_dist_graph_create_adjacent;
+  callarr[DUMPI_Neighbor_allgather].callout = (libundumpi_unsafe_fun)callback->on_neighbor_allgather;
+  callarr[DUMPI_Neighbor_allgatherv].callout = (libundumpi_unsafe_fun)callback->on_neighbor_allgatherv;
+  callarr[DUMPI_Neighbor_alltoall].callout = (libundumpi_unsafe_fun)callback->on_neighbor_alltoall;
+  callarr[DUMPI_Neighbor_alltoallv].callout = (libundumpi_unsafe_fun)callback->on_neighbor_alltoallv;
+  callarr[DUMPI_Neighbor_alltoallw].callout = (libundumpi_unsafe_fun)callback->on_neighbor_alltoallw;
+  callarr[DUMPI_Mprobe].callout = (libundumpi_unsafe_fun)callback->on_mprobe;
+  callarr[DUMPI_Improbe].callout = (libundumpi_unsafe_fun)callback->on_improbe;
+  callarr[DUMPI_Mrecv].callout = (libundumpi_unsafe_fun)callback->on_mrecv;
+  callarr[DUMPI_Imrecv].callout = (libundumpi_unsafe_fun)callback->on_imrecv;
   callarr[DUMPI_ALL_FUNCTIONS].callout = NULL;
   callarr[DUMPI_Function_enter].callout = (libundumpi_unsafe_fun)callback->on_function_enter;
   callarr[DUMPI_Function_exit].callout = (libundumpi_unsafe_fun)callback->on_function_exit;
+  callarr[DUMPI_Poll_summary].callout = (libundumpi_unsafe_fun)callback->on_poll_summary;
+  callarr[DUMPI_Function_call].callout = (libundumpi_unsafe_fun)callback->on_function_call;
 
 }
 
@@ -5761,8 +6300,36 @@ void libundumpi_populate_handlers(const libundumpi_callbacks *callback,
   callarr[DUMPIO_Waitany].handler = libdumpi_grab_io_waitany;
   callarr[DUMPIO_Waitsome].handler = libdumpi_grab_io_waitsome;
   callarr[DUMPIO_Testsome].handler = libdumpi_grab_io_testsome;
+  callarr[DUMPI_Ibarrier].handler = libundumpi_grab_ibarrier;
+  callarr[DUMPI_Ibcast].handler = libundumpi_grab_ibcast;
+  callarr[DUMPI_Igather].handler = libundumpi_grab_igather;
+  callarr[DUMPI_Igatherv].handler = libundumpi_grab_igatherv;
+  callarr[DUMPI_Iscatter].handler = libundumpi_grab_iscatter;
+  callarr[DUMPI_Iscatterv].handler = libundumpi_grab_iscatterv;
+  callarr[DUMPI_Iallgather].handler = libundumpi_grab_iallgather;
+  callarr[DUMPI_Iallgatherv].handler = libundumpi_grab_iallgatherv;
+  callarr[DUMPI_Ialltoall].handler = libundumpi_grab_ialltoall;
+  callarr[DUMPI_Ialltoallv].handler = libundumpi_grab_ialltoallv;
+  callarr[DUMPI_Ialltoallw].handler = libundumpi_grab_ialltoallw;
+  callarr[DUMPI_Ireduce].handler = libundumpi_grab_ireduce;
+  callarr[DUMPI_Iallreduce].handler = libundumpi_grab_iallreduce;
+  callarr[DUMPI_Ireduce_scatter].handler = libundumpi_grab_ireduce_scatter;
+  callarr[DUMPI_Iscan].handler = libundumpi_grab_iscan;
+  callarr[DUMPI_Iexscan].handler = libundumpi_grab_iexscan;
+  callarr[DUMPI_Dist_graph_create_adjacent].handler = libundumpi_grab_dist_graph_create_adjacent;
+  callarr[DUMPI_Neighbor_allgather].handler = libundumpi_grab_neighbor_allgather;
+  callarr[DUMPI_Neighbor_allgatherv].handler = libundumpi_grab_neighbor_allgatherv;
+  callarr[DUMPI_Neighbor_alltoall].handler = libundumpi_grab_neighbor_alltoall;
+  callarr[DUMPI_Neighbor_alltoallv].handler = libundumpi_grab_neighbor_alltoallv;
+  callarr[DUMPI_Neighbor_alltoallw].handler = libundumpi_grab_neighbor_alltoallw;
+  callarr[DUMPI_Mprobe].handler = libundumpi_grab_mprobe;
+  callarr[DUMPI_Improbe].handler = libundumpi_grab_improbe;
+  callarr[DUMPI_Mrecv].handler = libundumpi_grab_mrecv;
+  callarr[DUMPI_Imrecv].handler = libundumpi_grab_imrecv;
   callarr[DUMPI_ALL_FUNCTIONS].handler = libundumpi_grab_all_functions;
   callarr[DUMPI_Function_enter].handler = libundumpi_grab_function_enter;
   callarr[DUMPI_Function_exit].handler = libundumpi_grab_function_exit;
+  callarr[DUMPI_Poll_summary].handler = libundumpi_grab_poll_summary;
+  callarr[DUMPI_Function_call].handler = libundumpi_grab_function_call;
 }
 
@@ -2679,6 +2679,240 @@ extern "C" {
    */
   int libdumpi_grab_io_testsome(dumpi_profile *profile, libundumpi_unsafe_fun callout, void *uarg);
 
+  /**
+   * Parse MPI ibarrier.
+   * \param profile   An profile positioned at the start of the MPI call.
+   * \param callout   User-defined callback function (possibly NULL)
+   * \param uarg      User-defined argument to pass to callback function.
+   * \return non-zero on success.
+   */
+  int libundumpi_grab_ibarrier(dumpi_profile *profile, libundumpi_unsafe_fun callout, void *uarg);
+
+  /**
+   * Parse MPI ibcast.
+   * \param profile   An profile positioned at the start of the MPI call.
+   * \param callout   User-defined callback function (possibly NULL)
+   * \param uarg      User-defined argument to pass to callback function.
+   * \return non-zero on success.
+   */
+  int libundumpi_grab_ibcast(dumpi_profile *profile, libundumpi_unsafe_fun callout, void *uarg);
+
+  /**
+   * Parse MPI igather.
+   * \param profile   An profile positioned at the start of the MPI call.
+   * \param callout   User-defined callback function (possibly NULL)
+   * \param uarg      User-defined argument to pass to callback function.
+   * \return non-zero on success.
+   */
+  int libundumpi_grab_igather(dumpi_profile *profile, libundumpi_unsafe_fun callout, void *uarg);
+
+  /**
+   * Parse MPI igatherv.
+   * \param profile   An profile positioned at the start of the MPI call.
+   * \param callout   User-defined callback function (possibly NULL)
+   * \param uarg      User-defined argument to pass to callback function.
+   * \return non-zero on success.
+   */
+  int libundumpi_grab_igatherv(dumpi_profile *profile, libundumpi_unsafe_fun callout, void *uarg);
+
+  /**
+   * Parse MPI iscatter.
+   * \param profile   An profile positioned at the start of the MPI call.
+   * \param callout   User-defined callback function (possibly NULL)
+   * \param uarg      User-defined argument to pass to callback function.
+   * \return non-zero on success.
+   */
+  int libundumpi_grab_iscatter(dumpi_profile *profile, libundumpi_unsafe_fun callout, void *uarg);
+
+  /**
+   * Parse MPI iscatterv.
+   * \param profile   An profile positioned at the start of the MPI call.
+   * \param callout   User-defined callback function (possibly NULL)
+   * \param uarg      User-defined argument to pass to callback function.
+   * \return non-zero on success.
+   */
+  int libundumpi_grab_iscatterv(dumpi_profile *profile, libundumpi_unsafe_fun callout, void *uarg);
+
+  /**
+   * Parse MPI iallgather.
+   * \param profile   An profile positioned at the start of the MPI call.
+   * \param callout   User-defined callback function (possibly NULL)
+   * \param uarg      User-defined argument to pass to callback function.
+   * \return non-zero on success.
+   */
+  int libundumpi_grab_iallgather(dumpi_profile *profile, libundumpi_unsafe_fun callout, void *uarg);
+
+  /**
+   * Parse MPI iallgatherv.
+   * \param profile   An profile positioned at the start of the MPI call.
+   * \param callout   User-defined callback function (possibly NULL)
+   * \param uarg      User-defined argument to pass to callback function.
+   * \return non-zero on success.
+   */
+  int libundumpi_grab_iallgatherv(dumpi_profile *profile, libundumpi_unsafe_fun callout, void *uarg);
+
+  /**
+   * Parse MPI ialltoall.
+   * \param profile   An profile positioned at the start of the MPI call.
+   * \param callout   User-defined callback function (possibly NULL)
+   * \param uarg      User-defined argument to pass to callback function.
+   * \return non-zero on success.
+   */
+  int libundumpi_grab_ialltoall(dumpi_profile *profile, libundumpi_unsafe_fun callout, void *uarg);
+
+  /**
+   * Parse MPI ialltoallv.
+   * \param profile   An profile positioned at the start of the MPI call.
+   * \param callout   User-defined callback function (possibly NULL)
+   * \param uarg      User-defined argument to pass to callback function.
+   * \return non-zero on success.
+   */
+  int libundumpi_grab_ialltoallv(dumpi_profile *profile, libundumpi_unsafe_fun callout, void *uarg);
+
+  /**
+   * Parse MPI ialltoallw.
+   * \param profile   An profile positioned at the start of the MPI call.
+   * \param callout   User-defined callback function (possibly NULL)
+   * \param uarg      User-defined argument to pass to callback function.
+   * \return non-zero on success.
+   */
+  int libundumpi_grab_ialltoallw(dumpi_profile *profile, libundumpi_unsafe_fun callout, void *uarg);
+
+  /**
+   * Parse MPI ireduce.
+   * \param profile   An profile positioned at the start of the MPI call.
+   * \param callout   User-defined callback function (possibly NULL)
+   * \param uarg      User-defined argument to pass to callback function.
+   * \return non-zero on success.
+   */
+  int libundumpi_grab_ireduce(dumpi_profile *profile, libundumpi_unsafe_fun callout, void *uarg);
+
+  /**
+   * Parse MPI iallreduce.
+   * \param profile   An profile positioned at the start of the MPI call.
+   * \param callout   User-defined callback function (possibly NULL)
+   * \param uarg      User-defined argument to pass to callback function.
+   * \return non-zero on success.
+   */
+  int libundumpi_grab_iallreduce(dumpi_profile *profile, libundumpi_unsafe_fun callout, void *uarg);
+
+  /**
+   * Parse MPI ireduce_scatter.
+   * \param profile   An profile positioned at the start of the MPI call.
+   * \param callout   User-defined callback function (possibly NULL)
+   * \param uarg      User-defined argument to pass to callback function.
+   * \return non-zero on success.
+   */
+  int libundumpi_grab_ireduce_scatter(dumpi_profile *profile, libundumpi_unsafe_fun callout, void *uarg);
+
+  /**
+   * Parse MPI iscan.
+   * \param profile   An profile positioned at the start of the MPI call.
+   * \param callout   User-defined callback function (possibly NULL)
+   * \param uarg      User-defined argument to pass to callback function.
+   * \return non-zero on success.
+   */
+  int libundumpi_grab_iscan(dumpi_profile *profile, libundumpi_unsafe_fun callout, void *uarg);
+
+  /**
+   * Parse MPI iexscan.
+   * \param profile   An profile positioned at the start of the MPI call.
+   * \param callout   User-defined callback function (possibly NULL)
+   * \param uarg      User-defined argument to pass to callback function.
+   * \return non-zero on success.
+   */
+  int libundumpi_grab_iexscan(dumpi_profile *profile, libundumpi_unsafe_fun callout, void *uarg);
+
+  /**
+   * Parse MPI dist_graph_create_adjacent.
+   * \param profile   An profile positioned at the start of the MPI call.
+   * \param callout   User-defined callback function (possibly NULL)
+   * \param uarg      User-defined argument to pass to callback function.
+   * \return non-zero on success.
+   */
+  int libundumpi_grab_dist_graph_create_adjacent(dumpi_profile *profile, libundumpi_unsafe_fun callout, void *uarg);
+
+  /**
+   * Parse MPI neighbor_allgather.
+   * \param profile   An profile positioned at the start of the MPI call.
+   * \param callout   User-defined callback function (possibly NULL)
+   * \param uarg      User-defined argument to pass to callback function.
+   * \return non-zero on success.
+   */
+  int libundumpi_grab_neighbor_allgather(dumpi_profile *profile, libundumpi_unsafe_fun callout, void *uarg);
+
+  /**
+   * Parse MPI neighbor_allgatherv.
+   * \param profile   An profile positioned at the start of the MPI call.
+   * \param callout   User-defined callback function (possibly NULL)
+   * \param uarg      User-defined argument to pass to callback function.
+   * \return non-zero on success.
+   */
+  int libundumpi_grab_neighbor_allgatherv(dumpi_profile *profile, libundumpi_unsafe_fun callout, void *uarg);
+
+  /**
+   * Parse MPI neighbor_alltoall.
+   * \param profile   An profile positioned at the start of the MPI call.
+   * \param callout   User-defined callback function (possibly NULL)
+   * \param uarg      User-defined argument to pass to callback function.
+   * \return non-zero on success.
+   */
+  int libundumpi_grab_neighbor_alltoall(dumpi_profile *profile, libundumpi_unsafe_fun callout, void *uarg);
+
+  /**
+   * Parse MPI neighbor_alltoallv.
+   * \param profile   An profile positioned at the start of the MPI call.
+   * \param callout   User-defined callback function (possibly NULL)
+   * \param uarg      User-defined argument to pass to callback function.
+   * \return non-zero on success.
+   */
+  int libundumpi_grab_neighbor_alltoallv(dumpi_profile *profile, libundumpi_unsafe_fun callout, void *uarg);
+
+  /**
+   * Parse MPI neighbor_alltoallw.
+   * \param profile   An profile positioned at the start of the MPI call.
+   * \param callout   User-defined callback function (possibly NULL)
+   * \param uarg      User-defined argument to pass to callback function.
+   * \return non-zero on success.
+   */
+  int libundumpi_grab_neighbor_alltoallw(dumpi_profile *profile, libundumpi_unsafe_fun callout, void *uarg);
+
+  /**
+   * Parse MPI mprobe.
+   * \param profile   An profile positioned at the start of the MPI call.
+   * \param callout   User-defined callback function (possibly NULL)
+   * \param uarg      User-defined argument to pass to callback function.
+   * \return non-zero on success.
+   */
+  int libundumpi_grab_mprobe(dumpi_profile *profile, libundumpi_unsafe_fun callout, void *uarg);
+
+  /**
+   * Parse MPI improbe.
+   * \param profile   An profile positioned at the start of the MPI call.
+   * \param callout   User-defined callback function (possibly NULL)
+   * \param uarg      User-defined argument to pass to callback function.
+   * \return non-zero on success.
+   */
+  int libundumpi_grab_improbe(dumpi_profile *profile, libundumpi_unsafe_fun callout, void *uarg);
+
+  /**
+   * Parse MPI mrecv.
+   * \param profile   An profile positioned at the start of the MPI call.
+   * \param callout   User-defined callback function (possibly NULL)
+   * \param uarg      User-defined argument to pass to callback function.
+   * \return non-zero on success.
+   */
+  int libundumpi_grab_mrecv(dumpi_profile *profile, libundumpi_unsafe_fun callout, void *uarg);
+
+  /**
+   * Parse MPI imrecv.
+   * \param profile   An profile positioned at the start of the MPI call.
+   * \param callout   User-defined callback function (possibly NULL)
+   * \param uarg      User-defined argument to pass to callback function.
+   * \return non-zero on success.
+   */
+  int libundumpi_grab_imrecv(dumpi_profile *profile, libundumpi_unsafe_fun callout, void *uarg);
+
   /**
    * Parse MPI all_functions.
    * \param profile   An profile positioned at the start of the MPI call.
@@ -2706,6 +2940,24 @@ extern "C" {
    */
   int libundumpi_grab_function_exit(dumpi_profile *profile, libundumpi_unsafe_fun callout, void *uarg);
 
+  /**
+   * Parse a whole profiled function call (entry and exit in one record).
+   * \param profile   An profile positioned at the start of the record.
+   * \param callout   User-defined callback function (possibly NULL)
+   * \param uarg      User-defined argument to pass to callback function.
+   * \return non-zero on success.
+   */
+  int libundumpi_grab_function_call(dumpi_profile *profile, libundumpi_unsafe_fun callout, void *uarg);
+
+  /**
+   * Parse a poll summary (a run of unsuccessful polling calls).
+   * \param profile   An profile positioned at the start of the record.
+   * \param callout   User-defined callback function (possibly NULL)
+   * \param uarg      User-defined argument to pass to callback function.
+   * \return non-zero on success.
+   */
+  int libundumpi_grab_poll_summary(dumpi_profile *profile, libundumpi_unsafe_fun callout, void *uarg);
+
   /**
    * Internal function to associate user-specified callbacks with
    * MPI functions.
@@ -313,6 +313,34 @@ void libundumpi_set_callbacks(libundumpi_callbacks *cb, dumpi_generic_call func)
   cb->on_iowaitany = (dumpio_waitany_call)func;
   cb->on_iowaitsome = (dumpio_waitsome_call)func;
   cb->on_iotestsome = (dumpio_testsome_call)func;
+  cb->on_ibarrier = (dumpi_ibarrier_call)func;
+  cb->on_ibcast = (dumpi_ibcast_call)func;
+  cb->on_igather = (dumpi_igather_call)func;
+  cb->on_igatherv = (dumpi_igatherv_call)func;
+  cb->on_iscatter = (dumpi_iscatter_call)func;
+  cb->on_iscatterv = (dumpi_iscatterv_call)func;
+  cb->on_iallgather = (dumpi_iallgather_call)func;
+  cb->on_iallgatherv = (dumpi_iallgatherv_call)func;
+  cb->on_ialltoall = (dumpi_ialltoall_call)func;
+  cb->on_ialltoallv = (dumpi_ialltoallv_call)func;
+  cb->on_ialltoallw = (dumpi_ialltoallw_call)func;
+  cb->on_ireduce = (dumpi_ireduce_call)func;
+  cb->on_iallreduce = (dumpi_iallreduce_call)func;
+  cb->on_ireduce_scatter = (dumpi_ireduce_scatter_call)func;
+  cb->on_iscan = (dumpi_iscan_call)func;
+  cb->on_iexscan = (dumpi_iexscan_call)func;
+  cb->on_dist_graph_create_adjacent = (dumpi_dist_graph_create_adjacent_call)func;
+  cb->on_neighbor_allgather = (dumpi_neighbor_allgather_call)func;
+  cb->on_neighbor_allgatherv = (dumpi_neighbor_allgatherv_call)func;
+  cb->on_neighbor_alltoall = (dumpi_neighbor_alltoall_call)func;
+  cb->on_neighbor_alltoallv = (dumpi_neighbor_alltoallv_call)func;
+  cb->on_neighbor_alltoallw = (dumpi_neighbor_alltoallw_call)func;
+  cb->on_mprobe = (dumpi_mprobe_call)func;
+  cb->on_improbe = (dumpi_improbe_call)func;
+  cb->on_mrecv = (dumpi_mrecv_call)func;
+  cb->on_imrecv = (dumpi_imrecv_call)func;
   cb->on_function_enter = (dumpi_function_enter_call)func;
   cb-> on_function_exit = (dumpi_function_exit_call)func;
+  cb->on_poll_summary = (dumpi_poll_summary_call)func;
+  cb->on_function_call = (dumpi_function_call_call)func;
 }
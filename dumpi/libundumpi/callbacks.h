@@ -604,10 +604,66 @@ extern "C" {
   typedef int (*dumpio_waitany_call)(const dumpio_waitany *prm, uint16_t thread, const dumpi_time *cpu, const dumpi_time *wall, const dumpi_perfinfo *perf, void *userarg);
   typedef int (*dumpio_waitsome_call)(const dumpio_waitsome *prm, uint16_t thread, const dumpi_time *cpu, const dumpi_time *wall, const dumpi_perfinfo *perf, void *userarg);
   typedef int (*dumpio_testsome_call)(const dumpio_testsome *prm, uint16_t thread, const dumpi_time *cpu, const dumpi_time *wall, const dumpi_perfinfo *perf, void *userarg);
+  /** Signature for user-defined callback to handle MPI ibarrier calls. */
+  typedef int (*dumpi_ibarrier_call)(const dumpi_ibarrier *prm, uint16_t thread, const dumpi_time *cpu, const dumpi_time *wall, const dumpi_perfinfo *perf, void *userarg);
+  /** Signature for user-defined callback to handle MPI ibcast calls. */
+  typedef int (*dumpi_ibcast_call)(const dumpi_ibcast *prm, uint16_t thread, const dumpi_time *cpu, const dumpi_time *wall, const dumpi_perfinfo *perf, void *userarg);
+  /** Signature for user-defined callback to handle MPI igather calls. */
+  typedef int (*dumpi_igather_call)(const dumpi_igather *prm, uint16_t thread, const dumpi_time *cpu, const dumpi_time *wall, const dumpi_perfinfo *perf, void *userarg);
+  /** Signature for user-defined callback to handle MPI igatherv calls. */
+  typedef int (*dumpi_igatherv_call)(const dumpi_igatherv *prm, uint16_t thread, const dumpi_time *cpu, const dumpi_time *wall, const dumpi_perfinfo *perf, void *userarg);
+  /** Signature for user-defined callback to handle MPI iscatter calls. */
+  typedef int (*dumpi_iscatter_call)(const dumpi_iscatter *prm, uint16_t thread, const dumpi_time *cpu, const dumpi_time *wall, const dumpi_perfinfo *perf, void *userarg);
+  /** Signature for user-defined callback to handle MPI iscatterv calls. */
+  typedef int (*dumpi_iscatterv_call)(const dumpi_iscatterv *prm, uint16_t thread, const dumpi_time *cpu, const dumpi_time *wall, const dumpi_perfinfo *perf, void *userarg);
+  /** Signature for user-defined callback to handle MPI iallgather calls. */
+  typedef int (*dumpi_iallgather_call)(const dumpi_iallgather *prm, uint16_t thread, const dumpi_time *cpu, const dumpi_time *wall, const dumpi_perfinfo *perf, void *userarg);
+  /** Signature for user-defined callback to handle MPI iallgatherv calls. */
+  typedef int (*dumpi_iallgatherv_call)(const dumpi_iallgatherv *prm, uint16_t thread, const dumpi_time *cpu, const dumpi_time *wall, const dumpi_perfinfo *perf, void *userarg);
+  /** Signature for user-defined callback to handle MPI ialltoall calls. */
+  typedef int (*dumpi_ialltoall_call)(const dumpi_ialltoall *prm, uint16_t thread, const dumpi_time *cpu, const dumpi_time *wall, const dumpi_perfinfo *perf, void *userarg);
+  /** Signature for user-defined callback to handle MPI ialltoallv calls. */
+  typedef int (*dumpi_ialltoallv_call)(const dumpi_ialltoallv *prm, uint16_t thread, const dumpi_time *cpu, const dumpi_time *wall, const dumpi_perfinfo *perf, void *userarg);
+  /** Signature for user-defined callback to handle MPI ialltoallw calls. */
+  typedef int (*dumpi_ialltoallw_call)(const dumpi_ialltoallw *prm, uint16_t thread, const dumpi_time *cpu, const dumpi_time *wall, const dumpi_perfinfo *perf, void *userarg);
+  /** Signature for user-defined callback to handle MPI ireduce calls. */
+  typedef int (*dumpi_ireduce_call)(const dumpi_ireduce *prm, uint16_t thread, const dumpi_time *cpu, const dumpi_time *wall, const dumpi_perfinfo *perf, void *userarg);
+  /** Signature for user-defined callback to handle MPI iallreduce calls. */
+  typedef int (*dumpi_iallreduce_call)(const dumpi_iallreduce *prm, uint16_t thread, const dumpi_time *cpu, const dumpi_time *wall, const dumpi_perfinfo *perf, void *userarg);
+  /** Signature for user-defined callback to handle MPI ireduce_scatter calls. */
+  typedef int (*dumpi_ireduce_scatter_call)(const dumpi_ireduce_scatter *prm, uint16_t thread, const dumpi_time *cpu, const dumpi_time *wall, const dumpi_perfinfo *perf, void *userarg);
+  /** Signature for user-defined callback to handle MPI iscan calls. */
+  typedef int (*dumpi_iscan_call)(const dumpi_iscan *prm, uint16_t thread, const dumpi_time *cpu, const dumpi_time *wall, const dumpi_perfinfo *perf, void *userarg);
+  /** Signature for user-defined callback to handle MPI iexscan calls. */
+  typedef int (*dumpi_iexscan_call)(const dumpi_iexscan *prm, uint16_t thread, const dumpi_time *cpu, const dumpi_time *wall, const dumpi_perfinfo *perf, void *userarg);
+  /** Signature for user-defined callback to handle MPI dist_graph_create_adjacent calls. */
+  typedef int (*dumpi_dist_graph_create_adjacent_call)(const dumpi_dist_graph_create_adjacent *prm, uint16_t thread, const dumpi_time *cpu, const dumpi_time *wall, const dumpi_perfinfo *perf, void *userarg);
+  /** Signature for user-defined callback to handle MPI neighbor_allgather calls. */
+  typedef int (*dumpi_neighbor_allgather_call)(const dumpi_neighbor_allgather *prm, uint16_t thread, const dumpi_time *cpu, const dumpi_time *wall, const dumpi_perfinfo *perf, void *userarg);
+  /** Signature for user-defined callback to handle MPI neighbor_allgatherv calls. */
+  typedef int (*dumpi_neighbor_allgatherv_call)(const dumpi_neighbor_allgatherv *prm, uint16_t thread, const dumpi_time *cpu, const dumpi_time *wall, const dumpi_perfinfo *perf, void *userarg);
+  /** Signature for user-defined callback to handle MPI neighbor_alltoall calls. */
+  typedef int (*dumpi_neighbor_alltoall_call)(const dumpi_neighbor_alltoall *prm, uint16_t thread, const dumpi_time *cpu, const dumpi_time *wall, const dumpi_perfinfo *perf, void *userarg);
+  /** Signature for user-defined callback to handle MPI neighbor_alltoallv calls. */
+  typedef int (*dumpi_neighbor_alltoallv_call)(const dumpi_neighbor_alltoallv *prm, uint16_t thread, const dumpi_time *cpu, const dumpi_time *wall, const dumpi_perfinfo *perf, void *userarg);
+  /** Signature for user-defined callback to handle MPI neighbor_alltoallw calls. */
+  typedef int (*dumpi_neighbor_alltoallw_call)(const dumpi_neighbor_alltoallw *prm, uint16_t thread, const dumpi_time *cpu, const dumpi_time *wall, const dumpi_perfinfo *perf, void *userarg);
+  /** Signature for user-defined callback to handle MPI mprobe calls. */
+  typedef int (*dumpi_mprobe_call)(const dumpi_mprobe *prm, uint16_t thread, const dumpi_time *cpu, const dumpi_time *wall, const dumpi_perfinfo *perf, void *userarg);
+  /** Signature for user-defined callback to handle MPI improbe calls. */
+  typedef int (*dumpi_improbe_call)(const dumpi_improbe *prm, uint16_t thread, const dumpi_time *cpu, const dumpi_time *wall, const dumpi_perfinfo *perf, void *userarg);
+  /** Signature for user-defined callback to handle MPI mrecv calls. */
+  typedef int (*dumpi_mrecv_call)(const dumpi_mrecv *prm, uint16_t thread, const dumpi_time *cpu, const dumpi_time *wall, const dumpi_perfinfo *perf, void *userarg);
+  /** Signature for user-defined callback to handle MPI imrecv calls. */
+  typedef int (*dumpi_imrecv_call)(const dumpi_imrecv *prm, uint16_t thread, const dumpi_time *cpu, const dumpi_time *wall, const dumpi_perfinfo *perf, void *userarg);
   /** Signature for user-defined callback to handle MPI function_enter calls. */
   typedef int (*dumpi_function_enter_call)(const dumpi_func_call *prm, uint16_t thread, const dumpi_time *cpu, const dumpi_time *wall, const dumpi_perfinfo *perf, void *userarg);
   /** Signature for user-defined callback to handle MPI function_exit calls. */
   typedef int (*dumpi_function_exit_call)(const dumpi_func_call *prm, uint16_t thread, const dumpi_time *cpu, const dumpi_time *wall, const dumpi_perfinfo *perf, void *userarg);
+  /** Signature for user-defined callback to handle whole (short) profiled function calls. */
+  typedef int (*dumpi_function_call_call)(const dumpi_func_call *prm, uint16_t thread, const dumpi_time *cpu, const dumpi_time *wall, const dumpi_perfinfo *perf, void *userarg);
+  /** Signature for user-defined callback to handle coalesced polling calls. */
+  typedef int (*dumpi_poll_summary_call)(const dumpi_poll_summary *prm, uint16_t thread, const dumpi_time *cpu, const dumpi_time *wall, const dumpi_perfinfo *perf, void *userarg);
   /** Signature for user-defined generic callback for MPI function calls. */
   typedef int (*dumpi_generic_call)(const void *prm, uint16_t thread, const dumpi_time *cpu, const dumpi_time *wall, const dumpi_perfinfo *perf, void *userarg);
 
@@ -915,8 +971,36 @@ extern "C" {
     dumpio_waitany_call on_iowaitany;
     dumpio_waitsome_call on_iowaitsome;
     dumpio_testsome_call on_iotestsome;
+    dumpi_ibarrier_call on_ibarrier;
+    dumpi_ibcast_call on_ibcast;
+    dumpi_igather_call on_igather;
+    dumpi_igatherv_call on_igatherv;
+    dumpi_iscatter_call on_iscatter;
+    dumpi_iscatterv_call on_iscatterv;
+    dumpi_iallgather_call on_iallgather;
+    dumpi_iallgatherv_call on_iallgatherv;
+    dumpi_ialltoall_call on_ialltoall;
+    dumpi_ialltoallv_call on_ialltoallv;
+    dumpi_ialltoallw_call on_ialltoallw;
+    dumpi_ireduce_call on_ireduce;
+    dumpi_iallreduce_call on_iallreduce;
+    dumpi_ireduce_scatter_call on_ireduce_scatter;
+    dumpi_iscan_call on_iscan;
+    dumpi_iexscan_call on_iexscan;
+    dumpi_dist_graph_create_adjacent_call on_dist_graph_create_adjacent;
+    dumpi_neighbor_allgather_call on_neighbor_allgather;
+    dumpi_neighbor_allgatherv_call on_neighbor_allgatherv;
+    dumpi_neighbor_alltoall_call on_neighbor_alltoall;
+    dumpi_neighbor_alltoallv_call on_neighbor_alltoallv;
+    dumpi_neighbor_alltoallw_call on_neighbor_alltoallw;
+    dumpi_mprobe_call on_mprobe;
+    dumpi_improbe_call on_improbe;
+    dumpi_mrecv_call on_mrecv;
+    dumpi_imrecv_call on_imrecv;
     dumpi_function_enter_call on_function_enter;
     dumpi_function_exit_call  on_function_exit;
+    dumpi_poll_summary_call   on_poll_summary;
+    dumpi_function_call_call  on_function_call;
   } libundumpi_callbacks;
 
   /** Clear a callback struct (set all callbacks to NULL) */
@@ -13,6 +13,8 @@
 #include <dumpi/libundumpi/bindings.h>
 #include <dumpi/common/funcs.h>
 #include <dumpi/common/iodefs.h>
+#include <dumpi/common/clocksync.h>
+#include <stdlib.h>
 #include <assert.h>
 #include <sys/time.h>
 
@@ -28,17 +30,50 @@ static void populate_callbacks(const libundumpi_callbacks *callback,
 			       libundumpi_cbpair *callarr);
 */
 
+/* Correct wall times of every trace opened (undumpi_set_clock_sync) */
+static int sync_on_open = 0;
+
 /*
  * Open a trace file for reading.
  * It is the caller's job to clean up using undumpi_close.
  */
 dumpi_profile* undumpi_open(const char* fname) {
-  return dumpi_open_input_file(fname);
+  dumpi_profile *profile = dumpi_open_input_file(fname);
+  if(profile != NULL && sync_on_open)
+    undumpi_sync_clocks(profile);
+  return profile;
 }
 
 void undumpi_close(dumpi_profile *profile) {
   assert(profile != NULL && profile->file != NULL);
   fclose(profile->file);
+  free(profile->wall_sync);
+  profile->wall_sync = NULL;
+}
+
+/*
+ * Correct wall times with the clock-sync entries of the keyval record.
+ */
+int undumpi_sync_clocks(dumpi_profile *profile) {
+  dumpi_keyval_record *keyval;
+  dumpi_clock_sync sync;
+  int found;
+  assert(profile != NULL);
+  keyval = undumpi_read_keyval_record(profile);
+  found = dumpi_clock_sync_from_keyvals(keyval, &sync);
+  dumpi_free_keyval_record(keyval);
+  free(profile->wall_sync);
+  profile->wall_sync = NULL;
+  if(found) {
+    profile->wall_sync = (dumpi_clock_sync*)malloc(sizeof(dumpi_clock_sync));
+    assert(profile->wall_sync != NULL);
+    *profile->wall_sync = sync;
+  }
+  return found;
+}
+
+void undumpi_set_clock_sync(int enable) {
+  sync_on_open = enable;
 }
 
 /*
@@ -104,6 +104,23 @@ extern "C" {
    */
   dumpi_keyval_record* undumpi_read_keyval_record(dumpi_profile* profile);
 
+  /**
+   * Map the wall times of all records read from now on onto the clock of
+   * rank 0, using the offset and drift that libdumpi measured at MPI_Init
+   * and MPI_Finalize (clock-sync enable; see common/clocksync.h).
+   * \param profile  the file that gets read.
+   * \return         1 if the trace has clock-sync entries, 0 if not (its
+   *                 wall times are then read as recorded).
+   */
+  int undumpi_sync_clocks(dumpi_profile *profile);
+
+  /**
+   * Call undumpi_sync_clocks on every trace opened with undumpi_open
+   * from now on (or stop doing so).  This is how tools that open many
+   * traces compare wall times across ranks.
+   */
+  void undumpi_set_clock_sync(int enable);
+
   /**
    * Get the footer information from the given file (call counts etc.).
    * \param profile  the file that gets read.
@@ -0,0 +1,143 @@
+/*
+ *  This file is part of DUMPI:
+ *               The MPI profiling library from the SST suite.
+ *  Copyright (c) 2009-2011 Sandia Corporation.
+ *  This software is distributed under the BSD License.
+ *  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+ *  the U.S. Government retains certain rights in this software.
+ *  For more information, see the LICENSE file in the top
+ *  SST/macroscale directory.
+ */
+
+/* Size and speed of the compact integer array encodings (put32arr and
+ * get32arr in common/iodefs.h) against the plain per-entry form, on
+ * synthetic arrays shaped like the arguments of vector collectives. */
+
+#include <dumpi/common/iodefs.h>
+#include <dumpi/common/io.h>
+#include <dumpi/common/funcs.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* Entries per array and arrays written per measurement */
+#define BENCH_ENTRIES 16384
+#define BENCH_REPS    200
+#define BENCH_PATTERNS 6
+#define BENCH_FILE    "benchpack-remove.bin"
+
+static const char *pattern_name[BENCH_PATTERNS] = {
+  "uniform counts", "displs i*128", "6-neighbor counts",
+  "counts 100..200", "prefix-sum displs", "random 32-bit"
+};
+
+static int32_t pattern[BENCH_PATTERNS][BENCH_ENTRIES];
+
+static double now(void) {
+  struct timespec t;
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return t.tv_sec + 1e-9 * t.tv_nsec;
+}
+
+/* The plain form, one put32/get32 per entry as before the encodings */
+static void plain_put(dumpi_profile *fp, int32_t count, const int32_t *arr) {
+  int i;
+  put32(fp, count);
+  for(i = 0; i < count; ++i)
+    put32(fp, arr[i]);
+}
+
+static void plain_get(dumpi_profile *fp, int32_t *count, int32_t **arr) {
+  int i;
+  *count = get32(fp);
+  *arr = (int32_t*)malloc(*count * sizeof(int32_t));
+  for(i = 0; i < *count; ++i)
+    (*arr)[i] = get32(fp);
+}
+
+static void fill_patterns(void) {
+  int i, neighbor[6] = { 1, 2, 3, BENCH_ENTRIES-1, BENCH_ENTRIES-2,
+			 BENCH_ENTRIES-3 };
+  int32_t sum = 0;
+  srand(1);
+  for(i = 0; i < BENCH_ENTRIES; ++i) {
+    pattern[0][i] = 128;
+    pattern[1][i] = i * 128;
+    pattern[2][i] = 0;
+    pattern[3][i] = 100 + rand() % 101;
+    pattern[4][i] = sum;
+    sum += pattern[3][i];
+    pattern[5][i] = rand();
+  }
+  for(i = 0; i < 6; ++i)
+    pattern[2][neighbor[i]] = 4096;
+}
+
+/* Write and read back one pattern; returns non-zero on a mismatch. */
+static int bench(int which, int compact) {
+  int rep, failed = 0;
+  int32_t count, *arr;
+  size_t lead;
+  long bytes;
+  double start, write_time, read_time;
+  dumpi_profile *out, in;
+  out = dumpi_alloc_output_profile(0, 0, 0);
+  out->file = fopen(BENCH_FILE, "wb");
+  if(out->file == NULL) {
+    perror(BENCH_FILE);
+    exit(1);
+  }
+  lead = dumpi_membuf_pos(out);
+  start = now();
+  for(rep = 0; rep < BENCH_REPS; ++rep) {
+    if(compact)
+      put32arr(out, BENCH_ENTRIES, pattern[which]);
+    else
+      plain_put(out, BENCH_ENTRIES, pattern[which]);
+  }
+  dumpi_membuf_flush(out);
+  write_time = now() - start;
+  bytes = (ftell(out->file) - (long)lead) / BENCH_REPS;
+  fclose(out->file);
+  out->file = NULL;
+  dumpi_free_output_profile(out);
+  /* A bare input profile of the current version */
+  memset(&in, 0, sizeof(dumpi_profile));
+  in.version[0] = dumpi_version;
+  in.version[1] = dumpi_subversion;
+  in.version[2] = dumpi_subsubversion;
+  in.file = fopen(BENCH_FILE, "rb");
+  fseek(in.file, (long)lead, SEEK_SET);
+  start = now();
+  for(rep = 0; rep < BENCH_REPS; ++rep) {
+    if(compact)
+      get32arr(&in, &count, &arr);
+    else
+      plain_get(&in, &count, &arr);
+    if(count != BENCH_ENTRIES ||
+       memcmp(arr, pattern[which], sizeof(pattern[which])) != 0)
+      failed = 1;
+    free(arr);
+  }
+  read_time = now() - start;
+  fclose(in.file);
+  printf("%-18s %-7s %7ld bytes  write %7.1f Mentries/s  "
+	 "read %7.1f Mentries/s%s\n", pattern_name[which],
+	 (compact ? "compact" : "plain"), bytes,
+	 BENCH_ENTRIES * (double)BENCH_REPS / write_time / 1e6,
+	 BENCH_ENTRIES * (double)BENCH_REPS / read_time / 1e6,
+	 (failed ? "  MISMATCH" : ""));
+  return failed;
+}
+
+int main(void) {
+  int which, failed = 0;
+  fill_patterns();
+  for(which = 0; which < BENCH_PATTERNS; ++which) {
+    failed |= bench(which, 0);
+    failed |= bench(which, 1);
+  }
+  remove(BENCH_FILE);
+  return failed;
+}
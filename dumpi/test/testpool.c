@@ -0,0 +1,220 @@
+/*
+ *  This file is part of DUMPI:
+ *               The MPI profiling library from the SST suite.
+ *  Copyright (c) 2009-2011 Sandia Corporation.
+ *  This software is distributed under the BSD License.
+ *  Under the terms of Contract DE-AC04-94AL85000 with Sandia Corporation,
+ *  the U.S. Government retains certain rights in this software.
+ *  For more information, see the LICENSE file in the top
+ *  SST/macroscale directory.
+ */
+
+/* Write many traces through a writer pool (common/writerpool.h) from
+ * several threads, with fewer blocks and open files than threads, and
+ * check that each trace matches one written without a pool. */
+
+#include <dumpi/common/writerpool.h>
+#include <dumpi/common/dumpiio.h>
+#include <dumpi/common/io.h>
+#include <dumpi/common/funcs.h>
+#include <dumpi/common/constants.h>
+#include <dumpi/dumpiconfig.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#ifdef DUMPI_USE_PTHREADS
+#include <pthread.h>
+#endif /* ! DUMPI_USE_PTHREADS */
+
+/* Traces, writing threads, and rounds of records per trace */
+#define POOL_TRACES   64
+#ifdef DUMPI_USE_PTHREADS
+#define POOL_THREADS  4
+#else
+#define POOL_THREADS  1
+#endif /* ! DUMPI_USE_PTHREADS */
+#define POOL_ROUNDS   200
+/* Two blocks, and two open files, to share among the threads */
+#define POOL_BLOCK    4096
+#define POOL_MEMORY   (2 * POOL_BLOCK)
+#define POOL_FILES    2
+
+static dumpi_outputs output;
+
+/* The data that gets passed to each thread */
+typedef struct tdata {
+  int myid;
+  int pooled;
+  dumpi_profile **profile;
+} tdata;
+
+static void trace_name(char *buf, size_t len, int pooled, int trace) {
+  snprintf(buf, len, "testpool-remove-%s-%04d.bin",
+           (pooled ? "pool" : "plain"), trace);
+}
+
+/* The same records for a trace whether or not it is pooled. */
+static void write_round(dumpi_profile *profile, int trace, int round) {
+  dumpi_send send;
+  dumpi_recv recv;
+  dumpi_time cpu, wall;
+  cpu.start.sec = wall.start.sec = round;
+  cpu.start.nsec = wall.start.nsec = trace;
+  cpu.stop = cpu.start;
+  wall.stop = wall.start;
+  memset(&send, 0, sizeof(dumpi_send));
+  send.count = round;
+  send.datatype = DUMPI_INT;
+  send.dest = (trace + 1) % POOL_TRACES;
+  send.tag = round;
+  send.comm = DUMPI_COMM_WORLD;
+  dumpi_write_send(&send, 0, &cpu, &wall, NULL, &output, profile);
+  if(round % 7 == 0) {
+    memset(&recv, 0, sizeof(dumpi_recv));
+    recv.count = trace;
+    recv.datatype = DUMPI_INT;
+    recv.source = round % POOL_TRACES;
+    recv.comm = DUMPI_COMM_WORLD;
+    dumpi_write_recv(&recv, 0, &cpu, &wall, NULL, &output, profile);
+  }
+}
+
+static void write_trailer(dumpi_profile *profile) {
+  dumpi_header header;
+  dumpi_footer footer;
+  dumpi_keyval_record *keyval = dumpi_alloc_keyval_record();
+  memset(&header, 0, sizeof(dumpi_header));
+  memset(&footer, 0, sizeof(dumpi_footer));
+  header.version[0] = dumpi_version;
+  header.version[1] = dumpi_subversion;
+  header.version[2] = dumpi_subsubversion;
+  header.hostname = "testpool";
+  header.username = "testpool";
+  dumpi_write_header(profile, &header);
+  dumpi_write_footer(profile, &footer);
+  dumpi_write_keyval_record(profile, keyval);
+  dumpi_write_index(profile);
+  dumpi_free_keyval_record(keyval);
+}
+
+/* Thread routine:  interleave the records of this thread's traces, so
+ * that the pool runs out of blocks and files all the time. */
+static void* pool_runt(void *arg) {
+  tdata *data = (tdata*)arg;
+  int trace, round;
+  for(round = 0; round < POOL_ROUNDS; ++round) {
+    for(trace = data->myid; trace < POOL_TRACES; trace += POOL_THREADS) {
+      if(data->pooled) dumpi_pool_lock(data->profile[trace]);
+      write_round(data->profile[trace], trace, round);
+      if(data->pooled) dumpi_pool_unlock(data->profile[trace]);
+    }
+  }
+  for(trace = data->myid; trace < POOL_TRACES; trace += POOL_THREADS) {
+    if(data->pooled) dumpi_pool_lock(data->profile[trace]);
+    write_trailer(data->profile[trace]);
+    if(data->pooled) dumpi_pool_unlock(data->profile[trace]);
+    dumpi_free_output_profile(data->profile[trace]);
+  }
+  return NULL;
+}
+
+static void write_traces(dumpi_writer_pool *pool) {
+  int i;
+  char fname[256];
+  dumpi_profile **profile;
+  tdata threaddata[POOL_THREADS];
+#ifdef DUMPI_USE_PTHREADS
+  pthread_t threadhandle[POOL_THREADS];
+#endif /* ! DUMPI_USE_PTHREADS */
+  profile = (dumpi_profile**)calloc(POOL_TRACES, sizeof(dumpi_profile*));
+  assert(profile != NULL);
+  for(i = 0; i < POOL_TRACES; ++i) {
+    trace_name(fname, sizeof(fname), (pool != NULL), i);
+    if(pool != NULL) {
+      profile[i] = dumpi_pool_output_profile(pool, fname, 0, 0);
+    }
+    else {
+      profile[i] = dumpi_alloc_output_profile(0, 0, 16 * POOL_BLOCK);
+      profile[i]->file = dumpi_open_output_file(fname);
+      assert(profile[i]->file != NULL);
+    }
+  }
+  for(i = 0; i < POOL_THREADS; ++i) {
+    threaddata[i].myid = i;
+    threaddata[i].pooled = (pool != NULL);
+    threaddata[i].profile = profile;
+  }
+#ifdef DUMPI_USE_PTHREADS
+  for(i = 0; i < POOL_THREADS; ++i)
+    assert(pthread_create(threadhandle+i, NULL, pool_runt, threaddata+i) == 0);
+  for(i = 0; i < POOL_THREADS; ++i)
+    assert(pthread_join(threadhandle[i], NULL) == 0);
+#else
+  pool_runt(threaddata);
+#endif /* ! DUMPI_USE_PTHREADS */
+  free(profile);
+}
+
+/* Test whether two files hold the same bytes. */
+static int same_file(const char *aname, const char *bname) {
+  FILE *a = fopen(aname, "rb"), *b = fopen(bname, "rb");
+  int ca, cb, same = (a != NULL && b != NULL);
+  while(same) {
+    ca = getc(a);
+    cb = getc(b);
+    if(ca != cb)
+      same = 0;
+    else if(ca == EOF)
+      break;
+  }
+  if(a) fclose(a);
+  if(b) fclose(b);
+  return same;
+}
+
+int main(void) {
+  int i, failed = 0;
+  char pname[256], fname[256];
+  dumpi_writer_pool *pool;
+  dumpi_writer_pool_stats stats;
+  memset(&output, 0, sizeof(dumpi_outputs));
+  output.timestamps = DUMPI_TIME_FULL;
+  output.statuses = DUMPI_ENABLE;
+  for(i = 0; i <= DUMPI_ALL_FUNCTIONS; ++i)
+    output.function[i] = DUMPI_ENABLE;
+  pool = dumpi_alloc_writer_pool(POOL_MEMORY, POOL_BLOCK, POOL_FILES);
+  write_traces(pool);
+  dumpi_writer_pool_stats_get(pool, &stats);
+  dumpi_free_writer_pool(pool);
+  write_traces(NULL);
+  printf("%d traces from %d threads:  %d blocks, %d files open at most, "
+         "%llu evictions, %llu closes, %llu reopens, %llu waits\n",
+         POOL_TRACES, POOL_THREADS, stats.blocks, stats.peak_open_files,
+         (unsigned long long)stats.evictions,
+         (unsigned long long)stats.closes,
+         (unsigned long long)stats.reopens,
+         (unsigned long long)stats.waits);
+  for(i = 0; i < POOL_TRACES; ++i) {
+    trace_name(pname, sizeof(pname), 1, i);
+    trace_name(fname, sizeof(fname), 0, i);
+    if(! same_file(pname, fname)) {
+      fprintf(stderr, "%s differs from %s\n", pname, fname);
+      failed = 1;
+    }
+  }
+  if(stats.blocks > POOL_MEMORY / POOL_BLOCK ||
+     stats.peak_open_files > POOL_FILES) {
+    fprintf(stderr, "The pool went over its blocks or files\n");
+    failed = 1;
+  }
+  if(stats.open_files != 0) {
+    fprintf(stderr, "%d files left open\n", stats.open_files);
+    failed = 1;
+  }
+  if(stats.evictions == 0 || stats.closes == 0 || stats.reopens == 0) {
+    fprintf(stderr, "The pool never evicted a block or closed a file\n");
+    failed = 1;
+  }
+  return failed;
+}